@@ -74,6 +74,27 @@ void concrete_cpu_add_plaintext_lwe_ciphertext_u64(uint64_t *ct_out,
                                                    uint64_t plaintext,
                                                    size_t lwe_dimension);
 
+void concrete_cpu_batch_bootstrap_lwe_ciphertext_u64(uint64_t *ct_out_batch,
+                                                     const uint64_t *ct_in_batch,
+                                                     size_t batch_size,
+                                                     const uint64_t *accumulator,
+                                                     const double *fourier_bsk,
+                                                     size_t decomposition_level_count,
+                                                     size_t decomposition_base_log,
+                                                     size_t glwe_dimension,
+                                                     size_t polynomial_size,
+                                                     size_t input_lwe_dimension,
+                                                     const struct Fft *fft,
+                                                     uint8_t *stack,
+                                                     size_t stack_size);
+
+ScratchStatus concrete_cpu_batch_bootstrap_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                      size_t *stack_align,
+                                                                      size_t batch_size,
+                                                                      size_t glwe_dimension,
+                                                                      size_t polynomial_size,
+                                                                      const struct Fft *fft);
+
 void concrete_cpu_bootstrap_key_convert_u64_to_fourier(const uint64_t *standard_bsk,
                                                        double *fourier_bsk,
                                                        size_t decomposition_level_count,
@@ -85,6 +106,19 @@ void concrete_cpu_bootstrap_key_convert_u64_to_fourier(const uint64_t *standard_
                                                        uint8_t *stack,
                                                        size_t stack_size);
 
+void concrete_cpu_bootstrap_key_convert_u64_to_fourier_chunk(const uint64_t *standard_bsk,
+                                                             double *fourier_bsk,
+                                                             size_t chunk_start,
+                                                             size_t chunk_len,
+                                                             size_t decomposition_level_count,
+                                                             size_t decomposition_base_log,
+                                                             size_t glwe_dimension,
+                                                             size_t polynomial_size,
+                                                             size_t input_lwe_dimension,
+                                                             const struct Fft *fft,
+                                                             uint8_t *stack,
+                                                             size_t stack_size);
+
 ScratchStatus concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(size_t *stack_size,
                                                                         size_t *stack_align,
                                                                         const struct Fft *fft);
@@ -113,6 +147,38 @@ ScratchStatus concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(size_t *stack_si
                                                                 size_t polynomial_size,
                                                                 const struct Fft *fft);
 
+void concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64(double *ggsw_out,
+                                                               const uint64_t *ct_in,
+                                                               const double *fourier_bsk,
+                                                               const uint64_t *fpksk,
+                                                               size_t ct_in_dimension,
+                                                               size_t bsk_decomposition_level_count,
+                                                               size_t bsk_decomposition_base_log,
+                                                               size_t bsk_glwe_dimension,
+                                                               size_t bsk_polynomial_size,
+                                                               size_t bsk_input_lwe_dimension,
+                                                               size_t fpksk_decomposition_level_count,
+                                                               size_t fpksk_decomposition_base_log,
+                                                               size_t fpksk_input_dimension,
+                                                               size_t fpksk_output_glwe_dimension,
+                                                               size_t fpksk_output_polynomial_size,
+                                                               size_t fpksk_count,
+                                                               size_t cbs_decomposition_level_count,
+                                                               size_t cbs_decomposition_base_log,
+                                                               const struct Fft *fft,
+                                                               uint8_t *stack,
+                                                               size_t stack_size);
+
+ScratchStatus concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                                size_t *stack_align,
+                                                                                size_t ct_in_dimension,
+                                                                                size_t bsk_glwe_dimension,
+                                                                                size_t bsk_polynomial_size,
+                                                                                size_t fpksk_output_glwe_dimension,
+                                                                                size_t fpksk_output_polynomial_size,
+                                                                                size_t cbs_decomposition_level_count,
+                                                                                const struct Fft *fft);
+
 void concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(uint64_t *ct_out_vec,
                                                                                 const uint64_t *ct_in_vec,
                                                                                 const uint64_t *lut,
@@ -186,6 +252,15 @@ void concrete_cpu_encrypt_ggsw_ciphertext_u64(const uint64_t *glwe_sk,
                                               struct Csprng *csprng,
                                               const struct CsprngVtable *csprng_vtable);
 
+void concrete_cpu_encrypt_lwe_ciphertext_batch_u64(const uint64_t *lwe_sk,
+                                                   uint64_t *lwe_out,
+                                                   const uint64_t *input,
+                                                   size_t count,
+                                                   size_t lwe_dimension,
+                                                   double variance,
+                                                   struct Csprng *csprng,
+                                                   const struct CsprngVtable *csprng_vtable);
+
 void concrete_cpu_encrypt_lwe_ciphertext_u64(const uint64_t *lwe_sk,
                                              uint64_t *lwe_out,
                                              uint64_t input,
@@ -194,6 +269,23 @@ void concrete_cpu_encrypt_lwe_ciphertext_u64(const uint64_t *lwe_sk,
                                              struct Csprng *csprng,
                                              const struct CsprngVtable *csprng_vtable);
 
+void concrete_cpu_expand_seeded_lwe_bootstrap_key_u64(uint64_t *lwe_bsk,
+                                                      const uint64_t *seeded_lwe_bsk,
+                                                      size_t input_lwe_dimension,
+                                                      size_t output_polynomial_size,
+                                                      size_t output_glwe_dimension,
+                                                      size_t decomposition_level_count,
+                                                      size_t decomposition_base_log,
+                                                      struct Uint128 mask_seed);
+
+void concrete_cpu_expand_seeded_lwe_keyswitch_key_u64(uint64_t *lwe_ksk,
+                                                      const uint64_t *seeded_lwe_ksk,
+                                                      size_t input_lwe_dimension,
+                                                      size_t output_lwe_dimension,
+                                                      size_t decomposition_level_count,
+                                                      size_t decomposition_base_log,
+                                                      struct Uint128 mask_seed);
+
 void concrete_cpu_extract_bit_lwe_ciphertext_u64(uint64_t *ct_vec_out,
                                                  const uint64_t *ct_in,
                                                  const double *fourier_bsk,
@@ -229,6 +321,20 @@ void concrete_cpu_fill_with_random_gaussian(uint64_t *buffer,
                                             double variance,
                                             struct Csprng *csprng);
 
+int concrete_cpu_fork_concrete_csprng(struct Csprng *parent,
+                                      struct Csprng *children_mem,
+                                      size_t n_children,
+                                      size_t n_bytes_per_child);
+
+void concrete_cpu_fp_keyswitch_lwe_to_glwe_u64(uint64_t *glwe_ct_out,
+                                               const uint64_t *ct_in,
+                                               const uint64_t *fpksk,
+                                               size_t decomposition_level_count,
+                                               size_t decomposition_base_log,
+                                               size_t input_dimension,
+                                               size_t output_glwe_dimension,
+                                               size_t output_polynomial_size);
+
 void concrete_cpu_init_lwe_bootstrap_key_u64(uint64_t *lwe_bsk,
                                              const uint64_t *input_lwe_sk,
                                              const uint64_t *output_glwe_sk,
@@ -271,6 +377,32 @@ void concrete_cpu_init_secret_key_u64(uint64_t *sk,
                                       struct Csprng *csprng,
                                       const struct CsprngVtable *csprng_vtable);
 
+void concrete_cpu_init_seeded_lwe_bootstrap_key_u64(uint64_t *seeded_lwe_bsk,
+                                                    const uint64_t *input_lwe_sk,
+                                                    const uint64_t *output_glwe_sk,
+                                                    size_t input_lwe_dimension,
+                                                    size_t output_polynomial_size,
+                                                    size_t output_glwe_dimension,
+                                                    size_t decomposition_level_count,
+                                                    size_t decomposition_base_log,
+                                                    double variance,
+                                                    struct Uint128 mask_seed,
+                                                    Parallelism parallelism,
+                                                    struct Csprng *csprng,
+                                                    const struct CsprngVtable *csprng_vtable);
+
+void concrete_cpu_init_seeded_lwe_keyswitch_key_u64(uint64_t *seeded_lwe_ksk,
+                                                    const uint64_t *input_lwe_sk,
+                                                    const uint64_t *output_lwe_sk,
+                                                    size_t input_lwe_dimension,
+                                                    size_t output_lwe_dimension,
+                                                    size_t decomposition_level_count,
+                                                    size_t decomposition_base_log,
+                                                    double variance,
+                                                    struct Uint128 mask_seed,
+                                                    struct Csprng *csprng,
+                                                    const struct CsprngVtable *csprng_vtable);
+
 size_t concrete_cpu_keyswitch_key_size_u64(size_t decomposition_level_count,
                                            size_t _decomposition_base_log,
                                            size_t input_dimension,
@@ -300,6 +432,36 @@ void concrete_cpu_negate_lwe_ciphertext_u64(uint64_t *ct_out,
 
 size_t concrete_cpu_secret_key_size_u64(size_t lwe_dimension);
 
+size_t concrete_cpu_seeded_bootstrap_key_size_u64(size_t decomposition_level_count,
+                                                  size_t glwe_dimension,
+                                                  size_t polynomial_size,
+                                                  size_t input_lwe_dimension);
+
+size_t concrete_cpu_seeded_keyswitch_key_size_u64(size_t decomposition_level_count,
+                                                  size_t input_dimension);
+
+void concrete_cpu_vertical_packing_lwe_ciphertext_u64(uint64_t *ct_out,
+                                                      const double *ggsw_list,
+                                                      const uint64_t *lut,
+                                                      size_t ct_out_dimension,
+                                                      size_t lut_size,
+                                                      size_t ggsw_count,
+                                                      size_t glwe_dimension,
+                                                      size_t polynomial_size,
+                                                      size_t cbs_decomposition_level_count,
+                                                      size_t cbs_decomposition_base_log,
+                                                      const struct Fft *fft,
+                                                      uint8_t *stack,
+                                                      size_t stack_size);
+
+ScratchStatus concrete_cpu_vertical_packing_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                       size_t *stack_align,
+                                                                       size_t lut_size,
+                                                                       size_t ggsw_count,
+                                                                       size_t glwe_dimension,
+                                                                       size_t polynomial_size,
+                                                                       const struct Fft *fft);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif // __cplusplus
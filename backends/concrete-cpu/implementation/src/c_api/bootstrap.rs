@@ -4,7 +4,8 @@ use crate::implementation::types::*;
 use core::slice;
 use dyn_stack::DynStack;
 
-use super::types::{Csprng, CsprngVtable};
+use super::csprng::with_seeded_csprng;
+use super::types::{Csprng, CsprngVtable, Uint128};
 use super::utils::nounwind;
 
 #[no_mangle]
@@ -63,6 +64,156 @@ pub unsafe extern "C" fn concrete_cpu_init_lwe_bootstrap_key_u64(
     });
 }
 
+/// Generates a bootstrap key in seeded (compressed) form: only the body
+/// polynomial of each glwe row is written to `seeded_lwe_bsk`. The masks
+/// are derived from `mask_seed`, which is public and can be shipped next
+/// to the bodies; `concrete_cpu_expand_seeded_lwe_bootstrap_key_u64`
+/// rebuilds the full key from the two. The noise is drawn from `csprng`
+/// and never leaves this call.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_init_seeded_lwe_bootstrap_key_u64(
+    // seeded bootstrap key (bodies only)
+    seeded_lwe_bsk: *mut u64,
+    // secret keys
+    input_lwe_sk: *const u64,
+    output_glwe_sk: *const u64,
+    // secret key dimensions
+    input_lwe_dimension: usize,
+    output_polynomial_size: usize,
+    output_glwe_dimension: usize,
+    // bootstrap key parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    // noise parameters
+    variance: f64,
+    // public seed the masks are derived from
+    mask_seed: Uint128,
+    // parallelism
+    parallelism: Parallelism,
+    // csprng, used for the noise only
+    csprng: *mut Csprng,
+    csprng_vtable: *const CsprngVtable,
+) {
+    nounwind(|| {
+        let glwe_params = GlweParams {
+            dimension: output_glwe_dimension,
+            polynomial_size: output_polynomial_size,
+        };
+
+        let decomp_params = DecompParams {
+            level: decomposition_level_count,
+            base_log: decomposition_base_log,
+        };
+
+        let lwe_sk = LweSecretKey::from_raw_parts(input_lwe_sk, input_lwe_dimension);
+        let glwe_sk = GlweSecretKey::from_raw_parts(output_glwe_sk, glwe_params);
+
+        // The key is generated expanded (the bodies accumulate mask * key
+        // products, so the masks are needed along the way), then only the
+        // bodies are kept: the masks are a pure function of `mask_seed`.
+        let mut full = vec![
+            0_u64;
+            BootstrapKey::<&[u64]>::data_len(
+                glwe_params,
+                decomposition_level_count,
+                input_lwe_dimension
+            )
+        ];
+
+        with_seeded_csprng(mask_seed, |mask_csprng| {
+            let bsk = BootstrapKey::new(
+                full.as_mut_slice(),
+                glwe_params,
+                input_lwe_dimension,
+                decomp_params,
+            );
+            let noise_csprng = CsprngMut::new(csprng, csprng_vtable);
+            match parallelism {
+                Parallelism::No => bsk.fill_with_new_key_seeded(
+                    lwe_sk,
+                    glwe_sk,
+                    variance,
+                    mask_csprng,
+                    noise_csprng,
+                ),
+                Parallelism::Rayon => bsk.fill_with_new_key_seeded_par(
+                    lwe_sk,
+                    glwe_sk,
+                    variance,
+                    mask_csprng,
+                    noise_csprng,
+                ),
+            }
+        });
+
+        let seeded = slice::from_raw_parts_mut(
+            seeded_lwe_bsk,
+            concrete_cpu_seeded_bootstrap_key_size_u64(
+                decomposition_level_count,
+                output_glwe_dimension,
+                output_polynomial_size,
+                input_lwe_dimension,
+            ),
+        );
+        BootstrapKey::new(
+            full.as_slice(),
+            glwe_params,
+            input_lwe_dimension,
+            decomp_params,
+        )
+        .extract_seeded_bodies(seeded);
+    });
+}
+
+/// Expands `seeded_lwe_bsk`, a bootstrap key stripped down to the body
+/// polynomial of each glwe row, into the full key `lwe_bsk`, replaying
+/// the masks from `mask_seed` (the seed the key was generated with).
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_expand_seeded_lwe_bootstrap_key_u64(
+    // bootstrap key
+    lwe_bsk: *mut u64,
+    // seeded bootstrap key (bodies only)
+    seeded_lwe_bsk: *const u64,
+    // secret key dimensions
+    input_lwe_dimension: usize,
+    output_polynomial_size: usize,
+    output_glwe_dimension: usize,
+    // bootstrap key parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    // public seed the masks are derived from
+    mask_seed: Uint128,
+) {
+    nounwind(|| {
+        let glwe_params = GlweParams {
+            dimension: output_glwe_dimension,
+            polynomial_size: output_polynomial_size,
+        };
+
+        let decomp_params = DecompParams {
+            level: decomposition_level_count,
+            base_log: decomposition_base_log,
+        };
+
+        let bsk =
+            BootstrapKey::from_raw_parts(lwe_bsk, glwe_params, input_lwe_dimension, decomp_params);
+
+        let seeded = slice::from_raw_parts(
+            seeded_lwe_bsk,
+            concrete_cpu_seeded_bootstrap_key_size_u64(
+                decomposition_level_count,
+                output_glwe_dimension,
+                output_polynomial_size,
+                input_lwe_dimension,
+            ),
+        );
+
+        with_seeded_csprng(mask_seed, |mask_csprng| {
+            bsk.fill_from_seeded_bodies(seeded, mask_csprng)
+        });
+    });
+}
+
 #[no_mangle]
 #[must_use]
 pub unsafe extern "C" fn concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
@@ -131,6 +282,51 @@ pub unsafe extern "C" fn concrete_cpu_bootstrap_key_convert_u64_to_fourier(
     })
 }
 
+/// Converts the GGSW ciphertexts `[chunk_start, chunk_start + chunk_len)`
+/// of a bootstrap key to the Fourier domain. The conversion is
+/// independent per GGSW ciphertext, so disjoint chunks of one key may be
+/// converted concurrently, each call with its own scratch (the scratch
+/// requirements are those of the full conversion).
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_bootstrap_key_convert_u64_to_fourier_chunk(
+    // bootstrap key
+    standard_bsk: *const u64,
+    fourier_bsk: *mut f64,
+    // chunk of converted ggsw ciphertexts
+    chunk_start: usize,
+    chunk_len: usize,
+    // bootstrap parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    input_lwe_dimension: usize,
+    // side resources
+    fft: *const Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    debug_assert!(chunk_start + chunk_len <= input_lwe_dimension);
+    let _ = input_lwe_dimension;
+    // Both domains store one ggsw ciphertext in the same number of
+    // scalars: polynomial_size/2 c64 coefficients per polynomial in the
+    // Fourier domain.
+    let ggsw_len =
+        decomposition_level_count * (glwe_dimension + 1) * (glwe_dimension + 1) * polynomial_size;
+    concrete_cpu_bootstrap_key_convert_u64_to_fourier(
+        standard_bsk.add(chunk_start * ggsw_len),
+        fourier_bsk.add(chunk_start * ggsw_len),
+        decomposition_level_count,
+        decomposition_base_log,
+        glwe_dimension,
+        polynomial_size,
+        chunk_len,
+        fft,
+        stack,
+        stack_size,
+    )
+}
+
 #[no_mangle]
 #[must_use]
 pub unsafe extern "C" fn concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
@@ -215,6 +411,97 @@ pub unsafe extern "C" fn concrete_cpu_bootstrap_lwe_ciphertext_u64(
     })
 }
 
+#[no_mangle]
+#[must_use]
+pub unsafe extern "C" fn concrete_cpu_batch_bootstrap_lwe_ciphertext_u64_scratch(
+    stack_size: *mut usize,
+    stack_align: *mut usize,
+    // batch size
+    batch_size: usize,
+    // bootstrap parameters
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    // side resources
+    fft: *const crate::implementation::fft::Fft,
+) -> ScratchStatus {
+    nounwind(|| {
+        let fft = (*fft).as_view();
+        if let Ok(scratch) = BootstrapKey::batch_bootstrap_scratch(
+            GlweParams {
+                dimension: glwe_dimension,
+                polynomial_size,
+            },
+            batch_size,
+            fft,
+        ) {
+            *stack_size = scratch.size_bytes();
+            *stack_align = scratch.align_bytes();
+            ScratchStatus::Valid
+        } else {
+            ScratchStatus::SizeOverflow
+        }
+    })
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_batch_bootstrap_lwe_ciphertext_u64(
+    // ciphertexts, batch_size contiguous LWEs each
+    ct_out_batch: *mut u64,
+    ct_in_batch: *const u64,
+    // batch size
+    batch_size: usize,
+    // accumulator, shared by the whole batch
+    accumulator: *const u64,
+    // bootstrap key
+    fourier_bsk: *const f64,
+    // bootstrap parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    input_lwe_dimension: usize,
+    // side resources
+    fft: *const crate::implementation::fft::Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    nounwind(|| {
+        let glwe_params = GlweParams {
+            dimension: glwe_dimension,
+            polynomial_size,
+        };
+
+        let decomp_params = DecompParams {
+            level: decomposition_level_count,
+            base_log: decomposition_base_log,
+        };
+
+        let output_lwe_dimension = glwe_dimension * polynomial_size;
+
+        let fourier = BootstrapKey::from_raw_parts(
+            fourier_bsk,
+            glwe_params,
+            input_lwe_dimension,
+            decomp_params,
+        );
+
+        let lwe_in_list =
+            slice::from_raw_parts(ct_in_batch, batch_size * (input_lwe_dimension + 1));
+
+        let lwe_out_list =
+            slice::from_raw_parts_mut(ct_out_batch, batch_size * (output_lwe_dimension + 1));
+
+        let accumulator = GlweCiphertext::from_raw_parts(accumulator, glwe_params);
+        fourier.batch_bootstrap(
+            lwe_out_list,
+            lwe_in_list,
+            accumulator,
+            (*fft).as_view(),
+            DynStack::new(slice::from_raw_parts_mut(stack as _, stack_size)),
+        );
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_bootstrap_key_size_u64(
     decomposition_level_count: usize,
@@ -231,3 +518,22 @@ pub unsafe extern "C" fn concrete_cpu_bootstrap_key_size_u64(
         input_lwe_dimension,
     )
 }
+
+// Length in u64 words of the seeded (bodies-only) form of a bootstrap
+// key: one body polynomial per glwe row of the full key.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_seeded_bootstrap_key_size_u64(
+    decomposition_level_count: usize,
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    input_lwe_dimension: usize,
+) -> usize {
+    BootstrapKey::<&[u64]>::data_len(
+        GlweParams {
+            dimension: glwe_dimension,
+            polynomial_size,
+        },
+        decomposition_level_count,
+        input_lwe_dimension,
+    ) / (glwe_dimension + 1)
+}
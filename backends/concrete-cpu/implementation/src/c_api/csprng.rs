@@ -1,10 +1,27 @@
 use std::io::Read;
 
 use super::types::{Csprng, CsprngVtable, Uint128};
-use concrete_csprng::generators::{RandomGenerator, SoftwareRandomGenerator as Generator};
+use crate::implementation::types::CsprngMut;
+use concrete_csprng::generators::{
+    BytesPerChild, ChildrenCount, RandomGenerator, SoftwareRandomGenerator as Generator,
+};
 use concrete_csprng::seeders::Seed;
 use libc::c_int;
 
+// Runs `f` over a csprng wrapping a fresh software generator seeded with
+// `seed`. Used by the seeded key entry points: generation and expansion
+// both replay the exact same mask byte stream from the public seed.
+pub(crate) fn with_seeded_csprng<R>(seed: Uint128, f: impl FnOnce(CsprngMut<'_, '_>) -> R) -> R {
+    let mut generator = Generator::new(Seed(u128::from_le_bytes(seed.little_endian_bytes)));
+    let csprng = unsafe {
+        CsprngMut::new(
+            &mut generator as *mut Generator as *mut Csprng,
+            &CONCRETE_CSPRNG_VTABLE,
+        )
+    };
+    f(csprng)
+}
+
 #[no_mangle]
 pub static CONCRETE_CSPRNG_VTABLE: CsprngVtable = CsprngVtable {
     remaining_bytes: {
@@ -55,6 +72,34 @@ pub unsafe extern "C" fn concrete_cpu_construct_concrete_csprng(mem: *mut Csprng
     mem.write(Generator::new(seed));
 }
 
+// Fork `n_children` child generators off `parent` into `children_mem`, an
+// array of `n_children` slots of CONCRETE_CSPRNG_SIZE bytes each. The
+// generator is counter-mode: each child owns a disjoint range of
+// `n_bytes_per_child` bytes of the parent stream and the parent is advanced
+// past all of them, so the children can be consumed concurrently while the
+// overall stream stays a deterministic function of the original seed.
+// Returns 0 on success, 1 if the parent has too few bytes left to fork.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_fork_concrete_csprng(
+    parent: *mut Csprng,
+    children_mem: *mut Csprng,
+    n_children: usize,
+    n_bytes_per_child: usize,
+) -> c_int {
+    let parent = &mut *(parent as *mut Generator);
+    match parent.try_fork(ChildrenCount(n_children), BytesPerChild(n_bytes_per_child)) {
+        Ok(children) => {
+            let mut mem = children_mem as *mut Generator;
+            for child in children {
+                mem.write(child);
+                mem = mem.add(1);
+            }
+            0
+        }
+        Err(_) => 1,
+    }
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_destroy_concrete_csprng(mem: *mut Csprng) {
     core::ptr::drop_in_place(mem as *mut Generator);
@@ -64,7 +109,7 @@ pub unsafe extern "C" fn concrete_cpu_destroy_concrete_csprng(mem: *mut Csprng)
 // Returns 1 if the random is crypto secure, -1 if it not secure, 0 if fail.
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_crypto_secure_random_128(u128: *mut Uint128) -> c_int {
-    let buf = &mut (*u128).little_endian_bytes[0..16];
+    let buf = &mut (&mut (*u128).little_endian_bytes)[0..16];
 
     #[cfg(any(target_arch = "x86_64", target_arch = "x86"))]
     if is_x86_feature_detected!("rdseed") {
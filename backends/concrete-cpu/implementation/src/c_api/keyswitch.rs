@@ -1,6 +1,8 @@
-use super::types::{Csprng, CsprngVtable};
+use super::csprng::with_seeded_csprng;
+use super::types::{Csprng, CsprngVtable, Uint128};
 use super::utils::nounwind;
 use crate::implementation::types::*;
+use core::slice;
 
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_init_lwe_keyswitch_key_u64(
@@ -43,6 +45,129 @@ pub unsafe extern "C" fn concrete_cpu_init_lwe_keyswitch_key_u64(
     });
 }
 
+/// Generates a keyswitch key in seeded (compressed) form: only the body
+/// of each ciphertext is written to `seeded_lwe_ksk`. The masks are
+/// derived from `mask_seed`, which is public and can be shipped next to
+/// the bodies; `concrete_cpu_expand_seeded_lwe_keyswitch_key_u64`
+/// rebuilds the full key from the two. The noise is drawn from `csprng`
+/// and never leaves this call.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_init_seeded_lwe_keyswitch_key_u64(
+    // seeded keyswitch key (bodies only)
+    seeded_lwe_ksk: *mut u64,
+    // secret keys
+    input_lwe_sk: *const u64,
+    output_lwe_sk: *const u64,
+    // secret key dimensions
+    input_lwe_dimension: usize,
+    output_lwe_dimension: usize,
+    // keyswitch key parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    // noise parameters
+    variance: f64,
+    // public seed the masks are derived from
+    mask_seed: Uint128,
+    // csprng, used for the noise only
+    csprng: *mut Csprng,
+    csprng_vtable: *const CsprngVtable,
+) {
+    nounwind(|| {
+        let input_key = LweSecretKey::from_raw_parts(input_lwe_sk, input_lwe_dimension);
+        let output_key = LweSecretKey::from_raw_parts(output_lwe_sk, output_lwe_dimension);
+        let decomp_params = DecompParams {
+            level: decomposition_level_count,
+            base_log: decomposition_base_log,
+        };
+
+        // The key is generated expanded (the bodies accumulate mask * key
+        // products, so the masks are needed along the way), then only the
+        // bodies are kept: the masks are a pure function of `mask_seed`.
+        let mut full = vec![
+            0_u64;
+            LweKeyswitchKey::<&[u64]>::data_len(
+                output_lwe_dimension,
+                decomposition_level_count,
+                input_lwe_dimension
+            )
+        ];
+
+        with_seeded_csprng(mask_seed, |mask_csprng| {
+            let ksk = LweKeyswitchKey::new(
+                full.as_mut_slice(),
+                output_lwe_dimension,
+                input_lwe_dimension,
+                decomp_params,
+            );
+            ksk.fill_with_keyswitch_key_seeded(
+                input_key,
+                output_key,
+                variance,
+                mask_csprng,
+                CsprngMut::new(csprng, csprng_vtable),
+            );
+        });
+
+        let seeded = slice::from_raw_parts_mut(
+            seeded_lwe_ksk,
+            concrete_cpu_seeded_keyswitch_key_size_u64(
+                decomposition_level_count,
+                input_lwe_dimension,
+            ),
+        );
+        LweKeyswitchKey::new(
+            full.as_slice(),
+            output_lwe_dimension,
+            input_lwe_dimension,
+            decomp_params,
+        )
+        .extract_seeded_bodies(seeded);
+    });
+}
+
+/// Expands `seeded_lwe_ksk`, a keyswitch key stripped down to the body of
+/// each ciphertext, into the full key `lwe_ksk`, replaying the masks from
+/// `mask_seed` (the seed the key was generated with).
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_expand_seeded_lwe_keyswitch_key_u64(
+    // keyswitch key
+    lwe_ksk: *mut u64,
+    // seeded keyswitch key (bodies only)
+    seeded_lwe_ksk: *const u64,
+    // secret key dimensions
+    input_lwe_dimension: usize,
+    output_lwe_dimension: usize,
+    // keyswitch key parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    // public seed the masks are derived from
+    mask_seed: Uint128,
+) {
+    nounwind(|| {
+        let ksk = LweKeyswitchKey::from_raw_parts(
+            lwe_ksk,
+            output_lwe_dimension,
+            input_lwe_dimension,
+            DecompParams {
+                level: decomposition_level_count,
+                base_log: decomposition_base_log,
+            },
+        );
+
+        let seeded = slice::from_raw_parts(
+            seeded_lwe_ksk,
+            concrete_cpu_seeded_keyswitch_key_size_u64(
+                decomposition_level_count,
+                input_lwe_dimension,
+            ),
+        );
+
+        with_seeded_csprng(mask_seed, |mask_csprng| {
+            ksk.fill_from_seeded_bodies(seeded, mask_csprng)
+        });
+    });
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_keyswitch_lwe_ciphertext_u64(
     // ciphertexts
@@ -74,6 +199,43 @@ pub unsafe extern "C" fn concrete_cpu_keyswitch_lwe_ciphertext_u64(
     })
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_fp_keyswitch_lwe_to_glwe_u64(
+    // ciphertexts
+    glwe_ct_out: *mut u64,
+    ct_in: *const u64,
+    // packing keyswitch key
+    fpksk: *const u64,
+    // keyswitch parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    input_dimension: usize,
+    output_glwe_dimension: usize,
+    output_polynomial_size: usize,
+) {
+    nounwind(|| {
+        let glwe_params = GlweParams {
+            dimension: output_glwe_dimension,
+            polynomial_size: output_polynomial_size,
+        };
+
+        let ct_out = GlweCiphertext::from_raw_parts(glwe_ct_out, glwe_params);
+        let ct_in = LweCiphertext::from_raw_parts(ct_in, input_dimension);
+
+        let fpksk = PackingKeyswitchKey::from_raw_parts(
+            fpksk,
+            glwe_params,
+            input_dimension,
+            DecompParams {
+                level: decomposition_level_count,
+                base_log: decomposition_base_log,
+            },
+        );
+
+        fpksk.private_functional_keyswitch_ciphertext(ct_out, ct_in);
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_keyswitch_key_size_u64(
     decomposition_level_count: usize,
@@ -87,3 +249,13 @@ pub unsafe extern "C" fn concrete_cpu_keyswitch_key_size_u64(
         input_dimension,
     )
 }
+
+// Length in u64 words of the seeded (bodies-only) form of a keyswitch
+// key: one body word per ciphertext of the full key.
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_seeded_keyswitch_key_size_u64(
+    decomposition_level_count: usize,
+    input_dimension: usize,
+) -> usize {
+    input_dimension * decomposition_level_count
+}
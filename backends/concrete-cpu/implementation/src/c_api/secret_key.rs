@@ -55,6 +55,37 @@ pub unsafe extern "C" fn concrete_cpu_encrypt_lwe_ciphertext_u64(
     });
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_encrypt_lwe_ciphertext_batch_u64(
+    // secret key
+    lwe_sk: *const u64,
+    // contiguous ciphertext batch
+    lwe_out: *mut u64,
+    // plaintexts
+    input: *const u64,
+    // number of ciphertexts
+    count: usize,
+    // lwe size
+    lwe_dimension: usize,
+    // encryption parameters
+    variance: f64,
+    // csprng
+    csprng: *mut Csprng,
+    csprng_vtable: *const CsprngVtable,
+) {
+    nounwind(|| {
+        let mut csprng = CsprngMut::new(csprng, csprng_vtable);
+        let input = slice::from_raw_parts(input, count);
+        let lwe_size = lwe_dimension + 1;
+        for (i, &plaintext) in input.iter().enumerate() {
+            let lwe_sk = LweSecretKey::from_raw_parts(lwe_sk, lwe_dimension);
+            let lwe_out =
+                LweCiphertext::from_raw_parts(lwe_out.add(i * lwe_size), lwe_dimension);
+            lwe_sk.encrypt_lwe(lwe_out, plaintext, variance, csprng.as_mut());
+        }
+    });
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_encrypt_ggsw_ciphertext_u64(
     // secret key
@@ -3,11 +3,14 @@ use crate::c_api::utils::nounwind;
 use crate::implementation::fft::Fft;
 use crate::implementation::types::ciphertext_list::LweCiphertextList;
 use crate::implementation::types::packing_keyswitch_key_list::PackingKeyswitchKeyList;
+use crate::implementation::types::polynomial::Polynomial;
 use crate::implementation::types::polynomial_list::PolynomialList;
 use crate::implementation::types::*;
 use crate::implementation::wop::{
+    circuit_bootstrap_boolean_fourier_ggsw, circuit_bootstrap_boolean_fourier_ggsw_scratch,
     circuit_bootstrap_boolean_vertical_packing, circuit_bootstrap_boolean_vertical_packing_scratch,
-    extract_bits, extract_bits_scratch,
+    extract_bits, extract_bits_scratch, vertical_packing, vertical_packing_scratch,
+    FourierGgswCiphertextList,
 };
 use core::slice;
 use dyn_stack::DynStack;
@@ -353,6 +356,254 @@ pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_vertical_packing
     })
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64_scratch(
+    stack_size: *mut usize,
+    stack_align: *mut usize,
+    // ciphertext dimensions
+    ct_in_dimension: usize,
+    // bootstrap parameters
+    bsk_glwe_dimension: usize,
+    bsk_polynomial_size: usize,
+    // keyswitch_parameters
+    fpksk_output_glwe_dimension: usize,
+    fpksk_output_polynomial_size: usize,
+    // circuit bootstrap parameters
+    cbs_decomposition_level_count: usize,
+    // side resources
+    fft: *const Fft,
+) -> ScratchStatus {
+    nounwind(|| {
+        assert_ne!(cbs_decomposition_level_count, 0);
+        let bsk_output_lwe_dimension = bsk_glwe_dimension * bsk_polynomial_size;
+
+        if let Ok(scratch) = circuit_bootstrap_boolean_fourier_ggsw_scratch(
+            ct_in_dimension + 1,
+            bsk_output_lwe_dimension + 1,
+            GlweParams {
+                dimension: fpksk_output_glwe_dimension,
+                polynomial_size: fpksk_output_polynomial_size,
+            },
+            cbs_decomposition_level_count,
+            (*fft).as_view(),
+        ) {
+            *stack_size = scratch.size_bytes();
+            *stack_align = scratch.align_bytes();
+            ScratchStatus::Valid
+        } else {
+            ScratchStatus::SizeOverflow
+        }
+    })
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64(
+    // fourier ggsw ciphertext
+    ggsw_out: *mut f64,
+    // ciphertext
+    ct_in: *const u64,
+    // bootstrap key
+    fourier_bsk: *const f64,
+    // packing keyswitch key
+    fpksk: *const u64,
+    // ciphertext dimensions
+    ct_in_dimension: usize,
+    // bootstrap parameters
+    bsk_decomposition_level_count: usize,
+    bsk_decomposition_base_log: usize,
+    bsk_glwe_dimension: usize,
+    bsk_polynomial_size: usize,
+    bsk_input_lwe_dimension: usize,
+    // keyswitch_parameters
+    fpksk_decomposition_level_count: usize,
+    fpksk_decomposition_base_log: usize,
+    fpksk_input_dimension: usize,
+    fpksk_output_glwe_dimension: usize,
+    fpksk_output_polynomial_size: usize,
+    fpksk_count: usize,
+    // circuit bootstrap parameters
+    cbs_decomposition_level_count: usize,
+    cbs_decomposition_base_log: usize,
+    // side resources
+    fft: *const Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    nounwind(|| {
+        let bsk_output_lwe_dimension = bsk_glwe_dimension * bsk_polynomial_size;
+        assert_eq!(bsk_output_lwe_dimension, fpksk_input_dimension);
+        assert_eq!(ct_in_dimension, bsk_input_lwe_dimension);
+
+        assert_ne!(cbs_decomposition_base_log, 0);
+        assert_ne!(cbs_decomposition_level_count, 0);
+        assert!(cbs_decomposition_level_count * cbs_decomposition_base_log <= 64);
+
+        let fpksk_glwe_params = GlweParams {
+            dimension: fpksk_output_glwe_dimension,
+            polynomial_size: fpksk_output_polynomial_size,
+        };
+
+        let cbs_decomp_params = DecompParams {
+            level: cbs_decomposition_level_count,
+            base_log: cbs_decomposition_base_log,
+        };
+
+        let ggsw_out = GgswCiphertext::<&mut [f64]>::from_raw_parts(
+            ggsw_out,
+            fpksk_glwe_params,
+            cbs_decomp_params,
+        );
+
+        let lwe_in = LweCiphertext::<&[u64]>::from_raw_parts(ct_in, ct_in_dimension);
+
+        let fourier_bsk = BootstrapKey::<&[f64]>::from_raw_parts(
+            fourier_bsk,
+            GlweParams {
+                dimension: bsk_glwe_dimension,
+                polynomial_size: bsk_polynomial_size,
+            },
+            bsk_input_lwe_dimension,
+            DecompParams {
+                level: bsk_decomposition_level_count,
+                base_log: bsk_decomposition_base_log,
+            },
+        );
+
+        let fpksk_list = PackingKeyswitchKeyList::new(
+            slice::from_raw_parts(
+                fpksk,
+                fpksk_decomposition_level_count
+                    * (fpksk_output_glwe_dimension + 1)
+                    * fpksk_output_polynomial_size
+                    * (fpksk_input_dimension + 1)
+                    * fpksk_count,
+            ),
+            fpksk_glwe_params,
+            fpksk_input_dimension,
+            DecompParams {
+                level: fpksk_decomposition_level_count,
+                base_log: fpksk_decomposition_base_log,
+            },
+            fpksk_count,
+        );
+
+        circuit_bootstrap_boolean_fourier_ggsw(
+            ggsw_out,
+            fourier_bsk,
+            lwe_in,
+            fpksk_list,
+            cbs_decomp_params,
+            (*fft).as_view(),
+            DynStack::new(slice::from_raw_parts_mut(stack as _, stack_size)),
+        );
+    })
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_vertical_packing_lwe_ciphertext_u64_scratch(
+    stack_size: *mut usize,
+    stack_align: *mut usize,
+    // ciphertext dimensions
+    lut_size: usize,
+    ggsw_count: usize,
+    // glwe parameters
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    // side resources
+    fft: *const Fft,
+) -> ScratchStatus {
+    nounwind(|| {
+        assert_eq!(lut_size, 1 << ggsw_count);
+
+        // The cmux tree works on polynomial-size chunks of the lut; luts that
+        // fit in one polynomial only need the final blind rotation.
+        let lut_polynomial_count = if lut_size > polynomial_size {
+            lut_size / polynomial_size
+        } else {
+            1
+        };
+
+        if let Ok(scratch) = vertical_packing_scratch(
+            GlweParams {
+                dimension: glwe_dimension,
+                polynomial_size,
+            },
+            lut_polynomial_count,
+            ggsw_count,
+            (*fft).as_view(),
+        ) {
+            *stack_size = scratch.size_bytes();
+            *stack_align = scratch.align_bytes();
+            ScratchStatus::Valid
+        } else {
+            ScratchStatus::SizeOverflow
+        }
+    })
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_vertical_packing_lwe_ciphertext_u64(
+    // ciphertext
+    ct_out: *mut u64,
+    // fourier ggsw ciphertexts
+    ggsw_list: *const f64,
+    // lookup table
+    lut: *const u64,
+    // ciphertext dimensions
+    ct_out_dimension: usize,
+    lut_size: usize,
+    ggsw_count: usize,
+    // glwe parameters
+    glwe_dimension: usize,
+    polynomial_size: usize,
+    // circuit bootstrap parameters
+    cbs_decomposition_level_count: usize,
+    cbs_decomposition_base_log: usize,
+    // side resources
+    fft: *const Fft,
+    stack: *mut u8,
+    stack_size: usize,
+) {
+    nounwind(|| {
+        assert_eq!(ct_out_dimension, glwe_dimension * polynomial_size);
+        assert_eq!(lut_size, 1 << ggsw_count);
+
+        let glwe_params = GlweParams {
+            dimension: glwe_dimension,
+            polynomial_size,
+        };
+
+        let ggsw_list = FourierGgswCiphertextList::new(
+            slice::from_raw_parts(
+                ggsw_list,
+                ggsw_count
+                    * polynomial_size
+                    * (glwe_dimension + 1)
+                    * (glwe_dimension + 1)
+                    * cbs_decomposition_level_count,
+            ),
+            ggsw_count,
+            glwe_params,
+            DecompParams {
+                level: cbs_decomposition_level_count,
+                base_log: cbs_decomposition_base_log,
+            },
+        );
+
+        let lut = Polynomial::new(slice::from_raw_parts(lut, lut_size), lut_size);
+
+        let lwe_out = LweCiphertext::<&mut [u64]>::from_raw_parts(ct_out, ct_out_dimension);
+
+        vertical_packing(
+            lut,
+            lwe_out,
+            ggsw_list.as_view(),
+            (*fft).as_view(),
+            DynStack::new(slice::from_raw_parts_mut(stack as _, stack_size)),
+        );
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_lwe_packing_keyswitch_key_size(
     glwe_dimension: usize,
@@ -86,6 +86,107 @@ impl<'a> BootstrapKey<&'a [f64]> {
         }
     }
 
+    pub fn batch_bootstrap_scratch(
+        bsk_glwe_params: GlweParams,
+        batch_size: usize,
+        fft: FftView<'_>,
+    ) -> Result<StackReq, SizeOverflow> {
+        StackReq::try_all_of([
+            StackReq::try_new_aligned::<u64>(
+                batch_size * (bsk_glwe_params.dimension + 1) * bsk_glwe_params.polynomial_size,
+                CACHELINE_ALIGN,
+            )?,
+            Self::blind_rotate_scratch(bsk_glwe_params, fft)?,
+        ])
+    }
+
+    /// Bootstraps a batch of ciphertexts against a shared accumulator,
+    /// walking the bootstrap key in the outer loop: every GGSW block is
+    /// read once per batch instead of once per ciphertext, so the key
+    /// traffic out of the last-level cache no longer scales with the
+    /// batch size.
+    pub fn batch_bootstrap(
+        self,
+        lwe_out_list: &mut [u64],
+        lwe_in_list: &[u64],
+        accumulator: GlweCiphertext<&[u64]>,
+        fft: FftView<'_>,
+        stack: DynStack<'_>,
+    ) {
+        let glwe_params = accumulator.glwe_params;
+        let lut_poly_size = glwe_params.polynomial_size;
+        let glwe_len = (glwe_params.dimension + 1) * lut_poly_size;
+        let in_lwe_len = self.input_lwe_dimension + 1;
+        let out_lwe_len = glwe_params.lwe_dimension() + 1;
+        let batch_size = lwe_in_list.len() / in_lwe_len;
+        debug_assert_eq!(lwe_in_list.len(), batch_size * in_lwe_len);
+        debug_assert_eq!(lwe_out_list.len(), batch_size * out_lwe_len);
+
+        // One accumulator per ciphertext, rotated by its body coefficient.
+        let (mut accumulators, mut stack) = stack.collect_aligned(
+            CACHELINE_ALIGN,
+            (0..batch_size).flat_map(|_| accumulator.as_view().into_data().iter().copied()),
+        );
+        for (acc, lwe_in) in zip_eq(
+            accumulators.chunks_exact_mut(glwe_len),
+            lwe_in_list.chunks_exact(in_lwe_len),
+        ) {
+            let modulus_switched_body =
+                pbs_modulus_switch(lwe_in[in_lwe_len - 1], lut_poly_size, 0, 0);
+            let acc = GlweCiphertext::new(acc, glwe_params);
+            for polynomial in acc.into_polynomial_list().iter_polynomial() {
+                update_with_wrapping_unit_monomial_div(polynomial, modulus_switched_body);
+            }
+        }
+
+        // Blind rotation with the key in the outer loop: all the cmuxes
+        // against a GGSW block run back to back while the block is hot.
+        for (ggsw_index, bootstrap_key_ggsw) in self.into_ggsw_iter().enumerate() {
+            for (acc, lwe_in) in zip_eq(
+                accumulators.chunks_exact_mut(glwe_len),
+                lwe_in_list.chunks_exact(in_lwe_len),
+            ) {
+                let lwe_mask_element = lwe_in[ggsw_index];
+                if lwe_mask_element != 0 {
+                    let stack = stack.rb_mut();
+                    let mut ct0 = GlweCiphertext::new(acc, glwe_params);
+                    let (mut ct1, stack) = stack.collect_aligned(
+                        CACHELINE_ALIGN,
+                        ct0.as_view().into_data().iter().copied(),
+                    );
+                    let mut ct1 = GlweCiphertext::new(&mut *ct1, glwe_params);
+
+                    let modulus_switched_mask_element =
+                        pbs_modulus_switch(lwe_mask_element, lut_poly_size, 0, 0);
+                    for polynomial in ct1.as_mut_view().into_polynomial_list().iter_polynomial() {
+                        update_with_wrapping_monic_monomial_mul(
+                            polynomial,
+                            modulus_switched_mask_element,
+                        );
+                    }
+
+                    cmux(
+                        ct0.as_mut_view(),
+                        ct1.as_mut_view(),
+                        bootstrap_key_ggsw,
+                        fft,
+                        stack,
+                    );
+                }
+            }
+        }
+
+        for (acc, lwe_out) in zip_eq(
+            accumulators.chunks_exact(glwe_len),
+            lwe_out_list.chunks_exact_mut(out_lwe_len),
+        ) {
+            GlweCiphertext::new(acc, glwe_params).fill_lwe_with_sample_extraction(
+                LweCiphertext::new(lwe_out, glwe_params.lwe_dimension()),
+                0,
+            );
+        }
+    }
+
     pub fn bootstrap(
         self,
         lwe_out: LweCiphertext<&mut [u64]>,
@@ -189,6 +189,108 @@ impl BootstrapKey<&mut [u64]> {
     }
 }
 
+impl BootstrapKey<&mut [u64]> {
+    // Same as `fill_with_new_key`, with the masks drawn from `mask_csprng`
+    // only. Seeding `mask_csprng` from a public seed makes the masks
+    // replayable: `fill_from_seeded_bodies` rebuilds the full key from the
+    // seed and the stored bodies alone.
+    pub fn fill_with_new_key_seeded(
+        self,
+        lwe_sk: LweSecretKey<&[u64]>,
+        glwe_sk: GlweSecretKey<&[u64]>,
+        variance: f64,
+        mut mask_csprng: CsprngMut<'_, '_>,
+        mut noise_csprng: CsprngMut<'_, '_>,
+    ) {
+        for (mut ggsw, sk_scalar) in
+            zip_eq(self.into_ggsw_iter(), lwe_sk.into_data().iter().copied())
+        {
+            let encoded = sk_scalar;
+            glwe_sk.gen_noise_ggsw_seeded(
+                ggsw.as_mut_view(),
+                variance,
+                mask_csprng.as_mut(),
+                noise_csprng.as_mut(),
+            );
+            glwe_sk.encrypt_constant_ggsw_noise_full(ggsw, encoded);
+        }
+    }
+
+    // Rebuilds a full key from its seeded form: the masks are replayed from
+    // `mask_csprng` (built over the public seed used at generation time, so
+    // it yields the exact byte stream the generation drew from) and the
+    // stored bodies are copied back in place.
+    pub fn fill_from_seeded_bodies(self, seeded: &[u64], mut mask_csprng: CsprngMut<'_, '_>) {
+        let polynomial_size = self.glwe_params.polynomial_size;
+        let mut bodies = seeded.chunks_exact(polynomial_size);
+        for ggsw in self.into_ggsw_iter() {
+            let glwe_params = ggsw.glwe_params;
+            for matrix in ggsw.into_level_matrices_iter() {
+                for row in matrix.into_rows_iter() {
+                    let glwe = GlweCiphertext::new(row.into_data(), glwe_params);
+                    let (mut mask, body) = glwe.into_mask_and_body();
+                    fill_with_random_uniform(mask.as_mut_view().into_data(), mask_csprng.as_mut());
+                    body.into_data().copy_from_slice(bodies.next().unwrap());
+                }
+            }
+        }
+        debug_assert!(bodies.next().is_none());
+    }
+}
+
+impl BootstrapKey<&[u64]> {
+    // Copies the body polynomial of every glwe row into `seeded`, the
+    // bodies-only representation shipped next to the public mask seed.
+    pub fn extract_seeded_bodies(self, seeded: &mut [u64]) {
+        let polynomial_size = self.glwe_params.polynomial_size;
+        let mut bodies = seeded.chunks_exact_mut(polynomial_size);
+        for ggsw in self.into_ggsw_iter() {
+            let glwe_params = ggsw.glwe_params;
+            for matrix in ggsw.into_level_matrices_iter() {
+                for row in matrix.into_rows_iter() {
+                    let glwe = GlweCiphertext::new(row.into_data(), glwe_params);
+                    bodies
+                        .next()
+                        .unwrap()
+                        .copy_from_slice(glwe.into_body().into_data());
+                }
+            }
+        }
+        debug_assert!(bodies.next().is_none());
+    }
+}
+
+#[cfg(feature = "parallel")]
+impl BootstrapKey<&mut [u64]> {
+    pub fn fill_with_new_key_seeded_par(
+        mut self,
+        lwe_sk: LweSecretKey<&[u64]>,
+        glwe_sk: GlweSecretKey<&[u64]>,
+        variance: f64,
+        mut mask_csprng: CsprngMut<'_, '_>,
+        mut noise_csprng: CsprngMut<'_, '_>,
+    ) {
+        // The serial noise pass consumes the mask stream in the same row
+        // order as the serial variant, so the masks do not depend on the
+        // parallelism mode the key was generated with.
+        for ggsw in self.as_mut_view().into_ggsw_iter() {
+            glwe_sk.gen_noise_ggsw_seeded(
+                ggsw,
+                variance,
+                mask_csprng.as_mut(),
+                noise_csprng.as_mut(),
+            );
+        }
+
+        self.into_ggsw_iter_par()
+            .zip_eq(lwe_sk.data)
+            .for_each(|(ggsw, sk_scalar)| {
+                let encoded = *sk_scalar;
+                glwe_sk.encrypt_constant_ggsw_noise_full(ggsw, encoded);
+            });
+    }
+}
+
 impl LweKeyswitchKey<&mut [u64]> {
     pub fn fill_with_keyswitch_key(
         self,
@@ -217,6 +319,69 @@ impl LweKeyswitchKey<&mut [u64]> {
             }
         }
     }
+
+    // Same as `fill_with_keyswitch_key`, with the masks drawn from
+    // `mask_csprng` only (see `BootstrapKey::fill_with_new_key_seeded`).
+    pub fn fill_with_keyswitch_key_seeded(
+        self,
+        input_key: LweSecretKey<&[u64]>,
+        output_key: LweSecretKey<&[u64]>,
+        variance: f64,
+        mut mask_csprng: CsprngMut<'_, '_>,
+        mut noise_csprng: CsprngMut<'_, '_>,
+    ) {
+        let decomposition_level_count = self.decomp_params.level;
+        let decomposition_base_log = self.decomp_params.base_log;
+
+        for (input_key_bit, keyswitch_key_block) in zip_eq(
+            input_key.into_data().iter().copied(),
+            self.into_lev_ciphertexts(),
+        ) {
+            for (lwe, message) in zip_eq(
+                keyswitch_key_block.into_ciphertext_iter(),
+                (1..(decomposition_level_count + 1)).map(|level| {
+                    let shift = u64::BITS as usize - decomposition_base_log * level;
+                    input_key_bit << shift
+                }),
+            ) {
+                output_key.encrypt_lwe_seeded(
+                    lwe,
+                    message,
+                    variance,
+                    mask_csprng.as_mut(),
+                    noise_csprng.as_mut(),
+                );
+            }
+        }
+    }
+
+    // Rebuilds a full key from its seeded form: one stored body word per
+    // ciphertext, masks replayed from `mask_csprng`.
+    pub fn fill_from_seeded_bodies(self, seeded: &[u64], mut mask_csprng: CsprngMut<'_, '_>) {
+        let mut bodies = seeded.iter().copied();
+        for keyswitch_key_block in self.into_lev_ciphertexts() {
+            for lwe in keyswitch_key_block.into_ciphertext_iter() {
+                let (body, mask) = lwe.into_data().split_last_mut().unwrap();
+                fill_with_random_uniform(mask, mask_csprng.as_mut());
+                *body = bodies.next().unwrap();
+            }
+        }
+        debug_assert!(bodies.next().is_none());
+    }
+}
+
+impl LweKeyswitchKey<&[u64]> {
+    // Copies the body of every ciphertext into `seeded`, the bodies-only
+    // representation shipped next to the public mask seed.
+    pub fn extract_seeded_bodies(self, seeded: &mut [u64]) {
+        let mut bodies = seeded.iter_mut();
+        for keyswitch_key_block in self.into_lev_ciphertexts() {
+            for lwe in keyswitch_key_block.into_ciphertext_iter() {
+                *bodies.next().unwrap() = *lwe.into_data().last().unwrap();
+            }
+        }
+        debug_assert!(bodies.next().is_none());
+    }
 }
 
 impl PackingKeyswitchKey<&mut [u64]> {
@@ -562,6 +727,42 @@ impl GlweSecretKey<&[u64]> {
         fill_with_random_gaussian(body.as_mut_view().into_data(), variance, csprng);
     }
 
+    pub fn gen_noise_ggsw_seeded(
+        self,
+        ggsw: GgswCiphertext<&mut [u64]>,
+        variance: f64,
+        mut mask_csprng: CsprngMut<'_, '_>,
+        mut noise_csprng: CsprngMut<'_, '_>,
+    ) {
+        let glwe_params = ggsw.glwe_params;
+
+        for matrix in ggsw.into_level_matrices_iter() {
+            for row in matrix.into_rows_iter() {
+                self.gen_noise_glwe_seeded(
+                    GlweCiphertext::new(row.into_data(), glwe_params),
+                    variance,
+                    mask_csprng.as_mut(),
+                    noise_csprng.as_mut(),
+                );
+            }
+        }
+    }
+
+    // Same as `gen_noise_glwe`, with the (public) mask and the (secret)
+    // noise drawn from separate streams so that the mask can be replayed
+    // from a seed.
+    pub fn gen_noise_glwe_seeded(
+        self,
+        encrypted: GlweCiphertext<&mut [u64]>,
+        variance: f64,
+        mask_csprng: CsprngMut<'_, '_>,
+        noise_csprng: CsprngMut<'_, '_>,
+    ) {
+        let (mut mask, mut body) = encrypted.into_mask_and_body();
+        fill_with_random_uniform(mask.as_mut_view().into_data(), mask_csprng);
+        fill_with_random_gaussian(body.as_mut_view().into_data(), variance, noise_csprng);
+    }
+
     pub fn encrypt_constant_ggsw_noise_full(self, ggsw: GgswCiphertext<&mut [u64]>, encoded: u64) {
         let base_log = ggsw.decomp_params.base_log;
 
@@ -637,6 +838,27 @@ impl LweSecretKey<&[u64]> {
         *body = body.wrapping_add(plaintext);
     }
 
+    // Same as `encrypt_lwe`, with the mask drawn from `mask_csprng` only
+    // so that it can be replayed from a seed.
+    pub fn encrypt_lwe_seeded(
+        self,
+        encrypted: LweCiphertext<&mut [u64]>,
+        plaintext: u64,
+        variance: f64,
+        mask_csprng: CsprngMut<'_, '_>,
+        noise_csprng: CsprngMut<'_, '_>,
+    ) {
+        let (body, mask) = encrypted.into_data().split_last_mut().unwrap();
+
+        fill_with_random_uniform(mask, mask_csprng);
+        *body = from_torus(random_gaussian_pair(variance, noise_csprng).0);
+        *body = body.wrapping_add(
+            zip_eq(mask.iter().copied(), self.into_data().iter().copied())
+                .fold(0_u64, |acc, (lhs, rhs)| acc.wrapping_add(lhs * rhs)),
+        );
+        *body = body.wrapping_add(plaintext);
+    }
+
     pub fn decrypt_lwe(self, encrypted: LweCiphertext<&[u64]>) -> u64 {
         let (body, mask) = encrypted.into_data().split_last().unwrap();
 
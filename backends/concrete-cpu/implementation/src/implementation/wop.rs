@@ -798,6 +798,68 @@ pub fn circuit_bootstrap_boolean_vertical_packing(
     }
 }
 
+pub fn circuit_bootstrap_boolean_fourier_ggsw_scratch(
+    lwe_in_size: usize,
+    bsk_output_lwe_size: usize,
+    glwe_params: GlweParams,
+    level_cbs: usize,
+    fft: FftView<'_>,
+) -> Result<StackReq, SizeOverflow> {
+    StackReq::try_all_of([
+        StackReq::try_new_aligned::<u64>(
+            glwe_params.polynomial_size
+                * (glwe_params.dimension + 1)
+                * (glwe_params.dimension + 1)
+                * level_cbs,
+            CACHELINE_ALIGN,
+        )?,
+        StackReq::try_any_of([
+            circuit_bootstrap_boolean_scratch(lwe_in_size, bsk_output_lwe_size, glwe_params, fft)?,
+            fft.forward_scratch()?,
+        ])?,
+    ])
+}
+
+/// Compute the Fourier GGSW ciphertext of a single boolean LWE input, i.e. the
+/// per-bit circuit bootstrap stage of [`circuit_bootstrap_boolean_vertical_packing`].
+///
+/// Input bits are independent, so callers may fan the per-bit calls out over
+/// threads (each with its own stack) and hand the assembled GGSW list to
+/// [`vertical_packing`] once all of them completed.
+pub fn circuit_bootstrap_boolean_fourier_ggsw(
+    ggsw_out: GgswCiphertext<&mut [f64]>,
+    fourier_bsk: BootstrapKey<&[f64]>,
+    lwe_in: LweCiphertext<&[u64]>,
+    fpksk_list: PackingKeyswitchKeyList<&[u64]>,
+    cbs_dp: DecompParams,
+    fft: FftView<'_>,
+    stack: DynStack<'_>,
+) {
+    let glwe_params = fpksk_list.glwe_params;
+
+    let (mut ggsw_res_data, mut stack) = stack.make_aligned_with(
+        glwe_params.polynomial_size
+            * (glwe_params.dimension + 1)
+            * (glwe_params.dimension + 1)
+            * cbs_dp.level,
+        CACHELINE_ALIGN,
+        |_| 0_u64,
+    );
+    let mut ggsw_res = GgswCiphertext::new(&mut *ggsw_res_data, glwe_params, cbs_dp);
+
+    circuit_bootstrap_boolean(
+        fourier_bsk,
+        lwe_in,
+        ggsw_res.as_mut_view(),
+        u64::BITS as usize - 1,
+        fpksk_list,
+        fft,
+        stack.rb_mut(),
+    );
+
+    ggsw_out.fill_with_forward_fourier(ggsw_res.as_view(), fft, stack.rb_mut());
+}
+
 fn print_ct(ct: u64) {
     print!("{}", (((ct >> 53) + 1) >> 1) % (1 << 10));
 }
@@ -3,6 +3,17 @@
 
 #include <cstdint>
 
+/* Gate opcodes understood by cuda_boolean_gate_wave_32. NOT is purely
+ * linear and stays on cuda_boolean_not_32. */
+enum cuda_boolean_gate_type {
+  CUDA_BOOLEAN_GATE_AND = 0,
+  CUDA_BOOLEAN_GATE_NAND = 1,
+  CUDA_BOOLEAN_GATE_NOR = 2,
+  CUDA_BOOLEAN_GATE_OR = 3,
+  CUDA_BOOLEAN_GATE_XOR = 4,
+  CUDA_BOOLEAN_GATE_XNOR = 5,
+};
+
 extern "C" {
 
 void cuda_boolean_not_32(void *v_stream, uint32_t gpu_index,
@@ -69,6 +80,14 @@ void cuda_boolean_xnor_32(void *v_stream, uint32_t gpu_index,
                           uint32_t ks_base_log, uint32_t ks_level_count,
                           uint32_t input_lwe_ciphertext_count,
                           uint32_t max_shared_memory);
+
+void cuda_boolean_gate_wave_32(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out,
+    void *lwe_array_in_1, void *lwe_array_in_2, uint32_t *gate_types,
+    void *bootstrapping_key, void *ksk, uint32_t input_lwe_dimension,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level_count, uint32_t ks_base_log, uint32_t ks_level_count,
+    uint32_t gate_count, uint32_t max_shared_memory);
 }
 
 #endif // CUDA_BOOLAN_GATES_H
@@ -9,6 +9,14 @@ void cuda_fourier_polynomial_mul(void *input1, void *input2, void *output,
                                  uint32_t polynomial_size,
                                  uint32_t total_polynomials);
 
+void cuda_fourier_polynomial_mul_f32(void *input1, void *input2, void *output,
+                                     void *v_stream, uint32_t gpu_index,
+                                     uint32_t polynomial_size,
+                                     uint32_t total_polynomials);
+
+uint32_t cuda_get_pbs_fft_precision(uint32_t polynomial_size,
+                                    uint32_t base_log, uint32_t level_count);
+
 void cuda_convert_lwe_bootstrap_key_32(void *dest, void *src, void *v_stream,
                                        uint32_t gpu_index,
                                        uint32_t input_lwe_dim,
@@ -21,6 +29,13 @@ void cuda_convert_lwe_bootstrap_key_64(void *dest, void *src, void *v_stream,
                                        uint32_t glwe_dim, uint32_t level_count,
                                        uint32_t polynomial_size);
 
+void cuda_convert_lwe_bootstrap_key_64_f32(void *dest, void *src,
+                                           void *v_stream, uint32_t gpu_index,
+                                           uint32_t input_lwe_dim,
+                                           uint32_t glwe_dim,
+                                           uint32_t level_count,
+                                           uint32_t polynomial_size);
+
 void scratch_cuda_bootstrap_amortized_32(void *v_stream, uint32_t gpu_index,
                                          int8_t **pbs_buffer,
                                          uint32_t glwe_dimension,
@@ -53,6 +68,14 @@ void cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
     uint32_t num_samples, uint32_t num_lut_vectors, uint32_t lwe_idx,
     uint32_t max_shared_memory);
 
+void cuda_bootstrap_amortized_pipelined_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, uint64_t *lwe_array_out_host,
+    void *lut_vector, void *lut_vector_indexes, uint64_t *lwe_array_in_host,
+    void *bootstrapping_key, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t max_shared_memory,
+    uint32_t tile_samples);
+
 void cleanup_cuda_bootstrap_amortized(void *v_stream, uint32_t gpu_index,
                                       int8_t **pbs_buffer);
 
@@ -87,6 +110,59 @@ void cuda_bootstrap_low_latency_lwe_ciphertext_vector_64(
 void cleanup_cuda_bootstrap_low_latency(void *v_stream, uint32_t gpu_index,
                                         int8_t **pbs_buffer);
 
+void scratch_cuda_bootstrap_dispatch_64(
+    void *v_stream, uint32_t gpu_index, int8_t **pbs_buffer,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t level_count,
+    uint32_t input_lwe_ciphertext_count, uint32_t max_shared_memory,
+    bool allocate_gpu_memory);
+
+void cuda_bootstrap_dispatch_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *bootstrapping_key,
+    int8_t *pbs_buffer, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t lwe_idx,
+    uint32_t max_shared_memory);
+
+void cleanup_cuda_bootstrap_dispatch(void *v_stream, uint32_t gpu_index,
+                                     int8_t **pbs_buffer);
+
+void cuda_keyswitch_bootstrap_amortized_lwe_ciphertext_vector_32(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory);
+
+void cuda_keyswitch_bootstrap_amortized_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory);
+
+void cuda_keyswitch_bootstrap_low_latency_lwe_ciphertext_vector_32(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory);
+
+void cuda_keyswitch_bootstrap_low_latency_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory);
+
 void scratch_cuda_circuit_bootstrap_vertical_packing_32(
     void *v_stream, uint32_t gpu_index, int8_t **cbs_vp_buffer,
     uint32_t *cbs_delta_log, uint32_t glwe_dimension, uint32_t lwe_dimension,
@@ -143,6 +219,17 @@ void cuda_wop_pbs_64(void *v_stream, uint32_t gpu_index, void *lwe_array_out,
                      uint32_t *delta_log_array, uint32_t crt_decomposition_size,
                      uint32_t max_shared_memory);
 
+void cuda_wop_pbs_multi_gpu_64(
+    void *const *v_streams, uint32_t const *gpu_indexes, uint32_t gpu_count,
+    void *lwe_array_out, void *lwe_array_in, void *lut_vector,
+    void *const *fourier_bsk_per_gpu, void *const *ksk_per_gpu,
+    void *const *cbs_fpksk_per_gpu, uint32_t glwe_dimension,
+    uint32_t lwe_dimension, uint32_t polynomial_size, uint32_t base_log_bsk,
+    uint32_t level_count_bsk, uint32_t base_log_ksk, uint32_t level_count_ksk,
+    uint32_t base_log_pksk, uint32_t level_count_pksk, uint32_t base_log_cbs,
+    uint32_t level_count_cbs, uint32_t *number_of_bits_to_extract_array,
+    uint32_t crt_decomposition_size, uint32_t max_shared_memory);
+
 void cleanup_cuda_wop_pbs(void *v_stream, uint32_t gpu_index,
                           int8_t **wop_pbs_buffer);
 
@@ -32,6 +32,32 @@ __host__ uint32_t get_lwe_chunk_size(uint32_t lwe_dimension,
                                      uint32_t glwe_dimension,
                                      uint32_t num_samples);
 
+// Autotuned chunk size resolution: returns the benchmarked winner for the
+// parameter set when one is known (in memory or in the on-disk tuning
+// cache), the get_lwe_chunk_size heuristic otherwise.
+__host__ uint32_t get_tuned_lwe_chunk_size(
+    uint32_t gpu_index, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t level_count, uint32_t grouping_factor,
+    uint32_t num_samples);
+
+__host__ bool has_tuned_lwe_chunk_size(uint32_t gpu_index,
+                                       uint32_t lwe_dimension,
+                                       uint32_t glwe_dimension,
+                                       uint32_t polynomial_size,
+                                       uint32_t level_count,
+                                       uint32_t grouping_factor,
+                                       uint32_t num_samples);
+
+// Benchmark candidate chunk sizes with real arguments, record the winner
+// in the tuning cache and return it.
+__host__ uint32_t tune_multi_bit_pbs_chunk_size_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *bootstrapping_key,
+    uint32_t lwe_dimension, uint32_t glwe_dimension, uint32_t polynomial_size,
+    uint32_t grouping_factor, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t lwe_idx,
+    uint32_t max_shared_memory);
+
 __host__ uint64_t get_max_buffer_size_multibit_bootstrap(
     uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t level_count,
     uint32_t max_input_lwe_ciphertext_count);
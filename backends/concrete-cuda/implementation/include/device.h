@@ -50,6 +50,8 @@ int cuda_get_max_shared_memory(uint32_t gpu_index);
 
 int cuda_synchronize_stream(void *v_stream);
 
+void cuda_drop_pinned_buffer_pool();
+
 #define check_cuda_error(ans)                                                  \
   { cuda_error((ans), __FILE__, __LINE__); }
 inline void cuda_error(cudaError_t code, const char *file, int line,
@@ -284,6 +284,13 @@ __host__ void host_single_ciphertext_extract_bits(
  * Host function for cuda extract bits.
  * it executes device functions in specific order and manages
  * parallelism
+ *
+ * Independent ciphertexts are pipelined through the extraction chain:
+ * each one runs on its own sub-stream, and the chain is enqueued
+ * breadth-first, one extraction step per ciphertext per round. This way
+ * the levelled steps of one ciphertext reach the GPU while another is
+ * still waiting on its PBS, instead of the whole chain of ciphertext A
+ * being enqueued before the first kernel of ciphertext B.
  */
 template <typename Torus, class params>
 __host__ void
@@ -299,10 +306,21 @@ host_extract_bits(void *v_stream, uint32_t gpu_index, Torus *list_lwe_array_out,
 
   cudaSetDevice(gpu_index);
   auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint32_t ciphertext_n_bits = sizeof(Torus) * 8;
 
+  int threads = params::degree / params::opt;
+
+  cudaEvent_t event;
+  cudaEventCreate(&event);
+
+  // The sub-streams must not start before work already enqueued on the
+  // caller's stream (e.g. input transfers, buffer initialization) has
+  // completed
+  cudaEventRecord(event, *stream);
   cudaStream_t *sub_streams[crt_decomposition_size];
   for (int i = 0; i < crt_decomposition_size; i++) {
     sub_streams[i] = cuda_create_stream(gpu_index);
+    cudaStreamWaitEvent(*(sub_streams[i]), event, 0);
   }
 
   int bit_extract_buffer_size =
@@ -312,25 +330,114 @@ host_extract_bits(void *v_stream, uint32_t gpu_index, Torus *list_lwe_array_out,
           glwe_dimension, polynomial_size, level_count_bsk, 1,
           max_shared_memory);
 
+  // Per-ciphertext slices of the bit_extract_buffer, laid out as in
+  // host_single_ciphertext_extract_bits
+  int8_t *pbs_buffer[crt_decomposition_size];
+  Torus *lut_pbs[crt_decomposition_size];
+  Torus *lwe_array_in_buffer[crt_decomposition_size];
+  Torus *lwe_array_in_shifted_buffer[crt_decomposition_size];
+  Torus *lwe_array_out_ks_buffer[crt_decomposition_size];
+  Torus *lwe_array_out_pbs_buffer[crt_decomposition_size];
+  Torus *lut_vector_indexes[crt_decomposition_size];
+  Torus *cur_output_lwe_array[crt_decomposition_size];
+
+  uint32_t max_number_of_bits = 0;
   int cur_total_lwe = 0;
   for (int i = 0; i < crt_decomposition_size; i++) {
-    uint32_t number_of_bits = number_of_bits_array[i];
-    auto cur_input_lwe = &lwe_array_in[i * (lwe_dimension_in + 1)];
-    auto cur_output_lwe_array =
+    pbs_buffer[i] = &bit_extract_buffer[i * bit_extract_buffer_size];
+    lut_pbs[i] =
+        (Torus *)pbs_buffer[i] +
+        (ptrdiff_t)(get_buffer_size_bootstrap_fast_low_latency<Torus>(
+                        glwe_dimension, polynomial_size, level_count_bsk, 1,
+                        max_shared_memory) /
+                    sizeof(Torus));
+    lwe_array_in_buffer[i] =
+        lut_pbs[i] + (ptrdiff_t)((glwe_dimension + 1) * polynomial_size);
+    lwe_array_in_shifted_buffer[i] =
+        lwe_array_in_buffer[i] +
+        (ptrdiff_t)(glwe_dimension * polynomial_size + 1);
+    lwe_array_out_ks_buffer[i] =
+        lwe_array_in_shifted_buffer[i] +
+        (ptrdiff_t)(glwe_dimension * polynomial_size + 1);
+    lwe_array_out_pbs_buffer[i] =
+        lwe_array_out_ks_buffer[i] + (ptrdiff_t)(lwe_dimension_out + 1);
+    lut_vector_indexes[i] =
+        lwe_array_out_pbs_buffer[i] +
+        (ptrdiff_t)(glwe_dimension * polynomial_size + 1);
+    cur_output_lwe_array[i] =
         &list_lwe_array_out[cur_total_lwe * (lwe_dimension_out + 1)];
-    auto cur_bit_extract_buffer =
-        &bit_extract_buffer[i * bit_extract_buffer_size];
-    host_single_ciphertext_extract_bits<Torus, params>(
-        (void *)sub_streams[i], gpu_index, cur_output_lwe_array, cur_input_lwe,
-        cur_bit_extract_buffer, ksk, fourier_bsk, number_of_bits,
-        delta_log_array[i], lwe_dimension_in, lwe_dimension_out, glwe_dimension,
-        polynomial_size, base_log_bsk, level_count_bsk, base_log_ksk,
-        level_count_ksk, max_shared_memory);
     cur_total_lwe += number_of_bits_array[i];
+    if (number_of_bits_array[i] > max_number_of_bits)
+      max_number_of_bits = number_of_bits_array[i];
   }
 
-  cudaEvent_t event;
-  cudaEventCreate(&event);
+  // Shift every input on the padding bit and copy it in its state buffer
+  for (int i = 0; i < crt_decomposition_size; i++) {
+    auto cur_input_lwe = &lwe_array_in[i * (lwe_dimension_in + 1)];
+    check_cuda_error(
+        cudaMemcpyAsync(lwe_array_in_buffer[i], cur_input_lwe,
+                        (glwe_dimension * polynomial_size + 1) * sizeof(Torus),
+                        cudaMemcpyDeviceToDevice, *(sub_streams[i])));
+    copy_and_shift_lwe<Torus, params>
+        <<<glwe_dimension, threads, 0, *(sub_streams[i])>>>(
+            lwe_array_in_shifted_buffer[i], cur_input_lwe,
+            (Torus)(1ll << (ciphertext_n_bits - delta_log_array[i] - 1)),
+            glwe_dimension);
+    check_cuda_error(cudaGetLastError());
+  }
+
+  for (uint32_t bit_idx = 0; bit_idx < max_number_of_bits; bit_idx++) {
+    for (int i = 0; i < crt_decomposition_size; i++) {
+      uint32_t number_of_bits = number_of_bits_array[i];
+      if (bit_idx >= number_of_bits)
+        continue;
+      uint32_t delta_log = delta_log_array[i];
+      auto sub_stream = (void *)sub_streams[i];
+
+      cuda_keyswitch_lwe_ciphertext_vector(
+          sub_stream, gpu_index, lwe_array_out_ks_buffer[i],
+          lwe_array_in_shifted_buffer[i], ksk, lwe_dimension_in,
+          lwe_dimension_out, base_log_ksk, level_count_ksk, 1);
+      copy_small_lwe<<<1, 256, 0, *(sub_streams[i])>>>(
+          cur_output_lwe_array[i], lwe_array_out_ks_buffer[i],
+          lwe_dimension_out + 1, number_of_bits,
+          number_of_bits - bit_idx - 1);
+      check_cuda_error(cudaGetLastError());
+
+      if (bit_idx == number_of_bits - 1) {
+        continue;
+      }
+
+      // Add q/4 to center the error while computing a negacyclic LUT
+      add_to_body<Torus><<<1, 1, 0, *(sub_streams[i])>>>(
+          lwe_array_out_ks_buffer[i], lwe_dimension_out,
+          (Torus)(1ll << (ciphertext_n_bits - 2)));
+      check_cuda_error(cudaGetLastError());
+
+      // Fill lut for the current bit (equivalent to trivial encryption as
+      // mask is 0s) The LUT is filled with -alpha in each coefficient where
+      // alpha = delta*2^{bit_idx-1}
+      fill_lut_body_for_current_bit<Torus, params>
+          <<<1, threads, 0, *(sub_streams[i])>>>(
+              lut_pbs[i], (Torus)(0ll - 1ll << (delta_log - 1 + bit_idx)),
+              glwe_dimension);
+      check_cuda_error(cudaGetLastError());
+      host_bootstrap_fast_low_latency<Torus, params>(
+          sub_stream, gpu_index, lwe_array_out_pbs_buffer[i], lut_pbs[i],
+          lut_vector_indexes[i], lwe_array_out_ks_buffer[i], fourier_bsk,
+          pbs_buffer[i], glwe_dimension, lwe_dimension_out, polynomial_size,
+          base_log_bsk, level_count_bsk, 1, 1, max_shared_memory);
+
+      // Add alpha where alpha = delta*2^{bit_idx-1} to end up with an
+      // encryption of 0 if the extracted bit was 0 and 1 in the other case
+      add_sub_and_mul_lwe<Torus, params><<<1, threads, 0, *(sub_streams[i])>>>(
+          lwe_array_in_shifted_buffer[i], lwe_array_in_buffer[i],
+          lwe_array_out_pbs_buffer[i], (Torus)(1ll << (delta_log - 1 + bit_idx)),
+          (Torus)(1ll << (ciphertext_n_bits - delta_log - bit_idx - 2)),
+          glwe_dimension);
+      check_cuda_error(cudaGetLastError());
+    }
+  }
 
   for (int i = 0; i < crt_decomposition_size; i++) {
     cudaEventRecord(event, *(sub_streams[i]));
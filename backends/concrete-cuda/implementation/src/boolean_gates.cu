@@ -1,6 +1,7 @@
 #ifndef CUDA_BOOLEAN_GATES_CU
 #define CUDA_BOOLEAN_GATES_CU
 
+#include "boolean_gates.h"
 #include "bootstrap.h"
 #include "device.h"
 #include "keyswitch.h"
@@ -683,4 +684,147 @@ extern "C" void cuda_boolean_xnor_32(
 
   cuda_drop_async(lwe_pbs_buffer, stream, gpu_index);
 }
+
+/*
+ * Linear phase of a wave of mixed boolean gates. Each gate of the wave is
+ * one block; 'gate_types' selects the linear combination applied to the
+ * pair of input ciphertexts before the shared PBS:
+ *   AND:        a + b + false
+ *   NAND:    -( a + b ) + true
+ *   NOR:     -( a + b ) + false
+ *   OR:         a + b + true
+ *   XOR:     2*( a + b + true )
+ *   XNOR:    2*(-( a + b ) - true )
+ * The plaintext constants only touch the body, so they are folded into
+ * the last coefficient of each output ciphertext.
+ */
+__global__ void device_boolean_gates_linear_phase(uint32_t *lwe_array_out,
+                                                  uint32_t *lwe_array_in_1,
+                                                  uint32_t *lwe_array_in_2,
+                                                  uint32_t *gate_types,
+                                                  uint32_t lwe_size) {
+  uint32_t gate_id = blockIdx.x;
+  uint32_t gate_type = gate_types[gate_id];
+
+  uint32_t sign = (gate_type == CUDA_BOOLEAN_GATE_NAND ||
+                   gate_type == CUDA_BOOLEAN_GATE_NOR ||
+                   gate_type == CUDA_BOOLEAN_GATE_XNOR)
+                      ? (uint32_t)-1
+                      : (uint32_t)1;
+  uint32_t factor = (gate_type == CUDA_BOOLEAN_GATE_XOR ||
+                     gate_type == CUDA_BOOLEAN_GATE_XNOR)
+                        ? 2
+                        : 1;
+  uint32_t constant = (gate_type == CUDA_BOOLEAN_GATE_AND ||
+                       gate_type == CUDA_BOOLEAN_GATE_NOR)
+                          ? PLAINTEXT_FALSE
+                          : PLAINTEXT_TRUE;
+  // XNOR subtracts "true" after the negation instead of adding it
+  if (gate_type == CUDA_BOOLEAN_GATE_XNOR)
+    constant = (uint32_t)-(int32_t)constant;
+
+  uint32_t *cur_in_1 = &lwe_array_in_1[gate_id * lwe_size];
+  uint32_t *cur_in_2 = &lwe_array_in_2[gate_id * lwe_size];
+  uint32_t *cur_out = &lwe_array_out[gate_id * lwe_size];
+
+  for (uint32_t tid = threadIdx.x; tid < lwe_size; tid += blockDim.x) {
+    uint32_t value = factor * (sign * (cur_in_1[tid] + cur_in_2[tid]));
+    if (tid == lwe_size - 1)
+      value += factor * constant;
+    cur_out[tid] = value;
+  }
+}
+
+/*
+ * Execute a wave of boolean gates in one fused sequence of launches.
+ * 'lwe_array_in_1'/'lwe_array_in_2' hold the pair of input ciphertexts of
+ * each gate of the wave, 'gate_types' is a host array of 'gate_count'
+ * entries from cuda_boolean_gate_type (NOT is linear only and is excluded,
+ * use cuda_boolean_not_32). Instead of one launch sequence per gate type,
+ * the whole wave goes through a single opcode-driven linear kernel, one
+ * batched PBS sharing one scratch and LUT (all gates map onto the same
+ * negacyclic "true" LUT once their linear part is applied), and one
+ * batched keyswitch.
+ */
+extern "C" void cuda_boolean_gate_wave_32(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out,
+    void *lwe_array_in_1, void *lwe_array_in_2, uint32_t *gate_types,
+    void *bootstrapping_key, void *ksk, uint32_t input_lwe_dimension,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level_count, uint32_t ks_base_log, uint32_t ks_level_count,
+    uint32_t gate_count, uint32_t max_shared_memory) {
+
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint32_t lwe_size = input_lwe_dimension + 1;
+
+  // 1. Apply the per-gate linear combinations in one launch
+  uint32_t *d_gate_types = (uint32_t *)cuda_malloc_async(
+      gate_count * sizeof(uint32_t), stream, gpu_index);
+  cuda_memcpy_async_to_gpu(d_gate_types, gate_types,
+                           gate_count * sizeof(uint32_t), stream, gpu_index);
+  uint32_t *lwe_buffer = (uint32_t *)cuda_malloc_async(
+      lwe_size * gate_count * sizeof(uint32_t), stream, gpu_index);
+  device_boolean_gates_linear_phase<<<gate_count, 256, 0, *stream>>>(
+      lwe_buffer, (uint32_t *)lwe_array_in_1, (uint32_t *)lwe_array_in_2,
+      d_gate_types, lwe_size);
+  check_cuda_error(cudaGetLastError());
+
+  // 2. Compute a PBS over the whole wave with the shared LUT
+  uint32_t *h_pbs_lut = (uint32_t *)malloc((glwe_dimension + 1) *
+                                           polynomial_size * sizeof(uint32_t));
+  for (uint index = 0; index < (glwe_dimension + 1) * polynomial_size;
+       index++) {
+    h_pbs_lut[index] =
+        index < (glwe_dimension * polynomial_size) ? 0 : PLAINTEXT_TRUE;
+  }
+  uint32_t *pbs_lut = (uint32_t *)cuda_malloc_async(
+      (glwe_dimension + 1) * polynomial_size * sizeof(uint32_t), stream,
+      gpu_index);
+  cuda_memcpy_async_to_gpu(pbs_lut, h_pbs_lut,
+                           (glwe_dimension + 1) * polynomial_size *
+                               sizeof(uint32_t),
+                           stream, gpu_index);
+  check_cuda_error(cudaGetLastError());
+  uint32_t *h_pbs_lut_indexes =
+      (uint32_t *)malloc(gate_count * sizeof(uint32_t));
+  for (uint index = 0; index < gate_count; index++) {
+    h_pbs_lut_indexes[index] = 0;
+  }
+  uint32_t *pbs_lut_indexes = (uint32_t *)cuda_malloc_async(
+      gate_count * sizeof(uint32_t), stream, gpu_index);
+  cuda_memcpy_async_to_gpu(pbs_lut_indexes, h_pbs_lut_indexes,
+                           gate_count * sizeof(uint32_t), stream, gpu_index);
+  check_cuda_error(cudaGetLastError());
+  uint32_t *lwe_pbs_buffer = (uint32_t *)cuda_malloc_async(
+      (glwe_dimension * polynomial_size + 1) * gate_count * sizeof(uint32_t),
+      stream, gpu_index);
+  check_cuda_error(cudaGetLastError());
+
+  int8_t *pbs_buffer = nullptr;
+  scratch_cuda_bootstrap_low_latency_32(
+      v_stream, gpu_index, &pbs_buffer, glwe_dimension, polynomial_size,
+      pbs_level_count, gate_count, max_shared_memory, true);
+  cuda_bootstrap_low_latency_lwe_ciphertext_vector_32(
+      v_stream, gpu_index, lwe_pbs_buffer, pbs_lut, pbs_lut_indexes,
+      lwe_buffer, bootstrapping_key, pbs_buffer, input_lwe_dimension,
+      glwe_dimension, polynomial_size, pbs_base_log, pbs_level_count,
+      gate_count, 1, 0, max_shared_memory);
+  cleanup_cuda_bootstrap_low_latency(v_stream, gpu_index, &pbs_buffer);
+  check_cuda_error(cudaGetLastError());
+
+  cuda_drop_async(lwe_buffer, stream, gpu_index);
+  cuda_drop_async(d_gate_types, stream, gpu_index);
+  cuda_drop_async(pbs_lut, stream, gpu_index);
+  cuda_drop_async(pbs_lut_indexes, stream, gpu_index);
+  free(h_pbs_lut);
+  free(h_pbs_lut_indexes);
+
+  // 3. Keyswitch the whole wave back to the small key
+  cuda_keyswitch_lwe_ciphertext_vector_32(
+      v_stream, gpu_index, lwe_array_out, lwe_pbs_buffer, ksk,
+      glwe_dimension * polynomial_size, input_lwe_dimension, ks_base_log,
+      ks_level_count, gate_count);
+
+  cuda_drop_async(lwe_pbs_buffer, stream, gpu_index);
+}
 #endif // CUDA_BOOLEAN_GATES_CU
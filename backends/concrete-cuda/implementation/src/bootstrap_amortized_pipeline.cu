@@ -0,0 +1,112 @@
+#include "bootstrap.h"
+#include "device.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/* Pipelined driver for the amortized PBS on large batches.
+ *
+ * The single-launch entry point uploads the whole input batch, runs the
+ * kernel and downloads the whole output, so on large batches the PCIe
+ * transfers serialize with compute. This driver splits the batch into
+ * tiles and double-buffers them on two streams: while one tile computes,
+ * the next one uploads and the previous one downloads. The LUT vector,
+ * the LUT indexes and the bootstrapping key are expected on the device
+ * already (they are shared by all tiles); the input and output ciphertext
+ * arrays live on the host.
+ */
+
+namespace {
+constexpr uint32_t num_pipeline_slots = 2;
+constexpr uint32_t default_tile_samples = 1024;
+} // namespace
+
+/* Perform the programmable bootstrapping on a large batch of input u64 LWE
+ * ciphertexts, overlapping host/device transfers with compute.
+ *
+ * Arguments match cuda_bootstrap_amortized_lwe_ciphertext_vector_64 with
+ * the following differences:
+ * - `lwe_array_out_host` / `lwe_array_in_host` are host pointers; the
+ *   driver uploads and downloads one tile at a time
+ * - `v_stream` is only used to order this call after preceding uploads
+ *   (typically of the LUT vector and indexes); the driver synchronizes it
+ *   before starting and runs the tiles on internal streams
+ * - `tile_samples` is the number of ciphertexts per tile; 0 selects a
+ *   default of 1024
+ *
+ * The call is synchronous: all outputs are on the host when it returns.
+ */
+void cuda_bootstrap_amortized_pipelined_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, uint64_t *lwe_array_out_host,
+    void *lut_vector, void *lut_vector_indexes, uint64_t *lwe_array_in_host,
+    void *bootstrapping_key, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t max_shared_memory,
+    uint32_t tile_samples) {
+
+  if (tile_samples == 0)
+    tile_samples = default_tile_samples;
+  tile_samples = std::min(tile_samples, num_samples);
+
+  uint64_t in_sample_size = (uint64_t)lwe_dimension + 1;
+  uint64_t out_sample_size = (uint64_t)glwe_dimension * polynomial_size + 1;
+
+  // Wait for the uploads the caller enqueued (LUT vector, indexes)
+  cuda_synchronize_stream(v_stream);
+
+  struct PipelineSlot {
+    cudaStream_t *stream;
+    void *in_gpu;
+    void *out_gpu;
+    int8_t *pbs_buffer;
+  } slots[num_pipeline_slots];
+
+  for (uint32_t s = 0; s < num_pipeline_slots; s++) {
+    slots[s].stream = cuda_create_stream(gpu_index);
+    slots[s].in_gpu =
+        cuda_malloc_async(tile_samples * in_sample_size * sizeof(uint64_t),
+                          slots[s].stream, gpu_index);
+    slots[s].out_gpu =
+        cuda_malloc_async(tile_samples * out_sample_size * sizeof(uint64_t),
+                          slots[s].stream, gpu_index);
+    slots[s].pbs_buffer = nullptr;
+    scratch_cuda_bootstrap_amortized_64(
+        slots[s].stream, gpu_index, &slots[s].pbs_buffer, glwe_dimension,
+        polynomial_size, tile_samples, max_shared_memory, true);
+  }
+
+  for (uint32_t tile_start = 0, tile_idx = 0; tile_start < num_samples;
+       tile_start += tile_samples, tile_idx++) {
+    uint32_t tile_count = std::min(tile_samples, num_samples - tile_start);
+    PipelineSlot &slot = slots[tile_idx % num_pipeline_slots];
+
+    // Make sure the tile that last used this slot has fully drained
+    // before its buffers are overwritten
+    cuda_synchronize_stream(slot.stream);
+
+    cuda_memcpy_async_to_gpu(
+        slot.in_gpu, lwe_array_in_host + (uint64_t)tile_start * in_sample_size,
+        tile_count * in_sample_size * sizeof(uint64_t), slot.stream, gpu_index);
+    // The LUT indexes of the whole batch are on the device; lwe_idx shifts
+    // the kernel onto this tile's entries
+    cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+        slot.stream, gpu_index, slot.out_gpu, lut_vector, lut_vector_indexes,
+        slot.in_gpu, bootstrapping_key, slot.pbs_buffer, lwe_dimension,
+        glwe_dimension, polynomial_size, base_log, level_count, tile_count,
+        num_lut_vectors, tile_start, max_shared_memory);
+    cuda_memcpy_async_to_cpu(
+        lwe_array_out_host + (uint64_t)tile_start * out_sample_size,
+        slot.out_gpu, tile_count * out_sample_size * sizeof(uint64_t),
+        slot.stream, gpu_index);
+  }
+
+  for (uint32_t s = 0; s < num_pipeline_slots; s++) {
+    cuda_synchronize_stream(slots[s].stream);
+    cuda_drop_async(slots[s].in_gpu, slots[s].stream, gpu_index);
+    cuda_drop_async(slots[s].out_gpu, slots[s].stream, gpu_index);
+    cleanup_cuda_bootstrap_amortized(slots[s].stream, gpu_index,
+                                     &slots[s].pbs_buffer);
+    cuda_synchronize_stream(slots[s].stream);
+    cuda_destroy_stream(slots[s].stream, gpu_index);
+  }
+}
@@ -0,0 +1,278 @@
+#include "bootstrap.h"
+#include "device.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/* Batch-size aware dispatch between the bootstrap implementations.
+ *
+ * The low latency PBS wins for small batches and the amortized PBS for
+ * large ones, but the crossover moves with the parameter set and the
+ * device. The dispatch entry points measure both kernels the first time
+ * a (device, parameters, batch bucket) combination executes - with the
+ * caller's real key and ciphertexts, so the measured kernels are exactly
+ * the production ones - then keep the winner in a process-wide table and
+ * persist it on disk, so later processes skip the measurement entirely.
+ * The dispatch scratch is sized for whichever implementation needs more,
+ * so the choice can differ from call to call over one buffer.
+ *
+ * The multi-bit PBS takes a differently laid out bootstrapping key and
+ * keeps its own entry points (with their own tuner); it cannot be
+ * selected from a standard Fourier key, so it is not dispatched here.
+ */
+
+enum pbs_variant { PBS_VARIANT_LOW_LATENCY = 0, PBS_VARIANT_AMORTIZED = 1 };
+
+namespace {
+
+typedef std::tuple<std::string, uint32_t, uint32_t, uint32_t, uint32_t,
+                   uint32_t, uint32_t>
+    dispatch_key;
+
+std::mutex dispatch_mutex;
+std::map<dispatch_key, uint32_t> dispatch_table;
+bool dispatch_cache_loaded = false;
+
+// Below the bucketed measurements, fall back to the published crossover.
+const uint32_t heuristic_crossover_samples = 16;
+
+// Round the sample count so one measurement covers a range of batch
+// sizes.
+uint32_t sample_bucket(uint32_t num_samples) {
+  uint32_t bucket = 1;
+  while (bucket < num_samples)
+    bucket <<= 1;
+  return bucket;
+}
+
+std::string device_name(uint32_t gpu_index) {
+  cudaDeviceProp deviceProp;
+  cudaGetDeviceProperties(&deviceProp, gpu_index);
+  std::string name(deviceProp.name);
+  // The cache file is whitespace separated
+  for (auto &c : name)
+    if (c == ' ' || c == '\t')
+      c = '_';
+  return name;
+}
+
+dispatch_key make_key(uint32_t gpu_index, uint32_t lwe_dimension,
+                      uint32_t glwe_dimension, uint32_t polynomial_size,
+                      uint32_t base_log, uint32_t level_count,
+                      uint32_t num_samples) {
+  return std::make_tuple(device_name(gpu_index), lwe_dimension, glwe_dimension,
+                         polynomial_size, base_log, level_count,
+                         sample_bucket(num_samples));
+}
+
+bool dispatch_measurement_enabled() {
+  const char *env = getenv("CONCRETE_CUDA_PBS_DISPATCH");
+  return env == nullptr || strtoul(env, NULL, 10) != 0;
+}
+
+std::string dispatch_cache_path() {
+  const char *path = getenv("CONCRETE_CUDA_PBS_DISPATCH_CACHE");
+  if (path != nullptr)
+    return path;
+  const char *home = getenv("HOME");
+  if (home != nullptr)
+    return std::string(home) + "/.cache/concrete_cuda_pbs_dispatch.tune";
+  return "";
+}
+
+// Called with dispatch_mutex held.
+void load_dispatch_cache() {
+  if (dispatch_cache_loaded)
+    return;
+  dispatch_cache_loaded = true;
+  std::string path = dispatch_cache_path();
+  if (path.empty())
+    return;
+  FILE *f = fopen(path.c_str(), "r");
+  if (f == nullptr)
+    return;
+  char device[256];
+  uint32_t lwe, glwe, poly, base_log, level, samples, variant;
+  while (fscanf(f, "%255s %u %u %u %u %u %u %u", device, &lwe, &glwe, &poly,
+                &base_log, &level, &samples, &variant) == 8) {
+    dispatch_table[std::make_tuple(std::string(device), lwe, glwe, poly,
+                                   base_log, level, samples)] = variant;
+  }
+  fclose(f);
+}
+
+// Called with dispatch_mutex held.
+void append_dispatch_cache(dispatch_key const &key, uint32_t variant) {
+  std::string path = dispatch_cache_path();
+  if (path.empty())
+    return;
+  FILE *f = fopen(path.c_str(), "a");
+  if (f == nullptr)
+    return;
+  fprintf(f, "%s %u %u %u %u %u %u %u\n", std::get<0>(key).c_str(),
+          std::get<1>(key), std::get<2>(key), std::get<3>(key),
+          std::get<4>(key), std::get<5>(key), std::get<6>(key), variant);
+  fclose(f);
+}
+
+/* Measure both kernels with the caller's real arguments and record the
+ * winner. Each kernel gets one warmup execution and three timed ones; the
+ * repeated executions write the same output the caller's execution will,
+ * so the output buffer ends up in a valid state regardless.
+ */
+uint32_t measure_pbs_crossover_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *bootstrapping_key,
+    int8_t *pbs_buffer, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t lwe_idx,
+    uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+
+  cudaEvent_t start, stop;
+  check_cuda_error(cudaEventCreate(&start));
+  check_cuda_error(cudaEventCreate(&stop));
+
+  float times_ms[2];
+  for (uint32_t variant = 0; variant < 2; variant++) {
+    // Warmup
+    if (variant == PBS_VARIANT_LOW_LATENCY)
+      cuda_bootstrap_low_latency_lwe_ciphertext_vector_64(
+          v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+          lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+          glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+          num_lut_vectors, lwe_idx, max_shared_memory);
+    else
+      cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+          v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+          lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+          glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+          num_lut_vectors, lwe_idx, max_shared_memory);
+    check_cuda_error(cudaEventRecord(start, *stream));
+    for (int rep = 0; rep < 3; rep++) {
+      if (variant == PBS_VARIANT_LOW_LATENCY)
+        cuda_bootstrap_low_latency_lwe_ciphertext_vector_64(
+            v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+            lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+            glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+            num_lut_vectors, lwe_idx, max_shared_memory);
+      else
+        cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+            v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+            lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+            glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+            num_lut_vectors, lwe_idx, max_shared_memory);
+    }
+    check_cuda_error(cudaEventRecord(stop, *stream));
+    check_cuda_error(cudaEventSynchronize(stop));
+    check_cuda_error(cudaEventElapsedTime(&times_ms[variant], start, stop));
+  }
+
+  check_cuda_error(cudaEventDestroy(start));
+  check_cuda_error(cudaEventDestroy(stop));
+
+  return times_ms[PBS_VARIANT_LOW_LATENCY] <= times_ms[PBS_VARIANT_AMORTIZED]
+             ? PBS_VARIANT_LOW_LATENCY
+             : PBS_VARIANT_AMORTIZED;
+}
+
+} // namespace
+
+/* The dispatch scratch configures both implementations and allocates one
+ * buffer large enough for either, so the per-call selection below is free
+ * to pick differently as the batch size changes.
+ */
+void scratch_cuda_bootstrap_dispatch_64(
+    void *v_stream, uint32_t gpu_index, int8_t **pbs_buffer,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t level_count,
+    uint32_t input_lwe_ciphertext_count, uint32_t max_shared_memory,
+    bool allocate_gpu_memory) {
+  scratch_cuda_bootstrap_low_latency_64(
+      v_stream, gpu_index, pbs_buffer, glwe_dimension, polynomial_size,
+      level_count, input_lwe_ciphertext_count, max_shared_memory, false);
+  scratch_cuda_bootstrap_amortized_64(v_stream, gpu_index, pbs_buffer,
+                                      glwe_dimension, polynomial_size,
+                                      input_lwe_ciphertext_count,
+                                      max_shared_memory, false);
+  if (allocate_gpu_memory) {
+    uint64_t size = std::max(
+        get_buffer_size_bootstrap_low_latency_64(
+            glwe_dimension, polynomial_size, level_count,
+            input_lwe_ciphertext_count, max_shared_memory),
+        get_buffer_size_bootstrap_amortized_64(glwe_dimension, polynomial_size,
+                                               input_lwe_ciphertext_count,
+                                               max_shared_memory));
+    auto stream = static_cast<cudaStream_t *>(v_stream);
+    *pbs_buffer = (int8_t *)cuda_malloc_async(size, stream, gpu_index);
+    check_cuda_error(cudaGetLastError());
+  }
+}
+
+/* Run the bootstrap kernel that wins for this (device, parameters, batch)
+ * combination. The pbs_buffer must come from the dispatch scratch, sized
+ * for a ciphertext count of at least num_samples.
+ */
+void cuda_bootstrap_dispatch_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *bootstrapping_key,
+    int8_t *pbs_buffer, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t lwe_idx,
+    uint32_t max_shared_memory) {
+  dispatch_key key =
+      make_key(gpu_index, lwe_dimension, glwe_dimension, polynomial_size,
+               base_log, level_count, num_samples);
+  uint32_t variant;
+  bool known;
+  {
+    const std::lock_guard<std::mutex> guard(dispatch_mutex);
+    load_dispatch_cache();
+    auto it = dispatch_table.find(key);
+    known = it != dispatch_table.end();
+    variant = known ? it->second
+              : num_samples < heuristic_crossover_samples
+                  ? PBS_VARIANT_LOW_LATENCY
+                  : PBS_VARIANT_AMORTIZED;
+  }
+  if (!known && dispatch_measurement_enabled()) {
+    variant = measure_pbs_crossover_64(
+        v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+        lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+        glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+        num_lut_vectors, lwe_idx, max_shared_memory);
+    const std::lock_guard<std::mutex> guard(dispatch_mutex);
+    if (dispatch_table.count(key) == 0) {
+      dispatch_table[key] = variant;
+      append_dispatch_cache(key, variant);
+    }
+  }
+  if (variant == PBS_VARIANT_LOW_LATENCY)
+    cuda_bootstrap_low_latency_lwe_ciphertext_vector_64(
+        v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+        lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+        glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+        num_lut_vectors, lwe_idx, max_shared_memory);
+  else
+    cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+        v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+        lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+        glwe_dimension, polynomial_size, base_log, level_count, num_samples,
+        num_lut_vectors, lwe_idx, max_shared_memory);
+}
+
+/*
+ * This cleanup function frees the data of the dispatch scratch on GPU in
+ * pbs_buffer.
+ */
+void cleanup_cuda_bootstrap_dispatch(void *v_stream, uint32_t gpu_index,
+                                     int8_t **pbs_buffer) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  // Free memory
+  cuda_drop_async(*pbs_buffer, stream, gpu_index);
+}
@@ -180,9 +180,9 @@ __host__ void scratch_fast_multi_bit_pbs(
 
   if (allocate_gpu_memory) {
     if (!lwe_chunk_size)
-      lwe_chunk_size =
-          get_lwe_chunk_size(lwe_dimension, level_count, glwe_dimension,
-                             input_lwe_ciphertext_count);
+      lwe_chunk_size = get_tuned_lwe_chunk_size(
+          gpu_index, lwe_dimension, glwe_dimension, polynomial_size,
+          level_count, grouping_factor, input_lwe_ciphertext_count);
 
     uint64_t buffer_size = get_buffer_size_fast_multibit_bootstrap<Torus>(
         lwe_dimension, glwe_dimension, polynomial_size, level_count,
@@ -205,8 +205,10 @@ __host__ void host_fast_multi_bit_pbs(
   auto stream = static_cast<cudaStream_t *>(v_stream);
 
   if (!lwe_chunk_size)
-    lwe_chunk_size = get_lwe_chunk_size(lwe_dimension, level_count,
-                                        glwe_dimension, num_samples);
+    lwe_chunk_size = get_tuned_lwe_chunk_size(gpu_index, lwe_dimension,
+                                              glwe_dimension, polynomial_size,
+                                              level_count, grouping_factor,
+                                              num_samples);
 
   //
   double2 *keybundle_fft = (double2 *)pbs_buffer;
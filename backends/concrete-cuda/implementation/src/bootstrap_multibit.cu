@@ -23,6 +23,24 @@ void cuda_multi_bit_pbs_lwe_ciphertext_vector_64(
 
   checks_multi_bit_pbs(polynomial_size);
 
+  // First execution of this parameter set on this device: benchmark the
+  // candidate chunk sizes with the caller's arguments and record the
+  // winner. The caller's scratch buffer was sized with the heuristic chunk
+  // size, so this execution still uses it; every later scratch/execute
+  // pair picks the tuned value up through get_tuned_lwe_chunk_size.
+  if (!lwe_chunk_size &&
+      !has_tuned_lwe_chunk_size(gpu_index, lwe_dimension, glwe_dimension,
+                                polynomial_size, level_count, grouping_factor,
+                                num_samples)) {
+    tune_multi_bit_pbs_chunk_size_64(
+        v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+        lwe_array_in, bootstrapping_key, lwe_dimension, glwe_dimension,
+        polynomial_size, grouping_factor, base_log, level_count, num_samples,
+        num_lut_vectors, lwe_idx, max_shared_memory);
+    lwe_chunk_size = get_lwe_chunk_size(lwe_dimension, level_count,
+                                        glwe_dimension, num_samples);
+  }
+
   switch (polynomial_size) {
   case 256:
     if (verify_cuda_bootstrap_fast_multi_bit_grid_size<uint64_t,
@@ -368,9 +368,9 @@ scratch_multi_bit_pbs(void *v_stream, uint32_t gpu_index, int8_t **pbs_buffer,
 
   if (allocate_gpu_memory) {
     if (!lwe_chunk_size)
-      lwe_chunk_size =
-          get_lwe_chunk_size(lwe_dimension, level_count, glwe_dimension,
-                             input_lwe_ciphertext_count);
+      lwe_chunk_size = get_tuned_lwe_chunk_size(
+          gpu_index, lwe_dimension, glwe_dimension, polynomial_size,
+          level_count, grouping_factor, input_lwe_ciphertext_count);
 
     uint64_t buffer_size = get_buffer_size_multibit_bootstrap<Torus>(
         glwe_dimension, polynomial_size, level_count,
@@ -393,8 +393,10 @@ __host__ void host_multi_bit_pbs(
 
   // If a chunk size is not passed to this function, select one.
   if (!lwe_chunk_size)
-    lwe_chunk_size = get_lwe_chunk_size(lwe_dimension, level_count,
-                                        glwe_dimension, num_samples);
+    lwe_chunk_size = get_tuned_lwe_chunk_size(gpu_index, lwe_dimension,
+                                              glwe_dimension, polynomial_size,
+                                              level_count, grouping_factor,
+                                              num_samples);
 
   //
   double2 *keybundle_fft = (double2 *)pbs_buffer;
@@ -0,0 +1,221 @@
+#include "bootstrap_multibit.h"
+#include "device.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/* Autotuner for the multi-bit PBS launch configuration.
+ *
+ * The best lwe chunk size depends on the device and on the full parameter
+ * set, and the static tables in get_lwe_chunk_size only cover a few known
+ * GPUs. The tuner benchmarks candidate chunk sizes on the first execution
+ * of a parameter set (with the caller's real key and ciphertexts, so the
+ * measured kernels are exactly the production ones), keeps the winner in a
+ * process-wide table and persists it on disk so later processes skip the
+ * benchmark entirely.
+ */
+
+namespace {
+
+typedef std::tuple<std::string, uint32_t, uint32_t, uint32_t, uint32_t,
+                   uint32_t, uint32_t>
+    tuning_key;
+
+std::mutex tuning_mutex;
+std::map<tuning_key, uint32_t> tuning_table;
+bool tuning_cache_loaded = false;
+
+// Round the sample count so one benchmark covers a range of batch sizes.
+uint32_t sample_bucket(uint32_t num_samples) {
+  uint32_t bucket = 1;
+  while (bucket < num_samples)
+    bucket <<= 1;
+  return bucket;
+}
+
+std::string device_name(uint32_t gpu_index) {
+  cudaDeviceProp deviceProp;
+  cudaGetDeviceProperties(&deviceProp, gpu_index);
+  std::string name(deviceProp.name);
+  // The cache file is whitespace separated
+  for (auto &c : name)
+    if (c == ' ' || c == '\t')
+      c = '_';
+  return name;
+}
+
+tuning_key make_key(uint32_t gpu_index, uint32_t lwe_dimension,
+                    uint32_t glwe_dimension, uint32_t polynomial_size,
+                    uint32_t level_count, uint32_t grouping_factor,
+                    uint32_t num_samples) {
+  return std::make_tuple(device_name(gpu_index), lwe_dimension, glwe_dimension,
+                         polynomial_size, level_count, grouping_factor,
+                         sample_bucket(num_samples));
+}
+
+std::string tuning_cache_path() {
+  const char *path = getenv("CONCRETE_CUDA_TUNING_CACHE");
+  if (path != nullptr)
+    return path;
+  const char *home = getenv("HOME");
+  if (home != nullptr)
+    return std::string(home) + "/.cache/concrete_cuda_multibit_pbs.tune";
+  return "";
+}
+
+// Called with tuning_mutex held.
+void load_tuning_cache() {
+  if (tuning_cache_loaded)
+    return;
+  tuning_cache_loaded = true;
+  std::string path = tuning_cache_path();
+  if (path.empty())
+    return;
+  FILE *f = fopen(path.c_str(), "r");
+  if (f == nullptr)
+    return;
+  char device[256];
+  uint32_t lwe, glwe, poly, level, grouping, samples, chunk;
+  while (fscanf(f, "%255s %u %u %u %u %u %u %u", device, &lwe, &glwe, &poly,
+                &level, &grouping, &samples, &chunk) == 8) {
+    tuning_table[std::make_tuple(std::string(device), lwe, glwe, poly, level,
+                                 grouping, samples)] = chunk;
+  }
+  fclose(f);
+}
+
+// Called with tuning_mutex held.
+void append_tuning_cache(tuning_key const &key, uint32_t chunk) {
+  std::string path = tuning_cache_path();
+  if (path.empty())
+    return;
+  FILE *f = fopen(path.c_str(), "a");
+  if (f == nullptr)
+    return;
+  fprintf(f, "%s %u %u %u %u %u %u %u\n", std::get<0>(key).c_str(),
+          std::get<1>(key), std::get<2>(key), std::get<3>(key),
+          std::get<4>(key), std::get<5>(key), std::get<6>(key), chunk);
+  fclose(f);
+}
+
+} // namespace
+
+__host__ uint32_t get_tuned_lwe_chunk_size(
+    uint32_t gpu_index, uint32_t lwe_dimension, uint32_t glwe_dimension,
+    uint32_t polynomial_size, uint32_t level_count, uint32_t grouping_factor,
+    uint32_t num_samples) {
+  const std::lock_guard<std::mutex> guard(tuning_mutex);
+  load_tuning_cache();
+  auto it = tuning_table.find(make_key(gpu_index, lwe_dimension,
+                                       glwe_dimension, polynomial_size,
+                                       level_count, grouping_factor,
+                                       num_samples));
+  if (it != tuning_table.end())
+    return it->second;
+  return get_lwe_chunk_size(lwe_dimension, level_count, glwe_dimension,
+                            num_samples);
+}
+
+__host__ bool has_tuned_lwe_chunk_size(uint32_t gpu_index,
+                                       uint32_t lwe_dimension,
+                                       uint32_t glwe_dimension,
+                                       uint32_t polynomial_size,
+                                       uint32_t level_count,
+                                       uint32_t grouping_factor,
+                                       uint32_t num_samples) {
+  const std::lock_guard<std::mutex> guard(tuning_mutex);
+  load_tuning_cache();
+  return tuning_table.count(make_key(gpu_index, lwe_dimension, glwe_dimension,
+                                     polynomial_size, level_count,
+                                     grouping_factor, num_samples)) != 0;
+}
+
+/* Benchmark candidate chunk sizes with the caller's real arguments and
+ * record the winner. Each candidate gets its own scratch buffer, one warmup
+ * execution and three timed ones; the repeated executions write the same
+ * output the caller's execution will, so the output buffer ends up in a
+ * valid state regardless.
+ */
+__host__ uint32_t tune_multi_bit_pbs_chunk_size_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *bootstrapping_key,
+    uint32_t lwe_dimension, uint32_t glwe_dimension, uint32_t polynomial_size,
+    uint32_t grouping_factor, uint32_t base_log, uint32_t level_count,
+    uint32_t num_samples, uint32_t num_lut_vectors, uint32_t lwe_idx,
+    uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+
+  uint32_t heuristic = get_lwe_chunk_size(lwe_dimension, level_count,
+                                          glwe_dimension, num_samples);
+  std::vector<uint32_t> candidates = {heuristic, 1, 2,  4,  8,  12, 16,
+                                      20,        24, 32, 40, 48, 64};
+
+  uint32_t best_chunk = heuristic;
+  float best_time = -1.;
+  cudaEvent_t start, stop;
+  check_cuda_error(cudaEventCreate(&start));
+  check_cuda_error(cudaEventCreate(&stop));
+
+  for (size_t i = 0; i < candidates.size(); i++) {
+    uint32_t chunk = candidates[i];
+    // The chunk is a number of lwe iterations; anything beyond their total
+    // count only wastes memory.
+    if (chunk == 0 || chunk > lwe_dimension / grouping_factor)
+      continue;
+    // Skip duplicates of the heuristic
+    if (i > 0 && chunk == heuristic)
+      continue;
+
+    int8_t *pbs_buffer = nullptr;
+    scratch_cuda_multi_bit_pbs_64(v_stream, gpu_index, &pbs_buffer,
+                                  lwe_dimension, glwe_dimension,
+                                  polynomial_size, level_count,
+                                  grouping_factor, num_samples,
+                                  max_shared_memory, true, chunk);
+    // Warmup
+    cuda_multi_bit_pbs_lwe_ciphertext_vector_64(
+        v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+        lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+        glwe_dimension, polynomial_size, grouping_factor, base_log,
+        level_count, num_samples, num_lut_vectors, lwe_idx, max_shared_memory,
+        chunk);
+    check_cuda_error(cudaEventRecord(start, *stream));
+    for (int rep = 0; rep < 3; rep++)
+      cuda_multi_bit_pbs_lwe_ciphertext_vector_64(
+          v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+          lwe_array_in, bootstrapping_key, pbs_buffer, lwe_dimension,
+          glwe_dimension, polynomial_size, grouping_factor, base_log,
+          level_count, num_samples, num_lut_vectors, lwe_idx,
+          max_shared_memory, chunk);
+    check_cuda_error(cudaEventRecord(stop, *stream));
+    check_cuda_error(cudaEventSynchronize(stop));
+    float time_ms;
+    check_cuda_error(cudaEventElapsedTime(&time_ms, start, stop));
+    cleanup_cuda_multi_bit_pbs(v_stream, gpu_index, &pbs_buffer);
+
+    if (best_time < 0. || time_ms < best_time) {
+      best_time = time_ms;
+      best_chunk = chunk;
+    }
+  }
+
+  check_cuda_error(cudaEventDestroy(start));
+  check_cuda_error(cudaEventDestroy(stop));
+
+  const std::lock_guard<std::mutex> guard(tuning_mutex);
+  load_tuning_cache();
+  tuning_key key = make_key(gpu_index, lwe_dimension, glwe_dimension,
+                            polynomial_size, level_count, grouping_factor,
+                            num_samples);
+  if (tuning_table.count(key) == 0) {
+    tuning_table[key] = best_chunk;
+    append_tuning_cache(key, best_chunk);
+  }
+  return best_chunk;
+}
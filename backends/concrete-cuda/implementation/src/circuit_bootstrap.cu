@@ -1,5 +1,6 @@
 #include "circuit_bootstrap.cuh"
 #include "circuit_bootstrap.h"
+#include <algorithm>
 
 /*
  * Runs standard checks to validate the inputs
@@ -317,6 +318,86 @@ void cuda_circuit_bootstrap_64(
   }
 }
 
+/*
+ * Number of input LWE ciphertexts the circuit bootstrap can process in one
+ * launch grid, mirroring the occupancy bound enforced by
+ * checks_circuit_bootstrap. The batch entry points below recompute it, so
+ * scratch and run always agree on the chunk size.
+ */
+uint32_t get_circuit_bootstrap_chunk_size(uint32_t gpu_index,
+                                          uint32_t glwe_dimension,
+                                          uint32_t level_bsk,
+                                          uint32_t number_of_inputs) {
+  int number_of_sm = 0;
+  cudaDeviceGetAttribute(&number_of_sm, cudaDevAttrMultiProcessorCount,
+                         gpu_index);
+  uint32_t chunk_size = number_of_sm / 4 / (glwe_dimension + 1) / level_bsk;
+  if (chunk_size == 0)
+    chunk_size = 1;
+  return std::min(chunk_size, number_of_inputs);
+}
+
+/*
+ * This scratch function allocates the necessary amount of data on the GPU
+ * for the batched circuit bootstrap on 64 bits inputs, into `cbs_buffer`.
+ * The buffer is sized for one chunk of the batch, all chunks reuse it.
+ */
+void scratch_cuda_circuit_bootstrap_batch_64(
+    void *v_stream, uint32_t gpu_index, int8_t **cbs_buffer,
+    uint32_t glwe_dimension, uint32_t lwe_dimension, uint32_t polynomial_size,
+    uint32_t level_bsk, uint32_t level_count_cbs, uint32_t number_of_inputs,
+    uint32_t max_shared_memory, bool allocate_gpu_memory) {
+
+  uint32_t chunk_size = get_circuit_bootstrap_chunk_size(
+      gpu_index, glwe_dimension, level_bsk, number_of_inputs);
+  scratch_cuda_circuit_bootstrap_64(
+      v_stream, gpu_index, cbs_buffer, glwe_dimension, lwe_dimension,
+      polynomial_size, level_bsk, level_count_cbs, chunk_size,
+      max_shared_memory, allocate_gpu_memory);
+}
+
+/*
+ * Perform circuit bootstrapping on an arbitrarily large batch of 64 bit
+ * input LWE ciphertexts. cuda_circuit_bootstrap_64 is limited to a number
+ * of inputs derived from the number of streaming multiprocessors, so
+ * pipelines processing all the extracted bits of several ciphertexts have
+ * to split the batch; this entry point does the splitting internally,
+ * enqueueing one launch grid per chunk on the caller's stream and reusing
+ * the single chunk-sized scratch allocated by
+ * scratch_cuda_circuit_bootstrap_batch_64.
+ *
+ * 'lut_vector_indexes' must hold the indexes for one chunk
+ * (chunk size * 'level_cbs' entries); it is reused as-is for every chunk,
+ * which matches the usual periodic layout where the i-th PBS of a chunk
+ * uses index i % 'level_cbs'.
+ */
+void cuda_circuit_bootstrap_batch_64(
+    void *v_stream, uint32_t gpu_index, void *ggsw_out, void *lwe_array_in,
+    void *fourier_bsk, void *fp_ksk_array, void *lut_vector_indexes,
+    int8_t *cbs_buffer, uint32_t delta_log, uint32_t polynomial_size,
+    uint32_t glwe_dimension, uint32_t lwe_dimension, uint32_t level_bsk,
+    uint32_t base_log_bsk, uint32_t level_pksk, uint32_t base_log_pksk,
+    uint32_t level_cbs, uint32_t base_log_cbs, uint32_t number_of_inputs,
+    uint32_t max_shared_memory) {
+
+  uint32_t chunk_size = get_circuit_bootstrap_chunk_size(
+      gpu_index, glwe_dimension, level_bsk, number_of_inputs);
+  uint64_t ggsw_stride = (uint64_t)level_cbs * (glwe_dimension + 1) *
+                         (glwe_dimension + 1) * polynomial_size;
+  uint64_t lwe_stride = (uint64_t)lwe_dimension + 1;
+
+  for (uint32_t start = 0; start < number_of_inputs; start += chunk_size) {
+    uint32_t chunk_inputs = std::min(chunk_size, number_of_inputs - start);
+    cuda_circuit_bootstrap_64(
+        v_stream, gpu_index, (uint64_t *)ggsw_out + start * ggsw_stride,
+        (uint64_t *)lwe_array_in + start * lwe_stride, fourier_bsk,
+        fp_ksk_array, lut_vector_indexes, cbs_buffer, delta_log,
+        polynomial_size, glwe_dimension, lwe_dimension, level_bsk, base_log_bsk,
+        level_pksk, base_log_pksk, level_cbs, base_log_cbs, chunk_inputs,
+        max_shared_memory);
+  }
+}
+
 /*
  * This cleanup function frees the data for the circuit bootstrap on GPU in
  * cbs_buffer for 32 or 64 bits inputs.
@@ -84,4 +84,72 @@ __device__ inline double2 operator*(double a, double2 b) {
   return res;
 }
 
+//--------------------------------------------------
+// Basic float2 operations, mirroring the double2 set for the FP32 FFT
+
+__device__ inline float2 conjugate(const float2 num) {
+  float2 res;
+  res.x = num.x;
+  res.y = -num.y;
+  return res;
+}
+
+__device__ inline void operator+=(float2 &lh, const float2 rh) {
+  lh.x += rh.x;
+  lh.y += rh.y;
+}
+
+__device__ inline void operator-=(float2 &lh, const float2 rh) {
+  lh.x -= rh.x;
+  lh.y -= rh.y;
+}
+
+__device__ inline float2 operator+(const float2 a, const float2 b) {
+  float2 res;
+  res.x = a.x + b.x;
+  res.y = a.y + b.y;
+  return res;
+}
+
+__device__ inline float2 operator-(const float2 a, const float2 b) {
+  float2 res;
+  res.x = a.x - b.x;
+  res.y = a.y - b.y;
+  return res;
+}
+
+__device__ inline float2 operator*(const float2 a, const float2 b) {
+  float xx = a.x * b.x;
+  float xy = a.x * b.y;
+  float yx = a.y * b.x;
+  float yy = a.y * b.y;
+
+  float2 res;
+  res.x = xx - yy;
+  res.y = xy + yx;
+  return res;
+}
+
+__device__ inline float2 operator*(const float2 a, float b) {
+  float2 res;
+  res.x = a.x * b;
+  res.y = a.y * b;
+  return res;
+}
+
+__device__ inline void operator*=(float2 &a, const float2 b) {
+  float tmp = a.x;
+  a.x *= b.x;
+  a.x -= a.y * b.y;
+  a.y *= b.x;
+  a.y += b.y * tmp;
+}
+
+__device__ inline float2 operator*(float a, float2 b) {
+  float2 res;
+  res.x = b.x * a;
+  res.y = b.y * a;
+  return res;
+}
+
 #endif
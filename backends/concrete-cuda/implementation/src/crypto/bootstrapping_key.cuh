@@ -7,6 +7,8 @@
 #include "polynomial/polynomial.cuh"
 #include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 __device__ inline int get_start_ith_ggsw(int i, uint32_t polynomial_size,
                                          int glwe_dimension,
@@ -58,28 +60,27 @@ __device__ T *get_multi_bit_ith_lwe_gth_group_kth_block(
                                 glwe_dimension, level_count);
 }
 ////////////////////////////////////////////////
-template <typename T, typename ST>
-void cuda_convert_lwe_bootstrap_key(double2 *dest, ST *src, void *v_stream,
+template <typename T, typename ST, typename C = double2>
+void cuda_convert_lwe_bootstrap_key(C *dest, ST *src, void *v_stream,
                                     uint32_t gpu_index, uint32_t input_lwe_dim,
                                     uint32_t glwe_dim, uint32_t level_count,
                                     uint32_t polynomial_size,
                                     uint32_t total_polynomials) {
 
   cudaSetDevice(gpu_index);
-  int shared_memory_size = sizeof(double) * polynomial_size;
+  int shared_memory_size = sizeof(C) / 2 * polynomial_size;
 
-  // Here the buffer size is the size of double2 times the number of polynomials
-  // times the polynomial size over 2 because the polynomials are compressed
-  // into the complex domain to perform the FFT
-  size_t buffer_size =
-      total_polynomials * polynomial_size / 2 * sizeof(double2);
+  // Here the buffer size is the size of the complex type times the number of
+  // polynomials times the polynomial size over 2 because the polynomials are
+  // compressed into the complex domain to perform the FFT
+  size_t buffer_size = total_polynomials * polynomial_size / 2 * sizeof(C);
 
   int gridSize = total_polynomials;
   int blockSize = polynomial_size / choose_opt_amortized(polynomial_size);
 
-  double2 *h_bsk = (double2 *)malloc(buffer_size);
+  C *h_bsk = (C *)malloc(buffer_size);
   auto stream = static_cast<cudaStream_t *>(v_stream);
-  double2 *d_bsk = (double2 *)cuda_malloc_async(buffer_size, stream, gpu_index);
+  C *d_bsk = (C *)cuda_malloc_async(buffer_size, stream, gpu_index);
 
   // compress real bsk to complex and divide it on DOUBLE_MAX
   for (int i = 0; i < total_polynomials; i++) {
@@ -98,138 +99,138 @@ void cuda_convert_lwe_bootstrap_key(double2 *dest, ST *src, void *v_stream,
 
   cuda_memcpy_async_to_gpu(d_bsk, h_bsk, buffer_size, stream, gpu_index);
 
-  double2 *buffer;
+  C *buffer;
   switch (polynomial_size) {
   case 256:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<256>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
   case 512:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<512>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
   case 1024:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
   case 2048:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
   case 4096:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
   case 8192:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
   case 16384:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
-          batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, FULLSM>,
+          batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, FULLSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(d_bsk, dest,
                                                                  buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, NOSM>
+      batch_NSMFFT<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(d_bsk, dest, buffer);
     }
     break;
@@ -278,168 +279,185 @@ void cuda_convert_lwe_multi_bit_bootstrap_key_64(
       glwe_dim, level_count, polynomial_size, total_polynomials);
 }
 
-void cuda_fourier_polynomial_mul(void *_input1, void *_input2, void *_output,
-                                 void *v_stream, uint32_t gpu_index,
-                                 uint32_t polynomial_size,
-                                 uint32_t total_polynomials) {
+/*
+ * Single precision variant of cuda_convert_lwe_bootstrap_key_64: 'dest'
+ * receives the key in the fourier domain as float2 instead of double2
+ * (half the size), for use with the FP32 FFT path. The precision should
+ * be chosen per key with cuda_get_pbs_fft_precision.
+ */
+void cuda_convert_lwe_bootstrap_key_64_f32(void *dest, void *src,
+                                           void *v_stream, uint32_t gpu_index,
+                                           uint32_t input_lwe_dim,
+                                           uint32_t glwe_dim,
+                                           uint32_t level_count,
+                                           uint32_t polynomial_size) {
+  uint32_t total_polynomials =
+      input_lwe_dim * (glwe_dim + 1) * (glwe_dim + 1) * level_count;
+  cuda_initialize_twiddles_f32(v_stream, gpu_index);
+  cuda_convert_lwe_bootstrap_key<uint64_t, int64_t, float2>(
+      (float2 *)dest, (int64_t *)src, v_stream, gpu_index, input_lwe_dim,
+      glwe_dim, level_count, polynomial_size, total_polynomials);
+}
+
+template <typename C>
+void fourier_polynomial_mul(C *input1, C *input2, C *output, void *v_stream,
+                            uint32_t gpu_index, uint32_t polynomial_size,
+                            uint32_t total_polynomials) {
 
   auto stream = static_cast<cudaStream_t *>(v_stream);
-  auto input1 = (double2 *)_input1;
-  auto input2 = (double2 *)_input2;
-  auto output = (double2 *)_output;
 
-  size_t shared_memory_size = sizeof(double2) * polynomial_size / 2;
+  size_t shared_memory_size = sizeof(C) * polynomial_size / 2;
 
   int gridSize = total_polynomials;
   int blockSize = polynomial_size / choose_opt_amortized(polynomial_size);
 
-  double2 *buffer;
+  C *buffer;
   switch (polynomial_size) {
   case 256:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<256>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<256>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<256>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<256>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<256>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
   case 512:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<521>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<512>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<512>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<512>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<512>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
   case 1024:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<1024>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<1024>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<1024>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
   case 2048:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<2048>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<2048>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<2048>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
   case 4096:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<4096>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<4096>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<4096>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
   case 8192:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<8192>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<8192>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<8192>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
   case 16384:
     if (shared_memory_size <= cuda_get_max_shared_memory(gpu_index)) {
-      buffer = (double2 *)cuda_malloc_async(0, stream, gpu_index);
+      buffer = (C *)cuda_malloc_async(0, stream, gpu_index);
       check_cuda_error(cudaFuncSetAttribute(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<16384>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncAttributeMaxDynamicSharedMemorySize, shared_memory_size));
       check_cuda_error(cudaFuncSetCacheConfig(
           batch_polynomial_mul<FFTDegree<AmortizedDegree<16384>, ForwardFFT>,
-                               FULLSM>,
+                               FULLSM, C>,
           cudaFuncCachePreferShared));
       batch_polynomial_mul<FFTDegree<AmortizedDegree<16384>, ForwardFFT>,
-                           FULLSM>
+                           FULLSM, C>
           <<<gridSize, blockSize, shared_memory_size, *stream>>>(
               input1, input2, output, buffer);
     } else {
-      buffer = (double2 *)cuda_malloc_async(
+      buffer = (C *)cuda_malloc_async(
           shared_memory_size * total_polynomials, stream, gpu_index);
-      batch_polynomial_mul<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, NOSM>
+      batch_polynomial_mul<FFTDegree<AmortizedDegree<16384>, ForwardFFT>, NOSM, C>
           <<<gridSize, blockSize, 0, *stream>>>(input1, input2, output, buffer);
     }
     break;
@@ -449,6 +467,53 @@ void cuda_fourier_polynomial_mul(void *_input1, void *_input2, void *_output,
   cuda_drop_async(buffer, stream, gpu_index);
 }
 
+void cuda_fourier_polynomial_mul(void *input1, void *input2, void *output,
+                                 void *v_stream, uint32_t gpu_index,
+                                 uint32_t polynomial_size,
+                                 uint32_t total_polynomials) {
+  fourier_polynomial_mul<double2>((double2 *)input1, (double2 *)input2,
+                                  (double2 *)output, v_stream, gpu_index,
+                                  polynomial_size, total_polynomials);
+}
+
+/*
+ * Single precision variant of cuda_fourier_polynomial_mul, operating on
+ * float2 polynomials in the fourier domain.
+ */
+void cuda_fourier_polynomial_mul_f32(void *input1, void *input2, void *output,
+                                     void *v_stream, uint32_t gpu_index,
+                                     uint32_t polynomial_size,
+                                     uint32_t total_polynomials) {
+  cuda_initialize_twiddles_f32(v_stream, gpu_index);
+  fourier_polynomial_mul<float2>((float2 *)input1, (float2 *)input2,
+                                 (float2 *)output, v_stream, gpu_index,
+                                 polynomial_size, total_polynomials);
+}
+
+/*
+ * Select the FFT precision (32 or 64) to use for a bootstrap key. The
+ * FP32 butterflies lose about 29 bits of mantissa compared to the
+ * double precision path, so single precision is only selected when the
+ * products accumulated in the external product stay representable: a
+ * small polynomial and a decomposition that does not reach deep into
+ * the torus. The CONCRETE_CUDA_FFT_PRECISION environment variable
+ * ("32" or "64") overrides the heuristic, e.g. to force the double
+ * precision path when debugging noise issues.
+ */
+uint32_t cuda_get_pbs_fft_precision(uint32_t polynomial_size,
+                                    uint32_t base_log, uint32_t level_count) {
+  char *env = getenv("CONCRETE_CUDA_FFT_PRECISION");
+  if (env != nullptr) {
+    if (strcmp(env, "32") == 0)
+      return 32;
+    if (strcmp(env, "64") == 0)
+      return 64;
+  }
+  if (polynomial_size <= 1024 && base_log * level_count <= 16)
+    return 32;
+  return 64;
+}
+
 // We need these lines so the compiler knows how to specialize these functions
 template __device__ uint64_t *get_ith_mask_kth_block(uint64_t *ptr, int i,
                                                      int k, int level,
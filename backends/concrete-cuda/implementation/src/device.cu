@@ -1,6 +1,140 @@
 #include "device.h"
 #include <cstdint>
 #include <cuda_runtime.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/* Pinned host staging pool.
+ *
+ * The host buffers handed to the copy entry points come from the runtime's
+ * ciphertext memrefs and are pageable, so cudaMemcpyAsync on them degrades
+ * to a synchronous copy and transfers cannot overlap with compute. Copies
+ * are instead staged through a pool of page-locked buffers: the staging
+ * copy runs on the CPU, the DMA out of (or into) the pinned buffer is truly
+ * asynchronous, and a host function enqueued on the same stream returns the
+ * buffer to the pool once the transfer is done. Buffers are recycled by
+ * power-of-two size class to amortize the (expensive) cudaMallocHost calls
+ * across batched uploads and downloads.
+ */
+namespace {
+
+constexpr uint64_t max_pinned_pool_bytes = 1ull << 29;
+
+std::mutex pinned_pool_mutex;
+std::map<uint64_t, std::vector<void *>> pinned_pool;
+uint64_t pinned_pool_bytes = 0;
+
+uint64_t pinned_class_size(uint64_t size) {
+  uint64_t rounded = 4096;
+  while (rounded < size)
+    rounded <<= 1;
+  return rounded;
+}
+
+// Frees cached buffers until the pool is back under its byte cap.
+// Calls cudaFreeHost, so it must only run on a normal thread, never in
+// a stream callback.
+void pinned_pool_trim() {
+  std::vector<void *> surplus;
+  {
+    const std::lock_guard<std::mutex> guard(pinned_pool_mutex);
+    auto it = pinned_pool.rbegin();
+    while (pinned_pool_bytes > max_pinned_pool_bytes &&
+           it != pinned_pool.rend()) {
+      if (it->second.empty()) {
+        ++it;
+        continue;
+      }
+      // Drop from the largest size class first
+      surplus.push_back(it->second.back());
+      it->second.pop_back();
+      pinned_pool_bytes -= it->first;
+    }
+  }
+  for (void *ptr : surplus)
+    cudaFreeHost(ptr);
+}
+
+void *pinned_acquire(uint64_t size) {
+  // Completion callbacks may have pushed the pool over its cap (see
+  // pinned_release); trim it here, on a normal thread.
+  pinned_pool_trim();
+  uint64_t rounded = pinned_class_size(size);
+  {
+    const std::lock_guard<std::mutex> guard(pinned_pool_mutex);
+    auto it = pinned_pool.find(rounded);
+    if (it != pinned_pool.end() && !it->second.empty()) {
+      void *ptr = it->second.back();
+      it->second.pop_back();
+      pinned_pool_bytes -= rounded;
+      return ptr;
+    }
+  }
+  void *ptr = nullptr;
+  if (cudaMallocHost(&ptr, rounded) != cudaSuccess) {
+    cudaGetLastError();
+    return nullptr;
+  }
+  return ptr;
+}
+
+// Returns a buffer to the pool. Runs in stream callbacks, where calling
+// back into the CUDA API (cudaFreeHost included) is forbidden, so the
+// buffer is cached unconditionally even if that takes the pool over its
+// byte cap; the surplus is trimmed by the next acquisition from a
+// normal thread.
+void pinned_release(void *ptr, uint64_t size) {
+  uint64_t rounded = pinned_class_size(size);
+  const std::lock_guard<std::mutex> guard(pinned_pool_mutex);
+  pinned_pool[rounded].push_back(ptr);
+  pinned_pool_bytes += rounded;
+}
+
+// Completion callbacks run in stream order, so by the time one executes the
+// transfer using its staging buffer is done.
+struct staging_transfer {
+  void *staging;
+  uint64_t size;
+  // Only set for device-to-host transfers: the pageable destination the
+  // staged data still has to be copied to.
+  void *dest;
+};
+
+void CUDART_CB staging_to_gpu_done(void *user_data) {
+  auto transfer = static_cast<staging_transfer *>(user_data);
+  pinned_release(transfer->staging, transfer->size);
+  delete transfer;
+}
+
+void CUDART_CB staging_to_cpu_done(void *user_data) {
+  auto transfer = static_cast<staging_transfer *>(user_data);
+  memcpy(transfer->dest, transfer->staging, transfer->size);
+  pinned_release(transfer->staging, transfer->size);
+  delete transfer;
+}
+
+bool is_pageable_host_pointer(const void *ptr) {
+  cudaPointerAttributes attr;
+  if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    // Pre-11 runtimes return an error for unregistered host pointers
+    cudaGetLastError();
+    return true;
+  }
+  return attr.type == cudaMemoryTypeUnregistered;
+}
+
+} // namespace
+
+/// Releases the pinned buffers cached for staged host/device transfers
+void cuda_drop_pinned_buffer_pool() {
+  const std::lock_guard<std::mutex> guard(pinned_pool_mutex);
+  for (auto &size_class : pinned_pool)
+    for (auto ptr : size_class.second)
+      cudaFreeHost(ptr);
+  pinned_pool.clear();
+  pinned_pool_bytes = 0;
+}
 
 /// Unsafe function to create a CUDA stream, must check first that GPU exists
 cudaStream_t *cuda_create_stream(uint32_t gpu_index) {
@@ -109,6 +243,20 @@ int cuda_memcpy_async_to_gpu(void *dest, void *src, uint64_t size,
   }
 
   cudaSetDevice(gpu_index);
+  if (is_pageable_host_pointer(src)) {
+    void *staging = pinned_acquire(size);
+    if (staging != nullptr) {
+      memcpy(staging, src, size);
+      check_cuda_error(cudaMemcpyAsync(dest, staging, size,
+                                       cudaMemcpyHostToDevice, *stream));
+      check_cuda_error(cudaLaunchHostFunc(
+          *stream, staging_to_gpu_done,
+          new staging_transfer{staging, size, nullptr}));
+      return 0;
+    }
+    // Pinned allocation failed, fall through to the (synchronizing)
+    // pageable copy
+  }
   check_cuda_error(
       cudaMemcpyAsync(dest, src, size, cudaMemcpyHostToDevice, *stream));
   return 0;
@@ -173,6 +321,21 @@ int cuda_memcpy_async_to_cpu(void *dest, const void *src, uint64_t size,
   }
 
   cudaSetDevice(gpu_index);
+  if (is_pageable_host_pointer(dest)) {
+    void *staging = pinned_acquire(size);
+    if (staging != nullptr) {
+      check_cuda_error(cudaMemcpyAsync(staging, src, size,
+                                       cudaMemcpyDeviceToHost, *stream));
+      // The callback copies the staged data into dest, so dest is valid
+      // once the caller synchronizes the stream, as before
+      check_cuda_error(cudaLaunchHostFunc(
+          *stream, staging_to_cpu_done,
+          new staging_transfer{staging, size, dest}));
+      return 0;
+    }
+    // Pinned allocation failed, fall through to the (synchronizing)
+    // pageable copy
+  }
   check_cuda_error(
       cudaMemcpyAsync(dest, src, size, cudaMemcpyDeviceToHost, *stream));
   return 0;
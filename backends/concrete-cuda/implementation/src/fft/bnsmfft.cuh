@@ -22,7 +22,8 @@
  *     is replaced with:
  *     \zeta_j,k = exp(-i pi (2j-1)/2^k)
  */
-template <class params> __device__ void NSMFFT_direct(double2 *A) {
+template <class params, typename C = double2>
+__device__ void NSMFFT_direct(C *A) {
 
   /* We don't make bit reverse here, since twiddles are already reversed
    *  Each thread is always in charge of "opt/2" pairs of coefficients,
@@ -34,7 +35,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
   size_t tid = threadIdx.x;
   size_t twid_id;
   size_t i1, i2;
-  double2 u, v, w;
+  C u, v, w;
   // level 1
   // we don't make actual complex multiplication on level1 since we have only
   // one twiddle, it's real and image parts are equal, so we can multiply
@@ -67,7 +68,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
     twid_id = tid / (params::degree / 4);
     i1 = 2 * (params::degree / 4) * twid_id + (tid & (params::degree / 4 - 1));
     i2 = i1 + params::degree / 4;
-    w = negtwiddles[twid_id + 2];
+    w = neg_twiddle<C>(twid_id + 2);
     u = A[i1];
     v.x = A[i2].x * w.x - A[i2].y * w.y;
     v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -86,7 +87,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
     twid_id = tid / (params::degree / 8);
     i1 = 2 * (params::degree / 8) * twid_id + (tid & (params::degree / 8 - 1));
     i2 = i1 + params::degree / 8;
-    w = negtwiddles[twid_id + 4];
+    w = neg_twiddle<C>(twid_id + 4);
     u = A[i1];
     v.x = A[i2].x * w.x - A[i2].y * w.y;
     v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -106,7 +107,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
     i1 =
         2 * (params::degree / 16) * twid_id + (tid & (params::degree / 16 - 1));
     i2 = i1 + params::degree / 16;
-    w = negtwiddles[twid_id + 8];
+    w = neg_twiddle<C>(twid_id + 8);
     u = A[i1];
     v.x = A[i2].x * w.x - A[i2].y * w.y;
     v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -126,7 +127,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
     i1 =
         2 * (params::degree / 32) * twid_id + (tid & (params::degree / 32 - 1));
     i2 = i1 + params::degree / 32;
-    w = negtwiddles[twid_id + 16];
+    w = neg_twiddle<C>(twid_id + 16);
     u = A[i1];
     v.x = A[i2].x * w.x - A[i2].y * w.y;
     v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -146,7 +147,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
     i1 =
         2 * (params::degree / 64) * twid_id + (tid & (params::degree / 64 - 1));
     i2 = i1 + params::degree / 64;
-    w = negtwiddles[twid_id + 32];
+    w = neg_twiddle<C>(twid_id + 32);
     u = A[i1];
     v.x = A[i2].x * w.x - A[i2].y * w.y;
     v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -166,7 +167,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
     i1 = 2 * (params::degree / 128) * twid_id +
          (tid & (params::degree / 128 - 1));
     i2 = i1 + params::degree / 128;
-    w = negtwiddles[twid_id + 64];
+    w = neg_twiddle<C>(twid_id + 64);
     u = A[i1];
     v.x = A[i2].x * w.x - A[i2].y * w.y;
     v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -193,7 +194,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
       i1 = 2 * (params::degree / 256) * twid_id +
            (tid & (params::degree / 256 - 1));
       i2 = i1 + params::degree / 256;
-      w = negtwiddles[twid_id + 128];
+      w = neg_twiddle<C>(twid_id + 128);
       u = A[i1];
       v.x = A[i2].x * w.x - A[i2].y * w.y;
       v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -215,7 +216,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
       i1 = 2 * (params::degree / 512) * twid_id +
            (tid & (params::degree / 512 - 1));
       i2 = i1 + params::degree / 512;
-      w = negtwiddles[twid_id + 256];
+      w = neg_twiddle<C>(twid_id + 256);
       u = A[i1];
       v.x = A[i2].x * w.x - A[i2].y * w.y;
       v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -237,7 +238,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
       i1 = 2 * (params::degree / 1024) * twid_id +
            (tid & (params::degree / 1024 - 1));
       i2 = i1 + params::degree / 1024;
-      w = negtwiddles[twid_id + 512];
+      w = neg_twiddle<C>(twid_id + 512);
       u = A[i1];
       v.x = A[i2].x * w.x - A[i2].y * w.y;
       v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -259,7 +260,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
       i1 = 2 * (params::degree / 2048) * twid_id +
            (tid & (params::degree / 2048 - 1));
       i2 = i1 + params::degree / 2048;
-      w = negtwiddles[twid_id + 1024];
+      w = neg_twiddle<C>(twid_id + 1024);
       u = A[i1];
       v.x = A[i2].x * w.x - A[i2].y * w.y;
       v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -281,7 +282,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
       i1 = 2 * (params::degree / 4096) * twid_id +
            (tid & (params::degree / 4096 - 1));
       i2 = i1 + params::degree / 4096;
-      w = negtwiddles[twid_id + 2048];
+      w = neg_twiddle<C>(twid_id + 2048);
       u = A[i1];
       v.x = A[i2].x * w.x - A[i2].y * w.y;
       v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -306,7 +307,7 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
       i1 = 2 * (params::degree / 8192) * twid_id +
            (tid & (params::degree / 8192 - 1));
       i2 = i1 + params::degree / 8192;
-      w = negtwiddles13[twid_id];
+      w = neg_twiddle13<C>(twid_id);
       u = A[i1];
       v.x = A[i2].x * w.x - A[i2].y * w.y;
       v.y = A[i2].y * w.x + A[i2].x * w.y;
@@ -323,7 +324,8 @@ template <class params> __device__ void NSMFFT_direct(double2 *A) {
 /*
  * negacyclic inverse fft
  */
-template <class params> __device__ void NSMFFT_inverse(double2 *A) {
+template <class params, typename C = double2>
+__device__ void NSMFFT_inverse(C *A) {
 
   /* We don't make bit reverse here, since twiddles are already reversed
    *  Each thread is always in charge of "opt/2" pairs of coefficients,
@@ -335,7 +337,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
   size_t tid = threadIdx.x;
   size_t twid_id;
   size_t i1, i2;
-  double2 u, w;
+  C u, w;
 
   // divide input by compressed polynomial size
   tid = threadIdx.x;
@@ -365,7 +367,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
       i1 = 2 * (params::degree / 8192) * twid_id +
            (tid & (params::degree / 8192 - 1));
       i2 = i1 + params::degree / 8192;
-      w = negtwiddles13[twid_id];
+      w = neg_twiddle13<C>(twid_id);
       u.x = A[i1].x - A[i2].x;
       u.y = A[i1].y - A[i2].y;
       A[i1].x += A[i2].x;
@@ -387,7 +389,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
       i1 = 2 * (params::degree / 4096) * twid_id +
            (tid & (params::degree / 4096 - 1));
       i2 = i1 + params::degree / 4096;
-      w = negtwiddles[twid_id + 2048];
+      w = neg_twiddle<C>(twid_id + 2048);
       u.x = A[i1].x - A[i2].x;
       u.y = A[i1].y - A[i2].y;
       A[i1].x += A[i2].x;
@@ -409,7 +411,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
       i1 = 2 * (params::degree / 2048) * twid_id +
            (tid & (params::degree / 2048 - 1));
       i2 = i1 + params::degree / 2048;
-      w = negtwiddles[twid_id + 1024];
+      w = neg_twiddle<C>(twid_id + 1024);
       u.x = A[i1].x - A[i2].x;
       u.y = A[i1].y - A[i2].y;
       A[i1].x += A[i2].x;
@@ -431,7 +433,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
       i1 = 2 * (params::degree / 1024) * twid_id +
            (tid & (params::degree / 1024 - 1));
       i2 = i1 + params::degree / 1024;
-      w = negtwiddles[twid_id + 512];
+      w = neg_twiddle<C>(twid_id + 512);
       u.x = A[i1].x - A[i2].x;
       u.y = A[i1].y - A[i2].y;
       A[i1].x += A[i2].x;
@@ -453,7 +455,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
       i1 = 2 * (params::degree / 512) * twid_id +
            (tid & (params::degree / 512 - 1));
       i2 = i1 + params::degree / 512;
-      w = negtwiddles[twid_id + 256];
+      w = neg_twiddle<C>(twid_id + 256);
       u.x = A[i1].x - A[i2].x;
       u.y = A[i1].y - A[i2].y;
       A[i1].x += A[i2].x;
@@ -475,7 +477,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
       i1 = 2 * (params::degree / 256) * twid_id +
            (tid & (params::degree / 256 - 1));
       i2 = i1 + params::degree / 256;
-      w = negtwiddles[twid_id + 128];
+      w = neg_twiddle<C>(twid_id + 128);
       u.x = A[i1].x - A[i2].x;
       u.y = A[i1].y - A[i2].y;
       A[i1].x += A[i2].x;
@@ -502,7 +504,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     i1 = 2 * (params::degree / 128) * twid_id +
          (tid & (params::degree / 128 - 1));
     i2 = i1 + params::degree / 128;
-    w = negtwiddles[twid_id + 64];
+    w = neg_twiddle<C>(twid_id + 64);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -522,7 +524,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     i1 =
         2 * (params::degree / 64) * twid_id + (tid & (params::degree / 64 - 1));
     i2 = i1 + params::degree / 64;
-    w = negtwiddles[twid_id + 32];
+    w = neg_twiddle<C>(twid_id + 32);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -542,7 +544,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     i1 =
         2 * (params::degree / 32) * twid_id + (tid & (params::degree / 32 - 1));
     i2 = i1 + params::degree / 32;
-    w = negtwiddles[twid_id + 16];
+    w = neg_twiddle<C>(twid_id + 16);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -562,7 +564,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     i1 =
         2 * (params::degree / 16) * twid_id + (tid & (params::degree / 16 - 1));
     i2 = i1 + params::degree / 16;
-    w = negtwiddles[twid_id + 8];
+    w = neg_twiddle<C>(twid_id + 8);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -581,7 +583,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     twid_id = tid / (params::degree / 8);
     i1 = 2 * (params::degree / 8) * twid_id + (tid & (params::degree / 8 - 1));
     i2 = i1 + params::degree / 8;
-    w = negtwiddles[twid_id + 4];
+    w = neg_twiddle<C>(twid_id + 4);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -600,7 +602,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     twid_id = tid / (params::degree / 4);
     i1 = 2 * (params::degree / 4) * twid_id + (tid & (params::degree / 4 - 1));
     i2 = i1 + params::degree / 4;
-    w = negtwiddles[twid_id + 2];
+    w = neg_twiddle<C>(twid_id + 2);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -619,7 +621,7 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
     twid_id = tid / (params::degree / 2);
     i1 = 2 * (params::degree / 2) * twid_id + (tid & (params::degree / 2 - 1));
     i2 = i1 + params::degree / 2;
-    w = negtwiddles[twid_id + 1];
+    w = neg_twiddle<C>(twid_id + 1);
     u.x = A[i1].x - A[i2].x;
     u.y = A[i1].y - A[i2].y;
     A[i1].x += A[i2].x;
@@ -639,12 +641,13 @@ template <class params> __device__ void NSMFFT_inverse(double2 *A) {
  * this function must be called with actual degree
  * function takes as input already compressed input
  */
-template <class params, sharedMemDegree SMD>
-__global__ void batch_NSMFFT(double2 *d_input, double2 *d_output,
-                             double2 *buffer) {
-  extern __shared__ double2 sharedMemoryFFT[];
-  double2 *fft = (SMD == NOSM) ? &buffer[blockIdx.x * params::degree / 2]
-                               : sharedMemoryFFT;
+template <class params, sharedMemDegree SMD, typename C = double2>
+__global__ void batch_NSMFFT(C *d_input, C *d_output, C *buffer) {
+  // the raw shared array is casted so that double2 and float2
+  // instantiations can share one extern declaration
+  extern __shared__ int8_t sharedMemoryFFT[];
+  C *fft = (SMD == NOSM) ? &buffer[blockIdx.x * params::degree / 2]
+                         : (C *)sharedMemoryFFT;
   int tid = threadIdx.x;
 
 #pragma unroll
@@ -670,12 +673,12 @@ __global__ void batch_NSMFFT(double2 *d_input, double2 *d_output,
  * d_input1 and d_output must not have the same pointer
  * d_input1 can be modified inside the function
  */
-template <class params, sharedMemDegree SMD>
-__global__ void batch_polynomial_mul(double2 *d_input1, double2 *d_input2,
-                                     double2 *d_output, double2 *buffer) {
-  extern __shared__ double2 sharedMemoryFFT[];
-  double2 *fft = (SMD == NOSM) ? &buffer[blockIdx.x * params::degree / 2]
-                               : sharedMemoryFFT;
+template <class params, sharedMemDegree SMD, typename C = double2>
+__global__ void batch_polynomial_mul(C *d_input1, C *d_input2, C *d_output,
+                                     C *buffer) {
+  extern __shared__ int8_t sharedMemoryFFT[];
+  C *fft = (SMD == NOSM) ? &buffer[blockIdx.x * params::degree / 2]
+                         : (C *)sharedMemoryFFT;
 
   // Move first polynomial into shared memory(if possible otherwise it will
   // be moved in device buffer)
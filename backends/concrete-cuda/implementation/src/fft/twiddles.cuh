@@ -2,6 +2,8 @@
 #ifndef GPU_BOOTSTRAP_TWIDDLES_CUH
 #define GPU_BOOTSTRAP_TWIDDLES_CUH
 
+#include <cstdint>
+
 /*
  * 'negtwiddles' are stored in constant memory for faster access times
  * because of it's limitied size, only twiddles for up to 2^12 polynomial size
@@ -11,4 +13,36 @@
 
 extern __constant__ double2 negtwiddles[4096];
 extern __device__ double2 negtwiddles13[4096];
+
+/*
+ * single precision copies of the twiddle tables, used by the FP32
+ * instantiation of the FFT; they are filled from the double precision
+ * tables by cuda_initialize_twiddles_f32, which must have been called
+ * on the target device before an FP32 FFT kernel is launched
+ */
+
+extern __device__ float2 negtwiddles_f32[4096];
+extern __device__ float2 negtwiddles13_f32[4096];
+
+void cuda_initialize_twiddles_f32(void *v_stream, uint32_t gpu_index);
+
+/*
+ * precision dispatched twiddle accessors for the FFT butterflies
+ */
+
+template <typename C> __device__ inline C neg_twiddle(size_t i);
+template <typename C> __device__ inline C neg_twiddle13(size_t i);
+
+template <> __device__ inline double2 neg_twiddle<double2>(size_t i) {
+  return negtwiddles[i];
+}
+template <> __device__ inline double2 neg_twiddle13<double2>(size_t i) {
+  return negtwiddles13[i];
+}
+template <> __device__ inline float2 neg_twiddle<float2>(size_t i) {
+  return negtwiddles_f32[i];
+}
+template <> __device__ inline float2 neg_twiddle13<float2>(size_t i) {
+  return negtwiddles13_f32[i];
+}
 #endif
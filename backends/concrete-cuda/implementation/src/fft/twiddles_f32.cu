@@ -0,0 +1,44 @@
+#include "device.h"
+#include "twiddles.cuh"
+#include <mutex>
+#include <set>
+
+/*
+ * Single precision twiddle tables. The double precision tables in
+ * twiddles.cu are the reference; these copies are derived from them on
+ * the device the first time an FP32 FFT is requested, so the two sets
+ * can never diverge.
+ */
+
+__device__ float2 negtwiddles_f32[4096];
+__device__ float2 negtwiddles13_f32[4096];
+
+__global__ void device_convert_twiddles_f32() {
+  int tid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (tid < 4096) {
+    negtwiddles_f32[tid] =
+        make_float2((float)negtwiddles[tid].x, (float)negtwiddles[tid].y);
+    negtwiddles13_f32[tid] =
+        make_float2((float)negtwiddles13[tid].x, (float)negtwiddles13[tid].y);
+  }
+}
+
+/*
+ * Fill the single precision twiddle tables on the given device. The
+ * conversion runs once per device; subsequent calls are no-ops. The
+ * kernel is enqueued on the caller's stream, so FP32 FFT launches
+ * ordered after this call on the same stream see initialized tables.
+ */
+void cuda_initialize_twiddles_f32(void *v_stream, uint32_t gpu_index) {
+  static std::mutex m;
+  static std::set<uint32_t> initialized_devices;
+
+  std::lock_guard<std::mutex> lock(m);
+  if (!initialized_devices.insert(gpu_index).second)
+    return;
+
+  cudaSetDevice(gpu_index);
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  device_convert_twiddles_f32<<<16, 256, 0, *stream>>>();
+  check_cuda_error(cudaGetLastError());
+}
@@ -0,0 +1,143 @@
+#include "bootstrap.h"
+#include "device.h"
+#include "keyswitch.cuh"
+#include "keyswitch.h"
+
+#include <cstdint>
+
+/* Perform keyswitch followed by an amortized bootstrap on a batch of 32 bits
+ * input LWE ciphertexts. Head out to the equivalent operation on 64 bits for
+ * more details.
+ */
+void cuda_keyswitch_bootstrap_amortized_lwe_ciphertext_vector_32(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint32_t *lwe_after_ks = (uint32_t *)cuda_malloc_async(
+      (uint64_t)num_samples * (lwe_dimension_out + 1) * sizeof(uint32_t),
+      stream, gpu_index);
+  cuda_keyswitch_lwe_ciphertext_vector(
+      v_stream, gpu_index, lwe_after_ks, static_cast<uint32_t *>(lwe_array_in),
+      static_cast<uint32_t *>(ksk), lwe_dimension_in, lwe_dimension_out,
+      ks_base_log, ks_level, num_samples);
+  cuda_bootstrap_amortized_lwe_ciphertext_vector_32(
+      v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+      lwe_after_ks, bootstrapping_key, pbs_buffer, lwe_dimension_out,
+      glwe_dimension, polynomial_size, pbs_base_log, pbs_level, num_samples,
+      num_lut_vectors, lwe_idx, max_shared_memory);
+  cuda_drop_async(lwe_after_ks, stream, gpu_index);
+}
+
+/* Perform keyswitch followed by an amortized bootstrap on a batch of 64 bits
+ * input LWE ciphertexts.
+ *
+ * The two operations are chained on the same Cuda stream and the keyswitched
+ * ciphertexts stay in a device buffer allocated (and released) by this
+ * function: compared to two separate calls, the intermediate LWE ciphertexts
+ * never cross back over PCIe and no synchronization happens between the two
+ * kernels.
+ *
+ * - `v_stream` is a void pointer to the Cuda stream to be used in the kernel
+ * launches
+ * - `gpu_index` is the index of the GPU to be used in the kernel launches
+ * - `lwe_array_out`: output batch of num_samples bootstrapped ciphertexts
+ * - `lut_vector` / `lut_vector_indexes`: lookup tables and per-sample indexes,
+ * as in the amortized bootstrap
+ * - `lwe_array_in`: input batch of num_samples LWE ciphertexts of dimension
+ * `lwe_dimension_in`
+ * - `ksk`: keyswitch key from dimension `lwe_dimension_in` to
+ * `lwe_dimension_out`
+ * - `bootstrapping_key`: GGSW encryption of the LWE secret key of dimension
+ * `lwe_dimension_out`, in the Fourier domain
+ * - `pbs_buffer`: a scratch buffer obtained from
+ * scratch_cuda_bootstrap_amortized_64
+ *
+ * The keyswitch uses the (`ks_base_log`, `ks_level`) decomposition and the
+ * bootstrap the (`pbs_base_log`, `pbs_level`) one.
+ */
+void cuda_keyswitch_bootstrap_amortized_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint64_t *lwe_after_ks = (uint64_t *)cuda_malloc_async(
+      (uint64_t)num_samples * (lwe_dimension_out + 1) * sizeof(uint64_t),
+      stream, gpu_index);
+  cuda_keyswitch_lwe_ciphertext_vector(
+      v_stream, gpu_index, lwe_after_ks, static_cast<uint64_t *>(lwe_array_in),
+      static_cast<uint64_t *>(ksk), lwe_dimension_in, lwe_dimension_out,
+      ks_base_log, ks_level, num_samples);
+  cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+      v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+      lwe_after_ks, bootstrapping_key, pbs_buffer, lwe_dimension_out,
+      glwe_dimension, polynomial_size, pbs_base_log, pbs_level, num_samples,
+      num_lut_vectors, lwe_idx, max_shared_memory);
+  cuda_drop_async(lwe_after_ks, stream, gpu_index);
+}
+
+/* Perform keyswitch followed by a low latency bootstrap on a batch of 32 bits
+ * input LWE ciphertexts. Head out to the equivalent operation on 64 bits for
+ * more details.
+ */
+void cuda_keyswitch_bootstrap_low_latency_lwe_ciphertext_vector_32(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint32_t *lwe_after_ks = (uint32_t *)cuda_malloc_async(
+      (uint64_t)num_samples * (lwe_dimension_out + 1) * sizeof(uint32_t),
+      stream, gpu_index);
+  cuda_keyswitch_lwe_ciphertext_vector(
+      v_stream, gpu_index, lwe_after_ks, static_cast<uint32_t *>(lwe_array_in),
+      static_cast<uint32_t *>(ksk), lwe_dimension_in, lwe_dimension_out,
+      ks_base_log, ks_level, num_samples);
+  cuda_bootstrap_low_latency_lwe_ciphertext_vector_32(
+      v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+      lwe_after_ks, bootstrapping_key, pbs_buffer, lwe_dimension_out,
+      glwe_dimension, polynomial_size, pbs_base_log, pbs_level, num_samples,
+      num_lut_vectors, lwe_idx, max_shared_memory);
+  cuda_drop_async(lwe_after_ks, stream, gpu_index);
+}
+
+/* Perform keyswitch followed by a low latency bootstrap on a batch of 64 bits
+ * input LWE ciphertexts. The chaining works exactly as in
+ * cuda_keyswitch_bootstrap_amortized_lwe_ciphertext_vector_64, with the
+ * low latency bootstrap implementation and a `pbs_buffer` obtained from
+ * scratch_cuda_bootstrap_low_latency_64.
+ */
+void cuda_keyswitch_bootstrap_low_latency_lwe_ciphertext_vector_64(
+    void *v_stream, uint32_t gpu_index, void *lwe_array_out, void *lut_vector,
+    void *lut_vector_indexes, void *lwe_array_in, void *ksk,
+    void *bootstrapping_key, int8_t *pbs_buffer, uint32_t lwe_dimension_in,
+    uint32_t lwe_dimension_out, uint32_t ks_base_log, uint32_t ks_level,
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t pbs_base_log,
+    uint32_t pbs_level, uint32_t num_samples, uint32_t num_lut_vectors,
+    uint32_t lwe_idx, uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint64_t *lwe_after_ks = (uint64_t *)cuda_malloc_async(
+      (uint64_t)num_samples * (lwe_dimension_out + 1) * sizeof(uint64_t),
+      stream, gpu_index);
+  cuda_keyswitch_lwe_ciphertext_vector(
+      v_stream, gpu_index, lwe_after_ks, static_cast<uint64_t *>(lwe_array_in),
+      static_cast<uint64_t *>(ksk), lwe_dimension_in, lwe_dimension_out,
+      ks_base_log, ks_level, num_samples);
+  cuda_bootstrap_low_latency_lwe_ciphertext_vector_64(
+      v_stream, gpu_index, lwe_array_out, lut_vector, lut_vector_indexes,
+      lwe_after_ks, bootstrapping_key, pbs_buffer, lwe_dimension_out,
+      glwe_dimension, polynomial_size, pbs_base_log, pbs_level, num_samples,
+      num_lut_vectors, lwe_idx, max_shared_memory);
+  cuda_drop_async(lwe_after_ks, stream, gpu_index);
+}
@@ -229,6 +229,74 @@ __global__ void device_batch_cmux(Torus *glwe_array_out, Torus *glwe_array_in,
                               level_count, ggsw_idx);
 }
 
+/**
+ * Computes a full subtree of CMUXes in one thread block, keeping the subtree
+ * operands in shared memory. The per-layer kernel reloads half of its GLWE
+ * operands from global memory at every level; here a block loads the
+ * 2^tile_depth leaves of its subtree once, reduces them in place over
+ * tile_depth levels and writes a single GLWE back, roughly halving the
+ * global traffic of the tree. The CMUXes of a subtree run sequentially in
+ * the block, so this is only worth it when enough blocks remain to fill the
+ * device (see get_cmux_tree_tile_depth).
+ *
+ * - layer_base: index of the first GGSW layer consumed by this launch.
+ * - tile_depth: number of consecutive layers folded in this launch.
+ * Other arguments are as in device_batch_cmux. Requires shared memory for
+ * the tile plus one CMUX's accumulators (FULLSM only).
+ */
+template <typename Torus, typename STorus, class params>
+__global__ void device_batch_cmux_tiled(Torus *glwe_array_out,
+                                        Torus *glwe_array_in, double2 *ggsw_in,
+                                        uint32_t glwe_dim,
+                                        uint32_t polynomial_size,
+                                        uint32_t base_log, uint32_t level_count,
+                                        uint32_t layer_base,
+                                        uint32_t tile_depth, uint32_t num_lut) {
+
+  // We are running gridDim.y cmux trees in parallel
+  int tree_idx = blockIdx.y;
+  int tree_offset = tree_idx * num_lut * (glwe_dim + 1) * polynomial_size;
+
+  auto block_glwe_array_out = glwe_array_out + tree_offset;
+  auto block_glwe_array_in = glwe_array_in + tree_offset;
+
+  uint32_t glwe_size = (glwe_dim + 1) * polynomial_size;
+  uint32_t tile_inputs = 1 << tile_depth;
+
+  extern __shared__ int8_t sharedmem[];
+  Torus *tile = (Torus *)sharedmem;
+  int8_t *cmux_memory = (int8_t *)(tile + tile_inputs * glwe_size);
+
+  // Load the subtree leaves once
+  uint64_t first_input = (uint64_t)blockIdx.x * tile_inputs * glwe_size;
+  int tid = threadIdx.x;
+  for (int j = 0; j < tile_inputs * (glwe_dim + 1) * params::opt; j++) {
+    tile[tid] = block_glwe_array_in[first_input + tid];
+    tid += params::degree / params::opt;
+  }
+  synchronize_threads_in_block();
+
+  // Reduce the tile in place: level l leaves its outputs in the first
+  // 2^(tile_depth - 1 - l) slots, which never clobbers a pending input
+  // (output slot c only aliases input slot 2c when c == 0, the last read)
+  for (uint32_t layer = 0; layer < tile_depth; layer++) {
+    uint32_t num_cmuxes = 1 << (tile_depth - 1 - layer);
+    for (uint32_t c = 0; c < num_cmuxes; c++) {
+      cmux<Torus, STorus, params>(tile, tile, ggsw_in, cmux_memory, c, (c << 1),
+                                  (c << 1) + 1, glwe_dim, polynomial_size,
+                                  base_log, level_count, layer_base + layer);
+      synchronize_threads_in_block();
+    }
+  }
+
+  // Write the subtree root
+  tid = threadIdx.x;
+  for (int j = 0; j < (glwe_dim + 1) * params::opt; j++) {
+    block_glwe_array_out[(uint64_t)blockIdx.x * glwe_size + tid] = tile[tid];
+    tid += params::degree / params::opt;
+  }
+}
+
 template <typename Torus>
 __host__ __device__ uint64_t get_memory_needed_per_block_cmux_tree(
     uint32_t glwe_dimension, uint32_t polynomial_size) {
@@ -238,6 +306,33 @@ __host__ __device__ uint64_t get_memory_needed_per_block_cmux_tree(
          sizeof(double2) * polynomial_size / 2; // glwe_fft
 }
 
+template <typename Torus>
+__host__ __device__ uint64_t get_memory_needed_per_block_cmux_tree_tiled(
+    uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t tile_depth) {
+  return (1ull << tile_depth) * (glwe_dimension + 1) * polynomial_size *
+             sizeof(Torus) + // tile
+         get_memory_needed_per_block_cmux_tree<Torus>(glwe_dimension,
+                                                      polynomial_size);
+}
+
+// Picks the subtree depth for the tiled CMUX tree kernel: the largest depth
+// (capped at 4) whose tile still fits in shared memory next to the CMUX
+// accumulators. Depth 1 would tile single CMUXes and save nothing, so
+// anything below 2 selects the per-layer kernel instead (returns 0). Small
+// polynomials get deep tiles, large ones fall back to the per-layer path.
+template <typename Torus>
+__host__ uint32_t get_cmux_tree_tile_depth(uint32_t glwe_dimension,
+                                           uint32_t polynomial_size,
+                                           uint32_t max_shared_memory) {
+  uint32_t tile_depth = 0;
+  while (tile_depth < 4 &&
+         get_memory_needed_per_block_cmux_tree_tiled<Torus>(
+             glwe_dimension, polynomial_size, tile_depth + 1) <=
+             max_shared_memory)
+    tile_depth++;
+  return (tile_depth >= 2) ? tile_depth : 0;
+}
+
 template <typename Torus, typename params>
 __host__ __device__ uint64_t get_buffer_size_cmux_tree(
     uint32_t glwe_dimension, uint32_t polynomial_size, uint32_t level_count,
@@ -289,6 +384,18 @@ scratch_cmux_tree(void *v_stream, uint32_t gpu_index, int8_t **cmux_tree_buffer,
         cudaFuncSetCacheConfig(device_batch_cmux<Torus, STorus, params, FULLSM>,
                                cudaFuncCachePreferShared));
   }
+  uint32_t tile_depth = get_cmux_tree_tile_depth<Torus>(
+      glwe_dimension, polynomial_size, max_shared_memory);
+  if (tile_depth > 0) {
+    check_cuda_error(cudaFuncSetAttribute(
+        device_batch_cmux_tiled<Torus, STorus, params>,
+        cudaFuncAttributeMaxDynamicSharedMemorySize,
+        get_memory_needed_per_block_cmux_tree_tiled<Torus>(
+            glwe_dimension, polynomial_size, tile_depth)));
+    check_cuda_error(
+        cudaFuncSetCacheConfig(device_batch_cmux_tiled<Torus, STorus, params>,
+                               cudaFuncCachePreferShared));
+  }
 
   if (allocate_gpu_memory) {
     uint64_t buffer_size = get_buffer_size_cmux_tree<Torus, params>(
@@ -374,17 +481,34 @@ __host__ void host_cmux_tree(void *v_stream, uint32_t gpu_index,
                                          glwe_dimension, lut_vector_size, tau,
                                          stream);
 
-  Torus *output;
-  // Run the cmux tree
-  for (int layer_idx = 0; layer_idx < r; layer_idx++) {
-    output = (layer_idx % 2 ? (Torus *)d_buffer1 : (Torus *)d_buffer2);
-    Torus *input = (layer_idx % 2 ? (Torus *)d_buffer2 : (Torus *)d_buffer1);
-
-    int num_cmuxes = (1 << (r - 1 - layer_idx));
-    dim3 grid(num_cmuxes, tau, 1);
+  // Subtree depth folded per launch by the tiled kernel; 0 selects the
+  // per-layer kernel everywhere
+  uint32_t tile_depth = get_cmux_tree_tile_depth<Torus>(
+      glwe_dimension, polynomial_size, max_shared_memory);
 
-    // walks horizontally through the leaves
-    if (max_shared_memory < memory_needed_per_block) {
+  Torus *input = (Torus *)d_buffer1;
+  Torus *output = (Torus *)d_buffer2;
+  // Run the cmux tree
+  for (uint32_t layer_idx = 0; layer_idx < r;) {
+    uint32_t remaining = r - layer_idx;
+    // Fold a whole subtree per block while the levels and the shared
+    // memory allow it; finish the last levels with the per-layer kernel
+    uint32_t step =
+        (tile_depth >= 2 && remaining >= tile_depth) ? tile_depth : 1;
+    uint32_t num_blocks = (1 << (remaining - step));
+    dim3 grid(num_blocks, tau, 1);
+
+    if (step > 1) {
+      device_batch_cmux_tiled<Torus, STorus, params>
+          <<<grid, thds,
+             get_memory_needed_per_block_cmux_tree_tiled<Torus>(
+                 glwe_dimension, polynomial_size, step),
+             *stream>>>(output, input, d_ggsw_fft_in,
+                        glwe_dimension, // k
+                        polynomial_size, base_log, level_count, layer_idx, step,
+                        num_lut);
+    } else if (max_shared_memory < memory_needed_per_block) {
+      // walks horizontally through the leaves
       device_batch_cmux<Torus, STorus, params, NOSM>
           <<<grid, thds, 0, *stream>>>(output, input, d_ggsw_fft_in, d_mem,
                                        memory_needed_per_block,
@@ -402,7 +526,13 @@ __host__ void host_cmux_tree(void *v_stream, uint32_t gpu_index,
               num_lut);
     }
     check_cuda_error(cudaGetLastError());
+    Torus *tmp = input;
+    input = output;
+    output = tmp;
+    layer_idx += step;
   }
+  // After the final swap the last outputs are in `input`
+  output = input;
 
   for (int i = 0; i < tau; i++) {
     check_cuda_error(cudaMemcpyAsync(
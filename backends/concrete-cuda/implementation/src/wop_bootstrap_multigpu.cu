@@ -0,0 +1,260 @@
+#include "bit_extraction.h"
+#include "bootstrap.h"
+#include "circuit_bootstrap.h"
+#include "device.h"
+#include "vertical_packing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/* Multi-device driver for the WoP PBS.
+ *
+ * The WoP PBS is dominated by its first two stages: bit extraction runs
+ * per CRT input and circuit bootstrap runs per extracted bit, and both are
+ * embarrassingly parallel. This driver shards the CRT inputs (and with
+ * them their extracted bits) across the available GPUs, runs bit
+ * extraction and circuit bootstrap for each shard on its own device and
+ * stream, then gathers the GGSW ciphertexts on the first device where the
+ * CMUX tree and the final blind rotation + sample extraction run, as those
+ * reduce over all bits together.
+ *
+ * Keys are required on every device: the caller must have converted the
+ * bootstrapping key and copied the keyswitch and fp-keyswitch keys to each
+ * GPU listed in `gpu_indexes` and pass the per-device pointers. The input,
+ * the LUT vector and the output live on gpu_indexes[0]; shard inputs and
+ * GGSW shards are staged through the host (which goes through the pinned
+ * staging pool, so the transfers overlap across devices).
+ */
+
+namespace {
+
+constexpr uint32_t cbs_delta_log_64 = 63;
+
+uint64_t ggsw_sample_size(uint32_t glwe_dimension, uint32_t polynomial_size,
+                          uint32_t level_count_cbs) {
+  return (uint64_t)level_count_cbs * (glwe_dimension + 1) *
+         (glwe_dimension + 1) * polynomial_size;
+}
+
+// Work of one device: extract the bits of its CRT input shard, circuit
+// bootstrap them and download the resulting GGSW shard to the host
+void run_wop_pbs_shard(void *v_stream, uint32_t gpu_index,
+                       uint64_t *ggsw_out_host, uint64_t *lwe_array_in_host,
+                       void *fourier_bsk, void *ksk, void *cbs_fpksk,
+                       uint32_t glwe_dimension, uint32_t lwe_dimension,
+                       uint32_t polynomial_size, uint32_t base_log_bsk,
+                       uint32_t level_count_bsk, uint32_t base_log_ksk,
+                       uint32_t level_count_ksk, uint32_t base_log_pksk,
+                       uint32_t level_count_pksk, uint32_t base_log_cbs,
+                       uint32_t level_count_cbs,
+                       uint32_t *number_of_bits_to_extract_array,
+                       uint32_t *delta_log_array, uint32_t shard_inputs,
+                       uint32_t shard_bits, uint32_t max_shared_memory) {
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint64_t in_sample_size = (uint64_t)glwe_dimension * polynomial_size + 1;
+  uint64_t bit_sample_size = (uint64_t)lwe_dimension + 1;
+  uint64_t ggsw_size =
+      ggsw_sample_size(glwe_dimension, polynomial_size, level_count_cbs);
+
+  // Upload this shard's inputs
+  void *d_lwe_array_in = cuda_malloc_async(
+      shard_inputs * in_sample_size * sizeof(uint64_t), stream, gpu_index);
+  cuda_memcpy_async_to_gpu(d_lwe_array_in, lwe_array_in_host,
+                           shard_inputs * in_sample_size * sizeof(uint64_t),
+                           stream, gpu_index);
+
+  // Bit extraction of the shard's inputs
+  void *d_bits = cuda_malloc_async(
+      shard_bits * bit_sample_size * sizeof(uint64_t), stream, gpu_index);
+  int8_t *bit_extract_buffer = nullptr;
+  scratch_cuda_extract_bits_64(v_stream, gpu_index, &bit_extract_buffer,
+                               glwe_dimension, lwe_dimension, polynomial_size,
+                               level_count_bsk, shard_inputs, max_shared_memory,
+                               true);
+  cuda_extract_bits_64(v_stream, gpu_index, d_bits, d_lwe_array_in,
+                       bit_extract_buffer, ksk, fourier_bsk,
+                       number_of_bits_to_extract_array, delta_log_array,
+                       glwe_dimension * polynomial_size, lwe_dimension,
+                       glwe_dimension, polynomial_size, base_log_bsk,
+                       level_count_bsk, base_log_ksk, level_count_ksk,
+                       shard_inputs, max_shared_memory);
+  cleanup_cuda_extract_bits(v_stream, gpu_index, &bit_extract_buffer);
+
+  // Circuit bootstrap of the shard's bits into GGSWs
+  uint64_t *h_lut_vector_indexes = (uint64_t *)malloc(
+      (uint64_t)shard_bits * level_count_cbs * sizeof(uint64_t));
+  for (uint32_t index = 0; index < shard_bits * level_count_cbs; index++) {
+    h_lut_vector_indexes[index] = index % level_count_cbs;
+  }
+  void *d_lut_vector_indexes = cuda_malloc_async(
+      (uint64_t)shard_bits * level_count_cbs * sizeof(uint64_t), stream,
+      gpu_index);
+  cuda_memcpy_async_to_gpu(d_lut_vector_indexes, h_lut_vector_indexes,
+                           (uint64_t)shard_bits * level_count_cbs *
+                               sizeof(uint64_t),
+                           stream, gpu_index);
+  void *d_ggsw = cuda_malloc_async(
+      shard_bits * ggsw_size * sizeof(uint64_t), stream, gpu_index);
+  int8_t *cbs_buffer = nullptr;
+  // The batch entry point splits the shard's bits into chunks that satisfy
+  // the occupancy bound of the circuit bootstrap, reusing one scratch
+  scratch_cuda_circuit_bootstrap_batch_64(v_stream, gpu_index, &cbs_buffer,
+                                          glwe_dimension, lwe_dimension,
+                                          polynomial_size, level_count_bsk,
+                                          level_count_cbs, shard_bits,
+                                          max_shared_memory, true);
+  cuda_circuit_bootstrap_batch_64(
+      v_stream, gpu_index, d_ggsw, d_bits, fourier_bsk, cbs_fpksk,
+      d_lut_vector_indexes, cbs_buffer, cbs_delta_log_64, polynomial_size,
+      glwe_dimension, lwe_dimension, level_count_bsk, base_log_bsk,
+      level_count_pksk, base_log_pksk, level_count_cbs, base_log_cbs,
+      shard_bits, max_shared_memory);
+  cleanup_cuda_circuit_bootstrap(v_stream, gpu_index, &cbs_buffer);
+
+  // Bring this shard's GGSWs back to the host gather buffer
+  cuda_memcpy_async_to_cpu(ggsw_out_host, d_ggsw,
+                           shard_bits * ggsw_size * sizeof(uint64_t), stream,
+                           gpu_index);
+  cuda_synchronize_stream(v_stream);
+  free(h_lut_vector_indexes);
+  cuda_drop_async(d_lwe_array_in, stream, gpu_index);
+  cuda_drop_async(d_bits, stream, gpu_index);
+  cuda_drop_async(d_lut_vector_indexes, stream, gpu_index);
+  cuda_drop_async(d_ggsw, stream, gpu_index);
+  cuda_synchronize_stream(v_stream);
+}
+
+} // namespace
+
+/* Entry point for the WoP PBS sharded across multiple devices, on 64 bit
+ * input LWE ciphertexts.
+ * - `v_streams` / `gpu_indexes` / `gpu_count`: one stream per device; the
+ *   input, LUT vector and output are expected on gpu_indexes[0]
+ * - `fourier_bsk_per_gpu` / `ksk_per_gpu` / `cbs_fpksk_per_gpu`: per-device
+ *   pointers to the keys, which the caller must have replicated on every
+ *   device beforehand
+ * The remaining arguments match cuda_wop_pbs_64, except that no scratch
+ * buffer is taken: the driver allocates per-shard temporaries itself, and
+ * delta_log / cbs_delta_log are derived from the bit counts. The call is
+ * synchronous.
+ */
+void cuda_wop_pbs_multi_gpu_64(
+    void *const *v_streams, uint32_t const *gpu_indexes, uint32_t gpu_count,
+    void *lwe_array_out, void *lwe_array_in, void *lut_vector,
+    void *const *fourier_bsk_per_gpu, void *const *ksk_per_gpu,
+    void *const *cbs_fpksk_per_gpu, uint32_t glwe_dimension,
+    uint32_t lwe_dimension, uint32_t polynomial_size, uint32_t base_log_bsk,
+    uint32_t level_count_bsk, uint32_t base_log_ksk, uint32_t level_count_ksk,
+    uint32_t base_log_pksk, uint32_t level_count_pksk, uint32_t base_log_cbs,
+    uint32_t level_count_cbs, uint32_t *number_of_bits_to_extract_array,
+    uint32_t crt_decomposition_size, uint32_t max_shared_memory) {
+
+  gpu_count = std::min(gpu_count, crt_decomposition_size);
+
+  uint32_t total_bits = 0;
+  std::vector<uint32_t> delta_log_array(crt_decomposition_size);
+  for (uint32_t i = 0; i < crt_decomposition_size; i++) {
+    total_bits += number_of_bits_to_extract_array[i];
+    delta_log_array[i] = 64 - number_of_bits_to_extract_array[i];
+  }
+  uint64_t in_sample_size = (uint64_t)glwe_dimension * polynomial_size + 1;
+  uint64_t ggsw_size =
+      ggsw_sample_size(glwe_dimension, polynomial_size, level_count_cbs);
+
+  // Stage the inputs through the host so every device can upload its shard
+  uint64_t in_bytes =
+      crt_decomposition_size * in_sample_size * sizeof(uint64_t);
+  uint64_t *h_lwe_array_in = (uint64_t *)malloc(in_bytes);
+  cuda_memcpy_async_to_cpu(h_lwe_array_in, lwe_array_in, in_bytes,
+                           (cudaStream_t *)v_streams[0], gpu_indexes[0]);
+  cuda_synchronize_stream(v_streams[0]);
+
+  uint64_t *h_ggsw =
+      (uint64_t *)malloc(total_bits * ggsw_size * sizeof(uint64_t));
+
+  // Shard the CRT inputs contiguously, balancing the extracted bit counts;
+  // each shard keeps its own bits so the gathered GGSWs stay in input order
+  std::vector<std::thread> workers;
+  uint32_t input_pos = 0, bits_pos = 0;
+  for (uint32_t g = 0; g < gpu_count; g++) {
+    uint32_t shard_inputs =
+        (crt_decomposition_size + gpu_count - 1 - g) / gpu_count;
+    shard_inputs =
+        std::min(shard_inputs, crt_decomposition_size - input_pos);
+    if (shard_inputs == 0)
+      continue;
+    uint32_t shard_bits = 0;
+    for (uint32_t i = input_pos; i < input_pos + shard_inputs; i++)
+      shard_bits += number_of_bits_to_extract_array[i];
+    workers.emplace_back(
+        run_wop_pbs_shard, v_streams[g], gpu_indexes[g],
+        h_ggsw + (uint64_t)bits_pos * ggsw_size,
+        h_lwe_array_in + (uint64_t)input_pos * in_sample_size,
+        fourier_bsk_per_gpu[g], ksk_per_gpu[g], cbs_fpksk_per_gpu[g],
+        glwe_dimension, lwe_dimension, polynomial_size, base_log_bsk,
+        level_count_bsk, base_log_ksk, level_count_ksk, base_log_pksk,
+        level_count_pksk, base_log_cbs, level_count_cbs,
+        number_of_bits_to_extract_array + input_pos,
+        delta_log_array.data() + input_pos, shard_inputs, shard_bits,
+        max_shared_memory);
+    input_pos += shard_inputs;
+    bits_pos += shard_bits;
+  }
+  for (auto &worker : workers)
+    worker.join();
+  free(h_lwe_array_in);
+
+  // Gather the GGSWs on the first device and run the CMUX tree reduction
+  // and the final blind rotation + sample extraction there
+  void *v_stream = v_streams[0];
+  auto stream = static_cast<cudaStream_t *>(v_stream);
+  uint32_t gpu_index = gpu_indexes[0];
+  uint32_t tau = crt_decomposition_size;
+  void *d_ggsw = cuda_malloc_async(total_bits * ggsw_size * sizeof(uint64_t),
+                                   stream, gpu_index);
+  cuda_memcpy_async_to_gpu(d_ggsw, h_ggsw,
+                           total_bits * ggsw_size * sizeof(uint64_t), stream,
+                           gpu_index);
+
+  void *d_glwe_array_out_cmux_tree = cuda_malloc_async(
+      (uint64_t)tau * (glwe_dimension + 1) * polynomial_size * sizeof(uint64_t),
+      stream, gpu_index);
+  uint32_t lut_vector_size = 1 << total_bits;
+  int8_t *cmux_tree_buffer = nullptr;
+  scratch_cuda_cmux_tree_64(v_stream, gpu_index, &cmux_tree_buffer,
+                            glwe_dimension, polynomial_size, level_count_cbs,
+                            lut_vector_size, tau, max_shared_memory, true);
+  cuda_cmux_tree_64(v_stream, gpu_index, d_glwe_array_out_cmux_tree, d_ggsw,
+                    lut_vector, cmux_tree_buffer, glwe_dimension,
+                    polynomial_size, base_log_cbs, level_count_cbs,
+                    lut_vector_size, tau, max_shared_memory);
+  cleanup_cuda_cmux_tree(v_stream, gpu_index, &cmux_tree_buffer);
+
+  // The msb GGSWs went into the CMUX tree, the lsb ones drive the blind
+  // rotation, as in the single-device path
+  uint32_t log2_degree = 0;
+  for (uint32_t n = polynomial_size; n > 1; n >>= 1)
+    log2_degree++;
+  uint32_t mbr_size = std::min(log2_degree, total_bits);
+  uint32_t cmux_ggsw_len = total_bits - mbr_size;
+  uint64_t *br_ggsw = (uint64_t *)d_ggsw + (uint64_t)cmux_ggsw_len * ggsw_size;
+  int8_t *br_se_buffer = nullptr;
+  scratch_cuda_blind_rotation_sample_extraction_64(
+      v_stream, gpu_index, &br_se_buffer, glwe_dimension, polynomial_size,
+      level_count_cbs, mbr_size, tau, max_shared_memory, true);
+  cuda_blind_rotate_and_sample_extraction_64(
+      v_stream, gpu_index, lwe_array_out, br_ggsw, d_glwe_array_out_cmux_tree,
+      br_se_buffer, mbr_size, tau, glwe_dimension, polynomial_size,
+      base_log_cbs, level_count_cbs, max_shared_memory);
+  cleanup_cuda_blind_rotation_sample_extraction(v_stream, gpu_index,
+                                                &br_se_buffer);
+
+  cuda_drop_async(d_ggsw, stream, gpu_index);
+  cuda_drop_async(d_glwe_array_out_cmux_tree, stream, gpu_index);
+  cuda_synchronize_stream(v_stream);
+  free(h_ggsw);
+}
@@ -14,6 +14,42 @@ typedef struct {
   int input_lwe_ciphertext_count;
 } BootstrapBenchmarkParams;
 
+// Bytes a single PBS has to move through device memory: the fourier
+// bootstrapping key dominates, plus the input and output ciphertexts and
+// the lut.
+static uint64_t bytes_per_pbs(int lwe_dimension, int glwe_dimension,
+                              int polynomial_size, int pbs_level) {
+  uint64_t bsk_bytes = (uint64_t)lwe_dimension * pbs_level *
+                       (glwe_dimension + 1) * (glwe_dimension + 1) *
+                       polynomial_size * sizeof(double);
+  uint64_t in_ct_bytes = (lwe_dimension + 1) * sizeof(uint64_t);
+  uint64_t out_ct_bytes =
+      ((uint64_t)glwe_dimension * polynomial_size + 1) * sizeof(uint64_t);
+  uint64_t lut_bytes =
+      (uint64_t)(glwe_dimension + 1) * polynomial_size * sizeof(uint64_t);
+  return bsk_bytes + in_ct_bytes + out_ct_bytes + lut_bytes;
+}
+
+// Roofline-style metrics: achieved PBS/s and GB/s, and the fraction of the
+// device peak memory bandwidth the kernel reaches. Devices are assumed
+// homogeneous, the peak of device 0 is used as reference.
+static void set_roofline_counters(benchmark::State &st,
+                                  int input_lwe_ciphertext_count,
+                                  int lwe_dimension, int glwe_dimension,
+                                  int polynomial_size, int pbs_level) {
+  uint64_t total_bytes =
+      (uint64_t)input_lwe_ciphertext_count *
+      bytes_per_pbs(lwe_dimension, glwe_dimension, polynomial_size, pbs_level);
+  st.counters["PBS/s"] =
+      benchmark::Counter(input_lwe_ciphertext_count,
+                         benchmark::Counter::kIsIterationInvariantRate);
+  st.counters["GB/s"] = benchmark::Counter(
+      total_bytes * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+  st.counters["PeakBWFraction"] =
+      benchmark::Counter(total_bytes / device_peak_memory_bandwidth(0),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
 class Bootstrap_u64 : public benchmark::Fixture {
 protected:
   int lwe_dimension;
@@ -166,6 +202,74 @@ BENCHMARK_DEFINE_F(Bootstrap_u64, ConcreteCuda_LowLatencyPBS)
   st.counters["Throughput"] =
       benchmark::Counter(input_lwe_ciphertext_count / get_aws_cost_per_second(),
                          benchmark::Counter::kIsIterationInvariantRate);
+  set_roofline_counters(st, input_lwe_ciphertext_count, lwe_dimension,
+                        glwe_dimension, polynomial_size, pbs_level);
+}
+
+// Amortized PBS fixture: same key material and layout as the classical
+// fixture, but with the amortized kernel's scratch buffer. This is the
+// kernel the batched runtime wrappers feed, it was previously not
+// benchmarked at all.
+class AmortizedBootstrap_u64 : public Bootstrap_u64 {
+public:
+  void SetUp(const ::benchmark::State &state) override {
+    Bootstrap_u64::SetUp(state);
+    for (int gpu_index = 0; gpu_index < num_gpus; gpu_index++) {
+      cudaSetDevice(gpu_index);
+      // Swap the low latency scratch allocated by the base fixture for the
+      // amortized one.
+      cleanup_cuda_bootstrap_low_latency(streams[gpu_index], gpu_index,
+                                         &pbs_buffer[gpu_index]);
+      scratch_cuda_bootstrap_amortized_64(
+          streams[gpu_index], gpu_index, &pbs_buffer[gpu_index],
+          glwe_dimension, polynomial_size,
+          input_lwe_ciphertext_count_per_gpu[gpu_index],
+          cuda_get_max_shared_memory(gpu_index), true);
+    }
+  }
+
+  void TearDown(const ::benchmark::State &state) override {
+    for (int gpu_index = 0; gpu_index < num_gpus; gpu_index++) {
+      cudaSetDevice(gpu_index);
+      cleanup_cuda_bootstrap_amortized(streams[gpu_index], gpu_index,
+                                       &pbs_buffer[gpu_index]);
+      // Give the base fixture a low latency scratch back to clean up.
+      scratch_cuda_bootstrap_low_latency_64(
+          streams[gpu_index], gpu_index, &pbs_buffer[gpu_index],
+          glwe_dimension, polynomial_size, pbs_level,
+          input_lwe_ciphertext_count_per_gpu[gpu_index],
+          cuda_get_max_shared_memory(gpu_index), true);
+    }
+    Bootstrap_u64::TearDown(state);
+  }
+};
+
+BENCHMARK_DEFINE_F(AmortizedBootstrap_u64, ConcreteCuda_AmortizedPBS)
+(benchmark::State &st) {
+
+  for (auto _ : st) {
+#pragma omp parallel for
+    for (int gpu_index = 0; gpu_index < num_gpus; gpu_index++) {
+      cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+          streams[gpu_index], gpu_index, (void *)d_lwe_ct_out_array[gpu_index],
+          (void *)d_lut_pbs_identity[gpu_index],
+          (void *)d_lut_pbs_indexes[gpu_index],
+          (void *)d_lwe_ct_in_array[gpu_index],
+          (void *)d_fourier_bsk_array[gpu_index], pbs_buffer[gpu_index],
+          lwe_dimension, glwe_dimension, polynomial_size, pbs_base_log,
+          pbs_level, input_lwe_ciphertext_count_per_gpu[gpu_index], 1, 0,
+          cuda_get_max_shared_memory(gpu_index));
+    }
+    for (int gpu_index = 0; gpu_index < num_gpus; gpu_index++) {
+      cudaSetDevice(gpu_index);
+      cuda_synchronize_stream(streams[gpu_index]);
+    }
+  }
+  st.counters["Throughput"] =
+      benchmark::Counter(input_lwe_ciphertext_count / get_aws_cost_per_second(),
+                         benchmark::Counter::kIsIterationInvariantRate);
+  set_roofline_counters(st, input_lwe_ciphertext_count, lwe_dimension,
+                        glwe_dimension, polynomial_size, pbs_level);
 }
 
 static void
@@ -222,5 +326,35 @@ BootstrapBenchmarkGenerateParams(benchmark::internal::Benchmark *b) {
   }
 }
 
+static void
+BootstrapBatchSweepGenerateParams(benchmark::internal::Benchmark *b) {
+  // Batch-size sweep over the most used production parameter sets, to see
+  // at which batch size each kernel saturates and how far from the
+  // bandwidth roofline it stays.
+  std::vector<BootstrapBenchmarkParams> params = {
+      // SHORTINT_PARAM_MESSAGE_2_CARRY_0
+      (BootstrapBenchmarkParams){656, 2, 512, 8, 2, 0},
+      // SHORTINT_PARAM_MESSAGE_2_CARRY_1
+      (BootstrapBenchmarkParams){742, 2, 1024, 23, 1, 0},
+      // SHORTINT_PARAM_MESSAGE_2_CARRY_2
+      (BootstrapBenchmarkParams){745, 1, 2048, 23, 1, 0},
+      // SHORTINT_PARAM_MESSAGE_6_CARRY_0
+      (BootstrapBenchmarkParams){915, 1, 8192, 22, 1, 0},
+  };
+  for (auto x : params) {
+    for (int batch : {1, 16, 128, 1024, 4096}) {
+      // The largest polynomial sizes do not fit thousands of samples
+      if (x.polynomial_size >= 8192 && batch > 128)
+        continue;
+      b->Args({x.lwe_dimension, x.glwe_dimension, x.polynomial_size,
+               x.pbs_base_log, x.pbs_level, batch});
+    }
+  }
+}
+
 BENCHMARK_REGISTER_F(Bootstrap_u64, ConcreteCuda_LowLatencyPBS)
-    ->Apply(BootstrapBenchmarkGenerateParams);
+    ->Apply(BootstrapBenchmarkGenerateParams)
+    ->Apply(BootstrapBatchSweepGenerateParams);
+
+BENCHMARK_REGISTER_F(AmortizedBootstrap_u64, ConcreteCuda_AmortizedPBS)
+    ->Apply(BootstrapBatchSweepGenerateParams);
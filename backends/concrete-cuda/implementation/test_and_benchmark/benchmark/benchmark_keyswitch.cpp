@@ -110,8 +110,15 @@ static void
 KeyswitchBenchmarkGenerateParams(benchmark::internal::Benchmark *b) {
   // Define the parameters to benchmark
   // na, nb, base_log, level, number_of_inputs
+  // The parameter sets cover small and large outputs, deep and shallow
+  // decompositions, and both even and odd output sizes, so the
+  // register-tiled kernel is exercised with and without aligned
+  // vectorized KSK loads
   std::vector<KeyswitchBenchmarkParams> params = {
       (KeyswitchBenchmarkParams){600, 1024, 3, 8, 1000},
+      (KeyswitchBenchmarkParams){742, 2048, 23, 1, 1000},
+      (KeyswitchBenchmarkParams){882, 1024, 8, 2, 1000},
+      (KeyswitchBenchmarkParams){600, 749, 3, 8, 1000},
   };
 
   // Add to the list of parameters to benchmark
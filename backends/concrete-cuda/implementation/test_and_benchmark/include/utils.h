@@ -11,6 +11,11 @@
 
 double get_aws_cost_per_second();
 
+// Peak theoretical memory bandwidth of the device, in bytes per second,
+// computed from the memory clock and bus width. Used as the roofline
+// reference for the benchmark utilization counters.
+double device_peak_memory_bandwidth(int gpu_index);
+
 uint64_t *generate_plaintexts(uint64_t payload_modulus, uint64_t delta,
                               int number_of_inputs, const unsigned repetitions,
                               const unsigned samples);
@@ -10,6 +10,13 @@
 
 double get_aws_cost_per_second() { return AWS_VM_COST_PER_HOUR / 3600; }
 
+double device_peak_memory_bandwidth(int gpu_index) {
+  cudaDeviceProp prop;
+  cudaGetDeviceProperties(&prop, gpu_index);
+  // memoryClockRate is in kHz, memoryBusWidth in bits, factor 2 for DDR
+  return 2.0 * prop.memoryClockRate * 1e3 * (prop.memoryBusWidth / 8.0);
+}
+
 // For each sample and repetition, create a plaintext
 // The payload_modulus is the message modulus times the carry modulus
 // (so the total message modulus)
@@ -39,6 +39,39 @@ uint64_t encode(int64_t plaintext, uint64_t modulus, uint64_t product);
 /// Decode follow the crt encoding
 uint64_t decode(uint64_t val, uint64_t modulus);
 
+/// Precomputed constants to encode and decode whole tensors of values for a
+/// fixed crt decomposition. The product of moduli, the Barrett reciprocals
+/// and the icrt coefficients are hoisted out of the per-value loops, and the
+/// 128 bits divisions of `encode` are replaced by multiply and shift
+/// sequences, which keeps the loops over tensor elements vectorizable.
+class Decomposer {
+public:
+  Decomposer() = default;
+  Decomposer(std::vector<int64_t> moduli);
+
+  /// Same as crt::encode for the `blockIndex`-th modulus.
+  uint64_t encode(int64_t plaintext, size_t blockIndex) const;
+
+  /// Same as crt::decode for the `blockIndex`-th modulus.
+  uint64_t decode(uint64_t val, size_t blockIndex) const;
+
+  /// Same as crt::iCrt with the coefficients precomputed.
+  uint64_t iCrt(const std::vector<int64_t> &remainders) const;
+
+  size_t numBlocks() const { return moduli.size(); }
+
+private:
+  std::vector<int64_t> moduli;
+  uint64_t product = 1;
+  /// floor((2^64 - 1) / modulus) per modulus, used as Barrett reciprocal and
+  /// as encoding step
+  std::vector<uint64_t> reciprocals;
+  /// 2^64 - reciprocal * modulus per modulus, completes the exact encoding
+  std::vector<uint64_t> reciprocalRests;
+  /// (product / modulus) * modInverse(product / modulus, modulus) per modulus
+  std::vector<uint64_t> icrtCoefficients;
+};
+
 } // namespace crt
 } // namespace clientlib
 } // namespace concretelang
@@ -6,13 +6,20 @@
 #ifndef CONCRETELANG_CLIENTLIB_CLIENT_LAMBDA_H
 #define CONCRETELANG_CLIENTLIB_CLIENT_LAMBDA_H
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #include "concretelang/ClientLib/ClientParameters.h"
 #include "concretelang/ClientLib/EncryptedArguments.h"
 #include "concretelang/ClientLib/KeySet.h"
 #include "concretelang/ClientLib/KeySetCache.h"
 #include "concretelang/ClientLib/PublicArguments.h"
+#include "concretelang/ClientLib/Serializers.h"
 #include "concretelang/ClientLib/Types.h"
 #include "concretelang/Common/Error.h"
 
@@ -87,6 +94,82 @@ public:
     return publicArguments->serialize(ostream);
   }
 
+  /// Emit a call on this lambda to a binary ostream, overlapping the
+  /// encryption of each argument with the serialization and network
+  /// write of the previous one. The wire format is identical to
+  /// serializeCall; the difference is that finished arguments go out
+  /// while the remaining ones still encrypt, hiding the encryption of
+  /// large inputs behind the upload.
+  outcome::checked<void, StringError>
+  serializeCallPipelined(Args... args, KeySet &keySet,
+                         std::ostream &ostream) {
+    if (incorrectMode(ostream)) {
+      return StringError(
+          "serializeCallPipelined: ostream should be in binary mode");
+    }
+    if (sizeof...(Args) != clientParameters.inputs.size()) {
+      return StringError("serializeCallPipelined: expected ")
+             << clientParameters.inputs.size() << " arguments, got "
+             << sizeof...(Args);
+    }
+    auto encryptedArgs = EncryptedArguments::empty(/*simulation=*/false);
+
+    // The writer drains encrypted arguments in push order while the
+    // caller thread keeps encrypting the next one.
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<ScalarOrTensorData> pending;
+    bool done = false;
+    std::atomic<bool> writeFailed{false};
+
+    writeSize(ostream, (uint64_t)sizeof...(Args));
+    std::thread writer([&]() {
+      while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return done || !pending.empty(); });
+        if (pending.empty())
+          return;
+        ScalarOrTensorData value = std::move(pending.front());
+        pending.pop_front();
+        lock.unlock();
+        serializeScalarOrTensorData(value, ostream);
+        if (!ostream.good())
+          writeFailed = true;
+      }
+    });
+
+    std::optional<StringError> encryptError;
+    auto pushOne = [&](auto &arg) {
+      if (encryptError.has_value() || writeFailed)
+        return;
+      auto res = encryptedArgs->pushArg(arg, keySet);
+      if (res.has_error()) {
+        encryptError = res.error();
+        return;
+      }
+      {
+        const std::lock_guard<std::mutex> guard(mutex);
+        pending.push_back(encryptedArgs->popValue());
+      }
+      condition.notify_one();
+    };
+    (pushOne(args), ...);
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      done = true;
+    }
+    condition.notify_one();
+    writer.join();
+
+    if (encryptError.has_value()) {
+      return *encryptError;
+    }
+    if (writeFailed || !ostream.good()) {
+      return StringError("serializeCallPipelined: cannot write arguments");
+    }
+    return outcome::success();
+  }
+
   outcome::checked<std::unique_ptr<PublicArguments>, StringError>
   publicArguments(Args... args, KeySet &keySet) {
     OUTCOME_TRY(
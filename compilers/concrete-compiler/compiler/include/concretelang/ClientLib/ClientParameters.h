@@ -6,6 +6,7 @@
 #ifndef CONCRETELANG_CLIENTLIB_CLIENTPARAMETERS_H_
 #define CONCRETELANG_CLIENTLIB_CLIENTPARAMETERS_H_
 
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <string>
@@ -39,6 +40,12 @@ const uint64_t SMALL_KEY = 1;
 const uint64_t BIG_KEY = 0;
 
 const std::string CLIENT_PARAMETERS_EXT = ".concrete.params.json";
+/// Compact binary sidecar written at compile time next to the JSON
+/// parameters and preferred at load: decoding it is a straight read of
+/// fixed-width fields, where parsing the JSON of a large circuit costs
+/// tens of milliseconds and megabytes of allocations. The JSON stays
+/// the inspectable reference form.
+const std::string CLIENT_PARAMETERS_BIN_EXT = ".concrete.params.bin";
 
 typedef uint64_t DecompositionLevelCount;
 typedef uint64_t DecompositionBaseLog;
@@ -217,13 +224,37 @@ struct ClientParameters {
   std::vector<CircuitGate> outputs;
   std::string functionName;
 
+  /// When set, the used* vectors below list the IDs of the keys the circuit
+  /// functionName actually uses; keygen, key storage and evaluation key
+  /// upload may skip the others. Key IDs stay positional, the unused slots
+  /// hold empty placeholder keys. When unset, e.g. for parameters produced
+  /// by an older compiler, every key is conservatively considered used.
+  bool hasKeyLiveness = false;
+  std::vector<uint64_t> usedSecretKeys;
+  std::vector<uint64_t> usedBootstrapKeys;
+  std::vector<uint64_t> usedKeyswitchKeys;
+  std::vector<uint64_t> usedPackingKeyswitchKeys;
+
   size_t hash();
 
+  /// Loads the parameters stored at `path` (the JSON path), preferring
+  /// the binary sidecar next to it when one exists and decodes.
   static outcome::checked<std::vector<ClientParameters>, StringError>
   load(std::string path);
 
+  /// Writes the binary sidecar form of `params` at `path`.
+  static outcome::checked<void, StringError>
+  saveBinary(const std::vector<ClientParameters> &params, std::string path);
+
+  /// Loads parameters from their binary sidecar form.
+  static outcome::checked<std::vector<ClientParameters>, StringError>
+  loadBinary(std::string path);
+
   static std::string getClientParametersPath(std::string path);
 
+  /// Path of the binary sidecar for the JSON parameters at `jsonPath`.
+  static std::string getClientParametersBinaryPath(std::string jsonPath);
+
   outcome::checked<CircuitGate, StringError> input(size_t pos) {
     if (pos >= inputs.size()) {
       return StringError("input gate ") << pos << " didn't exists";
@@ -248,6 +279,27 @@ struct ClientParameters {
     return secretKey;
   }
 
+  bool isKeyUsed(const std::vector<uint64_t> &usedKeys, uint64_t id) {
+    return !hasKeyLiveness ||
+           std::find(usedKeys.begin(), usedKeys.end(), id) != usedKeys.end();
+  }
+
+  bool isSecretKeyUsed(LweSecretKeyID id) {
+    return isKeyUsed(usedSecretKeys, id);
+  }
+
+  bool isBootstrapKeyUsed(BootstrapKeyID id) {
+    return isKeyUsed(usedBootstrapKeys, id);
+  }
+
+  bool isKeyswitchKeyUsed(KeyswitchKeyID id) {
+    return isKeyUsed(usedKeyswitchKeys, id);
+  }
+
+  bool isPackingKeyswitchKeyUsed(PackingKeyswitchKeyID id) {
+    return isKeyUsed(usedPackingKeyswitchKeys, id);
+  }
+
   /// bufferSize returns the size of the whole buffer of a gate.
   int64_t bufferSize(CircuitGate gate) {
     if (!gate.encryption.has_value()) {
@@ -66,6 +66,21 @@ public:
   outcome::checked<std::unique_ptr<PublicArguments>, StringError>
   exportPublicArguments(ClientParameters clientParameters);
 
+  /// Moves the oldest not-yet-taken argument out of the holder, for
+  /// callers that stream arguments out as they are encrypted (see
+  /// TypedClientLambda::serializeCallPipelined). Positions keep
+  /// advancing, so later pushes still encrypt for the right gate.
+  ScalarOrTensorData popValue() {
+    ScalarOrTensorData value = std::move(values.front());
+    values.erase(values.begin());
+    poppedValues++;
+    return value;
+  }
+
+  /// Number of arguments pushed so far, including popped ones; the
+  /// position the next argument encrypts for.
+  size_t numPushedValues() const { return values.size() + poppedValues; }
+
   /// Check that all arguments as been pushed.
   // TODO: Remove public method here
   outcome::checked<void, StringError> checkAllArgs(KeySet &keySet);
@@ -75,7 +90,7 @@ public:
   /// Add a uint64_t scalar argument.
   outcome::checked<void, StringError> pushArg(uint64_t arg, KeySet &keySet) {
     auto exporter = getExporter(keySet);
-    OUTCOME_TRY(auto value, exporter->exportValue(arg, values.size()));
+    OUTCOME_TRY(auto value, exporter->exportValue(arg, numPushedValues()));
     values.push_back(std::move(value));
     return outcome::success();
   }
@@ -139,7 +154,8 @@ public:
   outcome::checked<void, StringError>
   pushArg(const T *data, llvm::ArrayRef<int64_t> shape, KeySet &keySet) {
     auto exporter = getExporter(keySet);
-    OUTCOME_TRY(auto value, exporter->exportValue(data, shape, values.size()));
+    OUTCOME_TRY(auto value,
+                exporter->exportValue(data, shape, numPushedValues()));
     values.push_back(std::move(value));
     return outcome::success();
   }
@@ -167,18 +183,49 @@ public:
     return checkAllArgs(keySet);
   }
 
+  /// Add a uint64_t scalar argument encrypted trivially (zero mask, no
+  /// noise), skipping the CSPRNG entirely. Only meant for public inputs: a
+  /// trivial ciphertext hides nothing, but is much cheaper to build when
+  /// thousands of public constants flow into a circuit.
+  outcome::checked<void, StringError> pushTrivialArg(uint64_t arg,
+                                                     KeySet &keySet) {
+    auto exporter = getExporter(keySet, /*trivialEncryption=*/true);
+    OUTCOME_TRY(auto value, exporter->exportValue(arg, numPushedValues()));
+    values.push_back(std::move(value));
+    return outcome::success();
+  }
+
+  /// Add a tensor argument encrypted trivially, the bulk counterpart of the
+  /// scalar pushTrivialArg.
+  template <typename T>
+  outcome::checked<void, StringError>
+  pushTrivialArg(const T *data, llvm::ArrayRef<int64_t> shape,
+                 KeySet &keySet) {
+    auto exporter = getExporter(keySet, /*trivialEncryption=*/true);
+    OUTCOME_TRY(auto value,
+                exporter->exportValue(data, shape, numPushedValues()));
+    values.push_back(std::move(value));
+    return outcome::success();
+  }
+
 private:
-  std::unique_ptr<ValueExporterInterface> getExporter(KeySet &keySet) {
+  std::unique_ptr<ValueExporterInterface>
+  getExporter(KeySet &keySet, bool trivialEncryption = false) {
     if (isSimulated()) {
+      // Simulated "encryption" only adds noise to the plaintext, there is no
+      // mask sampling to skip.
       return std::make_unique<SimulatedValueExporter>(
           keySet.clientParameters());
     } else {
-      return std::make_unique<ValueExporter>(keySet, keySet.clientParameters());
+      return std::make_unique<ValueExporter>(keySet, keySet.clientParameters(),
+                                             trivialEncryption);
     }
   }
 
   /// Store buffers of ciphertexts
   std::vector<ScalarOrTensorData> values;
+  /// Arguments already streamed out through popValue
+  size_t poppedValues = 0;
   /// Whether it a simulates an encrypted argument or not
   bool simulation;
 };
@@ -42,6 +42,45 @@ public:
   ConcreteCSPRNG(ConcreteCSPRNG &) = delete;
   ConcreteCSPRNG(ConcreteCSPRNG &&other);
   ~ConcreteCSPRNG();
+
+  /// Forks `nChildren` child streams off `parent`. The generator is
+  /// counter-mode, so each child owns a disjoint range of `bytesPerChild`
+  /// bytes of the parent stream: the children can be consumed concurrently
+  /// while all the randomness remains a deterministic function of the seed
+  /// `parent` was created from. Returns an empty vector when `parent` does
+  /// not wrap a concrete-cpu generator or has too few bytes left to fork.
+  static std::vector<ConcreteCSPRNG> fork(CSPRNG &parent, size_t nChildren,
+                                          size_t bytesPerChild);
+
+private:
+  ConcreteCSPRNG(Csprng *ptr);
+};
+
+/// @brief MappedKeyBuffer holds a read-only, file-backed (mmap) buffer of
+/// 64-bit words. Keys built on top of it use the mapped pages directly,
+/// without copying the key material into freshly allocated vectors. The
+/// mapping is released when the last key referencing it is destroyed.
+class MappedKeyBuffer {
+  void *_mapping;
+  size_t _mappingSize;
+  const uint64_t *_data;
+  size_t _size;
+
+public:
+  MappedKeyBuffer() = delete;
+  MappedKeyBuffer(MappedKeyBuffer &) = delete;
+  /// @brief Wraps a mapping of `mappingSize` bytes whose key words start at
+  /// `dataOffset` bytes and span `size` 64-bit words.
+  MappedKeyBuffer(void *mapping, size_t mappingSize, size_t dataOffset,
+                  size_t size)
+      : _mapping(mapping), _mappingSize(mappingSize),
+        _data(reinterpret_cast<const uint64_t *>(
+            reinterpret_cast<const char *>(mapping) + dataOffset)),
+        _size(size) {}
+  ~MappedKeyBuffer();
+
+  const uint64_t *data() const { return _data; }
+  size_t size() const { return _size; }
 };
 
 /// @brief LweSecretKey implements tools for manipulating lwe secret key on
@@ -61,6 +100,13 @@ public:
   void encrypt(uint64_t *ciphertext, uint64_t plaintext, double variance,
                CSPRNG &csprng) const;
 
+  /// @brief Encrypt `count` plaintexts into the contiguous ciphertext
+  /// batch, in one call into the backend whose inner loops vectorize
+  /// across the batch instead of paying one FFI round-trip per
+  /// ciphertext.
+  void encryptBatch(uint64_t *ciphertexts, const uint64_t *plaintexts,
+                    size_t count, double variance, CSPRNG &csprng) const;
+
   /// @brief Decrypt the ciphertext to the plaintext
   void decrypt(const uint64_t *ciphertext, uint64_t &plaintext) const;
 
@@ -80,6 +126,9 @@ public:
 class LweKeyswitchKey {
 private:
   std::shared_ptr<std::vector<uint64_t>> _buffer;
+  std::shared_ptr<MappedKeyBuffer> _mappedBuffer;
+  std::shared_ptr<std::vector<uint64_t>> _seededBuffer;
+  __uint128_t _maskSeed = 0;
   KeyswitchKeyParam _parameters;
 
 public:
@@ -89,10 +138,31 @@ public:
   LweKeyswitchKey(std::shared_ptr<std::vector<uint64_t>> buffer,
                   KeyswitchKeyParam parameters)
       : _buffer(buffer), _parameters(parameters){};
+  LweKeyswitchKey(std::shared_ptr<MappedKeyBuffer> buffer,
+                  KeyswitchKeyParam parameters)
+      : _mappedBuffer(buffer), _parameters(parameters){};
+  /// @brief Rebuilds the full key from its seeded form: the ciphertext
+  /// bodies in `seededBuffer` plus the public `maskSeed` the masks are
+  /// replayed from. `outputDimension` is the output lwe dimension, which
+  /// the parameters do not carry.
+  LweKeyswitchKey(std::shared_ptr<std::vector<uint64_t>> seededBuffer,
+                  __uint128_t maskSeed, size_t outputDimension,
+                  KeyswitchKeyParam parameters);
 
   /// @brief Returns the buffer that hold the keyswitch key.
-  const uint64_t *buffer() const { return _buffer->data(); }
-  size_t size() const { return _buffer->size(); }
+  const uint64_t *buffer() const {
+    return _mappedBuffer ? _mappedBuffer->data() : _buffer->data();
+  }
+  size_t size() const {
+    return _mappedBuffer ? _mappedBuffer->size() : _buffer->size();
+  }
+
+  /// @brief Returns whether the seeded (bodies-only) form of the key is
+  /// available for serialization.
+  bool isSeeded() const { return _seededBuffer != nullptr; }
+  const uint64_t *seededBuffer() const { return _seededBuffer->data(); }
+  size_t seededSize() const { return _seededBuffer->size(); }
+  __uint128_t maskSeed() const { return _maskSeed; }
 
   /// @brief Returns the parameters of the keyswicth key.
   KeyswitchKeyParam parameters() const { return this->_parameters; }
@@ -103,6 +173,10 @@ public:
 class LweBootstrapKey {
 private:
   std::shared_ptr<std::vector<uint64_t>> _buffer;
+  std::shared_ptr<MappedKeyBuffer> _mappedBuffer;
+  std::shared_ptr<MappedKeyBuffer> _fourierBuffer;
+  std::shared_ptr<std::vector<uint64_t>> _seededBuffer;
+  __uint128_t _maskSeed = 0;
   BootstrapKeyParam _parameters;
 
 public:
@@ -110,15 +184,53 @@ public:
   LweBootstrapKey(std::shared_ptr<std::vector<uint64_t>> buffer,
                   BootstrapKeyParam &parameters)
       : _buffer(buffer), _parameters(parameters){};
+  LweBootstrapKey(std::shared_ptr<MappedKeyBuffer> buffer,
+                  BootstrapKeyParam &parameters)
+      : _mappedBuffer(buffer), _parameters(parameters){};
+  /// @brief Rebuilds the full key from its seeded form: the ciphertext
+  /// bodies in `seededBuffer` plus the public `maskSeed` the masks are
+  /// replayed from.
+  LweBootstrapKey(std::shared_ptr<std::vector<uint64_t>> seededBuffer,
+                  __uint128_t maskSeed, BootstrapKeyParam &parameters);
   LweBootstrapKey(BootstrapKeyParam &parameters, LweSecretKey &inputKey,
                   LweSecretKey &outputKey, CSPRNG &csprng);
 
   ///// @brief Returns the buffer that hold the bootstrap key.
-  const uint64_t *buffer() const { return _buffer->data(); }
-  size_t size() const { return _buffer->size(); }
+  const uint64_t *buffer() const {
+    return _mappedBuffer ? _mappedBuffer->data() : _buffer->data();
+  }
+  size_t size() const {
+    return _mappedBuffer ? _mappedBuffer->size() : _buffer->size();
+  }
 
   /// @brief Returns the parameters of the bootsrap key.
   BootstrapKeyParam parameters() const { return this->_parameters; }
+
+  /// @brief Attaches the Fourier-domain representation of the key, e.g.
+  /// mapped from the key set cache. The representation is a deterministic
+  /// function of the key, so carrying it along lets the runtime skip the
+  /// conversion on first use.
+  void setFourierBuffer(std::shared_ptr<MappedKeyBuffer> buffer) {
+    _fourierBuffer = buffer;
+  }
+
+  /// @brief Returns the Fourier-domain buffer of the bootstrap key, or
+  /// nullptr when only the standard-domain representation is available.
+  const double *fourierBuffer() const {
+    return _fourierBuffer
+               ? reinterpret_cast<const double *>(_fourierBuffer->data())
+               : nullptr;
+  }
+  size_t fourierSize() const {
+    return _fourierBuffer ? _fourierBuffer->size() : 0;
+  }
+
+  /// @brief Returns whether the seeded (bodies-only) form of the key is
+  /// available for serialization.
+  bool isSeeded() const { return _seededBuffer != nullptr; }
+  const uint64_t *seededBuffer() const { return _seededBuffer->data(); }
+  size_t seededSize() const { return _seededBuffer->size(); }
+  __uint128_t maskSeed() const { return _maskSeed; }
 };
 
 /// @brief PackingKeyswitchKey implements tools for manipulating privat packing
@@ -126,6 +238,7 @@ public:
 class PackingKeyswitchKey {
 private:
   std::shared_ptr<std::vector<uint64_t>> _buffer;
+  std::shared_ptr<MappedKeyBuffer> _mappedBuffer;
   PackingKeyswitchKeyParam _parameters;
 
 public:
@@ -136,10 +249,17 @@ public:
   PackingKeyswitchKey(std::shared_ptr<std::vector<uint64_t>> buffer,
                       PackingKeyswitchKeyParam parameters)
       : _buffer(buffer), _parameters(parameters){};
+  PackingKeyswitchKey(std::shared_ptr<MappedKeyBuffer> buffer,
+                      PackingKeyswitchKeyParam parameters)
+      : _mappedBuffer(buffer), _parameters(parameters){};
 
   /// @brief Returns the buffer that hold the keyswitch key.
-  const uint64_t *buffer() const { return _buffer->data(); }
-  size_t size() const { return _buffer->size(); }
+  const uint64_t *buffer() const {
+    return _mappedBuffer ? _mappedBuffer->data() : _buffer->data();
+  }
+  size_t size() const {
+    return _mappedBuffer ? _mappedBuffer->size() : _buffer->size();
+  }
 
   /// @brief Returns the parameters of the keyswicth key.
   PackingKeyswitchKeyParam parameters() const { return this->_parameters; }
@@ -148,6 +268,12 @@ public:
 // =============================================
 
 /// Evalution keys required for execution.
+///
+/// Bootstrap and keyswitch keys are generated in seeded form: the masks are
+/// derived from a public 128-bit seed, so serialization ships only the
+/// ciphertext bodies plus the seed and the reader replays the masks,
+/// cutting key transfer size roughly in half. Packing keyswitch keys are
+/// still shipped expanded.
 class EvaluationKeys {
 private:
   std::vector<LweKeyswitchKey> keyswitchKeys;
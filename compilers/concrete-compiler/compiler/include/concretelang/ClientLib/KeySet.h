@@ -10,6 +10,7 @@
 
 #include "boost/outcome.h"
 
+#include "concretelang/ClientLib/CRT.h"
 #include "concretelang/ClientLib/ClientParameters.h"
 #include "concretelang/ClientLib/EvaluationKeys.h"
 #include "concretelang/ClientLib/KeySetCache.h"
@@ -53,6 +54,36 @@ public:
   outcome::checked<void, StringError>
   encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input);
 
+  /// encrypt the input to the ciphertext for the argument at argPos, drawing
+  /// randomness from the given csprng instead of the KeySet one. This allows
+  /// concurrent encryptions, the KeySet csprng being not thread safe.
+  outcome::checked<void, StringError> encrypt_lwe(size_t argPos,
+                                                  uint64_t *ciphertext,
+                                                  uint64_t input,
+                                                  CSPRNG &csprng);
+
+  /// encrypt `count` values into the contiguous ciphertext batch for the
+  /// argument at argPos, handing the whole batch to the backend at once:
+  /// the per-value FFI overhead disappears and the mask-secret dot
+  /// products vectorize across ciphertexts. CRT-encoded gates fall back
+  /// to per-value encryption.
+  outcome::checked<void, StringError>
+  encrypt_lwe_batch(size_t argPos, uint64_t *ciphertexts,
+                    const uint64_t *values, size_t count);
+
+  /// Same, drawing randomness from the given csprng instead of the
+  /// KeySet one, for concurrent encryptions.
+  outcome::checked<void, StringError>
+  encrypt_lwe_batch(size_t argPos, uint64_t *ciphertexts,
+                    const uint64_t *values, size_t count, CSPRNG &csprng);
+
+  /// encrypt the input trivially (zero mask, no noise) to the ciphertext for
+  /// the argument at argPos. No randomness is drawn, which makes it much
+  /// cheaper than encrypt_lwe, but a trivial ciphertext hides nothing: only
+  /// use it for public inputs.
+  outcome::checked<void, StringError>
+  trivial_encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input);
+
   /// isOuputEncrypted return true if the output at the given pos is encrypted.
   bool isOutputEncrypted(size_t pos);
 
@@ -119,6 +150,12 @@ private:
   SecretKeyGateMapping inputs;
   SecretKeyGateMapping outputs;
 
+  /// Per-gate crt constants, precomputed once so that encrypting or
+  /// decrypting a whole tensor reuses them for every value. Gates without a
+  /// crt encoding hold a default constructed decomposer.
+  std::vector<crt::Decomposer> inputCrtDecomposers;
+  std::vector<crt::Decomposer> outputCrtDecomposers;
+
   clientlib::ClientParameters _clientParameters;
 };
 
@@ -27,6 +27,19 @@ public:
   outcome::checked<std::unique_ptr<KeySet>, StringError>
   generate(ClientParameters &params, uint64_t seed_msb, uint64_t seed_lsb);
 
+  /// Same as `generate` but hands out a KeySet shared through a process-wide,
+  /// thread-safe LRU keyed like the on-disk cache directories. Concurrent
+  /// callers asking for the same (params, seed) share one live copy instead
+  /// of each deserializing the keys from disk again.
+  static outcome::checked<std::shared_ptr<KeySet>, StringError>
+  generateShared(std::shared_ptr<KeySetCache> optionalCache,
+                 ClientParameters &params, uint64_t seed_msb,
+                 uint64_t seed_lsb);
+
+  outcome::checked<std::shared_ptr<KeySet>, StringError>
+  generateShared(ClientParameters &params, uint64_t seed_msb,
+                 uint64_t seed_lsb);
+
 private:
   static outcome::checked<std::unique_ptr<KeySet>, StringError>
   loadKeys(ClientParameters &params, uint64_t seed_msb, uint64_t seed_lsb,
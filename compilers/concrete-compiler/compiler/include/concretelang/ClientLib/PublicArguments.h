@@ -45,6 +45,15 @@ public:
   static outcome::checked<std::unique_ptr<PublicArguments>, StringError>
   unserialize(const ClientParameters &expectedParams, std::istream &istream);
 
+  /// Creates PublicArguments over caller-owned contiguous buffers, one per
+  /// input gate, e.g. pre-read RPC buffers. Ciphertext and clear tensor
+  /// payloads are wrapped as borrowed views and not copied, the caller must
+  /// keep the buffers alive and unchanged as long as the arguments are in
+  /// use. Clear scalar gates are read by value from their buffer.
+  static outcome::checked<std::unique_ptr<PublicArguments>, StringError>
+  fromBorrowedBuffers(const ClientParameters &expectedParams,
+                      llvm::ArrayRef<void *> buffers);
+
   outcome::checked<void, StringError> serialize(std::ostream &ostream);
 
   std::vector<SharedScalarOrTensorData> &getArguments() { return arguments; }
@@ -99,8 +108,16 @@ struct PublicResult {
     OUTCOME_TRYV(publicResult->unserialize(istream));
     return std::move(publicResult);
   }
-  /// Serialize into an output stream.
-  outcome::checked<void, StringError> serialize(std::ostream &ostream);
+  /// Serialize into an output stream. When `compressCiphertexts` is set,
+  /// encrypted results are modulus switched to 32 bits words before being
+  /// written, halving the payload of the server to client hop. This is
+  /// lossy in the low bits of each coefficient and is only valid when the
+  /// receiver decrypts the results directly, i.e. when message, padding
+  /// and noise all fit the 32 most significant bits. `unserialize`
+  /// transparently expands compressed results back to 64 bits words, so
+  /// decryption on the client side is unchanged.
+  outcome::checked<void, StringError>
+  serialize(std::ostream &ostream, bool compressCiphertexts = false);
 
   /// Get the result at `pos` as a scalar. Decryption happens if the
   /// result is encrypted.
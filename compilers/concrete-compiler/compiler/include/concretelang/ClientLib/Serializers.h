@@ -31,6 +31,18 @@ std::ostream &writeSize(std::ostream &ostream, Size size) {
   return writeWord(ostream, size);
 }
 
+// bulk variant: streams a whole contiguous buffer in one shot, avoiding the
+// per-word iostream overhead on large payloads (keys, ciphertext tensors)
+template <typename Word>
+std::ostream &writeWords(std::ostream &ostream, const Word *words,
+                         size_t numWords) {
+  assert(std::numeric_limits<size_t>::max() / sizeof(*words) > numWords);
+  ostream.write(reinterpret_cast<const char *>(words),
+                sizeof(*words) * numWords);
+  assert(ostream.good());
+  return ostream;
+}
+
 // for sake of symetry
 template <typename Word>
 std::istream &readWord(std::istream &istream, Word &word) {
@@ -68,21 +80,32 @@ unserializeScalarData(std::istream &istream);
 std::ostream &serializeTensorData(const TensorData &values_and_sizes,
                                   std::ostream &ostream);
 
-template <typename T>
-std::ostream &serializeTensorDataRaw(const llvm::ArrayRef<size_t> &dimensions,
-                                     const llvm::ArrayRef<T> &values,
-                                     std::ostream &ostream) {
-
+// header of a serialized TensorData, the element values follow as raw words
+inline std::ostream &
+serializeTensorDataHeader(const llvm::ArrayRef<size_t> &dimensions,
+                          size_t elementWidth, bool sign,
+                          std::ostream &ostream) {
   writeWord<uint64_t>(ostream, dimensions.size());
 
   for (size_t dim : dimensions)
     writeWord<int64_t>(ostream, dim);
 
-  writeWord<uint64_t>(ostream, sizeof(T) * 8);
-  writeWord<uint8_t>(ostream, std::is_signed<T>());
+  writeWord<uint64_t>(ostream, elementWidth);
+  writeWord<uint8_t>(ostream, sign);
 
-  for (T val : values)
-    writeWord(ostream, val);
+  return ostream;
+}
+
+template <typename T>
+std::ostream &serializeTensorDataRaw(const llvm::ArrayRef<size_t> &dimensions,
+                                     const llvm::ArrayRef<T> &values,
+                                     std::ostream &ostream) {
+
+  serializeTensorDataHeader(dimensions, sizeof(T) * 8, std::is_signed<T>(),
+                            ostream);
+
+  if (!values.empty())
+    writeWords(ostream, values.data(), values.size());
 
   return ostream;
 }
@@ -108,6 +131,13 @@ std::ostream &operator<<(std::ostream &ostream,
                          const LweKeyswitchKey &wrappedKsk);
 LweKeyswitchKey readLweKeyswitchKey(std::istream &istream);
 
+// Key parameter headers, for readers that consume the payload
+// themselves (e.g. the direct-to-device key loader in the runtime).
+std::istream &operator>>(std::istream &istream, KeyswitchKeyParam &param);
+std::istream &operator>>(std::istream &istream, BootstrapKeyParam &param);
+std::istream &operator>>(std::istream &istream,
+                         PackingKeyswitchKeyParam &param);
+
 std::ostream &operator<<(std::ostream &ostream,
                          const LweBootstrapKey &wrappedBsk);
 LweBootstrapKey readLweBootstrapKey(std::istream &istream);
@@ -123,6 +153,24 @@ std::ostream &operator<<(std::ostream &ostream,
                          const EvaluationKeys &evaluationKeys);
 EvaluationKeys readEvaluationKeys(std::istream &istream);
 
+/// Writes a ready-to-run snapshot of `evaluationKeys` to `path`: every key
+/// buffer in its final in-memory layout at a page-aligned offset, together
+/// with the Fourier-domain representation of each bootstrap key (converted
+/// here when the keys do not already carry one). A server persists the
+/// snapshot after its first full initialization so that subsequent
+/// processes resume from the file instead of re-deserializing and
+/// re-converting the keys.
+outcome::checked<void, StringError>
+saveEvaluationKeysSnapshot(const EvaluationKeys &evaluationKeys,
+                           const std::string &path);
+
+/// Maps the snapshot written by saveEvaluationKeysSnapshot and returns
+/// evaluation keys backed by the mapped pages: no key material is copied
+/// or converted, the pages are faulted in on first use and the attached
+/// Fourier representations let the runtime skip its conversion step.
+outcome::checked<EvaluationKeys, StringError>
+loadEvaluationKeysSnapshot(const std::string &path);
+
 } // namespace clientlib
 } // namespace concretelang
 
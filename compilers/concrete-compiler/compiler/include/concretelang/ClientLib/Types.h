@@ -253,6 +253,9 @@ protected:
   ElementType elementType;
   std::vector<size_t> dimensions;
   size_t elementWidth;
+  // Non-null when the tensor is a view over a caller-owned buffer, see
+  // `fromBorrowedBuffer`. The vectors of `values` are unused in that case.
+  void *borrowedData = nullptr;
 
   /* Multi-dimensional, uninitialized, but preallocated tensor */
   void initPreallocated(llvm::ArrayRef<size_t> dimensions,
@@ -304,6 +307,18 @@ protected:
     return std::vector<size_t>(dims.begin(), dims.end());
   }
 
+  /* Multi-dimensional view over a caller-owned buffer, no allocation nor
+   * copy */
+  TensorData(void *borrowedData, llvm::ArrayRef<size_t> dimensions,
+             ElementType elementType, size_t elementWidth)
+      : elementType(elementType),
+        dimensions(dimensions.begin(), dimensions.end()),
+        elementWidth(elementWidth), borrowedData(borrowedData) {
+    assert(borrowedData != nullptr);
+    assert(dimensions.size() != 0);
+    this->values.u64 = nullptr;
+  }
+
 public:
   // Returns the total number of elements of a tensor with the
   // specified dimensions
@@ -318,7 +333,8 @@ public:
   // Move constructor. Leaves `that` uninitialized.
   TensorData(TensorData &&that)
       : elementType(that.elementType), dimensions(std::move(that.dimensions)),
-        elementWidth(that.elementWidth) {
+        elementWidth(that.elementWidth), borrowedData(that.borrowedData) {
+    that.borrowedData = nullptr;
     switch (that.elementType) {
     case ElementType::u64:
       this->values.u64 = that.values.u64;
@@ -410,6 +426,55 @@ public:
   DEF_TENSOR_DATA_TENSOR_COSTRUCTORS(uint8_t, u8)
   DEF_TENSOR_DATA_TENSOR_COSTRUCTORS(int8_t, i8)
 
+  // Creates a tensor that borrows the contiguous, densely packed buffer
+  // `data` instead of owning a copy of the values. The buffer must stay
+  // alive and unchanged for the whole lifetime of the returned tensor.
+  static TensorData fromBorrowedBuffer(void *data,
+                                       llvm::ArrayRef<size_t> dimensions,
+                                       size_t elementWidth, bool sign) {
+    return TensorData(data, dimensions,
+                      getElementTypeFromWidthAndSign(elementWidth, sign),
+                      elementWidth);
+  }
+
+  // Returns `true` if the tensor is a view over a caller-owned buffer
+  bool isBorrowed() const { return this->borrowedData != nullptr; }
+
+  // Returns a non-owning view over the rows [`begin`, `end`) of the
+  // outermost dimension. Such a slice of a contiguous tensor is itself
+  // contiguous, so this is an O(1) metadata operation: no element is
+  // copied. The view borrows this tensor's storage, which must stay alive
+  // and unchanged for the whole lifetime of the slice.
+  TensorData slice(size_t begin, size_t end) {
+    assert(begin <= end && end <= this->dimensions[0] &&
+           "Slice bounds out of range");
+    size_t rowElements = 1;
+    for (size_t i = 1; i < this->dimensions.size(); i++)
+      rowElements *= this->dimensions[i];
+    std::vector<size_t> sliceDimensions(this->dimensions);
+    sliceDimensions[0] = end - begin;
+    return TensorData(getOpaqueElementPointer(begin * rowElements),
+                      sliceDimensions, this->elementType, this->elementWidth);
+  }
+
+  // Splits the outermost dimension into `count` chunks of non-owning
+  // views, the first `length % count` chunks holding one extra row. Like
+  // `slice`, no element is copied and the chunks borrow this tensor's
+  // storage.
+  std::vector<TensorData> split(size_t count) {
+    assert(count > 0 && "Cannot split into zero chunks");
+    std::vector<TensorData> chunks;
+    chunks.reserve(count);
+    size_t rows = this->dimensions[0];
+    size_t begin = 0;
+    for (size_t i = 0; i < count; i++) {
+      size_t end = begin + rows / count + (i < rows % count ? 1 : 0);
+      chunks.push_back(slice(begin, end));
+      begin = end;
+    }
+    return chunks;
+  }
+
   ~TensorData() {
     switch (this->elementType) {
     case ElementType::u64:
@@ -471,18 +536,21 @@ public:
   // Iterator pointing to the first element of a flat representation
   // of the tensor.
   template <typename T> typename std::vector<T>::iterator begin() {
+    assert(!isBorrowed() && "Iterators are unavailable on borrowed tensors");
     return detail::TensorData::begin<typename std::vector<T>::iterator>(values);
   }
 
   // Iterator pointing past the last element of a flat representation
   // of the tensor.
   template <typename T> typename std::vector<T>::iterator end() {
+    assert(!isBorrowed() && "Iterators are unavailable on borrowed tensors");
     return detail::TensorData::end<typename std::vector<T>::iterator>(values);
   }
 
   // Const iterator pointing to the first element of a flat
   // representation of the tensor.
   template <typename T> typename std::vector<T>::iterator cbegin() {
+    assert(!isBorrowed() && "Iterators are unavailable on borrowed tensors");
     return detail::TensorData::cbegin<typename std::vector<T>::iterator>(
         values);
   }
@@ -490,27 +558,46 @@ public:
   // Const iterator pointing past the last element of a flat
   // representation of the tensor.
   template <typename T> typename std::vector<T>::iterator cend() {
+    assert(!isBorrowed() && "Iterators are unavailable on borrowed tensors");
     return detail::TensorData::cend<typename std::vector<T>::iterator>(values);
   }
 
   // Flat representation of the const tensor
   template <typename T> const std::vector<T> &getElements() const {
+    assert(!isBorrowed() &&
+           "Borrowed tensors have no backing vector, use getElementsView");
     return detail::TensorData::getConstElements<const std::vector<T> &>(values);
   }
 
   // Flat representation of the tensor
   template <typename T> const std::vector<T> &getElements() {
+    assert(!isBorrowed() &&
+           "Borrowed tensors have no backing vector, use getElementsView");
     return detail::TensorData::getElements<std::vector<T> &>(values);
   }
 
+  // Flat representation of the tensor as a reference to the contiguous
+  // values, also valid for views over borrowed buffers
+  template <typename T> llvm::ArrayRef<T> getElementsView() const {
+    if (isBorrowed()) {
+      return llvm::ArrayRef<T>(reinterpret_cast<const T *>(borrowedData),
+                               getNumElements());
+    }
+    return getElements<T>();
+  }
+
   // Returns the `index`-th value of a flat representation of the tensor
   template <typename T> T getElementValue(size_t index) {
+    if (isBorrowed())
+      return reinterpret_cast<T *>(borrowedData)[index];
     return detail::TensorData::getElementValue<T>(values, index, elementType);
   }
 
   // Returns a reference to the `index`-th value of a flat
   // representation of the tensor
   template <typename T> T &getElementReference(size_t index) {
+    if (isBorrowed())
+      return reinterpret_cast<T *>(borrowedData)[index];
     return detail::TensorData::getElementReference<T>(values, index,
                                                       elementType);
   }
@@ -518,18 +605,25 @@ public:
   // Returns a pointer to the `index`-th value of a flat
   // representation of the tensor
   template <typename T> T *getElementPointer(size_t index) {
+    if (isBorrowed())
+      return reinterpret_cast<T *>(borrowedData) + index;
     return detail::TensorData::getElementPointer<T>(values, index, elementType);
   }
 
   // Returns a pointer to the `index`-th value of a flat
   // representation of the tensor (const version)
   template <typename T> const T *getElementPointer(size_t index) const {
+    if (isBorrowed())
+      return reinterpret_cast<const T *>(borrowedData) + index;
     return detail::TensorData::getElementPointer<T>(values, index, elementType);
   }
 
   // Returns a void pointer to the `index`-th value of a flat
   // representation of the tensor
   void *getOpaqueElementPointer(size_t index) {
+    if (isBorrowed())
+      return static_cast<void *>(static_cast<uint8_t *>(borrowedData) +
+                                 index * getElementSize());
     switch (this->elementType) {
     case ElementType::u64:
       return reinterpret_cast<void *>(
@@ -618,6 +712,7 @@ public:
   // does not append values to the tensor, but overwrites existing
   // values.
   template <typename T> void bulkAssign(llvm::ArrayRef<T> values) {
+    assert(!isBorrowed() && "Cannot assign to a borrowed tensor");
     assert(values.size() <= this->getNumElements());
 
     switch (this->elementType) {
@@ -652,31 +747,47 @@ public:
   // positions starting with the iterator `start`.
   template <typename IT> void copy(IT start) const {
     switch (this->elementType) {
-    case ElementType::u64:
-      std::copy(this->values.u64->cbegin(), this->values.u64->cend(), start);
+    case ElementType::u64: {
+      auto elements = getElementsView<uint64_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::i64:
-      std::copy(this->values.i64->cbegin(), this->values.i64->cend(), start);
+    }
+    case ElementType::i64: {
+      auto elements = getElementsView<int64_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::u32:
-      std::copy(this->values.u32->cbegin(), this->values.u32->cend(), start);
+    }
+    case ElementType::u32: {
+      auto elements = getElementsView<uint32_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::i32:
-      std::copy(this->values.i32->cbegin(), this->values.i32->cend(), start);
+    }
+    case ElementType::i32: {
+      auto elements = getElementsView<int32_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::u16:
-      std::copy(this->values.u16->cbegin(), this->values.u16->cend(), start);
+    }
+    case ElementType::u16: {
+      auto elements = getElementsView<uint16_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::i16:
-      std::copy(this->values.i16->cbegin(), this->values.i16->cend(), start);
+    }
+    case ElementType::i16: {
+      auto elements = getElementsView<int16_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::u8:
-      std::copy(this->values.u8->cbegin(), this->values.u8->cend(), start);
+    }
+    case ElementType::u8: {
+      auto elements = getElementsView<uint8_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
-    case ElementType::i8:
-      std::copy(this->values.i8->cbegin(), this->values.i8->cend(), start);
+    }
+    case ElementType::i8: {
+      auto elements = getElementsView<int8_t>();
+      std::copy(elements.begin(), elements.end(), start);
       break;
     }
+    }
   }
 
   // Returns a flat representation of the tensor with elements
@@ -690,6 +801,8 @@ public:
   // Returns a void pointer to the first element of a flat
   // representation of the tensor
   void *getValuesAsOpaquePointer() const {
+    if (isBorrowed())
+      return borrowedData;
     switch (this->elementType) {
     case ElementType::u64:
       return static_cast<void *>(values.u64->data());
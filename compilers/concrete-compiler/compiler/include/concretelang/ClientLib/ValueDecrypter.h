@@ -7,6 +7,9 @@
 #define CONCRETELANG_CLIENTLIB_VALUE_DECRYPTER_H
 
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #include "boost/outcome.h"
 
@@ -90,20 +93,36 @@ public:
     OUTCOME_TRY(auto gate, outputGate(pos));
     auto lweSize = ciphertextSize(gate);
 
-    std::vector<T> decryptedValues(buffer.length() / lweSize);
-    for (size_t i = 0; i < decryptedValues.size(); i++) {
+    std::vector<uint64_t> decrypted(buffer.length() / lweSize);
+    OUTCOME_TRYV(decryptTensorValues(buffer, pos, lweSize, decrypted));
+    // Sized construction narrows in one vectorizable pass instead of one
+    // cast per element
+    std::vector<T> decryptedValues(decrypted.begin(), decrypted.end());
+    return decryptedValues;
+  }
+
+protected:
+  /// Decrypt a whole tensor of ciphertexts of `lweSize` 64bits words each
+  /// into `outputs`. Decrypters may override this to batch or parallelize
+  /// the decryption.
+  virtual outcome::checked<void, StringError>
+  decryptTensorValues(TensorData &buffer, size_t argPos, int64_t lweSize,
+                      std::vector<uint64_t> &outputs) {
+    for (size_t i = 0; i < outputs.size(); i++) {
       auto ciphertext = buffer.getOpaqueElementPointer(i * lweSize);
 
       // Convert to uint64_t* as required by `KeySet::decrypt_lwe`
       // FIXME: this may break alignment restrictions on some
       // architectures
       auto ciphertextu64 = reinterpret_cast<uint64_t *>(ciphertext);
-      OUTCOME_TRY(auto decrypted, decryptValue(pos, ciphertextu64));
-      decryptedValues[i] = decrypted;
+      OUTCOME_TRY(auto decrypted, decryptValue(argPos, ciphertextu64));
+      outputs[i] = decrypted;
     }
-    return decryptedValues;
+    return outcome::success();
   }
 
+public:
+
   /// Return the shape of the clear tensor of a result.
   outcome::checked<std::vector<int64_t>, StringError> getShape(size_t pos) {
     OUTCOME_TRY(auto gate, outputGate(pos));
@@ -125,6 +144,53 @@ protected:
     return decrypted;
   };
 
+  /// Decrypt the ciphertexts of a whole tensor across a pool of threads.
+  /// Decryption draws no randomness and `KeySet::decrypt_lwe` does not
+  /// mutate the key set, so the threads need no private state. Amortizes the
+  /// per-ciphertext overhead which dominates the decryption of large result
+  /// tensors.
+  outcome::checked<void, StringError>
+  decryptTensorValues(TensorData &buffer, size_t argPos, int64_t lweSize,
+                      std::vector<uint64_t> &outputs) override {
+    size_t numThreads = std::min<size_t>(
+        std::max<size_t>(std::thread::hardware_concurrency(), 1),
+        outputs.size());
+    if (numThreads <= 1) {
+      return ValueDecrypterInterface::decryptTensorValues(buffer, argPos,
+                                                          lweSize, outputs);
+    }
+    std::vector<std::thread> threads;
+    std::mutex errorMutex;
+    std::optional<StringError> firstError;
+    size_t chunkSize = (outputs.size() + numThreads - 1) / numThreads;
+    for (size_t t = 0; t < numThreads; t++) {
+      size_t begin = t * chunkSize;
+      size_t end = std::min(begin + chunkSize, outputs.size());
+      threads.push_back(std::thread([&, begin, end]() {
+        for (size_t i = begin; i < end; i++) {
+          auto ciphertext = buffer.getOpaqueElementPointer(i * lweSize);
+          auto ciphertextu64 = reinterpret_cast<uint64_t *>(ciphertext);
+          auto res = decryptValue(argPos, ciphertextu64);
+          if (res.has_error()) {
+            const std::lock_guard<std::mutex> guard(errorMutex);
+            if (!firstError.has_value()) {
+              firstError = res.error();
+            }
+            return;
+          }
+          outputs[i] = res.value();
+        }
+      }));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (firstError.has_value()) {
+      return *firstError;
+    }
+    return outcome::success();
+  }
+
   bool isSimulated() override { return false; }
 
   outcome::checked<CircuitGate, StringError>
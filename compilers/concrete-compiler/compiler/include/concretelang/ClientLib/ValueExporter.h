@@ -6,7 +6,11 @@
 #ifndef CONCRETELANG_CLIENTLIB_VALUE_EXPORTER_H
 #define CONCRETELANG_CLIENTLIB_VALUE_EXPORTER_H
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
 #include <ostream>
+#include <thread>
 
 #include "boost/outcome.h"
 
@@ -14,6 +18,7 @@
 #include "concretelang/ClientLib/ClientParameters.h"
 #include "concretelang/ClientLib/EvaluationKeys.h"
 #include "concretelang/ClientLib/KeySet.h"
+#include "concretelang/ClientLib/Serializers.h"
 #include "concretelang/ClientLib/Types.h"
 #include "concretelang/Common/Error.h"
 #include "concretelang/Runtime/simulation.h"
@@ -23,6 +28,10 @@ namespace clientlib {
 
 using concretelang::error::StringError;
 
+/// Default size of the scratch buffer of the streaming export, i.e. of the
+/// chunks of ciphertexts encrypted and written out at once
+constexpr size_t defaultExportChunkBytes = 8 << 20;
+
 class ValueExporterInterface {
 protected:
   virtual outcome::checked<void, StringError> encryptValue(CircuitGate &gate,
@@ -78,6 +87,101 @@ public:
     return exportClearTensor(arg, shape, gate);
   }
 
+  /// @brief Write the argument count header of a streaming export
+  /// Makes the stream wire-compatible with `PublicArguments::unserialize`,
+  /// call it once before streaming each argument with `exportValueToStream`.
+  static outcome::checked<void, StringError>
+  exportArgumentCountToStream(size_t numArguments, std::ostream &ostream) {
+    if (incorrectMode(ostream)) {
+      return StringError(
+          "exportArgumentCountToStream: ostream should be in binary mode");
+    }
+    writeSize<uint64_t>(ostream, numArguments);
+    return outcome::success();
+  }
+
+  /// @brief Export a scalar 64 bits integer directly into an output stream
+  /// @param arg An 64 bits integer
+  /// @param argPos The position of the argument to export
+  /// @param ostream The stream receiving the serialized value
+  /// @return Either nothing or an error if the gate doesn't match the
+  /// expected argument or the stream goes bad.
+  outcome::checked<void, StringError>
+  exportValueToStream(uint64_t arg, size_t argPos, std::ostream &ostream) {
+    OUTCOME_TRY(auto value, exportValue(arg, argPos));
+    serializeScalarOrTensorData(value, ostream);
+    if (ostream.bad()) {
+      return StringError("exportValueToStream: cannot write to stream");
+    }
+    return outcome::success();
+  }
+
+  /// @brief Export a tensor like buffer of values directly into an output
+  /// stream
+  ///
+  /// Encrypted tensors are encrypted and serialized in chunks of at most
+  /// `chunkBytes` of ciphertexts, so the peak memory of the export stays
+  /// bounded by the chunk size instead of the full encrypted payload. Clear
+  /// tensors don't expand when exported and are serialized in one shot.
+  /// @param arg A pointer to a memory area where the values are stored
+  /// @param shape The shape of the tensor
+  /// @param argPos The position of the argument to export
+  /// @param ostream The stream receiving the serialized value
+  /// @return Either nothing or an error if the gate doesn't match the
+  /// expected argument or the stream goes bad.
+  template <typename T>
+  outcome::checked<void, StringError>
+  exportValueToStream(const T *arg, llvm::ArrayRef<int64_t> shape,
+                      size_t argPos, std::ostream &ostream,
+                      size_t chunkBytes = defaultExportChunkBytes) {
+    OUTCOME_TRY(auto gate, inputGate(argPos));
+    OUTCOME_TRYV(checkShape(shape, gate.shape, argPos));
+    if (!gate.encryption.has_value()) {
+      OUTCOME_TRY(auto value, exportValue(arg, shape, argPos));
+      serializeScalarOrTensorData(value, ostream);
+      if (ostream.bad()) {
+        return StringError("exportValueToStream: cannot write to stream");
+      }
+      return outcome::success();
+    }
+    if (incorrectMode(ostream)) {
+      return StringError(
+          "exportValueToStream: ostream should be in binary mode");
+    }
+
+    // Write the header `serializeScalarOrTensorData` would write for the
+    // TensorData of the whole encrypted tensor
+    auto sizes = bufferShape(gate);
+    std::vector<size_t> dimensions(sizes.begin(), sizes.end());
+    writeWord<uint8_t>(ostream, 1); // tensor tag
+    serializeTensorDataHeader(dimensions, EncryptedScalarElementWidth, false,
+                              ostream);
+
+    // Encrypt and write out chunks of ciphertexts through a bounded scratch
+    // buffer
+    auto lweSize = ciphertextSize(gate);
+    size_t numValues = gate.shape.size;
+    size_t chunkValues =
+        std::max<size_t>(1, chunkBytes / (lweSize * sizeof(uint64_t)));
+    std::vector<uint64_t> chunk(std::min<size_t>(chunkValues, numValues) *
+                                lweSize);
+    std::vector<uint64_t> inputs;
+    for (size_t offset = 0; offset < numValues; offset += chunkValues) {
+      size_t count = std::min(chunkValues, numValues - offset);
+      inputs.resize(count);
+      // std::copy widens in one vectorizable pass (and degenerates to a
+      // memcpy when the argument is already 64 bits wide)
+      std::copy(arg + offset, arg + offset + count, inputs.begin());
+      OUTCOME_TRYV(
+          encryptTensorValues(gate, argPos, chunk.data(), inputs, lweSize));
+      writeWords(ostream, chunk.data(), count * lweSize);
+      if (ostream.bad()) {
+        return StringError("exportValueToStream: cannot write to stream");
+      }
+    }
+    return outcome::success();
+  }
+
 protected:
   /// Export a 64bits integer to a serializable value
   virtual outcome::checked<ScalarOrTensorData, StringError>
@@ -108,16 +212,28 @@ protected:
     TensorData td(sizes, EncryptedScalarElementType,
                   EncryptedScalarElementWidth);
 
-    // Iterate over values and encrypt at the right place the value
+    // Encrypt every value of the tensor at the right place in the buffer
     auto lweSize = ciphertextSize(gate);
-    for (size_t i = 0, offset = 0; i < gate.shape.size;
-         i++, offset += lweSize) {
-      OUTCOME_TRYV(encryptValue(
-          gate, argPos, td.getElementPointer<uint64_t>(offset), arg[i]));
-    }
+    std::vector<uint64_t> inputs(gate.shape.size);
+    std::copy(arg, arg + inputs.size(), inputs.begin());
+    OUTCOME_TRYV(encryptTensorValues(
+        gate, argPos, td.getElementPointer<uint64_t>(0), inputs, lweSize));
     return std::move(td);
   }
 
+  /// Encrypt a whole tensor of values into the output buffer, one ciphertext
+  /// of `lweSize` 64bits words per value. Exporters may override this to
+  /// batch or parallelize the encryption.
+  virtual outcome::checked<void, StringError>
+  encryptTensorValues(CircuitGate &gate, size_t argPos, uint64_t *buffer,
+                      const std::vector<uint64_t> &inputs, int64_t lweSize) {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      OUTCOME_TRYV(
+          encryptValue(gate, argPos, buffer + i * lweSize, inputs[i]));
+    }
+    return outcome::success();
+  }
+
 private:
   static outcome::checked<void, StringError>
   checkShape(llvm::ArrayRef<int64_t> shape, CircuitGateShape expected,
@@ -153,19 +269,79 @@ public:
   /// @brief
   /// @param keySet
   /// @param clientParameters
+  /// @param trivialEncryption When set, values are encrypted trivially (zero
+  /// mask, no noise), skipping the CSPRNG entirely. Only meant for public
+  /// inputs, a trivial ciphertext hides nothing.
   // TODO: Get rid of the reference here could make troubles (see for KeySet
   // copy constructor or shared pointers)
-  ValueExporter(KeySet &keySet, ClientParameters clientParameters)
-      : _keySet(keySet), _clientParameters(clientParameters) {}
+  ValueExporter(KeySet &keySet, ClientParameters clientParameters,
+                bool trivialEncryption = false)
+      : _keySet(keySet), _clientParameters(clientParameters),
+        _trivialEncryption(trivialEncryption) {}
 
 protected:
   outcome::checked<void, StringError> encryptValue(CircuitGate &gate,
                                                    size_t argPos,
                                                    uint64_t *ciphertext,
                                                    uint64_t input) override {
+    if (_trivialEncryption) {
+      return _keySet.trivial_encrypt_lwe(argPos, ciphertext, input);
+    }
     return _keySet.encrypt_lwe(argPos, ciphertext, input);
   }
 
+  /// Encrypt the values of a whole tensor across a pool of threads, each one
+  /// drawing randomness from its own freshly seeded CSPRNG stream as the
+  /// KeySet csprng is not thread safe. Amortizes the per-ciphertext overhead
+  /// which dominates the encryption of large input tensors.
+  outcome::checked<void, StringError>
+  encryptTensorValues(CircuitGate &gate, size_t argPos, uint64_t *buffer,
+                      const std::vector<uint64_t> &inputs,
+                      int64_t lweSize) override {
+    // Trivial encryption is a plain buffer fill, the thread pool would only
+    // add overhead.
+    if (_trivialEncryption) {
+      return ValueExporterInterface::encryptTensorValues(gate, argPos, buffer,
+                                                         inputs, lweSize);
+    }
+    size_t numThreads = std::min<size_t>(
+        std::max<size_t>(std::thread::hardware_concurrency(), 1),
+        inputs.size());
+    if (numThreads <= 1) {
+      return _keySet.encrypt_lwe_batch(argPos, buffer, inputs.data(),
+                                       inputs.size());
+    }
+    std::vector<std::thread> threads;
+    std::mutex errorMutex;
+    std::optional<StringError> firstError;
+    size_t chunkSize = (inputs.size() + numThreads - 1) / numThreads;
+    for (size_t t = 0; t < numThreads; t++) {
+      size_t begin = t * chunkSize;
+      size_t end = std::min(begin + chunkSize, inputs.size());
+      threads.push_back(std::thread([&, begin, end]() {
+        ConcreteCSPRNG csprng(0);
+        // One batched call per chunk: no per-ciphertext FFI, and the
+        // backend vectorizes the mask-secret dot products.
+        auto res = _keySet.encrypt_lwe_batch(argPos, buffer + begin * lweSize,
+                                             inputs.data() + begin,
+                                             end - begin, csprng);
+        if (res.has_error()) {
+          const std::lock_guard<std::mutex> guard(errorMutex);
+          if (!firstError.has_value()) {
+            firstError = res.error();
+          }
+        }
+      }));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (firstError.has_value()) {
+      return *firstError;
+    }
+    return outcome::success();
+  }
+
   outcome::checked<CircuitGate, StringError> inputGate(size_t argPos) override {
     return _clientParameters.input(argPos);
   }
@@ -196,6 +372,7 @@ protected:
 private:
   KeySet &_keySet;
   ClientParameters _clientParameters;
+  bool _trivialEncryption;
 };
 
 /// @brief The SimulatedValueExporter allows to transform clear
@@ -12,6 +12,7 @@
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
 
 #include "concretelang/Conversion/ConcreteToCAPI/Pass.h"
 #include "concretelang/Conversion/ExtractSDFGOps/Pass.h"
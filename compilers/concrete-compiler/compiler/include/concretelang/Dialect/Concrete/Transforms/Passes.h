@@ -14,6 +14,9 @@
 namespace mlir {
 namespace concretelang {
 std::unique_ptr<OperationPass<ModuleOp>> createAddRuntimeContext();
+std::unique_ptr<OperationPass<ModuleOp>> createGlwePackingPass();
+std::unique_ptr<OperationPass<ModuleOp>> createTLUDedupPass();
+std::unique_ptr<OperationPass<ModuleOp>> createStrengthReductionPass();
 } // namespace concretelang
 } // namespace mlir
 
@@ -19,7 +19,14 @@ class RewritePatternSet;
 namespace concretelang {
 std::unique_ptr<mlir::Pass>
 createBuildDataflowTaskGraphPass(bool debug = false);
-std::unique_ptr<mlir::Pass> createLowerDataflowTasksPass(bool debug = false);
+/// Minimum estimated work per dataflow task, in multiples of a levelled
+/// operation on a single ciphertext (see the coarsening cost model in
+/// LowerDataflowTasksToRT.cpp); tasks below this grain are merged with
+/// one of their producers.
+constexpr uint64_t DEFAULT_DATAFLOW_TASK_GRAIN_SIZE = 512;
+std::unique_ptr<mlir::Pass> createLowerDataflowTasksPass(
+    bool debug = false,
+    uint64_t taskGrainSize = DEFAULT_DATAFLOW_TASK_GRAIN_SIZE);
 std::unique_ptr<mlir::Pass>
 createBufferizeDataflowTaskOpsPass(bool debug = false);
 std::unique_ptr<mlir::Pass> createFinalizeTaskCreationPass(bool debug = false);
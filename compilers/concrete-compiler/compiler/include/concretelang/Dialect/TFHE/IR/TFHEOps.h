@@ -16,6 +16,23 @@
 #include "concretelang/Dialect/TFHE/IR/TFHETypes.h"
 #include "concretelang/Interfaces/BatchableInterface.h"
 
+namespace mlir {
+namespace concretelang {
+namespace TFHE {
+
+/// Estimates the number of bytes that a single element of a batch
+/// contributes to the operand and result buffers of the batched
+/// version of the operation `op`, i.e., the accumulated sizes of the
+/// batchable operands and of the result. Returns 0 if no estimate can
+/// be given for at least one of the types involved.
+int64_t batchedElementByteSizeEstimate(
+    mlir::Operation *op,
+    ::llvm::MutableArrayRef<::mlir::OpOperand> batchableOperands);
+
+} // namespace TFHE
+} // namespace concretelang
+} // namespace mlir
+
 #define GET_OP_CLASSES
 #include "concretelang/Dialect/TFHE/IR/TFHEOps.h.inc"
 
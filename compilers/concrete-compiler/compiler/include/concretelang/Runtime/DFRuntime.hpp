@@ -47,6 +47,20 @@ static inline uint64_t _dfr_set_memref_element_size(uint64_t val, size_t size) {
   return (val & 0xFF) | (((uint64_t)size) << 8);
 }
 
+/// The task priority word packs the critical-path share of the task
+/// (low 32 bits, 0-100) with its topological wave (high 32 bits), both
+/// computed in LowerDataflowTasksToRT.cpp. The wave is the task's level
+/// in the dependency graph; the runtime uses it to release whole waves
+/// of ready tasks at once.
+static inline uint64_t _dfr_set_task_wave(uint64_t val, uint64_t wave) {
+  assert(wave < (((uint64_t)1) << 32));
+  return (val & 0xFFFFFFFFUL) | (wave << 32);
+}
+static inline uint64_t _dfr_get_task_wave(uint64_t val) { return val >> 32; }
+static inline uint64_t _dfr_get_task_priority(uint64_t val) {
+  return val & 0xFFFFFFFFUL;
+}
+
 } // namespace dfr
 } // namespace concretelang
 } // namespace mlir
@@ -7,9 +7,16 @@
 #define CONCRETELANG_RUNTIME_CONTEXT_H
 
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <istream>
 #include <pthread.h>
+#include <set>
+#include <tuple>
 #include <vector>
 
 #include "concretelang/ClientLib/EvaluationKeys.h"
@@ -37,112 +44,322 @@ typedef struct FFT {
   size_t polynomial_size;
 } FFT;
 
+/// Process-wide registry of FFT plans keyed by polynomial size. Plans are
+/// identical for a given polynomial size, so contexts built over different
+/// evaluation keys share them instead of each paying the planning cost.
+/// The load paths warm the registry up front (see ServerLambda::load) so
+/// the first invocation does not plan either.
+class FFTPlanRegistry {
+public:
+  static FFTPlanRegistry &instance();
+
+  /// Returns the shared plan for `polynomial_size`, constructing it on
+  /// first use.
+  std::shared_ptr<const FFT> get(size_t polynomial_size);
+
+private:
+  std::mutex mutex;
+  std::map<size_t, std::shared_ptr<const FFT>> plans;
+};
+
+#ifdef CONCRETELANG_CUDA_SUPPORT
+/// Process-wide pacer for bulk host-to-device transfers (key uploads,
+/// typically gigabytes). A monolithic copy occupies the copy engine for
+/// its whole duration, so the small latency-sensitive ciphertext copies
+/// of concurrent invocations queue behind it. The pacer splits bulk
+/// transfers into chunks -- between two chunks the engine services the
+/// copies of other streams -- and optionally rate-limits the chunks
+/// under a token bucket so bulk traffic only consumes a configured
+/// share of the bus. CONCRETE_GPU_BULK_CHUNK_MB sets the chunk size
+/// (default 64, 0 issues one monolithic transfer), and
+/// CONCRETE_GPU_BULK_MBPS caps the bulk bandwidth (default 0, chunking
+/// without pacing).
+class GPUTransferScheduler {
+public:
+  static GPUTransferScheduler &instance();
+
+  /// Runs the bulk transfer of `itemCount` items of `itemBytes` bytes
+  /// each as a sequence of `transferChunk(start, count)` calls over
+  /// chunk-sized item ranges, taking bucket tokens before each chunk.
+  /// `stream` is synchronized between paced chunks so a chunk's copy
+  /// has really left the engine before the bucket refills.
+  void paced(size_t itemCount, size_t itemBytes, void *stream,
+             const std::function<void(size_t, size_t)> &transferChunk);
+
+  /// Paced plain host-to-device copy of `bytes` from `src` to `dst` on
+  /// `gpu_idx`, issued on `stream` (the destination may be a pending
+  /// stream-ordered allocation on it). Completion follows the stream.
+  void bulkUpload(uint32_t gpu_idx, void *dst, const void *src, size_t bytes,
+                  void *stream);
+
+private:
+  GPUTransferScheduler();
+
+  /// Blocks until the bucket holds `bytes` tokens, then takes them.
+  /// No-op without a configured rate.
+  void takeTokens(size_t bytes);
+
+  size_t chunkBytes;
+  // Token bucket: bytes of bulk transfer allowed ahead of the refill
+  // rate; capacity of a few chunks keeps isolated uploads unthrottled.
+  double rateBytesPerSecond;
+  double tokens;
+  std::chrono::steady_clock::time_point lastRefill;
+  std::mutex mutex;
+};
+
+/// Process-wide residency manager for evaluation keys on devices. Device
+/// buffers are keyed by the host key buffer address, so RuntimeContexts
+/// built over the same EvaluationKeys share a single device copy per GPU.
+/// Host buffers are page-locked for the duration of the upload, and when a
+/// device runs out of memory the least recently used keys of finished
+/// contexts are evicted before retrying.
+class GPUKeyResidencyManager {
+public:
+  static GPUKeyResidencyManager &instance();
+
+  /// Returns the device copy of the key backed by `hostBuffer` on device
+  /// `gpu_idx`, invoking `upload` to create it on first use. `user`
+  /// identifies the RuntimeContext requesting residency and keeps the key
+  /// pinned on the device until `release`d.
+  void *get(uint32_t gpu_idx, const void *hostBuffer, size_t deviceBytes,
+            const void *user, const std::function<void *()> &upload);
+
+  /// Called when `user` no longer needs its keys. Their device copies
+  /// remain cached for later invocations but become candidates for LRU
+  /// eviction under memory pressure.
+  void release(const void *user);
+
+  /// Registers a device buffer uploaded outside the manager (e.g. by the
+  /// direct-to-device key loader) under the identity `hostBuffer`. The
+  /// key has no host copy to re-upload from, so it is pinned on the
+  /// device and never considered for eviction.
+  void adopt(uint32_t gpu_idx, const void *hostBuffer, size_t deviceBytes,
+             void *devicePtr);
+
+private:
+  struct Entry {
+    void *devicePtr;
+    size_t bytes;
+    uint64_t lastUse;
+    std::set<const void *> users;
+  };
+  std::mutex mutex;
+  uint64_t clock = 0;
+  // (gpu_idx, host key buffer) -> device-resident copy
+  std::map<std::pair<uint32_t, const void *>, Entry> entries;
+
+  bool evictLeastRecentlyUsed(uint32_t gpu_idx);
+};
+
+/// Process-wide pool of device-resident bootstrap test vectors, keyed by
+/// table content. Circuits reuse a handful of distinct tables across
+/// millions of bootstraps, yet every invocation used to rebuild the
+/// trivially-encrypted GLWE accumulator on the host and upload it again.
+/// The pool uploads each distinct table once per device and hands out the
+/// shared device copy thereafter. Entries are small and live for the
+/// lifetime of the process.
+class GPULutPool {
+public:
+  static GPULutPool &instance();
+
+  /// Returns the device copy of the trivially-encrypted GLWE accumulator
+  /// built from the `poly_size * num_lut_vectors` table `tlu`, uploading
+  /// it on first use on `gpu_idx`. The returned buffer is owned by the
+  /// pool and must not be freed by the caller.
+  void *get(uint32_t gpu_idx, const uint64_t *tlu, uint32_t glwe_dim,
+            uint32_t poly_size, uint32_t num_lut_vectors, void *stream);
+
+private:
+  struct Entry {
+    void *devicePtr;
+    // Host copy of the table the device buffer was built from. The hash
+    // is not collision-free, so a hit is confirmed against the actual
+    // contents before the device copy is served.
+    std::vector<uint64_t> table;
+  };
+  std::mutex mutex;
+  // (gpu_idx, content hash, accumulator bytes) -> device-resident copy.
+  // A multimap so that tables colliding on the hash and the geometry
+  // each keep their own device copy.
+  std::multimap<std::tuple<uint32_t, uint64_t, size_t>, Entry> entries;
+};
+
+/// Reads serialized evaluation keys from `istream`, streaming every key
+/// payload from disk straight into device memory on `gpu_idx` through a
+/// small pinned staging buffer. The host side of each key keeps only
+/// its parameter header and a one-word sentinel buffer, which is the
+/// identity the device copies are registered under and what the lazy
+/// get_*_gpu accessors look up; a multi-gigabyte keyset no longer costs
+/// its size in host RSS. Only for deployments where the CPU fallback is
+/// disabled: no host key material is retained, so CPU evaluation over
+/// these keys is impossible.
+::concretelang::clientlib::EvaluationKeys
+readEvaluationKeysOnDevice(std::istream &istream, uint32_t gpu_idx,
+                           void *stream);
+#endif
+
 typedef struct RuntimeContext {
 
   RuntimeContext() = delete;
   RuntimeContext(::concretelang::clientlib::EvaluationKeys evaluationKeys);
   ~RuntimeContext() {
 #ifdef CONCRETELANG_CUDA_SUPPORT
-    for (int i = 0; i < num_devices; ++i) {
-      if (bsk_gpu[i] != nullptr)
-        cuda_drop(bsk_gpu[i], i);
-      if (ksk_gpu[i] != nullptr)
-        cuda_drop(ksk_gpu[i], i);
-    }
+    GPUKeyResidencyManager::instance().release(this);
 #endif
   };
 
   const uint64_t *keyswitch_key_buffer(size_t keyId) {
-    return evaluationKeys.getKeyswitchKey(keyId).buffer();
+    return keys()->evaluationKeys.getKeyswitchKey(keyId).buffer();
   }
 
   const double *fourier_bootstrap_key_buffer(size_t keyId) {
-    return fourier_bootstrap_keys[keyId]->data();
+    return keys()->fourier_bootstrap_key_buffers[keyId];
   }
 
   const uint64_t *fp_keyswitch_key_buffer(size_t keyId) {
-    return evaluationKeys.getPackingKeyswitchKey(keyId).buffer();
+    return keys()->evaluationKeys.getPackingKeyswitchKey(keyId).buffer();
   }
 
-  const struct Fft *fft(size_t keyId) { return ffts[keyId].fft; }
+  ::concretelang::clientlib::PackingKeyswitchKeyParam
+  fp_keyswitch_key_param(size_t keyId) {
+    return keys()->evaluationKeys.getPackingKeyswitchKey(keyId).parameters();
+  }
+
+  const struct Fft *fft(size_t keyId) { return keys()->ffts[keyId]->fft; }
+
+  /// Scratch requirements of concrete_cpu_bootstrap_lwe_ciphertext_u64 for
+  /// the key `keyId`, precomputed at key table creation so the bootstrap
+  /// wrappers do not query them through the FFI on every call.
+  void bootstrap_scratch(size_t keyId, size_t *size, size_t *align) {
+    auto table = keys();
+    *size = table->bootstrap_scratch_sizes[keyId];
+    *align = table->bootstrap_scratch_aligns[keyId];
+  }
 
   const ::concretelang::clientlib::EvaluationKeys getKeys() const {
-    return evaluationKeys;
+    return keys()->evaluationKeys;
   }
 
+  /// Atomically replaces the keys served by this context with `newKeys`,
+  /// e.g. when a tenant rotates its keyset: invocations entering after
+  /// the swap resolve every key index against the new table, without
+  /// rebuilding the context or interrupting the service. The Fourier
+  /// conversion of the new bootstrap keys happens before the swap, and
+  /// the previous table is retired rather than freed so in-flight
+  /// invocations finish on the keys they started with.
+  void rotateKeys(::concretelang::clientlib::EvaluationKeys newKeys);
+
+  /// Invocation epoch hooks, called by the invocation paths around each
+  /// circuit evaluation. Retired key tables are reclaimed when the last
+  /// active invocation leaves: any invocation entered after a rotation
+  /// only sees the new table, so global quiescence means no stale key
+  /// pointer is live anymore.
+  void enterInvocation() { activeInvocations.fetch_add(1); }
+  void leaveInvocation();
+
 private:
-  ::concretelang::clientlib::EvaluationKeys evaluationKeys;
-  std::vector<std::shared_ptr<std::vector<double>>> fourier_bootstrap_keys;
-  std::vector<FFT> ffts;
+  /// Immutable bundle of one keyset and the state derived from it. Key
+  /// accesses go through the table so a rotation is one atomic pointer
+  /// swap; entries of `fourier_bootstrap_keys` are null for keys whose
+  /// Fourier representation came with the evaluation keys (e.g. mapped
+  /// from the key set cache), in which case `evaluationKeys` keeps the
+  /// underlying buffer alive.
+  struct KeyTable {
+    KeyTable(::concretelang::clientlib::EvaluationKeys evaluationKeys);
+
+    ::concretelang::clientlib::EvaluationKeys evaluationKeys;
+    std::vector<std::shared_ptr<std::vector<double>>> fourier_bootstrap_keys;
+    std::vector<const double *> fourier_bootstrap_key_buffers;
+    std::vector<std::shared_ptr<const FFT>> ffts;
+    std::vector<size_t> bootstrap_scratch_sizes;
+    std::vector<size_t> bootstrap_scratch_aligns;
+  };
+
+  std::shared_ptr<const KeyTable> keys() const {
+    return std::atomic_load(&table);
+  }
+
+  /// Current key table, read through atomic_load/atomic_store.
+  std::shared_ptr<const KeyTable> table;
+  /// Tables replaced by rotateKeys, kept alive until quiescence.
+  std::vector<std::shared_ptr<const KeyTable>> retired;
+  std::mutex rotationMutex;
+  std::atomic<uint64_t> activeInvocations{0};
 
 #ifdef CONCRETELANG_CUDA_SUPPORT
 public:
+  /// Returns the device-resident bootstrap key, uploading and converting it
+  /// through the GPUKeyResidencyManager on first use on this device.
   void *get_bsk_gpu(uint32_t input_lwe_dim, uint32_t poly_size, uint32_t level,
-                    uint32_t glwe_dim, uint32_t gpu_idx, void *stream) {
-
-    if (bsk_gpu[gpu_idx] != nullptr) {
-      return bsk_gpu[gpu_idx];
-    }
-    const std::lock_guard<std::mutex> guard(*bsk_gpu_mutex[gpu_idx]);
-
-    if (bsk_gpu[gpu_idx] != nullptr) {
-      return bsk_gpu[gpu_idx];
-    }
-
-    auto bsk = evaluationKeys.getBootstrapKey(0);
-
-    size_t bsk_buffer_len = bsk.size();
-    size_t bsk_gpu_buffer_size = bsk_buffer_len * sizeof(double);
-
-    void *bsk_gpu_tmp =
-        cuda_malloc_async(bsk_gpu_buffer_size, (cudaStream_t *)stream, gpu_idx);
-    cuda_convert_lwe_bootstrap_key_64(
-        bsk_gpu_tmp, const_cast<uint64_t *>(bsk.buffer()),
-        (cudaStream_t *)stream, gpu_idx, input_lwe_dim, glwe_dim, level,
-        poly_size);
-    // Synchronization here is not optional as it works with mutex to
-    // prevent other GPU streams from reading partially copied keys.
-    cudaStreamSynchronize(*(cudaStream_t *)stream);
-    bsk_gpu[gpu_idx] = bsk_gpu_tmp;
-    return bsk_gpu[gpu_idx];
-  }
+                    uint32_t glwe_dim, uint32_t gpu_idx, void *stream);
 
+  /// Returns the device-resident keyswitch key, uploading it through the
+  /// GPUKeyResidencyManager on first use on this device.
   void *get_ksk_gpu(uint32_t level, uint32_t input_lwe_dim,
-                    uint32_t output_lwe_dim, uint32_t gpu_idx, void *stream) {
-
-    if (ksk_gpu[gpu_idx] != nullptr) {
-      return ksk_gpu[gpu_idx];
-    }
-
-    const std::lock_guard<std::mutex> guard(*ksk_gpu_mutex[gpu_idx]);
-    if (ksk_gpu[gpu_idx] != nullptr) {
-      return ksk_gpu[gpu_idx];
-    }
-    auto ksk = evaluationKeys.getKeyswitchKey(0);
-
-    size_t ksk_buffer_size = sizeof(uint64_t) * ksk.size();
-
-    void *ksk_gpu_tmp =
-        cuda_malloc_async(ksk_buffer_size, (cudaStream_t *)stream, gpu_idx);
-
-    cuda_memcpy_async_to_gpu(ksk_gpu_tmp, const_cast<uint64_t *>(ksk.buffer()),
-                             ksk_buffer_size, (cudaStream_t *)stream, gpu_idx);
-    // Synchronization here is not optional as it works with mutex to
-    // prevent other GPU streams from reading partially copied keys.
-    cudaStreamSynchronize(*(cudaStream_t *)stream);
-    ksk_gpu[gpu_idx] = ksk_gpu_tmp;
-    return ksk_gpu[gpu_idx];
-  }
+                    uint32_t output_lwe_dim, uint32_t gpu_idx, void *stream);
 
-private:
-  std::vector<std::unique_ptr<std::mutex>> bsk_gpu_mutex;
-  std::vector<void *> bsk_gpu;
-  std::vector<std::unique_ptr<std::mutex>> ksk_gpu_mutex;
-  std::vector<void *> ksk_gpu;
-  int num_devices;
+  /// Returns the device-resident packing keyswitch key, uploading it
+  /// through the GPUKeyResidencyManager on first use on this device.
+  void *get_pksk_gpu(uint32_t gpu_idx, void *stream);
+
+  /// Uploads every key of this context to `gpu_idx` through the getters
+  /// above, so a later invocation finds them already resident.
+  void prefetch_gpu_keys(uint32_t gpu_idx, void *stream);
 #endif
 } RuntimeContext;
 
+/// Process-wide registry of runtime contexts keyed by evaluation key
+/// identity. Circuits loaded from the same model typically share one
+/// keyset; giving each its own RuntimeContext multiplies the Fourier
+/// bootstrap keys by the number of circuits. The registry hands out one
+/// shared, refcounted context per distinct keyset instead: the context
+/// stays alive as long as some user holds it and is rebuilt on first
+/// use after all users dropped theirs.
+class RuntimeContextRegistry {
+public:
+  static RuntimeContextRegistry &instance();
+
+  /// Returns the shared context for `evaluationKeys`, constructing it
+  /// on first use. Identity is the set of key buffer addresses, so
+  /// copies of the same EvaluationKeys share a context while distinct
+  /// keysets (e.g. different tenants) each get their own.
+  std::shared_ptr<RuntimeContext>
+  get(::concretelang::clientlib::EvaluationKeys evaluationKeys);
+
+  /// Warms the context for `evaluationKeys` on a background thread:
+  /// builds it (paying the Fourier conversion of the bootstrap keys) and,
+  /// when CUDA support is enabled, uploads its keys to device 0. Intended
+  /// for sessions invoking a known sequence of circuits: declaring the
+  /// next keyset while the current circuit runs overlaps its key setup
+  /// with useful work. The warmed context is pinned in the registry so it
+  /// survives until used; releasePrefetch drops the pin at session end.
+  void prefetch(::concretelang::clientlib::EvaluationKeys evaluationKeys);
+
+  /// Unpins a context pinned by prefetch; it is destroyed once the last
+  /// invocation holding it finishes.
+  void
+  releasePrefetch(::concretelang::clientlib::EvaluationKeys evaluationKeys);
+
+  /// Re-keys the live context of `oldKeys` with `newKeys`: the shared
+  /// context rotates its key table (see RuntimeContext::rotateKeys) and
+  /// is re-registered under the new key identity so later get() calls
+  /// with either keyset stay coherent. No-op when no context is live for
+  /// `oldKeys`.
+  void rotate(::concretelang::clientlib::EvaluationKeys oldKeys,
+              ::concretelang::clientlib::EvaluationKeys newKeys);
+
+private:
+  static std::vector<const void *>
+  identityOf(::concretelang::clientlib::EvaluationKeys &evaluationKeys);
+
+  std::mutex mutex;
+  std::map<std::vector<const void *>, std::weak_ptr<RuntimeContext>> contexts;
+  // Contexts kept alive on behalf of prefetching sessions.
+  std::map<std::vector<const void *>, std::shared_ptr<RuntimeContext>>
+      prefetched;
+};
+
 } // namespace concretelang
 } // namespace mlir
 
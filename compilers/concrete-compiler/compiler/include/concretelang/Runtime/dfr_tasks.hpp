@@ -20,33 +20,273 @@ typedef struct dfr_refcounted_future {
       : future(f), count(c), cloned_memref_p(clone_p) {}
 } dfr_refcounted_future_t, *dfr_refcounted_future_p;
 
-// Determine where new task should run.  For now just round-robin
-// distribution - TODO: optimise.
+// A task output that becomes available chunk by chunk. A batched work
+// function producing a large tensor fulfills one promise per chunk as
+// it is finalized; each chunk is exposed as a regular refcounted
+// future, so a consumer that only needs one chunk declares it as an
+// ordinary task dependency and starts before the whole tensor is done.
+// A chunk future resolves to a producer-allocated descriptor of its
+// chunk and owns it, following the usual future memory management.
+typedef struct dfr_chunked_future {
+  std::vector<hpx::promise<void *>> promises;
+  std::vector<dfr_refcounted_future_p> chunks;
+  dfr_chunked_future(size_t num_chunks) : promises(num_chunks) {
+    chunks.reserve(num_chunks);
+    for (auto &promise : promises)
+      chunks.push_back(new dfr_refcounted_future_t(
+          new hpx::shared_future<void *>(promise.get_future()), 1, false));
+  }
+} dfr_chunked_future_t, *dfr_chunked_future_p;
+
+// Placement state: in-flight task counts per locality, decremented when a
+// task's outputs become available on the root node.
+namespace {
+static std::unique_ptr<std::atomic<std::size_t>[]> locality_inflight_tasks;
+static size_t key_imbalance_threshold = 4;
+static std::once_flag placement_init_flag;
+} // namespace
+
+static inline void dfr_placement_init() {
+  std::call_once(placement_init_flag, []() {
+    locality_inflight_tasks.reset(new std::atomic<std::size_t>[num_nodes]());
+    char *env = getenv("DFR_KEY_IMBALANCE_THRESHOLD");
+    if (env != nullptr)
+      key_imbalance_threshold = strtoul(env, NULL, 10);
+  });
+}
+
+// Determine where a new task should run. Tasks go to the least loaded
+// locality among those that already hold the evaluation keys: until the
+// runtime context has been broadcast only the root holds them, and
+// placing a key-dependent task elsewhere forces the keys across the
+// wire. A non-resident locality is only chosen when the load imbalance
+// exceeds a threshold of in-flight tasks (DFR_KEY_IMBALANCE_THRESHOLD,
+// default 4), at which point the transfer is paid to rebalance. The scan
+// origin rotates so equally loaded localities are still used
+// round-robin.
 static inline size_t dfr_get_next_execution_locality() {
   static std::atomic<std::size_t> next_locality{1};
 
-  size_t next_loc = next_locality.fetch_add(1);
+  if (num_nodes < 2)
+    return 0;
+  dfr_placement_init();
 
-  return next_loc % num_nodes;
+  bool keys_everywhere =
+      _dfr_node_level_runtime_context_manager == nullptr ||
+      _dfr_node_level_runtime_context_manager->keysBroadcast();
+  size_t start = next_locality.fetch_add(1);
+  size_t best = 0;
+  size_t best_load = SIZE_MAX;
+  size_t best_resident = SIZE_MAX;
+  size_t best_resident_load = SIZE_MAX;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    size_t loc = (start + i) % num_nodes;
+    size_t load = locality_inflight_tasks[loc];
+    if (load < best_load) {
+      best = loc;
+      best_load = load;
+    }
+    bool resident = keys_everywhere || loc == 0;
+    if (resident && load < best_resident_load) {
+      best_resident = loc;
+      best_resident_load = load;
+    }
+  }
+  size_t choice = best;
+  if (best_resident != SIZE_MAX &&
+      best_resident_load <= best_load + key_imbalance_threshold)
+    choice = best_resident;
+  locality_inflight_tasks[choice].fetch_add(1);
+  return choice;
 }
 
-void dfr_create_async_task_impl(wfnptr wfn, void *ctx,
-                                std::vector<void *> &refcounted_futures,
-                                std::vector<size_t> &param_sizes,
-                                std::vector<uint64_t> &param_types,
-                                std::vector<void *> &outputs,
-                                std::vector<size_t> &output_sizes,
-                                std::vector<uint64_t> &output_types) {
+static inline void dfr_task_completed(size_t loc) {
+  if (num_nodes > 1 && locality_inflight_tasks != nullptr)
+    locality_inflight_tasks[loc].fetch_sub(1);
+}
+
+// Work aggregation state: when the BatchingPass cannot prove
+// batchability statically, the task graph still contains many identical
+// tasks (same work function, same runtime context and therefore same
+// evaluation keys). Executing those back-to-back on the same worker
+// recovers most of the missed batching at runtime: keys, lookup tables
+// and FFT plans stay hot instead of being faulted into a different
+// cache for every task.
+namespace {
+struct dfr_aggregation_group {
+  size_t loc;
+  std::int16_t worker;
+  size_t count;
+};
+static std::mutex aggregation_mutex;
+static std::map<std::pair<const void *, const void *>, dfr_aggregation_group>
+    aggregation_groups;
+static size_t aggregation_window = 64;
+} // namespace
+
+static inline void dfr_aggregation_init() {
+  static std::once_flag flag;
+  std::call_once(flag, []() {
+    char *env = getenv("DFR_TASK_AGGREGATION_WINDOW");
+    if (env != nullptr)
+      aggregation_window = strtoul(env, NULL, 10);
+  });
+}
+
+// Scheduling slot (locality, worker hint) for a task. Tasks sharing a
+// work function and runtime context are pinned to the same worker of
+// the same locality for up to DFR_TASK_AGGREGATION_WINDOW tasks
+// (default 64, 1 disables aggregation), after which a fresh slot is
+// picked so a large group still spreads over the machine.
+static inline std::pair<size_t, std::int16_t>
+dfr_get_aggregated_execution_slot(wfnptr wfn, void *ctx) {
+  dfr_aggregation_init();
+  if (aggregation_window <= 1)
+    return {dfr_get_next_execution_locality(), (std::int16_t)-1};
+
+  const std::lock_guard<std::mutex> guard(aggregation_mutex);
+  auto key = std::make_pair((const void *)wfn, (const void *)ctx);
+  auto group = aggregation_groups.find(key);
+  if (group != aggregation_groups.end() &&
+      group->second.count < aggregation_window) {
+    group->second.count++;
+    if (num_nodes > 1 && locality_inflight_tasks != nullptr)
+      locality_inflight_tasks[group->second.loc].fetch_add(1);
+    return {group->second.loc, group->second.worker};
+  }
+  static std::atomic<unsigned> next_worker{0};
+  size_t loc = dfr_get_next_execution_locality();
+  std::int16_t worker =
+      (std::int16_t)(next_worker.fetch_add(1) % hpx::get_num_worker_threads());
+  aggregation_groups[key] = {loc, worker, 1};
+  return {loc, worker};
+}
+
+// Task template: the metadata of a task that is invariant across
+// invocations of a circuit, namely the work function, the registry name
+// under which it is shipped to remote localities and the sizes and
+// types of its arguments and outputs. Every call site in generated code issues
+// the same template on every invocation, only the futures it binds
+// change, so the first task issued for a work function records its
+// template and subsequent tasks instantiate it, skipping the per-task
+// rebuild of this metadata (in particular the registry name lookup).
+// DFR_TASK_TEMPLATES=0 disables the cache.
+struct dfr_task_template {
+  wfnptr wfn;
+  std::string wfnname;
+  std::vector<size_t> param_sizes;
+  std::vector<uint64_t> param_types;
+  std::vector<size_t> output_sizes;
+  std::vector<uint64_t> output_types;
+};
+namespace {
+static std::mutex task_template_mutex;
+static std::map<const void *, std::shared_ptr<const dfr_task_template>>
+    task_templates;
+} // namespace
+
+static inline bool dfr_use_task_templates() {
+  static bool use_p = []() {
+    char *env = getenv("DFR_TASK_TEMPLATES");
+    return env == nullptr || strtoul(env, NULL, 10) != 0;
+  }();
+  return use_p;
+}
+
+// Returns the recorded template for a work function, or nullptr when no
+// task has been issued for it yet (or the cache is disabled).
+static inline std::shared_ptr<const dfr_task_template>
+dfr_lookup_task_template(wfnptr wfn) {
+  if (!dfr_use_task_templates())
+    return nullptr;
+  const std::lock_guard<std::mutex> guard(task_template_mutex);
+  auto tmpl = task_templates.find((const void *)wfn);
+  if (tmpl == task_templates.end())
+    return nullptr;
+  return tmpl->second;
+}
+
+// Wave-batched task release (enabled with DFR_WAVE_SCHEDULING=1): tasks
+// annotated with the same topological wave are gated behind one shared
+// future and released together when the first task of a later wave is
+// issued. Task creation follows program order, so waves arrive
+// monotonically within an invocation; the scheduler then sees the whole
+// breadth of a wave at once instead of discovering its parallelism one
+// future at a time, and aggregation groups can form over complete
+// waves.
+namespace {
+static std::mutex wave_gate_mutex;
+static uint64_t current_wave = 0;
+static hpx::promise<void *> *wave_gate = nullptr;
+static hpx::shared_future<void *> wave_gate_future;
+} // namespace
+
+static inline bool dfr_use_wave_scheduling() {
+  static bool use_p = []() {
+    char *env = getenv("DFR_WAVE_SCHEDULING");
+    return env != nullptr && strtoul(env, NULL, 10) != 0;
+  }();
+  return use_p;
+}
+
+// Releases the gate of the pending wave. Called when a later wave
+// starts and at every synchronization point (awaiting a future,
+// stopping the runtime), so no task stays gated once its results are
+// needed. A synchronization point also ends the invocation's wave
+// sequence: waves restart from zero on the next invocation, so the
+// counter is rewound with the gate (otherwise every later task would
+// compare below the stale wave and never be gated again).
+void dfr_flush_wave_gates() {
+  if (!dfr_use_wave_scheduling())
+    return;
+  const std::lock_guard<std::mutex> guard(wave_gate_mutex);
+  if (wave_gate != nullptr) {
+    wave_gate->set_value(nullptr);
+    delete wave_gate;
+    wave_gate = nullptr;
+  }
+  current_wave = 0;
+}
+
+// Returns the gate future the body of a task of `wave` must wait on,
+// releasing completed earlier waves first. Tasks arriving out of order
+// (e.g. from a concurrent invocation) are not gated.
+static inline std::optional<hpx::shared_future<void *>>
+dfr_enter_wave(uint64_t wave) {
+  if (!dfr_use_wave_scheduling())
+    return std::nullopt;
+  const std::lock_guard<std::mutex> guard(wave_gate_mutex);
+  if (wave < current_wave)
+    return std::nullopt;
+  if (wave > current_wave) {
+    if (wave_gate != nullptr) {
+      wave_gate->set_value(nullptr);
+      delete wave_gate;
+      wave_gate = nullptr;
+    }
+    current_wave = wave;
+  }
+  if (wave_gate == nullptr) {
+    wave_gate = new hpx::promise<void *>();
+    wave_gate_future = hpx::shared_future<void *>(wave_gate->get_future());
+  }
+  return wave_gate_future;
+}
+
+void dfr_instantiate_task_template(
+    std::shared_ptr<const dfr_task_template> tmpl, void *ctx,
+    uint64_t priority, std::vector<void *> &refcounted_futures,
+    std::vector<void *> &outputs) {
   // Take a reference on each future argument
   for (auto rcf : refcounted_futures)
     ((dfr_refcounted_future_p)rcf)->count.fetch_add(1);
 
-  // We pass functions by name - which is not strictly necessary in
-  // shared memory as pointers suffice, but is needed in the
-  // distributed case where the functions need to be located/loaded on
-  // the node.
-  auto wfnname =
-      _dfr_node_level_work_function_registry->getWorkFunctionName((void *)wfn);
+  // The priority word carries both the scheduling share and the
+  // topological wave of the task (see DFRuntime.hpp).
+  uint64_t wave = _dfr_get_task_wave(priority);
+  priority = _dfr_get_task_priority(priority);
+
+  wfnptr wfn = tmpl->wfn;
   hpx::future<hpx::future<OpaqueOutputData>> oodf;
 
   // In order to allow complete dataflow semantics for
@@ -55,38 +295,84 @@ void dfr_create_async_task_impl(wfnptr wfn, void *ctx,
   // satisfied, which generates a future on a tuple of outputs, which
   // is then further split into a tuple of futures and provide
   // individual synchronization for each return independently.
-  GenericComputeClient *gcc_target = &gcc[dfr_get_next_execution_locality()];
-  switch (refcounted_futures.size()) {
-
-#include "concretelang/Runtime/generated/dfr_dataflow_inputs_cases.h"
-
-  default:
-    HPX_THROW_EXCEPTION(hpx::no_success, "_dfr_create_async_task",
-                        "Error: number of task parameters not supported.");
-  }
+  auto slot = dfr_get_aggregated_execution_slot(wfn, ctx);
+  size_t target_loc = slot.first;
+  GenericComputeClient *gcc_target = &gcc[target_loc];
+  // Issue the task body through a single dataflow on the conjunction of
+  // its parameter futures. This replaces the generated per-arity switch
+  // (dfr_dataflow_inputs_cases.h): issuing a task no longer runs a case
+  // analysis over the number of inputs, and any arity is supported.
+  std::vector<hpx::shared_future<void *>> param_futures;
+  param_futures.reserve(refcounted_futures.size());
+  for (auto rcf : refcounted_futures)
+    param_futures.push_back(*((dfr_refcounted_future_p)rcf)->future);
+  // Gate the body on its wave, so the whole wave becomes ready at once
+  // when the gate is released (see dfr_enter_wave).
+  if (auto gate = dfr_enter_wave(wave))
+    param_futures.push_back(*gate);
+  // Launch the task body with a scheduler priority derived from its
+  // critical-path share (0-100 of the entry point's longest dependency
+  // chain, see LowerDataflowTasksToRT.cpp): the scheduler only offers a
+  // few discrete levels, so tasks on the upper half of the critical
+  // path jump the ready queues ahead of off-path work instead of being
+  // launched in FIFO order. The schedule hint pins the bodies of an
+  // aggregation group to one worker so they run back-to-back.
+  hpx::launch::async_policy launch_policy(
+      priority >= 50 ? hpx::threads::thread_priority::high
+                     : hpx::threads::thread_priority::normal,
+      hpx::threads::thread_stacksize::default_,
+      slot.second >= 0 ? hpx::threads::thread_schedule_hint(slot.second)
+                       : hpx::threads::thread_schedule_hint());
+  oodf = std::move(hpx::dataflow(
+      launch_policy,
+      [tmpl, gcc_target, ctx, numParams = refcounted_futures.size()](
+          hpx::future<std::vector<hpx::shared_future<void *>>> ready)
+          -> hpx::future<mlir::concretelang::dfr::OpaqueOutputData> {
+        std::vector<hpx::shared_future<void *>> futures = ready.get();
+        // The dependency set may carry a trailing wave gate (see
+        // dfr_enter_wave); it only delays readiness and its value is
+        // not a task parameter.
+        std::vector<void *> params;
+        params.reserve(numParams);
+        for (size_t i = 0; i < numParams; i++)
+          params.push_back(futures[i].get());
+        mlir::concretelang::dfr::OpaqueInputData oid(
+            tmpl->wfnname, params, tmpl->param_sizes, tmpl->param_types,
+            tmpl->output_sizes, tmpl->output_types, ctx);
+        // On a single locality, execute the work function inline: going
+        // through the component action would re-schedule the body on an
+        // arbitrary worker and defeat the aggregation pinning.
+        if (num_nodes == 1)
+          return hpx::make_ready_future(
+              GenericComputeServer().execute_task(oid));
+        return gcc_target->execute_task(oid);
+      },
+      hpx::when_all(std::move(param_futures))));
 
   switch (outputs.size()) {
   case 1:
     *((void **)outputs[0]) = (void *)new dfr_refcounted_future_t(
         new hpx::shared_future<void *>(hpx::dataflow(
-            [refcounted_futures](
+            [refcounted_futures, target_loc](
                 hpx::future<OpaqueOutputData> oodf_in) -> void * {
               void *ret = oodf_in.get().outputs[0];
               for (auto rcf : refcounted_futures)
                 _dfr_deallocate_future(rcf);
+              dfr_task_completed(target_loc);
               return ret;
             },
             oodf)),
-        1, output_types[0] == _DFR_TASK_ARG_MEMREF);
+        1, tmpl->output_types[0] == _DFR_TASK_ARG_MEMREF);
     break;
 
   case 2: {
     hpx::future<hpx::tuple<void *, void *>> &&ft = hpx::dataflow(
-        [refcounted_futures](hpx::future<OpaqueOutputData> oodf_in)
+        [refcounted_futures, target_loc](hpx::future<OpaqueOutputData> oodf_in)
             -> hpx::tuple<void *, void *> {
           std::vector<void *> outputs = std::move(oodf_in.get().outputs);
           for (auto rcf : refcounted_futures)
             _dfr_deallocate_future(rcf);
+          dfr_task_completed(target_loc);
           return hpx::make_tuple<>(outputs[0], outputs[1]);
         },
         oodf);
@@ -94,20 +380,21 @@ void dfr_create_async_task_impl(wfnptr wfn, void *ctx,
         hpx::split_future(std::move(ft));
     *((void **)outputs[0]) = (void *)new dfr_refcounted_future_t(
         new hpx::shared_future<void *>(std::move(hpx::get<0>(tf))), 1,
-        output_types[0] == _DFR_TASK_ARG_MEMREF);
+        tmpl->output_types[0] == _DFR_TASK_ARG_MEMREF);
     *((void **)outputs[1]) = (void *)new dfr_refcounted_future_t(
         new hpx::shared_future<void *>(std::move(hpx::get<1>(tf))), 1,
-        output_types[1] == _DFR_TASK_ARG_MEMREF);
+        tmpl->output_types[1] == _DFR_TASK_ARG_MEMREF);
     break;
   }
 
   case 3: {
     hpx::future<hpx::tuple<void *, void *, void *>> &&ft = hpx::dataflow(
-        [refcounted_futures](hpx::future<OpaqueOutputData> oodf_in)
+        [refcounted_futures, target_loc](hpx::future<OpaqueOutputData> oodf_in)
             -> hpx::tuple<void *, void *, void *> {
           std::vector<void *> outputs = std::move(oodf_in.get().outputs);
           for (auto rcf : refcounted_futures)
             _dfr_deallocate_future(rcf);
+          dfr_task_completed(target_loc);
           return hpx::make_tuple<>(outputs[0], outputs[1], outputs[2]);
         },
         oodf);
@@ -115,13 +402,13 @@ void dfr_create_async_task_impl(wfnptr wfn, void *ctx,
         &&tf = hpx::split_future(std::move(ft));
     *((void **)outputs[0]) = (void *)new dfr_refcounted_future_t(
         new hpx::shared_future<void *>(std::move(hpx::get<0>(tf))), 1,
-        output_types[0] == _DFR_TASK_ARG_MEMREF);
+        tmpl->output_types[0] == _DFR_TASK_ARG_MEMREF);
     *((void **)outputs[1]) = (void *)new dfr_refcounted_future_t(
         new hpx::shared_future<void *>(std::move(hpx::get<1>(tf))), 1,
-        output_types[1] == _DFR_TASK_ARG_MEMREF);
+        tmpl->output_types[1] == _DFR_TASK_ARG_MEMREF);
     *((void **)outputs[2]) = (void *)new dfr_refcounted_future_t(
         new hpx::shared_future<void *>(std::move(hpx::get<2>(tf))), 1,
-        output_types[2] == _DFR_TASK_ARG_MEMREF);
+        tmpl->output_types[2] == _DFR_TASK_ARG_MEMREF);
     break;
   }
 
@@ -131,6 +418,32 @@ void dfr_create_async_task_impl(wfnptr wfn, void *ctx,
   }
 }
 
+// Cold path: build the template for this work function, record it for
+// later invocations and instantiate it.
+void dfr_create_async_task_impl(wfnptr wfn, void *ctx, uint64_t priority,
+                                std::vector<void *> &refcounted_futures,
+                                std::vector<size_t> &param_sizes,
+                                std::vector<uint64_t> &param_types,
+                                std::vector<void *> &outputs,
+                                std::vector<size_t> &output_sizes,
+                                std::vector<uint64_t> &output_types) {
+  // We pass functions by name - which is not strictly necessary in
+  // shared memory as pointers suffice, but is needed in the
+  // distributed case where the functions need to be located/loaded on
+  // the node.
+  auto wfnname =
+      _dfr_node_level_work_function_registry->getWorkFunctionName((void *)wfn);
+  auto tmpl = std::make_shared<const dfr_task_template>(dfr_task_template{
+      wfn, std::move(wfnname), std::move(param_sizes), std::move(param_types),
+      std::move(output_sizes), std::move(output_types)});
+  if (dfr_use_task_templates()) {
+    const std::lock_guard<std::mutex> guard(task_template_mutex);
+    task_templates.emplace((const void *)wfn, tmpl);
+  }
+  dfr_instantiate_task_template(std::move(tmpl), ctx, priority,
+                                refcounted_futures, outputs);
+}
+
 } // namespace dfr
 } // namespace concretelang
 } // namespace mlir
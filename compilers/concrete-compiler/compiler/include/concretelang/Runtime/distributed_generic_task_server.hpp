@@ -9,6 +9,8 @@
 #include <cstdarg>
 #include <cstdlib>
 #include <malloc.h>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include <hpx/async_colocated/get_colocation_id.hpp>
@@ -21,6 +23,7 @@
 #include <hpx/serialization/detail/serialize_collection.hpp>
 #include <hpx/serialization/serialization_fwd.hpp>
 #include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/serialize_buffer.hpp>
 
 #include <hpx/async_colocated/get_colocation_id.hpp>
 #include <hpx/include/client.hpp>
@@ -62,6 +65,47 @@ static inline void _dfr_checked_aligned_alloc(void **out, size_t align,
                         "Error: invalid memory alignment.");
 }
 
+/// Allocator used for received payload buffers: work functions assume
+/// the same 512-byte alignment as the regular allocation path.
+template <typename T> struct dfr_payload_allocator {
+  typedef T value_type;
+  dfr_payload_allocator() = default;
+  template <typename U>
+  dfr_payload_allocator(const dfr_payload_allocator<U> &) {}
+  T *allocate(size_t n) {
+    void *p;
+    _dfr_checked_aligned_alloc(&p, 512, n * sizeof(T));
+    return static_cast<T *>(p);
+  }
+  void deallocate(T *p, size_t) { free(p); }
+};
+
+/// Ciphertext payloads (memref data) are shipped between localities as
+/// serialize_buffer chunks, which the parcelport transfers out-of-band
+/// instead of copying them through the archive. A received buffer is
+/// owned by its serialize_buffer; the registry keeps it alive until the
+/// consumer releases it, replacing the free() of the copying path.
+typedef hpx::serialization::serialize_buffer<char, dfr_payload_allocator<char>>
+    dfr_payload_buffer_t;
+
+namespace {
+static std::mutex payload_registry_mutex;
+static std::map<void *, dfr_payload_buffer_t> payload_registry;
+} // namespace
+
+static inline void dfr_register_payload_buffer(void *data,
+                                               dfr_payload_buffer_t &buf) {
+  const std::lock_guard<std::mutex> guard(payload_registry_mutex);
+  payload_registry.emplace(data, buf);
+}
+
+/// Returns false when `data` is not a registered payload buffer and the
+/// caller must deallocate it itself.
+static inline bool dfr_release_payload_buffer(void *data) {
+  const std::lock_guard<std::mutex> guard(payload_registry_mutex);
+  return payload_registry.erase(data) != 0;
+}
+
 struct OpaqueInputData {
   OpaqueInputData() = default;
 
@@ -103,20 +147,20 @@ struct OpaqueInputData {
       case _DFR_TASK_ARG_BASE:
         break;
       case _DFR_TASK_ARG_MEMREF: {
-        size_t rank = _dfr_get_memref_rank(param_sizes[p]);
-        UnrankedMemRefType<char> umref = {(int64_t)rank, params[p]};
-        DynamicMemRefType<char> mref(umref);
-        size_t elementSize = _dfr_get_memref_element_size(param_types[p]);
-        size_t size = 1;
-        for (size_t r = 0; r < rank; ++r)
-          size *= mref.sizes[r];
-        size_t alloc_size = (size + mref.offset) * elementSize;
-        char *data;
-        _dfr_checked_aligned_alloc((void **)&data, 512, alloc_size);
-        ar >> hpx::serialization::make_array(data + mref.offset * elementSize,
-                                             size * elementSize);
-        static_cast<StridedMemRefType<char, 1> *>(params[p])->basePtr = nullptr;
-        static_cast<StridedMemRefType<char, 1> *>(params[p])->data = data;
+        // The payload lands directly in the buffer's 512-byte aligned
+        // allocation; the registry keeps it alive until released.
+        dfr_payload_buffer_t buf;
+        ar >> buf;
+        // The payload starts at the source memref's first element, so
+        // the rebuilt descriptor addresses it with a zero offset:
+        // subtracting the original offset from buf.data() would form a
+        // pointer outside the allocation.
+        char *data = buf.data();
+        dfr_register_payload_buffer(data, buf);
+        auto *desc = static_cast<StridedMemRefType<char, 1> *>(params[p]);
+        desc->basePtr = nullptr;
+        desc->data = data;
+        desc->offset = 0;
       } break;
       default:
         HPX_THROW_EXCEPTION(hpx::no_success, "DFR: OpaqueInputData save",
@@ -148,8 +192,13 @@ struct OpaqueInputData {
         size_t size = 1;
         for (size_t r = 0; r < rank; ++r)
           size *= mref.sizes[r];
-        ar << hpx::serialization::make_array(
-            mref.data + mref.offset * elementSize, size * elementSize);
+        // Reference-mode buffer: the parcelport ships the payload as a
+        // zero-copy chunk and the input futures keep the data alive
+        // until the task completes.
+        dfr_payload_buffer_t buf(mref.data + mref.offset * elementSize,
+                                 size * elementSize,
+                                 dfr_payload_buffer_t::reference);
+        ar << buf;
       } break;
       default:
         HPX_THROW_EXCEPTION(hpx::no_success, "DFR: OpaqueInputData save",
@@ -195,21 +244,17 @@ struct OpaqueOutputData {
       case _DFR_TASK_ARG_BASE:
         break;
       case _DFR_TASK_ARG_MEMREF: {
-        size_t rank = _dfr_get_memref_rank(output_sizes[p]);
-        UnrankedMemRefType<char> umref = {(int64_t)rank, outputs[p]};
-        DynamicMemRefType<char> mref(umref);
-        size_t elementSize = _dfr_get_memref_element_size(output_types[p]);
-        size_t size = 1;
-        for (size_t r = 0; r < rank; ++r)
-          size *= mref.sizes[r];
-        size_t alloc_size = (size + mref.offset) * elementSize;
-        char *data;
-        _dfr_checked_aligned_alloc((void **)&data, 512, alloc_size);
-        ar >> hpx::serialization::make_array(data + mref.offset * elementSize,
-                                             size * elementSize);
-        static_cast<StridedMemRefType<char, 1> *>(outputs[p])->basePtr =
-            nullptr;
-        static_cast<StridedMemRefType<char, 1> *>(outputs[p])->data = data;
+        dfr_payload_buffer_t buf;
+        ar >> buf;
+        // As for input memrefs: the payload is the element data itself,
+        // address it from its base with a zero offset rather than
+        // synthesizing a pre-allocation pointer.
+        char *data = buf.data();
+        dfr_register_payload_buffer(data, buf);
+        auto *desc = static_cast<StridedMemRefType<char, 1> *>(outputs[p]);
+        desc->basePtr = nullptr;
+        desc->data = data;
+        desc->offset = 0;
       } break;
       default:
         HPX_THROW_EXCEPTION(hpx::no_success, "DFR: OpaqueInputData save",
@@ -234,8 +279,10 @@ struct OpaqueOutputData {
         size_t size = 1;
         for (size_t r = 0; r < rank; ++r)
           size *= mref.sizes[r];
-        ar << hpx::serialization::make_array(
-            mref.data + mref.offset * elementSize, size * elementSize);
+        dfr_payload_buffer_t buf(mref.data + mref.offset * elementSize,
+                                 size * elementSize,
+                                 dfr_payload_buffer_t::reference);
+        ar << buf;
       } break;
       default:
         HPX_THROW_EXCEPTION(hpx::no_success, "DFR: OpaqueInputData save",
@@ -271,9 +318,13 @@ struct GenericComputeServer : component_base<GenericComputeServer> {
     // Deallocate input data buffers from OID deserialization (load)
     if (!_dfr_is_root_node()) {
       for (size_t p = 0; p < inputs.param_sizes.size(); ++p) {
-        if (_dfr_get_arg_type(inputs.param_types[p]) == _DFR_TASK_ARG_MEMREF)
-          delete (static_cast<StridedMemRefType<char, 1> *>(inputs.params[p])
-                      ->data);
+        if (_dfr_get_arg_type(inputs.param_types[p]) == _DFR_TASK_ARG_MEMREF) {
+          char *data =
+              static_cast<StridedMemRefType<char, 1> *>(inputs.params[p])
+                  ->data;
+          if (!dfr_release_payload_buffer(data))
+            delete (data);
+        }
         delete ((char *)inputs.params[p]);
       }
     }
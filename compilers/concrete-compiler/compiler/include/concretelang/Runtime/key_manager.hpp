@@ -6,9 +6,13 @@
 #ifndef CONCRETELANG_DFR_KEY_MANAGER_HPP
 #define CONCRETELANG_DFR_KEY_MANAGER_HPP
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <string>
 #include <utility>
 
 #include <hpx/include/runtime.hpp>
@@ -87,6 +91,227 @@ bool operator==(const KeyWrapper<LweKeyType, KeyParamType> &lhs,
   return true;
 }
 
+/*********************************/
+/* Chunked key broadcast.        */
+/*********************************/
+
+namespace {
+/// Number of 64-bit words per key broadcast chunk (32 MiB). Keys are
+/// streamed chunk by chunk instead of as one message serializing the whole
+/// buffer, so remotes copy earlier chunks into place while later ones are
+/// still in flight.
+constexpr size_t key_broadcast_chunk_words = (32 << 20) / sizeof(uint64_t);
+} // namespace
+
+/// One in-flight slice of a key buffer. The sender serializes a non-owning
+/// view of the key words; the receiver deserializes into its own storage.
+struct KeyChunk {
+  const uint64_t *data = nullptr;
+  size_t size = 0;
+  std::vector<uint64_t> storage;
+
+  friend class hpx::serialization::access;
+  template <class Archive>
+  void save(Archive &ar, const unsigned int version) const {
+    ar << size;
+    ar << hpx::serialization::make_array(data, size);
+  }
+  template <class Archive> void load(Archive &ar, const unsigned int version) {
+    ar >> size;
+    storage.resize(size);
+    ar >> hpx::serialization::make_array(storage.data(), size);
+    data = storage.data();
+  }
+  HPX_SERIALIZATION_SPLIT_MEMBER()
+};
+
+/// Parameters and sizes of a key set, broadcast ahead of the chunks so
+/// receivers can allocate the destination buffers up front.
+template <typename KeyParamType> struct KeyMetadata {
+  std::vector<KeyParamType> params;
+  std::vector<size_t> sizes;
+
+  friend class hpx::serialization::access;
+  template <class Archive>
+  void save(Archive &ar, const unsigned int version) const {
+    ar << (size_t)params.size();
+    for (size_t i = 0; i < params.size(); ++i) {
+      ar << hpx::serialization::make_array((const char *)&params[i],
+                                           sizeof(KeyParamType));
+      ar << sizes[i];
+    }
+  }
+  template <class Archive> void load(Archive &ar, const unsigned int version) {
+    size_t num_keys;
+    ar >> num_keys;
+    params.resize(num_keys);
+    sizes.resize(num_keys);
+    for (size_t i = 0; i < num_keys; ++i) {
+      ar >> hpx::serialization::make_array((char *)&params[i],
+                                           sizeof(KeyParamType));
+      ar >> sizes[i];
+    }
+  }
+  HPX_SERIALIZATION_SPLIT_MEMBER()
+};
+
+/// Root side of the chunked broadcast: post the metadata, then every chunk
+/// of every key. All chunk broadcasts are in flight at once, the HPX
+/// collective fans each one out to all localities in parallel.
+template <typename LweKeyType, typename KeyParamType>
+void broadcastKeys(std::string basename, const std::vector<LweKeyType> &keys) {
+  KeyMetadata<KeyParamType> metadata;
+  for (auto &key : keys) {
+    metadata.params.push_back(key.parameters());
+    metadata.sizes.push_back(key.size());
+  }
+  hpx::collectives::broadcast_to((basename + "_md").c_str(), metadata);
+  std::vector<hpx::future<KeyChunk>> pending;
+  size_t chunk_index = 0;
+  for (auto &key : keys) {
+    for (size_t offset = 0; offset < key.size();
+         offset += key_broadcast_chunk_words) {
+      KeyChunk chunk;
+      chunk.data = key.buffer() + offset;
+      chunk.size = std::min(key_broadcast_chunk_words, key.size() - offset);
+      pending.push_back(hpx::collectives::broadcast_to(
+          (basename + "_chunk" + std::to_string(chunk_index++)).c_str(),
+          chunk));
+    }
+  }
+  // The chunks view the key buffers of the caller, wait for the sends
+  // before returning.
+  hpx::wait_all(pending);
+}
+
+/// Remote side of the chunked broadcast: all chunk receives are posted as
+/// soon as the metadata arrives, so deserialization and assembly of early
+/// chunks overlap the transfer of later ones.
+template <typename LweKeyType, typename KeyParamType>
+std::vector<LweKeyType> receiveKeys(std::string basename) {
+  auto metadata = hpx::collectives::broadcast_from<KeyMetadata<KeyParamType>>(
+                      (basename + "_md").c_str())
+                      .get();
+  std::vector<hpx::future<KeyChunk>> chunks;
+  size_t chunk_index = 0;
+  for (auto size : metadata.sizes)
+    for (size_t offset = 0; offset < size; offset += key_broadcast_chunk_words)
+      chunks.push_back(hpx::collectives::broadcast_from<KeyChunk>(
+          (basename + "_chunk" + std::to_string(chunk_index++)).c_str()));
+  std::vector<LweKeyType> keys;
+  chunk_index = 0;
+  for (size_t i = 0; i < metadata.sizes.size(); ++i) {
+    auto buffer = std::make_shared<std::vector<uint64_t>>();
+    buffer->resize(metadata.sizes[i]);
+    for (size_t offset = 0; offset < metadata.sizes[i];
+         offset += key_broadcast_chunk_words) {
+      KeyChunk chunk = chunks[chunk_index++].get();
+      memcpy(buffer->data() + offset, chunk.data,
+             chunk.size * sizeof(uint64_t));
+    }
+    keys.push_back(LweKeyType(buffer, metadata.params[i]));
+  }
+  return keys;
+}
+
+/*********************************/
+/* Sharded key residency.        */
+/*********************************/
+
+// The phase cache below replicates every key on every locality, which
+// multiplies the key material by the number of localities and exceeds
+// single-node memory for large multi-tenant WoP circuits. With
+// DFR_KEY_SHARDING=ON each remote locality only keeps the cached keys it
+// owns resident between phases -- ownership is partitioned round-robin
+// over the localities -- and spills the rest to node-local storage
+// (DFR_KEY_SPILL_DIR, default /tmp). When the next phase reuses the
+// keys, the spilled shards of the two keystores stream back from local
+// storage concurrently. The root keeps its cache fully resident: it is
+// the reference copy the reuse check compares against.
+
+static inline bool dfr_key_sharding() {
+  static bool enabled = []() {
+    char *env = getenv("DFR_KEY_SHARDING");
+    return env != nullptr &&
+           (strcmp(env, "ON") == 0 || strcmp(env, "1") == 0);
+  }();
+  return enabled;
+}
+
+static inline std::string dfr_key_spill_path(const char *name) {
+  char *env = getenv("DFR_KEY_SPILL_DIR");
+  std::string dir = env != nullptr ? env : "/tmp";
+  return dir + "/" + name + "_loc" +
+         std::to_string(hpx::get_locality_id()) + ".spill";
+}
+
+// A locality owns every num_localities-th key of each keystore.
+static inline bool dfr_owns_key(size_t index) {
+  size_t localities = hpx::get_num_localities(hpx::launch::sync);
+  return index % localities == hpx::get_locality_id();
+}
+
+/// Writes the non-owned keys of `kw` to node-local storage and replaces
+/// them with empty placeholders, keeping only the owned shard resident.
+/// Returns false when no spill storage is available or the spill file
+/// cannot be fully written, in which case the keys stay resident.
+template <typename LweKeyType, typename KeyParamType>
+bool dfr_spill_keys(KeyWrapper<LweKeyType, KeyParamType> &kw,
+                    const char *name) {
+  std::string path = dfr_key_spill_path(name);
+  FILE *file = fopen(path.c_str(), "w");
+  if (file == nullptr)
+    return false;
+  // A short write (e.g. spill storage full) must not leave a truncated
+  // file behind: it would be reloaded as key material. Abort the spill
+  // and keep the keys in memory instead.
+  bool written = true;
+  for (size_t i = 0; written && i < kw.keys.size(); ++i) {
+    if (dfr_owns_key(i))
+      continue;
+    auto &key = kw.keys[i];
+    KeyParamType params = key.parameters();
+    size_t size = key.size();
+    written = fwrite(&i, sizeof(i), 1, file) == 1 &&
+              fwrite(&params, sizeof(params), 1, file) == 1 &&
+              fwrite(&size, sizeof(size), 1, file) == 1 &&
+              fwrite(key.buffer(), sizeof(uint64_t), size, file) == size;
+  }
+  written = fclose(file) == 0 && written;
+  if (!written) {
+    remove(path.c_str());
+    return false;
+  }
+  for (size_t i = 0; i < kw.keys.size(); ++i)
+    if (!dfr_owns_key(i))
+      kw.keys[i] = LweKeyType(std::make_shared<std::vector<uint64_t>>(),
+                              kw.keys[i].parameters());
+  return true;
+}
+
+/// Reloads the keys spilled by dfr_spill_keys back into `kw`.
+template <typename LweKeyType, typename KeyParamType>
+void dfr_reload_keys(KeyWrapper<LweKeyType, KeyParamType> &kw,
+                     const char *name) {
+  FILE *file = fopen(dfr_key_spill_path(name).c_str(), "r");
+  if (file == nullptr)
+    return;
+  size_t index;
+  while (fread(&index, sizeof(index), 1, file) == 1) {
+    KeyParamType params;
+    size_t size;
+    if (fread(&params, sizeof(params), 1, file) != 1 ||
+        fread(&size, sizeof(size), 1, file) != 1)
+      break;
+    auto buffer = std::make_shared<std::vector<uint64_t>>();
+    buffer->resize(size);
+    if (fread(buffer->data(), sizeof(uint64_t), size, file) != size)
+      break;
+    kw.keys[index] = LweKeyType(buffer, params);
+  }
+  fclose(file);
+}
+
 /************************/
 /* Context management.  */
 /************************/
@@ -95,6 +320,17 @@ struct RuntimeContextManager {
   // TODO: this is only ok so long as we don't change keys. Once we
   // use multiple keys, should have a map.
   RuntimeContext *context;
+  // Keys broadcast in an earlier computation phase, kept across
+  // clearContext. JIT executions go through setContext once per phase and
+  // the keys rarely change between phases, so remotes rebuild their
+  // RuntimeContext from the cached keys instead of receiving the same
+  // multi-GB buffers again.
+  KeyWrapper<LweKeyswitchKey, KeyswitchKeyParam> cachedKsk;
+  KeyWrapper<LweBootstrapKey, BootstrapKeyParam> cachedBsk;
+  bool keysCached = false;
+  // In sharded mode, whether the non-owned part of the cache currently
+  // lives on node-local storage instead of in memory.
+  bool keysSpilled = false;
 
   RuntimeContextManager() {
     context = nullptr;
@@ -106,7 +342,9 @@ struct RuntimeContextManager {
            "Only one RuntimeContext can be used at a time.");
 
     // Root node broadcasts the evaluation keys and each remote
-    // instantiates a local RuntimeContext.
+    // instantiates a local RuntimeContext. When the keys of this phase
+    // are the ones already broadcast, only a reuse flag goes over the
+    // wire.
     if (_dfr_is_root_node()) {
       RuntimeContext *context = (RuntimeContext *)ctx;
 
@@ -114,26 +352,70 @@ struct RuntimeContextManager {
           context->getKeys().getKeyswitchKeys());
       KeyWrapper<LweBootstrapKey, BootstrapKeyParam> bskw(
           context->getKeys().getBootstrapKeys());
-      hpx::collectives::broadcast_to("ksk_keystore", kskw);
-      hpx::collectives::broadcast_to("bsk_keystore", bskw);
+      bool reuse = keysCached && kskw == cachedKsk && bskw == cachedBsk;
+      hpx::collectives::broadcast_to("key_reuse", reuse);
+      if (!reuse) {
+        broadcastKeys<LweKeyswitchKey, KeyswitchKeyParam>("ksk_keystore",
+                                                          kskw.keys);
+        broadcastKeys<LweBootstrapKey, BootstrapKeyParam>("bsk_keystore",
+                                                          bskw.keys);
+        cachedKsk = kskw;
+        cachedBsk = bskw;
+        keysCached = true;
+      }
     } else {
-      auto kskFut = hpx::collectives::broadcast_from<
-          KeyWrapper<LweKeyswitchKey, KeyswitchKeyParam>>("ksk_keystore");
-      auto bskFut = hpx::collectives::broadcast_from<
-          KeyWrapper<LweBootstrapKey, BootstrapKeyParam>>("bsk_keystore");
-      KeyWrapper<LweKeyswitchKey, KeyswitchKeyParam> kskw = kskFut.get();
-      KeyWrapper<LweBootstrapKey, BootstrapKeyParam> bskw = bskFut.get();
+      bool reuse = hpx::collectives::broadcast_from<bool>("key_reuse").get();
+      if (!reuse) {
+        cachedKsk = KeyWrapper<LweKeyswitchKey, KeyswitchKeyParam>(
+            receiveKeys<LweKeyswitchKey, KeyswitchKeyParam>("ksk_keystore"));
+        cachedBsk = KeyWrapper<LweBootstrapKey, BootstrapKeyParam>(
+            receiveKeys<LweBootstrapKey, BootstrapKeyParam>("bsk_keystore"));
+        keysCached = true;
+        keysSpilled = false;
+      } else if (keysSpilled) {
+        // Bring the spilled shards back; the two keystores reload from
+        // node-local storage concurrently.
+        auto kskReload = hpx::async([this]() {
+          dfr_reload_keys<LweKeyswitchKey, KeyswitchKeyParam>(cachedKsk,
+                                                              "ksk_keystore");
+        });
+        auto bskReload = hpx::async([this]() {
+          dfr_reload_keys<LweBootstrapKey, BootstrapKeyParam>(cachedBsk,
+                                                              "bsk_keystore");
+        });
+        kskReload.get();
+        bskReload.get();
+        keysSpilled = false;
+      }
+      assert(keysCached && "Key reuse requested but no keys cached.");
       context = new mlir::concretelang::RuntimeContext(
-          EvaluationKeys(kskw.keys, bskw.keys, {}));
+          EvaluationKeys(cachedKsk.keys, cachedBsk.keys, {}));
     }
   }
 
   RuntimeContext *getContext() { return context; }
 
+  /// True once the evaluation keys are resident on every locality, i.e.
+  /// after the first broadcast. Placement uses this to avoid scheduling
+  /// key-dependent tasks on localities that would have to fetch keys.
+  bool keysBroadcast() const { return keysCached; }
+
   void clearContext() {
+    // The cached keys survive so the next phase can skip the broadcast.
     if (context != nullptr)
       delete context;
     context = nullptr;
+    // In sharded mode remotes keep only their owned shard resident
+    // between phases and spill the rest to node-local storage; the root
+    // cache stays resident as the reference copy for the reuse check.
+    if (dfr_key_sharding() && !_dfr_is_root_node() && keysCached &&
+        !keysSpilled) {
+      bool kskSpilled = dfr_spill_keys<LweKeyswitchKey, KeyswitchKeyParam>(
+          cachedKsk, "ksk_keystore");
+      bool bskSpilled = dfr_spill_keys<LweBootstrapKey, BootstrapKeyParam>(
+          cachedBsk, "bsk_keystore");
+      keysSpilled = kskSpilled || bskSpilled;
+    }
   }
 };
 
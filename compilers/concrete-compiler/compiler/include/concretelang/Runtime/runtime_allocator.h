@@ -0,0 +1,36 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+/// Allocation entry points for the compiled circuits: the LLVM lowering
+/// emits calls to the generic MLIR allocation functions instead of plain
+/// malloc/free, and the runtime backs them with a thread-local cache of
+/// power-of-two blocks. A circuit invocation allocates and releases
+/// thousands of small LWE buffers; serving them from the calling thread's
+/// cache keeps the hot path lock-free and the allocator out of the
+/// profile under heavy thread counts. All blocks come from the system
+/// allocator, so a cached pointer remains valid to release with plain
+/// free() wherever ownership escapes the generated code (e.g. circuit
+/// results exported by the client library).
+
+#ifndef CONCRETELANG_RUNTIME_ALLOCATOR_H
+#define CONCRETELANG_RUNTIME_ALLOCATOR_H
+
+#include <stdint.h>
+
+extern "C" {
+
+/// Allocation functions called by the generated code; the signatures are
+/// fixed by the MLIR memref-to-llvm lowering.
+void *_mlir_memref_to_llvm_alloc(uint64_t size);
+void *_mlir_memref_to_llvm_aligned_alloc(uint64_t alignment, uint64_t size);
+void _mlir_memref_to_llvm_free(void *ptr);
+
+/// Return the cached blocks of the calling thread to the system allocator.
+/// Called by the invocation drivers once the results of a circuit call have
+/// been exported, so per-invocation temporaries do not accumulate.
+void runtime_allocation_cache_release();
+}
+
+#endif
@@ -10,12 +10,15 @@
 #include <cstddef>
 #include <cstdlib>
 
+// Scrape API for the per-operation runtime counters and histograms.
+#include "concretelang/Runtime/runtime_stats.h"
+
 extern "C" {
 
 typedef void (*wfnptr)(...);
 
 void *_dfr_make_ready_future(void *, size_t);
-void _dfr_create_async_task(wfnptr, void *, size_t, size_t, ...);
+void _dfr_create_async_task(wfnptr, void *, size_t, size_t, uint64_t, ...);
 void _dfr_register_work_function(wfnptr);
 void *_dfr_await_future(void *);
 
@@ -24,11 +27,53 @@ void *_dfr_await_future(void *);
     _dfr_create_async_task allocates both future and storage for outputs.  */
 void _dfr_deallocate_future(void *);
 
+/*  Result streaming: a batched work function can expose its output as a
+    fixed number of chunks and fulfill each one as it is finalized with a
+    producer-allocated chunk descriptor. A chunk is a regular future
+    (usable with _dfr_await_future or as a task dependency) owning its
+    descriptor; deallocating the chunked future requires all chunks to
+    have been fulfilled.  */
+void *_dfr_make_chunked_future(size_t);
+void _dfr_fulfill_chunk(void *, size_t, void *);
+void *_dfr_get_chunk_future(void *, size_t);
+void _dfr_deallocate_chunked_future(void *);
+
 /*  Initialisation & termination.  */
 void _dfr_start(int64_t, void *);
 void _dfr_stop(int64_t);
 
 void _dfr_terminate();
+
+/*  NUMA-aware allocation mode: when enabled (default, or via the
+    CONCRETE_NUMA_AWARE environment variable) ciphertext temporaries are
+    served from thread-local arenas so first-touch keeps them on the
+    worker's memory node.  */
+void runtime_set_numa_aware(int enable);
+
+/*  Execution profiles: RUNTIME_PROFILE_LATENCY (default) lets a single
+    invocation use every resource -- all OpenMP workers for its batched
+    loops and high-priority GPU streams -- to minimize its latency.
+    RUNTIME_PROFILE_THROUGHPUT partitions resources across concurrent
+    invocations: each batched loop restricts itself to an equal share of
+    the workers and GPU work is issued on normal-priority streams, so
+    concurrent invocations progress side by side instead of serializing
+    behind each other's worker pool. The profile is per-thread, applies
+    from the next call on and is switchable without restart.  */
+#define RUNTIME_PROFILE_LATENCY 0
+#define RUNTIME_PROFILE_THROUGHPUT 1
+void runtime_set_execution_profile(int profile);
+int runtime_get_execution_profile(void);
+
+/*  Topology control: worker count and binding spec (HPX --hpx:bind
+    syntax) for the dataflow workers, to be set before the runtime first
+    starts; they take precedence over the DFR_NUM_THREADS and
+    DFR_THREAD_BINDING environment variables. Memory binding restricts
+    all subsequent allocation of the process to one NUMA node (negative
+    restores the default policy) and may be changed at any time.  */
+void runtime_set_worker_threads(size_t num_threads);
+void runtime_set_worker_binding(const char *bind_spec);
+void runtime_bind_memory_numa_node(int node);
+int runtime_get_numa_aware();
 }
 
 #endif
@@ -0,0 +1,104 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+/// Always-available instrumentation of the runtime hot paths: per-operation
+/// call counters, latency histograms and GPU transfer volumes, aggregated
+/// per thread so the entry points only touch thread-local memory. A service
+/// embedding the runtime scrapes the aggregates through the C API between
+/// invocations (and resets them per invocation if desired).
+
+#ifndef CONCRETELANG_RUNTIME_STATS_H
+#define CONCRETELANG_RUNTIME_STATS_H
+
+#include <stdint.h>
+
+extern "C" {
+
+/// Instrumented runtime operations.
+typedef enum runtime_stats_op {
+  RUNTIME_STATS_OP_KEYSWITCH = 0,
+  RUNTIME_STATS_OP_BOOTSTRAP = 1,
+  RUNTIME_STATS_OP_WOP_PBS = 2,
+  RUNTIME_STATS_OP_NUM = 3,
+} runtime_stats_op;
+
+/// Latency histograms use power-of-two nanosecond buckets: bucket b counts
+/// calls with latency in [2^b, 2^(b+1)) ns, the last bucket catches the
+/// rest.
+#define RUNTIME_STATS_HIST_BUCKETS 32
+
+/// Number of calls of `op` summed over all threads.
+uint64_t runtime_stats_get_count(runtime_stats_op op);
+/// Number of entry-point invocations of `op` summed over all threads.
+/// Batched entry points count one invocation for the whole batch, so
+/// count / invocations is the realized average batch size.
+uint64_t runtime_stats_get_invocations(runtime_stats_op op);
+/// Cumulated wall-clock nanoseconds spent in `op` over all threads.
+uint64_t runtime_stats_get_time_ns(runtime_stats_op op);
+/// Number of calls of `op` that fell into latency bucket `bucket`.
+uint64_t runtime_stats_get_histogram_bucket(runtime_stats_op op,
+                                            uint32_t bucket);
+/// Bytes copied to (resp. from) GPU devices.
+uint64_t runtime_stats_get_gpu_bytes_in();
+uint64_t runtime_stats_get_gpu_bytes_out();
+/// Bytes currently handed out by the runtime allocation entry points
+/// (see runtime_allocator.h) and not yet freed, measured in usable block
+/// sizes. Blocks parked in the thread caches are not counted: from the
+/// circuit's point of view they are free.
+uint64_t runtime_stats_get_allocated_bytes();
+/// Highest value runtime_stats_get_allocated_bytes reached since the last
+/// watermark reset. Resetting before an invocation and reading after
+/// yields that invocation's true peak ciphertext footprint.
+uint64_t runtime_stats_get_peak_allocated_bytes();
+/// Reset the peak watermark to the currently allocated bytes.
+void runtime_stats_reset_allocation_watermark();
+/// Zero all counters on all threads.
+void runtime_stats_reset();
+/// Writes the aggregated counters as a batching profile to `path`, a
+/// versioned text format the compiler consumes on recompilation (see
+/// CompilationOptions::batchingProfile). Returns 0 on success. Setting
+/// the CONCRETE_PROFILE_OUTPUT environment variable to a writable path
+/// writes the profile automatically at process exit.
+int runtime_stats_write_profile(const char *path);
+}
+
+namespace mlir {
+namespace concretelang {
+namespace runtime_stats {
+
+/// Record `calls` calls of `op` measured together in `time_ns` (batched
+/// entry points count one call per ciphertext; the histogram buckets the
+/// per-call average). Only touches the calling thread's aggregate.
+void recordCalls(runtime_stats_op op, uint64_t calls, uint64_t time_ns);
+/// Account a host-to-device (toDevice) or device-to-host transfer.
+void recordGpuTransfer(uint64_t bytes, bool toDevice);
+/// Account `bytes` handed out by (resp. returned to) an allocation entry
+/// point. Allocations may be freed on a different thread than they were
+/// made on, so these maintain process-wide counters rather than
+/// per-thread aggregates.
+void recordAllocation(uint64_t bytes);
+void recordDeallocation(uint64_t bytes);
+
+/// RAII timer for the runtime entry points: records `calls` calls of `op`
+/// on scope exit. `key` is the evaluation key index of the call (forwarded
+/// to the trace event when trace mode is on, see runtime_trace.h), or -1
+/// when the operation has none.
+class CallTimer {
+public:
+  CallTimer(runtime_stats_op op, uint64_t calls = 1, int64_t key = -1);
+  ~CallTimer();
+
+private:
+  runtime_stats_op op;
+  uint64_t calls;
+  int64_t key;
+  uint64_t start_ns;
+};
+
+} // namespace runtime_stats
+} // namespace concretelang
+} // namespace mlir
+
+#endif
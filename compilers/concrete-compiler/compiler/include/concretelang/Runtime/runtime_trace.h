@@ -0,0 +1,60 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+/// Opt-in timeline tracing of the runtime: when the environment variable
+/// CONCRETE_RUNTIME_TRACE is set to an output path, every instrumented
+/// runtime operation (see runtime_stats.h) is recorded with its begin/end
+/// timestamp and key index into a fixed-size lock-free ring buffer, and the
+/// Tracing dialect ops become cheap timeline markers instead of printing.
+/// The buffer is written out in Chrome trace format (loadable in
+/// chrome://tracing or Perfetto) at process exit, or on demand through
+/// runtime_trace_dump between invocations, so an individual slow PBS in a
+/// large circuit can be pinpointed on the timeline.
+
+#ifndef CONCRETELANG_RUNTIME_TRACE_H
+#define CONCRETELANG_RUNTIME_TRACE_H
+
+#include <stdint.h>
+
+#include "concretelang/Runtime/runtime_stats.h"
+
+extern "C" {
+
+/// Whether trace mode is active (CONCRETE_RUNTIME_TRACE is set).
+int runtime_trace_enabled();
+/// Write the recorded events to `path` in Chrome trace format. Returns 0 on
+/// success, -1 if trace mode is off or the file cannot be written.
+int runtime_trace_dump(const char *path);
+/// Number of events evicted from the ring buffer so far; non-zero means the
+/// capacity (CONCRETE_RUNTIME_TRACE_CAPACITY, default 2^20 events) should be
+/// raised for a complete timeline.
+uint64_t runtime_trace_dropped();
+/// Discard all recorded events, e.g. between invocations.
+void runtime_trace_reset();
+}
+
+namespace mlir {
+namespace concretelang {
+namespace runtime_trace {
+
+/// Whether trace mode is active; cheap enough for the hot paths.
+bool enabled();
+
+/// Record one operation spanning [begin_ns, end_ns] on the calling thread.
+/// `key` is the evaluation key index of the call, or -1 when the operation
+/// has none. Lock-free: only an atomic cursor bump plus a slot write.
+void recordOp(runtime_stats_op op, int64_t key, uint64_t calls,
+              uint64_t begin_ns, uint64_t end_ns);
+
+/// Record an instant marker named by `message` at the current time. Used by
+/// the Tracing dialect entry points; the message is interned under a lock,
+/// so markers are cheap but not free.
+void recordMarker(const char *message, uint32_t length);
+
+} // namespace runtime_trace
+} // namespace concretelang
+} // namespace mlir
+
+#endif
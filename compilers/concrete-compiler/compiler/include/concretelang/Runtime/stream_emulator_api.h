@@ -22,6 +22,12 @@ extern "C" {
 void *stream_emulator_init();
 void stream_emulator_run(void *dfg);
 void stream_emulator_delete(void *dfg);
+/// Sets the priority class of the circuit invocations subsequently
+/// started from the calling thread. Zero (the default) runs at normal
+/// priority; positive values run on high-priority device streams so
+/// latency-sensitive circuits can overtake batched work. Only the GPU
+/// backend differentiates priorities.
+void stream_emulator_set_invocation_priority(int priority);
 
 void stream_emulator_make_memref_add_lwe_ciphertexts_u64_process(void *dfg,
                                                                  void *sin1,
@@ -85,6 +85,36 @@ void memref_keyswitch_lwe_u64(uint64_t *out_allocated, uint64_t *out_aligned,
                               uint32_t ksk_index,
                               mlir::concretelang::RuntimeContext *context);
 
+/// Slim variants of the scalar entry points above. The operands are raw
+/// aligned pointers plus the static ciphertext size: when the compiler
+/// proved the buffers contiguous with a static shape, passing the five
+/// descriptor fields per memref (and re-checking strides here) is pure
+/// call overhead, which adds up in scalar-heavy circuits.
+void concrete_add_lwe_ciphertexts_u64(uint64_t *out, uint64_t *ct0,
+                                      uint64_t *ct1, uint64_t lwe_size);
+
+void concrete_add_plaintext_lwe_ciphertext_u64(uint64_t *out, uint64_t *ct0,
+                                               uint64_t plaintext,
+                                               uint64_t lwe_size);
+
+void concrete_mul_cleartext_lwe_ciphertext_u64(uint64_t *out, uint64_t *ct0,
+                                               uint64_t cleartext,
+                                               uint64_t lwe_size);
+
+void concrete_negate_lwe_ciphertext_u64(uint64_t *out, uint64_t *ct0,
+                                        uint64_t lwe_size);
+
+void concrete_keyswitch_lwe_u64(uint64_t *out, uint64_t *ct0, uint32_t level,
+                                uint32_t base_log, uint32_t input_lwe_dim,
+                                uint32_t output_lwe_dim, uint32_t ksk_index,
+                                mlir::concretelang::RuntimeContext *context);
+
+void concrete_bootstrap_lwe_u64(uint64_t *out, uint64_t *ct0, uint64_t *tlu,
+                                uint32_t input_lwe_dim, uint32_t poly_size,
+                                uint32_t level, uint32_t base_log,
+                                uint32_t glwe_dim, uint32_t bsk_index,
+                                mlir::concretelang::RuntimeContext *context);
+
 void memref_batched_add_lwe_ciphertexts_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
@@ -142,6 +172,31 @@ void memref_batched_keyswitch_lwe_u64(
     uint32_t base_log, uint32_t input_lwe_dim, uint32_t output_lwe_dim,
     uint32_t ksk_index, mlir::concretelang::RuntimeContext *context);
 
+/// Packs a batch of LWE ciphertexts into GLWE ciphertexts through the
+/// packing keyswitch key: LWE `i` lands in coefficient `i % poly_size` of
+/// GLWE `i / poly_size`, so a full GLWE carries poly_size ciphertexts in
+/// the footprint of a single big-key LWE. The decomposition parameters of
+/// the key are read from the evaluation keys held by the context.
+void memref_batched_glwe_pack_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t glwe_dim,
+    uint32_t poly_size, uint32_t pksk_index,
+    mlir::concretelang::RuntimeContext *context);
+
+/// Inverse of memref_batched_glwe_pack_lwe_u64: recovers LWE `i` by sample
+/// extraction of coefficient `i % poly_size` from GLWE `i / poly_size`.
+/// Sample extraction is a pure coefficient permutation and needs no key.
+void memref_batched_glwe_unpack_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t glwe_dim,
+    uint32_t poly_size);
+
 void *memref_keyswitch_async_lwe_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
@@ -238,19 +293,23 @@ void memref_copy_one_rank(uint64_t *src_allocated, uint64_t *src_aligned,
 /// \brief Run Keyswitch on GPU.
 ///
 /// It handles memory copy of the different arguments from CPU to GPU, and
-/// freeing memory.
+/// freeing memory. When the lowering proved that the result is only read
+/// by other CUDA entry points it passes their number as
+/// `out_device_readers` and the result stays resident on the device
+/// instead of being copied back.
 void memref_keyswitch_lwe_cuda_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
     uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
     uint64_t ct0_stride, uint32_t level, uint32_t base_log,
     uint32_t input_lwe_dim, uint32_t output_lwe_dim, uint32_t ksk_index,
-    mlir::concretelang::RuntimeContext *context);
+    mlir::concretelang::RuntimeContext *context, uint32_t out_device_readers);
 
 /// \brief Run bootstrapping on GPU.
 ///
 /// It handles memory copy of the different arguments from CPU to GPU, and
-/// freeing memory.
+/// freeing memory. See memref_keyswitch_lwe_cuda_u64 for
+/// `out_device_readers`.
 void memref_bootstrap_lwe_cuda_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
@@ -259,7 +318,55 @@ void memref_bootstrap_lwe_cuda_u64(
     uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
     uint32_t input_lwe_dim, uint32_t poly_size, uint32_t level,
     uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
-    mlir::concretelang::RuntimeContext *context);
+    mlir::concretelang::RuntimeContext *context, uint32_t out_device_readers);
+
+/// Levelled operations on GPU. They only pay off as part of a chain of
+/// CUDA entry points: the inputs are adopted from the device-residency
+/// table when a previous call left them there and the result is handed
+/// over to it when `out_device_readers` is non-zero, so chains like
+/// add -> keyswitch -> bootstrap -> add never round-trip through the
+/// host.
+void memref_add_lwe_ciphertexts_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *ct1_allocated, uint64_t *ct1_aligned,
+    uint64_t ct1_offset, uint64_t ct1_size, uint64_t ct1_stride,
+    uint32_t out_device_readers);
+
+void memref_add_plaintext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t plaintext, uint32_t out_device_readers);
+
+void memref_mul_cleartext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t cleartext, uint32_t out_device_readers);
+
+void memref_negate_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint32_t out_device_readers);
+
+/// \brief Run keyswitch followed by bootstrapping on GPU.
+///
+/// The keyswitched ciphertext stays on the device: compared to issuing the
+/// two operations separately it saves one device round-trip of the
+/// intermediate ciphertext and one synchronization.
+void memref_keyswitch_bootstrap_lwe_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *tlu_allocated, uint64_t *tlu_aligned,
+    uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
+    uint32_t ks_level, uint32_t ks_base_log, uint32_t ks_input_lwe_dim,
+    uint32_t ks_output_lwe_dim, uint32_t ksk_index, uint32_t input_lwe_dim,
+    uint32_t poly_size, uint32_t level, uint32_t base_log, uint32_t glwe_dim,
+    uint32_t bsk_index, mlir::concretelang::RuntimeContext *context);
 
 // Batched CUDA function //////////////////////////////////////////////////////
 
@@ -270,7 +377,20 @@ void memref_batched_keyswitch_lwe_cuda_u64(
     uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
     uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t level,
     uint32_t base_log, uint32_t input_lwe_dim, uint32_t output_lwe_dim,
-    uint32_t ksk_index, mlir::concretelang::RuntimeContext *context);
+    uint32_t ksk_index, mlir::concretelang::RuntimeContext *context,
+    uint32_t out_device_readers);
+
+/// Packs each input LWE of the batch into its own GLWE through the
+/// packing keyswitch key.
+void memref_batched_fp_keyswitch_lwe_to_glwe_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t level,
+    uint32_t base_log, uint32_t input_lwe_dim, uint32_t glwe_dim,
+    uint32_t poly_size, uint32_t pksk_index,
+    mlir::concretelang::RuntimeContext *context);
 
 void memref_batched_bootstrap_lwe_cuda_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
@@ -281,6 +401,72 @@ void memref_batched_bootstrap_lwe_cuda_u64(
     uint64_t *tlu_aligned, uint64_t tlu_offset, uint64_t tlu_size,
     uint64_t tlu_stride, uint32_t input_lwe_dim, uint32_t poly_size,
     uint32_t level, uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
+    mlir::concretelang::RuntimeContext *context, uint32_t out_device_readers);
+
+/// Batched levelled operations on GPU; see the single ciphertext variants
+/// above for the device-residency protocol.
+void memref_batched_add_lwe_ciphertexts_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *ct1_allocated,
+    uint64_t *ct1_aligned, uint64_t ct1_offset, uint64_t ct1_size0,
+    uint64_t ct1_size1, uint64_t ct1_stride0, uint64_t ct1_stride1,
+    uint32_t out_device_readers);
+
+void memref_batched_add_plaintext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *pt_allocated,
+    uint64_t *pt_aligned, uint64_t pt_offset, uint64_t pt_size,
+    uint64_t pt_stride, uint32_t out_device_readers);
+
+void memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t plaintext,
+    uint32_t out_device_readers);
+
+void memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *ct_allocated,
+    uint64_t *ct_aligned, uint64_t ct_offset, uint64_t ct_size,
+    uint64_t ct_stride, uint32_t out_device_readers);
+
+void memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t cleartext,
+    uint32_t out_device_readers);
+
+void memref_batched_negate_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t out_device_readers);
+
+void memref_batched_keyswitch_bootstrap_lwe_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *tlu_allocated,
+    uint64_t *tlu_aligned, uint64_t tlu_offset, uint64_t tlu_size,
+    uint64_t tlu_stride, uint32_t ks_level, uint32_t ks_base_log,
+    uint32_t ks_input_lwe_dim, uint32_t ks_output_lwe_dim, uint32_t ksk_index,
+    uint32_t input_lwe_dim, uint32_t poly_size, uint32_t level,
+    uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context);
 
 void memref_batched_mapped_bootstrap_lwe_cuda_u64(
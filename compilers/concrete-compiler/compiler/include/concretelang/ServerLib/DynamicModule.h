@@ -24,6 +24,12 @@ public:
   static outcome::checked<std::shared_ptr<DynamicModule>, StringError>
   open(std::string outputPath);
 
+  /// Forces immediate binding of every symbol of the loaded shared
+  /// library, so the relocation cost is paid now instead of on the
+  /// first call into it, and missing symbols surface as an error here
+  /// rather than at request time.
+  outcome::checked<void, StringError> prevalidate();
+
 private:
   outcome::checked<void, StringError>
   loadClientParametersJSON(std::string outputPath);
@@ -33,6 +39,7 @@ private:
 private:
   std::vector<ClientParameters> clientParametersList;
   void *libraryHandle;
+  std::string libraryPath;
 
   friend class ServerLambda;
 };
@@ -7,6 +7,11 @@
 #define CONCRETELANG_SERVERLIB_SERVER_LAMBDA_H
 
 #include <cassert>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "boost/outcome.h"
 
@@ -22,6 +27,19 @@ namespace serverlib {
 
 using concretelang::clientlib::ScalarOrTensorData;
 
+/// Session-scoped cache of evaluation results, shared by all copies of a
+/// ServerLambda (callAsync evaluates on copies). Keyed on the identity of
+/// the argument ciphertext handles, so it only hits when the caller passes
+/// the same shared buffers again across invocations (e.g. encrypted model
+/// weights pushed once per session); ciphertext contents are never
+/// inspected.
+struct ServerLambdaResultCache {
+  std::mutex mutex;
+  std::map<std::vector<const void *>,
+           std::vector<clientlib::SharedScalarOrTensorData>>
+      entries;
+};
+
 /// ServerLambda is a utility class that allows to call a function of a
 /// compilation result.
 class ServerLambda {
@@ -42,6 +60,97 @@ public:
        std::optional<clientlib::EvaluationKeys> evaluationKeys,
        bool simulation = false);
 
+  /// Call the ServerLambda with public arguments asynchronously. The
+  /// evaluation is scheduled on a shared executor, so many invocations can
+  /// be kept in flight concurrently; the result is delivered through the
+  /// returned future. `args` must stay alive until the future is ready.
+  std::future<llvm::Expected<std::unique_ptr<clientlib::PublicResult>>>
+  callAsync(clientlib::PublicArguments &args,
+            std::optional<clientlib::EvaluationKeys> evaluationKeys,
+            bool simulation = false);
+
+  /// Call the ServerLambda, reusing the memoized result when the same
+  /// argument buffers were already evaluated in this session. Only use
+  /// this for pure subcircuits whose inputs are stable across calls: the
+  /// cache is keyed on handle identity, assumes the evaluation keys do not
+  /// change between invocations (call clearMemoizedResults when they do),
+  /// and returns the identical output ciphertexts rather than a fresh
+  /// evaluation.
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  callMemoized(clientlib::PublicArguments &args,
+               std::optional<clientlib::EvaluationKeys> evaluationKeys,
+               bool simulation = false);
+
+  /// Call the ServerLambda asynchronously with hedged execution: when
+  /// the result is not ready after the configured hedge delay, a
+  /// duplicate invocation is launched on another executor worker and
+  /// the first result to finish wins. Stragglers (cold key pages, GPU
+  /// contention) stop dominating the tail at the cost of up to 2x
+  /// compute for the hedged calls; an FHE evaluation cannot be aborted
+  /// mid-run, so the losing invocation completes and its result is
+  /// discarded. Falls back to callAsync when no delay is configured.
+  std::future<llvm::Expected<std::unique_ptr<clientlib::PublicResult>>>
+  callAsyncHedged(clientlib::PublicArguments &args,
+                  std::optional<clientlib::EvaluationKeys> evaluationKeys,
+                  bool simulation = false);
+
+  /// Delay in milliseconds after which callAsyncHedged launches the
+  /// duplicate invocation. A good setting is around the p99 latency of
+  /// the circuit, so only stragglers pay the duplicate. Zero (the
+  /// default) disables hedging.
+  void setHedgeDelay(uint64_t milliseconds) { hedgeDelayMs = milliseconds; }
+
+  /// Drop all memoized results, e.g. when the session keys change.
+  void clearMemoizedResults();
+
+  /// Selects the runtime execution profile applied to this lambda's
+  /// calls: RUNTIME_PROFILE_LATENCY (the default) gives one invocation
+  /// every resource, RUNTIME_PROFILE_THROUGHPUT partitions workers and
+  /// GPU streams across concurrent invocations. Takes effect on the
+  /// next call, no restart needed; copies of the lambda (e.g. the ones
+  /// callAsync evaluates on) keep the profile they were copied with.
+  void setExecutionProfile(int profile) { executionProfile = profile; }
+
+  /// Declares the expected peak memory footprint of one invocation, in
+  /// bytes; a good estimate is peakIntermediateCiphertextSize plus the
+  /// input and output sizes from the CompilationFeedback of the
+  /// artifacts this lambda was loaded from. When the process defines a
+  /// budget (CONCRETE_MEMORY_BUDGET), calls whose declared footprint
+  /// does not fit into the remaining budget wait for in-flight calls to
+  /// finish instead of over-allocating. Zero (the default) opts out.
+  void setExpectedMemoryFootprint(uint64_t bytes) {
+    expectedMemoryFootprint = bytes;
+  }
+
+  /// Performs the remaining lazy work eagerly, at deploy time rather
+  /// than on the first request: binds every symbol of the loaded
+  /// library, validates the key references of the client parameters
+  /// and, when evaluation keys are given, runs one dummy invocation
+  /// over trivial zeroed ciphertexts so the allocations and key setup
+  /// of the first real request are already paid.
+  outcome::checked<void, concretelang::error::StringError>
+  warmup(std::optional<clientlib::EvaluationKeys> evaluationKeys =
+             std::nullopt);
+
+  /// Starts warming the runtime context for `evaluationKeys` on a
+  /// background thread (Fourier conversion of the bootstrap keys, GPU key
+  /// residency) and returns immediately. Sessions invoking a known
+  /// sequence of circuits call this for the next circuit's keyset while
+  /// the current one executes, so its key setup overlaps useful work
+  /// instead of delaying the invocation. Unlike warmup() this never
+  /// blocks and performs no dummy invocation. releasePrefetch drops the
+  /// pinned context at session end.
+  void prefetch(clientlib::EvaluationKeys evaluationKeys);
+  void releasePrefetch(clientlib::EvaluationKeys evaluationKeys);
+
+  /// Atomically swaps the keyset `oldKeys` for `newKeys` in the shared
+  /// runtime context, e.g. when a tenant rotates its keys: calls entering
+  /// after the swap run on the new keys while in-flight calls finish on
+  /// the old ones, with no downtime and no context rebuild. Subsequent
+  /// calls must pass `newKeys`.
+  void rotateKeys(clientlib::EvaluationKeys oldKeys,
+                  clientlib::EvaluationKeys newKeys);
+
   /// \brief Call the loaded function using opaque pointers to both inputs and
   /// outputs.
   /// \param args Array containing pointers to inputs first, followed by
@@ -50,11 +159,49 @@ public:
   llvm::Error invokeRaw(llvm::MutableArrayRef<void *> args);
 
 protected:
+  friend class ServerLambdaBatcher;
+  friend class ServerLambdaChain;
+
   ClientParameters clientParameters;
   /// holds a pointer to the entrypoint of the shared lib which
   void (*func)(void *...);
   /// Retain module and open shared lib alive
   std::shared_ptr<DynamicModule> module;
+  /// Memoized results, shared between copies of this lambda
+  std::shared_ptr<ServerLambdaResultCache> resultCache =
+      std::make_shared<ServerLambdaResultCache>();
+  /// Runtime execution profile applied on call (RUNTIME_PROFILE_LATENCY)
+  int executionProfile = 0;
+  /// Declared per-invocation footprint for admission control (opted out)
+  uint64_t expectedMemoryFootprint = 0;
+  /// Hedge delay for callAsyncHedged, in milliseconds (disabled)
+  uint64_t hedgeDelayMs = 0;
+};
+
+/// A server-side composition of lambdas over the same keyset: the
+/// internal ciphertext results of each stage feed the next stage's
+/// inputs directly, within one runtime invocation. Pipelines that used
+/// to export the intermediate result and re-import it for the next
+/// circuit skip the serialization round-trip and the keyswitch back to
+/// the client format entirely.
+class ServerLambdaChain {
+public:
+  /// Builds a chain from the given stages, in call order. Fails when
+  /// the output gates of a stage do not match the input gates of the
+  /// next one.
+  static outcome::checked<ServerLambdaChain, concretelang::error::StringError>
+  create(std::vector<ServerLambda> stages);
+
+  /// Calls every stage in order on the arguments of the first one and
+  /// returns the result of the last one; intermediate ciphertexts never
+  /// leave their internal format.
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  call(clientlib::PublicArguments &args,
+       std::optional<clientlib::EvaluationKeys> evaluationKeys,
+       bool simulation = false);
+
+private:
+  std::vector<ServerLambda> stages;
 };
 
 } // namespace serverlib
@@ -0,0 +1,101 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SERVERLIB_SERVER_LAMBDA_BATCHER_H
+#define CONCRETELANG_SERVERLIB_SERVER_LAMBDA_BATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "boost/outcome.h"
+
+#include "concretelang/ClientLib/ClientParameters.h"
+#include "concretelang/ClientLib/PublicArguments.h"
+#include "concretelang/Common/Error.h"
+#include "concretelang/ServerLib/ServerLambda.h"
+
+namespace concretelang {
+namespace serverlib {
+
+/// Opt-in micro-batching layer in front of a ServerLambda compiled with a
+/// leading batch dimension on its encrypted inputs and output. Independent
+/// single-sample invocations submitted concurrently are coalesced into one
+/// evaluation of the batched circuit: the batcher gathers up to `batchSize`
+/// compatible submissions within `latencyBudget` of the first one,
+/// concatenates the ciphertext buffers along the batch dimension (padding a
+/// short batch by repeating the last sample), runs the circuit once, then
+/// scatters the slices of the result back to each caller's future.
+class ServerLambdaBatcher {
+public:
+  using Result = llvm::Expected<std::unique_ptr<clientlib::PublicResult>>;
+
+  /// Create a batcher over `lambda`, which must evaluate a circuit whose
+  /// encrypted inputs and single encrypted output all carry a leading
+  /// dimension divisible by `batchSize`. Fails if a gate is not encrypted or
+  /// its shape cannot be split into `batchSize` equal samples.
+  static outcome::checked<std::unique_ptr<ServerLambdaBatcher>,
+                          concretelang::error::StringError>
+  create(ServerLambda lambda, clientlib::EvaluationKeys evaluationKeys,
+         size_t batchSize,
+         std::chrono::microseconds latencyBudget =
+             std::chrono::microseconds(500));
+
+  /// Drains pending submissions (evaluating a final partial batch if any)
+  /// and stops the collector thread.
+  ~ServerLambdaBatcher();
+
+  /// Queue one single-sample invocation. `args` must hold one sample of each
+  /// input, i.e. 1/`batchSize` of the batched circuit buffers; the returned
+  /// future delivers this sample's slice of the batched result, shaped by the
+  /// output gate of `args`' client parameters. The batcher keeps a reference
+  /// on `args` until the evaluation completes.
+  std::future<Result> submit(std::shared_ptr<clientlib::PublicArguments> args);
+
+private:
+  struct Pending {
+    std::shared_ptr<clientlib::PublicArguments> args;
+    std::shared_ptr<std::promise<Result>> promise;
+  };
+
+  ServerLambdaBatcher(ServerLambda lambda,
+                      clientlib::EvaluationKeys evaluationKeys,
+                      size_t batchSize, std::chrono::microseconds latencyBudget,
+                      std::vector<size_t> sampleWordsPerInput,
+                      size_t sampleWordsOutput);
+
+  /// Collector loop: waits for the batch to fill or the latency budget of
+  /// its oldest submission to expire, then evaluates.
+  void run();
+
+  /// Concatenate `batch` into one batched invocation, evaluate it and
+  /// scatter the result slices to the promises.
+  void evaluate(std::vector<Pending> batch);
+
+  ServerLambda lambda;
+  clientlib::EvaluationKeys evaluationKeys;
+  size_t batchSize;
+  std::chrono::microseconds latencyBudget;
+  /// Number of uint64_t words of one sample of each input gate.
+  std::vector<size_t> sampleWordsPerInput;
+  /// Number of uint64_t words of one sample of the output gate.
+  size_t sampleWordsOutput;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<Pending> pending;
+  std::chrono::steady_clock::time_point oldestSubmission;
+  bool stop;
+  std::thread collector;
+};
+
+} // namespace serverlib
+} // namespace concretelang
+
+#endif
@@ -0,0 +1,90 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SERVERLIB_SERVER_LAMBDA_STREAMER_H
+#define CONCRETELANG_SERVERLIB_SERVER_LAMBDA_STREAMER_H
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "boost/outcome.h"
+
+#include "concretelang/ClientLib/PublicArguments.h"
+#include "concretelang/Common/Error.h"
+#include "concretelang/ServerLib/ServerLambda.h"
+
+namespace concretelang {
+namespace serverlib {
+
+/// Streaming evaluation of a circuit over a dataset too large to
+/// materialize: the caller pushes the dataset chunk by chunk, each chunk
+/// is one invocation of the circuit, and the results stream back through
+/// the returned futures in push order. The memory envelope is fixed:
+/// at most `maxInFlight` chunks are resident in the streamer at a time,
+/// and push blocks until a slot frees up. Key setup and context warmup
+/// are paid once at creation and shared by every chunk, replacing
+/// application-level sharding that rebuilds them per shard.
+class ServerLambdaStreamer {
+public:
+  using Result = llvm::Expected<std::unique_ptr<clientlib::PublicResult>>;
+
+  /// Create a streamer over `lambda`, pinning the runtime context of
+  /// `evaluationKeys` for the lifetime of the streamer so every chunk
+  /// reuses the same key setup. `maxInFlight` bounds the chunks being
+  /// evaluated concurrently and must be >= 1; one chunk costs its
+  /// argument buffers plus the circuit's intermediate footprint.
+  static outcome::checked<std::unique_ptr<ServerLambdaStreamer>,
+                          concretelang::error::StringError>
+  create(ServerLambda lambda, clientlib::EvaluationKeys evaluationKeys,
+         size_t maxInFlight = 2);
+
+  /// Waits for the in-flight chunks to finish and releases the pinned
+  /// runtime context.
+  ~ServerLambdaStreamer();
+
+  /// Queue one chunk of the dataset, blocking while `maxInFlight` chunks
+  /// are already in flight. The streamer keeps a reference on `args`
+  /// until the chunk's evaluation completes; the future delivers the
+  /// chunk's result. Futures complete in evaluation order, which may
+  /// differ from push order when `maxInFlight` > 1.
+  std::future<Result> push(std::shared_ptr<clientlib::PublicArguments> args);
+
+private:
+  struct Pending {
+    std::shared_ptr<clientlib::PublicArguments> args;
+    std::shared_ptr<std::promise<Result>> promise;
+  };
+
+  ServerLambdaStreamer(ServerLambda lambda,
+                       clientlib::EvaluationKeys evaluationKeys,
+                       size_t maxInFlight);
+
+  /// Worker loop: evaluates queued chunks one at a time. The
+  /// `maxInFlight` workers are the memory envelope: no more chunks than
+  /// workers are ever being evaluated at once.
+  void run();
+
+  ServerLambda lambda;
+  clientlib::EvaluationKeys evaluationKeys;
+  size_t maxInFlight;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  /// Chunks queued or being evaluated; push blocks at `maxInFlight`.
+  size_t inFlight;
+  std::deque<Pending> pending;
+  bool stopping;
+  std::vector<std::thread> workers;
+};
+
+} // namespace serverlib
+} // namespace concretelang
+
+#endif
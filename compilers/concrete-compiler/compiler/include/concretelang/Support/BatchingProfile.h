@@ -0,0 +1,28 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SUPPORT_BATCHINGPROFILE_H_
+#define CONCRETELANG_SUPPORT_BATCHINGPROFILE_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "llvm/ADT/StringRef.h"
+
+namespace mlir {
+namespace concretelang {
+
+/// Derives a bound on batch sizes from a batching profile written by
+/// the runtime instrumentation (see runtime_stats_write_profile): the
+/// largest realized average batch size over the profiled operations,
+/// rounded up to the next power of two. Returns std::nullopt if the
+/// profile cannot be read, has an unknown format version or recorded
+/// no batched invocations.
+std::optional<int64_t> maxBatchSizeFromProfile(llvm::StringRef path);
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
@@ -0,0 +1,77 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SUPPORT_COMPILATIONCACHE_H_
+#define CONCRETELANG_SUPPORT_COMPILATIONCACHE_H_
+
+#include <optional>
+#include <string>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "concretelang/Support/CompilerEngine.h"
+
+namespace mlir {
+namespace concretelang {
+
+/// Returns the directory used to persist compiled library artifacts
+/// across compilations, or std::nullopt if the persistent cache is
+/// disabled. The cache is enabled by setting the
+/// CONCRETELANG_COMPILATION_CACHE_DIR environment variable to a
+/// writable directory.
+std::optional<std::string> compilationCacheDirectory();
+
+/// Computes the cache key of a library compilation of `sources` with
+/// the given `options` and artifact selection, or std::nullopt if the
+/// compilation cannot be cached (e.g. options carrying inputs the key
+/// cannot capture).
+std::optional<std::string> compilationCacheKey(
+    llvm::ArrayRef<std::string> sources, const CompilationOptions &options,
+    llvm::StringRef runtimeLibraryPath, bool generateSharedLib,
+    bool generateStaticLib, bool generateClientParameters,
+    bool generateCompilationFeedback, bool generateCppHeader);
+
+/// Copies the cached artifacts for `key` into `outputDirPath`, keeping
+/// the usual library output directory layout. Returns false if the
+/// cache is disabled or does not contain an entry for `key`.
+bool restoreCachedLibrary(llvm::StringRef key, llvm::StringRef outputDirPath);
+
+/// Persists the artifacts emitted in `outputDirPath` under `key`.
+/// Failures to write the cache entry are silently ignored, since the
+/// cache is a pure optimization.
+void cacheLibrary(llvm::StringRef key, llvm::StringRef outputDirPath);
+
+/// Computes the cache key of the compilation of a single `source` of a
+/// multi-source library build, or std::nullopt if it cannot be cached.
+/// Unlike whole-library entries, per-source entries are independent of
+/// the artifact selection, which only affects the final link.
+std::optional<std::string>
+sourceCompilationCacheKey(const std::string &source,
+                          const CompilationOptions &options,
+                          llvm::StringRef runtimeLibraryPath);
+
+/// Copies the object files of the cached single-source compilation
+/// `key` into `outputDirPath` and appends their paths and the client
+/// parameters and feedback of the functions of that source to the
+/// given vectors. Returns false if the cache is disabled or does not
+/// contain an entry for `key`.
+bool restoreCachedSourceCompilation(
+    llvm::StringRef key, llvm::StringRef outputDirPath,
+    std::vector<std::string> &objectPaths,
+    std::vector<ClientParameters> &clientParameters,
+    std::vector<CompilationFeedback> &compilationFeedbacks);
+
+/// Persists the object files and per-function metadata produced by
+/// compiling one source under `key`. Failures are silently ignored.
+void cacheSourceCompilation(
+    llvm::StringRef key, llvm::ArrayRef<std::string> objectPaths,
+    llvm::ArrayRef<ClientParameters> clientParameters,
+    llvm::ArrayRef<CompilationFeedback> compilationFeedbacks);
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
@@ -7,6 +7,7 @@
 #define CONCRETELANG_SUPPORT_COMPILATIONFEEDBACK_H_
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "concretelang/ClientLib/ClientParameters.h"
@@ -14,10 +15,20 @@
 #include "llvm/Support/Error.h"
 
 namespace mlir {
+class ModuleOp;
 namespace concretelang {
 
 using StringError = ::concretelang::error::StringError;
 
+/// Wall-clock time spent in one phase of the compilation pipeline.
+struct PhaseTiming {
+  /// @brief the name of the phase, e.g. "FHEToTFHEScalar"
+  std::string name;
+
+  /// @brief the wall-clock duration of the phase in seconds
+  double seconds;
+};
+
 struct CompilationFeedback {
   double complexity;
 
@@ -45,15 +56,45 @@ struct CompilationFeedback {
   /// @brief crt decomposition of outputs, if crt is not used, empty vectors
   std::vector<std::vector<int64_t>> crtDecompositionsOfOutputs;
 
+  /// @brief the number of programmable bootstrap operations
+  uint64_t totalPBSCount = 0;
+
+  /// @brief the number of keyswitch operations
+  uint64_t totalKSCount = 0;
+
+  /// @brief the number of wop-pbs operations
+  uint64_t totalWopPBSCount = 0;
+
+  /// @brief the total number of bytes of intermediate ciphertexts that are
+  /// statically visible in the circuit, i.e. the allocation volume of one
+  /// invocation ignoring loop trip counts
+  uint64_t totalIntermediateCiphertextSize = 0;
+
+  /// @brief an estimate of the peak number of bytes of intermediate
+  /// ciphertexts live at the same time
+  uint64_t peakIntermediateCiphertextSize = 0;
+
+  /// @brief the wall-clock time of every pipeline phase that ran for
+  /// this compilation, in execution order
+  std::vector<PhaseTiming> phaseTimings;
+
   /// Fill the sizes from the client parameters.
   void
   fillFromClientParameters(::concretelang::clientlib::ClientParameters params);
 
+  /// Fill the per-op-class counts and intermediate ciphertext sizes by
+  /// walking the parametrized TFHE module.
+  void fillOpStatsFromTFHE(mlir::ModuleOp module);
+
   /// Load the compilation feedback from a path
   static outcome::checked<CompilationFeedback, StringError>
   load(std::string path);
 };
 
+llvm::json::Value toJSON(const mlir::concretelang::PhaseTiming &);
+bool fromJSON(const llvm::json::Value, mlir::concretelang::PhaseTiming &,
+              llvm::json::Path);
+
 llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &);
 bool fromJSON(const llvm::json::Value,
               mlir::concretelang::CompilationFeedback &, llvm::json::Path);
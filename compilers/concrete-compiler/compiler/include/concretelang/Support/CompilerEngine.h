@@ -15,6 +15,7 @@
 #include <mlir/IR/BuiltinOps.h>
 #include <mlir/IR/MLIRContext.h>
 #include <mlir/Pass/Pass.h>
+#include <mutex>
 
 namespace mlir {
 namespace concretelang {
@@ -59,6 +60,10 @@ struct CompilationOptions {
 
   bool autoParallelize;
   bool loopParallelize;
+  /// lower parallel loops to the MLIR async runtime (a small std::thread
+  /// pool) instead of OpenMP, for deployments that cannot carry the HPX
+  /// or OpenMP runtimes; only meaningful together with loopParallelize
+  bool asyncLoopParallelize;
   bool batchTFHEOps;
   int64_t maxBatchSize;
   bool emitSDFGOps;
@@ -69,12 +74,28 @@ struct CompilationOptions {
   bool simulate;
   /// use GPU during execution by generating GPU operations if possible
   bool emitGPUOps;
+  /// compile the independent circuits of a module one at a time, with
+  /// object files spilled to disk between them, bounding peak compiler
+  /// memory on very large modules
+  bool streamingCompilation;
   std::optional<std::vector<int64_t>> fhelinalgTileSizes;
 
+  /// path of a batching profile written by the runtime instrumentation
+  /// (see runtime_stats_write_profile); when set, the batching pass
+  /// bounds batch sizes by the realized batch sizes it records instead
+  /// of relying on static cost models only
+  std::optional<std::string> batchingProfile;
+
   std::optional<std::string> clientParametersFuncName;
 
   optimizer::Config optimizerConfig;
 
+  /// try every optimizer strategy instead of the configured one and
+  /// compile with the cheapest feasible candidate, comparing the modeled
+  /// latency and error probability the optimizer reports rather than
+  /// running full compile+keygen+execute cycles per candidate
+  bool autotuneOptimizer;
+
   /// When decomposing big integers into chunks, chunkSize is the total number
   /// of bits used for the message, including the carry, while chunkWidth is
   /// only the number of bits used during encoding and decoding of a big integer
@@ -86,15 +107,40 @@ struct CompilationOptions {
   /// encodings info manually to allow the client lib to be generated.
   std::optional<mlir::concretelang::encodings::CircuitEncodings> encodings;
 
+  /// specialize the circuit for its concrete input shapes: after the
+  /// lowering to the canonical dialects, fold shape queries and size
+  /// arithmetic to constants and fully unroll the small static batch
+  /// loops, so deployments with a fixed serving batch size trade
+  /// artifact generality for tighter inner loops
+  bool specializeStaticShapes;
+
+  /// unroll factor requested for the lowered levelled loops, attached as
+  /// llvm.loop.unroll.count metadata before the LLVM optimization
+  /// pipeline runs; 0 leaves the unroller to its own heuristics
+  unsigned int loopUnrollFactor;
+  /// force the LLVM loop vectorizer on the lowered levelled loops via
+  /// llvm.loop.vectorize.enable metadata, overriding its profitability
+  /// model
+  bool forceLoopVectorize;
+  /// report on stderr, per loop, whether the LLVM loop vectorizer
+  /// vectorized it
+  bool vectorizerReport;
+
   CompilationOptions()
       : v0FHEConstraints(std::nullopt), verifyDiagnostics(false),
-        autoParallelize(false), loopParallelize(false), batchTFHEOps(false),
+        autoParallelize(false), loopParallelize(false),
+        asyncLoopParallelize(false), batchTFHEOps(false),
         maxBatchSize(std::numeric_limits<int64_t>::max()), emitSDFGOps(false),
         unrollLoopsWithSDFGConvertibleOps(false), dataflowParallelize(false),
         optimizeTFHE(true), simulate(false), emitGPUOps(false),
+        streamingCompilation(false), batchingProfile(std::nullopt),
         clientParametersFuncName(std::nullopt),
-        optimizerConfig(optimizer::DEFAULT_CONFIG), chunkIntegers(false),
-        chunkSize(4), chunkWidth(2), encodings(std::nullopt){};
+        optimizerConfig(optimizer::DEFAULT_CONFIG), autotuneOptimizer(false),
+        chunkIntegers(false),
+        chunkSize(4), chunkWidth(2), encodings(std::nullopt),
+        specializeStaticShapes(false), loopUnrollFactor(0),
+        forceLoopVectorize(false),
+        vectorizerReport(false){};
 
   CompilationOptions(std::string funcname) : CompilationOptions() {
     clientParametersFuncName = funcname;
@@ -148,6 +194,10 @@ public:
     /// Path to the runtime library. Will be linked to the output library if set
     std::string runtimeLibraryPath;
     bool cleanUp;
+    /// Serializes compilation registration: concurrent drivers (see the
+    /// --jobs option of the compiler) add the compilations of several
+    /// engines to one shared library instance.
+    std::mutex registrationMutex;
 
   public:
     /// Create a library instance on which you can add compilation results.
@@ -159,10 +209,38 @@ public:
           cleanUp(cleanUp) {}
     /// Add a compilation result to the library
     llvm::Expected<std::string> addCompilation(CompilationResult &compilation);
+    /// Register a compilation restored from the compilation cache:
+    /// object files already emitted for one input source together with
+    /// the client parameters and feedback of its functions.
+    void addCachedCompilation(
+        const std::vector<std::string> &objects,
+        const std::vector<mlir::concretelang::ClientParameters> &params,
+        const std::vector<mlir::concretelang::CompilationFeedback> &feedbacks);
+    /// Accessors over the registered compilations, used to attribute
+    /// newly added entries to the input source that produced them.
+    const std::vector<std::string> &getObjectsPath() { return objectsPath; }
+    const std::vector<mlir::concretelang::ClientParameters> &
+    getClientParametersList() {
+      return clientParametersList;
+    }
+    const std::vector<mlir::concretelang::CompilationFeedback> &
+    getCompilationFeedbackList() {
+      return compilationFeedbackList;
+    }
     /// Emit the library artifacts with the previously added compilation result
     llvm::Error emitArtifacts(bool sharedLib, bool staticLib,
                               bool clientParameters, bool compilationFeedback,
                               bool cppHeader);
+    /// Emit compressed containers (artifact path + COMPRESSED_EXT) next to
+    /// the emitted shared library and client parameters, the artifacts
+    /// dominated by constant pools and metadata. Distribution ships the
+    /// containers only; loading a module expands them in place on first
+    /// access (see serverlib::DynamicModule).
+    llvm::Error compressArtifacts();
+    /// Compress the file `path` into the container `path + COMPRESSED_EXT`.
+    static llvm::Error compressArtifact(std::string path);
+    /// Expand the container `path + COMPRESSED_EXT` back into `path`.
+    static llvm::Error decompressArtifact(std::string path);
     /// After a shared library has been emitted, its path is here
     std::string sharedLibraryPath;
     /// After a static library has been emitted, its path is here
@@ -182,7 +260,7 @@ public:
 
     // For advanced use
     const static std::string OBJECT_EXT, LINKER, LINKER_SHARED_OPT, AR,
-        AR_STATIC_OPT, DOT_STATIC_LIB_EXT, DOT_SHARED_LIB_EXT;
+        AR_STATIC_OPT, DOT_STATIC_LIB_EXT, DOT_SHARED_LIB_EXT, COMPRESSED_EXT;
     void addExtraObjectFilePath(std::string objectFilePath);
     llvm::Expected<std::string>
     emit(std::string path, std::string dotExt, std::string linker,
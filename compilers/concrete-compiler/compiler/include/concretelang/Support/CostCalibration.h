@@ -0,0 +1,40 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SUPPORT_COSTCALIBRATION_H_
+#define CONCRETELANG_SUPPORT_COSTCALIBRATION_H_
+
+namespace mlir {
+namespace concretelang {
+
+/// Cost weights fitted from timings measured on this machine. Each weight
+/// is the measured latency in nanoseconds divided by the abstract
+/// operation count of the optimizer's complexity model for the same
+/// operation, so multiplying the model by the weight yields an estimate
+/// in real time units and the optimizer trades keyswitch against
+/// bootstrap costs at their measured ratio.
+struct CalibratedCostWeights {
+  double keyswitch;
+  double bootstrap;
+};
+
+/// Whether cost calibration was requested, i.e. the environment variable
+/// CONCRETE_OPTIMIZER_CALIBRATE is set to a non-zero value. Calibration is
+/// off by default as it spends a few hundred milliseconds benchmarking on
+/// the first compilation of the process.
+bool useCostCalibration();
+
+/// Returns the cost weights of this machine, running the keyswitch and
+/// bootstrap microbenchmarks on first use and memoizing the result for
+/// the lifetime of the process. When CONCRETE_OPTIMIZER_CALIBRATION_FILE
+/// names a readable file the weights are loaded from it instead, and the
+/// file is written after a fresh measurement so subsequent processes skip
+/// the benchmark.
+CalibratedCostWeights getCalibratedCostWeights();
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
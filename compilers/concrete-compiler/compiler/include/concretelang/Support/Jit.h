@@ -6,7 +6,10 @@
 #ifndef COMPILER_JIT_H
 #define COMPILER_JIT_H
 
-#include <mlir/ExecutionEngine/ExecutionEngine.h>
+#include <functional>
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <mlir/Dialect/LLVMIR/LLVMDialect.h>
 #include <mlir/IR/BuiltinOps.h>
 #include <mlir/Support/LogicalResult.h>
 
@@ -28,10 +31,12 @@ public:
       : type(type), name(name){};
 
   /// create a JITLambda that point to the function name of the given module.
-  /// Use runtimeLibPath as a shared library if specified.
+  /// Use runtimeLibPath as a shared library if specified. Functions of the
+  /// module are compiled lazily, on their first invocation; `optPipeline` is
+  /// copied as it runs when functions materialize, after creation returns.
   static llvm::Expected<std::unique_ptr<JITLambda>>
   create(llvm::StringRef name, mlir::ModuleOp &module,
-         llvm::function_ref<llvm::Error(llvm::Module *)> optPipeline,
+         std::function<llvm::Error(llvm::Module *)> optPipeline,
          std::optional<std::string> runtimeLibPath = {});
 
   /// Call the JIT lambda with the public arguments.
@@ -53,7 +58,7 @@ public:
 private:
   mlir::LLVM::LLVMFunctionType type;
   std::string name;
-  std::unique_ptr<mlir::ExecutionEngine> engine;
+  std::unique_ptr<llvm::orc::LLLazyJIT> jit;
   /// Tell if the DF parallelization was on or during compilation. This will be
   /// useful to abort execution if the runtime doesn't support dataflow
   /// execution, instead of having undefined symbol issues
@@ -13,6 +13,13 @@ namespace concretelang {
 
 llvm::Error emitObject(llvm::Module &module, std::string objectPath);
 
+/// Same as `emitObject` but partitions the module and runs code generation
+/// on up to `maxPartitions` threads, returning the paths of the emitted
+/// object files. Partition object paths are derived from `objectPath`.
+llvm::Expected<std::vector<std::string>>
+emitObjects(llvm::Module &module, std::string objectPath,
+            unsigned maxPartitions);
+
 llvm::Error callCmd(std::string cmd);
 
 llvm::Error emitLibrary(std::vector<std::string> objectsPath,
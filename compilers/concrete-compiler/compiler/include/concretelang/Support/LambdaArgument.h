@@ -8,6 +8,8 @@
 
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include <concretelang/Support/Error.h>
 #include <llvm/ADT/ArrayRef.h>
@@ -154,6 +156,17 @@ public:
       llvm::ArrayRef<int64_t> dimensions)
       : dimensions(dimensions.vec()), value(std::move(value)) {}
 
+  /// Construct a tensor argument referencing the linearized values in
+  /// `value` without copying them. `owner` is kept alive for the
+  /// lifetime of the argument and must keep the external storage valid;
+  /// this allows callers such as the Python bindings to hand over
+  /// foreign buffers without a copy.
+  TensorLambdaArgument(typename ScalarArgumentT::value_type *value,
+                       llvm::ArrayRef<int64_t> dimensions,
+                       std::shared_ptr<void> owner)
+      : dimensions(dimensions.vec()), borrowed(value),
+        owner(std::move(owner)) {}
+
   /// Construct a one-dimensional tensor argument from the
   /// array `value`.
   TensorLambdaArgument(
@@ -187,13 +200,13 @@ public:
   /// Returns a bare pointer to the linearized values of the tensor
   /// (constant version).
   const typename ScalarArgumentT::value_type *getValue() const {
-    return this->value.data();
+    return this->borrowed ? this->borrowed : this->value.data();
   }
 
   /// Returns a bare pointer to the linearized values of the tensor (mutable
   /// version).
   typename ScalarArgumentT::value_type *getValue() {
-    return this->value.data();
+    return this->borrowed ? this->borrowed : this->value.data();
   }
 
   template <typename OtherScalarArgumentT>
@@ -202,8 +215,14 @@ public:
     if (getDimensions() != other.getDimensions())
       return false;
 
-    for (auto pair : llvm::zip(value, other.value)) {
-      if (std::get<0>(pair) != std::get<1>(pair))
+    llvm::Expected<size_t> numElements = getNumElements();
+    if (!numElements) {
+      llvm::consumeError(numElements.takeError());
+      return false;
+    }
+
+    for (size_t i = 0; i < *numElements; i++) {
+      if (getValue()[i] != other.getValue()[i])
         return false;
     }
 
@@ -221,6 +240,11 @@ public:
 protected:
   std::vector<typename ScalarArgumentT::value_type> value;
   std::vector<int64_t> dimensions;
+
+  /// When set, the values live in external storage kept alive by
+  /// `owner` and `value` stays empty.
+  typename ScalarArgumentT::value_type *borrowed = nullptr;
+  std::shared_ptr<void> owner;
 };
 
 template <typename ScalarArgumentT>
@@ -0,0 +1,49 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SUPPORT_OPTIMIZERSOLUTIONCACHE_H_
+#define CONCRETELANG_SUPPORT_OPTIMIZERSOLUTIONCACHE_H_
+
+#include <optional>
+#include <string>
+
+#include "llvm/ADT/StringRef.h"
+
+#include "concretelang/Support/V0Parameters.h"
+
+namespace mlir {
+namespace concretelang {
+namespace optimizer {
+
+/// Returns the directory used to persist optimizer solutions across
+/// compilations, or std::nullopt if the persistent cache is disabled.
+/// The cache is enabled by setting the CONCRETELANG_OPTIMIZER_CACHE_DIR
+/// environment variable to a writable directory.
+std::optional<std::string> solutionCacheDirectory();
+
+/// Computes the cache key of a crypto-parameter search over `dagDump`,
+/// the canonical dump of the optimizer dag, for the given `config`.
+/// `strategyTag` distinguishes searches of different kinds over the
+/// same dag.
+std::string solutionCacheKey(llvm::StringRef dagDump,
+                             llvm::StringRef strategyTag,
+                             const Config &config);
+
+/// Returns the cached solution for `key`, or std::nullopt if the cache
+/// is disabled or does not contain an entry for `key`.
+std::optional<DagSolution> lookupCachedDagSolution(llvm::StringRef key);
+std::optional<CircuitSolution>
+lookupCachedCircuitSolution(llvm::StringRef key);
+
+/// Persists the solution chosen for `key`. Failures to write the cache
+/// entry are silently ignored, since the cache is a pure optimization.
+void cacheSolution(llvm::StringRef key, const DagSolution &solution);
+void cacheSolution(llvm::StringRef key, const CircuitSolution &solution);
+
+} // namespace optimizer
+} // namespace concretelang
+} // namespace mlir
+
+#endif
@@ -11,12 +11,23 @@
 #include <mlir/Support/LogicalResult.h>
 #include <mlir/Transforms/Passes.h>
 
+#include <concretelang/Support/CompilationFeedback.h>
 #include <concretelang/Support/V0Parameters.h>
 
 namespace mlir {
 namespace concretelang {
 namespace pipeline {
 
+/// Returns the wall-clock timings of the pipeline phases that ran on
+/// this thread since the last call, in execution order, and clears the
+/// record. The phases record unconditionally at the cost of one clock
+/// read each, so the timings are always available.
+std::vector<PhaseTiming> consumePhaseTimings();
+
+/// Records a phase timed outside of the pipeline entry points, e.g. the
+/// optimizer parameter search.
+void recordPhaseTiming(PhaseTiming timing);
+
 mlir::LogicalResult autopar(mlir::MLIRContext &context, mlir::ModuleOp &module,
                             std::function<bool(mlir::Pass *)> enablePass);
 
@@ -48,11 +59,32 @@ mlir::LogicalResult
 transformFHEBoolean(mlir::MLIRContext &context, mlir::ModuleOp &module,
                     std::function<bool(mlir::Pass *)> enablePass);
 
+/// Composes chains of constant table lookups into single lookups, so
+/// the intermediate bootstraps disappear from the critical path. Runs
+/// before parameter determination: the optimizer never sees the
+/// removed lookups.
+mlir::LogicalResult
+fuseChainedTLU(mlir::MLIRContext &context, mlir::ModuleOp &module,
+               std::function<bool(mlir::Pass *)> enablePass);
+
+/// Merges duplicated encrypted computations, including the
+/// bootstrap-backed duplicates sitting in sibling branches that
+/// generic CSE alone cannot reach. Runs before TLU fusion and
+/// parameter determination so the optimizer never counts the merged
+/// bootstraps.
+mlir::LogicalResult
+deduplicateFHEOps(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                  std::function<bool(mlir::Pass *)> enablePass);
+
 mlir::LogicalResult
 transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
                    unsigned int chunkSize, unsigned int chunkWidth);
 
+mlir::LogicalResult
+foldCleartextOperations(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                        std::function<bool(mlir::Pass *)> enablePass);
+
 mlir::LogicalResult
 lowerFHEToTFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
                std::optional<V0FHEContext> &fheContext,
@@ -103,13 +135,30 @@ mlir::LogicalResult
 lowerSDFGToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
                std::function<bool(mlir::Pass *)> enablePass);
 
+/// Specializes the lowered circuit for its static shapes: folds the
+/// shape queries and size arithmetic to constants and fully unrolls the
+/// small static batch loops, so a deployment with a fixed batch size
+/// trades artifact generality for tighter inner loops. Runs on the
+/// canonical dialects, after the Concrete and SDFG lowerings.
+mlir::LogicalResult
+specializeStaticShapes(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                       std::function<bool(mlir::Pass *)> enablePass);
+
 mlir::LogicalResult
 lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
                       std::function<bool(mlir::Pass *)> enablePass,
-                      bool parallelizeLoops, bool gpu);
+                      bool parallelizeLoops, bool asyncLoops, bool gpu);
 
+/// Runs the LLVM optimization pipeline on the module. A non-zero
+/// `loopUnrollFactor` and `forceLoopVectorize` are attached as loop
+/// metadata to the lowered levelled loops beforehand, steering the LLVM
+/// unroller and loop vectorizer; `vectorizerReport` prints the loop
+/// vectorizer's remarks (vectorized or not, and why) on stderr.
 mlir::LogicalResult optimizeLLVMModule(llvm::LLVMContext &llvmContext,
-                                       llvm::Module &module);
+                                       llvm::Module &module,
+                                       unsigned loopUnrollFactor = 0,
+                                       bool forceLoopVectorize = false,
+                                       bool vectorizerReport = false);
 
 std::unique_ptr<llvm::Module>
 lowerLLVMDialectToLLVMIR(mlir::MLIRContext &context,
@@ -9,6 +9,7 @@
 #include "concretelang/Dialect/TFHE/IR/TFHEAttrs.h"
 #include "concretelang/Dialect/TFHE/IR/TFHEDialect.h"
 #include "concretelang/Dialect/TFHE/IR/TFHEParameters.h"
+#include <mlir/Dialect/Func/IR/FuncOps.h>
 
 namespace mlir {
 namespace concretelang {
@@ -29,8 +30,12 @@ struct TFHECircuitKeys {
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &OS, const TFHECircuitKeys cks);
 
+/// Extracts the keys used anywhere in the module.
 TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp);
 
+/// Extracts the keys used by the given functions only.
+TFHECircuitKeys extractCircuitKeys(llvm::ArrayRef<mlir::func::FuncOp> funcOps);
+
 } // namespace TFHE
 } // namespace concretelang
 } // namespace mlir
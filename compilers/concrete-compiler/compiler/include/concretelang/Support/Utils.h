@@ -11,6 +11,7 @@
 #include <concretelang/ClientLib/PublicArguments.h>
 #include <concretelang/ClientLib/Serializers.h>
 #include <concretelang/Runtime/context.h>
+#include <concretelang/Runtime/runtime_allocator.h>
 #include <concretelang/ServerLib/ServerLambda.h>
 #include <concretelang/Support/Error.h>
 #include <llvm/ADT/SmallVector.h>
@@ -63,12 +64,16 @@ invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
   }
 
   // Some calls require the runtime context while others don't (in simulation)
-  std::unique_ptr<mlir::concretelang::RuntimeContext> runtimeContext;
+  std::shared_ptr<mlir::concretelang::RuntimeContext> runtimeContext;
   mlir::concretelang::RuntimeContext *rtCtxPtr;
   if (!simulation) {
     assert(evaluationKeys.has_value() &&
            "evaluation keys are required if not in simulation");
-    runtimeContext = std::make_unique<mlir::concretelang::RuntimeContext>(
+    // Contexts are shared through the registry: every lambda and
+    // invocation over the same keyset reuses one context, so the key
+    // memory and the Fourier conversions are paid once per keyset
+    // rather than per circuit.
+    runtimeContext = mlir::concretelang::RuntimeContextRegistry::instance().get(
         evaluationKeys.value());
     // Pointer on runtime context, the rawArgs take pointer on actual value that
     // is passed to the compiled function.
@@ -79,9 +84,15 @@ invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
   // Outputs
   rawArgs[i++] = reinterpret_cast<void *>(outputs.data());
 
-  // Invoke
-  if (auto err = lambda->invokeRaw(rawArgs)) {
-    return std::move(err);
+  // Invoke, bracketed by the context's invocation epoch so a concurrent
+  // key rotation keeps the keys this invocation started with alive.
+  if (!simulation)
+    runtimeContext->enterInvocation();
+  auto invokeError = lambda->invokeRaw(rawArgs);
+  if (!simulation)
+    runtimeContext->leaveInvocation();
+  if (invokeError) {
+    return std::move(invokeError);
   }
 
   // Store the result to the PublicResult
@@ -141,6 +152,10 @@ invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
     }
   }
 
+  // The results have been copied out of the circuit's buffers; drop the
+  // temporaries the invocation left in the allocation cache.
+  runtime_allocation_cache_release();
+
   return clientlib::PublicResult::fromBuffers(clientParameters,
                                               std::move(buffers));
 }
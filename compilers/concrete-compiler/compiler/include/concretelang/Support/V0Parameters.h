@@ -80,6 +80,13 @@ constexpr concrete_optimizer::Encoding DEFAULT_ENCODING =
 constexpr bool DEFAULT_CACHE_ON_DISK = true;
 constexpr uint32_t DEFAULT_CIPHERTEXT_MODULUS_LOG = 64;
 constexpr uint32_t DEFAULT_FFT_PRECISION = 53;
+/// 0 means one optimizer thread per core
+constexpr uint64_t DEFAULT_THREADS = 0;
+/// 1.0 keeps the abstract operation counts of the complexity model;
+/// calibration (see CostCalibration.h) replaces the weights with values
+/// fitted on timings measured on the deployment machine.
+constexpr double DEFAULT_KS_COST_WEIGHT = 1.0;
+constexpr double DEFAULT_PBS_COST_WEIGHT = 1.0;
 
 /// The strategy of the crypto optimization
 enum Strategy {
@@ -95,7 +102,11 @@ enum Strategy {
 
 std::string const StrategyLabel[] = {"V0", "dag-mono", "dag-multi"};
 
-constexpr Strategy DEFAULT_STRATEGY = Strategy::DAG_MONO;
+/// DAG_MULTI lets sub-circuits of different precisions run with their own
+/// keys instead of sizing a single key set for the worst-case operation;
+/// getSolution falls back to DAG_MONO when the multi-parameter search is
+/// not applicable or finds no feasible solution.
+constexpr Strategy DEFAULT_STRATEGY = Strategy::DAG_MULTI;
 
 struct Config {
   double p_error;
@@ -109,6 +120,9 @@ struct Config {
   bool cache_on_disk;
   uint32_t ciphertext_modulus_log;
   uint32_t fft_precision;
+  uint64_t threads;
+  double ks_cost_weight;
+  double pbs_cost_weight;
 };
 
 constexpr Config DEFAULT_CONFIG = {
@@ -123,6 +137,9 @@ constexpr Config DEFAULT_CONFIG = {
     DEFAULT_CACHE_ON_DISK,
     DEFAULT_CIPHERTEXT_MODULUS_LOG,
     DEFAULT_FFT_PRECISION,
+    DEFAULT_THREADS,
+    DEFAULT_KS_COST_WEIGHT,
+    DEFAULT_PBS_COST_WEIGHT,
 };
 
 using Dag = rust::Box<concrete_optimizer::OperationDag>;
@@ -147,6 +164,20 @@ llvm::Expected<optimizer::Solution>
 getSolution(optimizer::Description &descr, CompilationFeedback &feedback,
             optimizer::Config optimizerConfig);
 
+/// Run the parameter search once per optimizer strategy and return the
+/// solution with the lowest modeled complexity among the candidates that
+/// meet the error constraints of `optimizerConfig` (the configured
+/// strategy is ignored). The candidates are compared on the modeled
+/// latency and error probability the optimizer reports in the
+/// CompilationFeedback -- the same quantities a simulated execution of
+/// the candidate would observe -- so the comparison costs three searches
+/// instead of three compile+keygen+run cycles. `feedback` is filled from
+/// the winning candidate.
+llvm::Expected<optimizer::Solution>
+getAutotunedSolution(optimizer::Description &descr,
+                     CompilationFeedback &feedback,
+                     optimizer::Config optimizerConfig);
+
 // As for now the solution which contains a crt encoding is mono parameter only
 // we have some parts of the pipeline that rely on that.
 // TODO: Remove this function
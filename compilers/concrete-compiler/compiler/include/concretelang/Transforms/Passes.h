@@ -9,6 +9,7 @@
 #include <mlir/Dialect/Func/IR/FuncOps.h>
 #include <mlir/Dialect/MemRef/IR/MemRef.h>
 #include <mlir/Dialect/SCF/IR/SCF.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
 #include <mlir/Pass/Pass.h>
 
 #define GEN_PASS_CLASSES
@@ -22,6 +23,11 @@ createCollapseParallelLoops();
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createForLoopToParallel();
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
 createBatchingPass(int64_t maxBatchSize = std::numeric_limits<int64_t>::max());
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createBatchingRelayoutCleanup();
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createBatchedCopyElision();
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createUnrollSmallStaticLoops(int64_t maxTripCount = 8);
 } // namespace concretelang
 } // namespace mlir
 
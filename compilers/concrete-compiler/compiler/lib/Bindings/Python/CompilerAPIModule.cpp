@@ -5,13 +5,16 @@
 
 #include "concretelang/Bindings/Python/CompilerAPIModule.h"
 #include "concretelang/Bindings/Python/CompilerEngine.h"
+#include "concretelang/ClientLib/Serializers.h"
 #include "concretelang/Dialect/FHE/IR/FHEOpsDialect.h.inc"
+#include "concretelang/Runtime/runtime_api.h"
 #include "concretelang/Support/JITSupport.h"
 #include "concretelang/Support/Jit.h"
 #include <mlir/Dialect/Func/IR/FuncOps.h>
 #include <mlir/Dialect/MemRef/IR/MemRef.h>
 #include <mlir/ExecutionEngine/OptUtils.h>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
@@ -23,6 +26,136 @@ using mlir::concretelang::CompilationOptions;
 using mlir::concretelang::JITSupport;
 using mlir::concretelang::LambdaArgument;
 
+namespace {
+
+/// Wraps a NumPy buffer into a tensor argument without copying: the
+/// argument borrows the array storage and keeps the array alive for its
+/// own lifetime. `forcecast` first makes a contiguous, correctly-typed
+/// copy when the input is not already one (wrong dtype, strided view or
+/// plain Python list), so layout-incompatible inputs still work.
+template <typename T>
+lambdaArgument lambdaArgumentFromTensorNoCopy(
+    pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>
+        tensor,
+    std::vector<int64_t> dimensions) {
+  auto array = std::make_shared<pybind11::array_t<
+      T, pybind11::array::c_style | pybind11::array::forcecast>>(
+      std::move(tensor));
+  // The engine only reads argument storage, so a read-only NumPy array
+  // may be borrowed through a mutable pointer.
+  T *data = const_cast<T *>(array->data());
+  return lambdaArgument{
+      std::make_shared<mlir::concretelang::TensorLambdaArgument<
+          mlir::concretelang::IntLambdaArgument<T>>>(data, dimensions,
+                                                     std::move(array))};
+}
+
+/// Exposes the storage of `lambda_arg` as a NumPy array of the
+/// argument's native element type, without copying; the capsule base
+/// keeps the argument alive for as long as the array is. Returns `none`
+/// when the argument is not a tensor of `T`.
+template <typename T>
+pybind11::object tryTensorDataAsArray(lambdaArgument &lambda_arg) {
+  auto arg = lambda_arg.ptr->dyn_cast<mlir::concretelang::TensorLambdaArgument<
+      mlir::concretelang::IntLambdaArgument<T>>>();
+  if (arg == nullptr)
+    return pybind11::none();
+  auto *keepAlive =
+      new std::shared_ptr<mlir::concretelang::LambdaArgument>(lambda_arg.ptr);
+  pybind11::capsule base(keepAlive, [](void *ptr) {
+    delete static_cast<std::shared_ptr<mlir::concretelang::LambdaArgument> *>(
+        ptr);
+  });
+  const T *data = arg->getValue();
+  return pybind11::array_t<T>(arg->getDimensions(), data, base);
+}
+
+pybind11::object tensorDataAsArray(lambdaArgument &lambda_arg) {
+  pybind11::object res;
+  if (!(res = tryTensorDataAsArray<uint64_t>(lambda_arg)).is_none() ||
+      !(res = tryTensorDataAsArray<uint8_t>(lambda_arg)).is_none() ||
+      !(res = tryTensorDataAsArray<uint16_t>(lambda_arg)).is_none() ||
+      !(res = tryTensorDataAsArray<uint32_t>(lambda_arg)).is_none())
+    return res;
+  throw std::invalid_argument(
+      "LambdaArgument isn't a tensor or has an unsupported bitwidth");
+}
+
+pybind11::object signedTensorDataAsArray(lambdaArgument &lambda_arg) {
+  pybind11::object res;
+  if (!(res = tryTensorDataAsArray<int64_t>(lambda_arg)).is_none() ||
+      !(res = tryTensorDataAsArray<int8_t>(lambda_arg)).is_none() ||
+      !(res = tryTensorDataAsArray<int16_t>(lambda_arg)).is_none() ||
+      !(res = tryTensorDataAsArray<int32_t>(lambda_arg)).is_none())
+    return res;
+  throw std::invalid_argument(
+      "LambdaArgument isn't a tensor or has an unsupported bitwidth");
+}
+
+/// Operation names indexed by runtime_stats_op, used as keys of the
+/// snapshot dictionary.
+const char *statsOpName(int op) {
+  switch (op) {
+  case RUNTIME_STATS_OP_KEYSWITCH:
+    return "keyswitch";
+  case RUNTIME_STATS_OP_BOOTSTRAP:
+    return "bootstrap";
+  case RUNTIME_STATS_OP_WOP_PBS:
+    return "wop_pbs";
+  }
+  return "unknown";
+}
+
+/// Gathers every aggregated runtime counter in one binding call: per
+/// operation NumPy vectors indexed like `operations`, one (operation,
+/// bucket) matrix for the power-of-two nanosecond latency histograms,
+/// and the scalar GPU transfer and allocation gauges.
+pybind11::dict runtimeStatsSnapshot() {
+  pybind11::array_t<uint64_t> counts(RUNTIME_STATS_OP_NUM);
+  pybind11::array_t<uint64_t> invocations(RUNTIME_STATS_OP_NUM);
+  pybind11::array_t<uint64_t> time_ns(RUNTIME_STATS_OP_NUM);
+  pybind11::array_t<uint64_t> histograms(
+      {RUNTIME_STATS_OP_NUM, RUNTIME_STATS_HIST_BUCKETS});
+  auto hist = histograms.mutable_unchecked<2>();
+  pybind11::list operations;
+  for (int op = 0; op < RUNTIME_STATS_OP_NUM; op++) {
+    auto statsOp = (runtime_stats_op)op;
+    operations.append(statsOpName(op));
+    counts.mutable_at(op) = runtime_stats_get_count(statsOp);
+    invocations.mutable_at(op) = runtime_stats_get_invocations(statsOp);
+    time_ns.mutable_at(op) = runtime_stats_get_time_ns(statsOp);
+    for (int bucket = 0; bucket < RUNTIME_STATS_HIST_BUCKETS; bucket++)
+      hist(op, bucket) = runtime_stats_get_histogram_bucket(statsOp, bucket);
+  }
+  pybind11::dict snapshot;
+  snapshot["operations"] = operations;
+  snapshot["count"] = counts;
+  snapshot["invocations"] = invocations;
+  snapshot["time_ns"] = time_ns;
+  snapshot["histogram_ns"] = histograms;
+  snapshot["gpu_bytes_in"] = runtime_stats_get_gpu_bytes_in();
+  snapshot["gpu_bytes_out"] = runtime_stats_get_gpu_bytes_out();
+  snapshot["allocated_bytes"] = runtime_stats_get_allocated_bytes();
+  snapshot["peak_allocated_bytes"] = runtime_stats_get_peak_allocated_bytes();
+  return snapshot;
+}
+
+/// Python callable invoked with a fresh snapshot after each server call,
+/// or none. Heap-allocated so it is never destroyed after interpreter
+/// shutdown.
+pybind11::object &invocationCallback() {
+  static pybind11::object *callback = new pybind11::object(pybind11::none());
+  return *callback;
+}
+
+void notifyInvocationCallback() {
+  pybind11::object &callback = invocationCallback();
+  if (callback && !callback.is_none())
+    callback(runtimeStatsSnapshot());
+}
+
+} // namespace
+
 class SignalGuard {
 public:
   SignalGuard() { previousHandler = signal(SIGINT, SignalGuard::handler); }
@@ -49,6 +182,14 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
 
   m.def("init_df_parallelization", &initDataflowParallelization);
 
+  m.def("runtime_stats_snapshot", []() { return runtimeStatsSnapshot(); });
+
+  m.def("runtime_stats_reset", []() { runtime_stats_reset(); });
+
+  m.def("set_invocation_callback", [](pybind11::object callback) {
+    invocationCallback() = std::move(callback);
+  });
+
   pybind11::enum_<optimizer::Strategy>(m, "OptimizerStrategy")
       .value("V0", optimizer::Strategy::V0)
       .value("DAG_MONO", optimizer::Strategy::DAG_MONO)
@@ -70,6 +211,10 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                                       bool b) { options.autoParallelize = b; })
       .def("set_loop_parallelize", [](CompilationOptions &options,
                                       bool b) { options.loopParallelize = b; })
+      .def("set_async_loop_parallelize",
+           [](CompilationOptions &options, bool b) {
+             options.asyncLoopParallelize = b;
+           })
       .def("set_dataflow_parallelize",
            [](CompilationOptions &options, bool b) {
              options.dataflowParallelize = b;
@@ -122,7 +267,19 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                     &mlir::concretelang::CompilationFeedback::totalOutputsSize)
       .def_readonly(
           "crt_decompositions_of_outputs",
-          &mlir::concretelang::CompilationFeedback::crtDecompositionsOfOutputs);
+          &mlir::concretelang::CompilationFeedback::crtDecompositionsOfOutputs)
+      .def_readonly("total_pbs_count",
+                    &mlir::concretelang::CompilationFeedback::totalPBSCount)
+      .def_readonly("total_ks_count",
+                    &mlir::concretelang::CompilationFeedback::totalKSCount)
+      .def_readonly("total_wop_pbs_count",
+                    &mlir::concretelang::CompilationFeedback::totalWopPBSCount)
+      .def_readonly("total_intermediate_ciphertext_size",
+                    &mlir::concretelang::CompilationFeedback::
+                        totalIntermediateCiphertextSize)
+      .def_readonly("peak_intermediate_ciphertext_size",
+                    &mlir::concretelang::CompilationFeedback::
+                        peakIntermediateCiphertextSize);
 
   pybind11::class_<mlir::concretelang::JitCompilationResult>(
       m, "JITCompilationResult");
@@ -161,8 +318,10 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
               clientlib::PublicArguments &publicArguments,
               clientlib::EvaluationKeys &evaluationKeys) {
              SignalGuard signalGuard;
-             return jit_server_call(support, lambda, publicArguments,
-                                    evaluationKeys);
+             auto res = jit_server_call(support, lambda, publicArguments,
+                                        evaluationKeys);
+             notifyInvocationCallback();
+             return res;
            });
 
   pybind11::class_<mlir::concretelang::LibraryCompilationResult>(
@@ -213,8 +372,10 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
               clientlib::PublicArguments &publicArguments,
               clientlib::EvaluationKeys &evaluationKeys) {
              SignalGuard signalGuard;
-             return library_server_call(support, lambda, publicArguments,
-                                        evaluationKeys);
+             auto res = library_server_call(support, lambda, publicArguments,
+                                            evaluationKeys);
+             notifyInvocationCallback();
+             return res;
            })
       .def("simulate",
            [](LibrarySupport_Py &support, serverlib::ServerLambda lambda,
@@ -526,43 +687,38 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                   [](const pybind11::bytes &buffer) {
                     return evaluationKeysUnserialize(buffer);
                   })
-      .def("serialize", [](clientlib::EvaluationKeys &evaluationKeys) {
-        return pybind11::bytes(evaluationKeysSerialize(evaluationKeys));
-      });
+      .def("serialize",
+           [](clientlib::EvaluationKeys &evaluationKeys) {
+             return pybind11::bytes(evaluationKeysSerialize(evaluationKeys));
+           })
+      .def_static("load_snapshot",
+                  [](const std::string &path) {
+                    auto keys = clientlib::loadEvaluationKeysSnapshot(path);
+                    if (keys.has_error()) {
+                      throw std::runtime_error(
+                          keys.error().mesg);
+                    }
+                    return keys.value();
+                  })
+      .def("save_snapshot",
+           [](clientlib::EvaluationKeys &evaluationKeys,
+              const std::string &path) {
+             auto res =
+                 clientlib::saveEvaluationKeysSnapshot(evaluationKeys, path);
+             if (res.has_error()) {
+               throw std::runtime_error(res.error().mesg);
+             }
+           });
 
   pybind11::class_<lambdaArgument>(m, "LambdaArgument")
-      .def_static("from_tensor_u8",
-                  [](std::vector<uint8_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorU8(tensor, dims);
-                  })
-      .def_static("from_tensor_u16",
-                  [](std::vector<uint16_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorU16(tensor, dims);
-                  })
-      .def_static("from_tensor_u32",
-                  [](std::vector<uint32_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorU32(tensor, dims);
-                  })
-      .def_static("from_tensor_u64",
-                  [](std::vector<uint64_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorU64(tensor, dims);
-                  })
-      .def_static("from_tensor_i8",
-                  [](std::vector<int8_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorI8(tensor, dims);
-                  })
-      .def_static("from_tensor_i16",
-                  [](std::vector<int16_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorI16(tensor, dims);
-                  })
-      .def_static("from_tensor_i32",
-                  [](std::vector<int32_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorI32(tensor, dims);
-                  })
-      .def_static("from_tensor_i64",
-                  [](std::vector<int64_t> tensor, std::vector<int64_t> dims) {
-                    return lambdaArgumentFromTensorI64(tensor, dims);
-                  })
+      .def_static("from_tensor_u8", lambdaArgumentFromTensorNoCopy<uint8_t>)
+      .def_static("from_tensor_u16", lambdaArgumentFromTensorNoCopy<uint16_t>)
+      .def_static("from_tensor_u32", lambdaArgumentFromTensorNoCopy<uint32_t>)
+      .def_static("from_tensor_u64", lambdaArgumentFromTensorNoCopy<uint64_t>)
+      .def_static("from_tensor_i8", lambdaArgumentFromTensorNoCopy<int8_t>)
+      .def_static("from_tensor_i16", lambdaArgumentFromTensorNoCopy<int16_t>)
+      .def_static("from_tensor_i32", lambdaArgumentFromTensorNoCopy<int32_t>)
+      .def_static("from_tensor_i64", lambdaArgumentFromTensorNoCopy<int64_t>)
       .def_static("from_scalar", lambdaArgumentFromScalar)
       .def_static("from_signed_scalar", lambdaArgumentFromSignedScalar)
       .def("is_tensor",
@@ -571,11 +727,11 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            })
       .def("get_tensor_data",
            [](lambdaArgument &lambda_arg) {
-             return lambdaArgumentGetTensorData(lambda_arg);
+             return tensorDataAsArray(lambda_arg);
            })
       .def("get_signed_tensor_data",
            [](lambdaArgument &lambda_arg) {
-             return lambdaArgumentGetSignedTensorData(lambda_arg);
+             return signedTensorDataAsArray(lambda_arg);
            })
       .def("get_tensor_shape",
            [](lambdaArgument &lambda_arg) {
@@ -360,12 +360,10 @@ MLIR_CAPI_EXPORTED std::vector<R> copyTensorLambdaArgumentTo64bitsvector(
        << llvm::toString(std::move(numElements.takeError()));
     throw std::runtime_error(os.str());
   }
-  std::vector<R> res;
-  res.reserve(*numElements);
   T *data = tensor->getValue();
-  for (size_t i = 0; i < *numElements; i++) {
-    res.push_back(data[i]);
-  }
+  // Range construction converts in one vectorizable pass, without the
+  // per-element capacity checks of push_back
+  std::vector<R> res(data, data + *numElements);
   return res;
 }
 
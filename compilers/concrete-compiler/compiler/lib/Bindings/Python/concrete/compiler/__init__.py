@@ -10,6 +10,11 @@ from mlir._mlir_libs._concretelang._compiler import (
     init_df_parallelization as _init_df_parallelization,
 )
 from mlir._mlir_libs._concretelang._compiler import round_trip as _round_trip
+from mlir._mlir_libs._concretelang._compiler import (
+    runtime_stats_snapshot as _runtime_stats_snapshot,
+    runtime_stats_reset as _runtime_stats_reset,
+    set_invocation_callback as _set_invocation_callback,
+)
 
 # pylint: enable=no-name-in-module,import-error
 
@@ -67,3 +72,42 @@ def round_trip(mlir_str: str) -> str:
     if not isinstance(mlir_str, str):
         raise TypeError(f"mlir_str must be of type str, not {type(mlir_str)}")
     return _round_trip(mlir_str)
+
+
+def runtime_stats_snapshot() -> dict:
+    """Fetch all aggregated runtime counters in a single native call.
+
+    Returns:
+        dict: 'operations' names the instrumented operations; 'count',
+            'invocations' and 'time_ns' are uint64 NumPy vectors indexed
+            like it; 'histogram_ns' is a uint64 (operation, bucket) NumPy
+            matrix of power-of-two nanosecond latency buckets; the
+            remaining keys are scalar GPU transfer and allocation gauges
+    """
+    return _runtime_stats_snapshot()
+
+
+def runtime_stats_reset():
+    """Zero all runtime counters, e.g. between two served invocations."""
+    _runtime_stats_reset()
+
+
+def set_invocation_callback(callback):
+    """Register a callback invoked after each completed server call.
+
+    The callback receives the result of runtime_stats_snapshot() taken
+    right after the invocation completed, so a serving layer can export
+    per-invocation latency histograms without polling.
+
+    Args:
+        callback: a callable taking the snapshot dict, or None to
+            unregister
+
+    Raises:
+        TypeError: if callback is neither callable nor None
+    """
+    if callback is not None and not callable(callback):
+        raise TypeError(
+            f"callback must be callable or None, not {type(callback)}"
+        )
+    _set_invocation_callback(callback)
@@ -189,7 +189,9 @@ class ClientSupport(WrapperCpp):
             )
 
         if lambda_arg.is_tensor():
-            return np.array(
+            # get_tensor_data returns a view over the result storage, so
+            # asarray only copies when the element type has to change
+            return np.asarray(
                 lambda_arg.get_signed_tensor_data()
                 if is_signed
                 else lambda_arg.get_tensor_data(),
@@ -245,34 +247,34 @@ class ClientSupport(WrapperCpp):
             return LambdaArgument.from_scalar(value)
         if value.dtype == np.uint8:
             return LambdaArgument.from_tensor_u8(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.uint16:
             return LambdaArgument.from_tensor_u16(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.uint32:
             return LambdaArgument.from_tensor_u32(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.uint64:
             return LambdaArgument.from_tensor_u64(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.int8:
             return LambdaArgument.from_tensor_i8(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.int16:
             return LambdaArgument.from_tensor_i16(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.int32:
             return LambdaArgument.from_tensor_i32(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         if value.dtype == np.int64:
             return LambdaArgument.from_tensor_i64(
-                value.flatten().tolist(), list(value.shape)
+                value, list(value.shape)
             )
         raise TypeError("numpy.array must be of dtype (u)int{8,16,32,64}")
@@ -84,6 +84,22 @@ class CompilationOptions(WrapperCpp):
             raise TypeError("can't set the option to a non-boolean value")
         self.cpp().set_loop_parallelize(loop_parallelize)
 
+    def set_async_loop_parallelize(self, async_loop_parallelize: bool):
+        """Set option for thread-pool based loop parallelization.
+
+        Lowers parallel loops to the MLIR async runtime thread pool instead
+        of OpenMP. Only meaningful together with loop parallelization.
+
+        Args:
+            async_loop_parallelize (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(async_loop_parallelize, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_async_loop_parallelize(async_loop_parallelize)
+
     def set_verify_diagnostics(self, verify_diagnostics: bool):
         """Set option for diagnostics verification.
 
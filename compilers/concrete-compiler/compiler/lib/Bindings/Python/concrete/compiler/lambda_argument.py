@@ -2,7 +2,9 @@
 #  See https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt for license information.
 
 """LambdaArgument."""
-from typing import List
+from typing import List, Union
+
+import numpy as np
 
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
@@ -82,11 +84,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_signed_scalar(scalar))
 
     @staticmethod
-    def from_tensor_u8(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_u8(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -95,11 +99,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_u8(data, shape))
 
     @staticmethod
-    def from_tensor_u16(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_u16(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -108,11 +114,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_u16(data, shape))
 
     @staticmethod
-    def from_tensor_u32(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_u32(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -121,11 +129,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_u32(data, shape))
 
     @staticmethod
-    def from_tensor_u64(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_u64(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -134,11 +144,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_u64(data, shape))
 
     @staticmethod
-    def from_tensor_i8(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_i8(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -147,11 +159,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_i8(data, shape))
 
     @staticmethod
-    def from_tensor_i16(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_i16(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -160,11 +174,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_i16(data, shape))
 
     @staticmethod
-    def from_tensor_i32(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_i32(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -173,11 +189,13 @@ class LambdaArgument(WrapperCpp):
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_i32(data, shape))
 
     @staticmethod
-    def from_tensor_i64(data: List[int], shape: List[int]) -> "LambdaArgument":
+    def from_tensor_i64(data: Union[List[int], np.ndarray], shape: List[int]) -> "LambdaArgument":
         """Build a LambdaArgument containing the given tensor.
 
         Args:
-            data (List[int]): flattened tensor data
+            data (Union[List[int], np.ndarray]): flattened tensor data; a
+                contiguous NumPy array of the matching dtype is used without
+                a copy
             shape (List[int]): shape of original tensor before flattening
 
         Returns:
@@ -3,6 +3,7 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <cassert>
 #include <cstddef>
 #include <stdio.h>
 
@@ -94,6 +95,70 @@ uint64_t decode(uint64_t val, uint64_t modulus) {
   result = result / ((__uint128_t)(1) << 64);
   return (uint64_t)result % modulus;
 }
+
+/// Returns floor(a * b / 2^64)
+static inline uint64_t mulhi(uint64_t a, uint64_t b) {
+  return (uint64_t)(((__uint128_t)a * b) >> 64);
+}
+
+Decomposer::Decomposer(std::vector<int64_t> moduli) : moduli(moduli) {
+  product = productOfModuli(moduli);
+  reciprocals.reserve(moduli.size());
+  reciprocalRests.reserve(moduli.size());
+  icrtCoefficients.reserve(moduli.size());
+  for (auto signedModulus : moduli) {
+    uint64_t modulus = signedModulus;
+    // The Barrett approximations below rely on small moduli
+    assert(modulus > 1 && modulus < ((uint64_t)1 << 31));
+    uint64_t reciprocal = UINT64_MAX / modulus;
+    reciprocals.push_back(reciprocal);
+    // 2^64 = reciprocal * modulus + rest, computed with wraparound
+    reciprocalRests.push_back((uint64_t)0 - reciprocal * modulus);
+    int64_t tmp = product / modulus;
+    icrtCoefficients.push_back((uint64_t)(modInverse(tmp, modulus) * tmp));
+  }
+}
+
+uint64_t Decomposer::encode(int64_t plaintext, size_t blockIndex) const {
+  uint64_t modulus = moduli[blockIndex];
+  // values are represented on the interval [0; product[ so we represent
+  // plaintext on this interval
+  uint64_t value = plaintext < 0 ? product + plaintext : plaintext;
+  // m = value % modulus, the Barrett approximated quotient underestimates
+  // the true one by at most two
+  uint64_t m = value - mulhi(value, reciprocals[blockIndex]) * modulus;
+  while (m >= modulus) {
+    m -= modulus;
+  }
+  // floor(m * 2^64 / modulus) = m * reciprocal + floor(m * rest / modulus)
+  // as 2^64 = reciprocal * modulus + rest
+  uint64_t t = m * reciprocalRests[blockIndex];
+  uint64_t quotient = mulhi(t, reciprocals[blockIndex]);
+  uint64_t rest = t - quotient * modulus;
+  while (rest >= modulus) {
+    quotient += 1;
+    rest -= modulus;
+  }
+  return m * reciprocals[blockIndex] + quotient;
+}
+
+uint64_t Decomposer::decode(uint64_t val, size_t blockIndex) const {
+  uint64_t modulus = moduli[blockIndex];
+  auto result = (__uint128_t)val * (__uint128_t)modulus;
+  result = result + ((result & ((__uint128_t)(1) << 63)) << 1);
+  result = result / ((__uint128_t)(1) << 64);
+  uint64_t decoded = (uint64_t)result;
+  return decoded >= modulus ? decoded - modulus : decoded;
+}
+
+uint64_t Decomposer::iCrt(const std::vector<int64_t> &remainders) const {
+  uint64_t result = 0;
+  for (size_t i = 0; i < remainders.size(); i++) {
+    result += (uint64_t)remainders[i] * icrtCoefficients[i];
+  }
+  return result % product;
+}
+
 } // namespace crt
 } // namespace clientlib
 } // namespace concretelang
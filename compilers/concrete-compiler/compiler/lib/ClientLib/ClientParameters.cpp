@@ -3,6 +3,7 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <cstring>
 #include <fstream>
 
 #include "boost/outcome.h"
@@ -59,6 +60,22 @@ std::size_t ClientParameters::hash() {
   for (auto packingKeyswitchKeyParam : packingKeyswitchKeys) {
     packingKeyswitchKeyParam.hash(currentHash);
   }
+  // Unused keys are neither generated nor stored, so parameters with
+  // different key liveness must not share a key cache entry.
+  if (hasKeyLiveness) {
+    for (auto id : usedSecretKeys) {
+      hash_(currentHash, id);
+    }
+    for (auto id : usedBootstrapKeys) {
+      hash_(currentHash, id);
+    }
+    for (auto id : usedKeyswitchKeys) {
+      hash_(currentHash, id);
+    }
+    for (auto id : usedPackingKeyswitchKeys) {
+      hash_(currentHash, id);
+    }
+  }
   return currentHash;
 }
 
@@ -221,25 +238,364 @@ llvm::json::Value toJSON(const ClientParameters &v) {
       {"outputs", v.outputs},
       {"functionName", v.functionName},
   };
+  if (v.hasKeyLiveness) {
+    object.insert({"usedSecretKeys", v.usedSecretKeys});
+    object.insert({"usedBootstrapKeys", v.usedBootstrapKeys});
+    object.insert({"usedKeyswitchKeys", v.usedKeyswitchKeys});
+    object.insert({"usedPackingKeyswitchKeys", v.usedPackingKeyswitchKeys});
+  }
   return object;
 }
 bool fromJSON(const llvm::json::Value j, ClientParameters &v,
               llvm::json::Path p) {
   llvm::json::ObjectMapper O(j, p);
-  return O && O.map("secretKeys", v.secretKeys) &&
-         O.map("bootstrapKeys", v.bootstrapKeys) &&
-         O.map("keyswitchKeys", v.keyswitchKeys) &&
-         O.map("packingKeyswitchKeys", v.packingKeyswitchKeys) &&
-         O.map("inputs", v.inputs) && O.map("outputs", v.outputs) &&
-         O.map("functionName", v.functionName);
+  if (!(O && O.map("secretKeys", v.secretKeys) &&
+        O.map("bootstrapKeys", v.bootstrapKeys) &&
+        O.map("keyswitchKeys", v.keyswitchKeys) &&
+        O.map("packingKeyswitchKeys", v.packingKeyswitchKeys) &&
+        O.map("inputs", v.inputs) && O.map("outputs", v.outputs) &&
+        O.map("functionName", v.functionName))) {
+    return false;
+  }
+  // Key liveness is optional, parameters produced by an older compiler
+  // consider every key as used.
+  auto object = j.getAsObject();
+  v.hasKeyLiveness =
+      object != nullptr && object->get("usedSecretKeys") != nullptr;
+  return !v.hasKeyLiveness ||
+         (O.map("usedSecretKeys", v.usedSecretKeys) &&
+          O.map("usedBootstrapKeys", v.usedBootstrapKeys) &&
+          O.map("usedKeyswitchKeys", v.usedKeyswitchKeys) &&
+          O.map("usedPackingKeyswitchKeys", v.usedPackingKeyswitchKeys));
+}
+
+// Binary sidecar format: fixed-width little-endian fields in the order
+// of the struct declarations, vectors prefixed by their length,
+// optionals by a presence byte. The format is identified by a magic
+// and a version; a reader facing an unknown version falls back to the
+// JSON, so the format can evolve without breaking older artifacts.
+namespace {
+
+const uint32_t BINARY_PARAMS_MAGIC = 0x30425043; // "CPB0"
+const uint32_t BINARY_PARAMS_VERSION = 1;
+
+struct BinaryWriter {
+  std::ostream &out;
+
+  void u8(uint8_t v) { out.write(reinterpret_cast<const char *>(&v), 1); }
+  void u32(uint32_t v) {
+    out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+  }
+  void u64(uint64_t v) {
+    out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+  }
+  void f64(double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    u64(bits);
+  }
+  void str(const std::string &s) {
+    u64(s.size());
+    out.write(s.data(), s.size());
+  }
+  void u64Vec(const std::vector<uint64_t> &v) {
+    u64(v.size());
+    for (auto e : v)
+      u64(e);
+  }
+  void i64Vec(const std::vector<int64_t> &v) {
+    u64(v.size());
+    for (auto e : v)
+      u64((uint64_t)e);
+  }
+};
+
+struct BinaryReader {
+  std::istream &in;
+  bool failed = false;
+
+  uint8_t u8() {
+    uint8_t v = 0;
+    in.read(reinterpret_cast<char *>(&v), 1);
+    failed |= in.fail();
+    return v;
+  }
+  uint32_t u32() {
+    uint32_t v = 0;
+    in.read(reinterpret_cast<char *>(&v), sizeof(v));
+    failed |= in.fail();
+    return v;
+  }
+  uint64_t u64() {
+    uint64_t v = 0;
+    in.read(reinterpret_cast<char *>(&v), sizeof(v));
+    failed |= in.fail();
+    return v;
+  }
+  double f64() {
+    uint64_t bits = u64();
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+  }
+  std::string str() {
+    size_t size = u64();
+    if (failed)
+      return "";
+    std::string s(size, '\0');
+    in.read(&s[0], size);
+    failed |= in.fail();
+    return s;
+  }
+  std::vector<uint64_t> u64Vec() {
+    std::vector<uint64_t> v;
+    size_t size = u64();
+    for (size_t i = 0; i < size && !failed; i++)
+      v.push_back(u64());
+    return v;
+  }
+  std::vector<int64_t> i64Vec() {
+    std::vector<int64_t> v;
+    size_t size = u64();
+    for (size_t i = 0; i < size && !failed; i++)
+      v.push_back((int64_t)u64());
+    return v;
+  }
+};
+
+void writeBinary(BinaryWriter &w, const LweSecretKeyParam &v) {
+  w.u64(v.dimension);
+}
+void readBinary(BinaryReader &r, LweSecretKeyParam &v) {
+  v.dimension = r.u64();
+}
+
+void writeBinary(BinaryWriter &w, const BootstrapKeyParam &v) {
+  w.u64(v.inputSecretKeyID);
+  w.u64(v.outputSecretKeyID);
+  w.u64(v.level);
+  w.u64(v.baseLog);
+  w.u64(v.glweDimension);
+  w.f64(v.variance);
+  w.u64(v.polynomialSize);
+  w.u64(v.inputLweDimension);
+}
+void readBinary(BinaryReader &r, BootstrapKeyParam &v) {
+  v.inputSecretKeyID = r.u64();
+  v.outputSecretKeyID = r.u64();
+  v.level = r.u64();
+  v.baseLog = r.u64();
+  v.glweDimension = r.u64();
+  v.variance = r.f64();
+  v.polynomialSize = r.u64();
+  v.inputLweDimension = r.u64();
+}
+
+void writeBinary(BinaryWriter &w, const KeyswitchKeyParam &v) {
+  w.u64(v.inputSecretKeyID);
+  w.u64(v.outputSecretKeyID);
+  w.u64(v.level);
+  w.u64(v.baseLog);
+  w.f64(v.variance);
+}
+void readBinary(BinaryReader &r, KeyswitchKeyParam &v) {
+  v.inputSecretKeyID = r.u64();
+  v.outputSecretKeyID = r.u64();
+  v.level = r.u64();
+  v.baseLog = r.u64();
+  v.variance = r.f64();
+}
+
+void writeBinary(BinaryWriter &w, const PackingKeyswitchKeyParam &v) {
+  w.u64(v.inputSecretKeyID);
+  w.u64(v.outputSecretKeyID);
+  w.u64(v.level);
+  w.u64(v.baseLog);
+  w.u64(v.glweDimension);
+  w.u64(v.polynomialSize);
+  w.u64(v.inputLweDimension);
+  w.f64(v.variance);
+}
+void readBinary(BinaryReader &r, PackingKeyswitchKeyParam &v) {
+  v.inputSecretKeyID = r.u64();
+  v.outputSecretKeyID = r.u64();
+  v.level = r.u64();
+  v.baseLog = r.u64();
+  v.glweDimension = r.u64();
+  v.polynomialSize = r.u64();
+  v.inputLweDimension = r.u64();
+  v.variance = r.f64();
+}
+
+void writeBinary(BinaryWriter &w, const CircuitGate &v) {
+  w.u8(v.encryption.has_value());
+  if (v.encryption.has_value()) {
+    w.u64(v.encryption->secretKeyID);
+    w.f64(v.encryption->variance);
+    w.u64(v.encryption->encoding.precision);
+    w.i64Vec(v.encryption->encoding.crt);
+    w.u8(v.encryption->encoding.isSigned);
+  }
+  w.u64(v.shape.width);
+  w.i64Vec(v.shape.dimensions);
+  w.u64(v.shape.size);
+  w.u8(v.shape.sign);
+  w.u8(v.chunkInfo.has_value());
+  if (v.chunkInfo.has_value()) {
+    w.u32(v.chunkInfo->size);
+    w.u32(v.chunkInfo->width);
+  }
+}
+void readBinary(BinaryReader &r, CircuitGate &v) {
+  if (r.u8()) {
+    EncryptionGate encryption;
+    encryption.secretKeyID = r.u64();
+    encryption.variance = r.f64();
+    encryption.encoding.precision = r.u64();
+    encryption.encoding.crt = r.i64Vec();
+    encryption.encoding.isSigned = r.u8();
+    v.encryption = encryption;
+  }
+  v.shape.width = r.u64();
+  v.shape.dimensions = r.i64Vec();
+  v.shape.size = r.u64();
+  v.shape.sign = r.u8();
+  if (r.u8()) {
+    ChunkInfo chunkInfo;
+    chunkInfo.size = r.u32();
+    chunkInfo.width = r.u32();
+    v.chunkInfo = chunkInfo;
+  }
+}
+
+template <typename T>
+void writeBinaryVec(BinaryWriter &w, const std::vector<T> &v) {
+  w.u64(v.size());
+  for (auto &e : v)
+    writeBinary(w, e);
+}
+template <typename T>
+void readBinaryVec(BinaryReader &r, std::vector<T> &v) {
+  size_t size = r.u64();
+  for (size_t i = 0; i < size && !r.failed; i++) {
+    T e;
+    readBinary(r, e);
+    v.push_back(std::move(e));
+  }
+}
+
+void writeBinary(BinaryWriter &w, const ClientParameters &v) {
+  writeBinaryVec(w, v.secretKeys);
+  writeBinaryVec(w, v.bootstrapKeys);
+  writeBinaryVec(w, v.keyswitchKeys);
+  writeBinaryVec(w, v.packingKeyswitchKeys);
+  writeBinaryVec(w, v.inputs);
+  writeBinaryVec(w, v.outputs);
+  w.str(v.functionName);
+  w.u8(v.hasKeyLiveness);
+  if (v.hasKeyLiveness) {
+    w.u64Vec(v.usedSecretKeys);
+    w.u64Vec(v.usedBootstrapKeys);
+    w.u64Vec(v.usedKeyswitchKeys);
+    w.u64Vec(v.usedPackingKeyswitchKeys);
+  }
+}
+void readBinary(BinaryReader &r, ClientParameters &v) {
+  readBinaryVec(r, v.secretKeys);
+  readBinaryVec(r, v.bootstrapKeys);
+  readBinaryVec(r, v.keyswitchKeys);
+  readBinaryVec(r, v.packingKeyswitchKeys);
+  readBinaryVec(r, v.inputs);
+  readBinaryVec(r, v.outputs);
+  v.functionName = r.str();
+  v.hasKeyLiveness = r.u8();
+  if (v.hasKeyLiveness) {
+    v.usedSecretKeys = r.u64Vec();
+    v.usedBootstrapKeys = r.u64Vec();
+    v.usedKeyswitchKeys = r.u64Vec();
+    v.usedPackingKeyswitchKeys = r.u64Vec();
+  }
+}
+
+} // namespace
+
+outcome::checked<void, StringError>
+ClientParameters::saveBinary(const std::vector<ClientParameters> &params,
+                             std::string path) {
+  std::ofstream file(path, std::ios::binary);
+  if (file.fail()) {
+    return StringError("Cannot write file: ") << path;
+  }
+  BinaryWriter w{file};
+  w.u32(BINARY_PARAMS_MAGIC);
+  w.u32(BINARY_PARAMS_VERSION);
+  w.u64(params.size());
+  for (auto &p : params)
+    writeBinary(w, p);
+  file.close();
+  if (file.fail()) {
+    return StringError("Cannot write file: ") << path;
+  }
+  return outcome::success();
+}
+
+outcome::checked<std::vector<ClientParameters>, StringError>
+ClientParameters::loadBinary(std::string path) {
+  std::ifstream file(path, std::ios::binary);
+  if (file.fail()) {
+    return StringError("Cannot read file: ") << path;
+  }
+  BinaryReader r{file};
+  if (r.u32() != BINARY_PARAMS_MAGIC) {
+    return StringError("Not a binary client parameters file: ") << path;
+  }
+  if (r.u32() != BINARY_PARAMS_VERSION) {
+    return StringError("Unsupported binary client parameters version: ")
+           << path;
+  }
+  std::vector<ClientParameters> params;
+  size_t size = r.u64();
+  for (size_t i = 0; i < size && !r.failed; i++) {
+    ClientParameters p;
+    readBinary(r, p);
+    params.push_back(std::move(p));
+  }
+  if (r.failed) {
+    return StringError("Truncated binary client parameters file: ") << path;
+  }
+  return params;
 }
 
 std::string ClientParameters::getClientParametersPath(std::string path) {
   return path + CLIENT_PARAMETERS_EXT;
 }
 
+std::string ClientParameters::getClientParametersBinaryPath(
+    std::string jsonPath) {
+  if (jsonPath.size() >= CLIENT_PARAMETERS_EXT.size() &&
+      jsonPath.compare(jsonPath.size() - CLIENT_PARAMETERS_EXT.size(),
+                       CLIENT_PARAMETERS_EXT.size(),
+                       CLIENT_PARAMETERS_EXT) == 0) {
+    return jsonPath.substr(0, jsonPath.size() - CLIENT_PARAMETERS_EXT.size()) +
+           CLIENT_PARAMETERS_BIN_EXT;
+  }
+  return jsonPath + CLIENT_PARAMETERS_BIN_EXT;
+}
+
 outcome::checked<std::vector<ClientParameters>, StringError>
 ClientParameters::load(std::string jsonPath) {
+  // Prefer the binary sidecar emitted next to the JSON at compile
+  // time. A sidecar that does not decode (e.g. written by a compiler
+  // with a different format version) falls back to the JSON.
+  auto binaryPath = getClientParametersBinaryPath(jsonPath);
+  std::ifstream binaryFile(binaryPath, std::ios::binary);
+  if (!binaryFile.fail()) {
+    binaryFile.close();
+    auto params = loadBinary(binaryPath);
+    if (params.has_value()) {
+      return params;
+    }
+  }
   std::ifstream file(jsonPath);
   std::string content((std::istreambuf_iterator<char>(file)),
                       (std::istreambuf_iterator<char>()));
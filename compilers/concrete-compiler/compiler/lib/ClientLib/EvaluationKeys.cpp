@@ -6,6 +6,7 @@
 #include "concretelang/ClientLib/EvaluationKeys.h"
 #include "concrete-cpu.h"
 #include "concretelang/ClientLib/ClientParameters.h"
+#include <sys/mman.h>
 
 #ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
 inline void getApproval() {
@@ -22,6 +23,26 @@ inline void getApproval() {
 namespace concretelang {
 namespace clientlib {
 
+static struct Uint128 toUint128(__uint128_t value) {
+  struct Uint128 u128;
+  for (int i = 0; i < 16; i++) {
+    u128.little_endian_bytes[i] = value >> (8 * i);
+  }
+  return u128;
+}
+
+// Draws the public mask seed of a seeded key from the keygen csprng, so
+// that the key set remains a deterministic function of the original seed.
+static __uint128_t drawMaskSeed(CSPRNG &csprng) {
+  struct Uint128 u128;
+  csprng.vtable->next_bytes(csprng.ptr, u128.little_endian_bytes, 16);
+  __uint128_t seed = 0;
+  for (int i = 0; i < 16; i++) {
+    seed |= (__uint128_t)u128.little_endian_bytes[i] << (8 * i);
+  }
+  return seed;
+}
+
 ConcreteCSPRNG::ConcreteCSPRNG(__uint128_t seed)
     : CSPRNG(nullptr, &CONCRETE_CSPRNG_VTABLE) {
   ptr = (Csprng *)aligned_alloc(CONCRETE_CSPRNG_ALIGN, CONCRETE_CSPRNG_SIZE);
@@ -59,6 +80,37 @@ ConcreteCSPRNG::~ConcreteCSPRNG() {
   }
 }
 
+ConcreteCSPRNG::ConcreteCSPRNG(Csprng *ptr)
+    : CSPRNG(ptr, &CONCRETE_CSPRNG_VTABLE) {}
+
+std::vector<ConcreteCSPRNG> ConcreteCSPRNG::fork(CSPRNG &parent,
+                                                 size_t nChildren,
+                                                 size_t bytesPerChild) {
+  std::vector<ConcreteCSPRNG> children;
+  if (parent.vtable != &CONCRETE_CSPRNG_VTABLE) {
+    return children;
+  }
+  children.reserve(nChildren);
+  for (size_t i = 0; i < nChildren; i++) {
+    Csprng *mem =
+        (Csprng *)aligned_alloc(CONCRETE_CSPRNG_ALIGN, CONCRETE_CSPRNG_SIZE);
+    if (concrete_cpu_fork_concrete_csprng(parent.ptr, mem, 1, bytesPerChild) !=
+        0) {
+      free(mem);
+      children.clear();
+      return children;
+    }
+    children.push_back(ConcreteCSPRNG(mem));
+  }
+  return children;
+}
+
+MappedKeyBuffer::~MappedKeyBuffer() {
+  if (_mapping != nullptr) {
+    munmap(_mapping, _mappingSize);
+  }
+}
+
 LweSecretKey::LweSecretKey(LweSecretKeyParam &parameters, CSPRNG &csprng)
     : _parameters(parameters) {
   // Allocate the buffer
@@ -84,6 +136,14 @@ void LweSecretKey::encrypt(uint64_t *ciphertext, uint64_t plaintext,
                                           variance, csprng.ptr, csprng.vtable);
 }
 
+void LweSecretKey::encryptBatch(uint64_t *ciphertexts,
+                                const uint64_t *plaintexts, size_t count,
+                                double variance, CSPRNG &csprng) const {
+  concrete_cpu_encrypt_lwe_ciphertext_batch_u64(
+      _buffer->data(), ciphertexts, plaintexts, count, parameters().dimension,
+      variance, csprng.ptr, csprng.vtable);
+}
+
 void LweSecretKey::decrypt(const uint64_t *ciphertext,
                            uint64_t &plaintext) const {
   concrete_cpu_decrypt_lwe_ciphertext_u64(_buffer->data(), ciphertext,
@@ -94,18 +154,47 @@ LweKeyswitchKey::LweKeyswitchKey(KeyswitchKeyParam &parameters,
                                  LweSecretKey &inputKey,
                                  LweSecretKey &outputKey, CSPRNG &csprng)
     : _parameters(parameters) {
-  // Allocate the buffer
+  // Allocate the buffers
   auto size = concrete_cpu_keyswitch_key_size_u64(
       _parameters.level, _parameters.baseLog, inputKey.dimension(),
       outputKey.dimension());
   _buffer = std::make_shared<std::vector<uint64_t>>();
   _buffer->resize(size);
+  _seededBuffer = std::make_shared<std::vector<uint64_t>>();
+  _seededBuffer->resize(concrete_cpu_seeded_keyswitch_key_size_u64(
+      _parameters.level, inputKey.dimension()));
 
-  // Initialize the keyswitch key buffer
-  concrete_cpu_init_lwe_keyswitch_key_u64(
-      _buffer->data(), inputKey.buffer(), outputKey.buffer(),
+  // The key is generated in seeded form: the masks are a replayable
+  // function of a public seed, so only the bodies and the seed need to
+  // reach the server. The expanded form is rebuilt right away for local
+  // use.
+  _maskSeed = drawMaskSeed(csprng);
+  concrete_cpu_init_seeded_lwe_keyswitch_key_u64(
+      _seededBuffer->data(), inputKey.buffer(), outputKey.buffer(),
       inputKey.dimension(), outputKey.dimension(), _parameters.level,
-      _parameters.baseLog, _parameters.variance, csprng.ptr, csprng.vtable);
+      _parameters.baseLog, _parameters.variance, toUint128(_maskSeed),
+      csprng.ptr, csprng.vtable);
+  concrete_cpu_expand_seeded_lwe_keyswitch_key_u64(
+      _buffer->data(), _seededBuffer->data(), inputKey.dimension(),
+      outputKey.dimension(), _parameters.level, _parameters.baseLog,
+      toUint128(_maskSeed));
+}
+
+LweKeyswitchKey::LweKeyswitchKey(
+    std::shared_ptr<std::vector<uint64_t>> seededBuffer, __uint128_t maskSeed,
+    size_t outputDimension, KeyswitchKeyParam parameters)
+    : _seededBuffer(seededBuffer), _maskSeed(maskSeed),
+      _parameters(parameters) {
+  // The seeded form holds one body word per ciphertext, i.e. level words
+  // per input dimension.
+  size_t inputDimension = _seededBuffer->size() / _parameters.level;
+  _buffer = std::make_shared<std::vector<uint64_t>>();
+  _buffer->resize(concrete_cpu_keyswitch_key_size_u64(
+      _parameters.level, _parameters.baseLog, inputDimension,
+      outputDimension));
+  concrete_cpu_expand_seeded_lwe_keyswitch_key_u64(
+      _buffer->data(), _seededBuffer->data(), inputDimension, outputDimension,
+      _parameters.level, _parameters.baseLog, toUint128(_maskSeed));
 }
 
 LweBootstrapKey::LweBootstrapKey(BootstrapKeyParam &parameters,
@@ -114,19 +203,46 @@ LweBootstrapKey::LweBootstrapKey(BootstrapKeyParam &parameters,
     : _parameters(parameters) {
   // TODO
   size_t polynomial_size = outputKey.dimension() / _parameters.glweDimension;
-  // Allocate the buffer
+  // Allocate the buffers
   auto size = concrete_cpu_bootstrap_key_size_u64(
       _parameters.level, _parameters.glweDimension, polynomial_size,
       inputKey.dimension());
   _buffer = std::make_shared<std::vector<uint64_t>>();
   _buffer->resize(size);
+  _seededBuffer = std::make_shared<std::vector<uint64_t>>();
+  _seededBuffer->resize(concrete_cpu_seeded_bootstrap_key_size_u64(
+      _parameters.level, _parameters.glweDimension, polynomial_size,
+      inputKey.dimension()));
 
-  // Initialize the keyswitch key buffer
-  concrete_cpu_init_lwe_bootstrap_key_u64(
-      _buffer->data(), inputKey.buffer(), outputKey.buffer(),
+  // The key is generated in seeded form: the masks are a replayable
+  // function of a public seed, so only the bodies and the seed need to
+  // reach the server. The expanded form is rebuilt right away for local
+  // use.
+  _maskSeed = drawMaskSeed(csprng);
+  concrete_cpu_init_seeded_lwe_bootstrap_key_u64(
+      _seededBuffer->data(), inputKey.buffer(), outputKey.buffer(),
       inputKey.dimension(), polynomial_size, _parameters.glweDimension,
       _parameters.level, _parameters.baseLog, _parameters.variance,
-      Parallelism::Rayon, csprng.ptr, csprng.vtable);
+      toUint128(_maskSeed), Parallelism::Rayon, csprng.ptr, csprng.vtable);
+  concrete_cpu_expand_seeded_lwe_bootstrap_key_u64(
+      _buffer->data(), _seededBuffer->data(), inputKey.dimension(),
+      polynomial_size, _parameters.glweDimension, _parameters.level,
+      _parameters.baseLog, toUint128(_maskSeed));
+}
+
+LweBootstrapKey::LweBootstrapKey(
+    std::shared_ptr<std::vector<uint64_t>> seededBuffer, __uint128_t maskSeed,
+    BootstrapKeyParam &parameters)
+    : _seededBuffer(seededBuffer), _maskSeed(maskSeed),
+      _parameters(parameters) {
+  _buffer = std::make_shared<std::vector<uint64_t>>();
+  _buffer->resize(concrete_cpu_bootstrap_key_size_u64(
+      _parameters.level, _parameters.glweDimension, _parameters.polynomialSize,
+      _parameters.inputLweDimension));
+  concrete_cpu_expand_seeded_lwe_bootstrap_key_u64(
+      _buffer->data(), _seededBuffer->data(), _parameters.inputLweDimension,
+      _parameters.polynomialSize, _parameters.glweDimension, _parameters.level,
+      _parameters.baseLog, toUint128(_maskSeed));
 }
 
 PackingKeyswitchKey::PackingKeyswitchKey(PackingKeyswitchKeyParam &params,
@@ -10,6 +10,8 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <thread>
 
 namespace concretelang {
 namespace clientlib {
@@ -65,26 +67,155 @@ outcome::checked<void, StringError> KeySet::setupEncryptionMaterial() {
               mapCircuitGateLweSecretKey(_clientParameters.inputs));
   OUTCOME_TRY(this->outputs,
               mapCircuitGateLweSecretKey(_clientParameters.outputs));
+  auto crtDecomposer = [](CircuitGate &gate) {
+    if (gate.encryption.has_value() && !gate.encryption->encoding.crt.empty()) {
+      return crt::Decomposer(gate.encryption->encoding.crt);
+    }
+    return crt::Decomposer();
+  };
+  for (auto &gate : _clientParameters.inputs) {
+    inputCrtDecomposers.push_back(crtDecomposer(gate));
+  }
+  for (auto &gate : _clientParameters.outputs) {
+    outputCrtDecomposers.push_back(crtDecomposer(gate));
+  }
   return outcome::success();
 }
 
 outcome::checked<void, StringError> KeySet::generateKeysFromParams() {
 
-  // Generate LWE secret keys
-  for (auto secretKeyParam : _clientParameters.secretKeys) {
-    OUTCOME_TRYV(this->generateSecretKey(secretKeyParam));
+  // Generate LWE secret keys sequentially, the evaluation keys generated
+  // below are all derived from them. Keys the circuit never uses are stored
+  // as empty placeholders, so that key IDs keep their positional meaning.
+  for (size_t i = 0; i < _clientParameters.secretKeys.size(); i++) {
+    auto param = _clientParameters.secretKeys[i];
+    if (!_clientParameters.isSecretKeyUsed(i)) {
+      secretKeys.push_back(
+          LweSecretKey(std::make_shared<std::vector<uint64_t>>(), param));
+      continue;
+    }
+    OUTCOME_TRYV(this->generateSecretKey(param));
   }
-  // Generate bootstrap keys
-  for (auto bootstrapKeyParam : _clientParameters.bootstrapKeys) {
-    OUTCOME_TRYV(this->generateBootstrapKey(bootstrapKeyParam));
+
+  // Bootstrap, keyswitch and packing keyswitch keys only depend on the
+  // secret keys and not on each other, so generate them concurrently, one
+  // task per key. The shared csprng is not thread safe, hence each task
+  // consumes its own child stream forked off it: the children cover
+  // disjoint ranges of the counter-mode parent stream, so the whole key
+  // set stays a deterministic function of the original seed. If forking
+  // is not available, each task falls back to a freshly seeded stream.
+  size_t numTasks = 0;
+  for (size_t i = 0; i < _clientParameters.bootstrapKeys.size(); i++) {
+    numTasks += _clientParameters.isBootstrapKeyUsed(i) ? 1 : 0;
   }
-  // Generate keyswitch key
-  for (auto keyswitchParam : _clientParameters.keyswitchKeys) {
-    OUTCOME_TRYV(this->generateKeyswitchKey(keyswitchParam));
+  for (size_t i = 0; i < _clientParameters.keyswitchKeys.size(); i++) {
+    numTasks += _clientParameters.isKeyswitchKeyUsed(i) ? 1 : 0;
   }
-  // Generate packing keyswitch key
-  for (auto packingKeyswitchKeyParam : _clientParameters.packingKeyswitchKeys) {
-    OUTCOME_TRYV(this->generatePackingKeyswitchKey(packingKeyswitchKeyParam));
+  for (size_t i = 0; i < _clientParameters.packingKeyswitchKeys.size(); i++) {
+    numTasks += _clientParameters.isPackingKeyswitchKeyUsed(i) ? 1 : 0;
+  }
+  // Generous upper bound on the bytes one key generation draws from its
+  // stream; the parent stream is large enough that overprovisioning costs
+  // nothing.
+  const size_t keygenBytesPerChild = (size_t)1 << 40;
+  std::vector<ConcreteCSPRNG> childCsprngs =
+      ConcreteCSPRNG::fork(csprng, numTasks, keygenBytesPerChild);
+  size_t nextChild = 0;
+  auto taskCsprng = [&]() -> CSPRNG * {
+    return childCsprngs.empty() ? nullptr : &childCsprngs[nextChild++];
+  };
+  std::vector<std::thread> tasks;
+  std::vector<std::optional<LweBootstrapKey>> generatedBsks(
+      _clientParameters.bootstrapKeys.size());
+  std::vector<std::optional<LweKeyswitchKey>> generatedKsks(
+      _clientParameters.keyswitchKeys.size());
+  std::vector<std::optional<PackingKeyswitchKey>> generatedPksks(
+      _clientParameters.packingKeyswitchKeys.size());
+
+  // The spawn loops run in a lambda so a failed secret key lookup does
+  // not return past the threads already started: destroying a joinable
+  // std::thread calls std::terminate, so the tasks are always joined
+  // below before an error is propagated.
+  auto spawnTasks = [&]() -> outcome::checked<void, StringError> {
+    for (size_t i = 0; i < _clientParameters.bootstrapKeys.size(); i++) {
+      auto param = _clientParameters.bootstrapKeys[i];
+      if (!_clientParameters.isBootstrapKeyUsed(i)) {
+        generatedBsks[i].emplace(std::make_shared<std::vector<uint64_t>>(),
+                                 param);
+        continue;
+      }
+      OUTCOME_TRY(auto inputKey, findLweSecretKey(param.inputSecretKeyID));
+      OUTCOME_TRY(auto outputKey, findLweSecretKey(param.outputSecretKeyID));
+      CSPRNG *child = taskCsprng();
+      tasks.push_back(std::thread(
+          [&generatedBsks, i, param, inputKey, outputKey, child]() mutable {
+            if (child != nullptr) {
+              generatedBsks[i].emplace(param, inputKey, outputKey, *child);
+            } else {
+              ConcreteCSPRNG csprng(0);
+              generatedBsks[i].emplace(param, inputKey, outputKey, csprng);
+            }
+          }));
+    }
+    for (size_t i = 0; i < _clientParameters.keyswitchKeys.size(); i++) {
+      auto param = _clientParameters.keyswitchKeys[i];
+      if (!_clientParameters.isKeyswitchKeyUsed(i)) {
+        generatedKsks[i].emplace(std::make_shared<std::vector<uint64_t>>(),
+                                 param);
+        continue;
+      }
+      OUTCOME_TRY(auto inputKey, findLweSecretKey(param.inputSecretKeyID));
+      OUTCOME_TRY(auto outputKey, findLweSecretKey(param.outputSecretKeyID));
+      CSPRNG *child = taskCsprng();
+      tasks.push_back(std::thread(
+          [&generatedKsks, i, param, inputKey, outputKey, child]() mutable {
+            if (child != nullptr) {
+              generatedKsks[i].emplace(param, inputKey, outputKey, *child);
+            } else {
+              ConcreteCSPRNG csprng(0);
+              generatedKsks[i].emplace(param, inputKey, outputKey, csprng);
+            }
+          }));
+    }
+    for (size_t i = 0; i < _clientParameters.packingKeyswitchKeys.size(); i++) {
+      auto param = _clientParameters.packingKeyswitchKeys[i];
+      if (!_clientParameters.isPackingKeyswitchKeyUsed(i)) {
+        generatedPksks[i].emplace(std::make_shared<std::vector<uint64_t>>(),
+                                  param);
+        continue;
+      }
+      OUTCOME_TRY(auto inputKey, findLweSecretKey(param.inputSecretKeyID));
+      OUTCOME_TRY(auto outputKey, findLweSecretKey(param.outputSecretKeyID));
+      CSPRNG *child = taskCsprng();
+      tasks.push_back(std::thread(
+          [&generatedPksks, i, param, inputKey, outputKey, child]() mutable {
+            if (child != nullptr) {
+              generatedPksks[i].emplace(param, inputKey, outputKey, *child);
+            } else {
+              ConcreteCSPRNG csprng(0);
+              generatedPksks[i].emplace(param, inputKey, outputKey, csprng);
+            }
+          }));
+    }
+    return outcome::success();
+  };
+  auto spawned = spawnTasks();
+  for (auto &task : tasks) {
+    task.join();
+  }
+  if (spawned.has_error()) {
+    return std::move(spawned.error());
+  }
+
+  // Store the generated keys in parameter order.
+  for (auto &bsk : generatedBsks) {
+    bootstrapKeys.push_back(std::move(*bsk));
+  }
+  for (auto &ksk : generatedKsks) {
+    keyswitchKeys.push_back(std::move(*ksk));
+  }
+  for (auto &pksk : generatedPksks) {
+    packingKeyswitchKeys.push_back(std::move(*pksk));
   }
   return outcome::success();
 }
@@ -180,6 +311,13 @@ uint64_t bitWidthOfValue(uint64_t value) { return std::ceil(std::log2(value)); }
 
 outcome::checked<void, StringError>
 KeySet::encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input) {
+  return encrypt_lwe(argPos, ciphertext, input, csprng);
+}
+
+outcome::checked<void, StringError> KeySet::encrypt_lwe(size_t argPos,
+                                                        uint64_t *ciphertext,
+                                                        uint64_t input,
+                                                        CSPRNG &csprng) {
   if (argPos >= inputs.size()) {
     return StringError("encrypt_lwe position of argument is too high");
   }
@@ -196,9 +334,9 @@ KeySet::encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input) {
   auto crt = encryption->encoding.crt;
   if (!crt.empty()) {
     // Put each decomposition into a new ciphertext
-    auto product = crt::productOfModuli(crt);
-    for (auto modulus : crt) {
-      auto plaintext = crt::encode(input, modulus, product);
+    const auto &decomposer = inputCrtDecomposers[argPos];
+    for (size_t block = 0; block < decomposer.numBlocks(); block++) {
+      auto plaintext = decomposer.encode(input, block);
       lweSecretKey.encrypt(ciphertext, plaintext, encryption->variance, csprng);
       ciphertext = ciphertext + lweSecretKeyParam.lweSize();
     }
@@ -211,6 +349,86 @@ KeySet::encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input) {
   return outcome::success();
 }
 
+outcome::checked<void, StringError>
+KeySet::encrypt_lwe_batch(size_t argPos, uint64_t *ciphertexts,
+                          const uint64_t *values, size_t count) {
+  return encrypt_lwe_batch(argPos, ciphertexts, values, count, csprng);
+}
+
+outcome::checked<void, StringError>
+KeySet::encrypt_lwe_batch(size_t argPos, uint64_t *ciphertexts,
+                          const uint64_t *values, size_t count,
+                          CSPRNG &csprng) {
+  if (argPos >= inputs.size()) {
+    return StringError("encrypt_lwe_batch position of argument is too high");
+  }
+  const auto &inputSk = inputs[argPos];
+  auto encryption = std::get<0>(inputSk).encryption;
+  if (!encryption.has_value()) {
+    return StringError(
+        "encrypt_lwe_batch the positional argument is not encrypted");
+  }
+  assert(inputSk.second.has_value());
+  auto lweSecretKey = *inputSk.second;
+  auto lweSize = lweSecretKey.parameters().lweSize();
+  // CRT encoding spreads one value over several blocks; keep the
+  // per-value path for it.
+  if (!encryption->encoding.crt.empty()) {
+    for (size_t i = 0; i < count; i++) {
+      OUTCOME_TRYV(
+          encrypt_lwe(argPos, ciphertexts + i * lweSize, values[i], csprng));
+    }
+    return outcome::success();
+  }
+  // Encode once, then submit the whole batch in a single call into the
+  // backend.
+  std::vector<uint64_t> plaintexts(count);
+  for (size_t i = 0; i < count; i++) {
+    plaintexts[i] = values[i] << (64 - (encryption->encoding.precision + 1));
+  }
+  lweSecretKey.encryptBatch(ciphertexts, plaintexts.data(), count,
+                            encryption->variance, csprng);
+  return outcome::success();
+}
+
+outcome::checked<void, StringError>
+KeySet::trivial_encrypt_lwe(size_t argPos, uint64_t *ciphertext,
+                            uint64_t input) {
+  if (argPos >= inputs.size()) {
+    return StringError("trivial_encrypt_lwe position of argument is too high");
+  }
+  const auto &inputSk = inputs[argPos];
+  auto encryption = std::get<0>(inputSk).encryption;
+  if (!encryption.has_value()) {
+    return StringError(
+        "trivial_encrypt_lwe the positional argument is not encrypted");
+  }
+  assert(inputSk.second.has_value());
+  auto lweSize = (*inputSk.second).parameters().lweSize();
+  // A trivial ciphertext is a zero mask followed by the plaintext as body,
+  // no randomness is involved.
+  auto writeTrivial = [&](uint64_t *ct, uint64_t plaintext) {
+    for (size_t i = 0; i < lweSize - 1; i++) {
+      ct[i] = 0;
+    }
+    ct[lweSize - 1] = plaintext;
+  };
+  // CRT encoding - N blocks with crt encoding
+  auto crt = encryption->encoding.crt;
+  if (!crt.empty()) {
+    const auto &decomposer = inputCrtDecomposers[argPos];
+    for (size_t block = 0; block < decomposer.numBlocks(); block++) {
+      writeTrivial(ciphertext, decomposer.encode(input, block));
+      ciphertext = ciphertext + lweSize;
+    }
+    return outcome::success();
+  }
+  // Simple TFHE integers - 1 blocks with one padding bits
+  writeTrivial(ciphertext,
+               input << (64 - (encryption->encoding.precision + 1)));
+  return outcome::success();
+}
+
 outcome::checked<void, StringError>
 KeySet::decrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t &output) {
   if (argPos >= outputs.size()) {
@@ -231,18 +449,19 @@ KeySet::decrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t &output) {
     // CRT encoded TFHE integers
 
     // Decrypt and decode remainders
+    const auto &decomposer = outputCrtDecomposers[argPos];
     std::vector<int64_t> remainders;
-    for (auto modulus : crt) {
+    for (size_t block = 0; block < decomposer.numBlocks(); block++) {
       uint64_t decrypted = 0;
       lweSecretKey.decrypt(ciphertext, decrypted);
 
-      auto plaintext = crt::decode(decrypted, modulus);
+      auto plaintext = decomposer.decode(decrypted, block);
       remainders.push_back(plaintext);
       ciphertext = ciphertext + lweSecretKeyParam.lweSize();
     }
 
     // Compute the inverse crt
-    output = crt::iCrt(crt, remainders);
+    output = decomposer.iCrt(remainders);
 
     // Further decode signed integers
     if (encryption->encoding.isSigned) {
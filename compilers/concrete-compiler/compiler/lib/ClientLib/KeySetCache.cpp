@@ -5,6 +5,7 @@
 
 #include "boost/outcome.h"
 
+#include "concrete-cpu.h"
 #include "concretelang/ClientLib/EvaluationKeys.h"
 #include "concretelang/ClientLib/KeySetCache.h"
 #include "concretelang/ClientLib/Serializers.h"
@@ -13,9 +14,15 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 
+#include <fcntl.h>
 #include <fstream>
+#include <list>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <utime.h>
 
 #ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
@@ -35,6 +42,127 @@ namespace clientlib {
 
 using StringError = concretelang::error::StringError;
 
+namespace {
+
+/// Process-wide LRU of live KeySets, keyed like the on-disk cache
+/// directories, i.e. by client parameters hash and seed. Spares the
+/// deserialization of the keys when several requests of one process ask for
+/// the same key set, they share one copy through shared_ptr handout.
+class SharedKeySetLRU {
+public:
+  static SharedKeySetLRU &instance() {
+    static SharedKeySetLRU lru;
+    return lru;
+  }
+
+  std::shared_ptr<KeySet> lookup(const std::string &key) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+      return nullptr;
+    }
+    // Mark the entry as most recently used
+    order.splice(order.begin(), order, it->second.first);
+    return it->second.second;
+  }
+
+  /// Insert the key set if no entry exists for `key` and return the stored
+  /// one, so that concurrent callers racing on a miss all end up sharing the
+  /// copy of the winner.
+  std::shared_ptr<KeySet> insert(const std::string &key,
+                                 std::shared_ptr<KeySet> keySet) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+      order.splice(order.begin(), order, it->second.first);
+      return it->second.second;
+    }
+    order.push_front(key);
+    entries.insert({key, {order.begin(), keySet}});
+    while (entries.size() > maxEntries) {
+      entries.erase(order.back());
+      order.pop_back();
+    }
+    return keySet;
+  }
+
+private:
+  /// Key sets are big, keep only a few of them live. Evicted entries stay
+  /// alive as long as callers hold their shared_ptr.
+  static const size_t maxEntries = 8;
+
+  std::mutex mutex;
+  std::list<std::string> order;
+  std::map<std::string,
+           std::pair<std::list<std::string>::iterator, std::shared_ptr<KeySet>>>
+      entries;
+};
+
+/// Cache entries carry a manifest of per-key digests, so that loads can
+/// verify the key material in one linear pass over the key words instead
+/// of relying on the deserializer to stumble over corruption. The digest
+/// runs four independent 64-bit mixing lanes over the words, which the
+/// compiler vectorizes; it guards against storage corruption, not against
+/// an adversary, who could rewrite the manifest alongside the keys.
+struct KeyDigest {
+  uint64_t lanes[4];
+
+  bool operator==(const KeyDigest &other) const {
+    return lanes[0] == other.lanes[0] && lanes[1] == other.lanes[1] &&
+           lanes[2] == other.lanes[2] && lanes[3] == other.lanes[3];
+  }
+};
+
+inline uint64_t digestMix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdUL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53UL;
+  x ^= x >> 33;
+  return x;
+}
+
+KeyDigest computeKeyDigest(const uint64_t *words, size_t count) {
+  KeyDigest digest = {{0x243f6a8885a308d3UL, 0x13198a2e03707344UL,
+                       0xa4093822299f31d0UL, 0x082efa98ec4e6c89UL}};
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    for (size_t lane = 0; lane < 4; lane++) {
+      // Mixing the position in makes reordered words change the digest.
+      digest.lanes[lane] =
+          digestMix(digest.lanes[lane] ^ (words[i + lane] + i + lane));
+    }
+  }
+  for (; i < count; i++) {
+    digest.lanes[i % 4] = digestMix(digest.lanes[i % 4] ^ (words[i] + i));
+  }
+  for (size_t lane = 0; lane < 4; lane++) {
+    digest.lanes[lane] = digestMix(digest.lanes[lane] ^ count);
+  }
+  return digest;
+}
+
+const char *digestManifestName = "digests";
+
+/// Parse the digest manifest of a cache folder, one `name lane0..lane3`
+/// line per key file. Entries written before the manifest existed return
+/// an empty map and load unverified, as before.
+std::map<std::string, KeyDigest> loadDigestManifest(std::string folderPath) {
+  std::map<std::string, KeyDigest> digests;
+  llvm::SmallString<0> path(folderPath);
+  llvm::sys::path::append(path, digestManifestName);
+  std::ifstream in((std::string)path);
+  std::string name;
+  KeyDigest digest;
+  while (in >> name >> std::hex >> digest.lanes[0] >> digest.lanes[1] >>
+         digest.lanes[2] >> digest.lanes[3]) {
+    digests.insert({name, digest});
+  }
+  return digests;
+}
+
+} // namespace
+
 template <class Key>
 outcome::checked<Key, StringError> loadKey(llvm::SmallString<0> &path,
                                            Key(deser)(std::istream &istream)) {
@@ -71,6 +199,160 @@ outcome::checked<void, StringError> saveKey(llvm::SmallString<0> &path,
   return outcome::success();
 }
 
+// Evaluation keys are cached with an mmap-friendly layout: a small
+// serialized header (magic word, key parameters, word count) padded to a
+// page boundary, followed by the raw key words. The key buffer can thus be
+// mapped read-only and used zero-copy by the runtime, instead of being
+// deserialized word by word into freshly allocated vectors.
+static const uint64_t mappableKeyMagic = 0x4d41504b45593634; // "MAPKEY64"
+static const size_t mappableKeyHeaderSize = 4096;
+
+template <class Key>
+outcome::checked<void, StringError> saveMappableKey(llvm::SmallString<0> &path,
+                                                    Key key) {
+#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
+  getApproval();
+#endif
+  std::ofstream out((std::string)path, std::ofstream::binary);
+  if (out.fail()) {
+    return StringError("Cannot access " + (std::string)path);
+  }
+  writeWord(out, mappableKeyMagic);
+  out << key.parameters();
+  writeSize(out, (uint64_t)key.size());
+  assert((size_t)out.tellp() <= mappableKeyHeaderSize);
+  std::vector<char> padding(mappableKeyHeaderSize - (size_t)out.tellp(), 0);
+  out.write(padding.data(), padding.size());
+  out.write((const char *)key.buffer(), key.size() * sizeof(uint64_t));
+  if (out.bad()) {
+    return StringError("Cannot save key at path(") << (std::string)path << ")";
+  }
+  out.close();
+  return outcome::success();
+}
+
+template <class Key, class Param>
+outcome::checked<Key, StringError> loadMappableKey(llvm::SmallString<0> &path) {
+#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
+  getApproval();
+#endif
+  std::ifstream in((std::string)path, std::ifstream::binary);
+  if (in.fail()) {
+    return StringError("Cannot access " + (std::string)path);
+  }
+  uint64_t magic;
+  readWord(in, magic);
+  if (in.bad() || magic != mappableKeyMagic) {
+    // Entries with the legacy layout are treated as invalid, which makes the
+    // cache regenerate them with the mappable layout.
+    return StringError("Not a mappable key at path(")
+           << (std::string)path << ")";
+  }
+  Param param;
+  in >> param;
+  uint64_t size;
+  readSize(in, size);
+  if (in.bad()) {
+    return StringError("Cannot load key at path(") << (std::string)path << ")";
+  }
+  in.close();
+
+  int fd = open(((std::string)path).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return StringError("Cannot open " + (std::string)path);
+  }
+  size_t mappingSize = mappableKeyHeaderSize + size * sizeof(uint64_t);
+  void *mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return StringError("Cannot map key at path(") << (std::string)path << ")";
+  }
+  auto buffer = std::make_shared<MappedKeyBuffer>(mapping, mappingSize,
+                                                  mappableKeyHeaderSize, size);
+  return Key(buffer, param);
+}
+
+// The Fourier-domain representation of a bootstrap key is a deterministic
+// function of the key, and converting it costs seconds per key the first
+// time a process touches it. Caching the converted doubles next to the
+// standard key lets server processes map them directly and skip the
+// conversion entirely. The file reuses the mappable layout, the doubles
+// being stored as raw 64-bit words.
+// Returns the digest of the converted doubles for the manifest.
+static outcome::checked<KeyDigest, StringError>
+saveFourierBootstrapKey(llvm::SmallString<0> &path, LweBootstrapKey key) {
+  auto param = key.parameters();
+
+  struct Fft *fft =
+      (struct Fft *)aligned_alloc(CONCRETE_FFT_ALIGN, CONCRETE_FFT_SIZE);
+  concrete_cpu_construct_concrete_fft(fft, param.polynomialSize);
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
+      &scratch_size, &scratch_align, fft);
+  auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  std::vector<double> fourier(key.size());
+  concrete_cpu_bootstrap_key_convert_u64_to_fourier(
+      key.buffer(), fourier.data(), param.level, param.baseLog,
+      param.glweDimension, param.polynomialSize, param.inputLweDimension, fft,
+      scratch, scratch_size);
+  free(scratch);
+  concrete_cpu_destroy_concrete_fft(fft);
+  free(fft);
+
+  std::ofstream out((std::string)path, std::ofstream::binary);
+  if (out.fail()) {
+    return StringError("Cannot access " + (std::string)path);
+  }
+  writeWord(out, mappableKeyMagic);
+  out << param;
+  writeSize(out, (uint64_t)fourier.size());
+  assert((size_t)out.tellp() <= mappableKeyHeaderSize);
+  std::vector<char> padding(mappableKeyHeaderSize - (size_t)out.tellp(), 0);
+  out.write(padding.data(), padding.size());
+  out.write((const char *)fourier.data(), fourier.size() * sizeof(double));
+  if (out.bad()) {
+    return StringError("Cannot save key at path(") << (std::string)path << ")";
+  }
+  out.close();
+  return computeKeyDigest((const uint64_t *)fourier.data(), fourier.size());
+}
+
+static outcome::checked<std::shared_ptr<MappedKeyBuffer>, StringError>
+loadFourierBootstrapKey(llvm::SmallString<0> &path) {
+  std::ifstream in((std::string)path, std::ifstream::binary);
+  if (in.fail()) {
+    return StringError("Cannot access " + (std::string)path);
+  }
+  uint64_t magic;
+  readWord(in, magic);
+  if (in.bad() || magic != mappableKeyMagic) {
+    return StringError("Not a mappable key at path(")
+           << (std::string)path << ")";
+  }
+  BootstrapKeyParam param;
+  in >> param;
+  uint64_t size;
+  readSize(in, size);
+  if (in.bad()) {
+    return StringError("Cannot load key at path(") << (std::string)path << ")";
+  }
+  in.close();
+
+  int fd = open(((std::string)path).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return StringError("Cannot open " + (std::string)path);
+  }
+  size_t mappingSize = mappableKeyHeaderSize + size * sizeof(double);
+  void *mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return StringError("Cannot map key at path(") << (std::string)path << ")";
+  }
+  return std::make_shared<MappedKeyBuffer>(mapping, mappingSize,
+                                           mappableKeyHeaderSize, size);
+}
+
 outcome::checked<std::unique_ptr<KeySet>, StringError>
 KeySetCache::loadKeys(ClientParameters &params, uint64_t seed_msb,
                       uint64_t seed_lsb, std::string folderPath) {
@@ -82,45 +364,111 @@ KeySetCache::loadKeys(ClientParameters &params, uint64_t seed_msb,
   // e.g. so the CI can do some cleanup of unused keys.
   utime(folderPath.c_str(), nullptr);
 
+  // Verify each loaded key against the per-key digest manifest of the
+  // folder: one linear pass over the key words (the mapped buffer for
+  // mappable keys), much cheaper than a re-deserialization sanity pass.
+  // A mismatch invalidates the whole entry and the caller regenerates it.
+  auto digests = loadDigestManifest(folderPath);
+  auto verifyDigest =
+      [&](std::string name, const uint64_t *words,
+          size_t count) -> outcome::checked<void, StringError> {
+    auto digest = digests.find(name);
+    if (digest == digests.end()) {
+      return outcome::success();
+    }
+    if (!(computeKeyDigest(words, count) == digest->second)) {
+      return StringError("Digest mismatch for key ")
+             << name << " in " << folderPath;
+    }
+    return outcome::success();
+  };
+
   std::vector<LweSecretKey> secretKeys;
   std::vector<LweBootstrapKey> bootstrapKeys;
   std::vector<LweKeyswitchKey> keyswitchKeys;
   std::vector<PackingKeyswitchKey> packingKeyswitchKeys;
 
+  // Unused keys are not stored in the cache, empty placeholders keep their
+  // slot so that key IDs keep their positional meaning.
+
   // Load secret keys
   for (auto p : llvm::enumerate(params.secretKeys)) {
     // TODO - Check parameters?
     // auto param = secretKeyParam.second;
+    if (!params.isSecretKeyUsed(p.index())) {
+      secretKeys.push_back(
+          LweSecretKey(std::make_shared<std::vector<uint64_t>>(), p.value()));
+      continue;
+    }
     llvm::SmallString<0> path(folderPath);
     llvm::sys::path::append(path, "secretKey_" + std::to_string(p.index()));
     OUTCOME_TRY(auto key, loadKey(path, readLweSecretKey));
+    OUTCOME_TRYV(verifyDigest("secretKey_" + std::to_string(p.index()),
+                              key.buffer(), key.size()));
     secretKeys.push_back(key);
   }
   // Load bootstrap keys
   for (auto p : llvm::enumerate(params.bootstrapKeys)) {
     // TODO - Check parameters?
     // auto param = p.value();
+    if (!params.isBootstrapKeyUsed(p.index())) {
+      bootstrapKeys.push_back(LweBootstrapKey(
+          std::make_shared<std::vector<uint64_t>>(), p.value()));
+      continue;
+    }
     llvm::SmallString<0> path(folderPath);
     llvm::sys::path::append(path, "pbsKey_" + std::to_string(p.index()));
-    OUTCOME_TRY(auto key, loadKey(path, readLweBootstrapKey));
+    OUTCOME_TRY(auto key,
+                (loadMappableKey<LweBootstrapKey, BootstrapKeyParam>(path)));
+    OUTCOME_TRYV(verifyDigest("pbsKey_" + std::to_string(p.index()),
+                              key.buffer(), key.size()));
     bootstrapKeys.push_back(key);
+    // The Fourier companion is optional: absent or stale entries just
+    // leave the conversion to the runtime, as before.
+    llvm::SmallString<0> fourierPath(folderPath);
+    llvm::sys::path::append(fourierPath,
+                            "pbsFourierKey_" + std::to_string(p.index()));
+    if (llvm::sys::fs::exists(fourierPath)) {
+      auto fourier = loadFourierBootstrapKey(fourierPath);
+      if (fourier.has_value() && fourier.value()->size() == key.size() &&
+          verifyDigest("pbsFourierKey_" + std::to_string(p.index()),
+                       fourier.value()->data(), fourier.value()->size())
+              .has_value()) {
+        bootstrapKeys.back().setFourierBuffer(fourier.value());
+      }
+    }
   }
   // Load keyswitch keys
   for (auto p : llvm::enumerate(params.keyswitchKeys)) {
     // TODO - Check parameters?
     // auto param = p.value();
+    if (!params.isKeyswitchKeyUsed(p.index())) {
+      keyswitchKeys.push_back(LweKeyswitchKey(
+          std::make_shared<std::vector<uint64_t>>(), p.value()));
+      continue;
+    }
     llvm::SmallString<0> path(folderPath);
     llvm::sys::path::append(path, "ksKey_" + std::to_string(p.index()));
-    OUTCOME_TRY(auto key, loadKey(path, readLweKeyswitchKey));
+    OUTCOME_TRY(auto key,
+                (loadMappableKey<LweKeyswitchKey, KeyswitchKeyParam>(path)));
+    OUTCOME_TRYV(verifyDigest("ksKey_" + std::to_string(p.index()),
+                              key.buffer(), key.size()));
     keyswitchKeys.push_back(key);
   }
 
   for (auto p : llvm::enumerate(params.packingKeyswitchKeys)) {
     // TODO - Check parameters?
     // auto param = p.value();
+    if (!params.isPackingKeyswitchKeyUsed(p.index())) {
+      packingKeyswitchKeys.push_back(PackingKeyswitchKey(
+          std::make_shared<std::vector<uint64_t>>(), p.value()));
+      continue;
+    }
     llvm::SmallString<0> path(folderPath);
     llvm::sys::path::append(path, "pksKey_" + std::to_string(p.index()));
     OUTCOME_TRY(auto key, loadKey(path, readPackingKeyswitchKey));
+    OUTCOME_TRYV(verifyDigest("pksKey_" + std::to_string(p.index()),
+                              key.buffer(), key.size()));
     packingKeyswitchKeys.push_back(key);
   }
 
@@ -152,30 +500,81 @@ outcome::checked<void, StringError> saveKeys(KeySet &key_set,
     return StringError("Cannot create directory \"")
            << std::string(folderIncompletePath) << "\": " << err.message();
   }
+  // Unused keys hold empty placeholders and are not worth storing, loading
+  // recreates the placeholders from the client parameters.
+  auto params = key_set.clientParameters();
+
+  // The digests of the saved keys, written out as a manifest next to them
+  // and checked against on load.
+  std::ostringstream manifest;
+  auto recordDigest = [&](std::string name, KeyDigest digest) {
+    manifest << name << std::hex;
+    for (size_t lane = 0; lane < 4; lane++) {
+      manifest << " " << digest.lanes[lane];
+    }
+    manifest << std::dec << "\n";
+  };
+
   // Save LWE secret keys
   for (auto p : llvm::enumerate(key_set.getSecretKeys())) {
-
+    if (!params.isSecretKeyUsed(p.index())) {
+      continue;
+    }
     llvm::SmallString<0> path = folderIncompletePath;
     llvm::sys::path::append(path, "secretKey_" + std::to_string(p.index()));
     OUTCOME_TRYV(saveKey(path, p.value()));
+    recordDigest("secretKey_" + std::to_string(p.index()),
+                 computeKeyDigest(p.value().buffer(), p.value().size()));
   }
   // Save bootstrap keys
   for (auto p : llvm::enumerate(key_set.getBootstrapKeys())) {
+    if (!params.isBootstrapKeyUsed(p.index())) {
+      continue;
+    }
     llvm::SmallString<0> path = folderIncompletePath;
     llvm::sys::path::append(path, "pbsKey_" + std::to_string(p.index()));
-    OUTCOME_TRYV(saveKey(path, p.value()));
+    OUTCOME_TRYV(saveMappableKey(path, p.value()));
+    recordDigest("pbsKey_" + std::to_string(p.index()),
+                 computeKeyDigest(p.value().buffer(), p.value().size()));
+    llvm::SmallString<0> fourierPath = folderIncompletePath;
+    llvm::sys::path::append(fourierPath,
+                            "pbsFourierKey_" + std::to_string(p.index()));
+    OUTCOME_TRY(auto fourierDigest,
+                saveFourierBootstrapKey(fourierPath, p.value()));
+    recordDigest("pbsFourierKey_" + std::to_string(p.index()), fourierDigest);
   }
   // Save keyswitch keys
   for (auto p : llvm::enumerate(key_set.getKeyswitchKeys())) {
+    if (!params.isKeyswitchKeyUsed(p.index())) {
+      continue;
+    }
     llvm::SmallString<0> path = folderIncompletePath;
     llvm::sys::path::append(path, "ksKey_" + std::to_string(p.index()));
-    OUTCOME_TRYV(saveKey(path, p.value()));
+    OUTCOME_TRYV(saveMappableKey(path, p.value()));
+    recordDigest("ksKey_" + std::to_string(p.index()),
+                 computeKeyDigest(p.value().buffer(), p.value().size()));
   }
   // Save packing keyswitch keys
   for (auto p : llvm::enumerate(key_set.getPackingKeyswitchKeys())) {
+    if (!params.isPackingKeyswitchKeyUsed(p.index())) {
+      continue;
+    }
     llvm::SmallString<0> path = folderIncompletePath;
     llvm::sys::path::append(path, "pksKey_" + std::to_string(p.index()));
     OUTCOME_TRYV(saveKey(path, p.value()));
+    recordDigest("pksKey_" + std::to_string(p.index()),
+                 computeKeyDigest(p.value().buffer(), p.value().size()));
+  }
+  // Save the digest manifest
+  {
+    llvm::SmallString<0> path = folderIncompletePath;
+    llvm::sys::path::append(path, digestManifestName);
+    std::ofstream out((std::string)path);
+    out << manifest.str();
+    if (out.bad()) {
+      return StringError("Cannot save digest manifest at path(")
+             << (std::string)path << ")";
+    }
   }
 
   err = llvm::sys::fs::rename(folderIncompletePath, folderPath);
@@ -288,5 +687,46 @@ KeySetCache::generate(ClientParameters &params, uint64_t seed_msb,
   return loadOrGenerateSave(params, seed_msb, seed_lsb);
 }
 
+outcome::checked<std::shared_ptr<KeySet>, StringError>
+KeySetCache::generateShared(std::shared_ptr<KeySetCache> cache,
+                            ClientParameters &params, uint64_t seed_msb,
+                            uint64_t seed_lsb) {
+#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
+  getApproval();
+#endif
+
+  if (cache) {
+    return cache->generateShared(params, seed_msb, seed_lsb);
+  }
+
+  __uint128_t seed = seed_msb;
+  seed <<= 64;
+  seed += seed_lsb;
+
+  auto csprng = ConcreteCSPRNG(seed);
+  OUTCOME_TRY(auto keySet, KeySet::generate(params, std::move(csprng)));
+  return std::shared_ptr<KeySet>(std::move(keySet));
+}
+
+outcome::checked<std::shared_ptr<KeySet>, StringError>
+KeySetCache::generateShared(ClientParameters &params, uint64_t seed_msb,
+                            uint64_t seed_lsb) {
+#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
+  getApproval();
+#endif
+
+  // Same key as the on-disk layout: one folder per parameters hash, one
+  // subfolder per seed
+  auto cacheKey = std::to_string(params.hash()) + "/" +
+                  std::to_string(seed_msb) + "_" + std::to_string(seed_lsb);
+
+  auto &lru = SharedKeySetLRU::instance();
+  if (auto keySet = lru.lookup(cacheKey)) {
+    return keySet;
+  }
+  OUTCOME_TRY(auto keySet, loadOrGenerateSave(params, seed_msb, seed_lsb));
+  return lru.insert(cacheKey, std::shared_ptr<KeySet>(std::move(keySet)));
+}
+
 } // namespace clientlib
 } // namespace concretelang
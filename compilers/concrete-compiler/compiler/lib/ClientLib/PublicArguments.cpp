@@ -3,6 +3,7 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <cstring>
 #include <iostream>
 #include <stdlib.h>
 
@@ -54,17 +55,124 @@ PublicArguments::unserialize(const ClientParameters &expectedParams,
   return std::move(sArguments);
 }
 
+outcome::checked<std::unique_ptr<PublicArguments>, StringError>
+PublicArguments::fromBorrowedBuffers(const ClientParameters &expectedParams,
+                                     llvm::ArrayRef<void *> buffers) {
+  // bufferShape is not const
+  ClientParameters params = expectedParams;
+  if (buffers.size() != params.inputs.size()) {
+    return StringError("PublicArguments::fromBorrowedBuffers: expected ")
+           << params.inputs.size() << " input buffers but got "
+           << buffers.size();
+  }
+  std::vector<SharedScalarOrTensorData> arguments;
+  arguments.reserve(buffers.size());
+  for (size_t i = 0; i < buffers.size(); i++) {
+    auto gate = params.inputs[i];
+    if (buffers[i] == nullptr) {
+      return StringError("PublicArguments::fromBorrowedBuffers: input buffer ")
+             << i << " is null";
+    }
+    // Clear scalars are passed by value, nothing worth borrowing
+    if (!gate.isEncrypted() && gate.shape.size == 0) {
+      uint64_t value = 0;
+      memcpy(&value, buffers[i], bitWidthAsWord(gate.shape.width) / 8);
+      arguments.push_back(ScalarOrTensorData(
+          ScalarData(value, gate.shape.sign, gate.shape.width)));
+      continue;
+    }
+    std::vector<size_t> dimensions;
+    size_t elementWidth;
+    bool sign;
+    if (gate.isEncrypted()) {
+      // Ciphertexts are stored as 64 bits words, with the lwe size as
+      // trailing dimension
+      for (auto dim : params.bufferShape(gate)) {
+        dimensions.push_back(dim);
+      }
+      elementWidth = EncryptedScalarElementWidth;
+      sign = false;
+    } else {
+      for (auto dim : gate.shape.dimensions) {
+        dimensions.push_back(dim);
+      }
+      elementWidth = gate.shape.width;
+      sign = gate.shape.sign;
+    }
+    arguments.push_back(ScalarOrTensorData(TensorData::fromBorrowedBuffer(
+        buffers[i], dimensions, elementWidth, sign)));
+  }
+  return std::make_unique<PublicArguments>(expectedParams, arguments);
+}
+
 outcome::checked<void, StringError>
 PublicResult::unserialize(std::istream &istream) {
   OUTCOME_TRY(buffers, unserializeVectorOfScalarOrTensorData(istream));
+  // Expand results that were modulus switched to 32 bits words on
+  // serialization (see PublicResult::serialize) back to the standard 64
+  // bits representation, so decryption is oblivious to the compression.
+  for (size_t i = 0; i < buffers.size() && i < clientParameters.outputs.size();
+       i++) {
+    auto gate = clientParameters.outputs[i];
+    auto &sotd = buffers[i].get();
+    if (!gate.isEncrypted() || !sotd.isTensor() ||
+        sotd.getTensor().getElementType() != ElementType::u32) {
+      continue;
+    }
+    auto &compressed = sotd.getTensor();
+    TensorData expanded(compressed.getDimensions(),
+                        EncryptedScalarElementWidth, false);
+    auto words = compressed.getElementsView<uint32_t>();
+    for (size_t j = 0; j < words.size(); j++) {
+      expanded.getElementReference<uint64_t>(j) = (uint64_t)words[j] << 32;
+    }
+    buffers[i] =
+        SharedScalarOrTensorData(ScalarOrTensorData(std::move(expanded)));
+  }
   return outcome::success();
 }
 
 outcome::checked<void, StringError>
-PublicResult::serialize(std::ostream &ostream) {
-  serializeVectorOfScalarOrTensorData(buffers, ostream);
-  if (ostream.bad()) {
-    return StringError("PublicResult::serialize: cannot serialize");
+PublicResult::serialize(std::ostream &ostream, bool compressCiphertexts) {
+  if (!compressCiphertexts) {
+    serializeVectorOfScalarOrTensorData(buffers, ostream);
+    if (ostream.bad()) {
+      return StringError("PublicResult::serialize: cannot serialize");
+    }
+    return outcome::success();
+  }
+  // Compressed path: encrypted results are modulus switched from 64 to 32
+  // bits words with rounding. The element width recorded in the tensor
+  // header is enough for `unserialize` to detect and expand them, so the
+  // wire format stays the plain vector of tensors.
+  writeSize(ostream, buffers.size());
+  for (size_t i = 0; i < buffers.size(); i++) {
+    auto &sotd = buffers[i].get();
+    bool encrypted =
+        i < clientParameters.outputs.size() &&
+        clientParameters.outputs[i].isEncrypted() && sotd.isTensor() &&
+        sotd.getTensor().getElementType() == ElementType::u64;
+    if (!encrypted) {
+      serializeScalarOrTensorData(sotd, ostream);
+      if (ostream.bad()) {
+        return StringError("PublicResult::serialize: cannot serialize");
+      }
+      continue;
+    }
+    auto &tensor = sotd.getTensor();
+    auto words = tensor.getElementsView<uint64_t>();
+    std::vector<uint32_t> switched(words.size());
+    for (size_t j = 0; j < words.size(); j++) {
+      // Round to the nearest multiple of 2^32, wrapping around the torus
+      switched[j] = (uint32_t)((words[j] + (1ULL << 31)) >> 32);
+    }
+    writeWord<uint8_t>(ostream, 1); // tensor
+    serializeTensorDataRaw<uint32_t>(tensor.getDimensions(),
+                                     llvm::ArrayRef<uint32_t>(switched),
+                                     ostream);
+    if (ostream.bad()) {
+      return StringError("PublicResult::serialize: cannot serialize");
+    }
   }
   return outcome::success();
 }
@@ -107,20 +215,35 @@ TensorData tensorDataFromMemRefTyped(size_t memref_rank, void *allocatedVoid,
                     std::is_signed<T>());
   assert(aligned != nullptr);
 
-  // ephemeral multi dim index to compute global strides
-  size_t *index = new size_t[memref_rank];
-  for (size_t r = 0; r < memref_rank; r++) {
-    index[r] = 0;
-  }
   auto len = result.length();
 
-  // TODO: add a fast path for dense result (no real strides)
-  for (size_t i = 0; i < len; i++) {
-    int g_index = offset + global_index(index, sizes, strides, memref_rank);
-    result.getElementReference<T>(i) = aligned[g_index];
-    next_coord_index(index, sizes, memref_rank);
+  // With canonical row-major strides (0 stands for the default stride) the
+  // memref elements already have the layout TensorData stores, so the whole
+  // buffer is copied in one memcpy instead of one indexed copy per element.
+  bool dense = true;
+  size_t default_stride = 1;
+  for (int r = memref_rank - 1; r >= 0; r--) {
+    if (strides[r] != 0 && strides[r] != default_stride) {
+      dense = false;
+      break;
+    }
+    default_stride *= sizes[r];
+  }
+  if (dense) {
+    memcpy(result.getElementPointer<T>(0), aligned + offset, len * sizeof(T));
+  } else {
+    // ephemeral multi dim index to compute global strides
+    size_t *index = new size_t[memref_rank];
+    for (size_t r = 0; r < memref_rank; r++) {
+      index[r] = 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+      int g_index = offset + global_index(index, sizes, strides, memref_rank);
+      result.getElementReference<T>(i) = aligned[g_index];
+      next_coord_index(index, sizes, memref_rank);
+    }
+    delete[] index;
   }
-  delete[] index;
   // TEMPORARY: That quick and dirty but as this function is used only to
   // convert a result of the mlir program and as data are copied here, we
   // release the alocated pointer if it set.
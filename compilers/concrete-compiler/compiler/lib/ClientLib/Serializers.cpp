@@ -3,10 +3,17 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <fcntl.h>
+#include <fstream>
 #include <iosfwd>
 #include <iostream>
+#include <sstream>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
 
+#include "concrete-cpu.h"
 #include "concretelang/ClientLib/PublicArguments.h"
 #include "concretelang/ClientLib/Serializers.h"
 #include "concretelang/Common/Error.h"
@@ -17,9 +24,7 @@ namespace clientlib {
 template <typename Key>
 std::ostream &writeUInt64KeyBuffer(std::ostream &ostream, Key &buffer) {
   writeSize(ostream, (uint64_t)buffer.size());
-  ostream.write((const char *)buffer.buffer(),
-                buffer.size() * sizeof(uint64_t));
-  assert(ostream.good());
+  writeWords(ostream, buffer.buffer(), buffer.size());
   return ostream;
 }
 
@@ -29,8 +34,21 @@ std::istream &operator>>(std::istream &istream,
   uint64_t size;
   readSize(istream, size);
   vec->resize(size);
-  istream.read((char *)vec->data(), size * sizeof(uint64_t));
-  assert(istream.good());
+  readWords(istream, vec->data(), size);
+  return istream;
+}
+
+static std::ostream &writeMaskSeed(std::ostream &ostream, __uint128_t seed) {
+  writeWord(ostream, (uint64_t)seed);
+  writeWord(ostream, (uint64_t)(seed >> 64));
+  return ostream;
+}
+
+static std::istream &readMaskSeed(std::istream &istream, __uint128_t &seed) {
+  uint64_t lo, hi;
+  readWord(istream, lo);
+  readWord(istream, hi);
+  seed = ((__uint128_t)hi << 64) | lo;
   return istream;
 }
 
@@ -85,15 +103,36 @@ std::istream &operator>>(std::istream &istream, KeyswitchKeyParam &param) {
 // LweKeyswitchKey //////////////////////////////
 
 std::ostream &operator<<(std::ostream &ostream, const LweKeyswitchKey &key) {
+  writeWord<uint8_t>(ostream, key.isSeeded());
   ostream << key.parameters();
+  if (key.isSeeded()) {
+    writeMaskSeed(ostream, key.maskSeed());
+    // The output lwe dimension is not part of the parameters; it is
+    // recovered from the expanded buffer layout, which holds
+    // inputDimension * level ciphertexts of outputDimension + 1 words.
+    writeWord<uint64_t>(ostream, key.size() / key.seededSize() - 1);
+    writeSize(ostream, (uint64_t)key.seededSize());
+    writeWords(ostream, key.seededBuffer(), key.seededSize());
+    return ostream;
+  }
   writeUInt64KeyBuffer(ostream, key);
   return ostream;
 }
 
 LweKeyswitchKey readLweKeyswitchKey(std::istream &istream) {
+  uint8_t seeded;
+  readWord(istream, seeded);
   KeyswitchKeyParam param;
   istream >> param;
   auto buffer = std::make_shared<std::vector<uint64_t>>();
+  if (seeded) {
+    __uint128_t maskSeed;
+    readMaskSeed(istream, maskSeed);
+    uint64_t outputDimension;
+    readWord(istream, outputDimension);
+    istream >> buffer;
+    return LweKeyswitchKey(buffer, maskSeed, outputDimension, param);
+  }
   istream >> buffer;
   return LweKeyswitchKey(buffer, param);
 }
@@ -125,15 +164,30 @@ std::istream &operator>>(std::istream &istream, BootstrapKeyParam &param) {
 // LweBootstrapKey //////////////////////////////
 
 std::ostream &operator<<(std::ostream &ostream, const LweBootstrapKey &key) {
+  writeWord<uint8_t>(ostream, key.isSeeded());
   ostream << key.parameters();
+  if (key.isSeeded()) {
+    writeMaskSeed(ostream, key.maskSeed());
+    writeSize(ostream, (uint64_t)key.seededSize());
+    writeWords(ostream, key.seededBuffer(), key.seededSize());
+    return ostream;
+  }
   writeUInt64KeyBuffer(ostream, key);
   return ostream;
 }
 
 LweBootstrapKey readLweBootstrapKey(std::istream &istream) {
+  uint8_t seeded;
+  readWord(istream, seeded);
   BootstrapKeyParam param;
   istream >> param;
   auto buffer = std::make_shared<std::vector<uint64_t>>();
+  if (seeded) {
+    __uint128_t maskSeed;
+    readMaskSeed(istream, maskSeed);
+    istream >> buffer;
+    return LweBootstrapKey(buffer, maskSeed, param);
+  }
   istream >> buffer;
   return LweBootstrapKey(buffer, param);
 }
@@ -272,22 +326,131 @@ std::ostream &operator<<(std::ostream &ostream, const KeySet &keySet) {
 
 // EvaluationKey ////////////////////////////////
 
+// A key whose header was scanned but whose payload is still on the stream,
+// waiting in `buffer` to be sized and filled.
+template <typename Param> struct PendingKey {
+  Param param;
+  std::shared_ptr<std::vector<uint64_t>> buffer;
+  std::streampos payloadPos;
+  uint64_t size;
+  uint8_t seeded = 0;
+  __uint128_t maskSeed = 0;
+  uint64_t outputDimension = 0;
+};
+
+// Scans the headers of `nbKey` serialized keys, seeking over the payloads.
+// Buffers are left empty: sizing them zero-fills, which for multi-gigabyte
+// keys costs as much as the read itself, so it is deferred to run on
+// background threads while earlier payloads stream in. Bootstrap and
+// keyswitch keys (`seedTagged`) are prefixed with a seeded tag and, when
+// seeded, carry the public mask seed in their header.
+template <typename Param>
+static std::vector<PendingKey<Param>>
+scanKeyHeaders(std::istream &istream, uint64_t nbKey, bool seedTagged) {
+  std::vector<PendingKey<Param>> pending(nbKey);
+  for (uint64_t i = 0; i < nbKey; i++) {
+    if (seedTagged) {
+      readWord(istream, pending[i].seeded);
+    }
+    istream >> pending[i].param;
+    if (pending[i].seeded) {
+      readMaskSeed(istream, pending[i].maskSeed);
+      if (std::is_same<Param, KeyswitchKeyParam>::value) {
+        readWord(istream, pending[i].outputDimension);
+      }
+    }
+    readSize(istream, pending[i].size);
+    pending[i].payloadPos = istream.tellg();
+    pending[i].buffer = std::make_shared<std::vector<uint64_t>>();
+    istream.seekg(pending[i].size * sizeof(uint64_t), std::ios::cur);
+  }
+  return pending;
+}
+
 EvaluationKeys readEvaluationKeys(std::istream &istream) {
   uint64_t nbKey;
+  if (istream.tellg() == std::streampos(-1)) {
+    // Non-seekable stream (e.g. a socket): keys are read one after the
+    // other, allocation inline with I/O.
+    readSize(istream, nbKey);
+    std::vector<LweBootstrapKey> bootstrapKeys;
+    for (uint64_t i = 0; i < nbKey; i++) {
+      bootstrapKeys.push_back(readLweBootstrapKey(istream));
+    }
+    readSize(istream, nbKey);
+    std::vector<LweKeyswitchKey> keyswitchKeys;
+    for (uint64_t i = 0; i < nbKey; i++) {
+      keyswitchKeys.push_back(readLweKeyswitchKey(istream));
+    }
+    std::vector<PackingKeyswitchKey> packingKeyswitchKeys;
+    readSize(istream, nbKey);
+    for (uint64_t i = 0; i < nbKey; i++) {
+      packingKeyswitchKeys.push_back(readPackingKeyswitchKey(istream));
+    }
+    return EvaluationKeys(keyswitchKeys, bootstrapKeys, packingKeyswitchKeys);
+  }
+
+  // Seekable stream: parse every size-prefixed key header first, then
+  // stream the payloads back in file order while the buffers of the keys
+  // still to come are sized on background threads.
+  readSize(istream, nbKey);
+  auto pendingBsks = scanKeyHeaders<BootstrapKeyParam>(istream, nbKey, true);
   readSize(istream, nbKey);
+  auto pendingKsks = scanKeyHeaders<KeyswitchKeyParam>(istream, nbKey, true);
+  readSize(istream, nbKey);
+  auto pendingPksks =
+      scanKeyHeaders<PackingKeyswitchKeyParam>(istream, nbKey, false);
+  std::streampos endPos = istream.tellg();
+
+  std::vector<std::thread> allocations;
+  auto deferAllocations = [&](auto &pendingKeys) {
+    for (auto &pending : pendingKeys) {
+      allocations.push_back(
+          std::thread([&pending]() { pending.buffer->resize(pending.size); }));
+    }
+  };
+  deferAllocations(pendingBsks);
+  deferAllocations(pendingKsks);
+  deferAllocations(pendingPksks);
+
+  // Reading key i only waits for its own allocation, overlapping its I/O
+  // with the allocation of the keys behind it.
+  size_t nextAllocation = 0;
+  auto readPayloads = [&](auto &pendingKeys) {
+    for (auto &pending : pendingKeys) {
+      allocations[nextAllocation++].join();
+      istream.seekg(pending.payloadPos);
+      readWords(istream, pending.buffer->data(), pending.size);
+    }
+  };
+  readPayloads(pendingBsks);
+  readPayloads(pendingKsks);
+  readPayloads(pendingPksks);
+  istream.seekg(endPos);
+
   std::vector<LweBootstrapKey> bootstrapKeys;
-  for (uint64_t i = 0; i < nbKey; i++) {
-    bootstrapKeys.push_back(readLweBootstrapKey(istream));
+  for (auto &pending : pendingBsks) {
+    if (pending.seeded) {
+      bootstrapKeys.push_back(
+          LweBootstrapKey(pending.buffer, pending.maskSeed, pending.param));
+    } else {
+      bootstrapKeys.push_back(LweBootstrapKey(pending.buffer, pending.param));
+    }
   }
-  readSize(istream, nbKey);
   std::vector<LweKeyswitchKey> keyswitchKeys;
-  for (uint64_t i = 0; i < nbKey; i++) {
-    keyswitchKeys.push_back(readLweKeyswitchKey(istream));
+  for (auto &pending : pendingKsks) {
+    if (pending.seeded) {
+      keyswitchKeys.push_back(LweKeyswitchKey(pending.buffer, pending.maskSeed,
+                                              pending.outputDimension,
+                                              pending.param));
+    } else {
+      keyswitchKeys.push_back(LweKeyswitchKey(pending.buffer, pending.param));
+    }
   }
   std::vector<PackingKeyswitchKey> packingKeyswitchKeys;
-  readSize(istream, nbKey);
-  for (uint64_t i = 0; i < nbKey; i++) {
-    packingKeyswitchKeys.push_back(readPackingKeyswitchKey(istream));
+  for (auto &pending : pendingPksks) {
+    packingKeyswitchKeys.push_back(
+        PackingKeyswitchKey(pending.buffer, pending.param));
   }
   return EvaluationKeys(keyswitchKeys, bootstrapKeys, packingKeyswitchKeys);
 }
@@ -313,6 +476,270 @@ std::ostream &operator<<(std::ostream &ostream,
   return ostream;
 }
 
+// EvaluationKeys snapshot //////////////////////
+//
+// A server cold start chains the deserialization of hundreds of megabytes
+// of keys and the Fourier conversion of every bootstrap key. The snapshot
+// below persists the fully initialized key state once: a serialized header
+// describing every key, then each buffer (including the Fourier-domain
+// bootstrap keys) at a page-aligned offset in its final in-memory layout.
+// Later processes map the sections read-only and resume without copying or
+// converting anything; the pages are faulted in on first use.
+
+static const uint64_t evaluationKeysSnapshotMagic =
+    0x45564b534e415031; // "EVKSNAP1"
+static const size_t snapshotPageSize = 4096;
+
+static size_t alignToPage(size_t offset) {
+  return (offset + snapshotPageSize - 1) & ~(snapshotPageSize - 1);
+}
+
+/// Returns the Fourier-domain representation of `key`, either the one it
+/// already carries or a fresh conversion (the same one the runtime
+/// performs when building its context).
+static std::vector<double> fourierRepresentation(const LweBootstrapKey &key) {
+  std::vector<double> fourier(key.size());
+  if (key.fourierBuffer() != nullptr) {
+    std::copy(key.fourierBuffer(), key.fourierBuffer() + key.fourierSize(),
+              fourier.begin());
+    return fourier;
+  }
+  if (key.size() == 0) {
+    return fourier;
+  }
+  auto param = key.parameters();
+  struct Fft *fft =
+      (struct Fft *)aligned_alloc(CONCRETE_FFT_ALIGN, CONCRETE_FFT_SIZE);
+  concrete_cpu_construct_concrete_fft(fft, param.polynomialSize);
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
+      &scratch_size, &scratch_align, fft);
+  auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  concrete_cpu_bootstrap_key_convert_u64_to_fourier(
+      key.buffer(), fourier.data(), param.level, param.baseLog,
+      param.glweDimension, param.polynomialSize, param.inputLweDimension, fft,
+      scratch, scratch_size);
+  free(scratch);
+  concrete_cpu_destroy_concrete_fft(fft);
+  free(fft);
+  return fourier;
+}
+
+outcome::checked<void, StringError>
+saveEvaluationKeysSnapshot(const EvaluationKeys &evaluationKeys,
+                           const std::string &path) {
+  auto ksks = evaluationKeys.getKeyswitchKeys();
+  auto bsks = evaluationKeys.getBootstrapKeys();
+  auto pksks = evaluationKeys.getPackingKeyswitchKeys();
+
+  std::vector<std::vector<double>> fouriers;
+  fouriers.reserve(bsks.size());
+  for (auto &bsk : bsks) {
+    fouriers.push_back(fourierRepresentation(bsk));
+  }
+
+  // Sections are laid out in header order: the keyswitch keys, then each
+  // bootstrap key followed by its Fourier representation, then the
+  // packing keyswitch keys.
+  auto emitHeader = [&](std::ostream &out, uint64_t headerBytes,
+                        const std::vector<uint64_t> &offsets) {
+    size_t section = 0;
+    writeWord(out, evaluationKeysSnapshotMagic);
+    writeWord(out, headerBytes);
+    writeSize(out, (uint64_t)ksks.size());
+    for (auto &ksk : ksks) {
+      out << ksk.parameters();
+      writeSize(out, (uint64_t)ksk.size());
+      writeWord(out, offsets[section++]);
+    }
+    writeSize(out, (uint64_t)bsks.size());
+    for (size_t i = 0; i < bsks.size(); i++) {
+      out << bsks[i].parameters();
+      writeSize(out, (uint64_t)bsks[i].size());
+      writeWord(out, offsets[section++]);
+      writeSize(out, (uint64_t)fouriers[i].size());
+      writeWord(out, offsets[section++]);
+    }
+    writeSize(out, (uint64_t)pksks.size());
+    for (auto &pksk : pksks) {
+      out << pksk.parameters();
+      writeSize(out, (uint64_t)pksk.size());
+      writeWord(out, offsets[section++]);
+    }
+  };
+
+  // The section offsets depend on the header size, so the header is
+  // generated twice: once with placeholders to measure it.
+  size_t numSections = ksks.size() + 2 * bsks.size() + pksks.size();
+  std::ostringstream measure(std::ios::binary);
+  emitHeader(measure, 0, std::vector<uint64_t>(numSections, 0));
+  uint64_t headerBytes = alignToPage(measure.str().size());
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(numSections);
+  uint64_t cursor = headerBytes;
+  auto claim = [&](size_t words) {
+    offsets.push_back(cursor);
+    cursor = alignToPage(cursor + words * sizeof(uint64_t));
+  };
+  for (auto &ksk : ksks) {
+    claim(ksk.size());
+  }
+  for (size_t i = 0; i < bsks.size(); i++) {
+    claim(bsks[i].size());
+    claim(fouriers[i].size());
+  }
+  for (auto &pksk : pksks) {
+    claim(pksk.size());
+  }
+
+  std::ofstream out(path, std::ofstream::binary);
+  if (out.fail()) {
+    return StringError("Cannot access ") << path;
+  }
+  emitHeader(out, headerBytes, offsets);
+  size_t section = 0;
+  auto emitSection = [&](const void *data, size_t bytes) {
+    std::vector<char> padding(offsets[section++] - (uint64_t)out.tellp(), 0);
+    out.write(padding.data(), padding.size());
+    out.write((const char *)data, bytes);
+  };
+  for (auto &ksk : ksks) {
+    emitSection(ksk.buffer(), ksk.size() * sizeof(uint64_t));
+  }
+  for (size_t i = 0; i < bsks.size(); i++) {
+    emitSection(bsks[i].buffer(), bsks[i].size() * sizeof(uint64_t));
+    emitSection(fouriers[i].data(), fouriers[i].size() * sizeof(double));
+  }
+  for (auto &pksk : pksks) {
+    emitSection(pksk.buffer(), pksk.size() * sizeof(uint64_t));
+  }
+  if (out.bad()) {
+    return StringError("Cannot save evaluation keys snapshot at ") << path;
+  }
+  out.close();
+  return outcome::success();
+}
+
+outcome::checked<EvaluationKeys, StringError>
+loadEvaluationKeysSnapshot(const std::string &path) {
+  std::ifstream in(path, std::ifstream::binary);
+  if (in.fail()) {
+    return StringError("Cannot access ") << path;
+  }
+  uint64_t magic;
+  readWord(in, magic);
+  if (in.bad() || magic != evaluationKeysSnapshotMagic) {
+    return StringError("Not an evaluation keys snapshot at ") << path;
+  }
+  uint64_t headerBytes;
+  readWord(in, headerBytes);
+  if (in.bad() || headerBytes % snapshotPageSize != 0) {
+    return StringError("Corrupted evaluation keys snapshot at ") << path;
+  }
+
+  struct Section {
+    uint64_t words;
+    uint64_t offset;
+  };
+  auto readSection = [&](Section &section) {
+    readSize(in, section.words);
+    readWord(in, section.offset);
+  };
+
+  uint64_t nbKsk;
+  readSize(in, nbKsk);
+  std::vector<KeyswitchKeyParam> kskParams(nbKsk);
+  std::vector<Section> kskSections(nbKsk);
+  for (size_t i = 0; i < nbKsk; i++) {
+    in >> kskParams[i];
+    readSection(kskSections[i]);
+  }
+  uint64_t nbBsk;
+  readSize(in, nbBsk);
+  std::vector<BootstrapKeyParam> bskParams(nbBsk);
+  std::vector<Section> bskSections(nbBsk);
+  std::vector<Section> fourierSections(nbBsk);
+  for (size_t i = 0; i < nbBsk; i++) {
+    in >> bskParams[i];
+    readSection(bskSections[i]);
+    readSection(fourierSections[i]);
+  }
+  uint64_t nbPksk;
+  readSize(in, nbPksk);
+  std::vector<PackingKeyswitchKeyParam> pkskParams(nbPksk);
+  std::vector<Section> pkskSections(nbPksk);
+  for (size_t i = 0; i < nbPksk; i++) {
+    in >> pkskParams[i];
+    readSection(pkskSections[i]);
+  }
+  if (in.bad()) {
+    return StringError("Cannot load evaluation keys snapshot at ") << path;
+  }
+  in.close();
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return StringError("Cannot open ") << path;
+  }
+  // Sections are page-aligned by construction, so each one can be mapped
+  // individually and owned by the key built over it. Empty sections stand
+  // for unused key slots and get an empty buffer instead of a mapping.
+  bool failed = false;
+  auto mapSection = [&](Section section) -> std::shared_ptr<MappedKeyBuffer> {
+    if (section.words == 0) {
+      return nullptr;
+    }
+    size_t bytes = section.words * sizeof(uint64_t);
+    void *mapping =
+        mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, (off_t)section.offset);
+    if (mapping == MAP_FAILED) {
+      failed = true;
+      return nullptr;
+    }
+    return std::make_shared<MappedKeyBuffer>(mapping, bytes, 0, section.words);
+  };
+
+  std::vector<LweKeyswitchKey> keyswitchKeys;
+  for (size_t i = 0; i < nbKsk; i++) {
+    if (auto buffer = mapSection(kskSections[i])) {
+      keyswitchKeys.push_back(LweKeyswitchKey(buffer, kskParams[i]));
+    } else {
+      keyswitchKeys.push_back(LweKeyswitchKey(
+          std::make_shared<std::vector<uint64_t>>(), kskParams[i]));
+    }
+  }
+  std::vector<LweBootstrapKey> bootstrapKeys;
+  for (size_t i = 0; i < nbBsk; i++) {
+    if (auto buffer = mapSection(bskSections[i])) {
+      LweBootstrapKey key(buffer, bskParams[i]);
+      if (auto fourier = mapSection(fourierSections[i])) {
+        key.setFourierBuffer(fourier);
+      }
+      bootstrapKeys.push_back(key);
+    } else {
+      bootstrapKeys.push_back(LweBootstrapKey(
+          std::make_shared<std::vector<uint64_t>>(), bskParams[i]));
+    }
+  }
+  std::vector<PackingKeyswitchKey> packingKeyswitchKeys;
+  for (size_t i = 0; i < nbPksk; i++) {
+    if (auto buffer = mapSection(pkskSections[i])) {
+      packingKeyswitchKeys.push_back(
+          PackingKeyswitchKey(buffer, pkskParams[i]));
+    } else {
+      packingKeyswitchKeys.push_back(PackingKeyswitchKey(
+          std::make_shared<std::vector<uint64_t>>(), pkskParams[i]));
+    }
+  }
+  close(fd);
+  if (failed) {
+    return StringError("Cannot map evaluation keys snapshot at ") << path;
+  }
+  return EvaluationKeys(keyswitchKeys, bootstrapKeys, packingKeyswitchKeys);
+}
+
 // TensorData ///////////////////////////////////
 
 template <typename T>
@@ -413,35 +840,35 @@ std::ostream &serializeTensorData(const TensorData &values_and_sizes,
   case ElementType::u64:
     return serializeTensorDataRaw<uint64_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<uint64_t>(), ostream);
+        values_and_sizes.getElementsView<uint64_t>(), ostream);
   case ElementType::i64:
     return serializeTensorDataRaw<int64_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<int64_t>(), ostream);
+        values_and_sizes.getElementsView<int64_t>(), ostream);
   case ElementType::u32:
     return serializeTensorDataRaw<uint32_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<uint32_t>(), ostream);
+        values_and_sizes.getElementsView<uint32_t>(), ostream);
   case ElementType::i32:
     return serializeTensorDataRaw<int32_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<int32_t>(), ostream);
+        values_and_sizes.getElementsView<int32_t>(), ostream);
   case ElementType::u16:
     return serializeTensorDataRaw<uint16_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<uint16_t>(), ostream);
+        values_and_sizes.getElementsView<uint16_t>(), ostream);
   case ElementType::i16:
     return serializeTensorDataRaw<int16_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<int16_t>(), ostream);
+        values_and_sizes.getElementsView<int16_t>(), ostream);
   case ElementType::u8:
     return serializeTensorDataRaw<uint8_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<uint8_t>(), ostream);
+        values_and_sizes.getElementsView<uint8_t>(), ostream);
   case ElementType::i8:
     return serializeTensorDataRaw<int8_t>(
         values_and_sizes.getDimensions(),
-        values_and_sizes.getElements<int8_t>(), ostream);
+        values_and_sizes.getElementsView<int8_t>(), ostream);
   }
 
   assert(false && "Unhandled element type");
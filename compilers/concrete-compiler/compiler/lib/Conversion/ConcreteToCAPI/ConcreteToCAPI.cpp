@@ -3,6 +3,13 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <mlir/Dialect/MemRef/IR/MemRef.h>
 #include <mlir/Pass/Pass.h>
 #include <mlir/Transforms/DialectConversion.h>
 
@@ -27,6 +34,17 @@ char memref_mul_cleartext_lwe_ciphertext_u64[] =
 char memref_negate_lwe_ciphertext_u64[] = "memref_negate_lwe_ciphertext_u64";
 char memref_keyswitch_lwe_u64[] = "memref_keyswitch_lwe_u64";
 char memref_bootstrap_lwe_u64[] = "memref_bootstrap_lwe_u64";
+// Slim scalar entry points, taking raw aligned pointers and a static
+// size instead of full memref descriptors.
+char concrete_add_lwe_ciphertexts_u64[] = "concrete_add_lwe_ciphertexts_u64";
+char concrete_add_plaintext_lwe_ciphertext_u64[] =
+    "concrete_add_plaintext_lwe_ciphertext_u64";
+char concrete_mul_cleartext_lwe_ciphertext_u64[] =
+    "concrete_mul_cleartext_lwe_ciphertext_u64";
+char concrete_negate_lwe_ciphertext_u64[] =
+    "concrete_negate_lwe_ciphertext_u64";
+char concrete_keyswitch_lwe_u64[] = "concrete_keyswitch_lwe_u64";
+char concrete_bootstrap_lwe_u64[] = "concrete_bootstrap_lwe_u64";
 char memref_batched_add_lwe_ciphertexts_u64[] =
     "memref_batched_add_lwe_ciphertexts_u64";
 char memref_batched_add_plaintext_lwe_ciphertext_u64[] =
@@ -43,18 +61,45 @@ char memref_batched_keyswitch_lwe_u64[] = "memref_batched_keyswitch_lwe_u64";
 char memref_batched_bootstrap_lwe_u64[] = "memref_batched_bootstrap_lwe_u64";
 char memref_batched_mapped_bootstrap_lwe_u64[] =
     "memref_batched_mapped_bootstrap_lwe_u64";
+char memref_batched_glwe_pack_lwe_u64[] = "memref_batched_glwe_pack_lwe_u64";
+char memref_batched_glwe_unpack_lwe_u64[] =
+    "memref_batched_glwe_unpack_lwe_u64";
 
 char memref_keyswitch_async_lwe_u64[] = "memref_keyswitch_async_lwe_u64";
 char memref_bootstrap_async_lwe_u64[] = "memref_bootstrap_async_lwe_u64";
 char memref_await_future[] = "memref_await_future";
 char memref_keyswitch_lwe_cuda_u64[] = "memref_keyswitch_lwe_cuda_u64";
 char memref_bootstrap_lwe_cuda_u64[] = "memref_bootstrap_lwe_cuda_u64";
+char memref_add_lwe_ciphertexts_cuda_u64[] =
+    "memref_add_lwe_ciphertexts_cuda_u64";
+char memref_add_plaintext_lwe_ciphertext_cuda_u64[] =
+    "memref_add_plaintext_lwe_ciphertext_cuda_u64";
+char memref_mul_cleartext_lwe_ciphertext_cuda_u64[] =
+    "memref_mul_cleartext_lwe_ciphertext_cuda_u64";
+char memref_negate_lwe_ciphertext_cuda_u64[] =
+    "memref_negate_lwe_ciphertext_cuda_u64";
+char memref_batched_add_lwe_ciphertexts_cuda_u64[] =
+    "memref_batched_add_lwe_ciphertexts_cuda_u64";
+char memref_batched_add_plaintext_lwe_ciphertext_cuda_u64[] =
+    "memref_batched_add_plaintext_lwe_ciphertext_cuda_u64";
+char memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64[] =
+    "memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64";
+char memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64[] =
+    "memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64";
+char memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64[] =
+    "memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64";
+char memref_batched_negate_lwe_ciphertext_cuda_u64[] =
+    "memref_batched_negate_lwe_ciphertext_cuda_u64";
 char memref_batched_keyswitch_lwe_cuda_u64[] =
     "memref_batched_keyswitch_lwe_cuda_u64";
 char memref_batched_bootstrap_lwe_cuda_u64[] =
     "memref_batched_bootstrap_lwe_cuda_u64";
 char memref_batched_mapped_bootstrap_lwe_cuda_u64[] =
     "memref_batched_mapped_bootstrap_lwe_cuda_u64";
+char memref_keyswitch_bootstrap_lwe_cuda_u64[] =
+    "memref_keyswitch_bootstrap_lwe_cuda_u64";
+char memref_batched_keyswitch_bootstrap_lwe_cuda_u64[] =
+    "memref_batched_keyswitch_bootstrap_lwe_cuda_u64";
 char memref_expand_lut_in_trivial_glwe_ct_u64[] =
     "memref_expand_lut_in_trivial_glwe_ct_u64";
 
@@ -120,20 +165,77 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
   } else if (funcName == memref_negate_lwe_ciphertext_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
                                        {memref1DType, memref1DType}, {});
-  } else if (funcName == memref_keyswitch_lwe_u64 ||
-             funcName == memref_keyswitch_lwe_cuda_u64) {
+  } else if (funcName == memref_keyswitch_lwe_u64) {
     funcType =
         mlir::FunctionType::get(rewriter.getContext(),
                                 {memref1DType, memref1DType, i32Type, i32Type,
                                  i32Type, i32Type, i32Type, contextType},
                                 {});
-  } else if (funcName == memref_bootstrap_lwe_u64 ||
-             funcName == memref_bootstrap_lwe_cuda_u64) {
+  } else if (funcName == memref_keyswitch_lwe_cuda_u64) {
+    // The CUDA entry points take the number of downstream CUDA readers of
+    // the result as a trailing argument; see markDeviceResidentChains.
+    funcType = mlir::FunctionType::get(rewriter.getContext(),
+                                       {memref1DType, memref1DType, i32Type,
+                                        i32Type, i32Type, i32Type, i32Type,
+                                        contextType, i32Type},
+                                       {});
+  } else if (funcName == memref_bootstrap_lwe_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
                                        {memref1DType, memref1DType,
                                         memref1DType, i32Type, i32Type, i32Type,
                                         i32Type, i32Type, i32Type, contextType},
                                        {});
+  } else if (funcName == memref_bootstrap_lwe_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref1DType, memref1DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, contextType, i32Type},
+        {});
+  } else if (funcName == memref_add_lwe_ciphertexts_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref1DType, memref1DType, memref1DType, i32Type}, {});
+  } else if (funcName == memref_add_plaintext_lwe_ciphertext_cuda_u64 ||
+             funcName == memref_mul_cleartext_lwe_ciphertext_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref1DType, memref1DType, rewriter.getI64Type(), i32Type}, {});
+  } else if (funcName == memref_negate_lwe_ciphertext_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(), {memref1DType, memref1DType, i32Type}, {});
+  } else if (funcName == concrete_add_lwe_ciphertexts_u64) {
+    // Slim entry points pass buffers as their aligned pointer, carried
+    // as an index value.
+    auto indexType = rewriter.getIndexType();
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {indexType, indexType, indexType, rewriter.getI64Type()}, {});
+  } else if (funcName == concrete_add_plaintext_lwe_ciphertext_u64 ||
+             funcName == concrete_mul_cleartext_lwe_ciphertext_u64) {
+    auto indexType = rewriter.getIndexType();
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {indexType, indexType, rewriter.getI64Type(), rewriter.getI64Type()},
+        {});
+  } else if (funcName == concrete_negate_lwe_ciphertext_u64) {
+    auto indexType = rewriter.getIndexType();
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(), {indexType, indexType, rewriter.getI64Type()},
+        {});
+  } else if (funcName == concrete_keyswitch_lwe_u64) {
+    auto indexType = rewriter.getIndexType();
+    funcType =
+        mlir::FunctionType::get(rewriter.getContext(),
+                                {indexType, indexType, i32Type, i32Type,
+                                 i32Type, i32Type, i32Type, contextType},
+                                {});
+  } else if (funcName == concrete_bootstrap_lwe_u64) {
+    auto indexType = rewriter.getIndexType();
+    funcType = mlir::FunctionType::get(rewriter.getContext(),
+                                       {indexType, indexType, indexType,
+                                        i32Type, i32Type, i32Type, i32Type,
+                                        i32Type, i32Type, contextType},
+                                       {});
   } else if (funcName == memref_keyswitch_async_lwe_u64) {
     // Todo Answer this question: Isn't it dead ?
     funcType = mlir::FunctionType::get(
@@ -165,20 +267,50 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
   } else if (funcName == memref_batched_negate_lwe_ciphertext_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
                                        {memref2DType, memref2DType}, {});
-  } else if (funcName == memref_batched_keyswitch_lwe_u64 ||
-             funcName == memref_batched_keyswitch_lwe_cuda_u64) {
+  } else if (funcName == memref_batched_keyswitch_lwe_u64) {
     funcType =
         mlir::FunctionType::get(rewriter.getContext(),
                                 {memref2DType, memref2DType, i32Type, i32Type,
                                  i32Type, i32Type, i32Type, contextType},
                                 {});
-  } else if (funcName == memref_batched_bootstrap_lwe_u64 ||
-             funcName == memref_batched_bootstrap_lwe_cuda_u64) {
+  } else if (funcName == memref_batched_keyswitch_lwe_cuda_u64) {
+    funcType = mlir::FunctionType::get(rewriter.getContext(),
+                                       {memref2DType, memref2DType, i32Type,
+                                        i32Type, i32Type, i32Type, i32Type,
+                                        contextType, i32Type},
+                                       {});
+  } else if (funcName == memref_batched_bootstrap_lwe_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
                                        {memref2DType, memref2DType,
                                         memref1DType, i32Type, i32Type, i32Type,
                                         i32Type, i32Type, i32Type, contextType},
                                        {});
+  } else if (funcName == memref_batched_bootstrap_lwe_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref2DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, contextType, i32Type},
+        {});
+  } else if (funcName == memref_batched_add_lwe_ciphertexts_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref2DType, memref2DType, i32Type}, {});
+  } else if (funcName == memref_batched_add_plaintext_lwe_ciphertext_cuda_u64 ||
+             funcName ==
+                 memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref2DType, memref1DType, i32Type}, {});
+  } else if (funcName ==
+                 memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64 ||
+             funcName ==
+                 memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref2DType, rewriter.getI64Type(), i32Type}, {});
+  } else if (funcName == memref_batched_negate_lwe_ciphertext_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(), {memref2DType, memref2DType, i32Type}, {});
   } else if (funcName == memref_batched_mapped_bootstrap_lwe_u64 ||
              funcName == memref_batched_mapped_bootstrap_lwe_cuda_u64) {
     funcType = mlir::FunctionType::get(rewriter.getContext(),
@@ -186,6 +318,29 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
                                         memref2DType, i32Type, i32Type, i32Type,
                                         i32Type, i32Type, i32Type, contextType},
                                        {});
+  } else if (funcName == memref_batched_glwe_pack_lwe_u64) {
+    funcType = mlir::FunctionType::get(rewriter.getContext(),
+                                       {memref2DType, memref2DType, i32Type,
+                                        i32Type, i32Type, contextType},
+                                       {});
+  } else if (funcName == memref_batched_glwe_unpack_lwe_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(), {memref2DType, memref2DType, i32Type, i32Type},
+        {});
+  } else if (funcName == memref_keyswitch_bootstrap_lwe_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref1DType, memref1DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, i32Type, i32Type, i32Type, i32Type, i32Type,
+         contextType},
+        {});
+  } else if (funcName == memref_batched_keyswitch_bootstrap_lwe_cuda_u64) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref2DType, memref2DType, memref1DType, i32Type, i32Type, i32Type,
+         i32Type, i32Type, i32Type, i32Type, i32Type, i32Type, i32Type, i32Type,
+         contextType},
+        {});
   } else if (funcName == memref_await_future) {
     funcType = mlir::FunctionType::get(
         rewriter.getContext(),
@@ -255,6 +410,70 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
   return insertForwardDeclaration(op, rewriter, funcName, funcType);
 }
 
+// Per-op GPU/CPU placement table for keyswitch and bootstrap. Compiling
+// with GPU support places every op on the GPU by default, but for small
+// parameter sets the host-device round trip exceeds the CPU execution
+// time. The placement_calibration tool measures both backends across
+// parameter sets and writes a table of lines
+//
+//   concrete-placement-table v1
+//   bootstrap poly_size=<N> glwe_dim=<k> level=<l> backend=cpu|gpu
+//   keyswitch level=<l> base_log=<b> lwe_dim_in=<n> lwe_dim_out=<m> \
+//       backend=cpu|gpu
+//
+// consumed here through the CONCRETE_PLACEMENT_TABLE environment
+// variable. Parameter sets without an entry keep the GPU default.
+struct PlacementTable {
+  std::map<std::string, bool> onGpu;
+
+  static const PlacementTable &instance() {
+    static PlacementTable table = load();
+    return table;
+  }
+
+  bool placeOnGpu(const std::string &key) const {
+    auto entry = onGpu.find(key);
+    return entry == onGpu.end() || entry->second;
+  }
+
+private:
+  static PlacementTable load() {
+    PlacementTable table;
+    char *path = getenv("CONCRETE_PLACEMENT_TABLE");
+    if (path == nullptr)
+      return table;
+    std::ifstream file(path);
+    std::string line;
+    if (!std::getline(file, line) || line != "concrete-placement-table v1")
+      return table;
+    while (std::getline(file, line)) {
+      auto backendPos = line.rfind(" backend=");
+      if (backendPos == std::string::npos)
+        continue;
+      std::string key = line.substr(0, backendPos);
+      std::string backend = line.substr(backendPos + strlen(" backend="));
+      table.onGpu[key] = backend != "cpu";
+    }
+    return table;
+  }
+};
+
+template <typename BootstrapOp> bool bootstrapOnGpu(BootstrapOp op) {
+  std::ostringstream key;
+  key << "bootstrap poly_size=" << op.getPolySize()
+      << " glwe_dim=" << op.getGlweDimension() << " level=" << op.getLevel();
+  return PlacementTable::instance().placeOnGpu(key.str());
+}
+
+template <typename KeySwitchOp> bool keyswitchOnGpu(KeySwitchOp op) {
+  std::ostringstream key;
+  key << "keyswitch level=" << op.getLevel()
+      << " base_log=" << op.getBaseLog()
+      << " lwe_dim_in=" << op.getLweDimIn()
+      << " lwe_dim_out=" << op.getLweDimOut();
+  return PlacementTable::instance().placeOnGpu(key.str());
+}
+
 template <typename ConcreteOp>
 void addNoOperands(ConcreteOp op, mlir::SmallVector<mlir::Value> &operands,
                    mlir::RewriterBase &rewriter) {}
@@ -266,14 +485,26 @@ struct ConcreteToCAPICallPattern : public mlir::OpRewritePattern<ConcreteOp> {
       std::function<void(ConcreteOp bOp, llvm::SmallVector<mlir::Value> &,
                          mlir::RewriterBase &)>
           addOperands = addNoOperands<ConcreteOp>,
-      mlir::PatternBenefit benefit = 1)
+      std::function<char const *(ConcreteOp bOp)> selectCallee = nullptr,
+      mlir::PatternBenefit benefit = 1,
+      std::function<bool(ConcreteOp bOp)> matches = nullptr)
       : ::mlir::OpRewritePattern<ConcreteOp>(context, benefit),
-        addOperands(addOperands) {}
+        addOperands(addOperands), selectCallee(selectCallee), matches(matches) {
+  }
 
   ::mlir::LogicalResult
   matchAndRewrite(ConcreteOp bOp,
                   ::mlir::PatternRewriter &rewriter) const override {
 
+    // Guarded patterns only apply to a subset of the ops (e.g. the
+    // levelled ops marked as part of a device-resident chain).
+    if (matches && !matches(bOp))
+      return mlir::failure();
+
+    // Resolve the target entry point, which may depend on the op
+    // parameters (e.g. per-op GPU/CPU placement).
+    char const *funcName = selectCallee ? selectCallee(bOp) : callee;
+
     // Create the operands
     mlir::SmallVector<mlir::Value> operands;
     // For all tensor operand get the corresponding casted buffer
@@ -290,6 +521,74 @@ struct ConcreteToCAPICallPattern : public mlir::OpRewritePattern<ConcreteOp> {
     addOperands(bOp, operands, rewriter);
 
     // Insert forward declaration of the function
+    if (insertForwardDeclarationOfTheCAPI(bOp, rewriter, funcName).failed()) {
+      return mlir::failure();
+    }
+
+    rewriter.replaceOpWithNewOp<func::CallOp>(bOp, funcName, mlir::TypeRange{},
+                                              operands);
+
+    return ::mlir::success();
+  };
+
+private:
+  std::function<void(ConcreteOp bOp, llvm::SmallVector<mlir::Value> &,
+                     mlir::RewriterBase &)>
+      addOperands;
+  std::function<char const *(ConcreteOp bOp)> selectCallee;
+  std::function<bool(ConcreteOp bOp)> matches;
+};
+
+/// Returns true when the payload of a memref of `type` is fully
+/// described by its aligned pointer: static shape and identity layout,
+/// which pins the offset to zero and the strides to the row-major ones.
+bool isSlimCallCompatible(mlir::Type type) {
+  auto memrefType = type.dyn_cast<mlir::MemRefType>();
+  return memrefType && memrefType.hasStaticShape() &&
+         memrefType.getLayout().isIdentity();
+}
+
+/// Rewrites a scalar ciphertext op into a call to a slim entry point
+/// taking raw aligned pointers instead of full memref descriptors,
+/// saving four arguments per operand and the runtime stride checks in
+/// tight scalar loops. Only applies when every memref operand is slim
+/// compatible; the higher benefit makes it win over the generic
+/// descriptor-based pattern, which stays as the fallback.
+template <typename ConcreteOp, char const *callee>
+struct ConcreteToSlimCAPICallPattern
+    : public mlir::OpRewritePattern<ConcreteOp> {
+  ConcreteToSlimCAPICallPattern(
+      ::mlir::MLIRContext *context,
+      std::function<void(ConcreteOp bOp, llvm::SmallVector<mlir::Value> &,
+                         mlir::RewriterBase &)>
+          addOperands = addNoOperands<ConcreteOp>)
+      : ::mlir::OpRewritePattern<ConcreteOp>(context,
+                                             mlir::PatternBenefit(2)),
+        addOperands(addOperands) {}
+
+  ::mlir::LogicalResult
+  matchAndRewrite(ConcreteOp bOp,
+                  ::mlir::PatternRewriter &rewriter) const override {
+    for (auto &operand : bOp->getOpOperands()) {
+      mlir::Type type = operand.get().getType();
+      if (type.isa<mlir::MemRefType>() && !isSlimCallCompatible(type))
+        return mlir::failure();
+    }
+
+    mlir::SmallVector<mlir::Value> operands;
+    for (auto &operand : bOp->getOpOperands()) {
+      if (operand.get().getType().isa<mlir::MemRefType>()) {
+        operands.push_back(
+            rewriter.create<memref::ExtractAlignedPointerAsIndexOp>(
+                bOp.getLoc(), operand.get()));
+      } else {
+        operands.push_back(operand.get());
+      }
+    }
+
+    // append additional argument
+    addOperands(bOp, operands, rewriter);
+
     if (insertForwardDeclarationOfTheCAPI(bOp, rewriter, callee).failed()) {
       return mlir::failure();
     }
@@ -306,6 +605,18 @@ private:
       addOperands;
 };
 
+/// Appends the static ciphertext size of the result buffer, the only
+/// geometry the slim levelled entry points need.
+template <typename ConcreteOp>
+void slimLweSizeAddOperands(ConcreteOp op,
+                            mlir::SmallVector<mlir::Value> &operands,
+                            mlir::RewriterBase &rewriter) {
+  auto outType =
+      op->getOpOperand(0).get().getType().template cast<mlir::MemRefType>();
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), rewriter.getI64IntegerAttr(outType.getDimSize(0))));
+}
+
 template <typename KeySwitchOp>
 void keyswitchAddOperands(KeySwitchOp op,
                           mlir::SmallVector<mlir::Value> &operands,
@@ -355,6 +666,33 @@ void bootstrapAddOperands(BootstrapOp op,
   operands.push_back(getContextArgument(op));
 }
 
+void glwePackAddOperands(Concrete::BatchedGlwePackLweBufferOp op,
+                         mlir::SmallVector<mlir::Value> &operands,
+                         mlir::RewriterBase &rewriter) {
+  // glwe_dim
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getGlweDimensionAttr()));
+  // poly_size
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getPolySizeAttr()));
+  // pksk_index
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getPkskIndexAttr()));
+  // context
+  operands.push_back(getContextArgument(op));
+}
+
+void glweUnpackAddOperands(Concrete::BatchedGlweUnpackLweBufferOp op,
+                           mlir::SmallVector<mlir::Value> &operands,
+                           mlir::RewriterBase &rewriter) {
+  // glwe_dim
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), op.getGlweDimensionAttr()));
+  // poly_size
+  operands.push_back(
+      rewriter.create<arith::ConstantOp>(op.getLoc(), op.getPolySizeAttr()));
+}
+
 void wopPBSAddOperands(Concrete::WopPBSCRTLweBufferOp op,
                        mlir::SmallVector<mlir::Value> &operands,
                        mlir::RewriterBase &rewriter) {
@@ -512,6 +850,323 @@ void encodeLutForWopPBSAddOperands(Concrete::EncodeLutForCrtWopPBSBufferOp op,
       op.getLoc(), op.getIsSignedAttr()));
 }
 
+/// Rewrite keyswitch/bootstrap pairs where the keyswitched ciphertext is
+/// only consumed by the bootstrap into a single fused CAPI call. On GPU the
+/// fused entry point keeps the intermediate ciphertext resident on the
+/// device, saving one round-trip and one synchronization per pair. Runs
+/// before the op-by-op conversion so the individual patterns never see the
+/// fused ops.
+template <typename KeySwitchOp, typename BootstrapOp, char const *callee>
+void fuseKeySwitchBootstrapPairs(mlir::Operation *top) {
+  mlir::IRRewriter rewriter(top->getContext());
+  llvm::SmallVector<BootstrapOp> bootstraps;
+  top->walk([&](BootstrapOp bsOp) { bootstraps.push_back(bsOp); });
+  for (BootstrapOp bsOp : bootstraps) {
+    mlir::Value intermediate = bsOp.getInputCiphertext();
+
+    // The intermediate buffer must be produced by a single keyswitch and
+    // consumed only by the bootstrap (its deallocation aside).
+    KeySwitchOp ksOp = nullptr;
+    bool fusable = true;
+    for (mlir::Operation *user : intermediate.getUsers()) {
+      if (user == bsOp.getOperation() || mlir::isa<memref::DeallocOp>(user))
+        continue;
+      auto ks = mlir::dyn_cast<KeySwitchOp>(user);
+      if (ks && ks.getResult() == intermediate && !ksOp) {
+        ksOp = ks;
+        continue;
+      }
+      fusable = false;
+      break;
+    }
+    if (!ksOp || !fusable || ksOp->getBlock() != bsOp->getBlock() ||
+        !ksOp->isBeforeInBlock(bsOp))
+      continue;
+
+    // Only fuse when nothing in between can touch the operand buffers.
+    mlir::Operation *cur = ksOp->getNextNode();
+    while (cur != bsOp.getOperation() &&
+           mlir::isa<memref::AllocOp, arith::ConstantOp>(cur))
+      cur = cur->getNextNode();
+    if (cur != bsOp.getOperation())
+      continue;
+
+    // Keep the pair unfused when the placement table routes either op to
+    // the CPU; the per-op patterns then pick the right entry points.
+    if (!keyswitchOnGpu(ksOp) || !bootstrapOnGpu(bsOp))
+      continue;
+
+    rewriter.setInsertionPoint(bsOp);
+    mlir::SmallVector<mlir::Value> operands;
+    operands.push_back(getCastedMemRef(rewriter, bsOp.getResult()));
+    operands.push_back(getCastedMemRef(rewriter, ksOp.getCiphertext()));
+    operands.push_back(getCastedMemRef(rewriter, bsOp.getLookupTable()));
+    // Keyswitch arguments
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        ksOp.getLoc(), ksOp.getLevelAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        ksOp.getLoc(), ksOp.getBaseLogAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        ksOp.getLoc(), ksOp.getLweDimInAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        ksOp.getLoc(), ksOp.getLweDimOutAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        ksOp.getLoc(), ksOp.getKskIndexAttr()));
+    // Bootstrap arguments
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        bsOp.getLoc(), bsOp.getInputLweDimAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        bsOp.getLoc(), bsOp.getPolySizeAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        bsOp.getLoc(), bsOp.getLevelAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        bsOp.getLoc(), bsOp.getBaseLogAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        bsOp.getLoc(), bsOp.getGlweDimensionAttr()));
+    operands.push_back(rewriter.create<arith::ConstantOp>(
+        bsOp.getLoc(), bsOp.getBskIndexAttr()));
+    // context
+    operands.push_back(getContextArgument(bsOp));
+
+    if (insertForwardDeclarationOfTheCAPI(bsOp, rewriter, callee).failed())
+      continue;
+    rewriter.create<func::CallOp>(bsOp.getLoc(), callee, mlir::TypeRange{},
+                                  operands);
+    rewriter.eraseOp(bsOp);
+    rewriter.eraseOp(ksOp);
+  }
+}
+
+// Device-resident ciphertext chains //////////////////////////////////////////
+//
+// Every CUDA entry point uploads its operands and downloads its result, so
+// a chain like add -> keyswitch -> bootstrap -> add crosses the PCIe bus
+// around every levelled op even though the GPU has levelled kernels. The
+// marking below finds the levelled ops whose ciphertexts already flow
+// through GPU-placed keyswitch/bootstrap ops and routes them to the CUDA
+// levelled entry points. Producers whose result buffer is read only by
+// other CUDA entry points additionally carry the number of those readers,
+// which the lowering passes as a trailing argument so the runtime hands the
+// device buffer over to them instead of copying it back (see
+// GPUCiphertextResidency in the runtime wrappers).
+
+constexpr char kOnDeviceAttr[] = "Concrete.on_device";
+constexpr char kDeviceReadersAttr[] = "Concrete.device_readers";
+
+bool isLevelledCiphertextOp(mlir::Operation *op) {
+  return mlir::isa<Concrete::AddLweBufferOp, Concrete::AddPlaintextLweBufferOp,
+                   Concrete::MulCleartextLweBufferOp,
+                   Concrete::NegateLweBufferOp, Concrete::BatchedAddLweBufferOp,
+                   Concrete::BatchedAddPlaintextLweBufferOp,
+                   Concrete::BatchedAddPlaintextCstLweBufferOp,
+                   Concrete::BatchedMulCleartextLweBufferOp,
+                   Concrete::BatchedMulCleartextCstLweBufferOp,
+                   Concrete::BatchedNegateLweBufferOp>(op);
+}
+
+/// True for the keyswitch/bootstrap ops the placement table routes to the
+/// GPU, the seeds of the device-resident chains.
+bool isGpuKeySwitchOrBootstrap(mlir::Operation *op) {
+  if (auto ks = mlir::dyn_cast<Concrete::KeySwitchLweBufferOp>(op))
+    return keyswitchOnGpu(ks);
+  if (auto ks = mlir::dyn_cast<Concrete::BatchedKeySwitchLweBufferOp>(op))
+    return keyswitchOnGpu(ks);
+  if (auto bs = mlir::dyn_cast<Concrete::BootstrapLweBufferOp>(op))
+    return bootstrapOnGpu(bs);
+  if (auto bs = mlir::dyn_cast<Concrete::BatchedBootstrapLweBufferOp>(op))
+    return bootstrapOnGpu(bs);
+  return false;
+}
+
+/// True for the calls to the fused keyswitch/bootstrap CUDA entry points
+/// emitted by fuseKeySwitchBootstrapPairs, which runs first.
+bool isFusedCudaCall(mlir::Operation *op) {
+  auto call = mlir::dyn_cast<func::CallOp>(op);
+  return call &&
+         (call.getCallee() == memref_keyswitch_bootstrap_lwe_cuda_u64 ||
+          call.getCallee() == memref_batched_keyswitch_bootstrap_lwe_cuda_u64);
+}
+
+/// The result buffer and ciphertext inputs of a levelled op; plaintext and
+/// cleartext operands never live on the device between calls.
+void appendCiphertextOperands(mlir::Operation *op,
+                              mlir::SmallVectorImpl<mlir::Value> &values) {
+  values.push_back(op->getOperand(0));
+  values.push_back(op->getOperand(1));
+  if (mlir::isa<Concrete::AddLweBufferOp, Concrete::BatchedAddLweBufferOp>(op))
+    values.push_back(op->getOperand(2));
+}
+
+/// Returns true when another user of `value` runs on the GPU: a GPU-placed
+/// keyswitch/bootstrap, an already marked levelled op, or a fused CUDA
+/// call (reached through the memref.cast the fusion inserted).
+bool touchesDeviceOp(mlir::Value value,
+                     const mlir::DenseSet<mlir::Operation *> &onDevice,
+                     mlir::Operation *self) {
+  for (mlir::Operation *user : value.getUsers()) {
+    if (user == self)
+      continue;
+    if (isGpuKeySwitchOrBootstrap(user) || onDevice.contains(user))
+      return true;
+    if (auto cast = mlir::dyn_cast<memref::CastOp>(user))
+      for (mlir::Operation *castUser : cast->getUsers())
+        if (isFusedCudaCall(castUser))
+          return true;
+  }
+  return false;
+}
+
+/// Returns true when `use` reads a ciphertext from an op lowered to a CUDA
+/// entry point that adopts device-resident copies.
+bool isDeviceConsumingUse(mlir::OpOperand &use,
+                          const mlir::DenseSet<mlir::Operation *> &onDevice) {
+  mlir::Operation *user = use.getOwner();
+  unsigned idx = use.getOperandNumber();
+  if (isGpuKeySwitchOrBootstrap(user))
+    return idx == 1;
+  if (onDevice.contains(user))
+    return idx == 1 || (idx == 2 && mlir::isa<Concrete::AddLweBufferOp,
+                                              Concrete::BatchedAddLweBufferOp>(
+                                        user));
+  if (auto cast = mlir::dyn_cast<memref::CastOp>(user)) {
+    // The cast stands for the uses of its result; all of them must be the
+    // input ciphertext of a fused CUDA call.
+    if (cast->use_empty())
+      return false;
+    for (mlir::OpOperand &castUse : cast.getDest().getUses())
+      if (!isFusedCudaCall(castUse.getOwner()) ||
+          castUse.getOperandNumber() != 1)
+        return false;
+    return true;
+  }
+  return false;
+}
+
+/// Returns the number of uses of `buffer` that adopt it on the device, or
+/// 0 when publication is illegal: the host copy of a published buffer is
+/// never written, so any reader outside the chain, any second writer, or
+/// any reader scheduled before the producer (as in a loop-carried buffer)
+/// keeps the copy-back.
+uint32_t deviceReaderCount(mlir::Value buffer, mlir::Operation *producer,
+                           const mlir::DenseSet<mlir::Operation *> &onDevice) {
+  if (!buffer.getDefiningOp<memref::AllocOp>())
+    return 0;
+  uint32_t readers = 0;
+  for (mlir::OpOperand &use : buffer.getUses()) {
+    mlir::Operation *user = use.getOwner();
+    if (user == producer) {
+      // An in-place update reads the buffer it overwrites; keep the host
+      // copy authoritative for it.
+      if (use.getOperandNumber() != 0)
+        return 0;
+      continue;
+    }
+    if (mlir::isa<memref::DeallocOp>(user))
+      continue;
+    if (!isDeviceConsumingUse(use, onDevice))
+      return 0;
+    if (user->getBlock() != producer->getBlock() ||
+        !producer->isBeforeInBlock(user))
+      return 0;
+    if (auto cast = mlir::dyn_cast<memref::CastOp>(user)) {
+      // One adoption per fused call reading through the cast
+      auto uses = cast.getDest().getUses();
+      readers += std::distance(uses.begin(), uses.end());
+    } else {
+      readers += 1;
+    }
+  }
+  return readers;
+}
+
+/// Marks the levelled ops joining a device-resident chain with
+/// kOnDeviceAttr and every chain producer with its reader count in
+/// kDeviceReadersAttr. Runs before the op-by-op conversion; the patterns
+/// and add-operands helpers below read the attributes back.
+void markDeviceResidentChains(mlir::Operation *top) {
+  llvm::SmallVector<mlir::Operation *> levelled;
+  top->walk([&](mlir::Operation *op) {
+    if (isLevelledCiphertextOp(op))
+      levelled.push_back(op);
+  });
+
+  // Fixpoint: a levelled op joins the chain when one of its ciphertexts
+  // is touched by a GPU-placed op or by another member.
+  mlir::DenseSet<mlir::Operation *> onDevice;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (mlir::Operation *op : levelled) {
+      if (onDevice.contains(op))
+        continue;
+      mlir::SmallVector<mlir::Value> ciphertexts;
+      appendCiphertextOperands(op, ciphertexts);
+      for (mlir::Value ciphertext : ciphertexts) {
+        if (touchesDeviceOp(ciphertext, onDevice, op)) {
+          onDevice.insert(op);
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  mlir::OpBuilder builder(top->getContext());
+  for (mlir::Operation *op : levelled)
+    if (onDevice.contains(op))
+      op->setAttr(kOnDeviceAttr, builder.getUnitAttr());
+
+  top->walk([&](mlir::Operation *op) {
+    if (!onDevice.contains(op) && !isGpuKeySwitchOrBootstrap(op))
+      return;
+    uint32_t readers = deviceReaderCount(op->getOperand(0), op, onDevice);
+    if (readers > 0)
+      op->setAttr(kDeviceReadersAttr, builder.getI32IntegerAttr(readers));
+  });
+}
+
+/// Appends the number of downstream CUDA readers of the result counted by
+/// markDeviceResidentChains; the runtime hands the device buffer over to
+/// them instead of copying it back to the host.
+template <typename ConcreteOp>
+void deviceReadersAddOperands(ConcreteOp op,
+                              mlir::SmallVector<mlir::Value> &operands,
+                              mlir::RewriterBase &rewriter) {
+  uint32_t readers = 0;
+  if (auto attr =
+          op->template getAttrOfType<mlir::IntegerAttr>(kDeviceReadersAttr))
+    readers = attr.getInt();
+  operands.push_back(rewriter.create<arith::ConstantOp>(
+      op.getLoc(), rewriter.getI32IntegerAttr(readers)));
+}
+
+/// Returns true when markDeviceResidentChains routed this levelled op to
+/// the CUDA entry points.
+template <typename ConcreteOp> bool onDeviceChain(ConcreteOp op) {
+  return op->hasAttr(kOnDeviceAttr);
+}
+
+/// On GPU the CUDA keyswitch entry point takes the reader count as an
+/// extra trailing argument; ops the placement table routes back to the CPU
+/// keep the CPU signature.
+template <typename KeySwitchOp>
+void gpuKeyswitchAddOperands(KeySwitchOp op,
+                             mlir::SmallVector<mlir::Value> &operands,
+                             mlir::RewriterBase &rewriter) {
+  keyswitchAddOperands(op, operands, rewriter);
+  if (keyswitchOnGpu(op))
+    deviceReadersAddOperands(op, operands, rewriter);
+}
+
+template <typename BootstrapOp>
+void gpuBootstrapAddOperands(BootstrapOp op,
+                             mlir::SmallVector<mlir::Value> &operands,
+                             mlir::RewriterBase &rewriter) {
+  bootstrapAddOperands(op, operands, rewriter);
+  if (bootstrapOnGpu(op))
+    deviceReadersAddOperands(op, operands, rewriter);
+}
+
 struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
 
   ConcreteToCAPIPass(bool gpu) : gpu(gpu) {}
@@ -519,6 +1174,19 @@ struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
   void runOnOperation() override {
     auto op = this->getOperation();
 
+    // On GPU, lower keyswitch/bootstrap pairs to the fused entry point
+    // before converting the remaining ops one by one.
+    if (gpu) {
+      fuseKeySwitchBootstrapPairs<Concrete::KeySwitchLweBufferOp,
+                                  Concrete::BootstrapLweBufferOp,
+                                  memref_keyswitch_bootstrap_lwe_cuda_u64>(op);
+      fuseKeySwitchBootstrapPairs<
+          Concrete::BatchedKeySwitchLweBufferOp,
+          Concrete::BatchedBootstrapLweBufferOp,
+          memref_batched_keyswitch_bootstrap_lwe_cuda_u64>(op);
+      markDeviceResidentChains(op);
+    }
+
     mlir::ConversionTarget target(getContext());
     mlir::RewritePatternSet patterns(&getContext());
 
@@ -532,6 +1200,26 @@ struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
     target.addIllegalDialect<Concrete::ConcreteDialect>();
 
     // Add patterns to transform Concrete operators to CAPI call
+    //
+    // Scalar ops whose operands were proved contiguous with static
+    // shapes take the slim entry points; the descriptor-based patterns
+    // below remain the fallback for every other case.
+    patterns.add<ConcreteToSlimCAPICallPattern<
+        Concrete::AddLweBufferOp, concrete_add_lwe_ciphertexts_u64>>(
+        &getContext(), slimLweSizeAddOperands<Concrete::AddLweBufferOp>);
+    patterns.add<ConcreteToSlimCAPICallPattern<
+        Concrete::AddPlaintextLweBufferOp,
+        concrete_add_plaintext_lwe_ciphertext_u64>>(
+        &getContext(),
+        slimLweSizeAddOperands<Concrete::AddPlaintextLweBufferOp>);
+    patterns.add<ConcreteToSlimCAPICallPattern<
+        Concrete::MulCleartextLweBufferOp,
+        concrete_mul_cleartext_lwe_ciphertext_u64>>(
+        &getContext(),
+        slimLweSizeAddOperands<Concrete::MulCleartextLweBufferOp>);
+    patterns.add<ConcreteToSlimCAPICallPattern<
+        Concrete::NegateLweBufferOp, concrete_negate_lwe_ciphertext_u64>>(
+        &getContext(), slimLweSizeAddOperands<Concrete::NegateLweBufferOp>);
     patterns.add<ConcreteToCAPICallPattern<Concrete::AddLweBufferOp,
                                            memref_add_lwe_ciphertexts_u64>>(
         &getContext());
@@ -579,28 +1267,133 @@ struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
                                   memref_batched_negate_lwe_ciphertext_u64>>(
         &getContext());
     if (gpu) {
+      // Levelled ops marked by markDeviceResidentChains run on the GPU so
+      // the keyswitch/bootstrap chain around them never leaves the
+      // device; unmarked ones keep the CPU entry points above. The higher
+      // benefit makes these win over the slim and descriptor patterns.
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::AddLweBufferOp, memref_add_lwe_ciphertexts_cuda_u64>>(
+          &getContext(), deviceReadersAddOperands<Concrete::AddLweBufferOp>,
+          nullptr, mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::AddLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::AddPlaintextLweBufferOp,
+          memref_add_plaintext_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::AddPlaintextLweBufferOp>, nullptr,
+          mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::AddPlaintextLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::MulCleartextLweBufferOp,
+          memref_mul_cleartext_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::MulCleartextLweBufferOp>, nullptr,
+          mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::MulCleartextLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::NegateLweBufferOp, memref_negate_lwe_ciphertext_cuda_u64>>(
+          &getContext(), deviceReadersAddOperands<Concrete::NegateLweBufferOp>,
+          nullptr, mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::NegateLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedAddLweBufferOp,
+          memref_batched_add_lwe_ciphertexts_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::BatchedAddLweBufferOp>, nullptr,
+          mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::BatchedAddLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedAddPlaintextLweBufferOp,
+          memref_batched_add_plaintext_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::BatchedAddPlaintextLweBufferOp>,
+          nullptr, mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::BatchedAddPlaintextLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedAddPlaintextCstLweBufferOp,
+          memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::BatchedAddPlaintextCstLweBufferOp>,
+          nullptr, mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::BatchedAddPlaintextCstLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedMulCleartextLweBufferOp,
+          memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::BatchedMulCleartextLweBufferOp>,
+          nullptr, mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::BatchedMulCleartextLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedMulCleartextCstLweBufferOp,
+          memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::BatchedMulCleartextCstLweBufferOp>,
+          nullptr, mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::BatchedMulCleartextCstLweBufferOp>);
+      patterns.add<ConcreteToCAPICallPattern<
+          Concrete::BatchedNegateLweBufferOp,
+          memref_batched_negate_lwe_ciphertext_cuda_u64>>(
+          &getContext(),
+          deviceReadersAddOperands<Concrete::BatchedNegateLweBufferOp>, nullptr,
+          mlir::PatternBenefit(3),
+          onDeviceChain<Concrete::BatchedNegateLweBufferOp>);
+      // The placement table can route individual keyswitch/bootstrap ops
+      // back to the CPU entry points when the calibration measured the
+      // GPU round trip as a loss for their parameters.
       patterns.add<ConcreteToCAPICallPattern<Concrete::KeySwitchLweBufferOp,
                                              memref_keyswitch_lwe_cuda_u64>>(
-          &getContext(), keyswitchAddOperands<Concrete::KeySwitchLweBufferOp>);
+          &getContext(),
+          gpuKeyswitchAddOperands<Concrete::KeySwitchLweBufferOp>,
+          [](Concrete::KeySwitchLweBufferOp op) {
+            return keyswitchOnGpu(op) ? memref_keyswitch_lwe_cuda_u64
+                                      : memref_keyswitch_lwe_u64;
+          });
       patterns.add<ConcreteToCAPICallPattern<Concrete::BootstrapLweBufferOp,
                                              memref_bootstrap_lwe_cuda_u64>>(
-          &getContext(), bootstrapAddOperands<Concrete::BootstrapLweBufferOp>);
+          &getContext(),
+          gpuBootstrapAddOperands<Concrete::BootstrapLweBufferOp>,
+          [](Concrete::BootstrapLweBufferOp op) {
+            return bootstrapOnGpu(op) ? memref_bootstrap_lwe_cuda_u64
+                                      : memref_bootstrap_lwe_u64;
+          });
       patterns.add<
           ConcreteToCAPICallPattern<Concrete::BatchedKeySwitchLweBufferOp,
                                     memref_batched_keyswitch_lwe_cuda_u64>>(
           &getContext(),
-          keyswitchAddOperands<Concrete::BatchedKeySwitchLweBufferOp>);
+          gpuKeyswitchAddOperands<Concrete::BatchedKeySwitchLweBufferOp>,
+          [](Concrete::BatchedKeySwitchLweBufferOp op) {
+            return keyswitchOnGpu(op) ? memref_batched_keyswitch_lwe_cuda_u64
+                                      : memref_batched_keyswitch_lwe_u64;
+          });
       patterns.add<
           ConcreteToCAPICallPattern<Concrete::BatchedBootstrapLweBufferOp,
                                     memref_batched_bootstrap_lwe_cuda_u64>>(
           &getContext(),
-          bootstrapAddOperands<Concrete::BatchedBootstrapLweBufferOp>);
+          gpuBootstrapAddOperands<Concrete::BatchedBootstrapLweBufferOp>,
+          [](Concrete::BatchedBootstrapLweBufferOp op) {
+            return bootstrapOnGpu(op) ? memref_batched_bootstrap_lwe_cuda_u64
+                                      : memref_batched_bootstrap_lwe_u64;
+          });
       patterns.add<ConcreteToCAPICallPattern<
           Concrete::BatchedMappedBootstrapLweBufferOp,
           memref_batched_mapped_bootstrap_lwe_cuda_u64>>(
           &getContext(),
-          bootstrapAddOperands<Concrete::BatchedMappedBootstrapLweBufferOp>);
+          bootstrapAddOperands<Concrete::BatchedMappedBootstrapLweBufferOp>,
+          [](Concrete::BatchedMappedBootstrapLweBufferOp op) {
+            return bootstrapOnGpu(op)
+                       ? memref_batched_mapped_bootstrap_lwe_cuda_u64
+                       : memref_batched_mapped_bootstrap_lwe_u64;
+          });
     } else {
+      // On CPU the scalar keyswitch/bootstrap also get a slim form; on
+      // GPU the callee depends on the placement table, keep the
+      // descriptor-based patterns there.
+      patterns.add<ConcreteToSlimCAPICallPattern<Concrete::KeySwitchLweBufferOp,
+                                                 concrete_keyswitch_lwe_u64>>(
+          &getContext(), keyswitchAddOperands<Concrete::KeySwitchLweBufferOp>);
+      patterns.add<ConcreteToSlimCAPICallPattern<Concrete::BootstrapLweBufferOp,
+                                                 concrete_bootstrap_lwe_u64>>(
+          &getContext(), bootstrapAddOperands<Concrete::BootstrapLweBufferOp>);
       patterns.add<ConcreteToCAPICallPattern<Concrete::KeySwitchLweBufferOp,
                                              memref_keyswitch_lwe_u64>>(
           &getContext(), keyswitchAddOperands<Concrete::KeySwitchLweBufferOp>);
@@ -624,6 +1417,18 @@ struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
           bootstrapAddOperands<Concrete::BatchedMappedBootstrapLweBufferOp>);
     }
 
+    // GLWE packing of intermediate batches runs on the CPU in both
+    // configurations: it is memory bound and the packed batches exist
+    // precisely to stay resident between stages.
+    patterns
+        .add<ConcreteToCAPICallPattern<Concrete::BatchedGlwePackLweBufferOp,
+                                       memref_batched_glwe_pack_lwe_u64>>(
+            &getContext(), glwePackAddOperands);
+    patterns
+        .add<ConcreteToCAPICallPattern<Concrete::BatchedGlweUnpackLweBufferOp,
+                                       memref_batched_glwe_unpack_lwe_u64>>(
+            &getContext(), glweUnpackAddOperands);
+
     patterns.add<ConcreteToCAPICallPattern<Concrete::WopPBSCRTLweBufferOp,
                                            memref_wop_pbs_crt_buffer>>(
         &getContext(), wopPBSAddOperands);
@@ -15,6 +15,7 @@
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/DialectConversion.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallVector.h"
 
 #include "concretelang/Conversion/Passes.h"
@@ -25,8 +26,6 @@
 #include "concretelang/Support/Constants.h"
 #include "concretelang/Support/logging.h"
 
-#include <unordered_set>
-
 namespace arith = mlir::arith;
 namespace linalg = mlir::linalg;
 namespace tensor = mlir::tensor;
@@ -1174,7 +1173,7 @@ struct SumToLinalgGeneric
       }
     }
 
-    auto axesToDestroy = std::unordered_set<int64_t>{};
+    auto axesToDestroy = llvm::SmallDenseSet<int64_t, 4>{};
     for (mlir::Attribute axisAttribute : sumOp.getAxes()) {
       int64_t axis = axisAttribute.cast<mlir::IntegerAttr>().getInt();
       axesToDestroy.insert(axis);
@@ -1185,6 +1184,81 @@ struct SumToLinalgGeneric
       }
     }
 
+    // Large full reductions are summed as a balanced tree of halving
+    // passes instead of the linear accumulation chain of the linalg
+    // reduction below: each pass is an elementwise tensor addition, so
+    // the loop parallelization sees log-depth parallel work instead of a
+    // serial chain. Each halving pass also slices and copies its
+    // operands, an overhead linear in the width, so the tree only pays
+    // off once the accumulation chain is long; smaller sums keep the
+    // plain generic lowering.
+    constexpr int64_t treeReductionThreshold = 64;
+    if (!outputIsTensor && inputType.hasStaticShape() &&
+        inputType.getNumElements() > treeReductionThreshold) {
+      mlir::Value flat = input;
+      if (inputDimensions > 1) {
+        llvm::SmallVector<mlir::ReassociationIndices, 1> reassociation(1);
+        for (int64_t i = 0; i < inputDimensions; i++) {
+          reassociation[0].push_back(i);
+        }
+        flat = rewriter.create<mlir::tensor::CollapseShapeOp>(location, input,
+                                                              reassociation);
+      }
+      auto slice = [&](mlir::Value source, int64_t offset, int64_t size) {
+        llvm::SmallVector<mlir::OpFoldResult, 1> offsets{
+            rewriter.getIndexAttr(offset)};
+        llvm::SmallVector<mlir::OpFoldResult, 1> sizes{
+            rewriter.getIndexAttr(size)};
+        llvm::SmallVector<mlir::OpFoldResult, 1> strides{
+            rewriter.getIndexAttr(1)};
+        return rewriter
+            .create<mlir::tensor::ExtractSliceOp>(
+                location,
+                mlir::RankedTensorType::get({size}, outputType), source,
+                offsets, sizes, strides)
+            .getResult();
+      };
+      int64_t n = inputType.getNumElements();
+      while (n > treeReductionThreshold) {
+        int64_t half = n / 2;
+        auto halfType = mlir::RankedTensorType::get({half}, outputType);
+        auto halved = rewriter.create<FHELinalg::AddEintOp>(
+            location, halfType, slice(flat, 0, half),
+            slice(flat, half, half));
+        forwardOptimizerID(sumOp, halved);
+        mlir::Value next = halved.getResult();
+        if (n % 2 == 1) {
+          // Fold the odd leftover element into the first lane.
+          auto oneType = mlir::RankedTensorType::get({1}, outputType);
+          auto firstSum = rewriter.create<FHELinalg::AddEintOp>(
+              location, oneType, slice(next, 0, 1), slice(flat, n - 1, 1));
+          forwardOptimizerID(sumOp, firstSum);
+          llvm::SmallVector<mlir::OpFoldResult, 1> offsets{
+              rewriter.getIndexAttr(0)};
+          llvm::SmallVector<mlir::OpFoldResult, 1> sizes{
+              rewriter.getIndexAttr(1)};
+          llvm::SmallVector<mlir::OpFoldResult, 1> strides{
+              rewriter.getIndexAttr(1)};
+          next = rewriter
+                     .create<mlir::tensor::InsertSliceOp>(
+                         location, firstSum.getResult(), next, offsets, sizes,
+                         strides)
+                     .getResult();
+        }
+        flat = next;
+        n = half;
+      }
+      // The remaining short vector takes the plain reduction: the new sum
+      // is below the threshold and matches this pattern again through the
+      // generic path.
+      auto remaining = rewriter.create<FHELinalg::SumOp>(
+          location, outputType, flat, rewriter.getI64ArrayAttr({}),
+          rewriter.getBoolAttr(false));
+      forwardOptimizerID(sumOp, remaining);
+      rewriter.replaceOp(sumOp, remaining.getResult());
+      return mlir::success();
+    }
+
     mlir::Type accumulatorType = outputType;
     if (!outputIsTensor) {
       int64_t accumulatorShape[1] = {1};
@@ -1309,7 +1383,7 @@ struct TransposeToLinalgGeneric
     mlir::Value zeroTensor =
         rewriter.create<FHE::ZeroTensorOp>(location, outputType).getResult();
 
-    std::vector<unsigned int> perms = {};
+    llvm::SmallVector<unsigned int, 4> perms = {};
 
     mlir::ArrayAttr axes = transposeOp.getAxes();
     if (axes.empty()) {
@@ -1691,13 +1765,16 @@ struct FHELinalgConv2dToLinalgConv2d
         conv2dOp->getAttrOfType<mlir::IntegerAttr>("TFHE.OId");
 
     // Create named attr for custom linalg op
-    std::vector<mlir::NamedAttribute> addOpDict = {rewriter.getNamedAttr(
-        "op", rewriter.getStringAttr(
-                  mlir::concretelang::FHE::AddEintOp::getOperationName()))};
-    std::vector<mlir::NamedAttribute> mulOpDict = {rewriter.getNamedAttr(
-        "op", rewriter.getStringAttr(
-                  mlir::concretelang::FHE::MulEintIntOp::getOperationName()))};
-    std::vector<mlir::NamedAttribute> opAttrs;
+    llvm::SmallVector<mlir::NamedAttribute, 2> addOpDict = {
+        rewriter.getNamedAttr(
+            "op", rewriter.getStringAttr(
+                      mlir::concretelang::FHE::AddEintOp::getOperationName()))};
+    llvm::SmallVector<mlir::NamedAttribute, 2> mulOpDict = {
+        rewriter.getNamedAttr(
+            "op",
+            rewriter.getStringAttr(
+                mlir::concretelang::FHE::MulEintIntOp::getOperationName()))};
+    llvm::SmallVector<mlir::NamedAttribute, 1> opAttrs;
     if (optimizerIdAttr != nullptr) {
       opAttrs.push_back(rewriter.getNamedAttr("TFHE.OId", optimizerIdAttr));
     }
@@ -1711,7 +1788,8 @@ struct FHELinalgConv2dToLinalgConv2d
         rewriter.getNamedAttr("add", rewriter.getDictionaryAttr(addOpDict));
     auto mulOpAttr =
         rewriter.getNamedAttr("mul", rewriter.getDictionaryAttr(mulOpDict));
-    std::vector<mlir::NamedAttribute> namedAttr({addOpAttr, mulOpAttr});
+    llvm::SmallVector<mlir::NamedAttribute, 2> namedAttr(
+        {addOpAttr, mulOpAttr});
 
     mlir::Location loc = conv2dOp->getLoc();
     mlir::Value input =
@@ -1831,10 +1909,11 @@ struct FHELinalgMaxpool2dToLinalgMaxpool2d
 
     const mlir::Location loc = maxpool2dOp->getLoc();
 
-    std::vector<mlir::NamedAttribute> maxOpDict = {rewriter.getNamedAttr(
-        "op", rewriter.getStringAttr(
-                  mlir::concretelang::FHE::MaxEintOp::getOperationName()))};
-    std::vector<mlir::NamedAttribute> opAttrs;
+    llvm::SmallVector<mlir::NamedAttribute, 2> maxOpDict = {
+        rewriter.getNamedAttr(
+            "op", rewriter.getStringAttr(
+                      mlir::concretelang::FHE::MaxEintOp::getOperationName()))};
+    llvm::SmallVector<mlir::NamedAttribute, 1> opAttrs;
     if (optimizerIdAttr != nullptr) {
       opAttrs.push_back(rewriter.getNamedAttr("TFHE.OId", optimizerIdAttr));
     }
@@ -132,6 +132,11 @@ struct CrtOpPattern : public mlir::OpConversionPattern<T> {
   /// execute the input lambda to write the loop body. Returns the first result
   /// of the op.
   ///
+  /// The loop is tagged with the `crt_residue_loop` attribute: each
+  /// iteration processes one residue of the decomposition and touches no
+  /// state of the others, so later transformations can recognize residue
+  /// branches without re-deriving that independence.
+  ///
   /// Note:
   /// -----
   ///
@@ -158,6 +163,7 @@ struct CrtOpPattern : public mlir::OpConversionPattern<T> {
     mlir::scf::ForOp newOp = rewriter.create<mlir::scf::ForOp>(
         location, zeroConstantOp, crtSizeConstantOp, oneConstantOp, tensor,
         body);
+    newOp->setAttr("crt_residue_loop", rewriter.getUnitAttr());
 
     return newOp.getResult(0);
   }
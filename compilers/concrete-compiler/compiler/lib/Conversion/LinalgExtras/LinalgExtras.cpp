@@ -3,9 +3,14 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
+#include <optional>
+
 #include <concretelang/Conversion/Passes.h>
+#include <concretelang/Dialect/FHE/IR/FHEOps.h>
 #include <concretelang/Support/LinalgExtras.h>
 #include <mlir/Dialect/Linalg/IR/Linalg.h>
+#include <mlir/Dialect/Tensor/IR/Tensor.h>
 #include <mlir/Transforms/GreedyPatternRewriteDriver.h>
 
 namespace {
@@ -22,6 +27,257 @@ private:
 };
 } // namespace
 
+/// Number of partial accumulators targeted when splitting an encrypted
+/// add-reduction. The reduction dimension is divided into at most this
+/// many chunks, each of which is accumulated independently and can thus
+/// be executed on a separate core.
+constexpr int64_t REDUCTION_SPLIT_TARGET_PARTIALS = 16;
+
+/// Minimum trip count of a reduction dimension for splitting to pay
+/// off; below this, the per-chunk overhead is not worth the added
+/// partial accumulators.
+constexpr int64_t REDUCTION_SPLIT_MIN_TRIP = 256;
+
+/// Returns the largest divisor of `n` that is less than or equal to
+/// `bound`, falling back to 1 if no divisor is in range.
+static int64_t largestDivisorUpTo(int64_t n, int64_t bound) {
+  for (int64_t d = std::min(n, bound); d >= 2; d--) {
+    if (n % d == 0)
+      return d;
+  }
+  return 1;
+}
+
+/// Splits the reduction dimension of `linalg.generic` operations that
+/// accumulate ciphertexts with `FHE.add_eint` into a parallel chunk
+/// dimension and a smaller reduction dimension, followed by a final
+/// combine of the partial accumulators.
+///
+/// Homomorphic addition is associative, so a full add-reduction such as
+/// an encrypted dot product or `FHELinalg.sum` can be computed as
+/// independent partial sums. The rewritten form exposes a parallel
+/// iterator that the subsequent lowering to loops marks as parallel,
+/// which ultimately yields an `scf.parallel` loop over the chunks
+/// instead of a fully serial reduction. The final combine only iterates
+/// over the partial accumulators and is negligible in comparison.
+///
+/// Only applied when the existing parallel dimensions do not already
+/// provide enough parallelism on their own.
+class SplitAddReductionPattern
+    : public mlir::OpRewritePattern<mlir::linalg::GenericOp> {
+public:
+  SplitAddReductionPattern(::mlir::MLIRContext *context,
+                           mlir::PatternBenefit benefit = 1)
+      : ::mlir::OpRewritePattern<mlir::linalg::GenericOp>(context, benefit) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::linalg::GenericOp genericOp,
+                  mlir::PatternRewriter &rewriter) const override {
+    namespace FHE = mlir::concretelang::FHE;
+
+    if (!genericOp.hasTensorSemantics() || genericOp.getNumDpsInits() != 1 ||
+        genericOp->getNumResults() != 1)
+      return mlir::failure();
+
+    // The body must be a pure add-reduction over ciphertexts: the
+    // yielded value is an `FHE.add_eint` of the accumulator argument,
+    // which has no other use.
+    mlir::Block &body = genericOp.getRegion().front();
+    auto yieldOp = mlir::cast<mlir::linalg::YieldOp>(body.getTerminator());
+    auto addOp = yieldOp->getOperand(0).getDefiningOp<FHE::AddEintOp>();
+    if (addOp == nullptr)
+      return mlir::failure();
+    mlir::BlockArgument acc = body.getArguments().back();
+    if (!acc.hasOneUse() ||
+        (addOp->getOperand(0) != acc && addOp->getOperand(1) != acc))
+      return mlir::failure();
+
+    // Select the largest static reduction dimension and check that the
+    // parallel dimensions do not already expose enough parallelism.
+    llvm::SmallVector<mlir::utils::IteratorType> iterators =
+        genericOp.getIteratorTypesArray();
+    llvm::SmallVector<int64_t> loopRanges = genericOp.getStaticLoopRanges();
+    int64_t numLoops = (int64_t)iterators.size();
+    int64_t parallelTrip = 1;
+    int64_t splitDim = -1;
+    int64_t splitTrip = 0;
+    for (int64_t i = 0; i < numLoops; i++) {
+      if (mlir::ShapedType::isDynamic(loopRanges[i]))
+        return mlir::failure();
+      if (mlir::linalg::isParallelIterator(iterators[i])) {
+        parallelTrip *= loopRanges[i];
+      } else if (loopRanges[i] > splitTrip) {
+        splitDim = i;
+        splitTrip = loopRanges[i];
+      }
+    }
+    if (splitDim < 0 || splitTrip < REDUCTION_SPLIT_MIN_TRIP ||
+        parallelTrip >= REDUCTION_SPLIT_TARGET_PARTIALS)
+      return mlir::failure();
+
+    int64_t chunks =
+        largestDivisorUpTo(splitTrip, REDUCTION_SPLIT_TARGET_PARTIALS);
+    if (chunks < 2)
+      return mlir::failure();
+
+    // The split dimension may only be accessed directly, i.e. through a
+    // plain dimension expression, so that the corresponding tensor
+    // dimension can be expanded into a chunk and an intra-chunk
+    // dimension.
+    mlir::AffineExpr splitExpr = rewriter.getAffineDimExpr(splitDim);
+    for (mlir::OpOperand &opOperand : genericOp->getOpOperands()) {
+      auto tensorTy =
+          opOperand.get().getType().dyn_cast<mlir::RankedTensorType>();
+      if (tensorTy == nullptr || !tensorTy.hasStaticShape())
+        return mlir::failure();
+
+      mlir::AffineMap map = genericOp.getMatchingIndexingMap(&opOperand);
+      unsigned numSplitResults = 0;
+      for (mlir::AffineExpr expr : map.getResults()) {
+        if (expr == splitExpr)
+          numSplitResults++;
+        else if (expr.isFunctionOfDim(splitDim))
+          return mlir::failure();
+      }
+      if (numSplitResults > 1 ||
+          (numSplitResults == 1 && genericOp.isDpsInit(&opOperand)))
+        return mlir::failure();
+    }
+
+    mlir::Location loc = genericOp.getLoc();
+    mlir::MLIRContext *ctx = rewriter.getContext();
+
+    // In the partial reduction, dimension `splitDim` becomes the
+    // parallel chunk dimension and `splitDim + 1` the remaining
+    // reduction; all subsequent dimensions are shifted by one.
+    llvm::SmallVector<mlir::AffineExpr> dimRepl;
+    for (int64_t d = 0; d < numLoops; d++)
+      dimRepl.push_back(mlir::getAffineDimExpr(d < splitDim ? d : d + 1, ctx));
+
+    llvm::SmallVector<mlir::Value> partialIns;
+    llvm::SmallVector<mlir::AffineMap> partialMaps;
+    for (mlir::OpOperand *inputOperand : genericOp.getDpsInputOperands()) {
+      mlir::Value input = inputOperand->get();
+      mlir::AffineMap map = genericOp.getMatchingIndexingMap(inputOperand);
+
+      llvm::SmallVector<mlir::AffineExpr> results;
+      std::optional<int64_t> expandedDim;
+      for (auto expr : llvm::enumerate(map.getResults())) {
+        if (expr.value() == splitExpr) {
+          expandedDim = (int64_t)expr.index();
+          results.push_back(mlir::getAffineDimExpr(splitDim, ctx));
+          results.push_back(mlir::getAffineDimExpr(splitDim + 1, ctx));
+        } else {
+          results.push_back(expr.value().replaceDimsAndSymbols(dimRepl, {}));
+        }
+      }
+      partialMaps.push_back(
+          mlir::AffineMap::get(numLoops + 1, 0, results, ctx));
+
+      if (expandedDim.has_value()) {
+        auto tensorTy = input.getType().cast<mlir::RankedTensorType>();
+        llvm::SmallVector<int64_t> expandedShape;
+        llvm::SmallVector<mlir::ReassociationIndices> reassociation;
+        int64_t nextDim = 0;
+        for (int64_t i = 0; i < tensorTy.getRank(); i++) {
+          if (i == *expandedDim) {
+            expandedShape.push_back(chunks);
+            expandedShape.push_back(splitTrip / chunks);
+            reassociation.push_back({nextDim, nextDim + 1});
+            nextDim += 2;
+          } else {
+            expandedShape.push_back(tensorTy.getDimSize(i));
+            reassociation.push_back({nextDim});
+            nextDim += 1;
+          }
+        }
+        input = rewriter.create<mlir::tensor::ExpandShapeOp>(
+            loc,
+            mlir::RankedTensorType::get(expandedShape,
+                                        tensorTy.getElementType()),
+            input, reassociation);
+      }
+      partialIns.push_back(input);
+    }
+
+    // Partial accumulators: one copy of the original output per chunk,
+    // each starting from the neutral element.
+    mlir::OpOperand *initOperand = genericOp.getDpsInitOperand(0);
+    auto outTy = initOperand->get().getType().cast<mlir::RankedTensorType>();
+    llvm::SmallVector<int64_t> partialShape{chunks};
+    partialShape.append(outTy.getShape().begin(), outTy.getShape().end());
+    auto partialTy =
+        mlir::RankedTensorType::get(partialShape, outTy.getElementType());
+    mlir::Value partialInit =
+        rewriter.create<FHE::ZeroTensorOp>(loc, partialTy).getResult();
+
+    llvm::SmallVector<mlir::AffineExpr> partialOutResults{
+        mlir::getAffineDimExpr(splitDim, ctx)};
+    for (mlir::AffineExpr expr :
+         genericOp.getMatchingIndexingMap(initOperand).getResults())
+      partialOutResults.push_back(expr.replaceDimsAndSymbols(dimRepl, {}));
+    partialMaps.push_back(
+        mlir::AffineMap::get(numLoops + 1, 0, partialOutResults, ctx));
+
+    llvm::SmallVector<mlir::utils::IteratorType> partialIterators(
+        iterators.begin(), iterators.begin() + splitDim);
+    partialIterators.push_back(mlir::utils::IteratorType::parallel);
+    partialIterators.append(iterators.begin() + splitDim, iterators.end());
+
+    llvm::StringRef doc{""};
+    llvm::StringRef call{""};
+
+    mlir::linalg::GenericOp partialOp =
+        rewriter.create<mlir::linalg::GenericOp>(
+            loc, mlir::TypeRange{partialTy}, partialIns,
+            mlir::ValueRange{partialInit}, partialMaps, partialIterators, doc,
+            call,
+            [&](mlir::OpBuilder &nestedBuilder, mlir::Location nestedLoc,
+                mlir::ValueRange blockArgs) {
+              mlir::IRMapping map;
+              map.map(body.getArguments(), blockArgs);
+              for (mlir::Operation &op : body.without_terminator()) {
+                auto *newOp = nestedBuilder.clone(op, map);
+                map.map(op.getResults(), newOp->getResults());
+              }
+              nestedBuilder.create<mlir::linalg::YieldOp>(
+                  nestedLoc, map.lookupOrDefault(yieldOp->getOperand(0)));
+            });
+
+    // Combine the partial accumulators into the original init value.
+    int64_t outRank = outTy.getRank();
+    llvm::SmallVector<mlir::AffineExpr> combineOutResults;
+    for (int64_t i = 0; i < outRank; i++)
+      combineOutResults.push_back(mlir::getAffineDimExpr(i + 1, ctx));
+    llvm::SmallVector<mlir::AffineMap> combineMaps{
+        mlir::AffineMap::getMultiDimIdentityMap(outRank + 1, ctx),
+        mlir::AffineMap::get(outRank + 1, 0, combineOutResults, ctx)};
+    llvm::SmallVector<mlir::utils::IteratorType> combineIterators{
+        mlir::utils::IteratorType::reduction};
+    combineIterators.append(outRank, mlir::utils::IteratorType::parallel);
+
+    mlir::linalg::GenericOp combineOp =
+        rewriter.create<mlir::linalg::GenericOp>(
+            loc, mlir::TypeRange{outTy},
+            mlir::ValueRange{partialOp.getResult(0)},
+            mlir::ValueRange{initOperand->get()}, combineMaps,
+            combineIterators, doc, call,
+            [&](mlir::OpBuilder &nestedBuilder, mlir::Location nestedLoc,
+                mlir::ValueRange blockArgs) {
+              auto combineAdd = nestedBuilder.create<FHE::AddEintOp>(
+                  nestedLoc, blockArgs[0], blockArgs[1]);
+              if (auto optimizerIdAttr = addOp->getAttr("TFHE.OId"))
+                combineAdd->setAttr("TFHE.OId", optimizerIdAttr);
+              nestedBuilder.create<mlir::linalg::YieldOp>(
+                  nestedLoc, combineAdd.getResult());
+            });
+
+    rewriter.replaceOp(genericOp, combineOp.getResult(0));
+
+    return mlir::success();
+  };
+};
+
 template <typename LoopType>
 class LinalgRewritePattern
     : public mlir::OpRewritePattern<mlir::linalg::GenericOp> {
@@ -56,6 +312,8 @@ void LinalgGenericOpWithTensorsToLoopsPass::runOnOperation() {
   auto op = this->getOperation();
 
   mlir::RewritePatternSet patterns(&getContext());
+  if (parallelizeLoops)
+    patterns.insert<SplitAddReductionPattern>(&getContext());
   patterns.insert<LinalgRewritePattern<mlir::scf::ForOp>>(&getContext(),
                                                           parallelizeLoops);
   (void)applyPatternsAndFoldGreedily(op, std::move(patterns));
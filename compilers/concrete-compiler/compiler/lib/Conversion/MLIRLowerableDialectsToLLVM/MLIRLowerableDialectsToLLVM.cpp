@@ -113,6 +113,10 @@ void MLIRLowerableDialectsToLLVMPass::runOnOperation() {
   // Setup the LLVMTypeConverter (that converts `std` types to `llvm` types) and
   // add our types conversion to `llvm` compatible type.
   mlir::LowerToLLVMOptions options(&getContext());
+  // Lower memref allocations to the generic MLIR allocation functions
+  // instead of malloc/free, so the runtime can back them with its
+  // thread-local allocation cache (see Runtime/runtime_allocator.h).
+  options.useGenericFunctions = true;
   mlir::LLVMTypeConverter typeConverter(&getContext(), options);
   typeConverter.addConversion(convertTypes);
 
@@ -93,6 +93,73 @@ struct TensorToMemrefOp : public BufferizableOpInterface::ExternalModel<
   }
 };
 
+/// Bufferization for the elementwise levelled ops (add, add_plaintext,
+/// mul_cleartext, negate and their batched forms): the result has the
+/// shape of the ciphertext operand and the runtime wrappers tolerate
+/// `out == in`, so the result reuses the operand's buffer instead of a
+/// fresh allocation. The operand is declared as written and equivalent
+/// to the result; when the analysis finds it live elsewhere, the
+/// framework inserts the copy, so the reuse only happens where the
+/// operand is provably dead.
+template <typename TensorOp, typename MemrefOp>
+struct InPlaceTensorToMemrefOp
+    : public BufferizableOpInterface::ExternalModel<
+          InPlaceTensorToMemrefOp<TensorOp, MemrefOp>, TensorOp> {
+  bool bufferizesToMemoryRead(Operation *op, OpOperand &opOperand,
+                              const AnalysisState &state) const {
+    return true;
+  }
+
+  bool bufferizesToMemoryWrite(Operation *op, OpOperand &opOperand,
+                               const AnalysisState &state) const {
+    // The ciphertext operand's buffer receives the result.
+    return opOperand.getOperandNumber() == 0;
+  }
+
+  AliasingOpResultList getAliasingOpResults(Operation *op, OpOperand &opOperand,
+                                            const AnalysisState &state) const {
+    if (opOperand.getOperandNumber() == 0)
+      return {{op->getOpResult(0), BufferRelation::Equivalent}};
+    return {};
+  }
+
+  BufferRelation bufferRelation(Operation *op, OpResult opResult,
+                                const AnalysisState &state) const {
+    return BufferRelation::Equivalent;
+  }
+
+  LogicalResult bufferize(Operation *op, RewriterBase &rewriter,
+                          const BufferizationOptions &options) const {
+    auto loc = op->getLoc();
+
+    auto outMemref =
+        bufferization::getBuffer(rewriter, op->getOpOperand(0).get(), options);
+    if (mlir::failed(outMemref)) {
+      return mlir::failure();
+    }
+
+    // The first operand is the result, here the in-place reuse of the
+    // ciphertext operand's buffer.
+    mlir::SmallVector<mlir::Value, 3> operands{
+        *outMemref,
+    };
+    for (auto &operand : op->getOpOperands()) {
+      if (!operand.get().getType().isa<mlir::RankedTensorType>()) {
+        operands.push_back(operand.get());
+      } else {
+        operands.push_back(
+            *bufferization::getBuffer(rewriter, operand.get(), options));
+      }
+    }
+
+    rewriter.create<MemrefOp>(loc, mlir::TypeRange{}, operands, op->getAttrs());
+
+    replaceOpWithBufferizedValues(rewriter, op, *outMemref);
+
+    return success();
+  }
+};
+
 } // namespace
 
 void mlir::concretelang::Concrete::
@@ -100,22 +167,21 @@ void mlir::concretelang::Concrete::
   registry.addExtension(+[](MLIRContext *ctx,
                             Concrete::ConcreteDialect *dialect) {
     // add_lwe_tensor => add_lwe_buffer
-    Concrete::AddLweTensorOp::attachInterface<
-        TensorToMemrefOp<Concrete::AddLweTensorOp, Concrete::AddLweBufferOp>>(
-        *ctx);
+    Concrete::AddLweTensorOp::attachInterface<InPlaceTensorToMemrefOp<
+        Concrete::AddLweTensorOp, Concrete::AddLweBufferOp>>(*ctx);
     // add_plaintext_lwe_tensor => add_plaintext_lwe_buffer
-    Concrete::AddPlaintextLweTensorOp::attachInterface<TensorToMemrefOp<
+    Concrete::AddPlaintextLweTensorOp::attachInterface<InPlaceTensorToMemrefOp<
         Concrete::AddPlaintextLweTensorOp, Concrete::AddPlaintextLweBufferOp>>(
         *ctx);
     // mul_cleartext_lwe_tensor => mul_cleartext_lwe_buffer
-    Concrete::MulCleartextLweTensorOp::attachInterface<TensorToMemrefOp<
+    Concrete::MulCleartextLweTensorOp::attachInterface<InPlaceTensorToMemrefOp<
         Concrete::MulCleartextLweTensorOp, Concrete::MulCleartextLweBufferOp>>(
         *ctx);
     // negate_cleartext_lwe_tensor => negate_cleartext_lwe_buffer
-    Concrete::NegateLweTensorOp::attachInterface<TensorToMemrefOp<
+    Concrete::NegateLweTensorOp::attachInterface<InPlaceTensorToMemrefOp<
         Concrete::NegateLweTensorOp, Concrete::NegateLweBufferOp>>(*ctx);
     // negate_cleartext_lwe_tensor => negate_cleartext_lwe_buffer
-    Concrete::NegateLweTensorOp::attachInterface<TensorToMemrefOp<
+    Concrete::NegateLweTensorOp::attachInterface<InPlaceTensorToMemrefOp<
         Concrete::NegateLweTensorOp, Concrete::NegateLweBufferOp>>(*ctx);
     // keyswitch_lwe_tensor => keyswitch_lwe_buffer
     Concrete::KeySwitchLweTensorOp::attachInterface<TensorToMemrefOp<
@@ -125,30 +191,30 @@ void mlir::concretelang::Concrete::
         Concrete::BootstrapLweTensorOp, Concrete::BootstrapLweBufferOp>>(*ctx);
 
     // batched_add_lwe_tensor => batched_add_lwe_buffer
-    Concrete::BatchedAddLweTensorOp::attachInterface<TensorToMemrefOp<
+    Concrete::BatchedAddLweTensorOp::attachInterface<InPlaceTensorToMemrefOp<
         Concrete::BatchedAddLweTensorOp, Concrete::BatchedAddLweBufferOp>>(
         *ctx);
     // batched_add_plaintext_lwe_tensor => batched_add_plaintext_lwe_buffer
     Concrete::BatchedAddPlaintextLweTensorOp::attachInterface<
-        TensorToMemrefOp<Concrete::BatchedAddPlaintextLweTensorOp,
+        InPlaceTensorToMemrefOp<Concrete::BatchedAddPlaintextLweTensorOp,
                          Concrete::BatchedAddPlaintextLweBufferOp>>(*ctx);
     // batched_add_plaintext_cst_lwe_tensor =>
     // batched_add_plaintext_cst_lwe_buffer
     Concrete::BatchedAddPlaintextCstLweTensorOp::attachInterface<
-        TensorToMemrefOp<Concrete::BatchedAddPlaintextCstLweTensorOp,
+        InPlaceTensorToMemrefOp<Concrete::BatchedAddPlaintextCstLweTensorOp,
                          Concrete::BatchedAddPlaintextCstLweBufferOp>>(*ctx);
     // batched_mul_cleartext_lwe_tensor => batched_mul_cleartext_lwe_buffer
     Concrete::BatchedMulCleartextLweTensorOp::attachInterface<
-        TensorToMemrefOp<Concrete::BatchedMulCleartextLweTensorOp,
+        InPlaceTensorToMemrefOp<Concrete::BatchedMulCleartextLweTensorOp,
                          Concrete::BatchedMulCleartextLweBufferOp>>(*ctx);
     // batched_mul_cleartext_cst_lwe_tensor =>
     // batched_mul_cleartext_cst_lwe_buffer
     Concrete::BatchedMulCleartextCstLweTensorOp::attachInterface<
-        TensorToMemrefOp<Concrete::BatchedMulCleartextCstLweTensorOp,
+        InPlaceTensorToMemrefOp<Concrete::BatchedMulCleartextCstLweTensorOp,
                          Concrete::BatchedMulCleartextCstLweBufferOp>>(*ctx);
     // batched_negate_lwe_tensor => batched_negate_lwe_buffer
     Concrete::BatchedNegateLweTensorOp::attachInterface<
-        TensorToMemrefOp<Concrete::BatchedNegateLweTensorOp,
+        InPlaceTensorToMemrefOp<Concrete::BatchedNegateLweTensorOp,
                          Concrete::BatchedNegateLweBufferOp>>(*ctx);
 
     // batched_keyswitch_lwe_tensor => batched_keyswitch_lwe_buffer
@@ -164,6 +230,14 @@ void mlir::concretelang::Concrete::
     Concrete::BatchedMappedBootstrapLweTensorOp::attachInterface<
         TensorToMemrefOp<Concrete::BatchedMappedBootstrapLweTensorOp,
                          Concrete::BatchedMappedBootstrapLweBufferOp>>(*ctx);
+    // batched_glwe_pack_lwe_tensor => batched_glwe_pack_lwe_buffer
+    Concrete::BatchedGlwePackLweTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::BatchedGlwePackLweTensorOp,
+                         Concrete::BatchedGlwePackLweBufferOp>>(*ctx);
+    // batched_glwe_unpack_lwe_tensor => batched_glwe_unpack_lwe_buffer
+    Concrete::BatchedGlweUnpackLweTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::BatchedGlweUnpackLweTensorOp,
+                         Concrete::BatchedGlweUnpackLweBufferOp>>(*ctx);
     // wop_pbs_crt_lwe_tensor => wop_pbs_crt_lwe_buffer
     Concrete::WopPBSCRTLweTensorOp::attachInterface<TensorToMemrefOp<
         Concrete::WopPBSCRTLweTensorOp, Concrete::WopPBSCRTLweBufferOp>>(*ctx);
@@ -0,0 +1,145 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <cstdlib>
+#include <cstring>
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+
+#include "concretelang/Dialect/Concrete/IR/ConcreteDialect.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+
+namespace {
+
+namespace Concrete = mlir::concretelang::Concrete;
+
+/// The pass is opt-in: packing is only sound when the evaluation keys of
+/// the circuit contain the packing keyswitch key, which the IR cannot
+/// check, so the user enables it explicitly. `CONCRETE_GLWE_PACKING=ON`
+/// enables it with the default live-range threshold; a numeric value
+/// enables it and overrides the threshold.
+bool glwePackingEnabled(size_t &minLiveRange) {
+  char *env = getenv("CONCRETE_GLWE_PACKING");
+  if (env == nullptr || strcmp(env, "OFF") == 0)
+    return false;
+  if (strcmp(env, "ON") != 0) {
+    size_t threshold = strtoul(env, nullptr, 10);
+    if (threshold > 0)
+      minLiveRange = threshold;
+  }
+  return true;
+}
+
+/// For documentation see Passes.td
+struct GlwePackingPass : public GlwePackingBase<GlwePackingPass> {
+  void runOnOperation() final {
+    // A packed batch carries poly_size ciphertexts per mask instead of
+    // one, but pays one packing keyswitch per ciphertext. Only batches
+    // that stay live across at least this many operations are packed.
+    size_t minLiveRange = 4;
+    if (!glwePackingEnabled(minLiveRange))
+      return;
+
+    getOperation()->walk(
+        [&](mlir::Block *block) { processBlock(block, minLiveRange); });
+  }
+
+protected:
+  /// Packs the bootstrap results of `block` whose first use is more than
+  /// `minLiveRange` operations away. Bootstrap outputs are the only
+  /// batches known from the IR to live under the big key the packing
+  /// keyswitch key was generated for.
+  void processBlock(mlir::Block *block, size_t minLiveRange) {
+    // Number the operations of the block once to measure live ranges.
+    llvm::DenseMap<mlir::Operation *, size_t> position;
+    size_t index = 0;
+    for (mlir::Operation &op : *block)
+      position[&op] = index++;
+
+    for (mlir::Operation &op : llvm::make_early_inc_range(*block)) {
+      uint32_t glweDim;
+      uint32_t polySize;
+      if (auto bsOp =
+              llvm::dyn_cast<Concrete::BatchedBootstrapLweTensorOp>(&op)) {
+        glweDim = bsOp.getGlweDimension();
+        polySize = bsOp.getPolySize();
+      } else if (auto mbsOp = llvm::dyn_cast<
+                     Concrete::BatchedMappedBootstrapLweTensorOp>(&op)) {
+        glweDim = mbsOp.getGlweDimension();
+        polySize = mbsOp.getPolySize();
+      } else {
+        continue;
+      }
+
+      mlir::Value result = op.getResult(0);
+      auto resultType = result.getType().cast<mlir::RankedTensorType>();
+      if (!resultType.hasStaticShape())
+        continue;
+      int64_t batchSize = resultType.getDimSize(0);
+      int64_t lweSize = resultType.getDimSize(1);
+
+      // The packing keyswitch key consumes ciphertexts under the big key
+      // of the partition the bootstrap writes to.
+      if (lweSize != (int64_t)glweDim * polySize + 1)
+        continue;
+
+      // A partially filled single GLWE still shrinks memory, but the
+      // saving only dominates the keyswitch cost once slots fill up.
+      if (batchSize < (int64_t)polySize)
+        continue;
+
+      int64_t numGlwe = (batchSize + polySize - 1) / polySize;
+      int64_t glweSize = (int64_t)(glweDim + 1) * polySize;
+      if (numGlwe * glweSize >= batchSize * lweSize)
+        continue;
+
+      // All users must be dominated by an unpack inserted in front of
+      // the first one, so restrict to straight-line uses in the block.
+      mlir::Operation *firstUser = nullptr;
+      bool sameBlock = true;
+      for (mlir::Operation *user : result.getUsers()) {
+        if (user->getBlock() != block) {
+          sameBlock = false;
+          break;
+        }
+        if (firstUser == nullptr || position[user] < position[firstUser])
+          firstUser = user;
+      }
+      if (!sameBlock || firstUser == nullptr)
+        continue;
+      if (position[firstUser] - position[&op] <= minLiveRange)
+        continue;
+
+      mlir::OpBuilder builder(&op);
+      builder.setInsertionPointAfter(&op);
+      auto packedType = mlir::RankedTensorType::get(
+          {numGlwe, glweSize}, resultType.getElementType());
+      auto packOp = builder.create<Concrete::BatchedGlwePackLweTensorOp>(
+          op.getLoc(), packedType, result,
+          builder.getI32IntegerAttr(glweDim),
+          builder.getI32IntegerAttr(polySize), builder.getI32IntegerAttr(0));
+
+      builder.setInsertionPoint(firstUser);
+      auto unpackOp = builder.create<Concrete::BatchedGlweUnpackLweTensorOp>(
+          op.getLoc(), resultType, packOp.getResult(),
+          builder.getI32IntegerAttr(glweDim),
+          builder.getI32IntegerAttr(polySize));
+
+      result.replaceAllUsesExcept(unpackOp.getResult(), packOp);
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<OperationPass<ModuleOp>> createGlwePackingPass() {
+  return std::make_unique<GlwePackingPass>();
+}
+} // namespace concretelang
+} // namespace mlir
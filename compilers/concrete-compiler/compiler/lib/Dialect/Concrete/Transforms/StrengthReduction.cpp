@@ -0,0 +1,144 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "concretelang/Dialect/Concrete/IR/ConcreteDialect.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+
+namespace Concrete = mlir::concretelang::Concrete;
+
+namespace {
+
+/// Value of the cleartext operand, when it is a constant.
+std::optional<int64_t> constantCleartext(mlir::Value cleartext) {
+  auto constantOp = cleartext.getDefiningOp<mlir::arith::ConstantOp>();
+  if (constantOp == nullptr)
+    return std::nullopt;
+  auto attr = constantOp.getValue().dyn_cast<mlir::IntegerAttr>();
+  if (attr == nullptr)
+    return std::nullopt;
+  return attr.getInt();
+}
+
+/// Replaces `ciphertext` by an elementwise left shift of its
+/// coefficients by `amount` bits, the strength-reduced form of a
+/// multiplication by 2^amount: the shift loop vectorizes where the
+/// generic 64-bit multiply loop of the runtime entry point does not.
+mlir::Value createShiftLeft(mlir::PatternRewriter &rewriter,
+                            mlir::Location loc, mlir::Value ciphertext,
+                            unsigned amount) {
+  auto type = ciphertext.getType().cast<mlir::RankedTensorType>();
+  unsigned rank = type.getShape().size();
+  mlir::Value shiftAmount = rewriter.create<mlir::arith::ConstantOp>(
+      loc, rewriter.getI64IntegerAttr(amount));
+
+  llvm::SmallVector<mlir::Type, 1> resTypes{type};
+  llvm::SmallVector<mlir::Value, 1> ins{ciphertext};
+  llvm::SmallVector<mlir::Value, 1> outs{ciphertext};
+  llvm::SmallVector<mlir::AffineMap, 2> maps{
+      mlir::AffineMap::getMultiDimIdentityMap(rank, rewriter.getContext()),
+      mlir::AffineMap::getMultiDimIdentityMap(rank, rewriter.getContext())};
+  llvm::SmallVector<mlir::utils::IteratorType> itTypes(
+      rank, mlir::utils::IteratorType::parallel);
+
+  auto regBuilder = [&](mlir::OpBuilder &nestedBuilder,
+                        mlir::Location nestedLoc,
+                        mlir::ValueRange blockArgs) {
+    auto shifted = nestedBuilder.create<mlir::arith::ShLIOp>(
+        nestedLoc, blockArgs[0], shiftAmount);
+    nestedBuilder.create<mlir::linalg::YieldOp>(nestedLoc,
+                                                shifted.getResult());
+  };
+
+  return rewriter
+      .create<mlir::linalg::GenericOp>(loc, resTypes, ins, outs, maps,
+                                       itTypes, /*doc=*/"", /*call=*/"",
+                                       regBuilder)
+      .getResult(0);
+}
+
+/// Strength-reduces a cleartext multiplication with a known constant.
+/// The generic form multiplies every coefficient of the ciphertext by
+/// the cleartext; multiplications by 0, +-1 and +-2^k have cheaper
+/// equivalents. `MulOp` is the scalar or the batched-constant variant,
+/// both a tensor of i64 coefficients times one I64 cleartext.
+template <typename MulOp, typename NegateOp>
+struct ReducedMulPattern : public mlir::OpRewritePattern<MulOp> {
+  ReducedMulPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<MulOp>(context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(MulOp op, mlir::PatternRewriter &rewriter) const override {
+    auto cleartext = constantCleartext(op.getRhs());
+    if (!cleartext)
+      return mlir::failure();
+    const int64_t value = *cleartext;
+    auto type = op.getResult().getType().template cast<mlir::TensorType>();
+
+    if (value == 1) {
+      rewriter.replaceOp(op, op.getLhs());
+      return mlir::success();
+    }
+    if (value == -1) {
+      rewriter.replaceOpWithNewOp<NegateOp>(op, type, op.getLhs());
+      return mlir::success();
+    }
+    if (value == 0 && type.hasStaticShape()) {
+      // The all-zero tensor is the trivial (noiseless) encryption of 0,
+      // exactly what multiplying every coefficient by 0 produces.
+      rewriter.replaceOpWithNewOp<mlir::arith::ConstantOp>(
+          op, mlir::DenseElementsAttr::get(
+                  type.template cast<mlir::ShapedType>(),
+                  rewriter.getI64IntegerAttr(0)));
+      return mlir::success();
+    }
+
+    const uint64_t magnitude = value < 0 ? -(uint64_t)value : (uint64_t)value;
+    if (magnitude > 1 && llvm::isPowerOf2_64(magnitude)) {
+      mlir::Value shifted = createShiftLeft(rewriter, op.getLoc(),
+                                            op.getLhs(),
+                                            llvm::Log2_64(magnitude));
+      if (value < 0)
+        shifted = rewriter.create<NegateOp>(op.getLoc(), type, shifted)
+                      .getResult();
+      rewriter.replaceOp(op, shifted);
+      return mlir::success();
+    }
+    return mlir::failure();
+  }
+};
+
+/// For documentation see Passes.td
+struct StrengthReductionPass
+    : public StrengthReductionBase<StrengthReductionPass> {
+  void runOnOperation() final {
+    mlir::Operation *op = getOperation();
+    mlir::RewritePatternSet patterns(op->getContext());
+    patterns
+        .insert<ReducedMulPattern<Concrete::MulCleartextLweTensorOp,
+                                  Concrete::NegateLweTensorOp>,
+                ReducedMulPattern<Concrete::BatchedMulCleartextCstLweTensorOp,
+                                  Concrete::BatchedNegateLweTensorOp>>(
+            op->getContext());
+    if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed())
+      this->signalPassFailure();
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<OperationPass<ModuleOp>> createStrengthReductionPass() {
+  return std::make_unique<StrengthReductionPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,91 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/OperationSupport.h"
+
+#include "concretelang/Dialect/Concrete/IR/ConcreteDialect.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+
+namespace {
+
+/// Returns `true` for pure operations that encode a lookup table into
+/// an accumulator. Equivalent instances of these operations produce
+/// identical accumulators, so all but the first instance can be
+/// removed.
+static bool isTLUEncodeOp(mlir::Operation *op) {
+  return llvm::isa<
+      mlir::concretelang::Concrete::EncodeExpandLutForBootstrapTensorOp,
+      mlir::concretelang::Concrete::EncodeLutForCrtWopPBSTensorOp>(op);
+}
+
+/// For documentation see Passes.td
+struct TLUDedupPass : public TLUDedupBase<TLUDedupPass> {
+  void runOnOperation() final {
+    getOperation()->walk([&](mlir::Block *block) { processBlock(block); });
+  }
+
+protected:
+  /// Deduplicates lookup table constants and encode operations within
+  /// `block`. Only operations of the same block are merged, so that
+  /// replacements are always dominated by the remaining instance.
+  void processBlock(mlir::Block *block) {
+    llvm::DenseMap<mlir::Attribute, mlir::Value> tableConstants;
+    llvm::DenseMap<llvm::hash_code, llvm::SmallVector<mlir::Operation *, 1>>
+        encodeOps;
+
+    for (mlir::Operation &op : llvm::make_early_inc_range(*block)) {
+      // Deduplicate table constants first, so that encode operations
+      // on equal tables become equivalent
+      if (auto cstOp = llvm::dyn_cast<mlir::arith::ConstantOp>(&op)) {
+        if (!cstOp.getValue().isa<mlir::DenseIntElementsAttr>())
+          continue;
+
+        auto it = tableConstants.try_emplace(cstOp.getValue(),
+                                             cstOp.getResult());
+        if (!it.second) {
+          cstOp.getResult().replaceAllUsesWith(it.first->second);
+          op.erase();
+        }
+        continue;
+      }
+
+      if (!isTLUEncodeOp(&op))
+        continue;
+
+      llvm::hash_code hash = mlir::OperationEquivalence::computeHash(
+          &op, mlir::OperationEquivalence::directHashValue,
+          mlir::OperationEquivalence::ignoreHashValue,
+          mlir::OperationEquivalence::IgnoreLocations);
+
+      llvm::SmallVector<mlir::Operation *, 1> &candidates = encodeOps[hash];
+
+      bool replaced = false;
+      for (mlir::Operation *candidate : candidates) {
+        if (mlir::OperationEquivalence::isEquivalentTo(
+                &op, candidate, mlir::OperationEquivalence::IgnoreLocations)) {
+          op.replaceAllUsesWith(candidate);
+          op.erase();
+          replaced = true;
+          break;
+        }
+      }
+
+      if (!replaced)
+        candidates.push_back(&op);
+    }
+  }
+};
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<OperationPass<ModuleOp>> createTLUDedupPass() {
+  return std::make_unique<TLUDedupPass>();
+}
+} // namespace concretelang
+} // namespace mlir
@@ -6,6 +6,8 @@
 #include <chrono>
 #include <cmath>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -73,6 +75,13 @@ struct FunctionToDag {
                    ::concretelang::error::StringError>
   build() {
     auto dag = concrete_optimizer::dag::empty();
+    // Reserve the dag storage upfront, each argument and operation adds at
+    // most one node
+    size_t numOps = 0;
+    for (auto &bb : func.getBody().getBlocks()) {
+      numOps += bb.getOperations().size();
+    }
+    dag->reserve(func.getNumArguments() + numOps);
     // Converting arguments as Input
     mlir::Builder builder(func.getContext());
     for (size_t i = 0; i < func.getNumArguments(); i++) {
@@ -839,6 +848,10 @@ struct FunctionToDag {
 struct DagPass : ConcreteOptimizerBase<DagPass> {
   optimizer::Config config;
   optimizer::FunctionsDag &dags;
+  // The pass runs in parallel over the functions of the module and its
+  // clones share `dags`, insertions must be synchronized. The mutex is
+  // shared so that it is common to all clones of a pass instance.
+  std::shared_ptr<std::mutex> dagsMutex;
 
   void runOnOperation() override {
     mlir::func::FuncOp func = getOperation();
@@ -846,6 +859,7 @@ struct DagPass : ConcreteOptimizerBase<DagPass> {
     DEBUG("ConcreteOptimizer Dag: " << name);
     auto dag = FunctionToDag(func, config).build();
     if (dag) {
+      std::lock_guard<std::mutex> lock(*dagsMutex);
       dags.insert(
           optimizer::FunctionsDag::value_type(name, std::move(dag.value())));
     } else {
@@ -855,7 +869,8 @@ struct DagPass : ConcreteOptimizerBase<DagPass> {
 
   DagPass() = delete;
   DagPass(optimizer::Config config, optimizer::FunctionsDag &dags)
-      : config(config), dags(dags) {}
+      : config(config), dags(dags),
+        dagsMutex(std::make_shared<std::mutex>()) {}
 };
 
 // Create an instance of the ConcreteOptimizerPass pass.
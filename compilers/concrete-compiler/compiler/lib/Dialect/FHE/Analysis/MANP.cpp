@@ -12,8 +12,10 @@
 #include <concretelang/Support/math.h>
 #include <mlir/IR/BuiltinOps.h>
 
+#include <deque>
 #include <limits>
 #include <llvm/ADT/APInt.h>
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/Optional.h>
 #include <llvm/ADT/SmallString.h>
 #include <mlir/Analysis/DataFlow/DeadCodeAnalysis.h>
@@ -129,6 +131,20 @@ static bool APIntWidthExtendULT(const llvm::APInt &lhs,
     return lhs.ult(rhs);
 }
 
+/// Truncates a positive `APInt` to the smallest width that still
+/// represents its value. The width-extending arithmetic helpers below
+/// grow the result width with every operation, i.e. with the depth of
+/// the analyzed circuit rather than with the magnitude of the norm;
+/// since `APInt` heap-allocates beyond 64 bits, deep chains would
+/// otherwise make the analysis allocate superlinearly. Trimming after
+/// each operation keeps most lattice values inline.
+static llvm::APInt APIntTrimToActiveWidth(const llvm::APInt &i) {
+  unsigned activeWidth = std::max(i.getActiveBits(), 1u);
+  if (activeWidth < i.getBitWidth())
+    return i.trunc(activeWidth);
+  return i;
+}
+
 /// Adds two `APInt` values, where both values are assumed to be
 /// positive. The bit width of the operands is extended in order to
 /// guarantee that the sum fits into the resulting `APInt`.
@@ -141,7 +157,7 @@ static llvm::APInt APIntWidthExtendUAdd(const llvm::APInt &lhs,
   assert(std::numeric_limits<unsigned>::max() - maxBits > 1);
 
   unsigned targetWidth = maxBits + 1;
-  return lhs.zext(targetWidth) + rhs.zext(targetWidth);
+  return APIntTrimToActiveWidth(lhs.zext(targetWidth) + rhs.zext(targetWidth));
 }
 
 /// Multiplies two `APInt` values, where both values are assumed to be
@@ -157,7 +173,7 @@ static llvm::APInt APIntWidthExtendUMul(const llvm::APInt &lhs,
          "Required number of bits cannot be represented with an APInt");
 
   unsigned targetWidth = lhs.getBitWidth() + rhs.getBitWidth();
-  return lhs.zext(targetWidth) * rhs.zext(targetWidth);
+  return APIntTrimToActiveWidth(lhs.zext(targetWidth) * rhs.zext(targetWidth));
 }
 
 /// Returns the maximum value beetwen `lhs` and `rhs`, where both values are
@@ -180,13 +196,15 @@ static llvm::APInt APIntWidthExtendUnsignedSq(const llvm::APInt &i) {
          "Required number of bits cannot be represented with an APInt");
   llvm::APInt ie = i.zext(2 * i.getBitWidth());
 
-  return ie * ie;
+  return APIntTrimToActiveWidth(ie * ie);
 }
 
 /// Calculates the square of the value of `i`.
 static llvm::APInt APIntWidthExtendSqForConstant(const llvm::APInt &i) {
   auto extI = i.sext(2 * i.getBitWidth());
-  return extI * extI;
+  // The square is positive, so trimming to the unsigned active width is
+  // value-preserving.
+  return APIntTrimToActiveWidth(extI * extI);
 }
 
 /// Calculates the square root of `i` and rounds it to the next highest
@@ -1405,9 +1423,50 @@ public:
   void visitOperation(Operation *op, ArrayRef<const MANPLattice *> operands,
                       ArrayRef<MANPLattice *> results) override {
     MANPLattice *latticeRes = results[0];
+    llvm::APInt norm2SqEquiv;
+
+    if (computeSqMANP(op, operands, norm2SqEquiv)) {
+      latticeRes->join(MANPLatticeValue{norm2SqEquiv});
+      setMANPAttributes(op, norm2SqEquiv, debug);
+    } else {
+      latticeRes->join(MANPLatticeValue{});
+    }
+  }
+
+  /// Sets the `SMANP` and `MANP` attributes of `op` from the squared
+  /// Minimal Arithmetic Noise Padding `norm2SqEquiv` of its result.
+  static void setMANPAttributes(mlir::Operation *op, llvm::APInt norm2SqEquiv,
+                                bool debug) {
+    op->setAttr("SMANP",
+                mlir::IntegerAttr::get(
+                    mlir::IntegerType::get(
+                        op->getContext(), norm2SqEquiv.getBitWidth(),
+                        mlir::IntegerType::SignednessSemantics::Unsigned),
+                    norm2SqEquiv));
+
+    llvm::APInt norm2Equiv = APIntCeilSqrt(norm2SqEquiv);
+
+    op->setAttr("MANP",
+                mlir::IntegerAttr::get(
+                    mlir::IntegerType::get(
+                        op->getContext(), norm2Equiv.getBitWidth(),
+                        mlir::IntegerType::SignednessSemantics::Unsigned),
+                    norm2Equiv));
+
+    if (debug) {
+      op->emitRemark("Squared Minimal Arithmetic Noise Padding: ")
+          << APIntToStringValUnsigned(norm2SqEquiv) << "\n";
+    }
+  }
 
+  /// Computes the squared Minimal Arithmetic Noise Padding of the
+  /// single result of `op` from the lattices of its operands and
+  /// stores it in `norm2SqEquiv`. Returns `false` if the operation is
+  /// irrelevant for the analysis.
+  static bool computeSqMANP(Operation *op,
+                            ArrayRef<const MANPLattice *> operands,
+                            llvm::APInt &norm2SqEquiv) {
     bool isDummy = false;
-    llvm::APInt norm2SqEquiv;
 
     // FHE Operators
     if (auto addEintIntOp =
@@ -1652,37 +1711,75 @@ public:
       isDummy = true;
     }
 
-    if (!isDummy) {
-      latticeRes->join(MANPLatticeValue{norm2SqEquiv});
-
-      op->setAttr("SMANP",
-                  mlir::IntegerAttr::get(
-                      mlir::IntegerType::get(
-                          op->getContext(), norm2SqEquiv.getBitWidth(),
-                          mlir::IntegerType::SignednessSemantics::Unsigned),
-                      norm2SqEquiv));
-
-      llvm::APInt norm2Equiv = APIntCeilSqrt(norm2SqEquiv);
-
-      op->setAttr("MANP",
-                  mlir::IntegerAttr::get(
-                      mlir::IntegerType::get(
-                          op->getContext(), norm2Equiv.getBitWidth(),
-                          mlir::IntegerType::SignednessSemantics::Unsigned),
-                      norm2Equiv));
-
-      if (debug) {
-        op->emitRemark("Squared Minimal Arithmetic Noise Padding: ")
-            << APIntToStringValUnsigned(norm2SqEquiv) << "\n";
-      }
-    } else {
-      latticeRes->join(MANPLatticeValue{});
-    }
+    return !isDummy;
   }
 
 private:
   bool debug;
 };
+
+/// Checks whether the fixed-point dataflow solver can be bypassed for
+/// `func`. This is the case if the body of the function is a single
+/// block without any nested regions, as a single visit of each
+/// operation in block order is then sufficient to reach the fixed
+/// point.
+static bool canUseSingleSweep(mlir::func::FuncOp func) {
+  if (!func.getBody().hasOneBlock())
+    return false;
+
+  for (mlir::Operation &op : func.getBody().front())
+    if (op.getNumRegions() != 0)
+      return false;
+
+  return true;
+}
+
+/// Runs the MANP analysis on `func` as a single sweep over the
+/// operations of its body in block order, visiting each operation
+/// exactly once. This avoids the overhead of the general dataflow
+/// framework for the common case of large, flat circuits.
+static void runSingleSweep(mlir::func::FuncOp func, bool debug) {
+  std::deque<MANPLattice> latticeStorage;
+  llvm::DenseMap<mlir::Value, MANPLattice *> lattices;
+
+  auto getLattice = [&](mlir::Value v) -> MANPLattice * {
+    auto it = lattices.find(v);
+
+    if (it != lattices.end())
+      return it->second;
+
+    MANPLattice *lattice = &latticeStorage.emplace_back(v);
+
+    if (isEncryptedFunctionParameter(v))
+      lattice->join(MANPLatticeValue{llvm::APInt{1, 1}});
+
+    lattices.insert({v, lattice});
+    return lattice;
+  };
+
+  for (mlir::BlockArgument arg : func.getBody().front().getArguments())
+    getLattice(arg);
+
+  for (mlir::Operation &op : func.getBody().front()) {
+    if (op.getNumResults() == 0)
+      continue;
+
+    llvm::SmallVector<const MANPLattice *> operandLattices;
+    operandLattices.reserve(op.getNumOperands());
+
+    for (mlir::Value operand : op.getOperands())
+      operandLattices.push_back(getLattice(operand));
+
+    llvm::APInt norm2SqEquiv;
+
+    if (MANPAnalysis::computeSqMANP(&op, operandLattices, norm2SqEquiv)) {
+      getLattice(op.getResult(0))->join(MANPLatticeValue{norm2SqEquiv});
+      MANPAnalysis::setMANPAttributes(&op, norm2SqEquiv, debug);
+    } else {
+      getLattice(op.getResult(0))->join(MANPLatticeValue{});
+    }
+  }
+}
 } // namespace
 
 namespace {
@@ -1691,6 +1788,14 @@ struct MANPPass : public MANPBase<MANPPass> {
   void runOnOperation() override {
     mlir::func::FuncOp func = getOperation();
 
+    // Large, flat circuits do not require the fixed-point machinery
+    // of the dataflow framework; visit each operation exactly once in
+    // block order instead.
+    if (canUseSingleSweep(func)) {
+      runSingleSweep(func, debug);
+      return;
+    }
+
     mlir::DataFlowSolver solver;
     solver.load<mlir::dataflow::DeadCodeAnalysis>();
     solver.load<MANPAnalysis>(debug);
@@ -311,6 +311,70 @@ OpFoldResult RoundEintOp::fold(FoldAdaptor operands) {
   return nullptr;
 }
 
+void RoundEintOp::getCanonicalizationPatterns(mlir::RewritePatternSet &patterns,
+                                              mlir::MLIRContext *context) {
+
+  // Fuse the rounding of a lookup table result into the table itself. The
+  // table entries are clear values, so they can be rounded at compile time
+  // and the lookup can directly produce the smaller precision. This removes
+  // the costly carry propagation emitted for the round and lets the
+  // optimizer choose parameters for the smaller output precision.
+  class FuseRoundIntoTLUPattern : public mlir::OpRewritePattern<RoundEintOp> {
+  public:
+    FuseRoundIntoTLUPattern(mlir::MLIRContext *context)
+        : mlir::OpRewritePattern<RoundEintOp>(context, 0) {}
+
+    mlir::LogicalResult
+    matchAndRewrite(RoundEintOp op,
+                    mlir::PatternRewriter &rewriter) const override {
+      auto lutOp = op.getInput().getDefiningOp<FHE::ApplyLookupTableEintOp>();
+      if (lutOp == nullptr || !lutOp->hasOneUse())
+        return mlir::failure();
+
+      // Signed messages wrap around differently, only fuse the rounding of
+      // unsigned messages
+      auto inputTy = op.getInput().getType().dyn_cast<EncryptedIntegerType>();
+      auto resultTy = op.getResult().getType().dyn_cast<EncryptedIntegerType>();
+      if (inputTy == nullptr || resultTy == nullptr)
+        return mlir::failure();
+
+      auto cstOp = lutOp.getLut().getDefiningOp<arith::ConstantOp>();
+      if (cstOp == nullptr)
+        return mlir::failure();
+      auto lutValues =
+          cstOp.getValue().dyn_cast<mlir::DenseIntElementsAttr>();
+      if (lutValues == nullptr)
+        return mlir::failure();
+
+      unsigned delta = inputTy.getWidth() - resultTy.getWidth();
+      uint64_t half = (uint64_t)1 << (delta - 1);
+      uint64_t mask = ((uint64_t)1 << resultTy.getWidth()) - 1;
+      unsigned elementWidth =
+          lutValues.getType().getElementTypeBitWidth();
+
+      llvm::SmallVector<llvm::APInt> roundedValues;
+      roundedValues.reserve(lutValues.getNumElements());
+      for (llvm::APInt value : lutValues.getValues<llvm::APInt>()) {
+        uint64_t rounded = ((value.getZExtValue() + half) >> delta) & mask;
+        roundedValues.push_back(llvm::APInt(elementWidth, rounded));
+      }
+
+      auto newLutValues =
+          mlir::DenseIntElementsAttr::get(lutValues.getType(), roundedValues);
+      auto newLut =
+          rewriter.create<arith::ConstantOp>(cstOp.getLoc(), newLutValues);
+
+      auto newLutOp = rewriter.replaceOpWithNewOp<FHE::ApplyLookupTableEintOp>(
+          op, op.getResult().getType(), lutOp.getA(), newLut);
+      if (auto optimizerIdAttr = lutOp->getAttr("TFHE.OId"))
+        newLutOp->setAttr("TFHE.OId", optimizerIdAttr);
+
+      return mlir::success();
+    }
+  };
+  patterns.add<FuseRoundIntoTLUPattern>(context);
+}
+
 /// Avoid addition with constant 0
 OpFoldResult AddEintIntOp::fold(FoldAdaptor operands) {
   auto toAdd = operands.getB().dyn_cast_or_null<mlir::IntegerAttr>();
@@ -0,0 +1,124 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "llvm/ADT/SetVector.h"
+
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/OperationSupport.h"
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/Transforms/FHECSE/FHECSE.h"
+
+namespace FHE = mlir::concretelang::FHE;
+
+namespace {
+
+/// The operations worth merging across branches: the ones that lower to
+/// at least one programmable bootstrap. Levelled operations are left to
+/// generic CSE, hoisting them across branches extends ciphertext
+/// liveness without removing a bootstrap.
+bool isBootstrapBackedOp(mlir::Operation *op) {
+  return llvm::isa<FHE::ApplyLookupTableEintOp, FHE::MulEintOp,
+                   FHE::MaxEintOp, FHE::RoundEintOp, FHE::GenGateOp,
+                   FHE::MuxOp, FHE::BoolAndOp, FHE::BoolOrOp, FHE::BoolNandOp,
+                   FHE::BoolXorOp>(op);
+}
+
+llvm::hash_code hashOp(mlir::Operation *op) {
+  return mlir::OperationEquivalence::computeHash(
+      op, mlir::OperationEquivalence::directHashValue,
+      mlir::OperationEquivalence::ignoreHashValue,
+      mlir::OperationEquivalence::IgnoreLocations);
+}
+
+bool equivalentOps(mlir::Operation *lhs, mlir::Operation *rhs) {
+  return mlir::OperationEquivalence::isEquivalentTo(
+      lhs, rhs, mlir::OperationEquivalence::exactValueMatch,
+      /*markEquivalent=*/nullptr,
+      mlir::OperationEquivalence::IgnoreLocations);
+}
+
+struct FHECSE : public FHECSEBase<FHECSE> {
+  void runOnOperation() final;
+
+private:
+  void processRegion(mlir::Region &region, mlir::DominanceInfo &dom);
+};
+
+/// Merges equivalent bootstrap-backed operations of one region. When
+/// one duplicate dominates the other it absorbs it directly; otherwise
+/// the kept copy moves to the nearest common dominator block of the
+/// two, which is legal since equivalent operations share their
+/// operands, and any value dominating both uses dominates that block.
+void FHECSE::processRegion(mlir::Region &region, mlir::DominanceInfo &dom) {
+  llvm::DenseMap<llvm::hash_code, llvm::SmallVector<mlir::Operation *, 2>>
+      representatives;
+  // Replaced copies stay in place until the traversal completes, so the
+  // iteration never runs over freed operations; the set keeps a copy
+  // that absorbed one duplicate from being processed again later.
+  llvm::SmallSetVector<mlir::Operation *, 8> erased;
+  for (mlir::Block &block : region.getBlocks()) {
+    for (mlir::Operation &op : block.getOperations()) {
+      for (mlir::Region &nested : op.getRegions())
+        processRegion(nested, dom);
+      if (!isBootstrapBackedOp(&op) || erased.contains(&op))
+        continue;
+      auto &candidates = representatives[hashOp(&op)];
+      mlir::Operation **match = nullptr;
+      for (mlir::Operation *&candidate : candidates) {
+        if (equivalentOps(candidate, &op)) {
+          match = &candidate;
+          break;
+        }
+      }
+      if (match == nullptr) {
+        candidates.push_back(&op);
+        continue;
+      }
+      if (dom.properlyDominates(&op, *match)) {
+        // The block order visited the dominated copy first, absorb it.
+        (*match)->replaceAllUsesWith(&op);
+        erased.insert(*match);
+        *match = &op;
+        continue;
+      }
+      if (!dom.properlyDominates(*match, &op)) {
+        // Neither copy dominates the other: hoist the representative
+        // right before the terminator of the nearest common dominator
+        // block, from where it covers both uses.
+        mlir::Block *ncd =
+            dom.findNearestCommonDominator((*match)->getBlock(), op.getBlock());
+        if (ncd == nullptr || ncd->empty() ||
+            !ncd->back().hasTrait<mlir::OpTrait::IsTerminator>()) {
+          candidates.push_back(&op);
+          continue;
+        }
+        (*match)->moveBefore(ncd->getTerminator());
+      }
+      op.replaceAllUsesWith(*match);
+      erased.insert(&op);
+    }
+  }
+  for (mlir::Operation *op : erased)
+    op->erase();
+}
+
+void FHECSE::runOnOperation() {
+  mlir::DominanceInfo dom(this->getOperation());
+  for (mlir::Region &region : this->getOperation()->getRegions())
+    processRegion(region, dom);
+}
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<>> createFHECSEPass() {
+  return std::make_unique<FHECSE>();
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,113 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/Transforms/TLUFusion/TLUFusion.h"
+
+namespace arith = mlir::arith;
+namespace FHE = mlir::concretelang::FHE;
+
+namespace {
+
+/// Reads the entries of a lookup table constant, when the table is an
+/// `arith.constant` of integer elements.
+std::optional<llvm::SmallVector<int64_t>> constantLutEntries(mlir::Value lut) {
+  auto constantOp = lut.getDefiningOp<arith::ConstantOp>();
+  if (constantOp == nullptr)
+    return std::nullopt;
+  auto elements = constantOp.getValue().dyn_cast<mlir::DenseIntElementsAttr>();
+  if (elements == nullptr)
+    return std::nullopt;
+  llvm::SmallVector<int64_t> entries;
+  entries.reserve(elements.getNumElements());
+  for (mlir::APInt element : elements.getValues<mlir::APInt>())
+    entries.push_back(element.getSExtValue());
+  return entries;
+}
+
+/// Rewrites `lut2[lut1[x]]` into a single lookup through the composed
+/// table. The intermediate lookup is only removed when its result has
+/// no other use, both tables are constants and every entry of the first
+/// table fits the intermediate precision, so the composed table indexes
+/// the second one exactly where the chain would have.
+struct ChainedTLUPattern
+    : public mlir::OpRewritePattern<FHE::ApplyLookupTableEintOp> {
+  ChainedTLUPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<FHE::ApplyLookupTableEintOp>(context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(FHE::ApplyLookupTableEintOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto producer = op.getA().getDefiningOp<FHE::ApplyLookupTableEintOp>();
+    if (producer == nullptr || !producer.getResult().hasOneUse())
+      return mlir::failure();
+
+    auto innerEntries = constantLutEntries(producer.getLut());
+    auto outerEntries = constantLutEntries(op.getLut());
+    if (!innerEntries || !outerEntries)
+      return mlir::failure();
+
+    // The entries of the first table must be representable at the
+    // intermediate precision: an out-of-range entry would wrap on the
+    // intermediate ciphertext, and the chain's behavior for it is not
+    // something the composition should bake in.
+    const auto midTy =
+        producer.getResult().getType().cast<FHE::FheIntegerInterface>();
+    const unsigned midWidth = midTy.getWidth();
+    const int64_t midSize = int64_t(1) << midWidth;
+    const int64_t lo = midTy.isSigned() ? -(midSize / 2) : 0;
+    const int64_t hi = midTy.isSigned() ? midSize / 2 : midSize;
+    for (int64_t entry : *innerEntries)
+      if (entry < lo || entry >= hi)
+        return mlir::failure();
+    if ((int64_t)outerEntries->size() != midSize)
+      return mlir::failure();
+
+    // Negative intermediate values index the upper half of the second
+    // table, as the signed lookup encoding does.
+    llvm::SmallVector<uint64_t> composed;
+    composed.reserve(innerEntries->size());
+    for (int64_t entry : *innerEntries)
+      composed.push_back((*outerEntries)[(entry + midSize) % midSize]);
+
+    mlir::Value composedLut = rewriter.create<arith::ConstantOp>(
+        op.getLoc(), mlir::DenseIntElementsAttr::get(
+                         mlir::RankedTensorType::get(
+                             composed.size(), rewriter.getIntegerType(64)),
+                         composed));
+    rewriter.replaceOpWithNewOp<FHE::ApplyLookupTableEintOp>(
+        op, op.getResult().getType(), producer.getA(), composedLut);
+    return mlir::success();
+  }
+};
+
+struct TLUFusion : public TLUFusionBase<TLUFusion> {
+  void runOnOperation() final;
+};
+
+void TLUFusion::runOnOperation() {
+  auto patterns = mlir::RewritePatternSet(&this->getContext());
+  patterns.insert<ChainedTLUPattern>(&this->getContext());
+
+  mlir::Operation *op = this->getOperation();
+  if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed()) {
+    this->signalPassFailure();
+  }
+}
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<>> createTLUFusionPass() {
+  return std::make_unique<TLUFusion>();
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -3,6 +3,9 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
+#include <optional>
+
 #include <mlir/Dialect/Arith/IR/Arith.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
 #include <mlir/Dialect/MemRef/IR/MemRef.h>
@@ -104,6 +107,35 @@ mlir::scf::ForOp buildLoopNestWithLoopCarriedDependency(
   return fops[0];
 }
 
+/// Creates a `tensor.extract_slice` operation that extracts a
+/// contiguous slice with the static sizes `sizes`, with the dynamic
+/// offsets `outerOffsets` on the leading dimensions and zero offsets
+/// on the remaining ones.
+mlir::tensor::ExtractSliceOp
+extractContiguousOuterSlice(mlir::OpBuilder &builder, mlir::Location loc,
+                            mlir::Value T, llvm::ArrayRef<int64_t> sizes,
+                            llvm::ArrayRef<mlir::OpFoldResult> outerOffsets) {
+  assert(outerOffsets.size() <= sizes.size() &&
+         "More offsets than sliced dimensions");
+
+  mlir::Type elTy = T.getType().cast<mlir::TensorType>().getElementType();
+
+  llvm::SmallVector<mlir::OpFoldResult> offsets(outerOffsets.begin(),
+                                                outerOffsets.end());
+  llvm::SmallVector<mlir::OpFoldResult> sizeAttrs;
+  llvm::SmallVector<mlir::OpFoldResult> strides;
+  for (int64_t size : sizes) {
+    sizeAttrs.push_back(builder.getI64IntegerAttr(size));
+    strides.push_back(builder.getI64IntegerAttr(1));
+  }
+  while (offsets.size() < sizes.size())
+    offsets.push_back(builder.getI64IntegerAttr(0));
+
+  return builder.create<mlir::tensor::ExtractSliceOp>(
+      loc, mlir::RankedTensorType::get(sizes, elTy), T, offsets, sizeAttrs,
+      strides);
+}
+
 /// Marker to avoid infinite recursion of the rewriting pattern
 static const mlir::StringLiteral kTransformMarker =
     "__internal_fhe_linalg_tiling_marker__";
@@ -312,15 +344,212 @@ public:
   }
 };
 
-/// Perfoms the actual tiling of `FHELinalg.matmul_eint_int`
-/// operations that have been marked with a "tile-sizes" attribute.
+/// Rewrite an `FHELinalg.conv2d` operation as an equivalent perfect
+/// loop nest of SCF for loops over blocks of the batch and
+/// output-feature dimensions, with an `FHELinalg.conv2d` operation
+/// computing one output block per iteration.
+///
+/// The loop nest lowered from an unblocked convolution strides across
+/// the whole batch for each output feature, so the ciphertexts of the
+/// levelled accumulations keep falling out of the cache. Blocking the
+/// two outer dimensions bounds the working set of one inner
+/// convolution to the input slice of a batch block plus its output
+/// block, and orders the batch loop outermost so a block's
+/// accumulations complete before the next block is touched.
+///
+/// Partial blocks are currently not supported, i.e., the batch size
+/// must be a multiple of the first block size and the output-feature
+/// count a multiple of the second. Grouped convolutions are not
+/// blocked, since the lowering already splits them per group.
+class Conv2dBlockingPattern
+    : public mlir::OpRewritePattern<mlir::concretelang::FHELinalg::Conv2dOp> {
+public:
+  Conv2dBlockingPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<mlir::concretelang::FHELinalg::Conv2dOp>(
+            context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::concretelang::FHELinalg::Conv2dOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    // Avoid infinite recursion by marking each convolution and bailing
+    // out for the marker
+    if (op->hasAttr(kTransformMarker))
+      return mlir::failure();
+
+    // Only block operations that are explicitly marked with block sizes
+    if (!op->hasAttr("tile-sizes"))
+      return mlir::failure();
+
+    if (mlir::concretelang::FHELinalg::getGroupFromConv2d(op) != 1)
+      return mlir::failure();
+
+    mlir::Location origLoc = op->getLoc();
+
+    mlir::ArrayAttr blockSizes =
+        op->getAttrOfType<mlir::ArrayAttr>("tile-sizes");
+
+    if (!blockSizes) {
+      op->emitError("Wrong type for attribute \"tile-size\"");
+      return mlir::failure();
+    }
+
+    if (blockSizes.size() != 2) {
+      op->emitError("Need 2 block sizes, but got ") << blockSizes.size();
+      return mlir::failure();
+    }
+
+    mlir::IntegerAttr attrTn =
+        blockSizes[0].dyn_cast_or_null<mlir::IntegerAttr>();
+    mlir::IntegerAttr attrTf =
+        blockSizes[1].dyn_cast_or_null<mlir::IntegerAttr>();
+
+    if (!attrTn || !attrTf) {
+      op->emitError("Wrong type for block sizes");
+      return mlir::failure();
+    }
+
+    int64_t iTn = attrTn.getInt();
+    int64_t iTf = attrTf.getInt();
+
+    mlir::TensorType inputTy =
+        op.getInput().getType().cast<mlir::TensorType>();
+    mlir::TensorType weightTy =
+        op.getWeight().getType().cast<mlir::TensorType>();
+    mlir::TensorType resultTy =
+        op.getResult().getType().cast<mlir::TensorType>();
+
+    int64_t N = resultTy.getDimSize(0);
+    int64_t F = resultTy.getDimSize(1);
+    int64_t OH = resultTy.getDimSize(2);
+    int64_t OW = resultTy.getDimSize(3);
+
+    // Check that no partial blocks are necessary
+    if (N % iTn != 0 || F % iTf != 0) {
+      op.emitError() << "Dimensions of the tensors must be a multiple of the "
+                        "block size. Partial blocks are currently not "
+                        "supported.";
+      return mlir::failure();
+    }
+
+    mlir::OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.startRootUpdate(op);
+    rewriter.setInsertionPointAfter(op);
+
+    // Initialization of the output tensor; every block of it is fully
+    // overwritten by an insertion below
+    mlir::concretelang::FHE::ZeroTensorOp Oinit =
+        rewriter.create<mlir::concretelang::FHE::ZeroTensorOp>(origLoc,
+                                                               resultTy);
+
+    mlir::arith::ConstantIndexOp Tn =
+        rewriter.create<mlir::arith::ConstantIndexOp>(origLoc, iTn);
+
+    mlir::arith::ConstantIndexOp Tf =
+        rewriter.create<mlir::arith::ConstantIndexOp>(origLoc, iTf);
+
+    // Lower bound for all for loops
+    mlir::arith::ConstantIndexOp lb =
+        rewriter.create<mlir::arith::ConstantIndexOp>(origLoc, 0);
+
+    mlir::arith::ConstantIndexOp ubN =
+        rewriter.create<mlir::arith::ConstantIndexOp>(origLoc, N);
+
+    mlir::arith::ConstantIndexOp ubF =
+        rewriter.create<mlir::arith::ConstantIndexOp>(origLoc, F);
+
+    // Bounds and steps in vector form; the batch loop is outermost
+    llvm::SmallVector<mlir::Value, 2> lbs{lb, lb};
+    llvm::SmallVector<mlir::Value, 2> ubs{ubN, ubF};
+    llvm::SmallVector<mlir::Value, 2> steps{Tn, Tf};
+
+    // Callback function to build the body of the innermost loop
+    auto innermostBodyBuilder = [&](mlir::OpBuilder &builder,
+                                    mlir::Location location,
+                                    mlir::ValueRange inductionVars,
+                                    mlir::ValueRange iterArgs) {
+      // Input slice covering a block of Tn images
+      mlir::tensor::ExtractSliceOp inputBlock = extractContiguousOuterSlice(
+          builder, origLoc, op.getInput(),
+          {iTn, inputTy.getDimSize(1), inputTy.getDimSize(2),
+           inputTy.getDimSize(3)},
+          {inductionVars[0]});
+
+      // Weights of a block of Tf output features
+      mlir::tensor::ExtractSliceOp weightBlock = extractContiguousOuterSlice(
+          builder, origLoc, op.getWeight(),
+          {iTf, weightTy.getDimSize(1), weightTy.getDimSize(2),
+           weightTy.getDimSize(3)},
+          {inductionVars[1]});
+
+      mlir::Value biasBlock;
+      if (op.getBias())
+        biasBlock = extractContiguousOuterSlice(builder, origLoc, op.getBias(),
+                                                {iTf}, {inductionVars[1]});
+
+      // Convolution of the blocks, with the original padding, strides
+      // and dilations
+      mlir::concretelang::FHELinalg::Conv2dOp blockedConv =
+          builder.create<mlir::concretelang::FHELinalg::Conv2dOp>(
+              origLoc,
+              mlir::RankedTensorType::get(
+                  llvm::SmallVector<int64_t, 4>{iTn, iTf, OH, OW},
+                  resultTy.getElementType()),
+              inputBlock, weightBlock, biasBlock, op.getPaddingAttr(),
+              op.getStridesAttr(), op.getDilationsAttr(), op.getGroupAttr());
+
+      // Mark the convolution to prevent recursive application of the
+      // rewriting pattern
+      blockedConv.getOperation()->setAttr(kTransformMarker,
+                                          rewriter.getUnitAttr());
+
+      // Write the output block into the result
+      mlir::tensor::InsertSliceOp Oupdated =
+          builder.create<mlir::tensor::InsertSliceOp>(
+              origLoc, blockedConv, *iterArgs.begin(),
+
+              llvm::SmallVector<mlir::OpFoldResult, 4>{
+                  inductionVars[0], inductionVars[1],
+                  rewriter.getI64IntegerAttr(0),
+                  rewriter.getI64IntegerAttr(0)},
+
+              llvm::SmallVector<mlir::OpFoldResult, 4>{
+                  rewriter.getI64IntegerAttr(iTn),
+                  rewriter.getI64IntegerAttr(iTf),
+                  rewriter.getI64IntegerAttr(OH),
+                  rewriter.getI64IntegerAttr(OW)},
+
+              llvm::SmallVector<mlir::OpFoldResult, 4>{
+                  rewriter.getI64IntegerAttr(1),
+                  rewriter.getI64IntegerAttr(1),
+                  rewriter.getI64IntegerAttr(1),
+                  rewriter.getI64IntegerAttr(1)});
+
+      builder.create<mlir::scf::YieldOp>(origLoc, Oupdated.getResult());
+    };
+
+    mlir::scf::ForOp outermost = buildLoopNestWithLoopCarriedDependency(
+        rewriter, origLoc, lbs, ubs, steps, Oinit.getResult(),
+        innermostBodyBuilder);
+
+    rewriter.replaceOp(op, outermost.getResult(0));
+
+    rewriter.finalizeRootUpdate(op);
+
+    return mlir::success();
+  }
+};
+
+/// Perfoms the actual tiling of `FHELinalg.matmul_eint_int` and
+/// blocking of `FHELinalg.conv2d` operations that have been marked
+/// with a "tile-sizes" attribute.
 class FHELinalgTilingPass : public FHELinalgTilingBase<FHELinalgTilingPass> {
 public:
   void runOnOperation() override {
     mlir::Operation *op = getOperation();
 
     mlir::RewritePatternSet patterns(op->getContext());
-    patterns.add<MatMulTilingPattern>(op->getContext());
+    patterns.add<MatMulTilingPattern, Conv2dBlockingPattern>(
+        op->getContext());
 
     if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed()) {
       this->signalPassFailure();
@@ -329,11 +558,71 @@ public:
     op->walk([](mlir::concretelang::FHELinalg::MatMulEintIntOp matmulOp) {
       matmulOp.getOperation()->removeAttr(kTransformMarker);
     });
+    op->walk([](mlir::concretelang::FHELinalg::Conv2dOp convOp) {
+      convOp.getOperation()->removeAttr(kTransformMarker);
+    });
   }
 };
 
-/// Marks all `FHELinalg.matmul_eint_int` operations that with a
-/// "tile-sizes" attribute containing the specified tile sizes.
+/// Maximum size of a tile dimension chosen by the automatic tile-size
+/// selection.
+constexpr int64_t MAX_AUTO_TILE_DIM_SIZE = 64;
+
+/// Returns the largest divisor of `n` that is less than or equal to
+/// `bound`.
+static int64_t largestDivisorUpTo(int64_t n, int64_t bound) {
+  for (int64_t d = std::min(n, bound); d >= 2; d--) {
+    if (n % d == 0)
+      return d;
+  }
+  return 1;
+}
+
+/// Selects tile sizes for a matrix multiplication that was not
+/// explicitly marked for tiling. Only multiplications on statically
+/// shaped, 2-dimensional operands whose result does not fit within a
+/// single tile are tiled, so that the intermediate tensors of the
+/// tiled form stay small instead of growing with the operands. The
+/// tile sizes are divisors of the dimensions, since partial tiles are
+/// not supported.
+///
+/// Returns `std::nullopt` if the multiplication should not be tiled.
+static std::optional<llvm::SmallVector<int64_t, 3>>
+selectDefaultTileSizes(mlir::concretelang::FHELinalg::MatMulEintIntOp op) {
+  mlir::TensorType ATy = op.getLhs().getType().cast<mlir::TensorType>();
+  mlir::TensorType BTy = op.getRhs().getType().cast<mlir::TensorType>();
+
+  if (!ATy.hasStaticShape() || !BTy.hasStaticShape() || ATy.getRank() != 2 ||
+      BTy.getRank() != 2)
+    return std::nullopt;
+
+  int64_t N = ATy.getDimSize(0);
+  int64_t M = ATy.getDimSize(1);
+  int64_t K = BTy.getDimSize(1);
+
+  // Small multiplications fit within a single tile
+  if (N * K <= MAX_AUTO_TILE_DIM_SIZE * MAX_AUTO_TILE_DIM_SIZE)
+    return std::nullopt;
+
+  llvm::SmallVector<int64_t, 3> tileSizes{
+      largestDivisorUpTo(N, MAX_AUTO_TILE_DIM_SIZE),
+      largestDivisorUpTo(M, MAX_AUTO_TILE_DIM_SIZE),
+      largestDivisorUpTo(K, MAX_AUTO_TILE_DIM_SIZE)};
+
+  if (tileSizes[0] == N && tileSizes[1] == M && tileSizes[2] == K)
+    return std::nullopt;
+
+  return tileSizes;
+}
+
+/// Marks all `FHELinalg.matmul_eint_int` operations with a
+/// "tile-sizes" attribute containing the specified tile sizes. If no
+/// tile sizes are specified, large matrix multiplications are marked
+/// with automatically selected tile sizes.
+///
+/// `FHELinalg.conv2d` operations are not marked here: their
+/// batch/output-feature blocking is opt-in through an explicit
+/// "tile-sizes" attribute set by the front end.
 class FHELinalgTilingMarkerPass
     : public FHELinalgTilingMarkerBase<FHELinalgTilingMarkerPass> {
 public:
@@ -342,12 +631,27 @@ public:
 
   void runOnOperation() override {
     mlir::Operation *op = getOperation();
+    mlir::Builder builder(&this->getContext());
 
-    mlir::ArrayAttr tileAttr =
-        mlir::Builder(&this->getContext()).getI64ArrayAttr(tileSizes);
+    if (!tileSizes.empty()) {
+      mlir::ArrayAttr tileAttr = builder.getI64ArrayAttr(tileSizes);
 
+      op->walk([&](mlir::concretelang::FHELinalg::MatMulEintIntOp matmulOp) {
+        matmulOp.getOperation()->setAttr("tile-sizes", tileAttr);
+      });
+      return;
+    }
+
+    // Automatic mode: mark large matrix multiplications that have not
+    // been marked explicitly, e.g., by the front end
     op->walk([&](mlir::concretelang::FHELinalg::MatMulEintIntOp matmulOp) {
-      matmulOp.getOperation()->setAttr("tile-sizes", tileAttr);
+      if (matmulOp->hasAttr("tile-sizes"))
+        return;
+
+      if (auto autoTileSizes = selectDefaultTileSizes(matmulOp)) {
+        matmulOp.getOperation()->setAttr(
+            "tile-sizes", builder.getI64ArrayAttr(*autoTileSizes));
+      }
     });
   }
 
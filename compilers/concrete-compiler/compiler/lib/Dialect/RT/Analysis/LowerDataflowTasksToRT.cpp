@@ -13,6 +13,7 @@
 #include <concretelang/Dialect/FHE/IR/FHEDialect.h>
 #include <concretelang/Dialect/FHE/IR/FHEOps.h>
 #include <concretelang/Dialect/FHE/IR/FHETypes.h>
+#include <concretelang/Dialect/FHELinalg/IR/FHELinalgOps.h>
 #include <concretelang/Dialect/RT/Analysis/Autopar.h>
 #include <concretelang/Dialect/RT/IR/RTDialect.h>
 #include <concretelang/Dialect/RT/IR/RTOps.h>
@@ -187,7 +188,8 @@ getTaskArgumentSizeAndType(Value val, Location loc, OpBuilder builder) {
 }
 
 static void lowerDataflowTaskOp(RT::DataflowTaskOp DFTOp,
-                                func::FuncOp workFunction) {
+                                func::FuncOp workFunction,
+                                uint64_t priority) {
   Region &opBody = DFTOp->getParentOfType<func::FuncOp>().getBody();
   OpBuilder builder(DFTOp);
 
@@ -222,7 +224,7 @@ static void lowerDataflowTaskOp(RT::DataflowTaskOp DFTOp,
   // DataflowTaskOp.  This also includes the necessary handling of
   // operands and results (conversion to/from futures and propagation).
   SmallVector<Value, 4> catOperands;
-  int size = 3 + DFTOp.getNumResults() + DFTOp.getNumOperands();
+  int size = 4 + DFTOp.getNumResults() + DFTOp.getNumOperands();
   catOperands.reserve(size);
   auto fnptr = builder.create<mlir::func::ConstantOp>(
       DFTOp.getLoc(), workFunction.getFunctionType(),
@@ -231,9 +233,12 @@ static void lowerDataflowTaskOp(RT::DataflowTaskOp DFTOp,
       DFTOp.getLoc(), builder.getI64IntegerAttr(DFTOp.getNumOperands()));
   auto numOuts = builder.create<arith::ConstantOp>(
       DFTOp.getLoc(), builder.getI64IntegerAttr(DFTOp.getNumResults()));
+  auto taskPriority = builder.create<arith::ConstantOp>(
+      DFTOp.getLoc(), builder.getI64IntegerAttr(priority));
   catOperands.push_back(fnptr.getResult());
   catOperands.push_back(numIns.getResult());
   catOperands.push_back(numOuts.getResult());
+  catOperands.push_back(taskPriority.getResult());
 
   // We need to adjust the results for the CreateAsyncTaskOp which
   // are the work function's returns through pointers passed as
@@ -311,6 +316,247 @@ static func::FuncOp getCalledFunction(CallOpInterface callOp) {
       SymbolTable::lookupNearestSymbolFrom(callOp, sym));
 }
 
+/// Relative weights of the operations in a task body used by the
+/// coarsening below. The baseline is a levelled operation on a single
+/// ciphertext; table lookups lower to a programmable bootstrap which
+/// dominates the cost of any levelled operation, and reductions
+/// (dot/matmul/conv) perform several levelled operations per output
+/// element.
+constexpr uint64_t TASK_WEIGHT_PBS = 100;
+constexpr uint64_t TASK_WEIGHT_REDUCTION = 10;
+
+/// Statically estimate the amount of work performed by the body of a
+/// task, in multiples of a levelled operation on a single ciphertext.
+static uint64_t estimateTaskWeight(RT::DataflowTaskOp task) {
+  uint64_t weight = 0;
+  task.getBody().walk([&](Operation *op) {
+    uint64_t elements = 1;
+    for (Type type : op->getResultTypes())
+      if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>())
+        if (tensorType.hasStaticShape()) {
+          uint64_t numElements = 1;
+          for (auto dim : tensorType.getShape())
+            numElements *= dim;
+          elements = std::max(elements, numElements);
+        }
+    if (isa<FHE::ApplyLookupTableEintOp, FHELinalg::ApplyLookupTableEintOp,
+            FHELinalg::ApplyMultiLookupTableEintOp,
+            FHELinalg::ApplyMappedLookupTableEintOp>(op))
+      weight += elements * TASK_WEIGHT_PBS;
+    else if (isa<FHELinalg::MatMulEintIntOp, FHELinalg::MatMulIntEintOp,
+                 FHELinalg::Dot, FHELinalg::SumOp, FHELinalg::Conv2dOp>(op))
+      weight += elements * TASK_WEIGHT_REDUCTION;
+    else
+      weight += elements;
+  });
+  return weight;
+}
+
+/// Critical-path priority of each task: its weight plus the longest
+/// chain of dependent tasks below it (its "bottom level"), expressed as
+/// a 0-100 share of the function's longest chain. The runtime maps this
+/// share onto its discrete scheduling priorities so that when several
+/// tasks become ready together, the ones whose delay would extend the
+/// makespan directly are launched first.
+static DenseMap<Operation *, uint64_t>
+computeCriticalPathPriorities(func::FuncOp func) {
+  SmallVector<RT::DataflowTaskOp, 8> tasks;
+  func.walk([&](RT::DataflowTaskOp op) { tasks.push_back(op); });
+
+  // Task results only flow forward, so walking the tasks in reverse
+  // visits every consumer before its producers.
+  DenseMap<Operation *, uint64_t> bottomLevels;
+  uint64_t longest = 0;
+  for (auto task : llvm::reverse(tasks)) {
+    uint64_t below = 0;
+    for (Value result : task->getResults())
+      for (Operation *user : result.getUsers()) {
+        Operation *consumer = user;
+        while (consumer != nullptr && !isa<RT::DataflowTaskOp>(consumer))
+          consumer = consumer->getParentOp();
+        if (consumer == nullptr)
+          continue;
+        auto it = bottomLevels.find(consumer);
+        if (it != bottomLevels.end())
+          below = std::max(below, it->second);
+      }
+    uint64_t level = estimateTaskWeight(task) + below;
+    bottomLevels[task] = level;
+    longest = std::max(longest, level);
+  }
+
+  DenseMap<Operation *, uint64_t> priorities;
+  for (auto &entry : bottomLevels)
+    priorities[entry.first] =
+        longest == 0 ? 0 : entry.second * 100 / longest;
+  return priorities;
+}
+
+/// Topological wave of each task: zero for tasks with no task
+/// producers, otherwise one past the deepest producer. Tasks of one
+/// wave have no dependences among themselves, so the runtime can
+/// release and schedule a whole wave as a batch; the wave is packed
+/// into the high bits of the task priority word (see DFRuntime.hpp).
+static DenseMap<Operation *, uint64_t> computeWaveLevels(func::FuncOp func) {
+  DenseMap<Operation *, uint64_t> waves;
+  // Tasks only consume results of earlier tasks, so one forward walk
+  // sees every producer before its consumers.
+  func.walk([&](RT::DataflowTaskOp task) {
+    uint64_t wave = 0;
+    for (Value operand : task->getOperands()) {
+      Operation *producer = operand.getDefiningOp();
+      while (producer != nullptr && !isa<RT::DataflowTaskOp>(producer))
+        producer = producer->getParentOp();
+      if (producer == nullptr)
+        continue;
+      auto it = waves.find(producer);
+      if (it != waves.end())
+        wave = std::max(wave, it->second + 1);
+    }
+    waves[task] = wave;
+  });
+  return waves;
+}
+
+/// Merging `producer` into `consumer` is only legal when no operation
+/// strictly between the two depends on the producer's results:
+/// otherwise the merged task and the intermediate operation would wait
+/// on each other.
+static bool canMergeTasks(RT::DataflowTaskOp producer,
+                          RT::DataflowTaskOp consumer) {
+  Block *block = consumer->getBlock();
+  if (producer->getBlock() != block)
+    return false;
+  for (Value result : producer->getResults()) {
+    for (Operation *user : result.getUsers()) {
+      Operation *ancestor = block->findAncestorOpInBlock(*user);
+      if (!ancestor)
+        return false;
+      if (ancestor == consumer.getOperation() ||
+          ancestor == producer.getOperation())
+        continue;
+      if (ancestor->isBeforeInBlock(consumer.getOperation()))
+        return false;
+    }
+  }
+  return true;
+}
+
+/// Merge the body of `producer` into `consumer`, returning the merged
+/// task. Producer results still used after the consumer are re-exported
+/// as extra results of the merged task.
+static RT::DataflowTaskOp mergeTasks(RT::DataflowTaskOp producer,
+                                     RT::DataflowTaskOp consumer) {
+  Block *block = consumer->getBlock();
+  Block &producerBody = producer.getBody().front();
+  Block &consumerBody = consumer.getBody().front();
+  auto producerYield = cast<RT::DataflowYieldOp>(producerBody.getTerminator());
+  auto consumerYield = cast<RT::DataflowYieldOp>(consumerBody.getTerminator());
+  SmallVector<Value, 4> producerYielded(producerYield.getValues().begin(),
+                                        producerYield.getValues().end());
+  SmallVector<Value, 4> consumerYielded(consumerYield.getValues().begin(),
+                                        consumerYield.getValues().end());
+
+  // Producer results used after the consumer remain results of the
+  // merged task.
+  SmallVector<std::pair<Value, Value>, 4> reExported;
+  SmallVector<Type, 4> resultTypes(consumer->getResultTypes().begin(),
+                                   consumer->getResultTypes().end());
+  for (auto pair : llvm::zip(producer->getResults(), producerYielded)) {
+    Value result = std::get<0>(pair);
+    for (Operation *user : result.getUsers()) {
+      Operation *ancestor = block->findAncestorOpInBlock(*user);
+      if (ancestor != nullptr && ancestor != consumer.getOperation()) {
+        reExported.push_back({result, std::get<1>(pair)});
+        resultTypes.push_back(result.getType());
+        break;
+      }
+    }
+  }
+
+  OpBuilder builder(consumer);
+  auto mergedTask = builder.create<RT::DataflowTaskOp>(
+      consumer.getLoc(), resultTypes, ValueRange());
+  Block &mergedBody = mergedTask.getBody().front();
+  producerYield.erase();
+  consumerYield.erase();
+  mergedBody.getOperations().splice(mergedBody.end(),
+                                    producerBody.getOperations());
+  mergedBody.getOperations().splice(mergedBody.end(),
+                                    consumerBody.getOperations());
+  OpBuilder bodyBuilder = OpBuilder::atBlockEnd(&mergedBody);
+  SmallVector<Value, 4> yielded(consumerYielded);
+  for (auto pair : reExported)
+    yielded.push_back(std::get<1>(pair));
+  bodyBuilder.create<RT::DataflowYieldOp>(mergedTask.getLoc(),
+                                          mlir::TypeRange(), yielded);
+
+  // Former consumer uses of the producer's results now refer to the
+  // values computed in the merged body.
+  for (auto pair : llvm::zip(producer->getResults(), producerYielded))
+    replaceAllUsesInRegionWith(std::get<0>(pair), std::get<1>(pair),
+                               mergedTask.getBody());
+  for (auto pair : llvm::zip(consumer->getResults(),
+                             mergedTask->getResults().take_front(
+                                 consumer->getNumResults())))
+    std::get<0>(pair).replaceAllUsesWith(std::get<1>(pair));
+  for (auto pair :
+       llvm::zip(reExported, mergedTask->getResults().take_back(
+                                 reExported.size())))
+    std::get<0>(std::get<0>(pair)).replaceAllUsesExcept(
+        std::get<1>(pair), consumer.getOperation());
+
+  // The dependences of the merged task are whatever its body still uses
+  // from the outside.
+  SetVector<Value> deps;
+  getUsedValuesDefinedAbove(mergedTask.getBody(), deps);
+  mergedTask->setOperands(deps.takeVector());
+
+  consumer->erase();
+  producer->erase();
+  return mergedTask;
+}
+
+/// Merge undersized tasks into one of their producers until they reach
+/// the requested grain size, so that the per-task runtime overhead
+/// (creation, scheduling and synchronization of futures) is amortized
+/// over enough work.
+static void coarsenTaskGraph(func::FuncOp func, uint64_t taskGrainSize) {
+  SmallVector<RT::DataflowTaskOp, 8> tasks;
+  func.walk([&](RT::DataflowTaskOp op) { tasks.push_back(op); });
+
+  DenseMap<Operation *, uint64_t> weights;
+  for (auto task : tasks)
+    weights[task] = estimateTaskWeight(task);
+
+  for (size_t i = 0; i < tasks.size(); i++) {
+    RT::DataflowTaskOp task = tasks[i];
+    while (weights[task] < taskGrainSize) {
+      // Merge with the lightest producer as long as the result stays
+      // within the grain size and the merge cannot create a dependence
+      // cycle.
+      RT::DataflowTaskOp bestProducer = nullptr;
+      for (Value operand : task->getOperands()) {
+        auto producer = operand.getDefiningOp<RT::DataflowTaskOp>();
+        if (!producer || producer == task ||
+            weights[producer] + weights[task] > taskGrainSize ||
+            !canMergeTasks(producer, task))
+          continue;
+        if (!bestProducer || weights[producer] < weights[bestProducer])
+          bestProducer = producer;
+      }
+      if (!bestProducer)
+        break;
+      uint64_t mergedWeight = weights[bestProducer] + weights[task];
+      weights.erase(bestProducer);
+      weights.erase(task);
+      task = mergeTasks(bestProducer, task);
+      tasks[i] = task;
+      weights[task] = mergedWeight;
+    }
+  }
+}
+
 /// For documentation see Autopar.td
 struct LowerDataflowTasksPass
     : public LowerDataflowTasksBase<LowerDataflowTasksPass> {
@@ -330,6 +576,24 @@ struct LowerDataflowTasksPass
       SymbolTable symbolTable = mlir::SymbolTable::getNearestSymbolTable(func);
       SmallVector<std::pair<RT::DataflowTaskOp, func::FuncOp>, 4> outliningMap;
 
+      // Merge undersized tasks into their producers before outlining so
+      // that each work function amortizes the runtime's task creation
+      // and scheduling overhead.
+      coarsenTaskGraph(func, taskGrainSize);
+
+      // Critical-path priorities must be computed before outlining
+      // detaches the task bodies the weight estimate walks.
+      DenseMap<Operation *, uint64_t> priorities =
+          computeCriticalPathPriorities(func);
+
+      // Annotate each task with its topological wave, packed into the
+      // priority word next to the critical-path share.
+      DenseMap<Operation *, uint64_t> waves = computeWaveLevels(func);
+      for (auto &entry : waves)
+        priorities[entry.first] =
+            dfr::_dfr_set_task_wave(priorities.lookup(entry.first),
+                                    entry.second);
+
       // Outline DataflowTaskOp bodies to work functions
       func.walk([&](RT::DataflowTaskOp op) {
         auto workFunctionName =
@@ -346,7 +610,8 @@ struct LowerDataflowTasksPass
       });
       // Lower the DF task ops to RT dialect ops.
       for (auto mapping : outliningMap)
-        lowerDataflowTaskOp(mapping.first, mapping.second);
+        lowerDataflowTaskOp(mapping.first, mapping.second,
+                            priorities.lookup(mapping.first));
 
       // Gather all entry points (assuming no recursive calls to entry points)
       // Main is always an entry-point - otherwise check if this
@@ -394,15 +659,18 @@ struct LowerDataflowTasksPass
         registerWorkFunction(entryPoint, wf);
     }
   }
-  LowerDataflowTasksPass(bool debug) : debug(debug){};
+  LowerDataflowTasksPass(bool debug, uint64_t taskGrainSize)
+      : debug(debug), taskGrainSize(taskGrainSize){};
 
 protected:
   bool debug;
+  uint64_t taskGrainSize;
 };
 } // end anonymous namespace
 
-std::unique_ptr<mlir::Pass> createLowerDataflowTasksPass(bool debug) {
-  return std::make_unique<LowerDataflowTasksPass>(debug);
+std::unique_ptr<mlir::Pass> createLowerDataflowTasksPass(bool debug,
+                                                         uint64_t taskGrainSize) {
+  return std::make_unique<LowerDataflowTasksPass>(debug, taskGrainSize);
 }
 
 namespace {
@@ -508,7 +776,7 @@ struct FinalizeTaskCreationPass
       func::FuncOp workfn = dyn_cast_or_null<func::FuncOp>(
           SymbolTable::lookupNearestSymbolFrom(catOp, sym));
       assert(workfn && "Task work function missing.");
-      if (workfn.getNumArguments() > catOp.getNumOperands() - 3)
+      if (workfn.getNumArguments() > catOp.getNumOperands() - 4)
         ctx = *catOp->getParentOfType<func::FuncOp>().getArguments().rbegin();
       else
         ctx = builder.create<arith::ConstantOp>(catOp.getLoc(),
@@ -520,9 +788,9 @@ struct FinalizeTaskCreationPass
         // checking if needed. It can be null when not relevant.
         if (index == 0)
           operands.push_back(ctx);
-        // First three operands are the function pointer, number inputs
-        // and number outputs - nothing further to do.
-        if (++index <= 3)
+        // First four operands are the function pointer, number inputs,
+        // number outputs and task priority - nothing further to do.
+        if (++index <= 4)
           continue;
         auto op_size = getTaskArgumentSizeAndType(op, catOp.getLoc(), builder);
         operands.push_back(op_size.first);
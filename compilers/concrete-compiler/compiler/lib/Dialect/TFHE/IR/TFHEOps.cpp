@@ -115,6 +115,67 @@ mlir::LogicalResult MulGLWEIntOp::verify() {
       *this);
 }
 
+/// Estimates the size of a value of type `t` in bytes, or returns 0
+/// if no estimate can be given.
+static int64_t typeByteSizeEstimate(mlir::Type t) {
+  if (GLWECipherTextType glweType = t.dyn_cast<GLWECipherTextType>()) {
+    GLWESecretKey key = glweType.getKey();
+
+    // A GLWE ciphertext is made up of (dimension * polySize + 1)
+    // coefficients of 64 bits each
+    if (std::optional<GLWESecretKeyParameterized> parameterized =
+            key.getParameterized()) {
+      return (parameterized->dimension * parameterized->polySize + 1) * 8;
+    } else if (std::optional<GLWESecretKeyNormalized> normalized =
+                   key.getNormalized()) {
+      return (normalized->dimension * normalized->polySize + 1) * 8;
+    }
+
+    return 0;
+  }
+
+  if (mlir::IntegerType intType = t.dyn_cast<mlir::IntegerType>())
+    return (intType.getWidth() + 7) / 8;
+
+  if (mlir::RankedTensorType tensorType =
+          t.dyn_cast<mlir::RankedTensorType>()) {
+    if (!tensorType.hasStaticShape())
+      return 0;
+
+    int64_t elementSize = typeByteSizeEstimate(tensorType.getElementType());
+
+    return elementSize * tensorType.getNumElements();
+  }
+
+  return 0;
+}
+
+int64_t batchedElementByteSizeEstimate(
+    mlir::Operation *op,
+    ::llvm::MutableArrayRef<::mlir::OpOperand> batchableOperands) {
+  int64_t size = 0;
+
+  for (mlir::OpOperand &operand : batchableOperands) {
+    int64_t operandSize = typeByteSizeEstimate(operand.get().getType());
+
+    if (operandSize == 0)
+      return 0;
+
+    size += operandSize;
+  }
+
+  for (mlir::Value result : op->getResults()) {
+    int64_t resultSize = typeByteSizeEstimate(result.getType());
+
+    if (resultSize == 0)
+      return 0;
+
+    size += resultSize;
+  }
+
+  return size;
+}
+
 } // namespace TFHE
 } // namespace concretelang
 } // namespace mlir
@@ -32,6 +32,8 @@ static std::vector<GenericComputeClient> gcc;
 static hpx::lcos::barrier *_dfr_jit_phase_barrier;
 static hpx::lcos::barrier *_dfr_startup_barrier;
 static size_t num_nodes = 0;
+static size_t dfr_worker_thread_override = 0;
+static std::string dfr_worker_binding;
 #if CONCRETELANG_TIMING_ENABLED
 static struct timespec init_timer, broadcast_timer, compute_timer, whole_timer;
 #endif
@@ -54,6 +56,9 @@ void *_dfr_make_ready_future(void *in, size_t memref_clone_p) {
 }
 
 void *_dfr_await_future(void *in) {
+  // A gated wave must be released before blocking on one of its
+  // results.
+  dfr_flush_wave_gates();
   return static_cast<dfr_refcounted_future_p>(in)->future->get();
 }
 
@@ -61,33 +66,97 @@ void _dfr_deallocate_future(void *in) {
   auto drf = static_cast<dfr_refcounted_future_p>(in);
   size_t prev_count = drf->count.fetch_sub(1);
   if (prev_count == 1) {
-    // If this was a memref for which a clone was needed, deallocate first.
-    if (drf->cloned_memref_p)
-      free(
+    // If this was a memref for which a clone was needed, deallocate
+    // first. Data received from another locality is owned by its
+    // zero-copy payload buffer and released through the registry.
+    if (drf->cloned_memref_p) {
+      void *data =
           (void *)(static_cast<StridedMemRefType<char, 1> *>(drf->future->get())
-                       ->data));
+                       ->data);
+      if (!dfr_release_payload_buffer(data))
+        free(data);
+    }
     free(drf->future->get());
     delete (drf->future);
     delete drf;
   }
 }
 
-/// Runtime generic async_task.  Each first NUM_PARAMS pairs of
-/// arguments in the variadic list corresponds to a void* pointer on a
-/// hpx::future<void*> and the size of data within the future.  After
-/// that come NUM_OUTPUTS pairs of hpx::future<void*>* and size_t for
-/// the returns.
+// Result streaming: a batched work function exposes its output as
+// chunks fulfilled one by one, letting chunk-level consumers start
+// before the whole output is done.
+void *_dfr_make_chunked_future(size_t num_chunks) {
+  return (void *)new dfr_chunked_future_t(num_chunks);
+}
+
+void _dfr_fulfill_chunk(void *chunked_future, size_t chunk_idx, void *chunk) {
+  static_cast<dfr_chunked_future_p>(chunked_future)
+      ->promises[chunk_idx]
+      .set_value(chunk);
+}
+
+void *_dfr_get_chunk_future(void *chunked_future, size_t chunk_idx) {
+  return (void *)static_cast<dfr_chunked_future_p>(chunked_future)
+      ->chunks[chunk_idx];
+}
+
+void _dfr_deallocate_chunked_future(void *chunked_future) {
+  auto dcf = static_cast<dfr_chunked_future_p>(chunked_future);
+  // Dropping a chunk's last reference releases its descriptor, which
+  // requires the chunk to have been fulfilled.
+  for (auto chunk : dcf->chunks)
+    _dfr_deallocate_future(chunk);
+  delete dcf;
+}
+
+/// Runtime generic async_task.  PRIORITY is the critical-path share of
+/// the task (0-100 of the longest dependency chain in the entry point,
+/// computed in LowerDataflowTasksToRT.cpp) used to order ready tasks.
+/// Each first NUM_PARAMS pairs of arguments in the variadic list
+/// corresponds to a void* pointer on a hpx::future<void*> and the size
+/// of data within the future.  After that come NUM_OUTPUTS pairs of
+/// hpx::future<void*>* and size_t for the returns.
 void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
-                            size_t num_outputs, ...) {
+                            size_t num_outputs, uint64_t priority, ...) {
   std::vector<void *> refcounted_futures;
+  std::vector<void *> outputs;
+  refcounted_futures.reserve(num_params);
+  outputs.reserve(num_outputs);
+
+  // When a template has been recorded for this work function, only
+  // the futures of this invocation need to be collected: the sizes
+  // and types in the variadic list are invariant and already held by
+  // the template.
+  auto tmpl = dfr_lookup_task_template(wfn);
+  if (tmpl != nullptr) {
+    assert(tmpl->param_sizes.size() == num_params &&
+           tmpl->output_sizes.size() == num_outputs);
+    va_list args;
+    va_start(args, priority);
+    for (size_t i = 0; i < num_outputs; ++i) {
+      outputs.push_back(va_arg(args, void *));
+      (void)va_arg(args, uint64_t);
+      (void)va_arg(args, uint64_t);
+    }
+    for (size_t i = 0; i < num_params; ++i) {
+      refcounted_futures.push_back(va_arg(args, void *));
+      (void)va_arg(args, uint64_t);
+      (void)va_arg(args, uint64_t);
+    }
+    va_end(args);
+
+    dfr_instantiate_task_template(std::move(tmpl), ctx, priority,
+                                  refcounted_futures, outputs);
+    return;
+  }
+
   std::vector<size_t> param_sizes;
   std::vector<uint64_t> param_types;
-  std::vector<void *> outputs;
   std::vector<size_t> output_sizes;
   std::vector<uint64_t> output_types;
 
   va_list args;
-  va_start(args, num_outputs);
+  va_start(args, priority);
   for (size_t i = 0; i < num_outputs; ++i) {
     outputs.push_back(va_arg(args, void *));
     output_sizes.push_back(va_arg(args, uint64_t));
@@ -100,8 +169,9 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   }
   va_end(args);
 
-  dfr_create_async_task_impl(wfn, ctx, refcounted_futures, param_sizes,
-                             param_types, outputs, output_sizes, output_types);
+  dfr_create_async_task_impl(wfn, ctx, priority, refcounted_futures,
+                             param_sizes, param_types, outputs, output_sizes,
+                             output_types);
 }
 
 /// Runtime generic async_task with vector parametres.  Each first
@@ -117,9 +187,41 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
 void _dfr_create_async_task_vec(wfnptr wfn, void *ctx, size_t num_params,
                                 size_t num_outputs, ...) {
   std::vector<void *> refcounted_futures;
+  std::vector<void *> outputs;
+
+  // Warm path, as in _dfr_create_async_task: the recorded template
+  // holds the per-element sizes and types, only futures are collected.
+  auto tmpl = dfr_lookup_task_template(wfn);
+  if (tmpl != nullptr) {
+    va_list args;
+    va_start(args, num_outputs);
+    for (size_t i = 0; i < num_outputs; ++i) {
+      size_t count = va_arg(args, uint64_t);
+      void **futures = va_arg(args, void **);
+      (void)va_arg(args, uint64_t);
+      (void)va_arg(args, uint64_t);
+      for (size_t j = 0; j < count; ++j)
+        outputs.push_back(futures[j]);
+    }
+    for (size_t i = 0; i < num_params; ++i) {
+      size_t count = va_arg(args, uint64_t);
+      void **futures = va_arg(args, void **);
+      (void)va_arg(args, uint64_t);
+      (void)va_arg(args, uint64_t);
+      for (size_t j = 0; j < count; ++j)
+        refcounted_futures.push_back(futures[j]);
+    }
+    va_end(args);
+    assert(tmpl->param_sizes.size() == refcounted_futures.size() &&
+           tmpl->output_sizes.size() == outputs.size());
+
+    dfr_instantiate_task_template(std::move(tmpl), ctx, /*priority=*/0,
+                                  refcounted_futures, outputs);
+    return;
+  }
+
   std::vector<size_t> param_sizes;
   std::vector<uint64_t> param_types;
-  std::vector<void *> outputs;
   std::vector<size_t> output_sizes;
   std::vector<uint64_t> output_types;
 
@@ -149,8 +251,9 @@ void _dfr_create_async_task_vec(wfnptr wfn, void *ctx, size_t num_params,
   }
   va_end(args);
 
-  dfr_create_async_task_impl(wfn, ctx, refcounted_futures, param_sizes,
-                             param_types, outputs, output_sizes, output_types);
+  dfr_create_async_task_impl(wfn, ctx, /*priority=*/0, refcounted_futures,
+                             param_sizes, param_types, outputs, output_sizes,
+                             output_types);
 }
 
 /***************************/
@@ -165,6 +268,21 @@ static bool dfr_required_p = false;
 static bool is_jit_p = false;
 static bool is_root_node_p = true;
 static bool use_omp_p = false;
+static bool dfr_runtime_suspended = false;
+
+// The runtime is initialized once per process and its worker pool stays
+// warm across invocations, teardown only happens in _dfr_terminate. When
+// this is set, the scheduler is additionally suspended between
+// computation phases so that idle HPX worker threads do not consume
+// cores while non-dataflow code runs; resuming a suspended pool is much
+// cheaper than a fresh runtime bring-up.
+static bool _dfr_suspend_between_phases() {
+  static bool suspend_p = []() {
+    char *env = getenv("CONCRETE_DFR_SUSPEND_ON_IDLE");
+    return env != nullptr && strtoul(env, NULL, 10) != 0;
+  }();
+  return suspend_p;
+}
 } // namespace
 
 void _dfr_set_required(bool is_required) {
@@ -262,15 +380,35 @@ static inline void _dfr_start_impl(int argc, char *argv[]) {
     // distribution of hardware resources to the runtime systems
     // should be explicitly defined by the user.
     env = getenv("DFR_NUM_THREADS");
-    if (env != nullptr) {
+    if (dfr_worker_thread_override > 0)
+      nHPXThreads = dfr_worker_thread_override;
+    else if (env != nullptr)
       nHPXThreads = strtoul(env, NULL, 10);
-      parameters.push_back(const_cast<char *>("--hpx:threads"));
-      hpxThreadNum = std::to_string(nHPXThreads);
-      parameters.push_back(const_cast<char *>(hpxThreadNum.c_str()));
-    } else
+    else
       nHPXThreads = nCores + 1 - nOMPThreads;
     if (nHPXThreads < 1)
       nHPXThreads = 1;
+    if (dfr_worker_thread_override > 0 || env != nullptr) {
+      parameters.push_back(const_cast<char *>("--hpx:threads"));
+      hpxThreadNum = std::to_string(nHPXThreads);
+      parameters.push_back(const_cast<char *>(hpxThreadNum.c_str()));
+    }
+
+    // Worker pinning: an explicit binding spec set by the embedding
+    // application (runtime_set_worker_binding) or through the
+    // DFR_THREAD_BINDING environment variable is handed to the HPX
+    // affinity machinery. Without it workers float and the OS migrates
+    // them across cores on shared hosts.
+    static std::string bindSpec;
+    env = getenv("DFR_THREAD_BINDING");
+    if (!dfr_worker_binding.empty())
+      bindSpec = dfr_worker_binding;
+    else if (env != nullptr)
+      bindSpec = env;
+    if (!bindSpec.empty()) {
+      parameters.push_back(const_cast<char *>("--hpx:bind"));
+      parameters.push_back(const_cast<char *>(bindSpec.c_str()));
+    }
 
     // If the user does not provide their own config file, one is by
     // default located at the root of the concrete-compiler directory.
@@ -334,6 +472,39 @@ static inline void _dfr_start_impl(int argc, char *argv[]) {
   END_TIME(&init_timer, "Initialization");
 }
 
+/*  Topology control.  Workers are spawned once per process, so the
+    worker count and binding spec must be set before the runtime first
+    starts; they take precedence over the DFR_NUM_THREADS and
+    DFR_THREAD_BINDING environment variables.  */
+void runtime_set_worker_threads(size_t num_threads) {
+  dfr_worker_thread_override = num_threads;
+}
+
+void runtime_set_worker_binding(const char *bind_spec) {
+  dfr_worker_binding = (bind_spec == nullptr) ? "" : bind_spec;
+}
+
+// Bind all subsequent memory allocation of the process to the given
+// NUMA node, co-locating a circuit's temporaries with its evaluation
+// keys. A negative node restores the default policy. Unlike the worker
+// settings this may be called at any time.
+void runtime_bind_memory_numa_node(int node) {
+  hwloc_topology_t topology;
+  hwloc_topology_init(&topology);
+  hwloc_topology_load(topology);
+  if (node < 0) {
+    hwloc_set_membind(topology, hwloc_topology_get_topology_nodeset(topology),
+                      HWLOC_MEMBIND_DEFAULT, HWLOC_MEMBIND_BYNODESET);
+  } else {
+    hwloc_bitmap_t nodeset = hwloc_bitmap_alloc();
+    hwloc_bitmap_set(nodeset, node);
+    hwloc_set_membind(topology, nodeset, HWLOC_MEMBIND_BIND,
+                      HWLOC_MEMBIND_BYNODESET);
+    hwloc_bitmap_free(nodeset);
+  }
+  hwloc_topology_destroy(topology);
+}
+
 /*  Start/stop functions to be called from within user code (or during
     JIT invocation).  These serve to pause/resume the runtime
     scheduler and to clean up used resources.  */
@@ -349,6 +520,12 @@ void _dfr_start(int64_t use_dfr_p, void *ctx) {
     uint64_t expected = uninitialised;
     if (init_guard.compare_exchange_strong(expected, active))
       _dfr_start_impl(0, nullptr);
+    else if (dfr_runtime_suspended) {
+      // The pool was left suspended at the end of the previous phase,
+      // wake the worker threads back up.
+      hpx::resume();
+      dfr_runtime_suspended = false;
+    }
 
     assert(init_guard == active && "DFR runtime failed to initialise");
 
@@ -383,6 +560,7 @@ void _dfr_start(int64_t use_dfr_p, void *ctx) {
 // called on exit from "main" when not using the main wrapper library.
 void _dfr_stop(int64_t use_dfr_p) {
   if (use_dfr_p) {
+    dfr_flush_wave_gates();
     if (num_nodes > 1) {
       // Non-root nodes synchronize here with the root to mark the point
       // where the root is free to send work out (only needed in JIT).
@@ -404,6 +582,14 @@ void _dfr_stop(int64_t use_dfr_p) {
       _dfr_node_level_runtime_context_manager->clearContext();
       _dfr_node_level_work_function_registry->clearRegistry();
     }
+
+    // Suspending is only meaningful on a single node: with remote
+    // localities the scheduler must keep servicing the network.
+    if (num_nodes == 1 && init_guard == active &&
+        _dfr_suspend_between_phases()) {
+      hpx::suspend();
+      dfr_runtime_suspended = true;
+    }
   }
   END_TIME(&compute_timer, "Compute");
   END_TIME(&whole_timer, "Total execution");
@@ -421,8 +607,15 @@ void _dfr_try_initialize() {
 
 void _dfr_terminate() {
   uint64_t expected = active;
-  if (init_guard.compare_exchange_strong(expected, terminated))
+  if (init_guard.compare_exchange_strong(expected, terminated)) {
+    // A suspended runtime cannot process the finalization messages,
+    // resume it before stopping.
+    if (dfr_runtime_suspended) {
+      hpx::resume();
+      dfr_runtime_suspended = false;
+    }
     _dfr_stop_impl();
+  }
 
   assert((init_guard == terminated || init_guard == uninitialised) &&
          "DFR runtime failed to terminate");
@@ -502,5 +695,11 @@ using namespace mlir::concretelang::dfr;
 void _dfr_start(int64_t use_dfr_p, void *ctx) { BEGIN_TIME(&compute_timer); }
 void _dfr_stop(int64_t use_dfr_p) { END_TIME(&compute_timer, "Compute"); }
 
+// Topology control is a no-op without the dataflow runtime: there are
+// no workers to size or bind.
+void runtime_set_worker_threads(size_t num_threads) {}
+void runtime_set_worker_binding(const char *bind_spec) {}
+void runtime_bind_memory_numa_node(int node) {}
+
 void _dfr_terminate() {}
 #endif
@@ -0,0 +1,536 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+/// Alternative single-node backend for the dataflow runtime API. It
+/// implements the same _dfr_* ABI as DFRuntime.cpp on a fixed worker
+/// pool fed by lock-free MPMC ready queues, with none of the HPX
+/// machinery (AGAS, parcel layers, configuration files) that a
+/// single-host deployment never exercises.
+///
+/// The backend is built as its own shared library
+/// (ConcretelangDFRSingleNode) and selected at load time: preloading it
+/// ahead of ConcretelangRuntime (LD_PRELOAD, or linking it first)
+/// interposes the whole task ABI, so generated circuits dispatch here
+/// while the rest of ConcretelangRuntime is untouched. The library must
+/// interpose the complete surface or not at all -- mixing the two
+/// backends within one process is not supported.
+///
+/// Distribution-only facilities are deliberately absent: there is a
+/// single locality, work functions are called through their pointers,
+/// and the runtime context stays where the caller put it.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mlir/ExecutionEngine/CRunnerUtils.h"
+
+#include "concretelang/Runtime/DFRuntime.hpp"
+#include "concretelang/Runtime/dfr_debug_interface.h"
+#include "concretelang/Runtime/runtime_api.h"
+
+namespace mlir {
+namespace concretelang {
+namespace dfr {
+namespace {
+
+[[noreturn]] void sn_fatal(const char *msg) {
+  fprintf(stderr, "DFR single-node runtime: %s\n", msg);
+  abort();
+}
+
+void sn_checked_aligned_alloc(void **out, size_t align, size_t size) {
+  if (posix_memalign(out, align, size) != 0)
+    sn_fatal("memory allocation failed");
+}
+
+struct sn_task;
+
+/// A future fulfilled by the producing task. Consumers either block in
+/// get() (the await path, caller threads only) or subscribe as tasks
+/// and are enqueued when their last dependency resolves; the blocking
+/// path is off the dispatch hot path by construction.
+struct sn_future {
+  sn_future(size_t initial_count, bool clone_p)
+      : count(initial_count), cloned_memref_p(clone_p) {}
+
+  std::atomic<size_t> count;
+  bool cloned_memref_p;
+  std::atomic<bool> ready{false};
+  void *value = nullptr;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<sn_task *> consumers;
+
+  void *get() {
+    if (!ready.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock,
+              [this]() { return ready.load(std::memory_order_acquire); });
+    }
+    return value;
+  }
+
+  /// Registers `task` as a consumer; returns false when the future is
+  /// already resolved and the dependency is satisfied immediately.
+  bool subscribe(sn_task *task) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    if (ready.load(std::memory_order_acquire))
+      return false;
+    consumers.push_back(task);
+    return true;
+  }
+
+  void set(void *v);
+};
+
+struct sn_task {
+  wfnptr wfn;
+  std::vector<sn_future *> params;
+  std::vector<sn_future *> results;
+  std::vector<size_t> output_sizes;
+  bool high_priority;
+  /// Unresolved dependencies plus one creation guard, dropped once all
+  /// subscriptions are in place so a task never launches half-built.
+  std::atomic<size_t> pending{0};
+};
+
+/// Bounded lock-free MPMC ready queue (sequence-numbered ring buffer).
+/// Producers and consumers synchronize per cell through the sequence
+/// word only, so task dispatch is one CAS on either side.
+class sn_mpmc_queue {
+public:
+  sn_mpmc_queue(size_t capacity) : buffer(capacity), mask(capacity - 1) {
+    for (size_t i = 0; i < capacity; i++)
+      buffer[i].sequence.store(i, std::memory_order_relaxed);
+    enqueue_pos.store(0, std::memory_order_relaxed);
+    dequeue_pos.store(0, std::memory_order_relaxed);
+  }
+
+  bool try_push(sn_task *task) {
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t *cell = &buffer[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+      if (dif == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          cell->task = task;
+          cell->sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false; // full
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  sn_task *try_pop() {
+    size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell_t *cell = &buffer[pos & mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (dif == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          sn_task *task = cell->task;
+          cell->sequence.store(pos + mask + 1, std::memory_order_release);
+          return task;
+        }
+      } else if (dif < 0) {
+        return nullptr; // empty
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  struct cell_t {
+    std::atomic<size_t> sequence;
+    sn_task *task;
+  };
+  std::vector<cell_t> buffer;
+  size_t mask;
+  std::atomic<size_t> enqueue_pos;
+  std::atomic<size_t> dequeue_pos;
+};
+
+class sn_scheduler {
+public:
+  static sn_scheduler &instance() {
+    static sn_scheduler scheduler;
+    return scheduler;
+  }
+
+  /// Spawns the worker pool once per process. Worker count follows
+  /// runtime_set_worker_threads, then DFR_NUM_THREADS, then the
+  /// hardware concurrency minus one caller thread.
+  void start() {
+    std::call_once(start_flag, [this]() {
+      size_t num = worker_override.load();
+      if (num == 0) {
+        char *env = getenv("DFR_NUM_THREADS");
+        if (env != nullptr)
+          num = strtoul(env, NULL, 10);
+      }
+      if (num == 0) {
+        size_t cores = std::thread::hardware_concurrency();
+        num = cores > 1 ? cores - 1 : 1;
+      }
+      for (size_t i = 0; i < num; i++)
+        workers.push_back(std::thread([this, i]() { run(i); }));
+    });
+  }
+
+  void shutdown() {
+    if (workers.empty())
+      return;
+    stopping.store(true, std::memory_order_release);
+    idle_cv.notify_all();
+    for (auto &worker : workers)
+      worker.join();
+    workers.clear();
+  }
+
+  void enqueue(sn_task *task) {
+    sn_mpmc_queue &queue = task->high_priority ? high : normal;
+    // A full ring means the machine is saturated with ready tasks;
+    // yielding until a slot frees is the cheap backpressure.
+    while (!queue.try_push(task))
+      std::this_thread::yield();
+    if (idle_workers.load(std::memory_order_acquire) > 0)
+      idle_cv.notify_one();
+  }
+
+  void set_worker_threads(size_t num) { worker_override.store(num); }
+
+  static thread_local size_t worker_id;
+
+private:
+  sn_scheduler() : high(1 << 12), normal(1 << 16) {}
+  ~sn_scheduler() { shutdown(); }
+
+  sn_task *pop() {
+    sn_task *task = high.try_pop();
+    if (task == nullptr)
+      task = normal.try_pop();
+    return task;
+  }
+
+  void run(size_t id) {
+    worker_id = id;
+    while (true) {
+      sn_task *task = pop();
+      if (task == nullptr) {
+        // Brief spin before sleeping: most gaps between tasks of one
+        // invocation are shorter than a futex round-trip.
+        for (int i = 0; i < 256 && task == nullptr; i++) {
+          std::this_thread::yield();
+          task = pop();
+        }
+      }
+      if (task == nullptr) {
+        if (stopping.load(std::memory_order_acquire))
+          return;
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_workers.fetch_add(1);
+        idle_cv.wait_for(lock, std::chrono::milliseconds(1));
+        idle_workers.fetch_sub(1);
+        continue;
+      }
+      execute(task);
+    }
+  }
+
+  void execute(sn_task *task);
+
+  sn_mpmc_queue high;
+  sn_mpmc_queue normal;
+  std::vector<std::thread> workers;
+  std::once_flag start_flag;
+  std::atomic<size_t> worker_override{0};
+  std::atomic<bool> stopping{false};
+  std::mutex idle_mutex;
+  std::condition_variable idle_cv;
+  std::atomic<size_t> idle_workers{0};
+};
+
+thread_local size_t sn_scheduler::worker_id = (size_t)-1;
+
+void sn_future::set(void *v) {
+  std::vector<sn_task *> to_release;
+  {
+    const std::lock_guard<std::mutex> guard(mutex);
+    value = v;
+    ready.store(true, std::memory_order_release);
+    to_release.swap(consumers);
+  }
+  cv.notify_all();
+  for (sn_task *task : to_release)
+    if (task->pending.fetch_sub(1) == 1)
+      sn_scheduler::instance().enqueue(task);
+}
+
+/// Invocation shim around the generated per-arity work function call
+/// switch, shared with the HPX backend.
+struct sn_invocation {
+  std::vector<void *> params;
+  std::vector<size_t> output_sizes;
+};
+
+// The generated switch reports unsupported arities through
+// HPX_THROW_EXCEPTION; map it onto the local fatal handler, the
+// severity token is dropped.
+#define HPX_THROW_EXCEPTION(kind, where, msg) sn_fatal(msg)
+#define _dfr_checked_aligned_alloc sn_checked_aligned_alloc
+
+std::vector<void *> sn_invoke(wfnptr wfn, const sn_invocation &inputs) {
+  std::vector<void *> outputs;
+  switch (inputs.output_sizes.size()) {
+#include "concretelang/Runtime/generated/dfr_task_work_function_calls.h"
+  default:
+    sn_fatal("number of task outputs not supported");
+  }
+  return outputs;
+}
+
+#undef _dfr_checked_aligned_alloc
+#undef HPX_THROW_EXCEPTION
+
+void sn_scheduler::execute(sn_task *task) {
+  sn_invocation inputs;
+  inputs.params.reserve(task->params.size());
+  for (sn_future *param : task->params)
+    inputs.params.push_back(param->get());
+  inputs.output_sizes = task->output_sizes;
+
+  std::vector<void *> outputs = sn_invoke(task->wfn, inputs);
+
+  for (size_t i = 0; i < task->results.size(); i++)
+    task->results[i]->set(outputs[i]);
+  for (sn_future *param : task->params)
+    _dfr_deallocate_future(param);
+  delete task;
+}
+
+/// Task creation shared by the scalar and vector entry points.
+void sn_create_task(wfnptr wfn, uint64_t priority,
+                    std::vector<sn_future *> &params,
+                    std::vector<void *> &output_slots,
+                    std::vector<size_t> &output_sizes,
+                    std::vector<uint64_t> &output_types) {
+  sn_task *task = new sn_task();
+  task->wfn = wfn;
+  task->params = std::move(params);
+  task->output_sizes = std::move(output_sizes);
+  // Same threshold as the HPX backend: tasks on the upper half of the
+  // critical path jump the ready queue (the wave bits of the priority
+  // word are not used here, waves resolve through plain dependencies).
+  task->high_priority = _dfr_get_task_priority(priority) >= 50;
+
+  task->results.reserve(output_slots.size());
+  for (size_t i = 0; i < output_slots.size(); i++) {
+    sn_future *result = new sn_future(
+        1, _dfr_get_arg_type(output_types[i]) == _DFR_TASK_ARG_MEMREF);
+    task->results.push_back(result);
+    *((void **)output_slots[i]) = (void *)result;
+  }
+
+  // Keep every parameter future alive until the body ran, mirroring the
+  // reference taken by the HPX backend.
+  for (sn_future *param : task->params)
+    param->count.fetch_add(1);
+
+  task->pending.store(task->params.size() + 1, std::memory_order_relaxed);
+  size_t satisfied = 1; // creation guard
+  for (sn_future *param : task->params)
+    if (!param->subscribe(task))
+      satisfied++;
+  if (task->pending.fetch_sub(satisfied) == satisfied)
+    sn_scheduler::instance().enqueue(task);
+}
+
+static bool is_jit_p = false;
+static bool use_omp_p = false;
+
+} // namespace
+
+// Process-level controls, interposed so the embedding code drives this
+// backend instead of the HPX one.
+void _dfr_set_required(bool is_required) {
+  if (is_required)
+    sn_scheduler::instance().start();
+}
+void _dfr_set_jit(bool is_jit) { is_jit_p = is_jit; }
+void _dfr_set_use_omp(bool use_omp) { use_omp_p = use_omp; }
+bool _dfr_is_jit() { return is_jit_p; }
+bool _dfr_is_root_node() { return true; }
+bool _dfr_use_omp() { return use_omp_p; }
+bool _dfr_is_distributed() { return false; }
+
+} // namespace dfr
+} // namespace concretelang
+} // namespace mlir
+
+using namespace mlir::concretelang::dfr;
+
+void *_dfr_make_ready_future(void *in, size_t memref_clone_p) {
+  sn_future *future = new sn_future(1, memref_clone_p != 0);
+  future->set(in);
+  return (void *)future;
+}
+
+void *_dfr_await_future(void *in) {
+  return static_cast<sn_future *>(in)->get();
+}
+
+void _dfr_deallocate_future(void *in) {
+  auto future = static_cast<sn_future *>(in);
+  if (future->count.fetch_sub(1) == 1) {
+    if (future->cloned_memref_p)
+      free(static_cast<StridedMemRefType<char, 1> *>(future->value)->data);
+    free(future->value);
+    delete future;
+  }
+}
+
+void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
+                            size_t num_outputs, uint64_t priority, ...) {
+  (void)ctx;
+  std::vector<sn_future *> params;
+  std::vector<void *> output_slots;
+  std::vector<size_t> output_sizes;
+  std::vector<uint64_t> output_types;
+  params.reserve(num_params);
+  output_slots.reserve(num_outputs);
+
+  va_list args;
+  va_start(args, priority);
+  for (size_t i = 0; i < num_outputs; ++i) {
+    output_slots.push_back(va_arg(args, void *));
+    output_sizes.push_back(va_arg(args, uint64_t));
+    output_types.push_back(va_arg(args, uint64_t));
+  }
+  for (size_t i = 0; i < num_params; ++i) {
+    params.push_back(static_cast<sn_future *>(va_arg(args, void *)));
+    (void)va_arg(args, uint64_t);
+    (void)va_arg(args, uint64_t);
+  }
+  va_end(args);
+
+  sn_create_task(wfn, priority, params, output_slots, output_sizes,
+                 output_types);
+}
+
+void _dfr_create_async_task_vec(wfnptr wfn, void *ctx, size_t num_params,
+                                size_t num_outputs, ...) {
+  (void)ctx;
+  std::vector<sn_future *> params;
+  std::vector<void *> output_slots;
+  std::vector<size_t> output_sizes;
+  std::vector<uint64_t> output_types;
+
+  va_list args;
+  va_start(args, num_outputs);
+  for (size_t i = 0; i < num_outputs; ++i) {
+    size_t count = va_arg(args, uint64_t);
+    void **futures = va_arg(args, void **);
+    size_t size = va_arg(args, uint64_t);
+    size_t type = va_arg(args, uint64_t);
+    for (size_t j = 0; j < count; ++j) {
+      output_slots.push_back(futures[j]);
+      output_sizes.push_back(size);
+      output_types.push_back(type);
+    }
+  }
+  for (size_t i = 0; i < num_params; ++i) {
+    size_t count = va_arg(args, uint64_t);
+    void **futures = va_arg(args, void **);
+    (void)va_arg(args, uint64_t);
+    (void)va_arg(args, uint64_t);
+    for (size_t j = 0; j < count; ++j)
+      params.push_back(static_cast<sn_future *>(futures[j]));
+  }
+  va_end(args);
+
+  sn_create_task(wfn, /*priority=*/0, params, output_slots, output_sizes,
+                 output_types);
+}
+
+// Work functions are reached through their pointers on a single node,
+// no registry is needed.
+void _dfr_register_work_function(wfnptr wfn) {}
+
+void *_dfr_make_chunked_future(size_t num_chunks) {
+  auto chunks = new std::vector<sn_future *>();
+  chunks->reserve(num_chunks);
+  for (size_t i = 0; i < num_chunks; i++)
+    chunks->push_back(new sn_future(1, false));
+  return (void *)chunks;
+}
+
+void _dfr_fulfill_chunk(void *chunked_future, size_t chunk_idx, void *chunk) {
+  (*static_cast<std::vector<sn_future *> *>(chunked_future))[chunk_idx]->set(
+      chunk);
+}
+
+void *_dfr_get_chunk_future(void *chunked_future, size_t chunk_idx) {
+  return (void *)(*static_cast<std::vector<sn_future *> *>(
+      chunked_future))[chunk_idx];
+}
+
+void _dfr_deallocate_chunked_future(void *chunked_future) {
+  auto chunks = static_cast<std::vector<sn_future *> *>(chunked_future);
+  for (sn_future *chunk : *chunks)
+    _dfr_deallocate_future(chunk);
+  delete chunks;
+}
+
+void _dfr_start(int64_t use_dfr_p, void *ctx) {
+  (void)ctx; // single locality, the context stays with the caller
+  if (use_dfr_p)
+    sn_scheduler::instance().start();
+}
+
+// The pool stays warm between phases; teardown happens in
+// _dfr_terminate only.
+void _dfr_stop(int64_t use_dfr_p) {}
+
+void _dfr_terminate() { sn_scheduler::instance().shutdown(); }
+
+/*  Topology control. The workers of this backend float; an explicit
+    binding spec has no HPX affinity machinery to land in, and memory
+    binding stays with the hwloc implementation of the main runtime
+    library (deliberately not interposed here).  */
+void runtime_set_worker_threads(size_t num_threads) {
+  sn_scheduler::instance().set_worker_threads(num_threads);
+}
+void runtime_set_worker_binding(const char *bind_spec) {}
+
+size_t _dfr_debug_get_node_id() { return 0; }
+
+size_t _dfr_debug_get_worker_id() { return sn_scheduler::worker_id; }
+
+void _dfr_debug_print_task(const char *name, size_t inputs, size_t outputs) {
+  fprintf(stderr, "Task \"%s\t\" [%zu inputs, %zu outputs]  Worker: %zu\n",
+          name, inputs, outputs, sn_scheduler::worker_id);
+}
+
+void _dfr_print_debug(size_t val) {
+  fprintf(stderr, "_dfr_print_debug : %zu\n", val);
+}
@@ -3,15 +3,22 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <err.h>
 #include <hwloc.h>
 #include <iostream>
+#include <limits>
 #include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <queue>
+#include <set>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -50,6 +57,106 @@ static size_t num_cores = 1;   // Set OMP_NUM_THREADS to configure (as
 // (or value of environment variable SDFG_NUM_GPUS whichever is
 // lower). Set SDFG_DISTRIBUTE_BATCH_OPS=OFF to inhibit this.
 static bool dont_distribute_batched_ops = false;
+// Minimum number of samples a device chunk must have for splitting a
+// batched subgraph across devices to be profitable (amortizing the
+// per-chunk transfers and kernel launches). Set
+// SDFG_MIN_SAMPLES_PER_GPU_CHUNK to configure.
+static size_t min_samples_per_gpu_chunk = 64;
+// Bound on the number of CUDA streams kept per device. Invocations
+// acquire their streams from a per-device pool, so at most this many
+// invocations overlap on one device; further ones wait for a stream to
+// be released. Set SDFG_MAX_STREAMS_PER_GPU to configure.
+static size_t max_streams_per_gpu = 8;
+// Priority class of the invocations started from this thread; set
+// through stream_emulator_set_invocation_priority.
+static thread_local int invocation_priority = 0;
+// The static chunking heuristic below only accounts for device memory,
+// but the optimal chunk count depends on kernel throughput and transfer
+// bandwidth, which vary by device and batch. When enabled, the profile
+// in ChunkingProfile measures the wall time of each chunk count tried
+// and re-derives the count for subsequent invocations of the same
+// subgraph. Set SDFG_ADAPTIVE_CHUNKING=OFF to keep the static
+// heuristic.
+static bool adaptive_chunking = true;
+// Co-schedule independent low-occupancy kernels of a non-batched
+// subgraph on concurrent streams instead of issuing them in stream
+// order. Set SDFG_CONCURRENT_KERNELS=OFF to inhibit this.
+static bool concurrent_kernels = true;
+// Capture the kernel sequence of a non-batched bootstrap subgraph into
+// a CUDA graph and replay it on subsequent invocations with the same
+// shapes, taking per-kernel launch overhead and host-side scheduling
+// off the critical path of repeated invocations. Set
+// SDFG_CUDA_GRAPHS=OFF to inhibit this.
+static bool use_cuda_graphs = true;
+// Bound on the streams one subgraph level spreads over (the compute
+// stream plus aux streams borrowed from the per-device pool).
+static const size_t max_concurrent_lanes = 4;
+
+// Number of SMs per device, queried once at init. The kernels belong
+// to concrete-cuda, so their occupancy cannot be measured through the
+// cudaOccupancy API from here; the block count of a launch (the
+// kernels assign one block per sample along the batch dimension)
+// against the SM count approximates the footprint instead.
+static std::vector<int> &device_sm_counts() {
+  static std::vector<int> counts;
+  return counts;
+}
+
+// Measured chunked-execution times per batched subgraph. Subgraphs are
+// identified by the kernels they chain and their batch geometry, so the
+// history survives the per-invocation rebuild of the DFG.
+struct ChunkingProfile {
+  std::mutex mutex;
+  // subgraph signature -> (chunk count -> best measured seconds)
+  std::map<uint64_t, std::map<size_t, double>> measurements;
+
+  // Picks the chunk count to run: an unmeasured candidate around
+  // `heuristic` while some remain, the best measured one afterwards.
+  // `min_chunks` is the smallest count whose chunks fit in device
+  // memory, `max_chunks` leaves at least one sample per chunk.
+  size_t choose(uint64_t signature, size_t heuristic, size_t min_chunks,
+                size_t max_chunks) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto &measured = measurements[signature];
+    auto clamp = [&](size_t chunks) {
+      if (chunks < min_chunks)
+        return min_chunks;
+      if (chunks > max_chunks)
+        return max_chunks;
+      return chunks;
+    };
+    size_t candidates[4] = {clamp(heuristic), clamp(heuristic * 2),
+                            clamp(heuristic / 2), clamp(heuristic * 4)};
+    for (size_t candidate : candidates)
+      if (measured.find(candidate) == measured.end())
+        return candidate;
+    size_t best = clamp(heuristic);
+    double best_time = std::numeric_limits<double>::max();
+    for (auto &m : measured)
+      if (m.first >= min_chunks && m.first <= max_chunks &&
+          m.second < best_time) {
+        best = m.first;
+        best_time = m.second;
+      }
+    return best;
+  }
+
+  // Keeps the fastest time observed for a count, so one slow outlier
+  // (e.g. a concurrent invocation competing for the devices) does not
+  // disqualify the count for good.
+  void record(uint64_t signature, size_t chunks, double seconds) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto &measured = measurements[signature];
+    auto it = measured.find(chunks);
+    if (it == measured.end() || seconds < it->second)
+      measured[chunks] = seconds;
+  }
+};
+
+static ChunkingProfile &chunking_profile() {
+  static ChunkingProfile profile;
+  return profile;
+}
 
 // Get the byte size of a rank 2 MemRef
 static inline size_t memref_get_data_size(MemRef2 &m) {
@@ -101,71 +208,596 @@ static const int32_t single_chunk = -1;
 static const int32_t split_chunks = -2;
 struct Stream;
 struct Dependence;
-// Track buffer/scratchpad for the PBS to avoid re-allocating it on
-// the device. Reuse where possible or reallocate if a larger buffer
-// is required.
+struct Process;
+// Per-device cap on resident PBS scratch, filled in at
+// stream_emulator_init (a fraction of device memory, or
+// SDFG_MAX_SCRATCH_PER_GPU bytes). Zero disables trimming.
+static std::vector<uint64_t> &device_scratch_limits() {
+  static std::vector<uint64_t> limits;
+  return limits;
+}
+
+// Device-wide broker of PBS scratch buffers. Per-DFG scratch
+// accumulated one buffer per resident circuit shape and was only
+// reclaimed when its DFG died, although scratch is only used while an
+// invocation runs; the broker instead leases buffers across DFGs,
+// reusing an idle one of the same shape and trimming the idle surplus
+// above the per-device cap, oldest first. Content need not survive a
+// lease, but allocations are stream-ordered: each released buffer
+// carries an event recorded on the stream of its last lease, which the
+// next lease (or the trim) waits on before touching the memory. In-use
+// leases cannot be revoked; high-priority requests may instead empty
+// the idle reserve on the spot to fit under the cap, where
+// normal-priority ones leave trimming to release time.
+struct Scratch_broker {
+  struct Scratch {
+    int8_t *buffer;
+    uint64_t bytes;
+    uint32_t glwe_dim;
+    uint32_t poly_size;
+    uint32_t level;
+    uint32_t max_samples;
+    cudaEvent_t ready;
+    bool has_ready;
+  };
+
+  Scratch *acquire(void *stream, uint32_t gpu_idx, uint32_t glwe_dimension,
+                   uint32_t polynomial_size, uint32_t level_count,
+                   uint32_t input_lwe_ciphertext_count, bool high_priority) {
+    uint32_t max_sm = cuda_get_max_shared_memory(gpu_idx);
+    uint64_t bytes =
+        std::max(get_buffer_size_bootstrap_low_latency_64(
+                     glwe_dimension, polynomial_size, level_count,
+                     input_lwe_ciphertext_count, max_sm),
+                 get_buffer_size_bootstrap_amortized_64(
+                     glwe_dimension, polynomial_size,
+                     input_lwe_ciphertext_count, max_sm));
+    uint64_t limit = gpu_idx < device_scratch_limits().size()
+                         ? device_scratch_limits()[gpu_idx]
+                         : 0;
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      // Reuse the smallest idle buffer of the same shape that is large
+      // enough for this lease.
+      std::list<Scratch *>::iterator best = idle.end();
+      for (auto it = idle.begin(); it != idle.end(); ++it) {
+        if ((*it)->glwe_dim == glwe_dimension &&
+            (*it)->poly_size == polynomial_size &&
+            (*it)->level == level_count &&
+            (*it)->max_samples >= input_lwe_ciphertext_count &&
+            (best == idle.end() || (*it)->bytes < (*best)->bytes))
+          best = it;
+      }
+      if (best != idle.end()) {
+        Scratch *scratch = *best;
+        idle.erase(best);
+        idle_bytes -= scratch->bytes;
+        leased_bytes += scratch->bytes;
+        if (scratch->has_ready)
+          cudaStreamWaitEvent(*(cudaStream_t *)stream, scratch->ready, 0);
+        return scratch;
+      }
+      if (high_priority && limit > 0)
+        trim_idle(stream, gpu_idx,
+                  limit > leased_bytes + bytes ? limit - leased_bytes - bytes
+                                               : 0);
+    }
+    Scratch *scratch = new Scratch();
+    scratch->bytes = bytes;
+    scratch->glwe_dim = glwe_dimension;
+    scratch->poly_size = polynomial_size;
+    scratch->level = level_count;
+    scratch->max_samples = input_lwe_ciphertext_count;
+    scratch->has_ready = false;
+    scratch_cuda_bootstrap_dispatch_64(stream, gpu_idx, &scratch->buffer,
+                                       glwe_dimension, polynomial_size,
+                                       level_count, input_lwe_ciphertext_count,
+                                       max_sm, true);
+    const std::lock_guard<std::mutex> guard(mutex);
+    leased_bytes += bytes;
+    return scratch;
+  }
+
+  void release(Scratch *scratch, void *stream, uint32_t gpu_idx) {
+    if (!scratch->has_ready) {
+      cudaEventCreateWithFlags(&scratch->ready, cudaEventDisableTiming);
+      scratch->has_ready = true;
+    }
+    cudaEventRecord(scratch->ready, *(cudaStream_t *)stream);
+    uint64_t limit = gpu_idx < device_scratch_limits().size()
+                         ? device_scratch_limits()[gpu_idx]
+                         : 0;
+    const std::lock_guard<std::mutex> guard(mutex);
+    leased_bytes -= scratch->bytes;
+    idle_bytes += scratch->bytes;
+    idle.push_back(scratch);
+    if (limit > 0 && leased_bytes + idle_bytes > limit)
+      trim_idle(stream, gpu_idx,
+                limit > leased_bytes ? limit - leased_bytes : 0);
+  }
+
+private:
+  // Free idle buffers, oldest first, until at most target_idle_bytes
+  // remain. Called with mutex held.
+  void trim_idle(void *stream, uint32_t gpu_idx, uint64_t target_idle_bytes) {
+    while (!idle.empty() && idle_bytes > target_idle_bytes) {
+      Scratch *victim = idle.front();
+      idle.pop_front();
+      idle_bytes -= victim->bytes;
+      if (victim->has_ready) {
+        cudaStreamWaitEvent(*(cudaStream_t *)stream, victim->ready, 0);
+        cudaEventDestroy(victim->ready);
+      }
+      cuda_drop_async(victim->buffer, (cudaStream_t *)stream, gpu_idx);
+      delete victim;
+    }
+  }
+
+  std::mutex mutex;
+  std::list<Scratch *> idle;
+  uint64_t leased_bytes = 0;
+  uint64_t idle_bytes = 0;
+};
+
+// One broker per device, sized once the device count is known (like the
+// stream pools, first used after stream_emulator_init).
+static std::vector<Scratch_broker> &scratch_brokers() {
+  static std::vector<Scratch_broker> brokers(num_devices);
+  return brokers;
+}
+
+// Handle on the PBS scratch leased for one DFG. Leases come from the
+// device-wide broker, so scratch is shared across invocations instead
+// of accumulating per resident circuit shape.
 struct PBS_buffer {
   PBS_buffer(void *stream, uint32_t gpu_idx, uint32_t glwe_dimension,
-             uint32_t polynomial_size, uint32_t input_lwe_ciphertext_count)
-      : max_pbs_buffer_samples(input_lwe_ciphertext_count),
-        glwe_dim(glwe_dimension), poly_size(polynomial_size),
-        gpu_stream(stream), gpu_index(gpu_idx) {
-    scratch_cuda_bootstrap_amortized_64(
-        gpu_stream, gpu_index, &pbs_buffer, glwe_dim, poly_size,
-        max_pbs_buffer_samples, cuda_get_max_shared_memory(gpu_index), true);
+             uint32_t polynomial_size, uint32_t level_count,
+             uint32_t input_lwe_ciphertext_count)
+      : gpu_stream(stream), gpu_index(gpu_idx) {
+    lease = scratch_brokers()[gpu_idx].acquire(
+        stream, gpu_idx, glwe_dimension, polynomial_size, level_count,
+        input_lwe_ciphertext_count, invocation_priority > 0);
   }
   ~PBS_buffer() {
-    cleanup_cuda_bootstrap_amortized(gpu_stream, gpu_index, &pbs_buffer);
+    scratch_brokers()[gpu_index].release(lease, gpu_stream, gpu_index);
   }
   int8_t *get_pbs_buffer(void *stream, uint32_t gpu_idx,
                          uint32_t glwe_dimension, uint32_t polynomial_size,
+                         uint32_t level_count,
                          uint32_t input_lwe_ciphertext_count) {
-    assert(glwe_dimension == glwe_dim);
-    assert(polynomial_size == poly_size);
-    assert(input_lwe_ciphertext_count <= max_pbs_buffer_samples);
+    assert(glwe_dimension == lease->glwe_dim);
+    assert(polynomial_size == lease->poly_size);
+    assert(level_count == lease->level);
+    assert(input_lwe_ciphertext_count <= lease->max_samples);
     assert(stream == gpu_stream);
     assert(gpu_idx == gpu_index);
-    return pbs_buffer;
+    return lease->buffer;
   }
 
 private:
-  int8_t *pbs_buffer;
-  uint32_t max_pbs_buffer_samples;
-  uint32_t glwe_dim;
-  uint32_t poly_size;
+  Scratch_broker::Scratch *lease;
   void *gpu_stream;
   uint32_t gpu_index;
 };
 
+// Bounded pool of reusable CUDA streams for one device. Creating and
+// destroying streams per invocation puts two driver calls on the
+// critical path of every small circuit and lets concurrent invocations
+// spawn streams without bound; the pool recycles streams across
+// invocations and caps how many run concurrently on a device. Streams
+// come in two priority classes so latency-sensitive circuits can
+// overtake batched work already resident on the device.
+struct Stream_pool {
+  cudaStream_t *acquire(uint32_t gpu_idx, bool high_priority) {
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    std::vector<cudaStream_t *> &same = high_priority ? free_high : free_normal;
+    std::vector<cudaStream_t *> &other =
+        high_priority ? free_normal : free_high;
+    while (true) {
+      if (!same.empty()) {
+        cudaStream_t *stream = same.back();
+        same.pop_back();
+        return stream;
+      }
+      if (created < max_streams_per_gpu) {
+        ++created;
+        lock.unlock();
+        return create(gpu_idx, high_priority);
+      }
+      if (!other.empty()) {
+        // At the bound with only streams of the other class idle:
+        // repurpose one rather than waiting.
+        cudaStream_t *stream = other.back();
+        other.pop_back();
+        lock.unlock();
+        cuda_destroy_stream(stream, gpu_idx);
+        return create(gpu_idx, high_priority);
+      }
+      available.wait(lock);
+    }
+  }
+  // Non-blocking acquire for secondary (copy and aux) streams: a
+  // caller already holding a compute stream must not wait on the pool,
+  // or max_streams_per_gpu invocations each holding one stream while
+  // waiting for a second would all block with nobody left to release.
+  // Returns nullptr when the device is at its bound with nothing idle;
+  // the caller falls back to the stream it already holds.
+  cudaStream_t *try_acquire(uint32_t gpu_idx, bool high_priority) {
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    std::vector<cudaStream_t *> &same = high_priority ? free_high : free_normal;
+    std::vector<cudaStream_t *> &other =
+        high_priority ? free_normal : free_high;
+    if (!same.empty()) {
+      cudaStream_t *stream = same.back();
+      same.pop_back();
+      return stream;
+    }
+    if (created < max_streams_per_gpu) {
+      ++created;
+      lock.unlock();
+      return create(gpu_idx, high_priority);
+    }
+    if (!other.empty()) {
+      cudaStream_t *stream = other.back();
+      other.pop_back();
+      lock.unlock();
+      cuda_destroy_stream(stream, gpu_idx);
+      return create(gpu_idx, high_priority);
+    }
+    return nullptr;
+  }
+  void release(cudaStream_t *stream, bool high_priority) {
+    {
+      const std::lock_guard<std::mutex> guard(pool_mutex);
+      (high_priority ? free_high : free_normal).push_back(stream);
+    }
+    available.notify_one();
+  }
+
+private:
+  static cudaStream_t *create(uint32_t gpu_idx, bool high_priority) {
+    if (!high_priority)
+      return cuda_create_stream(gpu_idx);
+    cudaSetDevice(gpu_idx);
+    int least, greatest;
+    cudaDeviceGetStreamPriorityRange(&least, &greatest);
+    cudaStream_t *stream = new cudaStream_t;
+    cudaStreamCreateWithPriority(stream, cudaStreamNonBlocking, greatest);
+    return stream;
+  }
+  std::mutex pool_mutex;
+  std::condition_variable available;
+  std::vector<cudaStream_t *> free_normal;
+  std::vector<cudaStream_t *> free_high;
+  size_t created = 0;
+};
+
+// One pool per device, sized once the device count is known (the pools
+// are first used after stream_emulator_init has set num_devices).
+static std::vector<Stream_pool> &stream_pools() {
+  static std::vector<Stream_pool> pools(num_devices);
+  return pools;
+}
+
+// A non-batched bootstrap subgraph recorded as a CUDA graph. One graph
+// launch replaces the per-kernel launches and the host-side scheduling
+// of the subgraph, which dominate the run time when the same small
+// circuit is invoked repeatedly. Replay requires every device pointer
+// the recorded kernels reference to still be valid, which the
+// per-invocation cuda_malloc_async allocations do not provide; the
+// graph therefore owns stable device buffers (slots) for the
+// subgraph's allocations, pinned staging the recorded uploads read
+// from (refreshed with the current inputs before each launch), and its
+// own PBS scratch lease. A graph matures over the invocations of its
+// subgraph: the first runs eagerly and sizes the slots (Sizing), the
+// second replays the same allocation sequence under stream capture and
+// instantiates the executable (Ready), later ones only refresh the
+// staging and launch it (Replayable). Any divergence demotes the graph
+// to Broken and the subgraph permanently to the eager path.
+struct Captured_graph {
+  enum State { Sizing, Ready, Replayable, Broken };
+  State state = Sizing;
+  uint64_t signature;
+  uint32_t device;
+  cudaGraphExec_t exec = nullptr;
+  // One leaseholder at a time: a concurrent invocation of the same
+  // subgraph falls back to the eager path rather than racing for the
+  // stable buffers. Releases record an event like the scratch broker's,
+  // but replays also rewrite the pinned staging from the host, so the
+  // next lease synchronizes on it host-side.
+  bool leased = false;
+  cudaEvent_t last_use;
+  bool has_last_use = false;
+  // Device buffers, in the order the subgraph allocates them. The
+  // recording runs must replay the exact sequence of the sizing run
+  // for the recorded kernels to land in the right slots.
+  struct Slot {
+    void *device_ptr;
+    size_t bytes;
+  };
+  std::vector<Slot> slots;
+  size_t slot_cursor = 0;
+  // Host-to-device copies recorded in the graph; what refreshes the
+  // staging before a launch depends on the kind.
+  enum Upload_kind {
+    upload_raw,  // an external input, copied from its stream's data
+    upload_glwe, // trivial glwe expansion of a bootstrap table input
+    upload_fixed // derived only from shapes, filled once
+  };
+  struct Upload {
+    Upload_kind kind;
+    void *staging;
+    size_t bytes;
+    size_t slot;
+    Stream *stream; // recording only; resolved to ordinals below
+    size_t process_idx;
+    size_t input_idx;
+    uint32_t poly_size;
+    uint32_t glwe_dim;
+    uint32_t num_luts;
+  };
+  std::vector<Upload> uploads;
+  size_t upload_cursor = 0;
+  // Evaluation key device pointers the recorded kernels reference, in
+  // schedule order. Key rotation moves them; replay re-checks and
+  // re-captures against the current copies when they changed.
+  std::vector<void *> key_ptrs;
+  size_t key_cursor = 0;
+  // Dependences the subgraph leaves on its output streams, recorded in
+  // queue order during the sizing run and synthesized on replay.
+  struct Output {
+    size_t process_idx;
+    size_t output_idx;
+    size_t slot;
+    MemRef2 shape;
+  };
+  std::vector<Output> outputs;
+  // Graph-owned PBS scratch: the per-DFG broker leases move between
+  // addresses, which a recorded kernel cannot follow. Held until the
+  // graph dies (the cache keeps graphs for the life of the process).
+  Scratch_broker::Scratch *scratch = nullptr;
+  // Set when a recording run diverges from the sizing run; the capture
+  // is then abandoned and the graph marked Broken.
+  bool failed = false;
+
+  bool owns(void *ptr) {
+    for (auto &s : slots)
+      if (s.device_ptr == ptr)
+        return true;
+    return false;
+  }
+
+  void reset_cursors() {
+    slot_cursor = 0;
+    upload_cursor = 0;
+    key_cursor = 0;
+    failed = false;
+  }
+
+  void *claim_slot(size_t bytes) {
+    if (state == Sizing) {
+      slots.push_back({cuda_malloc(bytes, device), bytes});
+      return slots.back().device_ptr;
+    }
+    if (slot_cursor >= slots.size() || slots[slot_cursor].bytes < bytes) {
+      // The sequence diverged from the sizing run. Keep handing out
+      // valid memory so the eager recovery can run, but drop the
+      // capture.
+      failed = true;
+      slots.insert(slots.begin() + slot_cursor,
+                   {cuda_malloc(bytes, device), bytes});
+    }
+    return slots[slot_cursor++].device_ptr;
+  }
+
+  // Trivial glwe encryption of num_luts tables: zero mask, table body.
+  static void expand_tables(uint64_t *staging, const uint64_t *tlu,
+                            uint32_t poly_size, uint32_t glwe_dim,
+                            uint32_t num_luts) {
+    size_t pos = 0, postlu = 0;
+    for (size_t l = 0; l < num_luts; ++l) {
+      for (size_t i = 0; i < (size_t)poly_size * glwe_dim; i++)
+        staging[pos++] = 0;
+      for (size_t i = 0; i < poly_size; i++)
+        staging[pos++] = tlu[postlu++];
+    }
+  }
+
+  // Claims a device buffer fed by a host-to-device copy. The copy runs
+  // for real during sizing and is recorded during capture; both read
+  // from the staging buffer, never from `host`, so replays only need
+  // to refresh the staging.
+  void *claim_upload(Upload_kind kind, Stream *s, const uint64_t *host,
+                     size_t bytes, cudaStream_t *stream, uint32_t poly_size = 0,
+                     uint32_t glwe_dim = 0, uint32_t num_luts = 0) {
+    if (state == Sizing) {
+      Upload u;
+      u.kind = kind;
+      u.bytes = bytes;
+      if (cudaMallocHost(&u.staging, bytes) != cudaSuccess)
+        u.staging = malloc(bytes);
+      u.slot = slots.size();
+      u.stream = s;
+      u.process_idx = u.input_idx = 0;
+      u.poly_size = poly_size;
+      u.glwe_dim = glwe_dim;
+      u.num_luts = num_luts;
+      fill_staging(u, host);
+      uploads.push_back(u);
+      void *dst = claim_slot(bytes);
+      cuda_memcpy_async_to_gpu(dst, u.staging, bytes, stream, device);
+      return dst;
+    }
+    if (upload_cursor >= uploads.size() ||
+        uploads[upload_cursor].bytes != bytes)
+      failed = true;
+    void *dst = claim_slot(bytes);
+    if (!failed) {
+      Upload &u = uploads[upload_cursor++];
+      fill_staging(u, host);
+      cuda_memcpy_async_to_gpu(dst, u.staging, bytes, stream, device);
+    }
+    return dst;
+  }
+
+  void fill_staging(Upload &u, const uint64_t *host) {
+    if (u.kind == upload_glwe)
+      expand_tables((uint64_t *)u.staging, host, u.poly_size, u.glwe_dim,
+                    u.num_luts);
+    else
+      memcpy(u.staging, host, u.bytes);
+  }
+
+  int8_t *pbs_scratch(cudaStream_t *stream, uint32_t gpu_idx,
+                      uint32_t glwe_dimension, uint32_t polynomial_size,
+                      uint32_t level_count, uint32_t samples) {
+    if (scratch == nullptr)
+      scratch = scratch_brokers()[gpu_idx].acquire(
+          stream, gpu_idx, glwe_dimension, polynomial_size, level_count,
+          samples, invocation_priority > 0);
+    if (scratch->glwe_dim != glwe_dimension ||
+        scratch->poly_size != polynomial_size ||
+        scratch->level != level_count || samples > scratch->max_samples)
+      failed = true;
+    return scratch->buffer;
+  }
+
+  // Records a key pointer during sizing, overwrites it in schedule
+  // order during a (re-)capture.
+  void note_key(void *ptr) {
+    if (key_cursor < key_ptrs.size())
+      key_ptrs[key_cursor++] = ptr;
+    else {
+      key_ptrs.push_back(ptr);
+      key_cursor = key_ptrs.size();
+    }
+  }
+
+  bool resolve(std::list<Process *> &queue);
+  bool refresh(std::list<Process *> &queue, cudaStream_t *stream, int32_t loc);
+  void synthesize_outputs(std::list<Process *> &queue, int32_t loc);
+};
+
+// Process-wide cache of captured graphs, keyed by subgraph signature so
+// entries survive the per-invocation rebuild of the DFG. Graphs keep
+// their device buffers, staging and scratch for the life of the
+// process; the footprint is bounded by the number of distinct
+// (subgraph, shape) pairs invoked, which the repeated-invocation
+// workloads this targets keep small.
+struct Graph_cache {
+  std::mutex mutex;
+  std::map<uint64_t, Captured_graph *> graphs;
+
+  Captured_graph *lease(uint64_t signature, uint32_t device) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    auto it = graphs.find(signature);
+    Captured_graph *g;
+    if (it == graphs.end()) {
+      g = new Captured_graph();
+      g->signature = signature;
+      g->device = device;
+      graphs.emplace(signature, g);
+    } else {
+      g = it->second;
+    }
+    if (g->state == Captured_graph::Broken || g->leased || g->device != device)
+      return nullptr;
+    g->leased = true;
+    // The previous leaseholder's launch may still be reading the
+    // staging this lease is about to rewrite from the host, so wait
+    // host-side rather than with a stream dependence.
+    if (g->has_last_use)
+      cudaEventSynchronize(g->last_use);
+    return g;
+  }
+
+  void release(Captured_graph *g, cudaStream_t *stream) {
+    const std::lock_guard<std::mutex> guard(mutex);
+    if (!g->has_last_use) {
+      cudaEventCreateWithFlags(&g->last_use, cudaEventDisableTiming);
+      g->has_last_use = true;
+    }
+    cudaEventRecord(g->last_use, *stream);
+    g->leased = false;
+  }
+};
+
+static Graph_cache &graph_cache() {
+  static Graph_cache cache;
+  return cache;
+}
+
 // Keep track of the GPU/CUDA streams used for each accelerator and
 // associated PBS buffer.
 struct GPU_state {
   uint32_t gpu_idx;
   void *gpu_stream;
+  void *copy_stream;
   PBS_buffer *pbs_buffer;
+  // Captured at creation on the invoking thread, so concurrently built
+  // DFGs can run at different priorities.
+  bool high_priority;
   GPU_state(uint32_t idx)
-      : gpu_idx(idx), gpu_stream(nullptr), pbs_buffer(nullptr) {}
+      : gpu_idx(idx), gpu_stream(nullptr), copy_stream(nullptr),
+        pbs_buffer(nullptr), high_priority(invocation_priority > 0) {}
   ~GPU_state() {
     if (pbs_buffer != nullptr)
       delete pbs_buffer;
     if (gpu_stream != nullptr)
-      cuda_destroy_stream((cudaStream_t *)gpu_stream, gpu_idx);
+      stream_pools()[gpu_idx].release((cudaStream_t *)gpu_stream,
+                                      high_priority);
+    if (copy_stream != nullptr)
+      stream_pools()[gpu_idx].release((cudaStream_t *)copy_stream,
+                                      high_priority);
+    for (auto s : aux_streams)
+      stream_pools()[gpu_idx].release((cudaStream_t *)s, high_priority);
   }
   inline int8_t *get_pbs_buffer(uint32_t glwe_dimension,
-                                uint32_t polynomial_size,
+                                uint32_t polynomial_size, uint32_t level_count,
                                 uint32_t input_lwe_ciphertext_count) {
     if (pbs_buffer == nullptr)
       pbs_buffer = new PBS_buffer(get_gpu_stream(), gpu_idx, glwe_dimension,
-                                  polynomial_size, input_lwe_ciphertext_count);
+                                  polynomial_size, level_count,
+                                  input_lwe_ciphertext_count);
     return pbs_buffer->get_pbs_buffer(get_gpu_stream(), gpu_idx, glwe_dimension,
-                                      polynomial_size,
+                                      polynomial_size, level_count,
                                       input_lwe_ciphertext_count);
   }
   inline void *get_gpu_stream() {
     if (gpu_stream == nullptr)
-      gpu_stream = cuda_create_stream(gpu_idx);
+      gpu_stream = stream_pools()[gpu_idx].acquire(gpu_idx, high_priority);
     return gpu_stream;
   }
+  // Separate stream for lookahead transfers, so prefetches overlap with the
+  // kernels running on the compute stream. When the pool is exhausted
+  // the transfers run on the compute stream instead: losing the
+  // overlap is preferable to waiting while holding a stream.
+  inline void *get_copy_stream() {
+    if (copy_stream == nullptr) {
+      copy_stream = stream_pools()[gpu_idx].try_acquire(gpu_idx, high_priority);
+      if (copy_stream == nullptr)
+        return get_gpu_stream();
+    }
+    return copy_stream;
+  }
+  // Extra compute streams for co-scheduling independent low-occupancy
+  // kernels next to the main compute stream. They come from the same
+  // bounded pool, so co-scheduling borrows streams idle invocations
+  // are not using; when none are idle, the lane collapses onto the
+  // compute stream and the kernels run in stream order.
+  inline void *get_aux_stream(size_t lane) {
+    while (aux_streams.size() <= lane) {
+      cudaStream_t *stream =
+          stream_pools()[gpu_idx].try_acquire(gpu_idx, high_priority);
+      if (stream == nullptr)
+        return get_gpu_stream();
+      aux_streams.push_back(stream);
+    }
+    return aux_streams[lane];
+  }
+
+private:
+  std::vector<void *> aux_streams;
 };
 
 // Track resources required for the execution of a single DFG,
@@ -173,6 +805,11 @@ struct GPU_state {
 // streams and memory allocated which depends on execution progress on
 // accelerators before it can be freed.  As execution on accelerators
 // is asynchronous, this must wait for the next synchronization point.
+// While a Captured_graph is being sized or recorded, the DFG routes
+// device allocations and uploads to the graph's stable buffers (see
+// device_alloc and Stream::get); the graph leases the DFG holds keep
+// those buffers out of the normal stream-ordered deallocation until
+// the DFG dies.
 struct GPU_DFG {
   std::vector<GPU_state> gpus;
   uint32_t gpu_idx;
@@ -185,6 +822,12 @@ struct GPU_DFG {
   ~GPU_DFG() {
     free_streams();
     free_stream_order_dependent_data();
+    // Released after the streams died: their dependences may reference
+    // graph slots, which must stay leased until then.
+    for (auto g : graph_leases)
+      graph_cache().release(g,
+                            (cudaStream_t *)gpus[g->device].get_gpu_stream());
+    graph_leases.clear();
   }
   inline void register_stream(Stream *s) { streams.push_back(s); }
   inline void register_stream_order_dependent_allocation(void *p) {
@@ -196,28 +839,66 @@ struct GPU_DFG {
     to_free_list.clear();
   }
   inline int8_t *get_pbs_buffer(uint32_t glwe_dimension,
-                                uint32_t polynomial_size,
+                                uint32_t polynomial_size, uint32_t level_count,
                                 uint32_t input_lwe_ciphertext_count) {
     if (pbs_buffer == nullptr) {
-      int8_t *ret = gpus[gpu_idx].get_pbs_buffer(
-          glwe_dimension, polynomial_size, input_lwe_ciphertext_count);
+      int8_t *ret =
+          gpus[gpu_idx].get_pbs_buffer(glwe_dimension, polynomial_size,
+                                       level_count, input_lwe_ciphertext_count);
       pbs_buffer = gpus[gpu_idx].pbs_buffer;
       return ret;
     }
     return pbs_buffer->get_pbs_buffer(gpu_stream, gpu_idx, glwe_dimension,
-                                      polynomial_size,
+                                      polynomial_size, level_count,
                                       input_lwe_ciphertext_count);
   }
   void free_streams();
+  // While set, the processes being scheduled run in graph mode: their
+  // device allocations come from the graph's stable slots and their
+  // uploads go through its staging (sizing run and capture run alike).
+  Captured_graph *graph = nullptr;
+  inline bool graph_active() { return graph != nullptr; }
+  inline void *device_alloc(size_t bytes, cudaStream_t *s, int32_t loc) {
+    if (graph != nullptr)
+      return graph->claim_slot(bytes);
+    return cuda_malloc_async(bytes, s, loc);
+  }
+  inline void adopt_graph_lease(Captured_graph *g) {
+    graph_leases.push_back(g);
+  }
+  // Whether this pointer is a slot of a graph this DFG leases; such
+  // memory belongs to the graph and must not be dropped with the
+  // dependence that carries it.
+  inline bool is_graph_memory(void *ptr) {
+    for (auto g : graph_leases)
+      if (g->owns(ptr))
+        return true;
+    return false;
+  }
+  // While set, every stream request of the process being scheduled is
+  // routed to this stream, so a co-scheduled kernel and the input
+  // transfers feeding it stay ordered on their own lane.
+  void *override_stream = nullptr;
   inline void *get_gpu_stream(int32_t loc) {
     if (loc < 0)
       return nullptr;
+    if (override_stream != nullptr)
+      return override_stream;
     return gpus[loc].get_gpu_stream();
   }
+  inline void *get_aux_gpu_stream(int32_t loc, size_t lane) {
+    return gpus[loc].get_aux_stream(lane);
+  }
+  inline void *get_copy_stream(int32_t loc) {
+    if (loc < 0)
+      return nullptr;
+    return gpus[loc].get_copy_stream();
+  }
 
 private:
   std::list<void *> to_free_list;
   std::list<Stream *> streams;
+  std::list<Captured_graph *> graph_leases;
   PBS_buffer *pbs_buffer;
 };
 
@@ -233,6 +914,9 @@ struct Dependence {
   int32_t chunk_id;
   std::vector<Dependence *> chunks;
   bool used;
+  // Event recorded on the copy stream when this dependence was prefetched,
+  // the compute stream waits on it before consuming the data.
+  void *prefetch_event = nullptr;
   Dependence(int32_t l, MemRef2 hd, void *dd, bool ohr, bool alloc = false,
              int32_t chunk_id = single_chunk)
       : location(l), host_data(hd), device_data(dd), onHostReady(ohr),
@@ -285,8 +969,41 @@ struct Dependence {
     chunk_id = split_chunks;
     location = split_location;
   }
+  // Start moving this host-resident dependence to `device` on the copy
+  // stream, recording the event `wait_prefetch` synchronizes on. The DFG
+  // knows which chunk each device consumes next, so the transfer overlaps
+  // with the kernels of the previous chunk instead of sitting on the
+  // critical path.
+  inline void prefetch(GPU_DFG *dfg, int32_t device) {
+    assert(onHostReady && device_data == nullptr &&
+           "Prefetch only applies to host-resident dependences.");
+    size_t data_size = memref_get_data_size(host_data);
+    cudaStream_t *cstream = (cudaStream_t *)dfg->get_copy_stream(device);
+    device_data = cuda_malloc_async(data_size, cstream, device);
+    cuda_memcpy_async_to_gpu(device_data, host_data.aligned + host_data.offset,
+                             data_size, cstream, device);
+    cudaEvent_t event;
+    cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+    cudaEventRecord(event, *cstream);
+    prefetch_event = (void *)event;
+    location = device;
+  }
+  // Order the compute stream after an in-flight prefetch of this dependence.
+  inline void wait_prefetch(void *compute_stream) {
+    if (prefetch_event != nullptr) {
+      cudaStreamWaitEvent(*(cudaStream_t *)compute_stream,
+                          (cudaEvent_t)prefetch_event, 0);
+      cudaEventDestroy((cudaEvent_t)prefetch_event);
+      prefetch_event = nullptr;
+    }
+  }
   inline void free_data(GPU_DFG *dfg, bool immediate = false) {
-    if (location >= 0 && device_data != nullptr) {
+    if (prefetch_event != nullptr) {
+      cudaEventDestroy((cudaEvent_t)prefetch_event);
+      prefetch_event = nullptr;
+    }
+    if (location >= 0 && device_data != nullptr &&
+        !dfg->is_graph_memory(device_data)) {
       cuda_drop_async(device_data,
                       (cudaStream_t *)dfg->get_gpu_stream(location), location);
     }
@@ -339,10 +1056,16 @@ void memref_mul_cleartext_lwe_ciphertext_u64_process(Process *p, int32_t loc,
                                                      uint64_t *out_ptr);
 void memref_negate_lwe_ciphertext_u64_process(Process *p, int32_t loc,
                                               uint64_t *out_ptr);
-static inline void schedule_kernel(Process *p, uint32_t loc,
-                                   uint64_t *out_ptr) {
+static inline void schedule_kernel(Process *p, uint32_t loc, uint64_t *out_ptr,
+                                   void *stream = nullptr) {
+  p->dfg->override_stream = stream;
   p->fun(p, loc, out_ptr);
+  p->dfg->override_stream = nullptr;
 }
+static void schedule_concurrent_subgraph(GPU_DFG *dfg,
+                                         std::list<Process *> &queue,
+                                         int32_t loc);
+static bool try_graph_subgraph(GPU_DFG *dfg, std::list<Process *> &queue);
 struct Stream {
   Dependence *dep;
   Dependence *saved_dependence;
@@ -421,9 +1144,16 @@ struct Stream {
     // If this subgraph is not batched, then use this DFG's allocated
     // GPU to offload to.
     if (!is_batched_subgraph) {
-      for (auto p : queue)
-        schedule_kernel(p, (subgraph_bootstraps) ? dfg->gpu_idx : host_location,
-                        nullptr);
+      if (subgraph_bootstraps && use_cuda_graphs &&
+          try_graph_subgraph(dfg, queue))
+        return;
+      if (subgraph_bootstraps && concurrent_kernels)
+        schedule_concurrent_subgraph(dfg, queue, dfg->gpu_idx);
+      else
+        for (auto p : queue)
+          schedule_kernel(
+              p, (subgraph_bootstraps) ? dfg->gpu_idx : host_location,
+              nullptr);
       return;
     }
 
@@ -514,6 +1244,38 @@ struct Stream {
         (available_mem - const_mem_per_sample) / (mem_per_sample * 2);
     size_t num_chunks = num_samples / num_samples_per_chunk +
                         ((num_samples % num_samples_per_chunk) ? 1 : 0);
+    // Smallest chunk count whose chunks still fit in device memory; the
+    // adaptive profile must not go below it.
+    size_t min_chunks = num_chunks;
+    // Even when a single chunk would fit in device memory, splitting the
+    // batch across the available devices is profitable as soon as each
+    // device gets enough samples to amortize the per-chunk transfers and
+    // kernel launches. Use as many devices as the batch can feed at
+    // min_samples_per_gpu_chunk samples per chunk.
+    if (!dont_distribute_batched_ops) {
+      size_t profitable_chunks = num_samples / min_samples_per_gpu_chunk;
+      if (profitable_chunks < 1)
+        profitable_chunks = 1;
+      size_t distributable_chunks =
+          (profitable_chunks < num_devices) ? profitable_chunks : num_devices;
+      if (num_chunks < distributable_chunks)
+        num_chunks = distributable_chunks;
+    }
+    // Identify the subgraph by the chain of kernels it schedules and its
+    // batch geometry. The kernel function pointers are stable within the
+    // process, so the profile survives the per-invocation DFG rebuilds.
+    uint64_t signature = 0xcbf29ce484222325ull;
+    auto mix = [&](uint64_t v) {
+      signature ^= v;
+      signature *= 0x100000001b3ull;
+    };
+    for (auto p : queue)
+      mix((uint64_t)(uintptr_t)p->fun);
+    mix(num_samples);
+    mix(mem_per_sample);
+    if (adaptive_chunking)
+      num_chunks = chunking_profile().choose(signature, num_chunks, min_chunks,
+                                             num_samples);
     // If we don't have enough samples, restrict the number of devices to use
     int32_t num_devices_to_use =
         (num_devices < num_samples) ? num_devices : num_samples;
@@ -521,6 +1283,7 @@ struct Stream {
     num_chunks = (num_chunks / num_devices_to_use +
                   ((num_chunks % num_devices_to_use) ? 1 : 0)) *
                  num_devices_to_use;
+    auto chunking_start = std::chrono::steady_clock::now();
     int32_t target_device = 0;
     for (auto i : inputs) {
       i->dep->split_dependence(num_chunks, (i->ct_stream) ? 0 : 1,
@@ -554,6 +1317,23 @@ struct Stream {
           o->saved_dependence->chunks.push_back(o->dep);
           o->dep = nullptr;
         }
+        // Lookahead prefetch: while this chunk's kernels execute, start
+        // moving the next chunk bound for the same device over its copy
+        // stream, hiding the transfer off the critical path.
+        size_t next = c + num_devices_to_use;
+        if (next < num_chunks) {
+          // Chunks are assigned round-robin, so chunk `next` runs
+          // num_devices_to_use device-increments after this one.
+          int32_t next_device = (target_device + num_devices_to_use) %
+                                num_devices;
+          for (auto i : inputs) {
+            Dependence *ch = i->saved_dependence->chunks[next];
+            if (i->ct_stream && !i->const_stream &&
+                ch->location == host_location && ch->onHostReady &&
+                ch->device_data == nullptr)
+              ch->prefetch(dfg, next_device);
+          }
+        }
         target_device = (target_device + 1) % num_devices;
       }
       // Once we've scheduled work on all devices, we can go gather up the
@@ -573,6 +1353,18 @@ struct Stream {
         o->saved_dependence->chunks.clear();
       }
     }
+    if (adaptive_chunking) {
+      // The gathers above are asynchronous, but the caller synchronizes on
+      // them immediately after in get_on_host, so draining the device
+      // streams here to time the whole chunked execution costs nothing
+      // extra.
+      for (size_t i = 0; i < (size_t)num_devices; ++i)
+        cudaStreamSynchronize(*(cudaStream_t *)dfg->get_gpu_stream(i));
+      double seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - chunking_start)
+                           .count();
+      chunking_profile().record(signature, num_chunks, seconds);
+    }
     // Restore the saved_dependence and deallocate the last input chunks.
     for (auto i : inputs) {
       i->put(i->saved_dependence);
@@ -664,16 +1456,30 @@ struct Stream {
       return dep;
     } else {
       // In case this dependence is needed on a single device
-      if (dep->location == location)
+      if (dep->location == location) {
+        // If it was moved there by a lookahead prefetch, order the compute
+        // stream after the copy stream before the data is consumed.
+        dep->wait_prefetch(dfg->get_gpu_stream(location));
         return dep;
+      }
       assert(dep->onHostReady &&
              "Device-to-device data transfers not supported yet.");
       size_t data_size = memref_get_data_size(dep->host_data);
-      dep->device_data = cuda_malloc_async(
-          data_size, (cudaStream_t *)dfg->get_gpu_stream(location), location);
-      cuda_memcpy_async_to_gpu(
-          dep->device_data, dep->host_data.aligned + dep->host_data.offset,
-          data_size, (cudaStream_t *)dfg->get_gpu_stream(location), location);
+      if (dfg->graph_active()) {
+        // External input of a graph-backed subgraph: the recorded copy
+        // must read from the graph's staging so replays can refresh it
+        // with the data of the invocation at hand.
+        dep->device_data = dfg->graph->claim_upload(
+            Captured_graph::upload_raw, this,
+            dep->host_data.aligned + dep->host_data.offset, data_size,
+            (cudaStream_t *)dfg->get_gpu_stream(location));
+      } else {
+        dep->device_data = cuda_malloc_async(
+            data_size, (cudaStream_t *)dfg->get_gpu_stream(location), location);
+        cuda_memcpy_async_to_gpu(
+            dep->device_data, dep->host_data.aligned + dep->host_data.offset,
+            data_size, (cudaStream_t *)dfg->get_gpu_stream(location), location);
+      }
       dep->location = location;
       return dep;
     }
@@ -687,6 +1493,337 @@ void GPU_DFG::free_streams() {
     delete s;
 }
 
+static Stream *stream_at(std::list<Process *> &queue, size_t process_idx,
+                         size_t input_idx) {
+  size_t pidx = 0;
+  for (auto p : queue) {
+    if (pidx == process_idx)
+      return p->input_streams[input_idx];
+    ++pidx;
+  }
+  return nullptr;
+}
+
+// Resolution, refresh and output synthesis all walk the queue in the
+// order the scheduler issues it, so the ordinals recorded here stay
+// valid across the per-invocation rebuild of streams and processes.
+bool Captured_graph::resolve(std::list<Process *> &queue) {
+  for (auto &u : uploads) {
+    if (u.kind == upload_fixed)
+      continue;
+    bool found = false;
+    size_t pidx = 0;
+    for (auto p : queue) {
+      for (size_t k = 0; k < p->input_streams.size(); ++k)
+        if (p->input_streams[k] == u.stream) {
+          u.process_idx = pidx;
+          u.input_idx = k;
+          found = true;
+          break;
+        }
+      if (found)
+        break;
+      ++pidx;
+    }
+    if (!found)
+      return false;
+  }
+  size_t pidx = 0;
+  for (auto p : queue) {
+    for (size_t k = 0; k < p->output_streams.size(); ++k) {
+      Dependence *d = p->output_streams[k]->dep;
+      if (d == nullptr || d->device_data == nullptr)
+        return false;
+      size_t slot = slots.size();
+      for (size_t i = 0; i < slots.size(); ++i)
+        if (slots[i].device_ptr == d->device_data) {
+          slot = i;
+          break;
+        }
+      if (slot == slots.size())
+        return false;
+      outputs.push_back({pidx, k, slot, d->host_data});
+    }
+    ++pidx;
+  }
+  return true;
+}
+
+// Prepare a launch of the instantiated graph: check the evaluation key
+// copies the recorded kernels reference are still where they were, and
+// rewrite the staging the recorded uploads read from with the inputs
+// of this invocation. Returns false when the keys moved, in which case
+// the caller re-captures.
+bool Captured_graph::refresh(std::list<Process *> &queue, cudaStream_t *stream,
+                             int32_t loc) {
+  size_t kidx = 0;
+  for (auto p : queue) {
+    void *key = nullptr;
+    if (p->fun == memref_keyswitch_lwe_u64_process)
+      key = p->ctx.val->get_ksk_gpu(p->level.val, p->input_lwe_dim.val,
+                                    p->output_lwe_dim.val, loc, stream);
+    else if (p->fun == memref_bootstrap_lwe_u64_process)
+      key = p->ctx.val->get_bsk_gpu(p->input_lwe_dim.val, p->poly_size.val,
+                                    p->level.val, p->glwe_dim.val, loc, stream);
+    else
+      continue;
+    if (kidx >= key_ptrs.size() || key_ptrs[kidx++] != key)
+      return false;
+  }
+  for (auto &u : uploads) {
+    if (u.kind == upload_fixed)
+      continue;
+    Dependence *d = stream_at(queue, u.process_idx, u.input_idx)->dep;
+    if (u.kind == upload_raw && memref_get_data_size(d->host_data) != u.bytes)
+      return false;
+    fill_staging(u, d->host_data.aligned + d->host_data.offset);
+  }
+  return true;
+}
+
+// Reproduce the dependence state an eager run of the subgraph would
+// leave behind: inputs consumed, one device-resident dependence per
+// output stream, backed by the slots the launched graph wrote.
+void Captured_graph::synthesize_outputs(std::list<Process *> &queue,
+                                        int32_t loc) {
+  std::set<Process *> members(queue.begin(), queue.end());
+  for (auto p : queue)
+    for (auto s : p->input_streams)
+      if (s->producer == nullptr || !members.count(s->producer))
+        s->dep->used = true;
+  auto out = outputs.begin();
+  size_t pidx = 0;
+  for (auto p : queue) {
+    for (size_t k = 0; k < p->output_streams.size(); ++k) {
+      assert(out != outputs.end() && out->process_idx == pidx &&
+             out->output_idx == k);
+      p->output_streams[k]->put(new Dependence(
+          loc, out->shape, slots[out->slot].device_ptr, false, false));
+      ++out;
+    }
+    ++pidx;
+  }
+}
+
+// Run a non-batched bootstrap subgraph through the captured-graph
+// cache. Returns false when the subgraph must take the eager path
+// instead: the graph for its signature is broken or leased to a
+// concurrent invocation, or an external input is only resident on a
+// device (such boundary pointers are not stable across invocations).
+static bool try_graph_subgraph(GPU_DFG *dfg, std::list<Process *> &queue) {
+  int32_t loc = dfg->gpu_idx;
+  std::set<Process *> members(queue.begin(), queue.end());
+  // Identify the subgraph by the kernels it chains, their parameters
+  // and the shapes of its external inputs: everything a recorded
+  // launch hard-codes.
+  uint64_t signature = 0xcbf29ce484222325ull;
+  auto mix = [&](uint64_t v) {
+    signature ^= v;
+    signature *= 0x100000001b3ull;
+  };
+  mix(loc);
+  for (auto p : queue) {
+    mix((uint64_t)(uintptr_t)p->fun);
+    if (p->fun == memref_keyswitch_lwe_u64_process) {
+      mix(p->level.val);
+      mix(p->base_log.val);
+      mix(p->input_lwe_dim.val);
+      mix(p->output_lwe_dim.val);
+      mix(p->output_size.val);
+    } else if (p->fun == memref_bootstrap_lwe_u64_process) {
+      mix(p->level.val);
+      mix(p->base_log.val);
+      mix(p->input_lwe_dim.val);
+      mix(p->poly_size.val);
+      mix(p->glwe_dim.val);
+      mix(p->output_size.val);
+    }
+    for (auto s : p->input_streams) {
+      if (s->producer != nullptr && members.count(s->producer))
+        continue;
+      if (s->dep == nullptr || !s->dep->onHostReady ||
+          s->dep->device_data != nullptr)
+        return false;
+      mix(s->dep->host_data.sizes[0]);
+      mix(s->dep->host_data.sizes[1]);
+    }
+  }
+  Captured_graph *graph = graph_cache().lease(signature, loc);
+  if (graph == nullptr)
+    return false;
+  dfg->adopt_graph_lease(graph);
+  cudaStream_t *stream = (cudaStream_t *)dfg->get_gpu_stream(loc);
+
+  if (graph->state == Captured_graph::Replayable) {
+    if (graph->refresh(queue, stream, loc)) {
+      cudaGraphLaunch(graph->exec, *stream);
+      graph->synthesize_outputs(queue, loc);
+      return true;
+    }
+    // The keys rotated under the recorded kernels; drop the executable
+    // and re-capture against the current copies.
+    cudaGraphExecDestroy(graph->exec);
+    graph->exec = nullptr;
+    graph->state = Captured_graph::Ready;
+  }
+
+  if (graph->state == Captured_graph::Sizing) {
+    // First invocation of this subgraph: run eagerly, with allocations
+    // and uploads routed into the graph's stable buffers, so the next
+    // invocation can record against valid pointers.
+    dfg->graph = graph;
+    for (auto p : queue)
+      schedule_kernel(p, loc, nullptr);
+    dfg->graph = nullptr;
+    graph->state = (!graph->failed && graph->resolve(queue))
+                       ? Captured_graph::Ready
+                       : Captured_graph::Broken;
+    return true;
+  }
+
+  // Ready: replay the sizing run's allocation sequence under stream
+  // capture. Relaxed mode keeps unrelated work on other threads legal
+  // while the capture is open.
+  graph->reset_cursors();
+  if (cudaStreamBeginCapture(*stream, cudaStreamCaptureModeRelaxed) !=
+      cudaSuccess) {
+    graph->state = Captured_graph::Broken;
+    for (auto p : queue)
+      schedule_kernel(p, loc, nullptr);
+    return true;
+  }
+  dfg->graph = graph;
+  for (auto p : queue)
+    schedule_kernel(p, loc, nullptr);
+  dfg->graph = nullptr;
+  cudaGraph_t recorded;
+  cudaError_t status = cudaStreamEndCapture(*stream, &recorded);
+  if (status == cudaSuccess && !graph->failed &&
+      cudaGraphInstantiate(&graph->exec, recorded, nullptr, nullptr, 0) ==
+          cudaSuccess) {
+    cudaGraphDestroy(recorded);
+    graph->state = Captured_graph::Replayable;
+    // Capture only records the work; launch the instantiated graph for
+    // this invocation (the staging already holds its inputs).
+    cudaGraphLaunch(graph->exec, *stream);
+    return true;
+  }
+  if (status == cudaSuccess)
+    cudaGraphDestroy(recorded);
+  graph->state = Captured_graph::Broken;
+  // Nothing of the failed capture executed. The capture run marked the
+  // external inputs device-resident in graph slots the recorded (and
+  // now dropped) copies were to fill; reset them to host so the eager
+  // re-run uploads them for real.
+  for (auto p : queue)
+    for (auto s : p->input_streams) {
+      if (s->producer != nullptr && members.count(s->producer))
+        continue;
+      Dependence *d = s->dep;
+      if (d != nullptr && d->device_data != nullptr &&
+          graph->owns(d->device_data)) {
+        d->device_data = nullptr;
+        d->location = host_location;
+      }
+    }
+  for (auto p : queue)
+    schedule_kernel(p, loc, nullptr);
+  return true;
+}
+
+// Block count of the launch this process would issue, approximated by
+// the batch dimension of its ciphertext inputs (available once the
+// previous level of the subgraph has been scheduled).
+static size_t estimated_blocks(Process *p) {
+  size_t blocks = 1;
+  for (auto s : p->input_streams)
+    if (s->ct_stream && s->dep != nullptr &&
+        (size_t)s->dep->host_data.sizes[0] > blocks)
+      blocks = s->dep->host_data.sizes[0];
+  return blocks;
+}
+
+// Full barrier across the streams a level issued on: every stream
+// waits on an event recorded on each of the others, so the next level
+// consumes its inputs wherever they were produced.
+static void join_streams(std::vector<cudaStream_t *> &streams) {
+  if (streams.size() < 2)
+    return;
+  std::vector<cudaEvent_t> events(streams.size());
+  for (size_t i = 0; i < streams.size(); ++i) {
+    cudaEventCreateWithFlags(&events[i], cudaEventDisableTiming);
+    cudaEventRecord(events[i], *streams[i]);
+  }
+  for (size_t i = 0; i < streams.size(); ++i)
+    for (size_t j = 0; j < streams.size(); ++j)
+      if (i != j)
+        cudaStreamWaitEvent(*streams[j], events[i], 0);
+  for (size_t i = 0; i < streams.size(); ++i)
+    cudaEventDestroy(events[i]);
+}
+
+// Issue the kernels of a non-batched subgraph level by level,
+// co-scheduling the independent kernels of one level on concurrent
+// streams when they would leave the device underused: small-parameter
+// kernels launch far fewer blocks than the device has SMs, so issuing
+// them in stream order runs them back to back on a mostly idle device.
+// Bootstraps are kept on the compute stream, they share the PBS
+// scratch buffer bound to it; so are kernels whose own launch already
+// covers the device. Levels are joined with events, so a kernel never
+// runs before the inputs another stream produced for it.
+static void schedule_concurrent_subgraph(GPU_DFG *dfg,
+                                         std::list<Process *> &queue,
+                                         int32_t loc) {
+  const size_t sm_count = device_sm_counts()[loc];
+  // Level of each process: one past the deepest of its producers
+  // within the subgraph. The queue is in topological order, so
+  // producers are levelled before their consumers.
+  std::map<Process *, size_t> levels;
+  size_t depth = 0;
+  for (auto p : queue) {
+    size_t level = 0;
+    for (auto s : p->input_streams) {
+      if (s->producer == nullptr)
+        continue;
+      auto it = levels.find(s->producer);
+      if (it != levels.end() && it->second + 1 > level)
+        level = it->second + 1;
+    }
+    levels[p] = level;
+    if (level > depth)
+      depth = level;
+  }
+  for (size_t level = 0; level <= depth; ++level) {
+    std::vector<Process *> spread;
+    for (auto p : queue) {
+      if (levels[p] != level)
+        continue;
+      if (p->fun == memref_bootstrap_lwe_u64_process ||
+          estimated_blocks(p) * 2 >= sm_count)
+        schedule_kernel(p, loc, nullptr);
+      else
+        spread.push_back(p);
+    }
+    if (spread.size() < 2) {
+      // Nothing to co-schedule on this level.
+      for (auto p : spread)
+        schedule_kernel(p, loc, nullptr);
+      continue;
+    }
+    size_t lanes = (spread.size() < max_concurrent_lanes)
+                       ? spread.size()
+                       : max_concurrent_lanes;
+    std::vector<cudaStream_t *> used;
+    used.push_back((cudaStream_t *)dfg->get_gpu_stream(loc));
+    for (size_t lane = 1; lane < lanes; ++lane)
+      used.push_back((cudaStream_t *)dfg->get_aux_gpu_stream(loc, lane - 1));
+    for (size_t i = 0; i < spread.size(); ++i)
+      schedule_kernel(spread[i], loc, nullptr,
+                      (i % lanes == 0) ? nullptr : (void *)used[i % lanes]);
+    join_streams(used);
+  }
+}
+
 static inline mlir::concretelang::gpu_dfg::Process *
 make_process_1_1(void *dfg, void *sin1, void *sout,
                  void (*fun)(Process *, int32_t, uint64_t *)) {
@@ -803,9 +1940,11 @@ void memref_keyswitch_lwe_u64_process(Process *p, int32_t loc,
       // Schedule the keyswitch kernel on the GPU
       cudaStream_t *s = (cudaStream_t *)p->dfg->get_gpu_stream(loc);
       void *ct0_gpu = d->device_data;
-      void *out_gpu = cuda_malloc_async(data_size, s, loc);
+      void *out_gpu = p->dfg->device_alloc(data_size, s, loc);
       void *ksk_gpu = p->ctx.val->get_ksk_gpu(
           p->level.val, p->input_lwe_dim.val, p->output_lwe_dim.val, loc, s);
+      if (p->dfg->graph_active())
+        p->dfg->graph->note_key(ksk_gpu);
       cuda_keyswitch_lwe_ciphertext_vector_64(
           s, loc, out_gpu, ct0_gpu, ksk_gpu, p->input_lwe_dim.val,
           p->output_lwe_dim.val, p->base_log.val, p->level.val, num_samples);
@@ -829,20 +1968,9 @@ void memref_bootstrap_lwe_u64_process(Process *p, int32_t loc,
   uint64_t glwe_ct_len =
       p->poly_size.val * (p->glwe_dim.val + 1) * num_lut_vectors;
   uint64_t glwe_ct_size = glwe_ct_len * sizeof(uint64_t);
-  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size);
   auto tlu = mtlu.aligned + mtlu.offset;
-  // Glwe trivial encryption
-  size_t pos = 0, postlu = 0;
-  for (size_t l = 0; l < num_lut_vectors; ++l) {
-    for (size_t i = 0; i < p->poly_size.val * p->glwe_dim.val; i++) {
-      glwe_ct[pos++] = 0;
-    }
-    for (size_t i = 0; i < p->poly_size.val; i++) {
-      glwe_ct[pos++] = tlu[postlu++];
-    }
-  }
 
-  auto sched = [&](Dependence *d0, Dependence *d1, uint64_t *glwe_ct,
+  auto sched = [&](Dependence *d0, Dependence *d1,
                    std::vector<size_t> &lut_indexes, cudaStream_t *s,
                    int32_t loc) {
     uint64_t num_samples = d0->host_data.sizes[0];
@@ -890,37 +2018,92 @@ void memref_bootstrap_lwe_u64_process(Process *p, int32_t loc,
             p->ctx.val);
       Dependence *dep =
           new Dependence(loc, out, nullptr, true, true, d0->chunk_id);
-      free(glwe_ct);
       return dep;
     } else {
-      // Schedule the bootstrap kernel on the GPU
-      void *glwe_ct_gpu = cuda_malloc_async(glwe_ct_size, s, loc);
-      cuda_memcpy_async_to_gpu(glwe_ct_gpu, glwe_ct, glwe_ct_size, s, loc);
-      void *test_vector_idxes_gpu =
-          cuda_malloc_async(test_vector_idxes_size, s, loc);
-      cuda_memcpy_async_to_gpu(test_vector_idxes_gpu, (void *)test_vector_idxes,
-                               test_vector_idxes_size, s, loc);
-      int8_t *pbs_buffer = p->dfg->gpus[loc].get_pbs_buffer(
-          p->glwe_dim.val, p->poly_size.val, num_samples);
+      // Schedule the bootstrap kernel on the GPU. A single shared table
+      // comes from the device-resident LUT pool so it is only uploaded on
+      // its first use on this device; mapped per-sample tables are batch
+      // specific and are uploaded per call.
+      void *glwe_ct_gpu;
+      uint64_t *glwe_ct = nullptr;
+      if (p->dfg->graph_active()) {
+        // Pool entries can be evicted under the feet of a recorded
+        // graph, so graph runs upload the table(s) into the graph's
+        // stable buffers instead; replays refresh the staging from the
+        // table input of the invocation at hand.
+        glwe_ct_gpu = p->dfg->graph->claim_upload(
+            Captured_graph::upload_glwe, p->input_streams[1], tlu, glwe_ct_size,
+            s, p->poly_size.val, p->glwe_dim.val, num_lut_vectors);
+      } else if (num_lut_vectors == 1) {
+        glwe_ct_gpu = GPULutPool::instance().get(loc, tlu, p->glwe_dim.val,
+                                                 p->poly_size.val, 1, s);
+      } else {
+        glwe_ct = (uint64_t *)malloc(glwe_ct_size);
+        // Glwe trivial encryption
+        size_t pos = 0, postlu = 0;
+        for (size_t l = 0; l < num_lut_vectors; ++l) {
+          for (size_t i = 0; i < p->poly_size.val * p->glwe_dim.val; i++) {
+            glwe_ct[pos++] = 0;
+          }
+          for (size_t i = 0; i < p->poly_size.val; i++) {
+            glwe_ct[pos++] = tlu[postlu++];
+          }
+        }
+        glwe_ct_gpu = cuda_malloc_async(glwe_ct_size, s, loc);
+        cuda_memcpy_async_to_gpu(glwe_ct_gpu, glwe_ct, glwe_ct_size, s, loc);
+      }
+      void *test_vector_idxes_gpu;
+      if (p->dfg->graph_active()) {
+        // Derived only from the batch shape, which the graph signature
+        // fixes: staged once into the graph, never refreshed.
+        test_vector_idxes_gpu = p->dfg->graph->claim_upload(
+            Captured_graph::upload_fixed, nullptr, test_vector_idxes,
+            test_vector_idxes_size, s);
+      } else {
+        test_vector_idxes_gpu = cuda_malloc_async(test_vector_idxes_size, s,
+                                                  loc);
+        cuda_memcpy_async_to_gpu(test_vector_idxes_gpu,
+                                 (void *)test_vector_idxes,
+                                 test_vector_idxes_size, s, loc);
+      }
+      int8_t *pbs_buffer =
+          p->dfg->graph_active()
+              ? p->dfg->graph->pbs_scratch(s, loc, p->glwe_dim.val,
+                                           p->poly_size.val, p->level.val,
+                                           num_samples)
+              : p->dfg->gpus[loc].get_pbs_buffer(p->glwe_dim.val,
+                                                 p->poly_size.val, p->level.val,
+                                                 num_samples);
       void *ct0_gpu = d0->device_data;
-      void *out_gpu = cuda_malloc_async(data_size, s, loc);
+      void *out_gpu = p->dfg->device_alloc(data_size, s, loc);
       void *fbsk_gpu =
           p->ctx.val->get_bsk_gpu(p->input_lwe_dim.val, p->poly_size.val,
                                   p->level.val, p->glwe_dim.val, loc, s);
-      cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+      if (p->dfg->graph_active())
+        p->dfg->graph->note_key(fbsk_gpu);
+      cuda_bootstrap_dispatch_lwe_ciphertext_vector_64(
           s, loc, out_gpu, glwe_ct_gpu, test_vector_idxes_gpu, ct0_gpu,
           fbsk_gpu, (int8_t *)pbs_buffer, p->input_lwe_dim.val, p->glwe_dim.val,
           p->poly_size.val, p->base_log.val, p->level.val, num_samples,
           lut_indexes.size(), lwe_idx, cuda_get_max_shared_memory(loc));
-      cuda_drop_async(test_vector_idxes_gpu, s, loc);
-      cuda_drop_async(glwe_ct_gpu, s, loc);
       Dependence *dep =
           new Dependence(loc, out, out_gpu, false, false, d0->chunk_id);
-      // As streams are not synchronized, we can only free this vector
-      // after a later synchronization point where we are guaranteed that
-      // this vector is no longer needed.
-      p->dfg->register_stream_order_dependent_allocation(test_vector_idxes);
-      p->dfg->register_stream_order_dependent_allocation(glwe_ct);
+      if (p->dfg->graph_active()) {
+        // The indexes were copied into the graph's staging above and
+        // the slot belongs to the graph; the host copy can go now.
+        free(test_vector_idxes);
+      } else {
+        cuda_drop_async(test_vector_idxes_gpu, s, loc);
+        // As streams are not synchronized, we can only free this vector
+        // after a later synchronization point where we are guaranteed
+        // that this vector is no longer needed.
+        p->dfg->register_stream_order_dependent_allocation(test_vector_idxes);
+      }
+      // Pooled accumulators stay resident on the device
+      if (glwe_ct != nullptr) {
+        cuda_drop_async(glwe_ct_gpu, s, loc);
+        p->dfg->register_stream_order_dependent_allocation(glwe_ct);
+      }
       return dep;
     }
   };
@@ -938,8 +2121,7 @@ void memref_bootstrap_lwe_u64_process(Process *p, int32_t loc,
 
   cudaStream_t *cstream = (cudaStream_t *)p->dfg->get_gpu_stream(loc);
   Dependence *idep0 = p->input_streams[0]->get(loc);
-  p->output_streams[0]->put(
-      sched(idep0, idep1, glwe_ct, lut_indexes, cstream, loc));
+  p->output_streams[0]->put(sched(idep0, idep1, lut_indexes, cstream, loc));
 }
 
 void memref_add_lwe_ciphertexts_u64_process(Process *p, int32_t loc,
@@ -975,7 +2157,7 @@ void memref_add_lwe_ciphertexts_u64_process(Process *p, int32_t loc,
       return dep;
     } else {
       // Schedule the kernel on the GPU
-      void *out_gpu = cuda_malloc_async(data_size, s, loc);
+      void *out_gpu = p->dfg->device_alloc(data_size, s, loc);
       cuda_add_lwe_ciphertext_vector_64(
           s, loc, out_gpu, d0->device_data, d1->device_data,
           d0->host_data.sizes[1] - 1, num_samples);
@@ -1030,7 +2212,7 @@ void memref_add_plaintext_lwe_ciphertext_u64_process(Process *p, int32_t loc,
       return dep;
     } else {
       // Schedule the kernel on the GPU
-      void *out_gpu = cuda_malloc_async(data_size, s, loc);
+      void *out_gpu = p->dfg->device_alloc(data_size, s, loc);
       cuda_add_lwe_ciphertext_vector_plaintext_vector_64(
           s, loc, out_gpu, d0->device_data, d1->device_data,
           d0->host_data.sizes[1] - 1, num_samples);
@@ -1085,7 +2267,7 @@ void memref_mul_cleartext_lwe_ciphertext_u64_process(Process *p, int32_t loc,
       return dep;
     } else {
       // Schedule the keyswitch kernel on the GPU
-      void *out_gpu = cuda_malloc_async(data_size, s, loc);
+      void *out_gpu = p->dfg->device_alloc(data_size, s, loc);
       cuda_mult_lwe_ciphertext_vector_cleartext_vector_64(
           s, loc, out_gpu, d0->device_data, d1->device_data,
           d0->host_data.sizes[1] - 1, num_samples);
@@ -1125,7 +2307,7 @@ void memref_negate_lwe_ciphertext_u64_process(Process *p, int32_t loc,
       return dep;
     } else {
       // Schedule the kernel on the GPU
-      void *out_gpu = cuda_malloc_async(data_size, s, loc);
+      void *out_gpu = p->dfg->device_alloc(data_size, s, loc);
       cuda_negate_lwe_ciphertext_vector_64(s, loc, out_gpu, d0->device_data,
                                            d0->host_data.sizes[1] - 1,
                                            num_samples);
@@ -1195,6 +2377,12 @@ void stream_emulator_make_memref_keyswitch_lwe_u64_process(
   p->sk_index.val = ksk_index;
   p->output_size.val = output_size;
   p->ctx.val = (RuntimeContext *)context;
+  // Kick off the key upload at graph construction time so the key is
+  // device resident before the circuit starts executing. The residency
+  // manager makes this a no-op when the key is already on the device.
+  for (uint32_t i = 0; i < num_devices; ++i)
+    p->ctx.val->get_ksk_gpu(level, input_lwe_dim, output_lwe_dim, i,
+                            p->dfg->get_gpu_stream(i));
   static int count = 0;
   sprintf(p->name, "keyswitch_%d", count++);
 }
@@ -1215,6 +2403,11 @@ void stream_emulator_make_memref_bootstrap_lwe_u64_process(
   p->sk_index.val = bsk_index;
   p->output_size.val = output_size;
   p->ctx.val = (RuntimeContext *)context;
+  // Prefetch the (converted) bootstrap key to the devices at graph
+  // construction time; a no-op when the key is already resident.
+  for (uint32_t i = 0; i < num_devices; ++i)
+    p->ctx.val->get_bsk_gpu(input_lwe_dim, poly_size, level, glwe_dim, i,
+                            p->dfg->get_gpu_stream(i));
   static int count = 0;
   sprintf(p->name, "bootstrap_%d", count++);
 }
@@ -1429,8 +2622,65 @@ void *stream_emulator_init() {
                          !strncmp(env, "0", 1))) {
     dont_distribute_batched_ops = true;
   }
+  env = getenv("SDFG_MIN_SAMPLES_PER_GPU_CHUNK");
+  if (env != nullptr) {
+    size_t requested = strtoul(env, NULL, 10);
+    if (requested > 0)
+      min_samples_per_gpu_chunk = requested;
+  }
+  env = getenv("SDFG_MAX_STREAMS_PER_GPU");
+  if (env != nullptr) {
+    size_t requested = strtoul(env, NULL, 10);
+    if (requested > 0)
+      max_streams_per_gpu = requested;
+  }
+  env = getenv("SDFG_ADAPTIVE_CHUNKING");
+  if (env != nullptr && (!strncmp(env, "off", 3) || !strncmp(env, "OFF", 3) ||
+                         !strncmp(env, "0", 1))) {
+    adaptive_chunking = false;
+  }
+  env = getenv("SDFG_CONCURRENT_KERNELS");
+  if (env != nullptr && (!strncmp(env, "off", 3) || !strncmp(env, "OFF", 3) ||
+                         !strncmp(env, "0", 1))) {
+    concurrent_kernels = false;
+  }
+  env = getenv("SDFG_CUDA_GRAPHS");
+  if (env != nullptr && (!strncmp(env, "off", 3) || !strncmp(env, "OFF", 3) ||
+                         !strncmp(env, "0", 1))) {
+    use_cuda_graphs = false;
+  }
   assert(num_devices > 0 && "No GPUs available on system.");
 
+  auto &sm_counts = device_sm_counts();
+  if (sm_counts.empty()) {
+    for (size_t i = 0; i < num_devices; ++i) {
+      int sm = 0;
+      cudaDeviceGetAttribute(&sm, cudaDevAttrMultiProcessorCount, i);
+      sm_counts.push_back(sm > 0 ? sm : 1);
+    }
+  }
+
+  // Cap the PBS scratch the broker keeps resident per device: a quarter
+  // of device memory by default, SDFG_MAX_SCRATCH_PER_GPU bytes when
+  // set, 0 to disable trimming.
+  auto &scratch_limits = device_scratch_limits();
+  if (scratch_limits.empty()) {
+    env = getenv("SDFG_MAX_SCRATCH_PER_GPU");
+    int prev_device;
+    cudaGetDevice(&prev_device);
+    for (size_t i = 0; i < num_devices; ++i) {
+      if (env != nullptr) {
+        scratch_limits.push_back(strtoull(env, NULL, 10));
+        continue;
+      }
+      size_t free_mem = 0, total_mem = 0;
+      cudaSetDevice(i);
+      cudaMemGetInfo(&free_mem, &total_mem);
+      scratch_limits.push_back(total_mem / 4);
+    }
+    cudaSetDevice(prev_device);
+  }
+
   hwloc_topology_t topology;
   hwloc_topology_init(&topology);
   hwloc_topology_set_all_types_filter(topology, HWLOC_TYPE_FILTER_KEEP_NONE);
@@ -1449,4 +2699,7 @@ void *stream_emulator_init() {
 }
 void stream_emulator_run(void *dfg) {}
 void stream_emulator_delete(void *dfg) { delete (GPU_DFG *)dfg; }
+void stream_emulator_set_invocation_priority(int priority) {
+  invocation_priority = priority;
+}
 #endif
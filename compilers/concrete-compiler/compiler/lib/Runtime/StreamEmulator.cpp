@@ -3,18 +3,21 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdarg>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
 #include <queue>
+#include <set>
 #include <thread>
 #include <utility>
 #include <vector>
 
-#include <sched.h>
-
 #include <concretelang/ClientLib/Types.h>
 #include <concretelang/Runtime/stream_emulator_api.h>
 #include <concretelang/Runtime/wrappers.h>
@@ -26,16 +29,42 @@ namespace concretelang {
 namespace stream_emulator {
 namespace {
 
+/// Bound on the number of in-flight elements between two processes. A
+/// process only fires when all of its output streams have room, so faster
+/// upstream stages cannot run arbitrarily far ahead of their consumers.
+constexpr size_t stream_capacity = 64;
+
+/// One scheduler lock protects every stream of the graph and the firing
+/// state of the processes. Critical sections only push/pop queue elements
+/// and flip flags; the process bodies themselves run outside the lock.
+std::mutex sched_mutex;
+std::condition_variable sched_cv;
+
 template <typename T> struct StreamBase {
-  void put(T e) { q.push(e); }
+  void put(T e) {
+    {
+      const std::lock_guard<std::mutex> guard(sched_mutex);
+      q.push(e);
+    }
+    sched_cv.notify_all();
+  }
   T get() {
-    while (q.empty())
-      sched_yield();
+    std::unique_lock<std::mutex> lock(sched_mutex);
+    sched_cv.wait(lock, [this]() { return !q.empty(); });
     T ret = q.front();
     q.pop();
+    lock.unlock();
+    // Popping may unblock a producer waiting on output room.
+    sched_cv.notify_all();
     return ret;
   }
-  bool empty() { return q.empty(); }
+  // Readiness checks used by the scheduler, called with sched_mutex held.
+  bool hasData() const { return !q.empty(); }
+  bool hasRoom() const { return q.size() < stream_capacity; }
+
+  /// Edge kind recorded at creation; on-device streams are exactly the
+  /// process-to-process edges and are the only fusion candidates.
+  stream_type kind = TS_STREAM_TYPE_X86_TO_X86_LSAP;
 
 private:
   std::queue<T> q;
@@ -43,9 +72,11 @@ private:
 union Stream {
   StreamBase<uint64_t> *uint64_stream;
   StreamBase<MemRefDescriptor<1>> *memref_stream;
+  StreamBase<MemRefDescriptor<2>> *batch_stream;
 
   Stream(StreamBase<uint64_t> *s) : uint64_stream(s) {}
   Stream(StreamBase<MemRefDescriptor<1>> *s) : memref_stream(s) {}
+  Stream(StreamBase<MemRefDescriptor<2>> *s) : batch_stream(s) {}
 };
 
 struct Void {};
@@ -58,10 +89,37 @@ union Context {
   mlir::concretelang::RuntimeContext *val;
 };
 struct Process {
-  void terminate() { terminate_p = true; }
-  bool terminate_p = false;
+  /// A process can fire when every input stream has an element pending and
+  /// every output stream has room for the result. Checked with sched_mutex
+  /// held through the type-aware closures built alongside the streams.
+  bool fireable() {
+    for (auto &ready : inputs_ready)
+      if (!ready())
+        return false;
+    for (auto &room : outputs_have_room)
+      if (!room())
+        return false;
+    return true;
+  }
+  /// Set while a worker executes one firing, so a process runs at most one
+  /// firing at a time and its streams keep FIFO order.
+  bool running = false;
+  /// Levelled processes are cheap relative to the scheduling cost of a
+  /// firing; linear chains of them get merged into one process before
+  /// execution starts.
+  bool fusable = false;
+  /// Member processes of a fused chain, executed back to back by a single
+  /// firing; empty for ordinary processes.
+  std::vector<Process *> fused_chain;
   std::vector<Stream> input_streams;
   std::vector<Stream> output_streams;
+  /// Raw stream pointers, used as edge identities when matching producers
+  /// to consumers for fusion.
+  std::vector<void *> input_ids;
+  std::vector<void *> output_ids;
+  std::vector<stream_type> output_kinds;
+  std::vector<std::function<bool()>> inputs_ready;
+  std::vector<std::function<bool()>> outputs_have_room;
   Param level;
   Param base_log;
   Param input_lwe_dim;
@@ -76,125 +134,385 @@ struct Process {
   void (*fun)(Process *);
 };
 
+void fused_chain_process(Process *p);
+
+/// Multithreaded SDFG executor: a fixed pool of workers shares the
+/// processes of the graph. Each worker scans for a fireable process
+/// (starting at its own offset so workers spread over different stages),
+/// claims it, executes one firing outside the scheduler lock, and goes back
+/// to scanning. Keyswitch and bootstrap firings of different ciphertexts
+/// thereby overlap across cores instead of executing inline.
 struct DFGraph {
   ~DFGraph() {
-    for (auto p : dfg_processes)
-      p->terminate();
-  }
-  void run() {
+    {
+      const std::lock_guard<std::mutex> guard(sched_mutex);
+      stopped = true;
+    }
+    sched_cv.notify_all();
+    for (auto &worker : workers)
+      worker.join();
     for (auto p : dfg_processes) {
-      std::thread process_thread(p->fun, p);
-      process_thread.detach();
+      for (auto m : p->fused_chain)
+        delete m;
+      delete p;
     }
   }
+  void run() {
+    if (!workers.empty())
+      return;
+    fuse_linear_chains();
+    size_t num_workers = std::thread::hardware_concurrency();
+    if (num_workers < 1)
+      num_workers = 1;
+    num_workers = std::min(num_workers, dfg_processes.size());
+    for (size_t i = 0; i < num_workers; i++)
+      workers.push_back(std::thread([this, i]() { worker(i); }));
+  }
   std::vector<Process *> dfg_processes;
+
+private:
+  /// Merges linear chains of levelled processes into single processes.
+  /// Chained levelled ops otherwise become strings of tiny firings each
+  /// paying a scheduler round trip that dwarfs the operation itself. A
+  /// chain link is an on-device stream with exactly one producer and one
+  /// consumer, both marked fusable; the fused process fires when the
+  /// external inputs of the whole chain are ready, runs the member bodies
+  /// back to back on one worker and only exposes the chain's external
+  /// streams to the scheduler.
+  void fuse_linear_chains() {
+    std::map<void *, size_t> producer_count;
+    std::map<void *, std::pair<Process *, size_t>> consumer;
+    for (Process *p : dfg_processes) {
+      for (void *id : p->output_ids)
+        producer_count[id]++;
+      for (void *id : p->input_ids) {
+        consumer[id].first = p;
+        consumer[id].second++;
+      }
+    }
+    std::map<Process *, Process *> next;
+    std::set<Process *> has_prev;
+    for (Process *a : dfg_processes) {
+      if (!a->fusable || a->output_ids.size() != 1 ||
+          a->output_kinds[0] != TS_STREAM_TYPE_TOPO_TO_TOPO_LSAP)
+        continue;
+      void *edge = a->output_ids[0];
+      if (producer_count[edge] != 1)
+        continue;
+      auto c = consumer.find(edge);
+      if (c == consumer.end() || c->second.second != 1)
+        continue;
+      Process *b = c->second.first;
+      if (!b->fusable || b == a)
+        continue;
+      next[a] = b;
+      has_prev.insert(b);
+    }
+    if (next.empty())
+      return;
+    std::vector<Process *> fused_graph;
+    std::set<Process *> chain_members;
+    for (Process *head : dfg_processes) {
+      if (has_prev.count(head) != 0 || next.count(head) == 0)
+        continue;
+      Process *f = new Process;
+      f->fun = fused_chain_process;
+      Process *m = head;
+      // Stream feeding `m` from its predecessor in the chain; its
+      // readiness is internal to the fused firing and hidden from the
+      // scheduler, as is the room of every non-final output.
+      void *edge = nullptr;
+      while (true) {
+        f->fused_chain.push_back(m);
+        chain_members.insert(m);
+        for (size_t i = 0; i < m->input_ids.size(); i++)
+          if (m->input_ids[i] != edge)
+            f->inputs_ready.push_back(m->inputs_ready[i]);
+        auto n = next.find(m);
+        if (n == next.end()) {
+          for (auto &room : m->outputs_have_room)
+            f->outputs_have_room.push_back(room);
+          break;
+        }
+        edge = m->output_ids[0];
+        m = n->second;
+      }
+      fused_graph.push_back(f);
+    }
+    for (Process *p : dfg_processes)
+      if (chain_members.count(p) == 0)
+        fused_graph.push_back(p);
+    dfg_processes = std::move(fused_graph);
+  }
+
+  void worker(size_t id) {
+    std::unique_lock<std::mutex> lock(sched_mutex);
+    while (!stopped) {
+      Process *fired = nullptr;
+      for (size_t i = 0; i < dfg_processes.size(); i++) {
+        Process *p = dfg_processes[(id + i) % dfg_processes.size()];
+        if (!p->running && p->fireable()) {
+          p->running = true;
+          fired = p;
+          break;
+        }
+      }
+      if (fired == nullptr) {
+        sched_cv.wait(lock);
+        continue;
+      }
+      lock.unlock();
+      fired->fun(fired);
+      lock.lock();
+      fired->running = false;
+      // The firing produced data and freed input room: wake consumers,
+      // producers and idle workers alike.
+      sched_cv.notify_all();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  bool stopped = false;
 };
 
-// Stream emulator processes
+// Stream emulator processes. Each function executes one firing: inputs are
+// guaranteed present and outputs guaranteed to have room by the scheduler.
 void memref_keyswitch_lwe_u64_process(Process *p) {
-  while (!p->terminate_p) {
-    MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
-    MemRefDescriptor<1> out;
-    out.sizes[0] = p->output_size.val;
-    out.strides[0] = 1;
-    out.offset = 0;
-    out.allocated = out.aligned =
-        (uint64_t *)malloc(out.sizes[0] * sizeof(uint64_t));
-    memref_keyswitch_lwe_u64(
-        out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
-        ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
-        p->level.val, p->base_log.val, p->input_lwe_dim.val,
-        p->output_lwe_dim.val, p->ksk_index.val, p->ctx.val);
-    (p->output_streams[0]).memref_stream->put(out);
-  }
-  delete p;
+  MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
+  MemRefDescriptor<1> out;
+  out.sizes[0] = p->output_size.val;
+  out.strides[0] = 1;
+  out.offset = 0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(out.sizes[0] * sizeof(uint64_t));
+  memref_keyswitch_lwe_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
+      ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
+      p->level.val, p->base_log.val, p->input_lwe_dim.val,
+      p->output_lwe_dim.val, p->ksk_index.val, p->ctx.val);
+  (p->output_streams[0]).memref_stream->put(out);
 }
 
 void memref_bootstrap_lwe_u64_process(Process *p) {
-  while (!p->terminate_p) {
-    MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
-    MemRefDescriptor<1> tlu = (p->input_streams[1]).memref_stream->get();
-    MemRefDescriptor<1> out;
-    out.sizes[0] = p->output_size.val;
-    out.strides[0] = 1;
-    out.offset = 0;
-    out.allocated = out.aligned =
-        (uint64_t *)malloc(out.sizes[0] * sizeof(uint64_t));
-    memref_bootstrap_lwe_u64(
-        out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
-        ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
-        tlu.allocated, tlu.aligned, tlu.offset, tlu.sizes[0], tlu.strides[0],
-        p->input_lwe_dim.val, p->poly_size.val, p->level.val, p->base_log.val,
-        p->glwe_dim.val, p->bsk_index.val, p->ctx.val);
-    (p->output_streams[0]).memref_stream->put(out);
-  }
-  delete p;
+  MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
+  MemRefDescriptor<1> tlu = (p->input_streams[1]).memref_stream->get();
+  MemRefDescriptor<1> out;
+  out.sizes[0] = p->output_size.val;
+  out.strides[0] = 1;
+  out.offset = 0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(out.sizes[0] * sizeof(uint64_t));
+  memref_bootstrap_lwe_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
+      ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
+      tlu.allocated, tlu.aligned, tlu.offset, tlu.sizes[0], tlu.strides[0],
+      p->input_lwe_dim.val, p->poly_size.val, p->level.val, p->base_log.val,
+      p->glwe_dim.val, p->bsk_index.val, p->ctx.val);
+  (p->output_streams[0]).memref_stream->put(out);
 }
 
 void memref_add_lwe_ciphertexts_u64_process(Process *p) {
-  while (!p->terminate_p) {
-    MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
-    MemRefDescriptor<1> ct1 = (p->input_streams[1]).memref_stream->get();
-    MemRefDescriptor<1> out = ct0;
-    out.allocated = out.aligned =
-        (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
-    out.offset = 0;
-    memref_add_lwe_ciphertexts_u64(
-        out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
-        ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
-        ct1.allocated, ct1.aligned, ct1.offset, ct1.sizes[0], ct1.strides[0]);
-    (p->output_streams[0]).memref_stream->put(out);
-  }
-  delete p;
+  MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
+  MemRefDescriptor<1> ct1 = (p->input_streams[1]).memref_stream->get();
+  MemRefDescriptor<1> out = ct0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
+  out.offset = 0;
+  memref_add_lwe_ciphertexts_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
+      ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
+      ct1.allocated, ct1.aligned, ct1.offset, ct1.sizes[0], ct1.strides[0]);
+  (p->output_streams[0]).memref_stream->put(out);
 }
 
 void memref_add_plaintext_lwe_ciphertext_u64_process(Process *p) {
-  while (!p->terminate_p) {
-    MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
-    uint64_t plaintext = (p->input_streams[1]).uint64_stream->get();
-    MemRefDescriptor<1> out = ct0;
-    out.allocated = out.aligned =
-        (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
-    out.offset = 0;
-    memref_add_plaintext_lwe_ciphertext_u64(
-        out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
-        ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
-        plaintext);
-    (p->output_streams[0]).memref_stream->put(out);
-  }
-  delete p;
+  MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
+  uint64_t plaintext = (p->input_streams[1]).uint64_stream->get();
+  MemRefDescriptor<1> out = ct0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
+  out.offset = 0;
+  memref_add_plaintext_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
+      ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
+      plaintext);
+  (p->output_streams[0]).memref_stream->put(out);
 }
 
 void memref_mul_cleartext_lwe_ciphertext_u64_process(Process *p) {
-  while (!p->terminate_p) {
-    MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
-    uint64_t cleartext = (p->input_streams[1]).uint64_stream->get();
-    MemRefDescriptor<1> out = ct0;
-    out.allocated = out.aligned =
-        (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
-    out.offset = 0;
-    memref_mul_cleartext_lwe_ciphertext_u64(
-        out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
-        ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
-        cleartext);
-    (p->output_streams[0]).memref_stream->put(out);
-  }
-  delete p;
+  MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
+  uint64_t cleartext = (p->input_streams[1]).uint64_stream->get();
+  MemRefDescriptor<1> out = ct0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
+  out.offset = 0;
+  memref_mul_cleartext_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
+      ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0],
+      cleartext);
+  (p->output_streams[0]).memref_stream->put(out);
 }
 
 void memref_negate_lwe_ciphertext_u64_process(Process *p) {
-  while (!p->terminate_p) {
-    MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
-    MemRefDescriptor<1> out = ct0;
-    out.allocated = out.aligned =
-        (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
-    out.offset = 0;
-    memref_negate_lwe_ciphertext_u64(
-        out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
-        ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0]);
-    (p->output_streams[0]).memref_stream->put(out);
-  }
-  delete p;
+  MemRefDescriptor<1> ct0 = (p->input_streams[0]).memref_stream->get();
+  MemRefDescriptor<1> out = ct0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(ct0.sizes[0] * sizeof(uint64_t));
+  out.offset = 0;
+  memref_negate_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.strides[0],
+      ct0.allocated, ct0.aligned, ct0.offset, ct0.sizes[0], ct0.strides[0]);
+  (p->output_streams[0]).memref_stream->put(out);
+}
+
+// Batched process bodies: one firing consumes and produces a whole
+// batch, so the per-call amortization of the memref_batched_* wrappers
+// carries over to the SDFG path instead of decaying into element-wise
+// firings.
+MemRefDescriptor<2> alloc_batch_like(uint64_t batch_size, uint64_t lwe_size) {
+  MemRefDescriptor<2> out;
+  out.sizes[0] = batch_size;
+  out.sizes[1] = lwe_size;
+  out.strides[0] = lwe_size;
+  out.strides[1] = 1;
+  out.offset = 0;
+  out.allocated = out.aligned =
+      (uint64_t *)malloc(batch_size * lwe_size * sizeof(uint64_t));
+  return out;
+}
+
+void memref_batched_keyswitch_lwe_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], p->output_size.val);
+  memref_batched_keyswitch_lwe_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1], p->level.val,
+      p->base_log.val, p->input_lwe_dim.val, p->output_lwe_dim.val,
+      p->ksk_index.val, p->ctx.val);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_bootstrap_lwe_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<1> tlu = (p->input_streams[1]).memref_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], p->output_size.val);
+  memref_batched_bootstrap_lwe_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1],
+      tlu.allocated, tlu.aligned, tlu.offset, tlu.sizes[0], tlu.strides[0],
+      p->input_lwe_dim.val, p->poly_size.val, p->level.val, p->base_log.val,
+      p->glwe_dim.val, p->bsk_index.val, p->ctx.val);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_mapped_bootstrap_lwe_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<2> tlu = (p->input_streams[1]).batch_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], p->output_size.val);
+  memref_batched_mapped_bootstrap_lwe_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1],
+      tlu.allocated, tlu.aligned, tlu.offset, tlu.sizes[0], tlu.sizes[1],
+      tlu.strides[0], tlu.strides[1], p->input_lwe_dim.val, p->poly_size.val,
+      p->level.val, p->base_log.val, p->glwe_dim.val, p->bsk_index.val,
+      p->ctx.val);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_add_lwe_ciphertexts_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<2> ct1 = (p->input_streams[1]).batch_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], ct0.sizes[1]);
+  memref_batched_add_lwe_ciphertexts_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1],
+      ct1.allocated, ct1.aligned, ct1.offset, ct1.sizes[0], ct1.sizes[1],
+      ct1.strides[0], ct1.strides[1]);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_add_plaintext_lwe_ciphertext_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<1> pts = (p->input_streams[1]).memref_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], ct0.sizes[1]);
+  memref_batched_add_plaintext_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1],
+      pts.allocated, pts.aligned, pts.offset, pts.sizes[0], pts.strides[0]);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_add_plaintext_cst_lwe_ciphertext_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  uint64_t plaintext = (p->input_streams[1]).uint64_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], ct0.sizes[1]);
+  memref_batched_add_plaintext_cst_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1], plaintext);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_mul_cleartext_lwe_ciphertext_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<1> cts = (p->input_streams[1]).memref_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], ct0.sizes[1]);
+  memref_batched_mul_cleartext_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1],
+      cts.allocated, cts.aligned, cts.offset, cts.sizes[0], cts.strides[0]);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_mul_cleartext_cst_lwe_ciphertext_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  uint64_t cleartext = (p->input_streams[1]).uint64_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], ct0.sizes[1]);
+  memref_batched_mul_cleartext_cst_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1], cleartext);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+void memref_batched_negate_lwe_ciphertext_u64_process(Process *p) {
+  MemRefDescriptor<2> ct0 = (p->input_streams[0]).batch_stream->get();
+  MemRefDescriptor<2> out = alloc_batch_like(ct0.sizes[0], ct0.sizes[1]);
+  memref_batched_negate_lwe_ciphertext_u64(
+      out.allocated, out.aligned, out.offset, out.sizes[0], out.sizes[1],
+      out.strides[0], out.strides[1], ct0.allocated, ct0.aligned, ct0.offset,
+      ct0.sizes[0], ct0.sizes[1], ct0.strides[0], ct0.strides[1]);
+  (p->output_streams[0]).batch_stream->put(out);
+}
+
+// Executes the member firings of a fused chain back to back. Elements
+// still transit the intermediate queues, but within one firing on one
+// worker, without scheduler scans or handoffs between the members.
+void fused_chain_process(Process *p) {
+  for (Process *m : p->fused_chain)
+    m->fun(m);
+}
+
+// Record a stream on a process together with the type-aware readiness
+// closures the scheduler uses to decide whether the process can fire.
+template <typename T>
+void add_input_stream(Process *p, StreamBase<T> *stream) {
+  p->input_streams.push_back(stream);
+  p->input_ids.push_back(stream);
+  p->inputs_ready.push_back([stream]() { return stream->hasData(); });
+}
+template <typename T>
+void add_output_stream(Process *p, StreamBase<T> *stream) {
+  p->output_streams.push_back(stream);
+  p->output_ids.push_back(stream);
+  p->output_kinds.push_back(stream->kind);
+  p->outputs_have_room.push_back([stream]() { return stream->hasRoom(); });
 }
 
 } // namespace
@@ -209,15 +527,19 @@ void stream_emulator_make_memref_add_lwe_ciphertexts_u64_process(void *dfg,
                                                                  void *sout) {
   mlir::concretelang::stream_emulator::Process *p =
       new mlir::concretelang::stream_emulator::Process;
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin1);
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin2);
-  p->output_streams.push_back(
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sout);
+  p->fusable = true;
   p->fun = mlir::concretelang::stream_emulator::
       memref_add_lwe_ciphertexts_u64_process;
   ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
@@ -228,14 +550,17 @@ void stream_emulator_make_memref_add_plaintext_lwe_ciphertext_u64_process(
     void *dfg, void *sin1, void *sin2, void *sout) {
   mlir::concretelang::stream_emulator::Process *p =
       new mlir::concretelang::stream_emulator::Process;
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin1);
-  p->input_streams.push_back(
-      (mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)sin2);
-  p->output_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p, (mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sout);
+  p->fusable = true;
   p->fun = mlir::concretelang::stream_emulator::
       memref_add_plaintext_lwe_ciphertext_u64_process;
   ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
@@ -246,14 +571,17 @@ void stream_emulator_make_memref_mul_cleartext_lwe_ciphertext_u64_process(
     void *dfg, void *sin1, void *sin2, void *sout) {
   mlir::concretelang::stream_emulator::Process *p =
       new mlir::concretelang::stream_emulator::Process;
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin1);
-  p->input_streams.push_back(
-      (mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)sin2);
-  p->output_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p, (mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sout);
+  p->fusable = true;
   p->fun = mlir::concretelang::stream_emulator::
       memref_mul_cleartext_lwe_ciphertext_u64_process;
   ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
@@ -265,12 +593,15 @@ void stream_emulator_make_memref_negate_lwe_ciphertext_u64_process(void *dfg,
                                                                    void *sout) {
   mlir::concretelang::stream_emulator::Process *p =
       new mlir::concretelang::stream_emulator::Process;
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin1);
-  p->output_streams.push_back(
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sout);
+  p->fusable = true;
   p->fun = mlir::concretelang::stream_emulator::
       memref_negate_lwe_ciphertext_u64_process;
   ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
@@ -283,10 +614,12 @@ void stream_emulator_make_memref_keyswitch_lwe_u64_process(
     uint32_t ksk_index, void *context) {
   mlir::concretelang::stream_emulator::Process *p =
       new mlir::concretelang::stream_emulator::Process;
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin1);
-  p->output_streams.push_back(
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sout);
   p->level.val = level;
@@ -308,13 +641,16 @@ void stream_emulator_make_memref_bootstrap_lwe_u64_process(
     uint32_t output_size, uint32_t bsk_index, void *context) {
   mlir::concretelang::stream_emulator::Process *p =
       new mlir::concretelang::stream_emulator::Process;
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin1);
-  p->input_streams.push_back(
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sin2);
-  p->output_streams.push_back(
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
       (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
           sout);
   p->input_lwe_dim.val = input_lwe_dim;
@@ -331,8 +667,231 @@ void stream_emulator_make_memref_bootstrap_lwe_u64_process(
       ->dfg_processes.push_back(p);
 }
 
+void stream_emulator_make_memref_batched_add_lwe_ciphertexts_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->fusable = true;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_add_lwe_ciphertexts_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_add_plaintext_lwe_ciphertext_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
+          sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->fusable = true;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_add_plaintext_lwe_ciphertext_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_add_plaintext_cst_lwe_ciphertext_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p, (mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->fusable = true;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_add_plaintext_cst_lwe_ciphertext_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_mul_cleartext_lwe_ciphertext_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
+          sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->fusable = true;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_mul_cleartext_lwe_ciphertext_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_mul_cleartext_cst_lwe_ciphertext_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p, (mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->fusable = true;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_mul_cleartext_cst_lwe_ciphertext_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_negate_lwe_ciphertext_u64_process(
+    void *dfg, void *sin1, void *sout) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->fusable = true;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_negate_lwe_ciphertext_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_keyswitch_lwe_u64_process(
+    void *dfg, void *sin1, void *sout, uint32_t level, uint32_t base_log,
+    uint32_t input_lwe_dim, uint32_t output_lwe_dim, uint32_t output_size,
+    uint32_t ksk_index, void *context) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->level.val = level;
+  p->base_log.val = base_log;
+  p->input_lwe_dim.val = input_lwe_dim;
+  p->output_lwe_dim.val = output_lwe_dim;
+  p->output_size.val = output_size;
+  p->ksk_index.val = ksk_index;
+  p->ctx.val = (mlir::concretelang::RuntimeContext *)context;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_keyswitch_lwe_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_bootstrap_lwe_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout, uint32_t input_lwe_dim,
+    uint32_t poly_size, uint32_t level, uint32_t base_log, uint32_t glwe_dim,
+    uint32_t output_size, uint32_t bsk_index, void *context) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<1>> *)
+          sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->input_lwe_dim.val = input_lwe_dim;
+  p->poly_size.val = poly_size;
+  p->level.val = level;
+  p->base_log.val = base_log;
+  p->glwe_dim.val = glwe_dim;
+  p->output_size.val = output_size;
+  p->bsk_index.val = bsk_index;
+  p->ctx.val = (mlir::concretelang::RuntimeContext *)context;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_bootstrap_lwe_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
+void stream_emulator_make_memref_batched_mapped_bootstrap_lwe_u64_process(
+    void *dfg, void *sin1, void *sin2, void *sout, uint32_t input_lwe_dim,
+    uint32_t poly_size, uint32_t level, uint32_t base_log, uint32_t glwe_dim,
+    uint32_t output_size, uint32_t bsk_index, void *context) {
+  mlir::concretelang::stream_emulator::Process *p =
+      new mlir::concretelang::stream_emulator::Process;
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin1);
+  mlir::concretelang::stream_emulator::add_input_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sin2);
+  mlir::concretelang::stream_emulator::add_output_stream(
+      p,
+      (mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+          sout);
+  p->input_lwe_dim.val = input_lwe_dim;
+  p->poly_size.val = poly_size;
+  p->level.val = level;
+  p->base_log.val = base_log;
+  p->glwe_dim.val = glwe_dim;
+  p->output_size.val = output_size;
+  p->bsk_index.val = bsk_index;
+  p->ctx.val = (mlir::concretelang::RuntimeContext *)context;
+  p->fun = mlir::concretelang::stream_emulator::
+      memref_batched_mapped_bootstrap_lwe_u64_process;
+  ((mlir::concretelang::stream_emulator::DFGraph *)dfg)
+      ->dfg_processes.push_back(p);
+}
+
 void *stream_emulator_make_uint64_stream(const char *name, stream_type stype) {
-  return (void *)new mlir::concretelang::stream_emulator::StreamBase<uint64_t>;
+  auto *s = new mlir::concretelang::stream_emulator::StreamBase<uint64_t>;
+  s->kind = stype;
+  return (void *)s;
 }
 void stream_emulator_put_uint64(void *stream, uint64_t e) {
   ((mlir::concretelang::stream_emulator::StreamBase<uint64_t> *)stream)->put(e);
@@ -343,8 +902,10 @@ uint64_t stream_emulator_get_uint64(void *stream) {
 }
 
 void *stream_emulator_make_memref_stream(const char *name, stream_type stype) {
-  return (void *)new mlir::concretelang::stream_emulator::StreamBase<
+  auto *s = new mlir::concretelang::stream_emulator::StreamBase<
       MemRefDescriptor<1>>;
+  s->kind = stype;
+  return (void *)s;
 }
 void stream_emulator_put_memref(void *stream, uint64_t *allocated,
                                 uint64_t *aligned, uint64_t offset,
@@ -368,20 +929,36 @@ void stream_emulator_get_memref(void *stream, uint64_t *out_allocated,
 
 void *stream_emulator_make_memref_batch_stream(const char *name,
                                                stream_type stype) {
-  assert(0 && "Batched operations not implemented in the StreamEmulator.");
+  auto *s = new mlir::concretelang::stream_emulator::StreamBase<
+      MemRefDescriptor<2>>;
+  s->kind = stype;
+  return (void *)s;
 }
 void stream_emulator_put_memref_batch(void *stream, uint64_t *allocated,
                                       uint64_t *aligned, uint64_t offset,
                                       uint64_t size0, uint64_t size1,
                                       uint64_t stride0, uint64_t stride1) {
-  assert(0 && "Batched operations not implemented in the StreamEmulator.");
+  ((mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+       stream)
+      ->put({allocated, aligned, offset, {size0, size1}, {stride0, stride1}});
 }
 void stream_emulator_get_memref_batch(void *stream, uint64_t *out_allocated,
                                       uint64_t *out_aligned,
                                       uint64_t out_offset, uint64_t out_size0,
                                       uint64_t out_size1, uint64_t out_stride0,
                                       uint64_t out_stride1) {
-  assert(0 && "Batched operations not implemented in the StreamEmulator.");
+  MemRefDescriptor<2> mref =
+      ((mlir::concretelang::stream_emulator::StreamBase<MemRefDescriptor<2>> *)
+           stream)
+          ->get();
+  assert(mref.sizes[0] == out_size0 && mref.sizes[1] == out_size1 &&
+         "batch stream element does not match the destination shape");
+  for (uint64_t i = 0; i < out_size0; i++)
+    memref_copy_one_rank(mref.allocated, mref.aligned,
+                         mref.offset + i * mref.strides[0], mref.sizes[1],
+                         mref.strides[1], out_allocated, out_aligned,
+                         out_offset + i * out_stride0, out_size1, out_stride1);
+  free(mref.allocated);
 }
 
 void *stream_emulator_init() {
@@ -410,3 +987,7 @@ void stream_emulator_delete(void *dfg) {
   delete ((mlir::concretelang::stream_emulator::DFGraph *)dfg);
 #endif
 }
+
+// Priority classes only matter to the GPU backend; the emulator's
+// workers share all processes of the graph alike.
+void stream_emulator_set_invocation_priority(int priority) {}
@@ -5,8 +5,14 @@
 
 #include "concretelang/Runtime/context.h"
 #include "concretelang/Common/Error.h"
+#ifdef CONCRETELANG_CUDA_SUPPORT
+#include "concretelang/ClientLib/Serializers.h"
+#endif
+#include <algorithm>
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <thread>
 
 namespace clientlib = ::concretelang::clientlib;
 namespace mlir {
@@ -29,7 +35,22 @@ FFT::~FFT() {
   }
 }
 
-RuntimeContext::RuntimeContext(clientlib::EvaluationKeys evaluationKeys)
+FFTPlanRegistry &FFTPlanRegistry::instance() {
+  static FFTPlanRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<const FFT> FFTPlanRegistry::get(size_t polynomial_size) {
+  const std::lock_guard<std::mutex> guard(mutex);
+  auto it = plans.find(polynomial_size);
+  if (it != plans.end())
+    return it->second;
+  auto plan = std::make_shared<const FFT>(polynomial_size);
+  plans.emplace(polynomial_size, plan);
+  return plan;
+}
+
+RuntimeContext::KeyTable::KeyTable(clientlib::EvaluationKeys evaluationKeys)
     : evaluationKeys(evaluationKeys) {
   {
 
@@ -43,44 +64,695 @@ RuntimeContext::RuntimeContext(clientlib::EvaluationKeys evaluationKeys)
       size_t polynomial_size = param.polynomialSize;
       size_t input_lwe_dimension = param.inputLweDimension;
 
-      // Create the FFT
-      FFT fft(polynomial_size);
-
-      // Allocate scratch for key conversion
-      size_t scratch_size;
-      size_t scratch_align;
-      concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
-          &scratch_size, &scratch_align, fft.fft);
-      auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
-
-      // Allocate the fourier_bootstrap_key
-      auto fourier_data = std::make_shared<std::vector<double>>();
-      fourier_data->resize(bsk.size());
-      auto bsk_data = bsk.buffer();
-
-      // Convert bootstrap_key to the fourier domain
-      concrete_cpu_bootstrap_key_convert_u64_to_fourier(
-          bsk_data, fourier_data->data(), decomposition_level_count,
-          decomposition_base_log, glwe_dimension, polynomial_size,
-          input_lwe_dimension, fft.fft, scratch, scratch_size);
-
-      // Store the fourier_bootstrap_key in the context
-      fourier_bootstrap_keys.push_back(fourier_data);
+      // Get the shared FFT plan
+      auto fft = FFTPlanRegistry::instance().get(polynomial_size);
+
+      if (bsk.buffer() == nullptr || bsk.size() <= 1) {
+        // Device-only key (see readEvaluationKeysOnDevice): the host
+        // side holds a sentinel, no standard-domain material to convert.
+        // The CPU fallback is disabled in such deployments.
+        fourier_bootstrap_keys.push_back(nullptr);
+        fourier_bootstrap_key_buffers.push_back(nullptr);
+      } else if (bsk.fourierBuffer() != nullptr &&
+                 bsk.fourierSize() == bsk.size()) {
+        // The Fourier representation came with the key (e.g. mapped from
+        // the key set cache): use it as is, the conversion output is
+        // deterministic. The buffer stays alive through evaluationKeys.
+        fourier_bootstrap_keys.push_back(nullptr);
+        fourier_bootstrap_key_buffers.push_back(bsk.fourierBuffer());
+      } else {
+        // Scratch requirements of the key conversion, per worker
+        size_t scratch_size;
+        size_t scratch_align;
+        concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
+            &scratch_size, &scratch_align, fft->fft);
+
+        // Allocate the fourier_bootstrap_key
+        auto fourier_data = std::make_shared<std::vector<double>>();
+        fourier_data->resize(bsk.size());
+        auto bsk_data = bsk.buffer();
+
+        // Convert bootstrap_key to the fourier domain. The conversion is
+        // independent per GGSW ciphertext, so the input_lwe_dimension
+        // ciphertexts are split over the cores, each worker converting
+        // one chunk with its own scratch. For large polynomials this
+        // turns tens of seconds of single-threaded cold start per key
+        // into the cost of the largest chunk.
+        size_t workers =
+            std::min((size_t)std::thread::hardware_concurrency(),
+                     input_lwe_dimension);
+        workers = std::max(workers, (size_t)1);
+        size_t chunk_len = (input_lwe_dimension + workers - 1) / workers;
+        auto convertChunk = [=, fourier_bsk = fourier_data->data(),
+                             fft_plan = fft->fft](size_t start, size_t len) {
+          auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+          concrete_cpu_bootstrap_key_convert_u64_to_fourier_chunk(
+              bsk_data, fourier_bsk, start, len, decomposition_level_count,
+              decomposition_base_log, glwe_dimension, polynomial_size,
+              input_lwe_dimension, fft_plan, scratch, scratch_size);
+          free(scratch);
+        };
+        if (workers <= 1) {
+          convertChunk(0, input_lwe_dimension);
+        } else {
+          std::vector<std::thread> tasks;
+          for (size_t start = 0; start < input_lwe_dimension;
+               start += chunk_len) {
+            size_t len = std::min(chunk_len, input_lwe_dimension - start);
+            tasks.push_back(std::thread(convertChunk, start, len));
+          }
+          for (auto &task : tasks)
+            task.join();
+        }
+
+        // Store the fourier_bootstrap_key in the context
+        fourier_bootstrap_key_buffers.push_back(fourier_data->data());
+        fourier_bootstrap_keys.push_back(std::move(fourier_data));
+      }
+
+      // Precompute the bootstrap scratch requirements for this key so the
+      // per-call wrappers can skip the FFI query on their hot path.
+      size_t pbs_scratch_size;
+      size_t pbs_scratch_align;
+      concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+          &pbs_scratch_size, &pbs_scratch_align, glwe_dimension,
+          polynomial_size, fft->fft);
+      bootstrap_scratch_sizes.push_back(pbs_scratch_size);
+      bootstrap_scratch_aligns.push_back(pbs_scratch_align);
+
       ffts.push_back(std::move(fft));
-      free(scratch);
     }
 
+  }
+}
+
+RuntimeContext::RuntimeContext(clientlib::EvaluationKeys evaluationKeys)
+    : table(std::make_shared<const KeyTable>(evaluationKeys)) {}
+
+void RuntimeContext::rotateKeys(clientlib::EvaluationKeys newKeys) {
+  // Pay the Fourier conversion of the new keys before publishing them,
+  // so the swap itself is one atomic pointer store.
+  auto newTable = std::make_shared<const KeyTable>(newKeys);
+  const std::lock_guard<std::mutex> guard(rotationMutex);
+  retired.push_back(keys());
+  std::atomic_store(&table, std::move(newTable));
+  if (activeInvocations.load() == 0) {
+    // Nothing is running on the old keys, no need to wait for the next
+    // quiescent point.
+    retired.clear();
+  }
+}
+
+void RuntimeContext::leaveInvocation() {
+  if (activeInvocations.fetch_sub(1) != 1) {
+    return;
+  }
+  // Last active invocation out: every invocation entered before a
+  // rotation has finished, the retired tables cannot be referenced
+  // anymore.
+  const std::lock_guard<std::mutex> guard(rotationMutex);
+  if (activeInvocations.load() == 0) {
+    retired.clear();
+  }
+}
+
+RuntimeContextRegistry &RuntimeContextRegistry::instance() {
+  static RuntimeContextRegistry registry;
+  return registry;
+}
+
+std::vector<const void *>
+RuntimeContextRegistry::identityOf(clientlib::EvaluationKeys &evaluationKeys) {
+  // Copies of the same EvaluationKeys share their key buffers, so the
+  // buffer addresses identify the keyset.
+  std::vector<const void *> identity;
+  for (auto &ksk : evaluationKeys.getKeyswitchKeys())
+    identity.push_back(ksk.buffer());
+  for (auto &bsk : evaluationKeys.getBootstrapKeys())
+    identity.push_back(bsk.buffer());
+  for (auto &pksk : evaluationKeys.getPackingKeyswitchKeys())
+    identity.push_back(pksk.buffer());
+  return identity;
+}
+
+std::shared_ptr<RuntimeContext>
+RuntimeContextRegistry::get(clientlib::EvaluationKeys evaluationKeys) {
+  auto identity = identityOf(evaluationKeys);
+
+  const std::lock_guard<std::mutex> guard(mutex);
+  auto it = contexts.find(identity);
+  if (it != contexts.end()) {
+    if (auto context = it->second.lock())
+      return context;
+  }
+  auto context = std::make_shared<RuntimeContext>(evaluationKeys);
+  contexts[identity] = context;
+  return context;
+}
+
+void RuntimeContextRegistry::prefetch(
+    clientlib::EvaluationKeys evaluationKeys) {
+  // The warm-up runs detached: prefetching is a hint, sessions never wait
+  // on it. A racing invocation of the same keyset simply builds or finds
+  // the context through get() as usual.
+  std::thread([this, evaluationKeys]() mutable {
+    auto context = get(evaluationKeys);
+#ifdef CONCRETELANG_CUDA_SUPPORT
+    void *stream = cuda_create_stream(0);
+    context->prefetch_gpu_keys(0, stream);
+    cuda_destroy_stream((cudaStream_t *)stream, 0);
+#endif
+    auto identity = identityOf(evaluationKeys);
+    const std::lock_guard<std::mutex> guard(mutex);
+    prefetched[identity] = std::move(context);
+  }).detach();
+}
+
+void RuntimeContextRegistry::releasePrefetch(
+    clientlib::EvaluationKeys evaluationKeys) {
+  auto identity = identityOf(evaluationKeys);
+  const std::lock_guard<std::mutex> guard(mutex);
+  prefetched.erase(identity);
+}
+
+void RuntimeContextRegistry::rotate(clientlib::EvaluationKeys oldKeys,
+                                    clientlib::EvaluationKeys newKeys) {
+  auto oldIdentity = identityOf(oldKeys);
+  auto newIdentity = identityOf(newKeys);
+
+  std::shared_ptr<RuntimeContext> context;
+  {
+    const std::lock_guard<std::mutex> guard(mutex);
+    auto it = contexts.find(oldIdentity);
+    if (it == contexts.end())
+      return;
+    context = it->second.lock();
+    contexts.erase(it);
+    if (!context) {
+      // The last user dropped the context, nothing to rotate; the next
+      // get() with the new keys builds a fresh one.
+      prefetched.erase(oldIdentity);
+      return;
+    }
+  }
+
+  // The Fourier conversion of the new keys runs outside the registry
+  // lock, invocations of other keysets are not blocked behind it.
+  context->rotateKeys(newKeys);
+
+  const std::lock_guard<std::mutex> guard(mutex);
+  contexts[newIdentity] = context;
+  // Move a prefetch pin of the old keyset along with the context.
+  auto pinned = prefetched.find(oldIdentity);
+  if (pinned != prefetched.end()) {
+    prefetched[newIdentity] = std::move(pinned->second);
+    prefetched.erase(oldIdentity);
+  }
+}
+
 #ifdef CONCRETELANG_CUDA_SUPPORT
-    assert(cudaGetDeviceCount(&num_devices) == cudaSuccess);
-    bsk_gpu.resize(num_devices, nullptr);
-    ksk_gpu.resize(num_devices, nullptr);
-    for (int i = 0; i < num_devices; ++i) {
-      bsk_gpu_mutex.push_back(std::make_unique<std::mutex>());
-      ksk_gpu_mutex.push_back(std::make_unique<std::mutex>());
+
+GPUTransferScheduler &GPUTransferScheduler::instance() {
+  static GPUTransferScheduler scheduler;
+  return scheduler;
+}
+
+GPUTransferScheduler::GPUTransferScheduler() {
+  chunkBytes = ((size_t)64) << 20;
+  if (char *env = getenv("CONCRETE_GPU_BULK_CHUNK_MB"))
+    chunkBytes = (size_t)strtoull(env, nullptr, 10) << 20;
+  rateBytesPerSecond = 0.0;
+  if (char *env = getenv("CONCRETE_GPU_BULK_MBPS"))
+    rateBytesPerSecond = strtod(env, nullptr) * (double)(1 << 20);
+  // A full bucket lets an isolated upload burst a few chunks before the
+  // rate kicks in.
+  tokens = 4.0 * (double)chunkBytes;
+  lastRefill = std::chrono::steady_clock::now();
+}
+
+void GPUTransferScheduler::takeTokens(size_t bytes) {
+  if (rateBytesPerSecond <= 0.0)
+    return;
+  std::unique_lock<std::mutex> guard(mutex);
+  double capacity = 4.0 * (double)chunkBytes;
+  // A request larger than the bucket (chunking disabled, or an item
+  // bigger than four chunks) could never be satisfied and would spin
+  // forever; charging a full bucket preserves the pacing it implies.
+  double cost = std::min((double)bytes, capacity);
+  for (;;) {
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - lastRefill;
+    lastRefill = now;
+    tokens = std::min(capacity, tokens + elapsed.count() * rateBytesPerSecond);
+    if (tokens >= cost) {
+      tokens -= cost;
+      return;
     }
-#endif
+    double waitSeconds = (cost - tokens) / rateBytesPerSecond;
+    guard.unlock();
+    std::this_thread::sleep_for(std::chrono::duration<double>(waitSeconds));
+    guard.lock();
   }
 }
 
+void GPUTransferScheduler::paced(
+    size_t itemCount, size_t itemBytes, void *stream,
+    const std::function<void(size_t, size_t)> &transferChunk) {
+  size_t chunkItems = itemCount;
+  if (chunkBytes > 0 && itemBytes > 0)
+    chunkItems = std::max((size_t)1, chunkBytes / itemBytes);
+  for (size_t start = 0; start < itemCount; start += chunkItems) {
+    size_t count = std::min(chunkItems, itemCount - start);
+    takeTokens(count * itemBytes);
+    transferChunk(start, count);
+    // Under a rate cap the chunk must have left the engine before its
+    // tokens count as spent; without one issuing the chunks back to back
+    // is enough, the boundaries alone give the copy engine points where
+    // it services the transfers of other streams.
+    if (rateBytesPerSecond > 0.0 && start + count < itemCount)
+      cudaStreamSynchronize(*(cudaStream_t *)stream);
+  }
+}
+
+void GPUTransferScheduler::bulkUpload(uint32_t gpu_idx, void *dst,
+                                      const void *src, size_t bytes,
+                                      void *stream) {
+  paced(bytes, 1, stream, [&](size_t start, size_t count) {
+    cuda_memcpy_async_to_gpu((void *)((char *)dst + start),
+                             (void *)((char *)src + start), count,
+                             (cudaStream_t *)stream, gpu_idx);
+  });
+}
+
+GPUKeyResidencyManager &GPUKeyResidencyManager::instance() {
+  static GPUKeyResidencyManager manager;
+  return manager;
+}
+
+void *GPUKeyResidencyManager::get(uint32_t gpu_idx, const void *hostBuffer,
+                                  size_t deviceBytes, const void *user,
+                                  const std::function<void *()> &upload) {
+  const std::lock_guard<std::mutex> guard(mutex);
+  auto key = std::make_pair(gpu_idx, hostBuffer);
+  auto it = entries.find(key);
+  if (it != entries.end()) {
+    it->second.lastUse = ++clock;
+    it->second.users.insert(user);
+    return it->second.devicePtr;
+  }
+  // Make room for the key if needed, evicting the coldest unused keys first.
+  while (cuda_check_valid_malloc(deviceBytes, gpu_idx) == -1 &&
+         evictLeastRecentlyUsed(gpu_idx))
+    ;
+  Entry entry;
+  entry.devicePtr = upload();
+  entry.bytes = deviceBytes;
+  entry.lastUse = ++clock;
+  entry.users.insert(user);
+  auto inserted = entries.emplace(key, std::move(entry));
+  return inserted.first->second.devicePtr;
+}
+
+void GPUKeyResidencyManager::adopt(uint32_t gpu_idx, const void *hostBuffer,
+                                   size_t deviceBytes, void *devicePtr) {
+  const std::lock_guard<std::mutex> guard(mutex);
+  Entry entry;
+  entry.devicePtr = devicePtr;
+  entry.bytes = deviceBytes;
+  entry.lastUse = ++clock;
+  // No host copy exists to re-upload from: keep the key registered as
+  // its own user so eviction never selects it.
+  entry.users.insert(hostBuffer);
+  entries.emplace(std::make_pair(gpu_idx, hostBuffer), std::move(entry));
+}
+
+void GPUKeyResidencyManager::release(const void *user) {
+  const std::lock_guard<std::mutex> guard(mutex);
+  for (auto &entry : entries) {
+    entry.second.users.erase(user);
+  }
+}
+
+bool GPUKeyResidencyManager::evictLeastRecentlyUsed(uint32_t gpu_idx) {
+  auto victim = entries.end();
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (it->first.first != gpu_idx || !it->second.users.empty())
+      continue;
+    if (victim == entries.end() || it->second.lastUse < victim->second.lastUse)
+      victim = it;
+  }
+  if (victim == entries.end())
+    return false;
+  cuda_drop(victim->second.devicePtr, gpu_idx);
+  entries.erase(victim);
+  return true;
+}
+
+GPULutPool &GPULutPool::instance() {
+  static GPULutPool pool;
+  return pool;
+}
+
+void *GPULutPool::get(uint32_t gpu_idx, const uint64_t *tlu, uint32_t glwe_dim,
+                      uint32_t poly_size, uint32_t num_lut_vectors,
+                      void *stream) {
+  size_t table_len = (size_t)poly_size * num_lut_vectors;
+  size_t glwe_ct_len = (size_t)poly_size * (glwe_dim + 1) * num_lut_vectors;
+  size_t glwe_ct_bytes = glwe_ct_len * sizeof(uint64_t);
+
+  // FNV-1a over the table contents
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < table_len; ++i) {
+    hash ^= tlu[i];
+    hash *= 0x100000001b3ULL;
+  }
+
+  const std::lock_guard<std::mutex> guard(mutex);
+  auto key = std::make_tuple(gpu_idx, hash, glwe_ct_bytes);
+  // The hash narrows the candidates down; the actual table contents
+  // decide, so a colliding table cannot be served another table's
+  // accumulator.
+  auto candidates = entries.equal_range(key);
+  for (auto it = candidates.first; it != candidates.second; ++it)
+    if (std::equal(it->second.table.begin(), it->second.table.end(), tlu))
+      return it->second.devicePtr;
+
+  // Trivial GLWE encryption of each table: zero mask, the table as body
+  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_bytes);
+  size_t pos = 0, postlu = 0;
+  for (size_t l = 0; l < num_lut_vectors; ++l) {
+    for (size_t i = 0; i < (size_t)poly_size * glwe_dim; i++)
+      glwe_ct[pos++] = 0;
+    for (size_t i = 0; i < poly_size; i++)
+      glwe_ct[pos++] = tlu[postlu++];
+  }
+  void *glwe_ct_gpu =
+      cuda_malloc_async(glwe_ct_bytes, (cudaStream_t *)stream, gpu_idx);
+  cuda_memcpy_async_to_gpu(glwe_ct_gpu, glwe_ct, glwe_ct_bytes,
+                           (cudaStream_t *)stream, gpu_idx);
+  // Synchronization here is not optional as it works with the pool lock
+  // to prevent other GPU streams from reading a partially uploaded table;
+  // it also allows releasing the host staging copy.
+  cudaStreamSynchronize(*(cudaStream_t *)stream);
+  free(glwe_ct);
+  Entry entry;
+  entry.devicePtr = glwe_ct_gpu;
+  entry.table.assign(tlu, tlu + table_len);
+  entries.emplace(key, std::move(entry));
+  return glwe_ct_gpu;
+}
+
+clientlib::EvaluationKeys
+readEvaluationKeysOnDevice(std::istream &istream, uint32_t gpu_idx,
+                           void *stream) {
+  // Pinned staging buffer the payloads stream through on their way to
+  // the device; sized well below any key so host memory stays flat.
+  constexpr size_t STAGING_BYTES = ((size_t)32) << 20;
+  void *staging = nullptr;
+  bool stagingPinned = cudaMallocHost(&staging, STAGING_BYTES) == cudaSuccess;
+  if (!stagingPinned)
+    staging = malloc(STAGING_BYTES);
+
+  // Streams the next `words` 64-bit words of the input into a fresh
+  // device buffer, chunk by chunk through the staging buffer.
+  auto streamToDevice = [&](uint64_t words) {
+    size_t bytes = words * sizeof(uint64_t);
+    void *device = cuda_malloc_async(bytes, (cudaStream_t *)stream, gpu_idx);
+    size_t offset = 0;
+    while (offset < bytes) {
+      size_t chunk = std::min(STAGING_BYTES, bytes - offset);
+      istream.read((char *)staging, chunk);
+      cuda_memcpy_async_to_gpu((void *)((char *)device + offset), staging,
+                               chunk, (cudaStream_t *)stream, gpu_idx);
+      // The staging buffer is reused by the next chunk, wait the copy
+      // out.
+      cudaStreamSynchronize(*(cudaStream_t *)stream);
+      offset += chunk;
+    }
+    return device;
+  };
+
+  // The host side of each key keeps a one-word sentinel: the identity
+  // its device copy is registered under, and what the lazy get_*_gpu
+  // accessors look up.
+  auto makeSentinel = []() {
+    auto buffer = std::make_shared<std::vector<uint64_t>>();
+    buffer->resize(1);
+    return buffer;
+  };
+
+  // Bootstrap and keyswitch keys may arrive in seeded form: bodies only,
+  // with the masks replayed host side from the public seed in the header.
+  auto readMaskSeed = [&istream]() {
+    uint64_t lo, hi;
+    clientlib::readWord(istream, lo);
+    clientlib::readWord(istream, hi);
+    struct Uint128 u128;
+    for (int i = 0; i < 8; i++) {
+      u128.little_endian_bytes[i] = lo >> (8 * i);
+      u128.little_endian_bytes[8 + i] = hi >> (8 * i);
+    }
+    return u128;
+  };
+
+  uint64_t nbKey;
+  clientlib::readSize(istream, nbKey);
+  std::vector<clientlib::LweBootstrapKey> bootstrapKeys;
+  for (uint64_t i = 0; i < nbKey; i++) {
+    uint8_t seeded;
+    clientlib::readWord(istream, seeded);
+    clientlib::BootstrapKeyParam param;
+    istream >> param;
+    struct Uint128 maskSeed = {};
+    if (seeded)
+      maskSeed = readMaskSeed();
+    uint64_t words;
+    clientlib::readSize(istream, words);
+    // The device bootstrap key is the Fourier representation, built by
+    // the conversion from the whole standard-domain key: stage that key
+    // fully in transient pinned memory (expanding it there when it came
+    // in seeded), convert, and drop the staging.
+    uint64_t fullWords = seeded ? concrete_cpu_bootstrap_key_size_u64(
+                                      param.level, param.glweDimension,
+                                      param.polynomialSize,
+                                      param.inputLweDimension)
+                                : words;
+    size_t host_bytes = fullWords * sizeof(uint64_t);
+    void *host = nullptr;
+    bool pinned = cudaMallocHost(&host, host_bytes) == cudaSuccess;
+    if (!pinned)
+      host = malloc(host_bytes);
+    if (seeded) {
+      std::vector<uint64_t> bodies(words);
+      istream.read((char *)bodies.data(), words * sizeof(uint64_t));
+      concrete_cpu_expand_seeded_lwe_bootstrap_key_u64(
+          (uint64_t *)host, bodies.data(), param.inputLweDimension,
+          param.polynomialSize, param.glweDimension, param.level,
+          param.baseLog, maskSeed);
+    } else {
+      istream.read((char *)host, host_bytes);
+    }
+    size_t device_bytes = fullWords * sizeof(double);
+    void *bsk_gpu =
+        cuda_malloc_async(device_bytes, (cudaStream_t *)stream, gpu_idx);
+    cuda_convert_lwe_bootstrap_key_64(
+        bsk_gpu, host, (cudaStream_t *)stream, gpu_idx,
+        param.inputLweDimension, param.glweDimension, param.level,
+        param.polynomialSize);
+    cudaStreamSynchronize(*(cudaStream_t *)stream);
+    if (pinned)
+      cudaFreeHost(host);
+    else
+      free(host);
+    auto buffer = makeSentinel();
+    GPUKeyResidencyManager::instance().adopt(gpu_idx, buffer->data(),
+                                             device_bytes, bsk_gpu);
+    bootstrapKeys.push_back(clientlib::LweBootstrapKey(buffer, param));
+  }
+
+  clientlib::readSize(istream, nbKey);
+  std::vector<clientlib::LweKeyswitchKey> keyswitchKeys;
+  for (uint64_t i = 0; i < nbKey; i++) {
+    uint8_t seeded;
+    clientlib::readWord(istream, seeded);
+    clientlib::KeyswitchKeyParam param;
+    istream >> param;
+    struct Uint128 maskSeed = {};
+    uint64_t outputDimension = 0;
+    if (seeded) {
+      maskSeed = readMaskSeed();
+      clientlib::readWord(istream, outputDimension);
+    }
+    uint64_t words;
+    clientlib::readSize(istream, words);
+    void *ksk_gpu;
+    uint64_t fullWords = words;
+    if (seeded) {
+      // Expand host side, then upload the full key in one copy.
+      uint64_t inputDimension = words / param.level;
+      fullWords = concrete_cpu_keyswitch_key_size_u64(
+          param.level, param.baseLog, inputDimension, outputDimension);
+      size_t host_bytes = fullWords * sizeof(uint64_t);
+      void *host = nullptr;
+      bool pinned = cudaMallocHost(&host, host_bytes) == cudaSuccess;
+      if (!pinned)
+        host = malloc(host_bytes);
+      std::vector<uint64_t> bodies(words);
+      istream.read((char *)bodies.data(), words * sizeof(uint64_t));
+      concrete_cpu_expand_seeded_lwe_keyswitch_key_u64(
+          (uint64_t *)host, bodies.data(), inputDimension, outputDimension,
+          param.level, param.baseLog, maskSeed);
+      ksk_gpu = cuda_malloc_async(host_bytes, (cudaStream_t *)stream, gpu_idx);
+      cuda_memcpy_async_to_gpu(ksk_gpu, host, host_bytes,
+                               (cudaStream_t *)stream, gpu_idx);
+      cudaStreamSynchronize(*(cudaStream_t *)stream);
+      if (pinned)
+        cudaFreeHost(host);
+      else
+        free(host);
+    } else {
+      ksk_gpu = streamToDevice(words);
+    }
+    auto buffer = makeSentinel();
+    GPUKeyResidencyManager::instance().adopt(
+        gpu_idx, buffer->data(), fullWords * sizeof(uint64_t), ksk_gpu);
+    keyswitchKeys.push_back(clientlib::LweKeyswitchKey(buffer, param));
+  }
+
+  clientlib::readSize(istream, nbKey);
+  std::vector<clientlib::PackingKeyswitchKey> packingKeyswitchKeys;
+  for (uint64_t i = 0; i < nbKey; i++) {
+    clientlib::PackingKeyswitchKeyParam param;
+    istream >> param;
+    uint64_t words;
+    clientlib::readSize(istream, words);
+    void *pksk_gpu = streamToDevice(words);
+    auto buffer = makeSentinel();
+    GPUKeyResidencyManager::instance().adopt(
+        gpu_idx, buffer->data(), words * sizeof(uint64_t), pksk_gpu);
+    packingKeyswitchKeys.push_back(
+        clientlib::PackingKeyswitchKey(buffer, param));
+  }
+
+  if (stagingPinned)
+    cudaFreeHost(staging);
+  else
+    free(staging);
+
+  return clientlib::EvaluationKeys(keyswitchKeys, bootstrapKeys,
+                                   packingKeyswitchKeys);
+}
+
+void *RuntimeContext::get_bsk_gpu(uint32_t input_lwe_dim, uint32_t poly_size,
+                                  uint32_t level, uint32_t glwe_dim,
+                                  uint32_t gpu_idx, void *stream) {
+  auto bsk = keys()->evaluationKeys.getBootstrapKey(0);
+  size_t host_bytes = bsk.size() * sizeof(uint64_t);
+  size_t device_bytes = bsk.size() * sizeof(double);
+  return GPUKeyResidencyManager::instance().get(
+      gpu_idx, bsk.buffer(), device_bytes, this, [&]() {
+        void *host = const_cast<uint64_t *>(bsk.buffer());
+        // Page-lock the host buffer for the duration of the upload so the
+        // transfer runs at full PCIe bandwidth. Registration is best effort.
+        bool pinned = cudaHostRegister(host, host_bytes,
+                                       cudaHostRegisterPortable) == cudaSuccess;
+        if (!pinned)
+          cudaGetLastError();
+        void *bsk_gpu = cuda_malloc_async(device_bytes, (cudaStream_t *)stream,
+                                          gpu_idx);
+        // The conversion is independent per GGSW ciphertext and both
+        // domains store the same scalar count per GGSW, so the upload
+        // goes through the scheduler one GGSW range at a time instead of
+        // monopolizing the copy engine for the whole key.
+        size_t ggsw_len =
+            (size_t)level * (glwe_dim + 1) * (glwe_dim + 1) * poly_size;
+        GPUTransferScheduler::instance().paced(
+            input_lwe_dim, ggsw_len * sizeof(uint64_t), stream,
+            [&](size_t start, size_t count) {
+              cuda_convert_lwe_bootstrap_key_64(
+                  (void *)((double *)bsk_gpu + start * ggsw_len),
+                  (void *)((uint64_t *)host + start * ggsw_len),
+                  (cudaStream_t *)stream, gpu_idx, count, glwe_dim, level,
+                  poly_size);
+            });
+        // Synchronization here is not optional as it works with the manager
+        // lock to prevent other GPU streams from reading partially copied
+        // keys.
+        cudaStreamSynchronize(*(cudaStream_t *)stream);
+        if (pinned)
+          cudaHostUnregister(host);
+        return bsk_gpu;
+      });
+}
+
+void *RuntimeContext::get_ksk_gpu(uint32_t level, uint32_t input_lwe_dim,
+                                  uint32_t output_lwe_dim, uint32_t gpu_idx,
+                                  void *stream) {
+  auto ksk = keys()->evaluationKeys.getKeyswitchKey(0);
+  size_t ksk_buffer_size = sizeof(uint64_t) * ksk.size();
+  return GPUKeyResidencyManager::instance().get(
+      gpu_idx, ksk.buffer(), ksk_buffer_size, this, [&]() {
+        void *host = const_cast<uint64_t *>(ksk.buffer());
+        bool pinned = cudaHostRegister(host, ksk_buffer_size,
+                                       cudaHostRegisterPortable) == cudaSuccess;
+        if (!pinned)
+          cudaGetLastError();
+        void *ksk_gpu = cuda_malloc_async(ksk_buffer_size,
+                                          (cudaStream_t *)stream, gpu_idx);
+        GPUTransferScheduler::instance().bulkUpload(gpu_idx, ksk_gpu, host,
+                                                    ksk_buffer_size, stream);
+        // Synchronization here is not optional as it works with the manager
+        // lock to prevent other GPU streams from reading partially copied
+        // keys.
+        cudaStreamSynchronize(*(cudaStream_t *)stream);
+        if (pinned)
+          cudaHostUnregister(host);
+        return ksk_gpu;
+      });
+}
+
+void RuntimeContext::prefetch_gpu_keys(uint32_t gpu_idx, void *stream) {
+  auto evaluationKeys = keys()->evaluationKeys;
+  if (!evaluationKeys.getBootstrapKeys().empty()) {
+    auto param = evaluationKeys.getBootstrapKey(0).parameters();
+    get_bsk_gpu(param.inputLweDimension, param.polynomialSize, param.level,
+                param.glweDimension, gpu_idx, stream);
+  }
+  if (!evaluationKeys.getKeyswitchKeys().empty()) {
+    // The keyswitch upload is a plain copy, the dimensions only matter to
+    // the kernels reading the key.
+    auto param = evaluationKeys.getKeyswitchKey(0).parameters();
+    get_ksk_gpu(param.level, 0, 0, gpu_idx, stream);
+  }
+  if (!evaluationKeys.getPackingKeyswitchKeys().empty())
+    get_pksk_gpu(gpu_idx, stream);
+}
+
+void *RuntimeContext::get_pksk_gpu(uint32_t gpu_idx, void *stream) {
+  auto pksk = keys()->evaluationKeys.getPackingKeyswitchKey(0);
+  size_t pksk_buffer_size = sizeof(uint64_t) * pksk.size();
+  return GPUKeyResidencyManager::instance().get(
+      gpu_idx, pksk.buffer(), pksk_buffer_size, this, [&]() {
+        void *host = const_cast<uint64_t *>(pksk.buffer());
+        bool pinned = cudaHostRegister(host, pksk_buffer_size,
+                                       cudaHostRegisterPortable) == cudaSuccess;
+        if (!pinned)
+          cudaGetLastError();
+        void *pksk_gpu = cuda_malloc_async(pksk_buffer_size,
+                                           (cudaStream_t *)stream, gpu_idx);
+        GPUTransferScheduler::instance().bulkUpload(gpu_idx, pksk_gpu, host,
+                                                    pksk_buffer_size, stream);
+        // Synchronization here is not optional as it works with the manager
+        // lock to prevent other GPU streams from reading partially copied
+        // keys.
+        cudaStreamSynchronize(*(cudaStream_t *)stream);
+        if (pinned)
+          cudaHostUnregister(host);
+        return pksk_gpu;
+      });
+}
+
+#endif
+
 } // namespace concretelang
 } // namespace mlir
@@ -0,0 +1,114 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <stdlib.h>
+#include <vector>
+
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "concretelang/Runtime/runtime_allocator.h"
+#include "concretelang/Runtime/runtime_stats.h"
+
+namespace {
+
+/// Blocks are cached in power-of-two size classes from 2^min_class_log2 to
+/// 2^max_class_log2 bytes; anything larger goes straight to the system
+/// allocator. A class only holds blocks whose usable size is at least the
+/// class size, so any cached block can serve any request of its class,
+/// including blocks released by a different thread than the one that
+/// allocated them.
+constexpr size_t min_class_log2 = 6;
+constexpr size_t max_class_log2 = 26;
+constexpr size_t num_classes = max_class_log2 - min_class_log2 + 1;
+/// Bound on the bytes a thread may hold; mostly relevant for worker
+/// threads, which have no invocation boundary at which the cache is
+/// released.
+constexpr size_t cache_capacity_bytes = 1 << 28;
+
+size_t usableSize(void *ptr) {
+#ifdef __APPLE__
+  return malloc_size(ptr);
+#else
+  return malloc_usable_size(ptr);
+#endif
+}
+
+size_t classOfRequest(uint64_t size) {
+  size_t c = min_class_log2;
+  while ((1ull << c) < size)
+    c++;
+  return c - min_class_log2;
+}
+
+struct AllocationCache {
+  std::vector<void *> blocks[num_classes];
+  size_t cachedBytes = 0;
+
+  void release() {
+    for (auto &list : blocks) {
+      for (void *block : list)
+        free(block);
+      list.clear();
+    }
+    cachedBytes = 0;
+  }
+
+  ~AllocationCache() { release(); }
+};
+
+thread_local AllocationCache allocation_cache;
+
+} // namespace
+
+void *_mlir_memref_to_llvm_alloc(uint64_t size) {
+  return _mlir_memref_to_llvm_aligned_alloc(alignof(max_align_t), size);
+}
+
+void *_mlir_memref_to_llvm_aligned_alloc(uint64_t alignment, uint64_t size) {
+  void *block = nullptr;
+  if (size > (1ull << max_class_log2)) {
+    block =
+        aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+  } else {
+    size_t c = classOfRequest(size > alignment ? size : alignment);
+    auto &list = allocation_cache.blocks[c];
+    // Cached blocks are at least max_align_t aligned; only reuse one when
+    // that satisfies the requested alignment.
+    if (!list.empty() && (uintptr_t)list.back() % alignment == 0) {
+      block = list.back();
+      list.pop_back();
+      allocation_cache.cachedBytes -= usableSize(block);
+    } else {
+      block = aligned_alloc(alignment, 1ull << (c + min_class_log2));
+    }
+  }
+  if (block != nullptr)
+    mlir::concretelang::runtime_stats::recordAllocation(usableSize(block));
+  return block;
+}
+
+void _mlir_memref_to_llvm_free(void *ptr) {
+  if (ptr == nullptr)
+    return;
+  size_t usable = usableSize(ptr);
+  mlir::concretelang::runtime_stats::recordDeallocation(usable);
+  if (usable < (1ull << min_class_log2) || usable > (2ull << max_class_log2) ||
+      allocation_cache.cachedBytes + usable > cache_capacity_bytes) {
+    free(ptr);
+    return;
+  }
+  // Largest class the block can serve: usable >= 2^(c + min_class_log2).
+  size_t c = 0;
+  while (c + 1 < num_classes && usable >= (2ull << (c + min_class_log2)))
+    c++;
+  allocation_cache.blocks[c].push_back(ptr);
+  allocation_cache.cachedBytes += usable;
+}
+
+void runtime_allocation_cache_release() { allocation_cache.release(); }
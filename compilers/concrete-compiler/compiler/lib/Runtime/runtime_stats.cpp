@@ -0,0 +1,231 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "concretelang/Runtime/runtime_stats.h"
+#include "concretelang/Runtime/runtime_trace.h"
+
+namespace mlir {
+namespace concretelang {
+namespace runtime_stats {
+namespace {
+
+/// Aggregate of one thread. The hot path only increments fields of its own
+/// thread's aggregate; the scraping side walks all aggregates under the
+/// registry lock. Scrapes race with in-flight increments, but a torn read
+/// is at worst one call off, which is acceptable for observability.
+struct ThreadStats {
+  uint64_t count[RUNTIME_STATS_OP_NUM];
+  uint64_t invocations[RUNTIME_STATS_OP_NUM];
+  uint64_t time_ns[RUNTIME_STATS_OP_NUM];
+  uint64_t hist[RUNTIME_STATS_OP_NUM][RUNTIME_STATS_HIST_BUCKETS];
+  uint64_t gpu_bytes_in;
+  uint64_t gpu_bytes_out;
+
+  void reset() { memset(this, 0, sizeof(ThreadStats)); }
+};
+
+std::mutex registry_mutex;
+// The registry keeps the aggregates of finished threads, their counts
+// must remain part of the totals.
+std::list<ThreadStats> registry;
+
+ThreadStats &getThreadStats() {
+  static thread_local ThreadStats *stats = []() {
+    const std::lock_guard<std::mutex> guard(registry_mutex);
+    registry.emplace_back();
+    registry.back().reset();
+    return &registry.back();
+  }();
+  return *stats;
+}
+
+const char *op_names[RUNTIME_STATS_OP_NUM] = {"keyswitch", "bootstrap",
+                                              "wop_pbs"};
+
+/// Honor CONCRETE_PROFILE_OUTPUT by writing the profile when the
+/// process exits, so services need no explicit shutdown hook.
+struct ProfileAtExit {
+  ProfileAtExit() {
+    if (getenv("CONCRETE_PROFILE_OUTPUT") != nullptr)
+      atexit([]() {
+        runtime_stats_write_profile(getenv("CONCRETE_PROFILE_OUTPUT"));
+      });
+  }
+} profile_at_exit;
+
+// Live allocation bytes and their high watermark. Unlike the call
+// counters these cannot be per-thread aggregates: a block may be freed on
+// a different thread than it was allocated on, which would drift the
+// per-thread sums negative. Relaxed atomics keep the entry points cheap.
+std::atomic<uint64_t> live_allocated_bytes{0};
+std::atomic<uint64_t> peak_allocated_bytes{0};
+
+uint64_t now_ns() {
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (uint64_t)tv.tv_sec * 1000000000ull + (uint64_t)tv.tv_nsec;
+}
+
+uint32_t bucketOf(uint64_t time_ns) {
+  uint32_t bucket = 0;
+  while (time_ns > 1 && bucket < RUNTIME_STATS_HIST_BUCKETS - 1) {
+    time_ns >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+} // namespace
+
+void recordCalls(runtime_stats_op op, uint64_t calls, uint64_t time_ns) {
+  if (calls == 0)
+    return;
+  ThreadStats &stats = getThreadStats();
+  stats.count[op] += calls;
+  stats.invocations[op] += 1;
+  stats.time_ns[op] += time_ns;
+  stats.hist[op][bucketOf(time_ns / calls)] += calls;
+}
+
+void recordAllocation(uint64_t bytes) {
+  uint64_t live =
+      live_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  uint64_t peak = peak_allocated_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !peak_allocated_bytes.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void recordDeallocation(uint64_t bytes) {
+  live_allocated_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void recordGpuTransfer(uint64_t bytes, bool toDevice) {
+  ThreadStats &stats = getThreadStats();
+  if (toDevice)
+    stats.gpu_bytes_in += bytes;
+  else
+    stats.gpu_bytes_out += bytes;
+}
+
+CallTimer::CallTimer(runtime_stats_op op, uint64_t calls, int64_t key)
+    : op(op), calls(calls), key(key), start_ns(now_ns()) {}
+
+CallTimer::~CallTimer() {
+  uint64_t end_ns = now_ns();
+  recordCalls(op, calls, end_ns - start_ns);
+  if (runtime_trace::enabled())
+    runtime_trace::recordOp(op, key, calls, start_ns, end_ns);
+}
+
+} // namespace runtime_stats
+} // namespace concretelang
+} // namespace mlir
+
+using namespace mlir::concretelang::runtime_stats;
+
+uint64_t runtime_stats_get_count(runtime_stats_op op) {
+  const std::lock_guard<std::mutex> guard(registry_mutex);
+  uint64_t total = 0;
+  for (auto &stats : registry)
+    total += stats.count[op];
+  return total;
+}
+
+uint64_t runtime_stats_get_time_ns(runtime_stats_op op) {
+  const std::lock_guard<std::mutex> guard(registry_mutex);
+  uint64_t total = 0;
+  for (auto &stats : registry)
+    total += stats.time_ns[op];
+  return total;
+}
+
+uint64_t runtime_stats_get_histogram_bucket(runtime_stats_op op,
+                                            uint32_t bucket) {
+  if (bucket >= RUNTIME_STATS_HIST_BUCKETS)
+    return 0;
+  const std::lock_guard<std::mutex> guard(registry_mutex);
+  uint64_t total = 0;
+  for (auto &stats : registry)
+    total += stats.hist[op][bucket];
+  return total;
+}
+
+uint64_t runtime_stats_get_gpu_bytes_in() {
+  const std::lock_guard<std::mutex> guard(registry_mutex);
+  uint64_t total = 0;
+  for (auto &stats : registry)
+    total += stats.gpu_bytes_in;
+  return total;
+}
+
+uint64_t runtime_stats_get_gpu_bytes_out() {
+  const std::lock_guard<std::mutex> guard(registry_mutex);
+  uint64_t total = 0;
+  for (auto &stats : registry)
+    total += stats.gpu_bytes_out;
+  return total;
+}
+
+uint64_t runtime_stats_get_invocations(runtime_stats_op op) {
+  const std::lock_guard<std::mutex> guard(registry_mutex);
+  uint64_t total = 0;
+  for (auto &stats : registry)
+    total += stats.invocations[op];
+  return total;
+}
+
+uint64_t runtime_stats_get_allocated_bytes() {
+  return live_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t runtime_stats_get_peak_allocated_bytes() {
+  return peak_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+void runtime_stats_reset_allocation_watermark() {
+  peak_allocated_bytes.store(
+      live_allocated_bytes.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+}
+
+void runtime_stats_reset() {
+  {
+    const std::lock_guard<std::mutex> guard(registry_mutex);
+    for (auto &stats : registry)
+      stats.reset();
+  }
+  // Live bytes are not zeroed: allocations made before the reset remain
+  // live and their frees would otherwise underflow the counter.
+  runtime_stats_reset_allocation_watermark();
+}
+
+int runtime_stats_write_profile(const char *path) {
+  FILE *file = fopen(path, "w");
+  if (file == nullptr)
+    return -1;
+  fprintf(file, "concrete-batching-profile v1\n");
+  for (int op = 0; op < RUNTIME_STATS_OP_NUM; op++) {
+    fprintf(file,
+            "%s invocations=%llu calls=%llu time_ns=%llu\n", op_names[op],
+            (unsigned long long)runtime_stats_get_invocations(
+                (runtime_stats_op)op),
+            (unsigned long long)runtime_stats_get_count((runtime_stats_op)op),
+            (unsigned long long)runtime_stats_get_time_ns(
+                (runtime_stats_op)op));
+  }
+  fprintf(file, "gpu_bytes_in=%llu gpu_bytes_out=%llu\n",
+          (unsigned long long)runtime_stats_get_gpu_bytes_in(),
+          (unsigned long long)runtime_stats_get_gpu_bytes_out());
+  return fclose(file);
+}
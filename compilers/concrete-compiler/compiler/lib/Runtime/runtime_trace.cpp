@@ -0,0 +1,184 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <string>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "concretelang/Runtime/runtime_trace.h"
+
+namespace mlir {
+namespace concretelang {
+namespace runtime_trace {
+namespace {
+
+struct TraceEvent {
+  const char *name;
+  uint64_t begin_ns;
+  uint64_t end_ns; // equal to begin_ns for instant markers
+  uint64_t calls;
+  int64_t key;
+  uint32_t tid;
+};
+
+const char *opNames[RUNTIME_STATS_OP_NUM] = {"keyswitch", "bootstrap",
+                                             "wop_pbs"};
+
+/// Trace state, allocated once when CONCRETE_RUNTIME_TRACE is set. The ring
+/// overwrites its oldest events when full; a writer racing the dump can tear
+/// at most the events being overwritten, which only matters when the buffer
+/// is undersized anyway (and runtime_trace_dropped reports it).
+struct TraceState {
+  std::vector<TraceEvent> ring;
+  std::atomic<uint64_t> cursor{0};
+  uint64_t origin_ns;
+  std::string autoDumpPath;
+};
+
+uint64_t now_ns() {
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (uint64_t)tv.tv_sec * 1000000000ull + (uint64_t)tv.tv_nsec;
+}
+
+TraceState *getState() {
+  static TraceState *state = []() -> TraceState * {
+    char *path = getenv("CONCRETE_RUNTIME_TRACE");
+    if (path == nullptr || path[0] == '\0')
+      return nullptr;
+    size_t capacity = 1 << 20;
+    if (char *env = getenv("CONCRETE_RUNTIME_TRACE_CAPACITY")) {
+      size_t requested = strtoul(env, nullptr, 10);
+      if (requested > 0)
+        capacity = requested;
+    }
+    TraceState *s = new TraceState();
+    s->ring.resize(capacity);
+    s->origin_ns = now_ns();
+    s->autoDumpPath = path;
+    atexit([]() {
+      TraceState *s = getState();
+      runtime_trace_dump(s->autoDumpPath.c_str());
+    });
+    return s;
+  }();
+  return state;
+}
+
+uint32_t getThreadId() {
+  static std::atomic<uint32_t> next{0};
+  static thread_local uint32_t tid = next.fetch_add(1);
+  return tid;
+}
+
+/// Stable storage for marker names: the message buffers of the Tracing
+/// dialect live in the compiled circuit, which may be unloaded before the
+/// trace is dumped.
+const char *internName(const char *message, uint32_t length) {
+  static std::mutex mutex;
+  static std::set<std::string> names;
+  const std::lock_guard<std::mutex> guard(mutex);
+  return names.emplace(message, (size_t)length).first->c_str();
+}
+
+} // namespace
+
+bool enabled() { return getState() != nullptr; }
+
+void recordOp(runtime_stats_op op, int64_t key, uint64_t calls,
+              uint64_t begin_ns, uint64_t end_ns) {
+  TraceState *s = getState();
+  if (s == nullptr)
+    return;
+  uint64_t slot = s->cursor.fetch_add(1, std::memory_order_relaxed);
+  TraceEvent &event = s->ring[slot % s->ring.size()];
+  event.name = opNames[op];
+  event.begin_ns = begin_ns;
+  event.end_ns = end_ns;
+  event.calls = calls;
+  event.key = key;
+  event.tid = getThreadId();
+}
+
+void recordMarker(const char *message, uint32_t length) {
+  TraceState *s = getState();
+  if (s == nullptr)
+    return;
+  uint64_t time_ns = now_ns();
+  uint64_t slot = s->cursor.fetch_add(1, std::memory_order_relaxed);
+  TraceEvent &event = s->ring[slot % s->ring.size()];
+  event.name = internName(message, length);
+  event.begin_ns = time_ns;
+  event.end_ns = time_ns;
+  event.calls = 0;
+  event.key = -1;
+  event.tid = getThreadId();
+}
+
+} // namespace runtime_trace
+} // namespace concretelang
+} // namespace mlir
+
+using namespace mlir::concretelang::runtime_trace;
+
+int runtime_trace_enabled() { return enabled() ? 1 : 0; }
+
+int runtime_trace_dump(const char *path) {
+  TraceState *s = getState();
+  if (s == nullptr)
+    return -1;
+  FILE *out = fopen(path, "w");
+  if (out == nullptr)
+    return -1;
+  uint64_t cursor = s->cursor.load();
+  uint64_t count = cursor < s->ring.size() ? cursor : s->ring.size();
+  int pid = (int)getpid();
+  fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", out);
+  for (uint64_t i = 0; i < count; i++) {
+    const TraceEvent &event = s->ring[i];
+    double ts = (double)(event.begin_ns - s->origin_ns) / 1000.0;
+    if (i > 0)
+      fputc(',', out);
+    if (event.end_ns > event.begin_ns) {
+      double dur = (double)(event.end_ns - event.begin_ns) / 1000.0;
+      fprintf(out,
+              "{\"name\":\"%s\",\"cat\":\"runtime\",\"ph\":\"X\",\"ts\":%."
+              "3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u,\"args\":{\"key\":%ld,"
+              "\"calls\":%lu}}",
+              event.name, ts, dur, pid, event.tid, (long)event.key,
+              (unsigned long)event.calls);
+    } else {
+      fprintf(out,
+              "{\"name\":\"%s\",\"cat\":\"marker\",\"ph\":\"i\",\"s\":\"t\","
+              "\"ts\":%.3f,\"pid\":%d,\"tid\":%u}",
+              event.name, ts, pid, event.tid);
+    }
+  }
+  fputs("]}\n", out);
+  fclose(out);
+  return 0;
+}
+
+uint64_t runtime_trace_dropped() {
+  TraceState *s = getState();
+  if (s == nullptr)
+    return 0;
+  uint64_t cursor = s->cursor.load();
+  return cursor > s->ring.size() ? cursor - s->ring.size() : 0;
+}
+
+void runtime_trace_reset() {
+  TraceState *s = getState();
+  if (s == nullptr)
+    return;
+  s->cursor.store(0);
+  s->origin_ns = now_ns();
+}
@@ -12,7 +12,10 @@
 #include "concretelang/Support/V0Parameters.h"
 #include <assert.h>
 #include <cmath>
+#include <map>
 #include <random>
+#include <tuple>
+#include <vector>
 
 inline concrete::SecurityCurve *security_curve() {
   return concrete::getSecurityCurve(128, concrete::BINARY);
@@ -23,14 +26,27 @@ uint64_t from_torus(double torus) {
   return (uint64_t)round(torus * pow(2, 64));
 }
 
-// TODO: what's the overhead of creating a csprng everytime? Should we have a
-// single one?
+// Noise samples are drawn in batches from per-thread pools, one pool per
+// variance. This amortizes the CSPRNG construction and the FFI sampling call
+// that used to happen on every single sample, which dominated the runtime of
+// large simulation sweeps. Each thread owns its CSPRNG and pools, no locking
+// is needed.
 uint64_t gaussian_noise(double mean, double variance) {
-  uint64_t random_gaussian_buff[2];
-  auto csprng = concretelang::clientlib::ConcreteCSPRNG(0);
-  concrete_cpu_fill_with_random_gaussian(random_gaussian_buff, 2, variance,
-                                         csprng.ptr);
-  return random_gaussian_buff[0];
+  constexpr size_t poolSize = 1024;
+  struct NoisePool {
+    std::vector<uint64_t> samples;
+    size_t next = 0;
+  };
+  thread_local auto csprng = concretelang::clientlib::ConcreteCSPRNG(0);
+  thread_local std::map<double, NoisePool> pools;
+  auto &pool = pools[variance];
+  if (pool.next == pool.samples.size()) {
+    pool.samples.resize(poolSize);
+    concrete_cpu_fill_with_random_gaussian(pool.samples.data(), poolSize,
+                                           variance, csprng.ptr);
+    pool.next = 0;
+  }
+  return pool.samples[pool.next++];
 }
 
 uint64_t sim_encrypt_lwe_u64(uint64_t message, uint32_t lwe_dim, void *csprng) {
@@ -45,9 +61,23 @@ uint64_t sim_encrypt_lwe_u64(uint64_t message, uint32_t lwe_dim, void *csprng) {
 uint64_t sim_keyswitch_lwe_u64(uint64_t plaintext, uint32_t level,
                                uint32_t base_log, uint32_t input_lwe_dim,
                                uint32_t output_lwe_dim) {
-  double variance_ksk = security_curve()->getVariance(1, output_lwe_dim, 64);
-  double variance = concrete_cpu_variance_keyswitch(input_lwe_dim, base_log,
-                                                    level, 64, variance_ksk);
+  // The variance only depends on the keyswitch parameters, which take a
+  // handful of values per circuit, memoize it per thread
+  thread_local std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>,
+                        double>
+      varianceCache;
+  auto cacheKey =
+      std::make_tuple(level, base_log, input_lwe_dim, output_lwe_dim);
+  auto cached = varianceCache.find(cacheKey);
+  double variance;
+  if (cached != varianceCache.end()) {
+    variance = cached->second;
+  } else {
+    double variance_ksk = security_curve()->getVariance(1, output_lwe_dim, 64);
+    variance = concrete_cpu_variance_keyswitch(input_lwe_dim, base_log, level,
+                                               64, variance_ksk);
+    varianceCache.insert({cacheKey, variance});
+  }
   uint64_t ks_noise = gaussian_noise(0, variance);
   return plaintext + ks_noise;
 }
@@ -60,10 +90,27 @@ uint64_t sim_bootstrap_lwe_u64(uint64_t plaintext, uint64_t *tlu_allocated,
                                uint32_t glwe_dim) {
   auto tlu = tlu_aligned + tlu_offset;
 
-  // modulus switching
-  double variance_ms =
-      concrete_cpu_estimate_modulus_switching_noise_with_binary_key(
-          input_lwe_dim, log2(poly_size), 64);
+  // Both variances only depend on the bootstrap parameters, which take a
+  // handful of values per circuit, memoize them per thread
+  thread_local std::map<
+      std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>,
+      std::pair<double, double>>
+      varianceCache;
+  auto cacheKey =
+      std::make_tuple(input_lwe_dim, poly_size, level, base_log, glwe_dim);
+  auto cached = varianceCache.find(cacheKey);
+  if (cached == varianceCache.end()) {
+    double variance_ms =
+        concrete_cpu_estimate_modulus_switching_noise_with_binary_key(
+            input_lwe_dim, log2(poly_size), 64);
+    double variance_bsk =
+        security_curve()->getVariance(glwe_dim, poly_size, 64);
+    double variance_br = concrete_cpu_variance_blind_rotate(
+        input_lwe_dim, glwe_dim, poly_size, base_log, level, 64,
+        mlir::concretelang::optimizer::DEFAULT_FFT_PRECISION, variance_bsk);
+    cached = varianceCache.insert({cacheKey, {variance_ms, variance_br}}).first;
+  }
+  double variance_ms = cached->second.first;
   uint64_t shift = (64 - log2(poly_size) - 2);
   // mod_switch noise
   auto noise = gaussian_noise(0, variance_ms);
@@ -86,11 +133,7 @@ uint64_t sim_bootstrap_lwe_u64(uint64_t plaintext, uint64_t *tlu_allocated,
   else
     out = -tlu[mod_switched % poly_size];
 
-  double variance_bsk = security_curve()->getVariance(glwe_dim, poly_size, 64);
-  double variance = concrete_cpu_variance_blind_rotate(
-      input_lwe_dim, glwe_dim, poly_size, base_log, level, 64,
-      mlir::concretelang::optimizer::DEFAULT_FFT_PRECISION, variance_bsk);
-  return out + gaussian_noise(0, variance);
+  return out + gaussian_noise(0, cached->second.second);
 }
 
 uint64_t sim_neg_lwe_u64(uint64_t plaintext) { return ~plaintext + 1; }
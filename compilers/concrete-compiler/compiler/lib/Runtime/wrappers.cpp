@@ -6,21 +6,111 @@
 #include "concretelang/Runtime/wrappers.h"
 #include "concrete-cpu.h"
 #include "concretelang/Common/Error.h"
+#include <algorithm>
 #include <assert.h>
+#include <atomic>
 #include <bitset>
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <omp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #include "concretelang/ClientLib/CRT.h"
+#include "concretelang/Runtime/runtime_api.h"
+#include "concretelang/Runtime/stream_emulator_api.h"
+#include "concretelang/Runtime/runtime_stats.h"
+#include "concretelang/Runtime/runtime_trace.h"
 #include "concretelang/Runtime/wrappers.h"
 
+using mlir::concretelang::runtime_stats::CallTimer;
+using mlir::concretelang::runtime_stats::recordGpuTransfer;
+
 #ifdef CONCRETELANG_CUDA_SUPPORT
 
+// Device ciphertext memory pool //////////////////////////////////////////////
+//
+// Each batched op invocation needs device buffers for its input, output and
+// accumulator temporaries. Allocating them with cuda_malloc_async per call
+// and dropping them at the end throttles high request rates: the driver
+// returns the memory to the OS on every synchronization and the next call
+// pays the allocation again. The pool below keeps dropped blocks cached by
+// power-of-two size class, per GPU, so steady-state invocations reuse the
+// same device blocks. Blocks must only be released to the pool once the
+// stream that used them has been synchronized, as cached blocks may be
+// handed out to any stream.
+
+namespace {
+constexpr uint64_t device_pool_cache_bytes = 1ull << 31;
+
+struct DeviceMemoryPool {
+  std::mutex mutex;
+  std::map<uint64_t, std::vector<void *>> free_blocks;
+  std::map<void *, uint64_t> block_sizes;
+  uint64_t cached_bytes = 0;
+};
+
+DeviceMemoryPool &device_pool(uint32_t gpu_idx) {
+  static std::mutex pools_mutex;
+  static std::map<uint32_t, DeviceMemoryPool> pools;
+  const std::lock_guard<std::mutex> guard(pools_mutex);
+  return pools[gpu_idx];
+}
+
+uint64_t device_pool_class(uint64_t size) {
+  uint64_t rounded = 1024;
+  while (rounded < size)
+    rounded <<= 1;
+  return rounded;
+}
+} // namespace
+
+void *cuda_malloc_pooled(uint64_t size, void *stream, uint32_t gpu_idx) {
+  uint64_t rounded = device_pool_class(size);
+  DeviceMemoryPool &pool = device_pool(gpu_idx);
+  {
+    const std::lock_guard<std::mutex> guard(pool.mutex);
+    auto it = pool.free_blocks.find(rounded);
+    if (it != pool.free_blocks.end() && !it->second.empty()) {
+      void *ptr = it->second.back();
+      it->second.pop_back();
+      pool.cached_bytes -= rounded;
+      return ptr;
+    }
+  }
+  void *ptr = cuda_malloc_async(rounded, (cudaStream_t *)stream, gpu_idx);
+  const std::lock_guard<std::mutex> guard(pool.mutex);
+  pool.block_sizes[ptr] = rounded;
+  return ptr;
+}
+
+// The caller must have synchronized the stream on which the block was last
+// used: the pool can hand cached blocks out to any stream.
+void cuda_free_pooled(void *ptr, void *stream, uint32_t gpu_idx) {
+  DeviceMemoryPool &pool = device_pool(gpu_idx);
+  {
+    const std::lock_guard<std::mutex> guard(pool.mutex);
+    auto it = pool.block_sizes.find(ptr);
+    if (it != pool.block_sizes.end()) {
+      uint64_t rounded = it->second;
+      if (pool.cached_bytes + rounded <= device_pool_cache_bytes) {
+        pool.free_blocks[rounded].push_back(ptr);
+        pool.cached_bytes += rounded;
+        return;
+      }
+      pool.block_sizes.erase(it);
+    }
+  }
+  cuda_drop_async(ptr, (cudaStream_t *)stream, gpu_idx);
+}
+
 // CUDA memory utils function /////////////////////////////////////////////////
 
 void *memcpy_async_bsk_to_gpu(mlir::concretelang::RuntimeContext *context,
@@ -39,13 +129,19 @@ void *memcpy_async_ksk_to_gpu(mlir::concretelang::RuntimeContext *context,
                               stream);
 }
 
+void *memcpy_async_pksk_to_gpu(mlir::concretelang::RuntimeContext *context,
+                               uint32_t gpu_idx, void *stream) {
+  return context->get_pksk_gpu(gpu_idx, stream);
+}
+
 void *alloc_and_memcpy_async_to_gpu(uint64_t *buf_ptr, uint64_t buf_offset,
                                     uint64_t buf_size, uint32_t gpu_idx,
                                     void *stream) {
   size_t buf_size_ = buf_size * sizeof(uint64_t);
-  void *ct_gpu = cuda_malloc_async(buf_size_, (cudaStream_t *)stream, gpu_idx);
+  void *ct_gpu = cuda_malloc_pooled(buf_size_, stream, gpu_idx);
   cuda_memcpy_async_to_gpu(ct_gpu, buf_ptr + buf_offset, buf_size_,
                            (cudaStream_t *)stream, gpu_idx);
+  recordGpuTransfer(buf_size_, true);
   return ct_gpu;
 }
 
@@ -55,12 +151,192 @@ void memcpy_async_to_cpu(uint64_t *buf_ptr, uint64_t buf_offset,
   cuda_memcpy_async_to_cpu(buf_ptr + buf_offset, buf_gpu,
                            buf_size * sizeof(uint64_t), (cudaStream_t *)stream,
                            gpu_idx);
+  recordGpuTransfer(buf_size * sizeof(uint64_t), false);
 }
 
 void free_from_gpu(void *gpu_ptr, uint32_t gpu_idx = 0) {
   cuda_drop(gpu_ptr, gpu_idx);
 }
 
+// Device-resident intermediate ciphertexts ///////////////////////////////////
+//
+// Each CUDA entry point uploads its inputs and downloads its result, so a
+// chain of device-placed ops crosses the PCIe bus twice per op even though
+// every kernel runs on the same GPU. When the lowering proves that a result
+// buffer is only read by other CUDA entry points, it passes the number of
+// those readers as a trailing argument; the producer then hands its device
+// buffer over to the table below instead of copying it back, and the
+// readers adopt the device copy instead of re-uploading the host one. The
+// host copy of a published buffer is never written, so entries must only be
+// created when the lowering proved that no host reader exists. Producers
+// synchronize their stream before returning, so a published buffer is
+// complete when a reader adopts it.
+namespace {
+struct GPUCiphertextResidency {
+  struct Entry {
+    void *device_ptr;
+    uint32_t remaining_readers;
+  };
+
+  static GPUCiphertextResidency &instance() {
+    static GPUCiphertextResidency residency;
+    return residency;
+  }
+
+  void publish(const uint64_t *host_ptr, void *device_ptr, uint32_t readers) {
+    std::lock_guard<std::mutex> guard(mutex);
+    entries[host_ptr] = {device_ptr, readers};
+  }
+
+  // Returns the device copy published for `host_ptr`, or nullptr. Sets
+  // `last` when the caller is the final expected reader and must recycle
+  // the device buffer once its kernel completed.
+  void *consume(const uint64_t *host_ptr, bool *last) {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto it = entries.find(host_ptr);
+    if (it == entries.end()) {
+      *last = false;
+      return nullptr;
+    }
+    void *device_ptr = it->second.device_ptr;
+    *last = --it->second.remaining_readers == 0;
+    if (*last)
+      entries.erase(it);
+    return device_ptr;
+  }
+
+private:
+  std::mutex mutex;
+  std::map<const uint64_t *, Entry> entries;
+};
+} // namespace
+
+// Returns a device copy of a ciphertext input, either adopted from the
+// residency table (no transfer) or freshly uploaded from the host. Sets
+// `free_after_use` when the caller must recycle the buffer once its kernel
+// completed; an adopted copy with further readers pending is left in
+// place.
+static void *get_or_upload_ct_to_gpu(uint64_t *buf_aligned, uint64_t buf_offset,
+                                     uint64_t buf_size, bool *free_after_use,
+                                     uint32_t gpu_idx, void *stream) {
+  void *ct_gpu = GPUCiphertextResidency::instance().consume(
+      buf_aligned + buf_offset, free_after_use);
+  if (ct_gpu != nullptr)
+    return ct_gpu;
+  *free_after_use = true;
+  return alloc_and_memcpy_async_to_gpu(buf_aligned, buf_offset, buf_size,
+                                       gpu_idx, stream);
+}
+
+// Either hands the device result over to the residency table for
+// `out_device_readers` downstream CUDA readers or copies it back to the
+// host. Returns true when ownership moved to the table and the caller must
+// not recycle the buffer.
+static bool publish_or_memcpy_to_cpu(uint64_t *out_aligned, uint64_t out_offset,
+                                     uint64_t out_batch_size, void *out_gpu,
+                                     uint32_t out_device_readers,
+                                     uint32_t gpu_idx, void *stream) {
+  if (out_device_readers > 0) {
+    GPUCiphertextResidency::instance().publish(out_aligned + out_offset,
+                                               out_gpu, out_device_readers);
+    return true;
+  }
+  memcpy_async_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu, gpu_idx,
+                      stream);
+  return false;
+}
+
+// Scalar low-latency PBS /////////////////////////////////////////////////////
+//
+// Interactive circuits issue many batch-1 PBS calls through
+// memref_bootstrap_lwe_cuda_u64. Routed through the batched entry, each
+// call pays stream creation, device buffer allocation and the amortized
+// kernel's scratch setup, which dominate the kernel time at batch 1. The
+// contexts below keep, per GPU and parameter set, a dedicated stream,
+// device staging buffers for one input and one output ciphertext, a
+// zeroed test vector index and the scratch buffer of the low-latency
+// kernel, so a scalar call only uploads one ciphertext, launches the
+// low-latency kernel and downloads one ciphertext.
+// CONCRETE_CUDA_SCALAR_PBS=0 reverts to the batched path.
+
+namespace {
+struct ScalarPBSContext {
+  void *stream;
+  int8_t *pbs_buffer;
+  void *in_gpu;
+  void *out_gpu;
+  void *test_vector_idxes_gpu;
+};
+
+typedef std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>
+    ScalarPBSKey;
+
+// Free-list of scalar PBS contexts, keyed by GPU and parameter set.
+// Concurrent scalar calls each acquire their own context, so they
+// proceed on distinct streams and scratch buffers.
+struct ScalarPBSContextPool {
+  static ScalarPBSContextPool &instance() {
+    static ScalarPBSContextPool pool;
+    return pool;
+  }
+
+  ScalarPBSContext *acquire(uint32_t gpu_idx, uint32_t input_lwe_dim,
+                            uint32_t glwe_dim, uint32_t poly_size,
+                            uint32_t level) {
+    ScalarPBSKey key{gpu_idx, input_lwe_dim, glwe_dim, poly_size, level};
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      auto it = free_contexts.find(key);
+      if (it != free_contexts.end() && !it->second.empty()) {
+        ScalarPBSContext *ctx = it->second.back();
+        it->second.pop_back();
+        return ctx;
+      }
+    }
+    ScalarPBSContext *ctx = new ScalarPBSContext();
+    ctx->stream = cuda_create_stream(gpu_idx);
+    ctx->pbs_buffer = nullptr;
+    scratch_cuda_bootstrap_low_latency_64(
+        ctx->stream, gpu_idx, &ctx->pbs_buffer, glwe_dim, poly_size, level, 1,
+        cuda_get_max_shared_memory(gpu_idx), true);
+    ctx->in_gpu = cuda_malloc_pooled((input_lwe_dim + 1) * sizeof(uint64_t),
+                                     ctx->stream, gpu_idx);
+    ctx->out_gpu =
+        cuda_malloc_pooled((glwe_dim * poly_size + 1) * sizeof(uint64_t),
+                           ctx->stream, gpu_idx);
+    // The single test vector index is zero for the lifetime of the
+    // context, upload it once
+    uint64_t test_vector_idx = 0;
+    ctx->test_vector_idxes_gpu =
+        cuda_malloc_pooled(sizeof(uint64_t), ctx->stream, gpu_idx);
+    cuda_memcpy_async_to_gpu(ctx->test_vector_idxes_gpu, &test_vector_idx,
+                             sizeof(uint64_t), (cudaStream_t *)ctx->stream,
+                             gpu_idx);
+    cudaStreamSynchronize(*(cudaStream_t *)ctx->stream);
+    return ctx;
+  }
+
+  void release(uint32_t gpu_idx, uint32_t input_lwe_dim, uint32_t glwe_dim,
+               uint32_t poly_size, uint32_t level, ScalarPBSContext *ctx) {
+    ScalarPBSKey key{gpu_idx, input_lwe_dim, glwe_dim, poly_size, level};
+    const std::lock_guard<std::mutex> guard(mutex);
+    free_contexts[key].push_back(ctx);
+  }
+
+private:
+  std::mutex mutex;
+  std::map<ScalarPBSKey, std::vector<ScalarPBSContext *>> free_contexts;
+};
+
+bool use_scalar_fast_pbs() {
+  static bool use_p = []() {
+    char *env = getenv("CONCRETE_CUDA_SCALAR_PBS");
+    return env == nullptr || strtoul(env, NULL, 10) != 0;
+  }();
+  return use_p;
+}
+} // namespace
+
 // Single ciphertext CUDA functions ///////////////////////////////////////////
 
 void memref_keyswitch_lwe_cuda_u64(
@@ -69,7 +345,7 @@ void memref_keyswitch_lwe_cuda_u64(
     uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
     uint64_t ct0_stride, uint32_t level, uint32_t base_log,
     uint32_t input_lwe_dim, uint32_t output_lwe_dim, uint32_t ksk_index,
-    mlir::concretelang::RuntimeContext *context) {
+    mlir::concretelang::RuntimeContext *context, uint32_t out_device_readers) {
   assert(out_stride == 1);
   assert(ct0_stride == 1);
   memref_batched_keyswitch_lwe_cuda_u64(
@@ -78,7 +354,8 @@ void memref_keyswitch_lwe_cuda_u64(
       // Output 1D memref as 2D memref
       ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size, ct0_stride,
       // Keyswitch additional arguments
-      level, base_log, input_lwe_dim, output_lwe_dim, ksk_index, context);
+      level, base_log, input_lwe_dim, output_lwe_dim, ksk_index, context,
+      out_device_readers);
 }
 
 void memref_bootstrap_lwe_cuda_u64(
@@ -89,16 +366,125 @@ void memref_bootstrap_lwe_cuda_u64(
     uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
     uint32_t input_lwe_dim, uint32_t poly_size, uint32_t level,
     uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
-    mlir::concretelang::RuntimeContext *context) {
-  memref_batched_bootstrap_lwe_cuda_u64(
-      // Output 1D memref as 2D memref
+    mlir::concretelang::RuntimeContext *context, uint32_t out_device_readers) {
+  if (!use_scalar_fast_pbs()) {
+    memref_batched_bootstrap_lwe_cuda_u64(
+        // Output 1D memref as 2D memref
+        out_allocated, out_aligned, out_offset, 1, out_size, out_size,
+        out_stride,
+        // Input 1D memref as 2D memref
+        ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size,
+        ct0_stride,
+        // Table lookup memref
+        tlu_allocated, tlu_aligned, tlu_offset, tlu_size, tlu_stride,
+        // Bootstrap additional arguments
+        input_lwe_dim, poly_size, level, base_log, glwe_dim, bsk_index, context,
+        out_device_readers);
+    return;
+  }
+  assert(bsk_index == 0 && "multiple bsk is not yet implemented on GPU");
+  assert(out_size == glwe_dim * poly_size + 1);
+  assert(ct0_size == input_lwe_dim + 1);
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, 1, bsk_index);
+  uint32_t gpu_idx = 0;
+  ScalarPBSContext *ctx = ScalarPBSContextPool::instance().acquire(
+      gpu_idx, input_lwe_dim, glwe_dim, poly_size, level);
+  void *stream = ctx->stream;
+  // Get the pointer on the bootstraping key on the GPU
+  void *fbsk_gpu = memcpy_async_bsk_to_gpu(context, input_lwe_dim, poly_size,
+                                           level, glwe_dim, gpu_idx, stream);
+  // Adopt a device-resident input or copy it into the staging buffer
+  bool ct0_free;
+  void *ct0_gpu = GPUCiphertextResidency::instance().consume(
+      ct0_aligned + ct0_offset, &ct0_free);
+  if (ct0_gpu == nullptr) {
+    cuda_memcpy_async_to_gpu(ctx->in_gpu, ct0_aligned + ct0_offset,
+                             ct0_size * sizeof(uint64_t),
+                             (cudaStream_t *)stream, gpu_idx);
+    recordGpuTransfer(ct0_size * sizeof(uint64_t), true);
+    ct0_gpu = ctx->in_gpu;
+    ct0_free = false;
+  }
+  // Get the device-resident glwe accumulator for this table; distinct
+  // tables are uploaded once per device and shared across invocations
+  void *glwe_ct_gpu = mlir::concretelang::GPULutPool::instance().get(
+      gpu_idx, tlu_aligned + tlu_offset, glwe_dim, poly_size, 1, stream);
+  // A published output buffer changes hands, so it cannot come from the
+  // context: give downstream readers their own pooled buffer
+  void *out_gpu = ctx->out_gpu;
+  if (out_device_readers > 0)
+    out_gpu = cuda_malloc_pooled(out_size * sizeof(uint64_t), stream, gpu_idx);
+  // Run the low-latency bootstrap kernel on the GPU, with the scratch
+  // preallocated in the context
+  cuda_bootstrap_low_latency_lwe_ciphertext_vector_64(
+      stream, gpu_idx, out_gpu, glwe_ct_gpu, ctx->test_vector_idxes_gpu,
+      ct0_gpu, fbsk_gpu, ctx->pbs_buffer, input_lwe_dim, glwe_dim, poly_size,
+      base_log, level, /*num_samples=*/1, /*num_lut_vectors=*/1, /*lwe_idx=*/0,
+      cuda_get_max_shared_memory(gpu_idx));
+  // Hand the result over to the next CUDA reader or copy it back to CPU
+  if (out_device_readers > 0)
+    GPUCiphertextResidency::instance().publish(out_aligned + out_offset,
+                                               out_gpu, out_device_readers);
+  else
+    memcpy_async_to_cpu(out_aligned, out_offset, out_size, out_gpu, gpu_idx,
+                        stream);
+  cudaStreamSynchronize(*(cudaStream_t *)stream);
+  // Recycle an adopted input whose readers are exhausted; the staging
+  // buffers stay with the context
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  ScalarPBSContextPool::instance().release(gpu_idx, input_lwe_dim, glwe_dim,
+                                           poly_size, level, ctx);
+}
+
+// Single ciphertext levelled CUDA functions; the batched variants below
+// hold the actual logic.
+
+void memref_add_lwe_ciphertexts_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *ct1_allocated, uint64_t *ct1_aligned,
+    uint64_t ct1_offset, uint64_t ct1_size, uint64_t ct1_stride,
+    uint32_t out_device_readers) {
+  memref_batched_add_lwe_ciphertexts_cuda_u64(
       out_allocated, out_aligned, out_offset, 1, out_size, out_size, out_stride,
-      // Input 1D memref as 2D memref
       ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size, ct0_stride,
-      // Table lookup memref
-      tlu_allocated, tlu_aligned, tlu_offset, tlu_size, tlu_stride,
-      // Bootstrap additional arguments
-      input_lwe_dim, poly_size, level, base_log, glwe_dim, bsk_index, context);
+      ct1_allocated, ct1_aligned, ct1_offset, 1, ct1_size, ct1_size, ct1_stride,
+      out_device_readers);
+}
+
+void memref_add_plaintext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t plaintext, uint32_t out_device_readers) {
+  memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64(
+      out_allocated, out_aligned, out_offset, 1, out_size, out_size, out_stride,
+      ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size, ct0_stride,
+      plaintext, out_device_readers);
+}
+
+void memref_mul_cleartext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t cleartext, uint32_t out_device_readers) {
+  memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64(
+      out_allocated, out_aligned, out_offset, 1, out_size, out_size, out_stride,
+      ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size, ct0_stride,
+      cleartext, out_device_readers);
+}
+
+void memref_negate_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint32_t out_device_readers) {
+  memref_batched_negate_lwe_ciphertext_cuda_u64(
+      out_allocated, out_aligned, out_offset, 1, out_size, out_size, out_stride,
+      ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size, ct0_stride,
+      out_device_readers);
 }
 
 // Batched CUDA function //////////////////////////////////////////////////////
@@ -110,10 +496,12 @@ void memref_batched_keyswitch_lwe_cuda_u64(
     uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
     uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t level,
     uint32_t base_log, uint32_t input_lwe_dim, uint32_t output_lwe_dim,
-    uint32_t ksk_index, mlir::concretelang::RuntimeContext *context) {
+    uint32_t ksk_index, mlir::concretelang::RuntimeContext *context,
+    uint32_t out_device_readers) {
   assert(ksk_index == 0 && "multiple ksk is not yet implemented on GPU");
   assert(out_size0 == ct0_size0);
   assert(out_size1 == output_lwe_dim + 1);
+  CallTimer timer(RUNTIME_STATS_OP_KEYSWITCH, out_size0, ksk_index);
   assert(ct0_size1 == input_lwe_dim + 1);
   // TODO: Multi GPU
   uint32_t gpu_idx = 0;
@@ -127,26 +515,131 @@ void memref_batched_keyswitch_lwe_cuda_u64(
   // Get the pointer on the keyswitching key on the GPU
   void *ksk_gpu = memcpy_async_ksk_to_gpu(context, level, input_lwe_dim,
                                           output_lwe_dim, gpu_idx, stream);
-  // Move the input and output batch of ciphertexts to the GPU
+  // Adopt a device-resident input or move it to the GPU
   // TODO: The allocation should be done by the compiler codegen
-  void *ct0_gpu = alloc_and_memcpy_async_to_gpu(
-      ct0_aligned, ct0_offset, ct0_batch_size, gpu_idx, (cudaStream_t *)stream);
-  void *out_gpu = cuda_malloc_async(out_batch_size * sizeof(uint64_t),
-                                    (cudaStream_t *)stream, gpu_idx);
+  bool ct0_free;
+  void *ct0_gpu = get_or_upload_ct_to_gpu(ct0_aligned, ct0_offset,
+                                          ct0_batch_size, &ct0_free, gpu_idx,
+                                          stream);
+  void *out_gpu = cuda_malloc_pooled(out_batch_size * sizeof(uint64_t), stream,
+                                     gpu_idx);
   // Run the keyswitch kernel on the GPU
   cuda_keyswitch_lwe_ciphertext_vector_64(
       stream, gpu_idx, out_gpu, ct0_gpu, ksk_gpu, input_lwe_dim, output_lwe_dim,
       base_log, level, num_samples);
-  // Copy the output batch of ciphertext back to CPU
+  // Hand the result over to the next CUDA reader or copy it back to CPU
+  bool out_kept =
+      publish_or_memcpy_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu,
+                               out_device_readers, gpu_idx, stream);
+  cuda_synchronize_device(gpu_idx);
+  // Recycle the device buffers, now idle after the synchronization
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  if (!out_kept)
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
+  cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
+}
+
+void memref_batched_fp_keyswitch_lwe_to_glwe_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t level,
+    uint32_t base_log, uint32_t input_lwe_dim, uint32_t glwe_dim,
+    uint32_t poly_size, uint32_t pksk_index,
+    mlir::concretelang::RuntimeContext *context) {
+  assert(pksk_index == 0 && "multiple pksk is not yet implemented on GPU");
+  assert(out_size0 == ct0_size0);
+  assert(out_size1 == (glwe_dim + 1) * poly_size);
+  CallTimer timer(RUNTIME_STATS_OP_KEYSWITCH, out_size0, pksk_index);
+  assert(ct0_size1 == input_lwe_dim + 1);
+  // TODO: Multi GPU
+  uint32_t gpu_idx = 0;
+  uint32_t num_samples = out_size0;
+  uint64_t ct0_batch_size = ct0_size0 * ct0_size1;
+  uint64_t out_batch_size = out_size0 * out_size1;
+
+  // Create the cuda stream
+  void *stream = cuda_create_stream(gpu_idx);
+  // Get the pointer on the packing keyswitch key on the GPU
+  void *pksk_gpu = memcpy_async_pksk_to_gpu(context, gpu_idx, stream);
+  // Move the input batch of ciphertexts to the GPU
+  void *ct0_gpu = alloc_and_memcpy_async_to_gpu(
+      ct0_aligned, ct0_offset, ct0_batch_size, gpu_idx, (cudaStream_t *)stream);
+  void *out_gpu = cuda_malloc_pooled(out_batch_size * sizeof(uint64_t), stream,
+                                     gpu_idx);
+  // Pack each input LWE of the batch into its own GLWE on the GPU
+  cuda_fp_keyswitch_lwe_to_glwe_64(stream, gpu_idx, out_gpu, ct0_gpu, pksk_gpu,
+                                   input_lwe_dim, glwe_dim, poly_size, base_log,
+                                   level, num_samples, 1);
+  // Copy the output batch of ciphertexts back to CPU
   memcpy_async_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu, gpu_idx,
                       stream);
   cuda_synchronize_device(gpu_idx);
-  // free memory that we allocated on gpu
-  cuda_drop(ct0_gpu, gpu_idx);
-  cuda_drop(out_gpu, gpu_idx);
+  // Recycle the device buffers, now idle after the synchronization
+  cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  cuda_free_pooled(out_gpu, stream, gpu_idx);
   cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
 }
 
+void memref_keyswitch_bootstrap_lwe_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
+    uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
+    uint64_t ct0_stride, uint64_t *tlu_allocated, uint64_t *tlu_aligned,
+    uint64_t tlu_offset, uint64_t tlu_size, uint64_t tlu_stride,
+    uint32_t ks_level, uint32_t ks_base_log, uint32_t ks_input_lwe_dim,
+    uint32_t ks_output_lwe_dim, uint32_t ksk_index, uint32_t input_lwe_dim,
+    uint32_t poly_size, uint32_t level, uint32_t base_log, uint32_t glwe_dim,
+    uint32_t bsk_index, mlir::concretelang::RuntimeContext *context) {
+  memref_batched_keyswitch_bootstrap_lwe_cuda_u64(
+      // Output 1D memref as 2D memref
+      out_allocated, out_aligned, out_offset, 1, out_size, out_size, out_stride,
+      // Input 1D memref as 2D memref
+      ct0_allocated, ct0_aligned, ct0_offset, 1, ct0_size, ct0_size, ct0_stride,
+      // Table lookup memref
+      tlu_allocated, tlu_aligned, tlu_offset, tlu_size, tlu_stride,
+      // Keyswitch additional arguments
+      ks_level, ks_base_log, ks_input_lwe_dim, ks_output_lwe_dim, ksk_index,
+      // Bootstrap additional arguments
+      input_lwe_dim, poly_size, level, base_log, glwe_dim, bsk_index, context);
+}
+
+// Hybrid CPU+GPU batched PBS /////////////////////////////////////////////////
+//
+// Sending the whole batch to the GPU leaves the host cores idle, and for
+// mid-size batches neither device alone is optimal. The batched bootstrap
+// wrappers below split the batch: the head goes to the GPU and the tail runs
+// concurrently through the CPU backend on a host thread (whose OpenMP pool
+// uses all cores). The GPU share of the batch is a calibrated throughput
+// ratio, set with CONCRETE_HYBRID_PBS_GPU_SHARE in [0, 1], e.g. 0.8 when the
+// GPU sustains 4x the CPU throughput. The default of 1 keeps the GPU-only
+// behavior for uncalibrated deployments.
+
+static double hybrid_pbs_gpu_share_init() {
+  char *env = getenv("CONCRETE_HYBRID_PBS_GPU_SHARE");
+  if (env != nullptr) {
+    double share = atof(env);
+    if (share >= 0.0 && share <= 1.0)
+      return share;
+  }
+  return 1.0;
+}
+static double hybrid_pbs_gpu_share = hybrid_pbs_gpu_share_init();
+
+// Number of trailing samples of the batch to run on the CPU backend. Small
+// batches are not worth splitting.
+static uint64_t hybrid_pbs_cpu_samples(uint64_t num_samples) {
+  if (num_samples < 64)
+    return 0;
+  return (uint64_t)(num_samples * (1.0 - hybrid_pbs_gpu_share));
+}
+
+// Set while the GPU head of a split batch is dispatched on this thread, so
+// the recursive call does not split again.
+static thread_local bool hybrid_pbs_splitting = false;
+
 void memref_batched_bootstrap_lwe_cuda_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
@@ -156,10 +649,46 @@ void memref_batched_bootstrap_lwe_cuda_u64(
     uint64_t *tlu_aligned, uint64_t tlu_offset, uint64_t tlu_size,
     uint64_t tlu_stride, uint32_t input_lwe_dim, uint32_t poly_size,
     uint32_t level, uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
-    mlir::concretelang::RuntimeContext *context) {
+    mlir::concretelang::RuntimeContext *context, uint32_t out_device_readers) {
   assert(bsk_index == 0 && "multiple bsk is not yet implemented on GPU");
+  // A device-resident input has no valid host copy, so a hybrid split
+  // cannot route part of the batch through the CPU backend: adopt the
+  // device copy and keep the whole batch on the GPU.
+  bool ct0_free;
+  void *ct0_resident = GPUCiphertextResidency::instance().consume(
+      ct0_aligned + ct0_offset, &ct0_free);
+  uint64_t cpu_samples = (hybrid_pbs_splitting || ct0_resident != nullptr)
+                             ? 0
+                             : hybrid_pbs_cpu_samples(out_size0);
+  if (cpu_samples > 0) {
+    uint64_t gpu_samples = out_size0 - cpu_samples;
+    // Bootstrap the tail of the batch on the CPU while the head runs on the
+    // GPU
+    std::thread cpu_worker([=]() {
+      memref_batched_bootstrap_lwe_u64(
+          out_allocated, out_aligned, out_offset + gpu_samples * out_size1,
+          cpu_samples, out_size1, out_stride0, out_stride1, ct0_allocated,
+          ct0_aligned, ct0_offset + gpu_samples * ct0_size1, cpu_samples,
+          ct0_size1, ct0_stride0, ct0_stride1, tlu_allocated, tlu_aligned,
+          tlu_offset, tlu_size, tlu_stride, input_lwe_dim, poly_size, level,
+          base_log, glwe_dim, bsk_index, context);
+    });
+    hybrid_pbs_splitting = true;
+    // The result is only whole on the host once both halves finished, so
+    // the GPU head cannot be published for downstream readers.
+    memref_batched_bootstrap_lwe_cuda_u64(
+        out_allocated, out_aligned, out_offset, gpu_samples, out_size1,
+        out_stride0, out_stride1, ct0_allocated, ct0_aligned, ct0_offset,
+        gpu_samples, ct0_size1, ct0_stride0, ct0_stride1, tlu_allocated,
+        tlu_aligned, tlu_offset, tlu_size, tlu_stride, input_lwe_dim, poly_size,
+        level, base_log, glwe_dim, bsk_index, context, 0);
+    hybrid_pbs_splitting = false;
+    cpu_worker.join();
+    return;
+  }
   assert(out_size0 == ct0_size0);
   assert(out_size1 == glwe_dim * poly_size + 1);
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, out_size0, bsk_index);
   // TODO: Multi GPU
   uint32_t gpu_idx = 0;
   uint32_t num_samples = out_size0;
@@ -173,63 +702,141 @@ void memref_batched_bootstrap_lwe_cuda_u64(
   // Get the pointer on the bootstraping key on the GPU
   void *fbsk_gpu = memcpy_async_bsk_to_gpu(context, input_lwe_dim, poly_size,
                                            level, glwe_dim, gpu_idx, stream);
-  // Move the input and output batch of ciphertext to the GPU
+  // Use the adopted device-resident input or move it to the GPU
   // TODO: The allocation should be done by the compiler codegen
-  void *ct0_gpu = alloc_and_memcpy_async_to_gpu(
-      ct0_aligned, ct0_offset, ct0_batch_size, gpu_idx, (cudaStream_t *)stream);
-  void *out_gpu = cuda_malloc_async(out_batch_size * sizeof(uint64_t),
-                                    (cudaStream_t *)stream, gpu_idx);
-  // Construct the glwe accumulator (on CPU)
-  // TODO: Should be done outside of the bootstrap call, compile time if
-  // possible. Refactor in progress
-  uint64_t glwe_ct_size = poly_size * (glwe_dim + 1);
-  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
-  auto tlu = tlu_aligned + tlu_offset;
-
-  // Glwe trivial encryption
-  for (size_t i = 0; i < poly_size * glwe_dim; i++) {
-    glwe_ct[i] = 0;
-  }
-  for (size_t i = 0; i < poly_size; i++) {
-    glwe_ct[poly_size * glwe_dim + i] = tlu[i];
+  void *ct0_gpu = ct0_resident;
+  if (ct0_gpu == nullptr) {
+    ct0_gpu = alloc_and_memcpy_async_to_gpu(ct0_aligned, ct0_offset,
+                                            ct0_batch_size, gpu_idx,
+                                            (cudaStream_t *)stream);
+    ct0_free = true;
   }
-
-  // Move the glwe accumulator to the GPU
-  void *glwe_ct_gpu = alloc_and_memcpy_async_to_gpu(
-      glwe_ct, 0, glwe_ct_size, gpu_idx, (cudaStream_t *)stream);
+  void *out_gpu = cuda_malloc_pooled(out_batch_size * sizeof(uint64_t), stream,
+                                     gpu_idx);
+  // Get the device-resident glwe accumulator for this table; distinct
+  // tables are uploaded once per device and shared across invocations
+  void *glwe_ct_gpu = mlir::concretelang::GPULutPool::instance().get(
+      gpu_idx, tlu_aligned + tlu_offset, glwe_dim, poly_size, 1, stream);
 
   // Move test vector indexes to the GPU, the test vector indexes is set of 0
   uint32_t num_test_vectors = 1, lwe_idx = 0,
            test_vector_idxes_size = num_samples * sizeof(uint64_t);
   void *test_vector_idxes = malloc(test_vector_idxes_size);
   memset(test_vector_idxes, 0, test_vector_idxes_size);
-  void *test_vector_idxes_gpu = cuda_malloc_async(
-      test_vector_idxes_size, (cudaStream_t *)stream, gpu_idx);
+  void *test_vector_idxes_gpu =
+      cuda_malloc_pooled(test_vector_idxes_size, stream, gpu_idx);
   cuda_memcpy_async_to_gpu(test_vector_idxes_gpu, test_vector_idxes,
                            test_vector_idxes_size, (cudaStream_t *)stream,
                            gpu_idx);
+  recordGpuTransfer(test_vector_idxes_size, true);
   // Allocate PBS buffer on GPU
-  scratch_cuda_bootstrap_amortized_64(
-      stream, gpu_idx, &pbs_buffer, glwe_dim, poly_size, num_samples,
+  scratch_cuda_bootstrap_dispatch_64(
+      stream, gpu_idx, &pbs_buffer, glwe_dim, poly_size, level, num_samples,
       cuda_get_max_shared_memory(gpu_idx), true);
-  // Run the bootstrap kernel on the GPU
-  cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+  // Run whichever bootstrap kernel wins at this batch size on the GPU
+  cuda_bootstrap_dispatch_lwe_ciphertext_vector_64(
       stream, gpu_idx, out_gpu, glwe_ct_gpu, test_vector_idxes_gpu, ct0_gpu,
       fbsk_gpu, pbs_buffer, input_lwe_dim, glwe_dim, poly_size, base_log, level,
       num_samples, num_test_vectors, lwe_idx,
       cuda_get_max_shared_memory(gpu_idx));
+  cleanup_cuda_bootstrap_dispatch(stream, gpu_idx, &pbs_buffer);
+  // Hand the result over to the next CUDA reader or copy it back to CPU
+  bool out_kept =
+      publish_or_memcpy_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu,
+                               out_device_readers, gpu_idx, stream);
+  cudaStreamSynchronize(*(cudaStream_t *)stream);
+  // Recycle the device buffers, now idle after the synchronization; the
+  // glwe accumulator stays resident in the LUT pool
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  if (!out_kept)
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
+  cuda_free_pooled(test_vector_idxes_gpu, stream, gpu_idx);
+  cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
+}
+
+void memref_batched_keyswitch_bootstrap_lwe_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *tlu_allocated,
+    uint64_t *tlu_aligned, uint64_t tlu_offset, uint64_t tlu_size,
+    uint64_t tlu_stride, uint32_t ks_level, uint32_t ks_base_log,
+    uint32_t ks_input_lwe_dim, uint32_t ks_output_lwe_dim, uint32_t ksk_index,
+    uint32_t input_lwe_dim, uint32_t poly_size, uint32_t level,
+    uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
+    mlir::concretelang::RuntimeContext *context) {
+  assert(ksk_index == 0 && "multiple ksk is not yet implemented on GPU");
+  assert(bsk_index == 0 && "multiple bsk is not yet implemented on GPU");
+  assert(out_size0 == ct0_size0);
+  assert(out_size1 == glwe_dim * poly_size + 1);
+  assert(ct0_size1 == ks_input_lwe_dim + 1);
+  assert(ks_output_lwe_dim == input_lwe_dim);
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, out_size0, bsk_index);
+  // TODO: Multi GPU
+  uint32_t gpu_idx = 0;
+  uint32_t num_samples = out_size0;
+  uint64_t ct0_batch_size = ct0_size0 * ct0_size1;
+  uint64_t out_batch_size = out_size0 * out_size1;
+  int8_t *pbs_buffer = nullptr;
+
+  // Create the cuda stream
+  // TODO: Should be created by the compiler codegen
+  void *stream = cuda_create_stream(gpu_idx);
+  // Get the pointers on the keyswitch and bootstraping keys on the GPU
+  void *ksk_gpu = memcpy_async_ksk_to_gpu(context, ks_level, ks_input_lwe_dim,
+                                          ks_output_lwe_dim, gpu_idx, stream);
+  void *fbsk_gpu = memcpy_async_bsk_to_gpu(context, input_lwe_dim, poly_size,
+                                           level, glwe_dim, gpu_idx, stream);
+  // Adopt a device-resident input batch or move it to the GPU; the
+  // keyswitched intermediate ciphertexts stay on the device, only the
+  // bootstrapped outputs come back.
+  // TODO: The allocation should be done by the compiler codegen
+  bool ct0_free;
+  void *ct0_gpu = get_or_upload_ct_to_gpu(ct0_aligned, ct0_offset,
+                                          ct0_batch_size, &ct0_free, gpu_idx,
+                                          stream);
+  void *out_gpu = cuda_malloc_pooled(out_batch_size * sizeof(uint64_t), stream,
+                                     gpu_idx);
+  // Get the device-resident glwe accumulator for this table; distinct
+  // tables are uploaded once per device and shared across invocations
+  void *glwe_ct_gpu = mlir::concretelang::GPULutPool::instance().get(
+      gpu_idx, tlu_aligned + tlu_offset, glwe_dim, poly_size, 1, stream);
+
+  // Move test vector indexes to the GPU, the test vector indexes is set of 0
+  uint32_t num_test_vectors = 1, lwe_idx = 0,
+           test_vector_idxes_size = num_samples * sizeof(uint64_t);
+  void *test_vector_idxes = malloc(test_vector_idxes_size);
+  memset(test_vector_idxes, 0, test_vector_idxes_size);
+  void *test_vector_idxes_gpu =
+      cuda_malloc_pooled(test_vector_idxes_size, stream, gpu_idx);
+  cuda_memcpy_async_to_gpu(test_vector_idxes_gpu, test_vector_idxes,
+                           test_vector_idxes_size, (cudaStream_t *)stream,
+                           gpu_idx);
+  recordGpuTransfer(test_vector_idxes_size, true);
+  // Allocate PBS buffer on GPU
+  scratch_cuda_bootstrap_amortized_64(
+      stream, gpu_idx, &pbs_buffer, glwe_dim, poly_size, num_samples,
+      cuda_get_max_shared_memory(gpu_idx), true);
+  // Run the chained keyswitch + bootstrap kernels on the GPU
+  cuda_keyswitch_bootstrap_amortized_lwe_ciphertext_vector_64(
+      stream, gpu_idx, out_gpu, glwe_ct_gpu, test_vector_idxes_gpu, ct0_gpu,
+      ksk_gpu, fbsk_gpu, pbs_buffer, ks_input_lwe_dim, ks_output_lwe_dim,
+      ks_base_log, ks_level, glwe_dim, poly_size, base_log, level, num_samples,
+      num_test_vectors, lwe_idx, cuda_get_max_shared_memory(gpu_idx));
   cleanup_cuda_bootstrap_amortized(stream, gpu_idx, &pbs_buffer);
   // Copy the output batch of ciphertext back to CPU
   memcpy_async_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu, gpu_idx,
                       stream);
-  // free memory that we allocated on gpu
-  cuda_drop_async(ct0_gpu, (cudaStream_t *)stream, gpu_idx);
-  cuda_drop_async(out_gpu, (cudaStream_t *)stream, gpu_idx);
-  cuda_drop_async(glwe_ct_gpu, (cudaStream_t *)stream, gpu_idx);
-  cuda_drop_async(test_vector_idxes_gpu, (cudaStream_t *)stream, gpu_idx);
   cudaStreamSynchronize(*(cudaStream_t *)stream);
-  // Free the glwe accumulator (on CPU)
-  free(glwe_ct);
+  // Recycle the device buffers, now idle after the synchronization; the
+  // glwe accumulator stays resident in the LUT pool
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  cuda_free_pooled(out_gpu, stream, gpu_idx);
+  cuda_free_pooled(test_vector_idxes_gpu, stream, gpu_idx);
+  free(test_vector_idxes);
   cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
 }
 
@@ -249,6 +856,46 @@ void memref_batched_mapped_bootstrap_lwe_cuda_u64(
   assert(out_size1 == glwe_dim * poly_size + 1);
   assert((out_size0 == tlu_size0 || tlu_size0 == 1) &&
          "Number of LUTs does not match batch size");
+  uint64_t cpu_samples =
+      hybrid_pbs_splitting ? 0 : hybrid_pbs_cpu_samples(out_size0);
+  if (cpu_samples > 0) {
+    uint64_t gpu_samples = out_size0 - cpu_samples;
+    // Bootstrap the tail of the batch on the CPU while the head runs on the
+    // GPU. With a single shared LUT the tail goes through the non-mapped CPU
+    // wrapper, whose signature takes the LUT as a 1D memref.
+    std::thread cpu_worker([=]() {
+      if (tlu_size0 == 1) {
+        memref_batched_bootstrap_lwe_u64(
+            out_allocated, out_aligned, out_offset + gpu_samples * out_size1,
+            cpu_samples, out_size1, out_stride0, out_stride1, ct0_allocated,
+            ct0_aligned, ct0_offset + gpu_samples * ct0_size1, cpu_samples,
+            ct0_size1, ct0_stride0, ct0_stride1, tlu_allocated, tlu_aligned,
+            tlu_offset, tlu_size1, tlu_stride1, input_lwe_dim, poly_size, level,
+            base_log, glwe_dim, bsk_index, context);
+      } else {
+        memref_batched_mapped_bootstrap_lwe_u64(
+            out_allocated, out_aligned, out_offset + gpu_samples * out_size1,
+            cpu_samples, out_size1, out_stride0, out_stride1, ct0_allocated,
+            ct0_aligned, ct0_offset + gpu_samples * ct0_size1, cpu_samples,
+            ct0_size1, ct0_stride0, ct0_stride1, tlu_allocated, tlu_aligned,
+            tlu_offset + gpu_samples * tlu_size1, cpu_samples, tlu_size1,
+            tlu_stride0, tlu_stride1, input_lwe_dim, poly_size, level, base_log,
+            glwe_dim, bsk_index, context);
+      }
+    });
+    hybrid_pbs_splitting = true;
+    memref_batched_mapped_bootstrap_lwe_cuda_u64(
+        out_allocated, out_aligned, out_offset, gpu_samples, out_size1,
+        out_stride0, out_stride1, ct0_allocated, ct0_aligned, ct0_offset,
+        gpu_samples, ct0_size1, ct0_stride0, ct0_stride1, tlu_allocated,
+        tlu_aligned, tlu_offset, tlu_size0 == 1 ? 1 : gpu_samples, tlu_size1,
+        tlu_stride0, tlu_stride1, input_lwe_dim, poly_size, level, base_log,
+        glwe_dim, bsk_index, context);
+    hybrid_pbs_splitting = false;
+    cpu_worker.join();
+    return;
+  }
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, out_size0, bsk_index);
   // TODO: Multi GPU
   uint32_t gpu_idx = 0;
   uint32_t num_samples = out_size0;
@@ -256,6 +903,10 @@ void memref_batched_mapped_bootstrap_lwe_cuda_u64(
   uint64_t ct0_batch_size = ct0_size0 * ct0_size1;
   uint64_t out_batch_size = out_size0 * out_size1;
   int8_t *pbs_buffer = nullptr;
+  // Large batches go through the pipelined driver, which splits the batch
+  // into tiles and double-buffers upload/compute/download on internal
+  // streams; only the accumulators and LUT indexes are uploaded up front
+  bool use_pipeline = num_samples >= 4096;
 
   // Create the cuda stream
   // TODO: Should be created by the compiler codegen
@@ -263,33 +914,46 @@ void memref_batched_mapped_bootstrap_lwe_cuda_u64(
   // Get the pointer on the bootstraping key on the GPU
   void *fbsk_gpu = memcpy_async_bsk_to_gpu(context, input_lwe_dim, poly_size,
                                            level, glwe_dim, gpu_idx, stream);
-  // Move the input and output batch of ciphertext to the GPU
+  // Move the input and output batch of ciphertext to the GPU; the
+  // pipelined driver transfers them tile by tile instead
   // TODO: The allocation should be done by the compiler codegen
-  void *ct0_gpu = alloc_and_memcpy_async_to_gpu(
-      ct0_aligned, ct0_offset, ct0_batch_size, gpu_idx, (cudaStream_t *)stream);
-  void *out_gpu = cuda_malloc_async(out_batch_size * sizeof(uint64_t),
-                                    (cudaStream_t *)stream, gpu_idx);
-  // Construct the glwe accumulator (on CPU)
-  // TODO: Should be done outside of the bootstrap call, compile time if
-  // possible. Refactor in progress
-  uint64_t glwe_ct_size = poly_size * (glwe_dim + 1) * num_lut_vectors;
-  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
-  auto tlu = tlu_aligned + tlu_offset;
-
-  // Glwe trivial encryption
-  size_t pos = 0, postlu = 0;
-  for (size_t l = 0; l < num_lut_vectors; ++l) {
-    for (size_t i = 0; i < poly_size * glwe_dim; i++) {
-      glwe_ct[pos++] = 0;
-    }
-    for (size_t i = 0; i < poly_size; i++) {
-      glwe_ct[pos++] = tlu[postlu++];
-    }
+  void *ct0_gpu = nullptr;
+  void *out_gpu = nullptr;
+  if (!use_pipeline) {
+    ct0_gpu = alloc_and_memcpy_async_to_gpu(ct0_aligned, ct0_offset,
+                                            ct0_batch_size, gpu_idx,
+                                            (cudaStream_t *)stream);
+    out_gpu = cuda_malloc_pooled(out_batch_size * sizeof(uint64_t), stream,
+                                 gpu_idx);
   }
+  // Construct or fetch the glwe accumulator. A single shared table comes
+  // from the device-resident LUT pool; per-sample tables are batch
+  // specific and keep the per-call upload.
+  uint64_t *glwe_ct = nullptr;
+  void *glwe_ct_gpu;
+  if (num_lut_vectors == 1) {
+    glwe_ct_gpu = mlir::concretelang::GPULutPool::instance().get(
+        gpu_idx, tlu_aligned + tlu_offset, glwe_dim, poly_size, 1, stream);
+  } else {
+    uint64_t glwe_ct_size = poly_size * (glwe_dim + 1) * num_lut_vectors;
+    glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
+    auto tlu = tlu_aligned + tlu_offset;
+
+    // Glwe trivial encryption
+    size_t pos = 0, postlu = 0;
+    for (size_t l = 0; l < num_lut_vectors; ++l) {
+      for (size_t i = 0; i < poly_size * glwe_dim; i++) {
+        glwe_ct[pos++] = 0;
+      }
+      for (size_t i = 0; i < poly_size; i++) {
+        glwe_ct[pos++] = tlu[postlu++];
+      }
+    }
 
-  // Move the glwe accumulator to the GPU
-  void *glwe_ct_gpu = alloc_and_memcpy_async_to_gpu(
-      glwe_ct, 0, glwe_ct_size, gpu_idx, (cudaStream_t *)stream);
+    // Move the glwe accumulator to the GPU
+    glwe_ct_gpu = alloc_and_memcpy_async_to_gpu(
+        glwe_ct, 0, glwe_ct_size, gpu_idx, (cudaStream_t *)stream);
+  }
 
   // Move test vector indexes to the GPU, the test vector indexes is set of 0
   uint32_t lwe_idx = 0, test_vector_idxes_size = num_samples * sizeof(uint64_t);
@@ -301,38 +965,386 @@ void memref_batched_mapped_bootstrap_lwe_cuda_u64(
     for (size_t i = 0; i < num_lut_vectors; ++i)
       test_vector_idxes[i] = i;
   }
-  void *test_vector_idxes_gpu = cuda_malloc_async(
-      test_vector_idxes_size, (cudaStream_t *)stream, gpu_idx);
+  void *test_vector_idxes_gpu =
+      cuda_malloc_pooled(test_vector_idxes_size, stream, gpu_idx);
   cuda_memcpy_async_to_gpu(test_vector_idxes_gpu, (void *)test_vector_idxes,
                            test_vector_idxes_size, (cudaStream_t *)stream,
                            gpu_idx);
-  // Allocate PBS buffer on GPU
-  scratch_cuda_bootstrap_amortized_64(
-      stream, gpu_idx, &pbs_buffer, glwe_dim, poly_size, num_samples,
-      cuda_get_max_shared_memory(gpu_idx), true);
-  // Run the bootstrap kernel on the GPU
-  cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
-      stream, gpu_idx, out_gpu, glwe_ct_gpu, test_vector_idxes_gpu, ct0_gpu,
-      fbsk_gpu, pbs_buffer, input_lwe_dim, glwe_dim, poly_size, base_log, level,
-      num_samples, num_lut_vectors, lwe_idx,
-      cuda_get_max_shared_memory(gpu_idx));
-  cleanup_cuda_bootstrap_amortized(stream, gpu_idx, &pbs_buffer);
-  // Copy the output batch of ciphertext back to CPU
-  memcpy_async_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu, gpu_idx,
-                      stream);
-  // free memory that we allocated on gpu
-  cuda_drop_async(ct0_gpu, (cudaStream_t *)stream, gpu_idx);
-  cuda_drop_async(out_gpu, (cudaStream_t *)stream, gpu_idx);
-  cuda_drop_async(glwe_ct_gpu, (cudaStream_t *)stream, gpu_idx);
-  cuda_drop_async(test_vector_idxes_gpu, (cudaStream_t *)stream, gpu_idx);
+  recordGpuTransfer(test_vector_idxes_size, true);
+  if (use_pipeline) {
+    // Tile the batch and overlap transfers with compute; the call returns
+    // with the outputs on the host
+    cuda_bootstrap_amortized_pipelined_lwe_ciphertext_vector_64(
+        stream, gpu_idx, out_aligned + out_offset, glwe_ct_gpu,
+        test_vector_idxes_gpu, ct0_aligned + ct0_offset, fbsk_gpu,
+        input_lwe_dim, glwe_dim, poly_size, base_log, level, num_samples,
+        num_lut_vectors, cuda_get_max_shared_memory(gpu_idx), 0);
+    recordGpuTransfer(ct0_batch_size * sizeof(uint64_t), true);
+    recordGpuTransfer(out_batch_size * sizeof(uint64_t), false);
+  } else {
+    // Allocate PBS buffer on GPU
+    scratch_cuda_bootstrap_amortized_64(
+        stream, gpu_idx, &pbs_buffer, glwe_dim, poly_size, num_samples,
+        cuda_get_max_shared_memory(gpu_idx), true);
+    // Run the bootstrap kernel on the GPU
+    cuda_bootstrap_amortized_lwe_ciphertext_vector_64(
+        stream, gpu_idx, out_gpu, glwe_ct_gpu, test_vector_idxes_gpu, ct0_gpu,
+        fbsk_gpu, pbs_buffer, input_lwe_dim, glwe_dim, poly_size, base_log,
+        level, num_samples, num_lut_vectors, lwe_idx,
+        cuda_get_max_shared_memory(gpu_idx));
+    cleanup_cuda_bootstrap_amortized(stream, gpu_idx, &pbs_buffer);
+    // Copy the output batch of ciphertext back to CPU
+    memcpy_async_to_cpu(out_aligned, out_offset, out_batch_size, out_gpu,
+                        gpu_idx, stream);
+  }
   cudaStreamSynchronize(*(cudaStream_t *)stream);
-  // Free the glwe accumulator (on CPU)
-  free(glwe_ct);
+  // Recycle the device buffers, now idle after the synchronization
+  if (!use_pipeline) {
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
+  }
+  // Pooled LUT accumulators stay resident on the device
+  if (glwe_ct != nullptr) {
+    cuda_free_pooled(glwe_ct_gpu, stream, gpu_idx);
+    free(glwe_ct);
+  }
+  cuda_free_pooled(test_vector_idxes_gpu, stream, gpu_idx);
+  cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
+}
+
+// Batched levelled CUDA functions ////////////////////////////////////////////
+//
+// In isolation the two transfers of a levelled op dwarf its kernel, so the
+// lowering only routes a levelled op here when it is part of a chain of
+// CUDA entry points: the inputs are then adopted from the residency table
+// and the result handed over to it, and the chain runs without touching
+// the host.
+
+void memref_batched_add_lwe_ciphertexts_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *ct1_allocated,
+    uint64_t *ct1_aligned, uint64_t ct1_offset, uint64_t ct1_size0,
+    uint64_t ct1_size1, uint64_t ct1_stride0, uint64_t ct1_stride1,
+    uint32_t out_device_readers) {
+  assert(out_size0 == ct0_size0 && out_size0 == ct1_size0);
+  assert(out_size1 == ct0_size1 && out_size1 == ct1_size1);
+  // TODO: Multi GPU
+  uint32_t gpu_idx = 0;
+  uint32_t num_samples = out_size0;
+  uint64_t batch_size = out_size0 * out_size1;
+
+  void *stream = cuda_create_stream(gpu_idx);
+  bool ct0_free, ct1_free;
+  void *ct0_gpu = get_or_upload_ct_to_gpu(ct0_aligned, ct0_offset, batch_size,
+                                          &ct0_free, gpu_idx, stream);
+  void *ct1_gpu = get_or_upload_ct_to_gpu(ct1_aligned, ct1_offset, batch_size,
+                                          &ct1_free, gpu_idx, stream);
+  void *out_gpu =
+      cuda_malloc_pooled(batch_size * sizeof(uint64_t), stream, gpu_idx);
+  cuda_add_lwe_ciphertext_vector_64(stream, gpu_idx, out_gpu, ct0_gpu, ct1_gpu,
+                                    out_size1 - 1, num_samples);
+  bool out_kept =
+      publish_or_memcpy_to_cpu(out_aligned, out_offset, batch_size, out_gpu,
+                               out_device_readers, gpu_idx, stream);
+  cuda_synchronize_device(gpu_idx);
+  // Recycle the device buffers, now idle after the synchronization. Both
+  // inputs may adopt the same device buffer; at most one of the flags is
+  // set in that case.
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  if (ct1_free)
+    cuda_free_pooled(ct1_gpu, stream, gpu_idx);
+  if (!out_kept)
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
+  cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
+}
+
+void memref_batched_add_plaintext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *pt_allocated,
+    uint64_t *pt_aligned, uint64_t pt_offset, uint64_t pt_size,
+    uint64_t pt_stride, uint32_t out_device_readers) {
+  assert(out_size0 == ct0_size0 && out_size0 == pt_size);
+  assert(out_size1 == ct0_size1);
+  // TODO: Multi GPU
+  uint32_t gpu_idx = 0;
+  uint32_t num_samples = out_size0;
+  uint64_t batch_size = out_size0 * out_size1;
+
+  void *stream = cuda_create_stream(gpu_idx);
+  bool ct0_free;
+  void *ct0_gpu = get_or_upload_ct_to_gpu(ct0_aligned, ct0_offset, batch_size,
+                                          &ct0_free, gpu_idx, stream);
+  // Plaintexts are never device resident, upload them directly
+  void *pt_gpu = alloc_and_memcpy_async_to_gpu(pt_aligned, pt_offset, pt_size,
+                                               gpu_idx, stream);
+  void *out_gpu =
+      cuda_malloc_pooled(batch_size * sizeof(uint64_t), stream, gpu_idx);
+  cuda_add_lwe_ciphertext_vector_plaintext_vector_64(
+      stream, gpu_idx, out_gpu, ct0_gpu, pt_gpu, out_size1 - 1, num_samples);
+  bool out_kept =
+      publish_or_memcpy_to_cpu(out_aligned, out_offset, batch_size, out_gpu,
+                               out_device_readers, gpu_idx, stream);
+  cuda_synchronize_device(gpu_idx);
+  // Recycle the device buffers, now idle after the synchronization
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  cuda_free_pooled(pt_gpu, stream, gpu_idx);
+  if (!out_kept)
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
+  cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
+}
+
+void memref_batched_add_plaintext_cst_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t plaintext,
+    uint32_t out_device_readers) {
+  // The kernel takes one plaintext per sample; replicate the constant
+  std::vector<uint64_t> plaintexts(out_size0, plaintext);
+  memref_batched_add_plaintext_lwe_ciphertext_cuda_u64(
+      out_allocated, out_aligned, out_offset, out_size0, out_size1, out_stride0,
+      out_stride1, ct0_allocated, ct0_aligned, ct0_offset, ct0_size0, ct0_size1,
+      ct0_stride0, ct0_stride1, plaintexts.data(), plaintexts.data(), 0,
+      out_size0, 1, out_device_readers);
+}
+
+void memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t *ct_allocated,
+    uint64_t *ct_aligned, uint64_t ct_offset, uint64_t ct_size,
+    uint64_t ct_stride, uint32_t out_device_readers) {
+  assert(out_size0 == ct0_size0 && out_size0 == ct_size);
+  assert(out_size1 == ct0_size1);
+  // TODO: Multi GPU
+  uint32_t gpu_idx = 0;
+  uint32_t num_samples = out_size0;
+  uint64_t batch_size = out_size0 * out_size1;
+
+  void *stream = cuda_create_stream(gpu_idx);
+  bool ct0_free;
+  void *ct0_gpu = get_or_upload_ct_to_gpu(ct0_aligned, ct0_offset, batch_size,
+                                          &ct0_free, gpu_idx, stream);
+  // Cleartexts are never device resident, upload them directly
+  void *ct_gpu = alloc_and_memcpy_async_to_gpu(ct_aligned, ct_offset, ct_size,
+                                               gpu_idx, stream);
+  void *out_gpu =
+      cuda_malloc_pooled(batch_size * sizeof(uint64_t), stream, gpu_idx);
+  cuda_mult_lwe_ciphertext_vector_cleartext_vector_64(
+      stream, gpu_idx, out_gpu, ct0_gpu, ct_gpu, out_size1 - 1, num_samples);
+  bool out_kept =
+      publish_or_memcpy_to_cpu(out_aligned, out_offset, batch_size, out_gpu,
+                               out_device_readers, gpu_idx, stream);
+  cuda_synchronize_device(gpu_idx);
+  // Recycle the device buffers, now idle after the synchronization
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  cuda_free_pooled(ct_gpu, stream, gpu_idx);
+  if (!out_kept)
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
+  cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
+}
+
+void memref_batched_mul_cleartext_cst_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint64_t cleartext,
+    uint32_t out_device_readers) {
+  // The kernel takes one cleartext per sample; replicate the constant
+  std::vector<uint64_t> cleartexts(out_size0, cleartext);
+  memref_batched_mul_cleartext_lwe_ciphertext_cuda_u64(
+      out_allocated, out_aligned, out_offset, out_size0, out_size1, out_stride0,
+      out_stride1, ct0_allocated, ct0_aligned, ct0_offset, ct0_size0, ct0_size1,
+      ct0_stride0, ct0_stride1, cleartexts.data(), cleartexts.data(), 0,
+      out_size0, 1, out_device_readers);
+}
+
+void memref_batched_negate_lwe_ciphertext_cuda_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t out_device_readers) {
+  assert(out_size0 == ct0_size0);
+  assert(out_size1 == ct0_size1);
+  // TODO: Multi GPU
+  uint32_t gpu_idx = 0;
+  uint32_t num_samples = out_size0;
+  uint64_t batch_size = out_size0 * out_size1;
+
+  void *stream = cuda_create_stream(gpu_idx);
+  bool ct0_free;
+  void *ct0_gpu = get_or_upload_ct_to_gpu(ct0_aligned, ct0_offset, batch_size,
+                                          &ct0_free, gpu_idx, stream);
+  void *out_gpu =
+      cuda_malloc_pooled(batch_size * sizeof(uint64_t), stream, gpu_idx);
+  cuda_negate_lwe_ciphertext_vector_64(stream, gpu_idx, out_gpu, ct0_gpu,
+                                       out_size1 - 1, num_samples);
+  bool out_kept =
+      publish_or_memcpy_to_cpu(out_aligned, out_offset, batch_size, out_gpu,
+                               out_device_readers, gpu_idx, stream);
+  cuda_synchronize_device(gpu_idx);
+  // Recycle the device buffers, now idle after the synchronization
+  if (ct0_free)
+    cuda_free_pooled(ct0_gpu, stream, gpu_idx);
+  if (!out_kept)
+    cuda_free_pooled(out_gpu, stream, gpu_idx);
   cuda_destroy_stream((cudaStream_t *)stream, gpu_idx);
 }
 
 #endif
 
+// NUMA-aware scratch placement ///////////////////////////////////////////////
+//
+// On multi-socket machines a large part of the remote-memory stalls of the
+// PBS paths comes from the scratch and accumulator temporaries: returning
+// them to the allocator between calls lets the next call fault the pages on
+// whichever node the allocator recycles them from. In NUMA-aware mode (the
+// default; disable with CONCRETE_NUMA_AWARE=OFF or runtime_set_numa_aware)
+// each thread keeps its scratch and GLWE accumulator across calls, so the
+// pages stay on the node where the worker first touched them. The batched
+// loops use a static schedule for a stable iteration-to-thread mapping,
+// which keeps the first-touch placement of ciphertext batches consistent
+// across repeated invocations.
+
+static bool numa_aware_init() {
+  char *env = getenv("CONCRETE_NUMA_AWARE");
+  if (env != nullptr && (strcmp(env, "OFF") == 0 || strcmp(env, "off") == 0 ||
+                         strcmp(env, "0") == 0))
+    return false;
+  return true;
+}
+static bool numa_aware_p = numa_aware_init();
+
+void runtime_set_numa_aware(int enable) { numa_aware_p = enable != 0; }
+int runtime_get_numa_aware() { return numa_aware_p ? 1 : 0; }
+
+// Execution profile of the calling thread and the count of batched calls
+// currently in flight, used in throughput mode to give each concurrent
+// invocation an equal share of the OpenMP workers.
+static thread_local int execution_profile = RUNTIME_PROFILE_LATENCY;
+static std::atomic<size_t> active_batched_calls{0};
+
+void runtime_set_execution_profile(int profile) {
+  execution_profile = profile;
+  // GPU work of a latency invocation goes on high-priority streams so it
+  // preempts the streams of throughput invocations.
+  stream_emulator_set_invocation_priority(
+      profile == RUNTIME_PROFILE_LATENCY ? 1 : 0);
+}
+int runtime_get_execution_profile() { return execution_profile; }
+
+namespace {
+// Worker share of one batched call: all workers in latency mode, an
+// equal split between the in-flight batched calls in throughput mode.
+struct BatchedCallShare {
+  int threads;
+  bool counted;
+  BatchedCallShare() {
+    counted = execution_profile == RUNTIME_PROFILE_THROUGHPUT;
+    if (counted) {
+      size_t active = active_batched_calls.fetch_add(1) + 1;
+      threads = std::max(1, omp_get_max_threads() / (int)active);
+    } else {
+      threads = omp_get_max_threads();
+    }
+  }
+  ~BatchedCallShare() {
+    if (counted)
+      active_batched_calls.fetch_sub(1);
+  }
+};
+} // namespace
+
+namespace {
+// One cached scratch slab of a thread. Slabs are cached per size class:
+// the scratch size and alignment are a function of the cryptographic
+// parameters of the key (polynomial size, GLWE dimension, decomposition
+// level), so a circuit only ever sees as many classes as it has distinct
+// evaluation keys and every class keeps its slab across invocations.
+struct ScratchSlab {
+  uint8_t *mem = nullptr;
+  size_t size = 0;
+  size_t align = 0;
+  bool in_use = false;
+};
+struct ThreadScratchArena {
+  std::vector<ScratchSlab> slabs;
+  uint64_t *glwe_ct = nullptr;
+  size_t glwe_ct_size = 0;
+  ~ThreadScratchArena() {
+    for (auto &slab : slabs)
+      free(slab.mem);
+    free(glwe_ct);
+  }
+};
+static thread_local ThreadScratchArena thread_scratch_arena;
+
+// Scratch buffer of the calling thread, served from the slab cache in
+// NUMA-aware mode and freshly allocated otherwise. Steady-state execution
+// hits an existing slab and performs no heap allocation.
+uint8_t *scratch_acquire(size_t align, size_t size) {
+  if (!numa_aware_p)
+    return (uint8_t *)aligned_alloc(align, size);
+  ThreadScratchArena &arena = thread_scratch_arena;
+  for (auto &slab : arena.slabs) {
+    if (!slab.in_use && slab.size == size && slab.align >= align) {
+      slab.in_use = true;
+      return slab.mem;
+    }
+  }
+  ScratchSlab slab;
+  slab.mem = (uint8_t *)aligned_alloc(align, size);
+  slab.size = size;
+  slab.align = align;
+  slab.in_use = true;
+  arena.slabs.push_back(slab);
+  return slab.mem;
+}
+
+// GLWE accumulator of the calling thread, same policy as the scratch.
+uint64_t *glwe_ct_acquire(size_t size) {
+  if (!numa_aware_p)
+    return (uint64_t *)malloc(size * sizeof(uint64_t));
+  ThreadScratchArena &arena = thread_scratch_arena;
+  if (arena.glwe_ct_size < size) {
+    free(arena.glwe_ct);
+    arena.glwe_ct = (uint64_t *)malloc(size * sizeof(uint64_t));
+    arena.glwe_ct_size = size;
+  }
+  return arena.glwe_ct;
+}
+
+// Release counterparts: only free buffers that do not belong to the arena,
+// so toggling the mode between acquire and release stays safe.
+void scratch_release(uint8_t *scratch) {
+  for (auto &slab : thread_scratch_arena.slabs) {
+    if (slab.mem == scratch) {
+      slab.in_use = false;
+      return;
+    }
+  }
+  free(scratch);
+}
+void glwe_ct_release(uint64_t *glwe_ct) {
+  if (glwe_ct != thread_scratch_arena.glwe_ct)
+    free(glwe_ct);
+}
+} // namespace
+
 void memref_encode_plaintext_with_crt(
     uint64_t *output_allocated, uint64_t *output_aligned,
     uint64_t output_offset, uint64_t output_size, uint64_t output_stride,
@@ -354,6 +1366,80 @@ void memref_encode_plaintext_with_crt(
   return;
 }
 
+namespace {
+
+// Expands and encodes a bootstrap test vector. The expansion writes runs
+// of a constant, so it is expressed as fills the compiler can vectorize
+// instead of an element-wise loop going through an indexing closure.
+void expand_lut_for_bootstrap(uint64_t *out, size_t output_size,
+                              const uint64_t *in, size_t input_size,
+                              uint32_t out_MESSAGE_BITS, bool is_signed) {
+  size_t mega_case_size = output_size / input_size;
+
+  assert((mega_case_size % 2) == 0);
+
+  // When the bootstrap is executed on encrypted signed integers, the lut
+  // must be half-rotated; folding the rotation into the encoding lookup
+  // takes care about properly indexing into the input lut depending on
+  // what bootstrap gets executed.
+  size_t half_rotate = is_signed ? input_size / 2 : 0;
+  auto encoded = [=](size_t idx) {
+    return in[(idx + half_rotate) % input_size] << (64 - out_MESSAGE_BITS - 1);
+  };
+
+  // The first lut value should be centered over zero. This means that half of
+  // it should appear at the beginning of the output lut, and half of it at the
+  // end (but negated).
+  std::fill_n(out, mega_case_size / 2, encoded(0));
+  std::fill_n(out + (input_size - 1) * mega_case_size + mega_case_size / 2,
+              mega_case_size / 2, -encoded(0));
+
+  // Treats the other lut values.
+  for (size_t lut_idx = 1; lut_idx < input_size; ++lut_idx) {
+    std::fill_n(out + mega_case_size * (lut_idx - 1) + mega_case_size / 2,
+                mega_case_size, encoded(lut_idx));
+  }
+}
+
+// Expanded test vectors, keyed by the table contents and the encoding
+// parameters. The expansion rebuilds a polynomial-size vector on every
+// bootstrap even though the tables are circuit constants, so the set of
+// distinct expansions is small and bounded; like the other runtime
+// caches in this file the entries live for the process lifetime.
+struct ExpandedLutCache {
+  static ExpandedLutCache &instance() {
+    static ExpandedLutCache cache;
+    return cache;
+  }
+
+  void encode(uint64_t *out, size_t output_size, const uint64_t *in,
+              size_t input_size, uint32_t out_MESSAGE_BITS, bool is_signed) {
+    Key key{std::vector<uint64_t>(in, in + input_size), output_size,
+            out_MESSAGE_BITS, is_signed};
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      auto it = entries.find(key);
+      if (it != entries.end()) {
+        memcpy(out, it->second.data(), output_size * sizeof(uint64_t));
+        return;
+      }
+    }
+    expand_lut_for_bootstrap(out, output_size, in, input_size,
+                             out_MESSAGE_BITS, is_signed);
+    std::lock_guard<std::mutex> guard(mutex);
+    entries.emplace(std::move(key),
+                    std::vector<uint64_t>(out, out + output_size));
+  }
+
+private:
+  using Key = std::tuple<std::vector<uint64_t>, size_t, uint32_t, bool>;
+
+  std::mutex mutex;
+  std::map<Key, std::vector<uint64_t>> entries;
+};
+
+} // namespace
+
 void memref_encode_expand_lut_for_bootstrap(
     uint64_t *output_lut_allocated, uint64_t *output_lut_aligned,
     uint64_t output_lut_offset, uint64_t output_lut_size,
@@ -368,52 +1454,10 @@ void memref_encode_expand_lut_for_bootstrap(
   assert(output_lut_stride == 1 && "Runtime: stride not equal to 1, check "
                                    "memref_encode_expand_lut_bootstrap");
 
-  size_t mega_case_size = output_lut_size / input_lut_size;
-
-  assert((mega_case_size % 2) == 0);
-
-  // When the bootstrap is executed on encrypted signed integers, the lut must
-  // be half-rotated. This map takes care about properly indexing into the input
-  // lut depending on what bootstrap gets executed.
-  std::function<size_t(size_t)> indexMap;
-  if (is_signed) {
-    size_t halfInputSize = input_lut_size / 2;
-    indexMap = [=](size_t idx) {
-      if (idx < halfInputSize) {
-        return idx + halfInputSize;
-      } else {
-        return idx - halfInputSize;
-      }
-    };
-  } else {
-    indexMap = [=](size_t idx) { return idx; };
-  }
-
-  // The first lut value should be centered over zero. This means that half of
-  // it should appear at the beginning of the output lut, and half of it at the
-  // end (but negated).
-  for (size_t idx = 0; idx < mega_case_size / 2; ++idx) {
-    output_lut_aligned[output_lut_offset + idx] =
-        input_lut_aligned[input_lut_offset + indexMap(0)]
-        << (64 - out_MESSAGE_BITS - 1);
-  }
-  for (size_t idx = (input_lut_size - 1) * mega_case_size + mega_case_size / 2;
-       idx < output_lut_size; ++idx) {
-    output_lut_aligned[output_lut_offset + idx] =
-        -(input_lut_aligned[input_lut_offset + indexMap(0)]
-          << (64 - out_MESSAGE_BITS - 1));
-  }
-
-  // Treats the other ut values.
-  for (size_t lut_idx = 1; lut_idx < input_lut_size; ++lut_idx) {
-    uint64_t lut_value = input_lut_aligned[input_lut_offset + indexMap(lut_idx)]
-                         << (64 - out_MESSAGE_BITS - 1);
-    size_t start = mega_case_size * (lut_idx - 1) + mega_case_size / 2;
-    for (size_t output_idx = start; output_idx < start + mega_case_size;
-         ++output_idx) {
-      output_lut_aligned[output_lut_offset + output_idx] = lut_value;
-    }
-  }
+  ExpandedLutCache::instance().encode(
+      output_lut_aligned + output_lut_offset, output_lut_size,
+      input_lut_aligned + input_lut_offset, input_lut_size, out_MESSAGE_BITS,
+      is_signed);
 
   return;
 }
@@ -546,6 +1590,54 @@ void memref_encode_lut_for_crt_woppbs(
   }
 }
 
+// Levelled elementwise kernels ///////////////////////////////////////////////
+//
+// The levelled linear-algebra wrappers below used to forward each ciphertext
+// to concrete-cpu, whose scalar loops are not vectorized and dominate the
+// lowered FHELinalg dot/matmul code. The kernels here are plain wrapping u64
+// loops the compiler can vectorize; on x86-64, target_clones additionally
+// compiles AVX2 and AVX-512 versions next to the baseline one and resolves
+// the best match at load time from the CPU features (ifunc dispatch). On
+// aarch64 the single clone auto-vectorizes to NEON.
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define CONCRETELANG_LEVELLED_KERNEL                                           \
+  __attribute__((target_clones("default", "avx2", "avx512f")))
+#endif
+#endif
+#ifndef CONCRETELANG_LEVELLED_KERNEL
+#define CONCRETELANG_LEVELLED_KERNEL
+#endif
+
+CONCRETELANG_LEVELLED_KERNEL
+static void levelled_add_lwe_u64(uint64_t *out, const uint64_t *ct0,
+                                 const uint64_t *ct1, uint64_t size) {
+  for (uint64_t i = 0; i < size; i++) {
+    out[i] = ct0[i] + ct1[i];
+  }
+}
+
+CONCRETELANG_LEVELLED_KERNEL
+static void levelled_mul_cleartext_lwe_u64(uint64_t *out, const uint64_t *ct0,
+                                           uint64_t cleartext, uint64_t size) {
+  for (uint64_t i = 0; i < size; i++) {
+    out[i] = ct0[i] * cleartext;
+  }
+}
+
+CONCRETELANG_LEVELLED_KERNEL
+static void levelled_negate_lwe_u64(uint64_t *out, const uint64_t *ct0,
+                                    uint64_t size) {
+  for (uint64_t i = 0; i < size; i++) {
+    out[i] = (uint64_t)0 - ct0[i];
+  }
+}
+
+// The levelled wrappers below (add, add_plaintext, mul_cleartext,
+// negate and their batched forms) accept `out` aliasing the ciphertext
+// operand: every output element depends only on the same-index input
+// elements. The bufferization relies on this to execute levelled
+// chains in place when the operand buffer is dead after the op.
 void memref_add_lwe_ciphertexts_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
@@ -554,10 +1646,8 @@ void memref_add_lwe_ciphertexts_u64(
     uint64_t ct1_offset, uint64_t ct1_size, uint64_t ct1_stride) {
   assert(out_size == ct0_size && out_size == ct1_size &&
          "size of lwe buffer are incompatible");
-  size_t lwe_dimension = out_size - 1;
-  concrete_cpu_add_lwe_ciphertext_u64(out_aligned + out_offset,
-                                      ct0_aligned + ct0_offset,
-                                      ct1_aligned + ct1_offset, lwe_dimension);
+  levelled_add_lwe_u64(out_aligned + out_offset, ct0_aligned + ct0_offset,
+                       ct1_aligned + ct1_offset, out_size);
 }
 
 void memref_add_plaintext_lwe_ciphertext_u64(
@@ -566,10 +1656,13 @@ void memref_add_plaintext_lwe_ciphertext_u64(
     uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
     uint64_t ct0_stride, uint64_t plaintext) {
   assert(out_size == ct0_size && "size of lwe buffer are incompatible");
-  size_t lwe_dimension = out_size - 1;
-  concrete_cpu_add_plaintext_lwe_ciphertext_u64(out_aligned + out_offset,
-                                                ct0_aligned + ct0_offset,
-                                                plaintext, lwe_dimension);
+  // Only the body receives the plaintext, the mask is copied as is
+  if (out_aligned + out_offset != ct0_aligned + ct0_offset) {
+    memcpy(out_aligned + out_offset, ct0_aligned + ct0_offset,
+           (out_size - 1) * sizeof(uint64_t));
+  }
+  out_aligned[out_offset + out_size - 1] =
+      ct0_aligned[ct0_offset + ct0_size - 1] + plaintext;
 }
 
 void memref_mul_cleartext_lwe_ciphertext_u64(
@@ -578,10 +1671,8 @@ void memref_mul_cleartext_lwe_ciphertext_u64(
     uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
     uint64_t ct0_stride, uint64_t cleartext) {
   assert(out_size == ct0_size && "size of lwe buffer are incompatible");
-  size_t lwe_dimension = out_size - 1;
-  concrete_cpu_mul_cleartext_lwe_ciphertext_u64(out_aligned + out_offset,
-                                                ct0_aligned + ct0_offset,
-                                                cleartext, lwe_dimension);
+  levelled_mul_cleartext_lwe_u64(out_aligned + out_offset,
+                                 ct0_aligned + ct0_offset, cleartext, out_size);
 }
 
 void memref_negate_lwe_ciphertext_u64(
@@ -590,9 +1681,8 @@ void memref_negate_lwe_ciphertext_u64(
     uint64_t *ct0_aligned, uint64_t ct0_offset, uint64_t ct0_size,
     uint64_t ct0_stride) {
   assert(out_size == ct0_size && "size of lwe buffer are incompatible");
-  size_t lwe_dimension = {out_size - 1};
-  concrete_cpu_negate_lwe_ciphertext_u64(
-      out_aligned + out_offset, ct0_aligned + ct0_offset, lwe_dimension);
+  levelled_negate_lwe_u64(out_aligned + out_offset, ct0_aligned + ct0_offset,
+                          out_size);
 }
 
 void memref_keyswitch_lwe_u64(uint64_t *out_allocated, uint64_t *out_aligned,
@@ -606,6 +1696,7 @@ void memref_keyswitch_lwe_u64(uint64_t *out_allocated, uint64_t *out_aligned,
                               uint32_t output_dimension, uint32_t ksk_index,
                               mlir::concretelang::RuntimeContext *context) {
   assert(out_stride == 1 && ct0_stride == 1);
+  CallTimer timer(RUNTIME_STATS_OP_KEYSWITCH, 1, ksk_index);
   // Get keyswitch key
   const uint64_t *keyswitch_key = context->keyswitch_key_buffer(ksk_index);
   // Get stack parameter
@@ -615,6 +1706,47 @@ void memref_keyswitch_lwe_u64(uint64_t *out_allocated, uint64_t *out_aligned,
       output_dimension);
 }
 
+// Slim scalar entry points: the compiler proved the operands contiguous
+// with static shapes, so the buffers are just their aligned pointers and
+// the descriptor plumbing of the memref entry points is skipped.
+
+void concrete_add_lwe_ciphertexts_u64(uint64_t *out, uint64_t *ct0,
+                                      uint64_t *ct1, uint64_t lwe_size) {
+  levelled_add_lwe_u64(out, ct0, ct1, lwe_size);
+}
+
+void concrete_add_plaintext_lwe_ciphertext_u64(uint64_t *out, uint64_t *ct0,
+                                               uint64_t plaintext,
+                                               uint64_t lwe_size) {
+  // Only the body receives the plaintext, the mask is copied as is
+  if (out != ct0) {
+    memcpy(out, ct0, (lwe_size - 1) * sizeof(uint64_t));
+  }
+  out[lwe_size - 1] = ct0[lwe_size - 1] + plaintext;
+}
+
+void concrete_mul_cleartext_lwe_ciphertext_u64(uint64_t *out, uint64_t *ct0,
+                                               uint64_t cleartext,
+                                               uint64_t lwe_size) {
+  levelled_mul_cleartext_lwe_u64(out, ct0, cleartext, lwe_size);
+}
+
+void concrete_negate_lwe_ciphertext_u64(uint64_t *out, uint64_t *ct0,
+                                        uint64_t lwe_size) {
+  levelled_negate_lwe_u64(out, ct0, lwe_size);
+}
+
+void concrete_keyswitch_lwe_u64(uint64_t *out, uint64_t *ct0, uint32_t level,
+                                uint32_t base_log, uint32_t input_lwe_dim,
+                                uint32_t output_lwe_dim, uint32_t ksk_index,
+                                mlir::concretelang::RuntimeContext *context) {
+  CallTimer timer(RUNTIME_STATS_OP_KEYSWITCH, 1, ksk_index);
+  const uint64_t *keyswitch_key = context->keyswitch_key_buffer(ksk_index);
+  concrete_cpu_keyswitch_lwe_ciphertext_u64(out, ct0, keyswitch_key, level,
+                                            base_log, input_lwe_dim,
+                                            output_lwe_dim);
+}
+
 void memref_batched_add_lwe_ciphertexts_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
@@ -719,6 +1851,10 @@ void memref_batched_keyswitch_lwe_u64(
     uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t level,
     uint32_t base_log, uint32_t input_lwe_dim, uint32_t output_lwe_dim,
     uint32_t ksk_index, mlir::concretelang::RuntimeContext *context) {
+  // Keyswitching every ciphertext of the batch is embarrassingly parallel
+  // and allocation free, so hand the loop to the OpenMP worker pool.
+  BatchedCallShare share;
+#pragma omp parallel for schedule(static) num_threads(share.threads)
   for (size_t i = 0; i < ct0_size0; i++) {
     memref_keyswitch_lwe_u64(
         out_allocated + i * out_size1, out_aligned + i * out_size1, out_offset,
@@ -728,6 +1864,138 @@ void memref_batched_keyswitch_lwe_u64(
   }
 }
 
+void memref_batched_glwe_pack_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t glwe_dim,
+    uint32_t poly_size, uint32_t pksk_index,
+    mlir::concretelang::RuntimeContext *context) {
+  auto params = context->fp_keyswitch_key_param(pksk_index);
+  size_t input_lwe_dim = ct0_size1 - 1;
+  size_t glwe_size = (glwe_dim + 1) * (size_t)poly_size;
+  assert((uint32_t)params.glweDimension == glwe_dim &&
+         (uint32_t)params.polynomialSize == poly_size &&
+         "packing keyswitch key does not match the requested GLWE geometry");
+  assert(params.inputLweDimension == input_lwe_dim &&
+         "packing keyswitch key does not match the input LWE dimension");
+  assert(out_size1 == glwe_size && "output is not a batch of GLWEs");
+  assert(out_size0 * poly_size >= ct0_size0 &&
+         "output batch too small for the input batch");
+
+  // The key material holds the circuit bootstrap private functional
+  // packing keyswitch key list; its last entry encodes the identity
+  // function and keyswitches an LWE into coefficient 0 of a GLWE.
+  size_t single_key_size = concrete_cpu_lwe_packing_keyswitch_key_size(
+      glwe_dim, poly_size, params.level, input_lwe_dim);
+  const uint64_t *fpksk = context->fp_keyswitch_key_buffer(pksk_index) +
+                          (size_t)glwe_dim * single_key_size;
+
+  // Each output GLWE accumulates up to poly_size keyswitched inputs, each
+  // rotated to its own slot; distinct GLWEs are independent.
+  BatchedCallShare share;
+#pragma omp parallel for schedule(static) num_threads(share.threads)
+  for (size_t g = 0; g < out_size0; g++) {
+    uint64_t *out = out_aligned + out_offset + g * out_size1;
+    memset(out, 0, glwe_size * sizeof(uint64_t));
+    auto *scratch =
+        (uint64_t *)scratch_acquire(64, glwe_size * sizeof(uint64_t));
+    for (size_t i = 0; i < poly_size; i++) {
+      size_t j = g * poly_size + i;
+      if (j >= ct0_size0)
+        break;
+      concrete_cpu_fp_keyswitch_lwe_to_glwe_u64(
+          scratch, ct0_aligned + ct0_offset + j * ct0_size1, fpksk,
+          params.level, params.baseLog, input_lwe_dim, glwe_dim, poly_size);
+      // Accumulate the keyswitched GLWE multiplied by X^i, which moves
+      // the message from coefficient 0 to slot i. The multiplication is
+      // a negacyclic rotation of every polynomial of the ciphertext.
+      for (size_t p = 0; p <= glwe_dim; p++) {
+        const uint64_t *src = scratch + p * poly_size;
+        uint64_t *dst = out + p * poly_size;
+        for (size_t k = 0; k < poly_size - i; k++)
+          dst[k + i] += src[k];
+        for (size_t k = poly_size - i; k < poly_size; k++)
+          dst[k + i - poly_size] -= src[k];
+      }
+    }
+    scratch_release((uint8_t *)scratch);
+  }
+}
+
+void memref_batched_glwe_unpack_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size0, uint64_t ct0_size1,
+    uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t glwe_dim,
+    uint32_t poly_size) {
+  assert(ct0_size1 == (glwe_dim + 1) * (size_t)poly_size &&
+         "input is not a batch of GLWEs");
+  assert(out_size1 == (size_t)glwe_dim * poly_size + 1 &&
+         "output LWE dimension does not match the GLWE geometry");
+  assert(ct0_size0 * poly_size >= out_size0 &&
+         "input batch too small for the output batch");
+
+  // Sample extraction of coefficient i is a permutation (with sign) of
+  // the GLWE mask coefficients plus one body coefficient; every output
+  // LWE is independent.
+  BatchedCallShare share;
+#pragma omp parallel for schedule(static) num_threads(share.threads)
+  for (size_t j = 0; j < out_size0; j++) {
+    size_t g = j / poly_size;
+    size_t i = j % poly_size;
+    const uint64_t *in = ct0_aligned + ct0_offset + g * ct0_size1;
+    uint64_t *lwe = out_aligned + out_offset + j * out_size1;
+    for (size_t p = 0; p < glwe_dim; p++) {
+      const uint64_t *mask_poly = in + p * poly_size;
+      uint64_t *mask = lwe + p * poly_size;
+      for (size_t k = 0; k <= i; k++)
+        mask[k] = mask_poly[i - k];
+      for (size_t k = i + 1; k < poly_size; k++)
+        mask[k] = -mask_poly[poly_size + i - k];
+    }
+    lwe[(size_t)glwe_dim * poly_size] = in[(size_t)glwe_dim * poly_size + i];
+  }
+}
+
+// Trivial GLWE encryption of a lookup table. The polynomial sizes seen in
+// production come from a small set of powers of two, so the fill is
+// specialized on the size for the common cases, giving the compiler
+// constant loop bounds to unroll, with a generic fallback for the rest.
+template <size_t polynomial_size>
+static void glwe_trivial_encrypt_tlu(uint64_t *glwe_ct, uint64_t glwe_dim,
+                                     const uint64_t *tlu) {
+  for (size_t i = 0; i < polynomial_size * glwe_dim; i++) {
+    glwe_ct[i] = 0;
+  }
+  for (size_t i = 0; i < polynomial_size; i++) {
+    glwe_ct[polynomial_size * glwe_dim + i] = tlu[i];
+  }
+}
+
+static void glwe_trivial_encrypt_tlu(uint64_t *glwe_ct, uint64_t glwe_dim,
+                                     uint64_t polynomial_size,
+                                     const uint64_t *tlu) {
+  switch (polynomial_size) {
+  case 2048:
+    glwe_trivial_encrypt_tlu<2048>(glwe_ct, glwe_dim, tlu);
+    break;
+  case 8192:
+    glwe_trivial_encrypt_tlu<8192>(glwe_ct, glwe_dim, tlu);
+    break;
+  default:
+    for (size_t i = 0; i < polynomial_size * glwe_dim; i++) {
+      glwe_ct[i] = 0;
+    }
+    for (size_t i = 0; i < polynomial_size; i++) {
+      glwe_ct[polynomial_size * glwe_dim + i] = tlu[i];
+    }
+    break;
+  }
+}
+
 void memref_bootstrap_lwe_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size, uint64_t out_stride, uint64_t *ct0_allocated,
@@ -738,29 +2006,24 @@ void memref_bootstrap_lwe_u64(
     uint32_t decomposition_level_count, uint32_t decomposition_base_log,
     uint32_t glwe_dimension, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context) {
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, 1, bsk_index);
 
   uint64_t glwe_ct_size = polynomial_size * (glwe_dimension + 1);
-  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
+  uint64_t *glwe_ct = glwe_ct_acquire(glwe_ct_size);
   auto tlu = tlu_aligned + tlu_offset;
 
   // Glwe trivial encryption
-  for (size_t i = 0; i < polynomial_size * glwe_dimension; i++) {
-    glwe_ct[i] = 0;
-  }
-  for (size_t i = 0; i < polynomial_size; i++) {
-    glwe_ct[polynomial_size * glwe_dimension + i] = tlu[i];
-  }
+  glwe_trivial_encrypt_tlu(glwe_ct, glwe_dimension, polynomial_size, tlu);
 
   // Get fourrier bootstrap key
   const auto &fft = context->fft(bsk_index);
   auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
-  // Get stack parameter
+  // Get stack parameter, precomputed when the context was built
   size_t scratch_size;
   size_t scratch_align;
-  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
-      &scratch_size, &scratch_align, glwe_dimension, polynomial_size, fft);
+  context->bootstrap_scratch(bsk_index, &scratch_size, &scratch_align);
   // Allocate scratch
-  auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  auto scratch = scratch_acquire(scratch_align, scratch_size);
 
   // Bootstrap
   concrete_cpu_bootstrap_lwe_ciphertext_u64(
@@ -769,8 +2032,39 @@ void memref_bootstrap_lwe_u64(
       glwe_dimension, polynomial_size, input_lwe_dimension, fft, scratch,
       scratch_size);
 
-  free(glwe_ct);
-  free(scratch);
+  glwe_ct_release(glwe_ct);
+  scratch_release(scratch);
+}
+
+// Slim counterpart of memref_bootstrap_lwe_u64, see the slim scalar entry
+// points above.
+void concrete_bootstrap_lwe_u64(uint64_t *out, uint64_t *ct0, uint64_t *tlu,
+                                uint32_t input_lwe_dim, uint32_t poly_size,
+                                uint32_t level, uint32_t base_log,
+                                uint32_t glwe_dim, uint32_t bsk_index,
+                                mlir::concretelang::RuntimeContext *context) {
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, 1, bsk_index);
+
+  uint64_t glwe_ct_size = poly_size * (glwe_dim + 1);
+  uint64_t *glwe_ct = glwe_ct_acquire(glwe_ct_size);
+
+  // Glwe trivial encryption
+  glwe_trivial_encrypt_tlu(glwe_ct, glwe_dim, poly_size, tlu);
+
+  const auto &fft = context->fft(bsk_index);
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+  size_t scratch_size;
+  size_t scratch_align;
+  context->bootstrap_scratch(bsk_index, &scratch_size, &scratch_align);
+  auto scratch = scratch_acquire(scratch_align, scratch_size);
+
+  concrete_cpu_bootstrap_lwe_ciphertext_u64(out, ct0, glwe_ct, bootstrap_key,
+                                            level, base_log, glwe_dim,
+                                            poly_size, input_lwe_dim, fft,
+                                            scratch, scratch_size);
+
+  glwe_ct_release(glwe_ct);
+  scratch_release(scratch);
 }
 
 void memref_batched_bootstrap_lwe_u64(
@@ -784,13 +2078,64 @@ void memref_batched_bootstrap_lwe_u64(
     uint32_t level, uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context) {
 
-  for (size_t i = 0; i < out_size0; i++) {
-    memref_bootstrap_lwe_u64(
-        out_allocated + i * out_size1, out_aligned + i * out_size1, out_offset,
-        out_size1, out_stride1, ct0_allocated, ct0_aligned + i * ct0_size1,
-        ct0_offset, ct0_size1, ct0_stride1, tlu_allocated, tlu_aligned,
-        tlu_offset, tlu_size, tlu_stride, input_lwe_dim, poly_size, level,
-        base_log, glwe_dim, bsk_index, context);
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, out_size0, bsk_index);
+  // Hoist everything shared by the whole batch (fourier key, fft plan,
+  // scratch sizing) out of the loop and bootstrap the ciphertexts in
+  // parallel on the OpenMP worker pool, each thread reusing its own scratch
+  // and trivial GLWE accumulator instead of allocating per ciphertext.
+  uint64_t glwe_ct_size = poly_size * (glwe_dim + 1);
+  auto tlu = tlu_aligned + tlu_offset;
+  const auto &fft = context->fft(bsk_index);
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+
+  // Block the batch so consecutive ciphertexts share the streamed key:
+  // the batched entry point walks the Fourier key in the outer loop, so
+  // each GGSW block is read once per block of ciphertexts instead of
+  // once per ciphertext. The block size keeps one GGSW block plus the
+  // two rotating accumulators per ciphertext within a fraction of a
+  // typical last-level cache; beyond that the accumulators start
+  // evicting the key block and the reuse is lost.
+  BatchedCallShare share;
+  size_t ggsw_block_bytes = (size_t)level * (glwe_dim + 1) * (glwe_dim + 1) *
+                            poly_size * sizeof(double);
+  size_t acc_bytes = 2 * glwe_ct_size * sizeof(uint64_t);
+  size_t cache_budget = (size_t)16 << 20;
+  size_t block_size = 1;
+  if (cache_budget > ggsw_block_bytes + acc_bytes)
+    block_size = (cache_budget - ggsw_block_bytes) / acc_bytes;
+  if (block_size < 1)
+    block_size = 1;
+  // Keep every worker busy: never block coarser than an even split of
+  // the batch over the threads.
+  size_t per_thread = (out_size0 + share.threads - 1) / share.threads;
+  if (block_size > per_thread)
+    block_size = per_thread;
+
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_batch_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratch_size, &scratch_align, block_size, glwe_dim, poly_size, fft);
+
+#pragma omp parallel num_threads(share.threads)
+  {
+    auto *glwe_ct = glwe_ct_acquire(glwe_ct_size);
+    auto *scratch = scratch_acquire(scratch_align, scratch_size);
+
+    // Glwe trivial encryption of the shared lookup table
+    glwe_trivial_encrypt_tlu(glwe_ct, glwe_dim, poly_size, tlu);
+
+#pragma omp for schedule(static)
+    for (size_t i = 0; i < out_size0; i += block_size) {
+      size_t block = std::min(block_size, (size_t)out_size0 - i);
+      concrete_cpu_batch_bootstrap_lwe_ciphertext_u64(
+          out_aligned + out_offset + i * out_size1,
+          ct0_aligned + ct0_offset + i * ct0_size1, block, glwe_ct,
+          bootstrap_key, level, base_log, glwe_dim, poly_size, input_lwe_dim,
+          fft, scratch, scratch_size);
+    }
+
+    glwe_ct_release(glwe_ct);
+    scratch_release(scratch);
   }
 }
 
@@ -806,14 +2151,42 @@ void memref_batched_mapped_bootstrap_lwe_u64(
     uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context) {
   assert(out_size0 == tlu_size0 && "Number of LUTs does not match batch size");
-  for (size_t i = 0; i < out_size0; i++) {
-    memref_bootstrap_lwe_u64(
-        out_allocated + i * out_size1, out_aligned + i * out_size1, out_offset,
-        out_size1, out_stride1, ct0_allocated, ct0_aligned + i * ct0_size1,
-        ct0_offset, ct0_size1, ct0_stride1, tlu_allocated,
-        tlu_aligned + i * tlu_size1, tlu_offset, tlu_size1, tlu_stride1,
-        input_lwe_dim, poly_size, level, base_log, glwe_dim, bsk_index,
-        context);
+  CallTimer timer(RUNTIME_STATS_OP_BOOTSTRAP, out_size0, bsk_index);
+  // Same parallel scheme as memref_batched_bootstrap_lwe_u64, except that
+  // each ciphertext comes with its own lookup table so the trivial GLWE
+  // accumulator is refilled per iteration.
+  uint64_t glwe_ct_size = poly_size * (glwe_dim + 1);
+  const auto &fft = context->fft(bsk_index);
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+  size_t scratch_size;
+  size_t scratch_align;
+  context->bootstrap_scratch(bsk_index, &scratch_size, &scratch_align);
+
+  BatchedCallShare share;
+#pragma omp parallel num_threads(share.threads)
+  {
+    auto *glwe_ct = glwe_ct_acquire(glwe_ct_size);
+    auto *scratch = scratch_acquire(scratch_align, scratch_size);
+
+    for (size_t i = 0; i < poly_size * glwe_dim; i++) {
+      glwe_ct[i] = 0;
+    }
+
+#pragma omp for schedule(static)
+    for (size_t i = 0; i < out_size0; i++) {
+      auto tlu = tlu_aligned + tlu_offset + i * tlu_size1;
+      for (size_t j = 0; j < poly_size; j++) {
+        glwe_ct[poly_size * glwe_dim + j] = tlu[j];
+      }
+      concrete_cpu_bootstrap_lwe_ciphertext_u64(
+          out_aligned + out_offset + i * out_size1,
+          ct0_aligned + ct0_offset + i * ct0_size1, glwe_ct, bootstrap_key,
+          level, base_log, glwe_dim, poly_size, input_lwe_dim, fft, scratch,
+          scratch_size);
+    }
+
+    glwe_ct_release(glwe_ct);
+    scratch_release(scratch);
   }
 }
 
@@ -847,6 +2220,7 @@ void memref_wop_pbs_crt_buffer(
     uint32_t ksk_index, uint32_t bsk_index, uint32_t pksk_index,
     // runtime context that hold evluation keys
     mlir::concretelang::RuntimeContext *context) {
+  CallTimer timer(RUNTIME_STATS_OP_WOP_PBS);
 
   // The compiler should only generates 2D memref<BxS>, where B is the number of
   // ciphertext block and S the lweSize.
@@ -900,8 +2274,12 @@ void memref_wop_pbs_crt_buffer(
   auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
   auto keyswicth_key = context->keyswitch_key_buffer(ksk_index);
 
-  for (int64_t i = crt_decomp_size - 1, extract_bits_output_offset = 0; i >= 0;
-       extract_bits_output_offset += number_of_bits_per_block[i--]) {
+  // The bit extractions of the residue blocks are independent and use the
+  // same keys: fan them out over one thread per block (writes go to
+  // disjoint slices of the output buffer, each thread acquires its own
+  // scratch), so an n-residue circuit extracts its n blocks concurrently
+  // instead of sequentially.
+  auto extract_block = [&](int64_t i, int64_t extract_bits_output_offset) {
     auto nb_bits_to_extract = number_of_bits_per_block[i];
 
     size_t delta_log = 64 - nb_bits_to_extract;
@@ -919,7 +2297,7 @@ void memref_wop_pbs_crt_buffer(
         &scratch_size, &scratch_align, lwe_small_dim, lwe_big_dim, glwe_dim,
         polynomial_size, fft);
     // Allocate scratch
-    auto *scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+    auto *scratch = scratch_acquire(scratch_align, scratch_size);
 
     concrete_cpu_extract_bit_lwe_ciphertext_u64(
         &extract_bits_output_buffer[lwe_small_size *
@@ -930,7 +2308,20 @@ void memref_wop_pbs_crt_buffer(
         ksk_level_count, ksk_base_log, lwe_big_dim, lwe_small_dim, fft, scratch,
         scratch_size);
 
-    free(scratch);
+    scratch_release(scratch);
+  };
+  if (crt_decomp_size > 1) {
+    std::vector<std::thread> extract_threads;
+    extract_threads.reserve(crt_decomp_size);
+    for (int64_t i = crt_decomp_size - 1, extract_bits_output_offset = 0;
+         i >= 0; extract_bits_output_offset += number_of_bits_per_block[i--]) {
+      extract_threads.push_back(
+          std::thread(extract_block, i, extract_bits_output_offset));
+    }
+    for (auto &thread : extract_threads)
+      thread.join();
+  } else if (crt_decomp_size == 1) {
+    extract_block(0, 0);
   }
 
   size_t ct_in_count = total_number_of_bits_per_block;
@@ -941,28 +2332,74 @@ void memref_wop_pbs_crt_buffer(
   assert(lut_ct_size0 == lut_count);
   assert(lut_ct_size1 == lut_size);
 
-  // Vertical packing
-  size_t scratch_size;
-  size_t scratch_align;
-  concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64_scratch(
-      &scratch_size, &scratch_align, ct_out_count, lwe_small_dim, ct_in_count,
-      lut_size, lut_count, glwe_dim, polynomial_size, polynomial_size,
-      cbs_level_count, fft);
-
-  auto *scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
-
   auto fp_keyswicth_key = context->fp_keyswitch_key_buffer(pksk_index);
 
-  concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(
-      out_aligned + out_offset, extract_bits_output_buffer,
-      lut_ct_aligned + lut_ct_offset, bootstrap_key, fp_keyswicth_key,
-      lwe_big_dim, ct_out_count, lwe_small_dim, ct_in_count, lut_size,
-      lut_count, bsk_level_count, bsk_base_log, glwe_dim, polynomial_size,
-      lwe_small_dim, fpksk_level_count, fpksk_base_log, lwe_big_dim, glwe_dim,
-      polynomial_size, glwe_dim + 1, cbs_level_count, cbs_base_log, fft,
-      scratch, scratch_size);
+  // Circuit bootstrap of the extracted bits. Each bit yields one Fourier
+  // GGSW written to a disjoint slice of the shared list, so like the bit
+  // extractions above they fan out over one thread per bit and join before
+  // the vertical packing reads the list.
+  size_t ggsw_size =
+      polynomial_size * (glwe_dim + 1) * (glwe_dim + 1) * cbs_level_count;
+  std::vector<double> ggsw_list(ct_in_count * ggsw_size);
 
-  free(scratch);
+  auto bootstrap_bit = [&](size_t i) {
+    size_t scratch_size;
+    size_t scratch_align;
+    concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64_scratch(
+        &scratch_size, &scratch_align, lwe_small_dim, glwe_dim,
+        polynomial_size, glwe_dim, polynomial_size, cbs_level_count, fft);
+    auto *scratch = scratch_acquire(scratch_align, scratch_size);
+
+    concrete_cpu_circuit_bootstrap_boolean_lwe_ciphertext_u64(
+        &ggsw_list[i * ggsw_size],
+        &extract_bits_output_buffer[i * lwe_small_size], bootstrap_key,
+        fp_keyswicth_key, lwe_small_dim, bsk_level_count, bsk_base_log,
+        glwe_dim, polynomial_size, lwe_small_dim, fpksk_level_count,
+        fpksk_base_log, lwe_big_dim, glwe_dim, polynomial_size, glwe_dim + 1,
+        cbs_level_count, cbs_base_log, fft, scratch, scratch_size);
+
+    scratch_release(scratch);
+  };
+  if (ct_in_count > 1) {
+    std::vector<std::thread> cbs_threads;
+    cbs_threads.reserve(ct_in_count);
+    for (size_t i = 0; i < ct_in_count; i++)
+      cbs_threads.push_back(std::thread(bootstrap_bit, i));
+    for (auto &thread : cbs_threads)
+      thread.join();
+  } else if (ct_in_count == 1) {
+    bootstrap_bit(0);
+  }
+
+  // Vertical packing of each output lut over the shared GGSW list. The
+  // packings only read the list and write disjoint output ciphertexts, so
+  // they are independent as well.
+  auto pack_lut = [&](size_t i) {
+    size_t scratch_size;
+    size_t scratch_align;
+    concrete_cpu_vertical_packing_lwe_ciphertext_u64_scratch(
+        &scratch_size, &scratch_align, lut_size, ct_in_count, glwe_dim,
+        polynomial_size, fft);
+    auto *scratch = scratch_acquire(scratch_align, scratch_size);
+
+    concrete_cpu_vertical_packing_lwe_ciphertext_u64(
+        out_aligned + out_offset + i * lwe_big_size, ggsw_list.data(),
+        lut_ct_aligned + lut_ct_offset + i * lut_size, lwe_big_dim, lut_size,
+        ct_in_count, glwe_dim, polynomial_size, cbs_level_count, cbs_base_log,
+        fft, scratch, scratch_size);
+
+    scratch_release(scratch);
+  };
+  if (lut_count > 1) {
+    std::vector<std::thread> vp_threads;
+    vp_threads.reserve(lut_count);
+    for (size_t i = 0; i < lut_count; i++)
+      vp_threads.push_back(std::thread(pack_lut, i));
+    for (auto &thread : vp_threads)
+      thread.join();
+  } else if (lut_count == 1) {
+    pack_lut(0);
+  }
 }
 
 void memref_copy_one_rank(uint64_t *src_allocated, uint64_t *src_aligned,
@@ -986,6 +2423,12 @@ void memref_trace_ciphertext(uint64_t *ct0_allocated, uint64_t *ct0_aligned,
                              uint64_t ct0_offset, uint64_t ct0_size,
                              uint64_t ct0_stride, char *message_ptr,
                              uint32_t message_len, uint32_t msb) {
+  // In trace mode the tracing ops become timeline markers: printing the
+  // ciphertext contents would perturb the timings being measured.
+  if (mlir::concretelang::runtime_trace::enabled()) {
+    mlir::concretelang::runtime_trace::recordMarker(message_ptr, message_len);
+    return;
+  }
   std::string message{message_ptr, (size_t)message_len};
   std::cout << message << " : ";
   std::bitset<64> bits{ct0_aligned[ct0_offset + ct0_size - 1]};
@@ -997,6 +2440,10 @@ void memref_trace_ciphertext(uint64_t *ct0_allocated, uint64_t *ct0_aligned,
 void memref_trace_plaintext(uint64_t input, uint64_t input_width,
                             char *message_ptr, uint32_t message_len,
                             uint32_t msb) {
+  if (mlir::concretelang::runtime_trace::enabled()) {
+    mlir::concretelang::runtime_trace::recordMarker(message_ptr, message_len);
+    return;
+  }
   std::string message{message_ptr, (size_t)message_len};
   std::cout << message << " : ";
   std::bitset<64> bits{input};
@@ -1007,6 +2454,10 @@ void memref_trace_plaintext(uint64_t input, uint64_t input_width,
 }
 
 void memref_trace_message(char *message_ptr, uint32_t message_len) {
+  if (mlir::concretelang::runtime_trace::enabled()) {
+    mlir::concretelang::runtime_trace::recordMarker(message_ptr, message_len);
+    return;
+  }
   std::string message{message_ptr, (size_t)message_len};
   std::cout << message << std::flush;
 }
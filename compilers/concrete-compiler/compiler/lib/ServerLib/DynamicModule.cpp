@@ -5,11 +5,14 @@
 
 #include <dlfcn.h>
 #include <fstream>
+#include <map>
+#include <mutex>
 
 #include "boost/outcome.h"
 #include "concretelang/ServerLib/DynamicModule.h"
 #include "concretelang/Support/CompilerEngine.h"
 #include "concretelang/Support/Error.h"
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
 
 namespace concretelang {
@@ -18,6 +21,25 @@ namespace serverlib {
 using concretelang::error::StringError;
 using mlir::concretelang::CompilerEngine;
 
+namespace {
+/// Expands the compressed container of `path` in place when the plain
+/// artifact is missing but its container was shipped (see
+/// Library::compressArtifacts). A no-op when the artifact is already
+/// expanded, so only the first load of a compressed distribution pays
+/// the decompression.
+outcome::checked<void, StringError> expandIfCompressed(std::string path) {
+  if (llvm::sys::fs::exists(path) ||
+      !llvm::sys::fs::exists(path + CompilerEngine::Library::COMPRESSED_EXT)) {
+    return outcome::success();
+  }
+  if (auto err = CompilerEngine::Library::decompressArtifact(path)) {
+    return StringError("Cannot expand compressed artifact: ")
+           << llvm::toString(std::move(err));
+  }
+  return outcome::success();
+}
+} // namespace
+
 DynamicModule::~DynamicModule() {
   if (libraryHandle != nullptr) {
     dlclose(libraryHandle);
@@ -26,26 +48,55 @@ DynamicModule::~DynamicModule() {
 
 outcome::checked<std::shared_ptr<DynamicModule>, StringError>
 DynamicModule::open(std::string outputPath) {
+  // Cache loaded modules by artifact path so that constructing many lambdas
+  // from the same compilation result parses the client parameters and
+  // resolves the shared library only once. Expired weak references are the
+  // only entries kept after all lambdas of a module are destroyed, so the
+  // library itself gets dlclosed as usual.
+  static std::mutex cacheMutex;
+  static std::map<std::string, std::weak_ptr<DynamicModule>> cache;
+
+  const std::lock_guard<std::mutex> guard(cacheMutex);
+  auto cached = cache.find(outputPath);
+  if (cached != cache.end()) {
+    if (auto module = cached->second.lock()) {
+      return module;
+    }
+  }
   std::shared_ptr<DynamicModule> module = std::make_shared<DynamicModule>();
   OUTCOME_TRYV(module->loadClientParametersJSON(outputPath));
   OUTCOME_TRYV(module->loadSharedLibrary(outputPath));
+  cache[outputPath] = module;
   return module;
 }
 
 outcome::checked<void, StringError>
 DynamicModule::loadSharedLibrary(std::string outputPath) {
-  libraryHandle =
-      dlopen(CompilerEngine::Library::getSharedLibraryPath(outputPath).c_str(),
-             RTLD_LAZY);
+  libraryPath = CompilerEngine::Library::getSharedLibraryPath(outputPath);
+  OUTCOME_TRYV(expandIfCompressed(libraryPath));
+  libraryHandle = dlopen(libraryPath.c_str(), RTLD_LAZY);
   if (!libraryHandle) {
     return StringError("Cannot open shared library ") << dlerror();
   }
   return outcome::success();
 }
 
+outcome::checked<void, StringError> DynamicModule::prevalidate() {
+  // Promote the lazily bound library to immediate binding; the library
+  // is already resident, so this only resolves the outstanding
+  // relocations.
+  void *handle = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_NOLOAD);
+  if (handle == nullptr) {
+    return StringError("Cannot prevalidate shared library: ") << dlerror();
+  }
+  dlclose(handle);
+  return outcome::success();
+}
+
 outcome::checked<void, StringError>
 DynamicModule::loadClientParametersJSON(std::string outputPath) {
   auto jsonPath = CompilerEngine::Library::getClientParametersPath(outputPath);
+  OUTCOME_TRYV(expandIfCompressed(jsonPath));
   OUTCOME_TRY(auto clientParams, ClientParameters::load(jsonPath));
   this->clientParametersList = clientParams;
   return outcome::success();
@@ -3,12 +3,22 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <dlfcn.h>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 #include "boost/outcome.h"
 
 #include "concretelang/ClientLib/Serializers.h"
 #include "concretelang/Common/Error.h"
+#include "concretelang/Runtime/context.h"
+#include "concretelang/Runtime/runtime_api.h"
 #include "concretelang/ServerLib/DynamicModule.h"
 #include "concretelang/ServerLib/ServerLambda.h"
 #include "concretelang/Support/CompilerEngine.h"
@@ -49,6 +59,10 @@ ServerLambda::loadFromModule(std::shared_ptr<DynamicModule> module,
            << funcName << "in client parameters";
   }
 
+  // TODO: support multi-output functions. Once they land, an
+  // invocation-time output mask backed by per-output reverse slices
+  // computed at compile time would let callers skip the computation
+  // (entire PBS chains) feeding the outputs they do not consume.
   if (param->outputs.size() != 1) {
     return StringError("ServerLambda: output arity (")
            << std::to_string(param->outputs.size())
@@ -56,6 +70,15 @@ ServerLambda::loadFromModule(std::shared_ptr<DynamicModule> module,
   }
 
   lambda.clientParameters = *param;
+
+  // Warm the process-wide FFT plan registry with the polynomial sizes of
+  // the circuit's bootstrap keys, so the first invocation pays no planning
+  // cost.
+  for (auto &bskParam : param->bootstrapKeys) {
+    mlir::concretelang::FFTPlanRegistry::instance().get(
+        bskParam.polynomialSize);
+  }
+
   return lambda;
 }
 
@@ -77,12 +100,357 @@ llvm::Error ServerLambda::invokeRaw(llvm::MutableArrayRef<void *> args) {
          << pos << " is null or missing";
 }
 
+namespace {
+
+/// Process-wide admission controller for invocation memory. The budget
+/// is set through CONCRETE_MEMORY_BUDGET (bytes); without it admission
+/// is a no-op. Invocations that would push the in-use footprint past
+/// the budget wait for running ones to release theirs instead of
+/// allocating and getting OOM-killed; an invocation larger than the
+/// whole budget is admitted once it runs alone rather than rejected.
+class MemoryBudget {
+public:
+  static MemoryBudget &instance() {
+    static MemoryBudget manager;
+    return manager;
+  }
+
+  void acquire(uint64_t bytes) {
+    if (budget == 0 || bytes == 0)
+      return;
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock,
+                   [&] { return used + bytes <= budget || used == 0; });
+    used += bytes;
+  }
+
+  void release(uint64_t bytes) {
+    if (budget == 0 || bytes == 0)
+      return;
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      used -= bytes;
+    }
+    condition.notify_all();
+  }
+
+private:
+  MemoryBudget() {
+    char *env = getenv("CONCRETE_MEMORY_BUDGET");
+    if (env != nullptr)
+      budget = strtoull(env, nullptr, 10);
+  }
+
+  uint64_t budget = 0;
+  uint64_t used = 0;
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+/// Holds the declared footprint of one invocation for its duration.
+struct MemoryBudgetGuard {
+  MemoryBudgetGuard(uint64_t bytes) : bytes(bytes) {
+    MemoryBudget::instance().acquire(bytes);
+  }
+  ~MemoryBudgetGuard() { MemoryBudget::instance().release(bytes); }
+
+  uint64_t bytes;
+};
+
+} // namespace
+
 llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
 ServerLambda::call(PublicArguments &args,
                    std::optional<EvaluationKeys> evaluationKeys,
                    bool simulation) {
+  // The profile is per-thread in the runtime, so setting it here covers
+  // both direct calls and the executor workers of callAsync.
+  runtime_set_execution_profile(executionProfile);
+  // Queue behind running invocations when the declared footprint does
+  // not fit into the remaining process budget.
+  MemoryBudgetGuard guard(expectedMemoryFootprint);
   return invokeRawOnLambda(this, args, evaluationKeys, simulation);
 }
 
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+ServerLambda::callMemoized(PublicArguments &args,
+                           std::optional<EvaluationKeys> evaluationKeys,
+                           bool simulation) {
+  // Identity of the invocation: the underlying buffers of the argument
+  // handles. A hit requires the caller to pass the same shared buffers
+  // again; equal ciphertexts in distinct buffers are evaluated anew.
+  std::vector<const void *> key;
+  key.reserve(args.getArguments().size());
+  for (auto &arg : args.getArguments())
+    key.push_back((const void *)&arg.get());
+
+  {
+    const std::lock_guard<std::mutex> guard(resultCache->mutex);
+    auto entry = resultCache->entries.find(key);
+    if (entry != resultCache->entries.end()) {
+      // The cached buffers are shared handles: returning them does not
+      // copy the ciphertexts.
+      std::vector<clientlib::SharedScalarOrTensorData> buffers = entry->second;
+      return clientlib::PublicResult::fromBuffers(clientParameters,
+                                                  std::move(buffers));
+    }
+  }
+
+  auto result = call(args, evaluationKeys, simulation);
+  if (!result)
+    return result;
+  {
+    const std::lock_guard<std::mutex> guard(resultCache->mutex);
+    resultCache->entries.emplace(std::move(key), (*result)->buffers);
+  }
+  return result;
+}
+
+void ServerLambda::clearMemoizedResults() {
+  const std::lock_guard<std::mutex> guard(resultCache->mutex);
+  resultCache->entries.clear();
+}
+
+outcome::checked<void, StringError>
+ServerLambda::warmup(std::optional<EvaluationKeys> evaluationKeys) {
+  OUTCOME_TRYV(module->prevalidate());
+  // Check the key references the first call would otherwise trip over.
+  for (auto gates : {clientParameters.inputs, clientParameters.outputs}) {
+    for (auto &gate : gates) {
+      if (gate.encryption.has_value() &&
+          gate.encryption->secretKeyID >= clientParameters.secretKeys.size()) {
+        return StringError("warmup: gate refers to unknown secret key ")
+               << gate.encryption->secretKeyID;
+      }
+    }
+  }
+  if (!evaluationKeys.has_value()) {
+    return outcome::success();
+  }
+  // One dummy invocation over trivial zeroed ciphertexts: the result is
+  // meaningless and discarded, but the evaluation walks the same path
+  // as a real request (key setup, FFT plans, scratch allocations).
+  std::vector<clientlib::SharedScalarOrTensorData> buffers;
+  for (auto gate : clientParameters.inputs) {
+    if (gate.encryption.has_value() || !gate.shape.dimensions.empty()) {
+      clientlib::TensorData tensor(
+          clientParameters.bufferShape(gate),
+          gate.encryption.has_value() ? (size_t)64 : (size_t)gate.shape.width,
+          gate.encryption.has_value() ? false : gate.shape.sign);
+      buffers.push_back(clientlib::SharedScalarOrTensorData(
+          ScalarOrTensorData(std::move(tensor))));
+    } else {
+      buffers.push_back(
+          clientlib::SharedScalarOrTensorData(ScalarOrTensorData(
+              clientlib::ScalarData(0,
+                                    clientlib::getElementTypeFromWidthAndSign(
+                                        gate.shape.width, gate.shape.sign),
+                                    gate.shape.width))));
+    }
+  }
+  PublicArguments dummyArgs(clientParameters, buffers);
+  auto result = call(dummyArgs, evaluationKeys);
+  if (!result) {
+    return StringError("warmup: dummy invocation failed: ")
+           << llvm::toString(result.takeError());
+  }
+  return outcome::success();
+}
+
+void ServerLambda::prefetch(EvaluationKeys evaluationKeys) {
+  mlir::concretelang::RuntimeContextRegistry::instance().prefetch(
+      evaluationKeys);
+}
+
+void ServerLambda::releasePrefetch(EvaluationKeys evaluationKeys) {
+  mlir::concretelang::RuntimeContextRegistry::instance().releasePrefetch(
+      evaluationKeys);
+}
+
+void ServerLambda::rotateKeys(EvaluationKeys oldKeys,
+                              EvaluationKeys newKeys) {
+  mlir::concretelang::RuntimeContextRegistry::instance().rotate(oldKeys,
+                                                                newKeys);
+}
+
+namespace {
+/// Shared executor backing ServerLambda::callAsync: a fixed pool of worker
+/// threads consuming a FIFO of pending evaluations, so a service can keep
+/// many circuit invocations in flight without dedicating one caller thread
+/// per request.
+class CallExecutor {
+public:
+  static CallExecutor &instance() {
+    static CallExecutor executor;
+    return executor;
+  }
+
+  void submit(std::function<void()> task) {
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+  }
+
+private:
+  CallExecutor() : stop(false) {
+    size_t numWorkers = std::thread::hardware_concurrency();
+    if (numWorkers < 1)
+      numWorkers = 1;
+    for (size_t i = 0; i < numWorkers; i++) {
+      workers.push_back(std::thread([this]() { run(); }));
+    }
+  }
+
+  ~CallExecutor() {
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      stop = true;
+    }
+    condition.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  void run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return stop || !tasks.empty(); });
+        if (stop && tasks.empty())
+          return;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<std::function<void()>> tasks;
+  std::vector<std::thread> workers;
+  bool stop;
+};
+} // namespace
+
+outcome::checked<ServerLambdaChain, StringError>
+ServerLambdaChain::create(std::vector<ServerLambda> stages) {
+  if (stages.empty()) {
+    return StringError("chain: at least one stage is required");
+  }
+  // Validate the hand-off between consecutive stages up front, so a
+  // shape mismatch surfaces at composition time rather than deep inside
+  // an invocation.
+  for (size_t i = 1; i < stages.size(); i++) {
+    auto &producer = stages[i - 1].clientParameters;
+    auto &consumer = stages[i].clientParameters;
+    if (consumer.inputs.size() != producer.outputs.size()) {
+      return StringError("chain: stage ")
+             << i << " takes " << consumer.inputs.size()
+             << " inputs but stage " << i - 1 << " produces "
+             << producer.outputs.size() << " outputs";
+    }
+    for (size_t gate = 0; gate < consumer.inputs.size(); gate++) {
+      if (consumer.bufferShape(consumer.inputs[gate]) !=
+          producer.bufferShape(producer.outputs[gate])) {
+        return StringError("chain: output ")
+               << gate << " of stage " << i - 1
+               << " does not match the corresponding input of stage " << i;
+      }
+    }
+  }
+  ServerLambdaChain chain;
+  chain.stages = std::move(stages);
+  return chain;
+}
+
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+ServerLambdaChain::call(PublicArguments &args,
+                        std::optional<EvaluationKeys> evaluationKeys,
+                        bool simulation) {
+  auto result = stages[0].call(args, evaluationKeys, simulation);
+  for (size_t i = 1; i < stages.size(); i++) {
+    if (!result) {
+      return result;
+    }
+    // Hand the previous stage's result buffers to the next stage as
+    // shared handles: the ciphertexts stay in their internal format,
+    // with no serialization and no keyswitch to the client format in
+    // between.
+    PublicArguments stageArgs(stages[i].clientParameters,
+                              (*result)->buffers);
+    result = stages[i].call(stageArgs, evaluationKeys, simulation);
+  }
+  return result;
+}
+
+std::future<llvm::Expected<std::unique_ptr<clientlib::PublicResult>>>
+ServerLambda::callAsync(PublicArguments &args,
+                        std::optional<EvaluationKeys> evaluationKeys,
+                        bool simulation) {
+  using Result = llvm::Expected<std::unique_ptr<clientlib::PublicResult>>;
+  auto promise = std::make_shared<std::promise<Result>>();
+  auto future = promise->get_future();
+  // Copy the lambda itself: it only holds the function pointer, parameters
+  // and a shared reference on the module, which keeps the shared library
+  // alive for the duration of the evaluation.
+  ServerLambda lambda = *this;
+  CallExecutor::instance().submit(
+      [promise, lambda, &args, evaluationKeys, simulation]() mutable {
+        promise->set_value(lambda.call(args, evaluationKeys, simulation));
+      });
+  return future;
+}
+
+std::future<llvm::Expected<std::unique_ptr<clientlib::PublicResult>>>
+ServerLambda::callAsyncHedged(
+    PublicArguments &args, std::optional<EvaluationKeys> evaluationKeys,
+    bool simulation) {
+  if (hedgeDelayMs == 0) {
+    return callAsync(args, evaluationKeys, simulation);
+  }
+  using Result = llvm::Expected<std::unique_ptr<clientlib::PublicResult>>;
+  auto promise = std::make_shared<std::promise<Result>>();
+  auto future = promise->get_future();
+  // Both attempts race on this flag: the first to resolve publishes its
+  // result, the loser consumes and drops its own.
+  auto resolved = std::make_shared<std::atomic<bool>>(false);
+  ServerLambda lambda = *this;
+  // The losing attempt keeps evaluating after the winner resolved the
+  // future, at which point the caller may already have destroyed its
+  // arguments. Snapshot them for both attempts: the copy shares the
+  // underlying ciphertext buffers, so it is cheap and keeps them alive
+  // for as long as either attempt runs.
+  auto sharedArgs = std::make_shared<PublicArguments>(args);
+  auto attempt = [promise, resolved, lambda, sharedArgs, evaluationKeys,
+                  simulation]() mutable {
+    auto result = lambda.call(*sharedArgs, evaluationKeys, simulation);
+    if (!resolved->exchange(true)) {
+      promise->set_value(std::move(result));
+      return;
+    }
+    // The other attempt already won; an evaluation cannot be aborted
+    // mid-run, so this one ran to completion for nothing.
+    if (!result) {
+      llvm::consumeError(result.takeError());
+    }
+  };
+  CallExecutor::instance().submit(attempt);
+  // The watchdog sleeps out the hedge delay off the executor pool, so a
+  // blocked worker never delays the duplicate it is meant to launch.
+  uint64_t delay = hedgeDelayMs;
+  std::thread([delay, resolved, attempt]() mutable {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    if (!resolved->load()) {
+      CallExecutor::instance().submit(std::move(attempt));
+    }
+  }).detach();
+  return future;
+}
+
 } // namespace serverlib
 } // namespace concretelang
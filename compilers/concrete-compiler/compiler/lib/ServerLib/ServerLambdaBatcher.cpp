@@ -0,0 +1,198 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <cstring>
+
+#include "concretelang/ServerLib/ServerLambdaBatcher.h"
+#include "concretelang/ClientLib/Types.h"
+#include "concretelang/Support/Error.h"
+
+namespace concretelang {
+namespace serverlib {
+
+using concretelang::clientlib::CircuitGate;
+using concretelang::clientlib::PublicArguments;
+using concretelang::clientlib::PublicResult;
+using concretelang::clientlib::ScalarOrTensorData;
+using concretelang::clientlib::SharedScalarOrTensorData;
+using concretelang::clientlib::TensorData;
+using concretelang::error::StringError;
+using mlir::concretelang::StreamStringError;
+
+outcome::checked<std::unique_ptr<ServerLambdaBatcher>, StringError>
+ServerLambdaBatcher::create(ServerLambda lambda,
+                            clientlib::EvaluationKeys evaluationKeys,
+                            size_t batchSize,
+                            std::chrono::microseconds latencyBudget) {
+  if (batchSize < 1) {
+    return StringError("ServerLambdaBatcher: batch size must be >= 1");
+  }
+  auto &params = lambda.clientParameters;
+  // Check that every gate splits into batchSize equal ciphertext samples
+  // along its leading dimension, and record the per-sample word counts used
+  // to concatenate submissions and scatter results.
+  auto sampleWords = [&](CircuitGate gate,
+                         size_t pos) -> outcome::checked<size_t, StringError> {
+    if (!gate.isEncrypted()) {
+      return StringError("ServerLambdaBatcher: gate ")
+             << pos << " is not encrypted, clear gates cannot be batched";
+    }
+    auto shape = params.bufferShape(gate);
+    if (shape.size() < 2 || shape[0] % (int64_t)batchSize != 0) {
+      return StringError("ServerLambdaBatcher: gate ")
+             << pos << " has no leading dimension divisible by "
+             << batchSize;
+    }
+    return (size_t)params.bufferSize(gate) / batchSize;
+  };
+  std::vector<size_t> sampleWordsPerInput;
+  for (size_t i = 0; i < params.inputs.size(); i++) {
+    OUTCOME_TRY(auto words, sampleWords(params.inputs[i], i));
+    sampleWordsPerInput.push_back(words);
+  }
+  OUTCOME_TRY(auto sampleWordsOutput, sampleWords(params.outputs[0], 0));
+  return std::unique_ptr<ServerLambdaBatcher>(new ServerLambdaBatcher(
+      lambda, evaluationKeys, batchSize, latencyBudget,
+      std::move(sampleWordsPerInput), sampleWordsOutput));
+}
+
+ServerLambdaBatcher::ServerLambdaBatcher(
+    ServerLambda lambda, clientlib::EvaluationKeys evaluationKeys,
+    size_t batchSize, std::chrono::microseconds latencyBudget,
+    std::vector<size_t> sampleWordsPerInput, size_t sampleWordsOutput)
+    : lambda(lambda), evaluationKeys(evaluationKeys), batchSize(batchSize),
+      latencyBudget(latencyBudget),
+      sampleWordsPerInput(std::move(sampleWordsPerInput)),
+      sampleWordsOutput(sampleWordsOutput), stop(false) {
+  collector = std::thread([this]() { run(); });
+}
+
+ServerLambdaBatcher::~ServerLambdaBatcher() {
+  {
+    const std::lock_guard<std::mutex> guard(mutex);
+    stop = true;
+  }
+  condition.notify_all();
+  collector.join();
+}
+
+std::future<ServerLambdaBatcher::Result>
+ServerLambdaBatcher::submit(std::shared_ptr<PublicArguments> args) {
+  auto promise = std::make_shared<std::promise<Result>>();
+  auto future = promise->get_future();
+  auto &arguments = args->getArguments();
+  // Reject incompatible submissions up front so they cannot poison a batch.
+  if (arguments.size() != sampleWordsPerInput.size()) {
+    promise->set_value(StreamStringError("submit: expected ")
+                       << sampleWordsPerInput.size() << " arguments, got "
+                       << arguments.size());
+    return future;
+  }
+  for (size_t i = 0; i < arguments.size(); i++) {
+    auto &data = arguments[i].get();
+    if (!data.isTensor() ||
+        data.getTensor().getNumElements() != sampleWordsPerInput[i]) {
+      promise->set_value(StreamStringError("submit: argument ")
+                         << i << " is not a single sample of "
+                         << sampleWordsPerInput[i] << " words");
+      return future;
+    }
+  }
+  bool full;
+  {
+    const std::lock_guard<std::mutex> guard(mutex);
+    if (pending.empty())
+      oldestSubmission = std::chrono::steady_clock::now();
+    pending.push_back(Pending{std::move(args), std::move(promise)});
+    full = pending.size() >= batchSize;
+  }
+  // Wake the collector: either to evaluate a full batch immediately or to
+  // arm the latency deadline of a fresh one.
+  condition.notify_one();
+  if (full)
+    condition.notify_one();
+  return future;
+}
+
+void ServerLambdaBatcher::run() {
+  while (true) {
+    std::vector<Pending> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [this]() { return stop || !pending.empty(); });
+      if (pending.empty()) // stopped with nothing left to drain
+        return;
+      // Hold the batch open until it fills or the oldest submission has
+      // waited out the latency budget.
+      auto deadline = oldestSubmission + latencyBudget;
+      condition.wait_until(lock, deadline, [this]() {
+        return stop || pending.size() >= batchSize;
+      });
+      size_t count = std::min(pending.size(), batchSize);
+      batch.assign(std::make_move_iterator(pending.begin()),
+                   std::make_move_iterator(pending.begin() + count));
+      pending.erase(pending.begin(), pending.begin() + count);
+      if (!pending.empty())
+        oldestSubmission = std::chrono::steady_clock::now();
+    }
+    evaluate(std::move(batch));
+  }
+}
+
+void ServerLambdaBatcher::evaluate(std::vector<Pending> batch) {
+  auto &params = lambda.clientParameters;
+  // Concatenate the submitted samples along the batch dimension; a partial
+  // batch is padded by repeating the last sample so the circuit always sees
+  // its compiled shape.
+  std::vector<SharedScalarOrTensorData> buffers;
+  for (size_t i = 0; i < params.inputs.size(); i++) {
+    TensorData batched(params.bufferShape(params.inputs[i]), 64, false);
+    auto words = sampleWordsPerInput[i];
+    auto dest = batched.getElementPointer<uint64_t>(0);
+    for (size_t s = 0; s < batchSize; s++) {
+      auto &sample = batch[std::min(s, batch.size() - 1)];
+      auto src =
+          sample.args->getArguments()[i].get().getTensor().getElementPointer<
+              uint64_t>(0);
+      memcpy(dest + s * words, src, words * sizeof(uint64_t));
+    }
+    buffers.push_back(SharedScalarOrTensorData(std::move(batched)));
+  }
+  PublicArguments batchedArgs(params, buffers);
+  auto maybeResult = lambda.call(batchedArgs, evaluationKeys);
+  if (auto err = maybeResult.takeError()) {
+    auto message = llvm::toString(std::move(err));
+    for (auto &sample : batch) {
+      sample.promise->set_value(StreamStringError(message));
+    }
+    return;
+  }
+  auto value = maybeResult.get()->getValue(0);
+  if (value.has_error()) {
+    for (auto &sample : batch) {
+      sample.promise->set_value(
+          StreamStringError(value.error().mesg));
+    }
+    return;
+  }
+  auto src = value.value().get().getTensor().getElementPointer<uint64_t>(0);
+  // Scatter each sample's slice back, shaped by the submitter's own output
+  // gate so results decrypt like a plain single-sample call.
+  for (size_t s = 0; s < batch.size(); s++) {
+    auto &sample = batch[s];
+    auto &sampleParams = sample.args->getClientParameters();
+    TensorData slice(sampleParams.bufferShape(sampleParams.outputs[0]), 64,
+                     false);
+    memcpy(slice.getElementPointer<uint64_t>(0), src + s * sampleWordsOutput,
+           sampleWordsOutput * sizeof(uint64_t));
+    std::vector<SharedScalarOrTensorData> resultBuffers;
+    resultBuffers.push_back(SharedScalarOrTensorData(std::move(slice)));
+    sample.promise->set_value(PublicResult::fromBuffers(
+        sampleParams, std::move(resultBuffers)));
+  }
+}
+
+} // namespace serverlib
+} // namespace concretelang
@@ -0,0 +1,94 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/ServerLib/ServerLambdaStreamer.h"
+#include "concretelang/Support/Error.h"
+
+namespace concretelang {
+namespace serverlib {
+
+using concretelang::clientlib::EvaluationKeys;
+using concretelang::clientlib::PublicArguments;
+using concretelang::error::StringError;
+
+outcome::checked<std::unique_ptr<ServerLambdaStreamer>, StringError>
+ServerLambdaStreamer::create(ServerLambda lambda,
+                             EvaluationKeys evaluationKeys,
+                             size_t maxInFlight) {
+  if (maxInFlight < 1) {
+    return StringError("ServerLambdaStreamer: maxInFlight must be >= 1");
+  }
+  return std::unique_ptr<ServerLambdaStreamer>(
+      new ServerLambdaStreamer(lambda, evaluationKeys, maxInFlight));
+}
+
+ServerLambdaStreamer::ServerLambdaStreamer(ServerLambda lambda,
+                                           EvaluationKeys evaluationKeys,
+                                           size_t maxInFlight)
+    : lambda(lambda), evaluationKeys(evaluationKeys), maxInFlight(maxInFlight),
+      inFlight(0), stopping(false) {
+  // Pay the key setup once for the whole stream: the pinned context
+  // (Fourier conversion of the bootstrap keys, GPU residency) is shared
+  // by every chunk and released when the streamer is destroyed.
+  this->lambda.prefetch(evaluationKeys);
+  for (size_t i = 0; i < maxInFlight; i++) {
+    workers.push_back(std::thread([this]() { run(); }));
+  }
+}
+
+ServerLambdaStreamer::~ServerLambdaStreamer() {
+  {
+    const std::lock_guard<std::mutex> guard(mutex);
+    stopping = true;
+  }
+  condition.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  lambda.releasePrefetch(evaluationKeys);
+}
+
+std::future<ServerLambdaStreamer::Result>
+ServerLambdaStreamer::push(std::shared_ptr<PublicArguments> args) {
+  auto promise = std::make_shared<std::promise<Result>>();
+  auto future = promise->get_future();
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // The memory envelope: block the producer until a chunk slot frees
+    // up instead of queueing the whole dataset.
+    condition.wait(lock, [this]() { return inFlight < maxInFlight; });
+    inFlight++;
+    pending.push_back({std::move(args), std::move(promise)});
+  }
+  condition.notify_all();
+  return future;
+}
+
+void ServerLambdaStreamer::run() {
+  while (true) {
+    Pending chunk;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [this]() { return stopping || !pending.empty(); });
+      if (pending.empty()) {
+        // Stopping: the queued chunks are drained before the workers
+        // exit, so every pushed future completes.
+        return;
+      }
+      chunk = std::move(pending.front());
+      pending.pop_front();
+    }
+    chunk.promise->set_value(
+        lambda.call(*chunk.args, evaluationKeys, /*simulation=*/false));
+    {
+      const std::lock_guard<std::mutex> guard(mutex);
+      inFlight--;
+    }
+    condition.notify_all();
+  }
+}
+
+} // namespace serverlib
+} // namespace concretelang
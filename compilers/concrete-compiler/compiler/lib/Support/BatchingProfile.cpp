@@ -0,0 +1,64 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "concretelang/Support/BatchingProfile.h"
+
+namespace mlir {
+namespace concretelang {
+
+/// Extracts the value of a `name=value` field from a profile line, or
+/// std::nullopt if the field is absent or malformed.
+static std::optional<uint64_t> profileField(llvm::StringRef line,
+                                            llvm::StringRef name) {
+  llvm::SmallVector<llvm::StringRef> fields;
+  line.split(fields, ' ', -1, false);
+  for (auto field : fields) {
+    auto [key, value] = field.split('=');
+    uint64_t parsed;
+    if (key == name && !value.getAsInteger(10, parsed)) {
+      return parsed;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<int64_t> maxBatchSizeFromProfile(llvm::StringRef path) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  llvm::SmallVector<llvm::StringRef> lines;
+  (*buffer)->getBuffer().split(lines, '\n', -1, false);
+  if (lines.empty() || lines[0].trim() != "concrete-batching-profile v1") {
+    return std::nullopt;
+  }
+  uint64_t maxAverageBatch = 0;
+  for (auto line : llvm::ArrayRef<llvm::StringRef>(lines).drop_front()) {
+    auto invocations = profileField(line, "invocations");
+    auto calls = profileField(line, "calls");
+    if (!invocations.has_value() || !calls.has_value() || *invocations == 0) {
+      continue;
+    }
+    // Round the average up: a bound below the realized batch size would
+    // split batches the workload actually forms.
+    uint64_t averageBatch = (*calls + *invocations - 1) / *invocations;
+    maxAverageBatch = std::max(maxAverageBatch, averageBatch);
+  }
+  if (maxAverageBatch < 2) {
+    return std::nullopt;
+  }
+  int64_t bound = 1;
+  while (bound < (int64_t)maxAverageBatch) {
+    bound *= 2;
+  }
+  return bound;
+}
+
+} // namespace concretelang
+} // namespace mlir
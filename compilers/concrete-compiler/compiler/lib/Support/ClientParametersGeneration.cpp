@@ -331,6 +331,39 @@ extractCircuitGates(ClientParameters &output, mlir::func::FuncOp funcOp,
   return std::monostate();
 }
 
+/// Returns the functions reachable from `entry`, following both direct calls
+/// and function address references (dataflow task work functions are taken by
+/// address through `func.constant` instead of being called directly).
+static std::vector<mlir::func::FuncOp>
+reachableFunctions(mlir::ModuleOp module, mlir::func::FuncOp entry) {
+  std::vector<mlir::func::FuncOp> reachable;
+  llvm::SmallSet<mlir::Operation *, 10> visited;
+  std::vector<mlir::func::FuncOp> worklist{entry};
+  visited.insert(entry);
+  auto enqueue = [&](llvm::StringRef calleeName) {
+    auto callee = module.lookupSymbol<mlir::func::FuncOp>(calleeName);
+    if (callee != nullptr && visited.insert(callee).second) {
+      worklist.push_back(callee);
+    }
+  };
+  while (!worklist.empty()) {
+    auto funcOp = worklist.back();
+    worklist.pop_back();
+    reachable.push_back(funcOp);
+    funcOp->walk([&](mlir::Operation *op) {
+      if (auto callOp = mlir::dyn_cast<mlir::CallOpInterface>(op)) {
+        if (auto callee = callOp.getCallableForCallee()
+                              .dyn_cast<mlir::SymbolRefAttr>()) {
+          enqueue(callee.getLeafReference().getValue());
+        }
+      } else if (auto constantOp = mlir::dyn_cast<mlir::func::ConstantOp>(op)) {
+        enqueue(constantOp.getValueAttr().getValue());
+      }
+    });
+  }
+  return reachable;
+}
+
 llvm::Expected<ClientParameters>
 createClientParametersFromTFHE(mlir::ModuleOp module,
                                llvm::StringRef functionName, int bitsOfSecurity,
@@ -365,6 +398,38 @@ createClientParametersFromTFHE(mlir::ModuleOp module,
   // We extract all the keys used in the circuit
   extractCircuitKeys(output, circuitKeys, *curve);
 
+  // Key IDs are positions in the key vectors above and are shared by all the
+  // circuits of the module, so the keys stay listed module wide. We record
+  // which of them the circuits reachable from the entry point actually use,
+  // so that keygen, key storage and evaluation key upload can skip the
+  // others.
+  auto usedKeys = TFHE::extractCircuitKeys(reachableFunctions(module, *funcOp));
+  output.hasKeyLiveness = true;
+  for (size_t i = 0; i < circuitKeys.secretKeys.size(); i++) {
+    if (usedKeys.getSecretKeyIndex(circuitKeys.secretKeys[i]).has_value()) {
+      output.usedSecretKeys.push_back(i);
+    }
+  }
+  for (size_t i = 0; i < circuitKeys.bootstrapKeys.size(); i++) {
+    if (usedKeys.getBootstrapKeyIndex(circuitKeys.bootstrapKeys[i])
+            .has_value()) {
+      output.usedBootstrapKeys.push_back(i);
+    }
+  }
+  for (size_t i = 0; i < circuitKeys.keyswitchKeys.size(); i++) {
+    if (usedKeys.getKeyswitchKeyIndex(circuitKeys.keyswitchKeys[i])
+            .has_value()) {
+      output.usedKeyswitchKeys.push_back(i);
+    }
+  }
+  for (size_t i = 0; i < circuitKeys.packingKeyswitchKeys.size(); i++) {
+    if (usedKeys
+            .getPackingKeyswitchKeyIndex(circuitKeys.packingKeyswitchKeys[i])
+            .has_value()) {
+      output.usedPackingKeyswitchKeys.push_back(i);
+    }
+  }
+
   // We generate the gates for the inputs aud outputs
   if (auto err =
           extractCircuitGates(output, *funcOp, encodings, *curve, maybeCrt)
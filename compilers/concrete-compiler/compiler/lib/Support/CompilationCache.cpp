@@ -0,0 +1,341 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "concretelang/Support/CompilationCache.h"
+
+namespace mlir {
+namespace concretelang {
+
+std::optional<std::string> compilationCacheDirectory() {
+  const char *dir = std::getenv("CONCRETELANG_COMPILATION_CACHE_DIR");
+  if (dir == nullptr || *dir == '\0') {
+    return std::nullopt;
+  }
+  if (llvm::sys::fs::create_directories(dir)) {
+    return std::nullopt;
+  }
+  return std::string(dir);
+}
+
+/// Serializes every field of `options` that influences the emitted
+/// artifacts into `stream`. Fields are separated by NUL bytes so that
+/// adjacent values cannot alias.
+static void serializeOptions(llvm::raw_string_ostream &stream,
+                             const CompilationOptions &options) {
+  stream << options.v0FHEConstraints.has_value() << '\0';
+  if (options.v0FHEConstraints.has_value()) {
+    stream << options.v0FHEConstraints->norm2 << '\0'
+           << options.v0FHEConstraints->p << '\0';
+  }
+  stream << options.v0Parameter.has_value() << '\0';
+  if (options.v0Parameter.has_value()) {
+    auto &param = *options.v0Parameter;
+    stream << param.glweDimension << '\0' << param.logPolynomialSize << '\0'
+           << param.nSmall << '\0' << param.brLevel << '\0' << param.brLogBase
+           << '\0' << param.ksLevel << '\0' << param.ksLogBase << '\0'
+           << param.largeInteger.has_value() << '\0';
+  }
+  stream << options.largeIntegerParameter.has_value() << '\0';
+  if (options.largeIntegerParameter.has_value()) {
+    for (auto modulus : options.largeIntegerParameter->crtDecomposition) {
+      stream << modulus << '\0';
+    }
+  }
+  stream << options.verifyDiagnostics << '\0' << options.autoParallelize
+         << '\0' << options.loopParallelize << '\0' << options.batchTFHEOps
+         << '\0' << options.maxBatchSize << '\0' << options.emitSDFGOps << '\0'
+         << options.unrollLoopsWithSDFGConvertibleOps << '\0'
+         << options.dataflowParallelize << '\0' << options.optimizeTFHE << '\0'
+         << options.simulate << '\0' << options.emitGPUOps << '\0'
+         << options.streamingCompilation << '\0';
+  stream << options.fhelinalgTileSizes.has_value() << '\0';
+  if (options.fhelinalgTileSizes.has_value()) {
+    for (auto size : *options.fhelinalgTileSizes) {
+      stream << size << '\0';
+    }
+  }
+  stream << options.clientParametersFuncName.value_or("") << '\0';
+  auto &config = options.optimizerConfig;
+  stream << config.display << '\0' << config.strategy << '\0'
+         << config.p_error << '\0' << config.global_p_error << '\0'
+         << config.security << '\0' << config.fallback_log_norm_woppbs << '\0'
+         << config.use_gpu_constraints << '\0' << (unsigned)config.encoding
+         << '\0' << config.cache_on_disk << '\0'
+         << config.ciphertext_modulus_log << '\0' << config.fft_precision
+         << '\0';
+  stream << options.chunkIntegers << '\0' << options.chunkSize << '\0'
+         << options.chunkWidth << '\0';
+}
+
+std::optional<std::string> compilationCacheKey(
+    llvm::ArrayRef<std::string> sources, const CompilationOptions &options,
+    llvm::StringRef runtimeLibraryPath, bool generateSharedLib,
+    bool generateStaticLib, bool generateClientParameters,
+    bool generateCompilationFeedback, bool generateCppHeader) {
+  // Version tag of the on-disk format, to be bumped whenever the
+  // serialization or the meaning of the hashed inputs changes.
+  constexpr unsigned CACHE_FORMAT_VERSION = 1;
+
+  // Manually provided circuit encodings are not captured by the key,
+  // compilations using them are not cached. Neither is the content of
+  // a batching profile, which can change without its path changing.
+  if (options.encodings.has_value() || options.batchingProfile.has_value()) {
+    return std::nullopt;
+  }
+
+  std::string compilationInputs;
+  llvm::raw_string_ostream stream(compilationInputs);
+  stream << CACHE_FORMAT_VERSION << '\0';
+  serializeOptions(stream, options);
+  stream << runtimeLibraryPath << '\0' << generateSharedLib << '\0'
+         << generateStaticLib << '\0' << generateClientParameters << '\0'
+         << generateCompilationFeedback << '\0' << generateCppHeader << '\0';
+  stream.flush();
+
+  llvm::MD5 hash;
+  hash.update(compilationInputs);
+  for (const auto &source : sources) {
+    hash.update(source);
+    hash.update(llvm::StringRef("\0", 1));
+  }
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return std::string(result.digest().str());
+}
+
+/// Returns the path of the cache entry for `key`, or std::nullopt if
+/// the cache is disabled.
+static std::optional<llvm::SmallString<128>>
+compilationCachePath(llvm::StringRef key) {
+  auto dir = compilationCacheDirectory();
+  if (!dir.has_value()) {
+    return std::nullopt;
+  }
+  llvm::SmallString<128> path(*dir);
+  llvm::sys::path::append(path, key);
+  return path;
+}
+
+/// Copies every regular file of `fromDir` into `toDir`. Returns false
+/// if a file could not be copied.
+static bool copyDirEntries(llvm::StringRef fromDir, llvm::StringRef toDir) {
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(fromDir, ec), end;
+       !ec && it != end; it.increment(ec)) {
+    if (it->type() != llvm::sys::fs::file_type::regular_file) {
+      continue;
+    }
+    llvm::SmallString<128> destination(toDir);
+    llvm::sys::path::append(destination,
+                            llvm::sys::path::filename(it->path()));
+    if (llvm::sys::fs::copy_file(it->path(), destination)) {
+      return false;
+    }
+  }
+  return !ec;
+}
+
+bool restoreCachedLibrary(llvm::StringRef key, llvm::StringRef outputDirPath) {
+  auto entryPath = compilationCachePath(key);
+  if (!entryPath.has_value() ||
+      !llvm::sys::fs::is_directory(*entryPath)) {
+    return false;
+  }
+  if (llvm::sys::fs::create_directories(outputDirPath)) {
+    return false;
+  }
+  return copyDirEntries(*entryPath, outputDirPath);
+}
+
+void cacheLibrary(llvm::StringRef key, llvm::StringRef outputDirPath) {
+  auto entryPath = compilationCachePath(key);
+  if (!entryPath.has_value() || llvm::sys::fs::is_directory(*entryPath)) {
+    return;
+  }
+  // The entry is populated in a unique temporary directory and renamed
+  // into place, so that concurrent compilations never observe a partial
+  // entry.
+  llvm::SmallString<128> temporaryPath;
+  if (llvm::sys::fs::createUniqueDirectory(*entryPath + ".tmp",
+                                           temporaryPath)) {
+    return;
+  }
+  if (!copyDirEntries(outputDirPath, temporaryPath) ||
+      llvm::sys::fs::rename(temporaryPath, *entryPath)) {
+    llvm::sys::fs::remove_directories(temporaryPath);
+  }
+}
+
+std::optional<std::string>
+sourceCompilationCacheKey(const std::string &source,
+                          const CompilationOptions &options,
+                          llvm::StringRef runtimeLibraryPath) {
+  // Version tag of the per-source on-disk format.
+  constexpr unsigned SOURCE_CACHE_FORMAT_VERSION = 1;
+
+  // Manually provided circuit encodings are not captured by the key,
+  // compilations using them are not cached. Neither is the content of
+  // a batching profile, which can change without its path changing.
+  if (options.encodings.has_value() || options.batchingProfile.has_value()) {
+    return std::nullopt;
+  }
+
+  std::string compilationInputs;
+  llvm::raw_string_ostream stream(compilationInputs);
+  stream << SOURCE_CACHE_FORMAT_VERSION << '\0';
+  serializeOptions(stream, options);
+  stream << runtimeLibraryPath << '\0';
+  stream.flush();
+
+  llvm::MD5 hash;
+  hash.update(compilationInputs);
+  hash.update(source);
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  // The prefix keeps per-source entries apart from whole-library ones.
+  return "src-" + std::string(result.digest().str());
+}
+
+static const char *SOURCE_CACHE_PARAMS_FILE = "client_parameters.json";
+static const char *SOURCE_CACHE_FEEDBACK_FILE = "compilation_feedback.json";
+
+/// Parses the JSON file `fileName` of the cache entry `entryPath` into
+/// `out`. Returns false on a missing or malformed file.
+template <typename T>
+static bool readCachedJSON(const llvm::SmallString<128> &entryPath,
+                           llvm::StringRef fileName, std::vector<T> &out) {
+  llvm::SmallString<128> path(entryPath);
+  llvm::sys::path::append(path, fileName);
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer) {
+    return false;
+  }
+  auto parsed = llvm::json::parse<std::vector<T>>((*buffer)->getBuffer());
+  if (!parsed) {
+    llvm::consumeError(parsed.takeError());
+    return false;
+  }
+  out.insert(out.end(), parsed->begin(), parsed->end());
+  return true;
+}
+
+bool restoreCachedSourceCompilation(
+    llvm::StringRef key, llvm::StringRef outputDirPath,
+    std::vector<std::string> &objectPaths,
+    std::vector<ClientParameters> &clientParameters,
+    std::vector<CompilationFeedback> &compilationFeedbacks) {
+  auto entryPath = compilationCachePath(key);
+  if (!entryPath.has_value() || !llvm::sys::fs::is_directory(*entryPath)) {
+    return false;
+  }
+  if (llvm::sys::fs::create_directories(outputDirPath)) {
+    return false;
+  }
+  // Everything is staged locally and appended to the caller's vectors
+  // only once the whole entry restored: a half-restored entry falls
+  // back to recompilation, which must not see duplicated parameters.
+  std::vector<ClientParameters> restoredParameters;
+  std::vector<CompilationFeedback> restoredFeedbacks;
+  if (!readCachedJSON(*entryPath, SOURCE_CACHE_PARAMS_FILE,
+                      restoredParameters) ||
+      !readCachedJSON(*entryPath, SOURCE_CACHE_FEEDBACK_FILE,
+                      restoredFeedbacks)) {
+    return false;
+  }
+  // Objects are restored under a key-unique name so that entries of
+  // different sources cannot collide in the output directory.
+  std::vector<std::string> restored;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(*entryPath, ec), end;
+       !ec && it != end; it.increment(ec)) {
+    if (it->type() != llvm::sys::fs::file_type::regular_file) {
+      continue;
+    }
+    auto name = llvm::sys::path::filename(it->path());
+    if (!name.startswith("object-")) {
+      continue;
+    }
+    llvm::SmallString<128> destination(outputDirPath);
+    llvm::sys::path::append(destination, (key + "-" + name).str());
+    if (llvm::sys::fs::copy_file(it->path(), destination)) {
+      return false;
+    }
+    restored.push_back(std::string(destination));
+  }
+  if (ec) {
+    return false;
+  }
+  // Directory iteration order is unspecified, keep the link order
+  // deterministic.
+  std::sort(restored.begin(), restored.end());
+  objectPaths.insert(objectPaths.end(), restored.begin(), restored.end());
+  clientParameters.insert(clientParameters.end(), restoredParameters.begin(),
+                          restoredParameters.end());
+  compilationFeedbacks.insert(compilationFeedbacks.end(),
+                              restoredFeedbacks.begin(),
+                              restoredFeedbacks.end());
+  return true;
+}
+
+void cacheSourceCompilation(
+    llvm::StringRef key, llvm::ArrayRef<std::string> objectPaths,
+    llvm::ArrayRef<ClientParameters> clientParameters,
+    llvm::ArrayRef<CompilationFeedback> compilationFeedbacks) {
+  auto entryPath = compilationCachePath(key);
+  if (!entryPath.has_value() || llvm::sys::fs::is_directory(*entryPath)) {
+    return;
+  }
+  llvm::SmallString<128> temporaryPath;
+  if (llvm::sys::fs::createUniqueDirectory(*entryPath + ".tmp",
+                                           temporaryPath)) {
+    return;
+  }
+  bool ok = true;
+  for (size_t i = 0; i < objectPaths.size() && ok; i++) {
+    llvm::SmallString<128> destination(temporaryPath);
+    llvm::sys::path::append(destination, "object-" + std::to_string(i) + ".o");
+    ok = !llvm::sys::fs::copy_file(objectPaths[i], destination);
+  }
+  auto writeJSON = [&](llvm::StringRef fileName, llvm::json::Value value) {
+    llvm::SmallString<128> path(temporaryPath);
+    llvm::sys::path::append(path, fileName);
+    std::error_code error;
+    llvm::raw_fd_ostream out(path, error);
+    if (error) {
+      ok = false;
+      return;
+    }
+    out << llvm::formatv("{0:2}", value);
+    out.close();
+  };
+  if (ok) {
+    writeJSON(SOURCE_CACHE_PARAMS_FILE,
+              llvm::json::Value(std::vector<ClientParameters>(
+                  clientParameters.begin(), clientParameters.end())));
+  }
+  if (ok) {
+    writeJSON(SOURCE_CACHE_FEEDBACK_FILE,
+              llvm::json::Value(std::vector<CompilationFeedback>(
+                  compilationFeedbacks.begin(), compilationFeedbacks.end())));
+  }
+  if (!ok || llvm::sys::fs::rename(temporaryPath, *entryPath)) {
+    llvm::sys::fs::remove_directories(temporaryPath);
+  }
+}
+
+} // namespace concretelang
+} // namespace mlir
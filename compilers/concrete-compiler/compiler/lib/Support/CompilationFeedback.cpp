@@ -8,7 +8,11 @@
 
 #include "boost/outcome.h"
 #include "llvm/Support/JSON.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
 
+#include "concretelang/Dialect/TFHE/IR/TFHEOps.h"
+#include "concretelang/Dialect/TFHE/IR/TFHETypes.h"
 #include "concretelang/Support/CompilationFeedback.h"
 
 namespace mlir {
@@ -64,6 +68,88 @@ void CompilationFeedback::fillFromClientParameters(
   }
 }
 
+/// Returns the number of bytes of the ciphertext (or tensor of
+/// ciphertexts) `type`, or 0 if `type` is not a ciphertext type or its
+/// key carries no parameters.
+static uint64_t ciphertextByteSize(mlir::Type type) {
+  uint64_t numElements = 1;
+  if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>()) {
+    if (!tensorType.hasStaticShape()) {
+      return 0;
+    }
+    for (auto dim : tensorType.getShape()) {
+      numElements *= dim;
+    }
+    type = tensorType.getElementType();
+  }
+  auto glweType = type.dyn_cast<TFHE::GLWECipherTextType>();
+  if (!glweType) {
+    return 0;
+  }
+  auto key = glweType.getKey();
+  uint64_t dimension, polySize;
+  if (auto parameterized = key.getParameterized()) {
+    dimension = parameterized->dimension;
+    polySize = parameterized->polySize;
+  } else if (auto normalized = key.getNormalized()) {
+    dimension = normalized->dimension;
+    polySize = normalized->polySize;
+  } else {
+    return 0;
+  }
+  return numElements * (dimension * polySize + 1) * sizeof(uint64_t);
+}
+
+void CompilationFeedback::fillOpStatsFromTFHE(mlir::ModuleOp module) {
+  totalPBSCount = 0;
+  totalKSCount = 0;
+  totalWopPBSCount = 0;
+  totalIntermediateCiphertextSize = 0;
+  peakIntermediateCiphertextSize = 0;
+
+  for (auto func : module.getOps<mlir::func::FuncOp>()) {
+    // Number the operations in walk order and compute the live range of
+    // every intermediate ciphertext, i.e. the range between the
+    // producing operation and its last user.
+    llvm::DenseMap<mlir::Operation *, uint64_t> opIndex;
+    uint64_t index = 0;
+    func.walk([&](mlir::Operation *op) { opIndex[op] = index++; });
+
+    // Accumulated size deltas at each operation index: the size of a
+    // ciphertext is accounted from its definition to its last use.
+    std::map<uint64_t, int64_t> sizeDeltas;
+    func.walk([&](mlir::Operation *op) {
+      if (llvm::isa<TFHE::BootstrapGLWEOp>(op)) {
+        totalPBSCount++;
+      } else if (llvm::isa<TFHE::KeySwitchGLWEOp>(op)) {
+        totalKSCount++;
+      } else if (llvm::isa<TFHE::WopPBSGLWEOp>(op)) {
+        totalWopPBSCount++;
+      }
+      for (auto result : op->getResults()) {
+        uint64_t byteSize = ciphertextByteSize(result.getType());
+        if (byteSize == 0) {
+          continue;
+        }
+        totalIntermediateCiphertextSize += byteSize;
+        uint64_t lastUse = opIndex[op];
+        for (auto *user : result.getUsers()) {
+          lastUse = std::max(lastUse, opIndex[user]);
+        }
+        sizeDeltas[opIndex[op]] += byteSize;
+        sizeDeltas[lastUse + 1] -= byteSize;
+      }
+    });
+
+    uint64_t liveSize = 0;
+    for (auto delta : sizeDeltas) {
+      liveSize += delta.second;
+      peakIntermediateCiphertextSize =
+          std::max(peakIntermediateCiphertextSize, liveSize);
+    }
+  }
+}
+
 outcome::checked<CompilationFeedback, StringError>
 CompilationFeedback::load(std::string jsonPath) {
   std::ifstream file(jsonPath);
@@ -81,6 +167,20 @@ CompilationFeedback::load(std::string jsonPath) {
   return expectedCompFeedback.get();
 }
 
+llvm::json::Value toJSON(const mlir::concretelang::PhaseTiming &v) {
+  llvm::json::Object object{
+      {"name", v.name},
+      {"seconds", v.seconds},
+  };
+  return object;
+}
+
+bool fromJSON(const llvm::json::Value j, mlir::concretelang::PhaseTiming &v,
+              llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("name", v.name) && O.map("seconds", v.seconds);
+}
+
 llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &v) {
   llvm::json::Object object{
       {"complexity", v.complexity},
@@ -92,6 +192,12 @@ llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &v) {
       {"totalInputsSize", v.totalInputsSize},
       {"totalOutputsSize", v.totalOutputsSize},
       {"crtDecompositionsOfOutputs", v.crtDecompositionsOfOutputs},
+      {"totalPBSCount", v.totalPBSCount},
+      {"totalKSCount", v.totalKSCount},
+      {"totalWopPBSCount", v.totalWopPBSCount},
+      {"totalIntermediateCiphertextSize", v.totalIntermediateCiphertextSize},
+      {"peakIntermediateCiphertextSize", v.peakIntermediateCiphertextSize},
+      {"phaseTimings", v.phaseTimings},
   };
   return object;
 }
@@ -106,7 +212,15 @@ bool fromJSON(const llvm::json::Value j,
          O.map("totalKeyswitchKeysSize", v.totalKeyswitchKeysSize) &&
          O.map("totalInputsSize", v.totalInputsSize) &&
          O.map("totalOutputsSize", v.totalOutputsSize) &&
-         O.map("crtDecompositionsOfOutputs", v.crtDecompositionsOfOutputs);
+         O.map("crtDecompositionsOfOutputs", v.crtDecompositionsOfOutputs) &&
+         O.mapOptional("totalPBSCount", v.totalPBSCount) &&
+         O.mapOptional("totalKSCount", v.totalKSCount) &&
+         O.mapOptional("totalWopPBSCount", v.totalWopPBSCount) &&
+         O.mapOptional("totalIntermediateCiphertextSize",
+                       v.totalIntermediateCiphertextSize) &&
+         O.mapOptional("peakIntermediateCiphertextSize",
+                       v.peakIntermediateCiphertextSize) &&
+         O.mapOptional("phaseTimings", v.phaseTimings);
 }
 
 } // namespace concretelang
@@ -3,17 +3,25 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <llvm/Support/Debug.h>
 #include <mlir/Dialect/Arith/Transforms/BufferizableOpInterfaceImpl.h>
+#include <mlir/Dialect/Async/IR/Async.h>
 #include <mlir/Dialect/Bufferization/IR/Bufferization.h>
 #include <mlir/Dialect/Linalg/Transforms/BufferizableOpInterfaceImpl.h>
 #include <mlir/Dialect/SCF/Transforms/BufferizableOpInterfaceImpl.h>
 #include <mlir/Dialect/Tensor/Transforms/BufferizableOpInterfaceImpl.h>
 #include <stdio.h>
 #include <string>
+#include <thread>
+#include <unistd.h>
 
+#include <llvm/Support/Compression.h>
 #include <llvm/Support/Error.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SMLoc.h>
@@ -42,6 +50,8 @@
 #include <concretelang/Dialect/Tracing/IR/TracingDialect.h>
 #include <concretelang/Dialect/Tracing/Transforms/BufferizableOpInterfaceImpl.h>
 #include <concretelang/Runtime/DFRuntime.hpp>
+#include <concretelang/Support/BatchingProfile.h>
+#include <concretelang/Support/CompilationCache.h>
 #include <concretelang/Support/CompilerEngine.h>
 #include <concretelang/Support/Encodings.h>
 #include <concretelang/Support/Error.h>
@@ -85,7 +95,8 @@ mlir::MLIRContext *CompilationContext::getMLIRContext() {
         mlir::concretelang::SDFG::SDFGDialect, mlir::func::FuncDialect,
         mlir::memref::MemRefDialect, mlir::linalg::LinalgDialect,
         mlir::LLVM::LLVMDialect, mlir::scf::SCFDialect,
-        mlir::omp::OpenMPDialect, mlir::bufferization::BufferizationDialect>();
+        mlir::omp::OpenMPDialect, mlir::async::AsyncDialect,
+        mlir::bufferization::BufferizationDialect>();
     Tracing::registerBufferizableOpInterfaceExternalModels(registry);
     Concrete::registerBufferizableOpInterfaceExternalModels(registry);
     SDFG::registerSDFGConvertibleOpInterfaceExternalModels(registry);
@@ -100,7 +111,6 @@ mlir::MLIRContext *CompilationContext::getMLIRContext() {
     this->mlirContext = new mlir::MLIRContext();
     this->mlirContext->appendDialectRegistry(registry);
     this->mlirContext->loadAllAvailableDialects();
-    this->mlirContext->disableMultithreading();
   }
 
   return this->mlirContext;
@@ -212,11 +222,21 @@ llvm::Error CompilerEngine::determineFHEParameters(CompilationResult &res) {
     // backend.
     compilerOptions.optimizerConfig.use_gpu_constraints =
         compilerOptions.emitGPUOps;
-    auto expectedSolution = getSolution(descr.get().value(), feedback,
-                                        compilerOptions.optimizerConfig);
+    // The parameter search is a phase of its own for the compile-time
+    // feedback: it runs outside the pass pipeline but often dominates.
+    auto searchStart = std::chrono::steady_clock::now();
+    auto expectedSolution =
+        compilerOptions.autotuneOptimizer
+            ? getAutotunedSolution(descr.get().value(), feedback,
+                                   compilerOptions.optimizerConfig)
+            : getSolution(descr.get().value(), feedback,
+                          compilerOptions.optimizerConfig);
     if (auto err = expectedSolution.takeError()) {
       return err;
     }
+    std::chrono::duration<double> searchTime =
+        std::chrono::steady_clock::now() - searchStart;
+    pipeline::recordPhaseTiming({"OptimizerSearch", searchTime.count()});
     res.fheContext.emplace(mlir::concretelang::V0FHEContext{
         descr.get().value().constraint, *expectedSolution});
     res.feedback.emplace(feedback);
@@ -242,6 +262,10 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
 
   CompilationResult res(this->compilationContext);
 
+  // Drop phase timings a previous compilation on this thread may have
+  // left behind, so the record below covers this compilation only.
+  mlir::concretelang::pipeline::consumePhaseTimings();
+
   CompilationOptions &options = this->compilerOptions;
 
   // enable/disable usage of gpu functions during bufferization
@@ -272,7 +296,9 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
       return std::move(res);
   }
 
-  if (loopParallelize)
+  // The async-runtime lowering emits no OpenMP regions, so only tell the
+  // dataflow runtime about OpenMP when OpenMP is actually generated.
+  if (loopParallelize && !options.asyncLoopParallelize)
     mlir::concretelang::dfr::_dfr_set_use_omp(true);
 
   if (dataflowParallelize)
@@ -322,14 +348,36 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
     }
   }
 
+  // Merge duplicated encrypted computations before TLU fusion and
+  // parameter determination, so a deduplicated lookup chain fuses once
+  if (mlir::concretelang::pipeline::deduplicateFHEOps(mlirContext, module,
+                                                      enablePass)
+          .failed()) {
+    return errorDiag("Deduplicating FHE operations failed");
+  }
+
+  // Compose chained table lookups before parameter determination, so
+  // the removed intermediate bootstraps never reach the optimizer
+  if (mlir::concretelang::pipeline::fuseChainedTLU(mlirContext, module,
+                                                   enablePass)
+          .failed()) {
+    return errorDiag("Fusing chained table lookups failed");
+  }
+
   // FHE High level pass to determine FHE parameters
   if (auto err = this->determineFHEParameters(res))
     return std::move(err);
 
-  // FHELinalg tiling
-  if (options.fhelinalgTileSizes) {
+  // FHELinalg tiling. With explicit tile sizes, all matrix
+  // multiplications are tiled accordingly; otherwise, large matrix
+  // multiplications are tiled with automatically selected tile sizes,
+  // so that the intermediate tensors materialized by bufferization
+  // stay small instead of growing with the operands.
+  {
+    std::vector<int64_t> tileSizes =
+        options.fhelinalgTileSizes.value_or(std::vector<int64_t>{});
     if (mlir::concretelang::pipeline::markFHELinalgForTiling(
-            mlirContext, module, *options.fhelinalgTileSizes, enablePass)
+            mlirContext, module, tileSizes, enablePass)
             .failed())
       return errorDiag("Marking of FHELinalg operations for tiling failed");
   }
@@ -366,6 +414,14 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   if (target == Target::FHE_NO_LINALG)
     return std::move(res);
 
+  // Fold statically-known cleartext computation before it is lowered
+  // alongside the encrypted operations.
+  if (mlir::concretelang::pipeline::foldCleartextOperations(mlirContext, module,
+                                                            enablePass)
+          .failed()) {
+    return errorDiag("Folding of cleartext operations failed");
+  }
+
   // FHE -> TFHE
   if (mlir::concretelang::pipeline::lowerFHEToTFHE(mlirContext, module,
                                                    res.fheContext, enablePass)
@@ -433,6 +489,7 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
 
       res.clientParameters = clientParametersOrErr.get();
       res.feedback->fillFromClientParameters(*res.clientParameters);
+      res.feedback->fillOpStatsFromTFHE(module);
     }
   }
 
@@ -440,8 +497,16 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
     return std::move(res);
 
   if (options.batchTFHEOps) {
+    int64_t maxBatchSize = options.maxBatchSize;
+    // A runtime batching profile bounds the batch sizes by what the
+    // workload actually forms, instead of the static default.
+    if (options.batchingProfile.has_value()) {
+      auto profiledBound = maxBatchSizeFromProfile(*options.batchingProfile);
+      if (profiledBound.has_value())
+        maxBatchSize = std::min(maxBatchSize, *profiledBound);
+    }
     if (mlir::concretelang::pipeline::batchTFHE(mlirContext, module, enablePass,
-                                                options.maxBatchSize)
+                                                maxBatchSize)
             .failed()) {
       return errorDiag("Batching of TFHE operations");
     }
@@ -502,12 +567,21 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
     return errorDiag("Lowering from SDFG to canonical MLIR dialects failed");
   }
 
+  // Specialize the lowered circuit for its static shapes
+  if (options.specializeStaticShapes &&
+      mlir::concretelang::pipeline::specializeStaticShapes(mlirContext, module,
+                                                           enablePass)
+          .failed()) {
+    return errorDiag("Static shape specialization failed");
+  }
+
   if (target == Target::STD)
     return std::move(res);
 
   // MLIR canonical dialects -> LLVM Dialect
   if (mlir::concretelang::pipeline::lowerStdToLLVMDialect(
-          mlirContext, module, enablePass, loopParallelize, options.emitGPUOps)
+          mlirContext, module, enablePass, loopParallelize,
+          options.asyncLoopParallelize, options.emitGPUOps)
           .failed()) {
     return errorDiag("Failed to lower to LLVM dialect");
   }
@@ -527,8 +601,9 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   if (target == Target::LLVM_IR)
     return std::move(res);
 
-  if (mlir::concretelang::pipeline::optimizeLLVMModule(llvmContext,
-                                                       *res.llvmModule)
+  if (mlir::concretelang::pipeline::optimizeLLVMModule(
+          llvmContext, *res.llvmModule, options.loopUnrollFactor,
+          options.forceLoopVectorize, options.vectorizerReport)
           .failed()) {
     return errorDiag("Failed to optimize LLVM IR");
   }
@@ -536,6 +611,13 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   if (target == Target::OPTIMIZED_LLVM_IR)
     return std::move(res);
 
+  // Attach the per-phase compile times to the feedback; intermediate
+  // targets return above without them, they stop mid-pipeline anyway.
+  if (res.feedback.has_value()) {
+    res.feedback->phaseTimings =
+        mlir::concretelang::pipeline::consumePhaseTimings();
+  }
+
   if (target == Target::LIBRARY) {
     if (!lib) {
       return StreamStringError(
@@ -573,6 +655,41 @@ CompilerEngine::compile(std::unique_ptr<llvm::MemoryBuffer> buffer,
   return this->compile(sm, target, lib);
 }
 
+/// Splits `source` into one source per function when the functions of
+/// the module are independent (no function references another symbol of
+/// the module), so that each circuit can be lowered and emitted on its
+/// own. Returns std::nullopt when splitting is not possible: a single
+/// function, cross-function references, or a source the parser rejects
+/// (which the regular compilation path will diagnose).
+static std::optional<std::vector<std::string>>
+splitIndependentCircuits(mlir::MLIRContext &context, llvm::StringRef source) {
+  mlir::OwningOpRef<mlir::ModuleOp> module =
+      mlir::parseSourceString<mlir::ModuleOp>(source, &context);
+  if (!module)
+    return std::nullopt;
+  std::vector<mlir::func::FuncOp> funcs;
+  for (auto func : module->getOps<mlir::func::FuncOp>())
+    funcs.push_back(func);
+  if (funcs.size() < 2)
+    return std::nullopt;
+  for (auto func : funcs) {
+    auto uses = mlir::SymbolTable::getSymbolUses(func, module->getOperation());
+    if (uses.has_value() && !uses->empty())
+      return std::nullopt;
+  }
+  std::vector<std::string> circuits;
+  for (auto func : funcs) {
+    mlir::OwningOpRef<mlir::ModuleOp> circuit =
+        mlir::ModuleOp::create(module->getLoc());
+    circuit->push_back(func.clone());
+    std::string printed;
+    llvm::raw_string_ostream os(printed);
+    circuit->print(os);
+    circuits.push_back(os.str());
+  }
+  return circuits;
+}
+
 llvm::Expected<CompilerEngine::Library> CompilerEngine::compile(
     std::vector<std::string> inputs, std::string outputDirPath,
     std::string runtimeLibraryPath, bool generateSharedLib,
@@ -581,12 +698,69 @@ llvm::Expected<CompilerEngine::Library> CompilerEngine::compile(
   using Library = mlir::concretelang::CompilerEngine::Library;
   auto outputLib = std::make_shared<Library>(outputDirPath, runtimeLibraryPath);
   auto target = CompilerEngine::Target::LIBRARY;
+  if (compilerOptions.streamingCompilation) {
+    // Stream the independent circuits of each module through the
+    // pipeline one at a time: every circuit's objects are emitted and
+    // its intermediate IR released before the next one is lowered.
+    std::vector<std::string> split;
+    for (auto &input : inputs) {
+      auto circuits = splitIndependentCircuits(
+          *compilationContext->getMLIRContext(), input);
+      if (circuits.has_value())
+        split.insert(split.end(), circuits->begin(), circuits->end());
+      else
+        split.push_back(input);
+    }
+    inputs = std::move(split);
+  }
+  auto cacheKey = compilationCacheKey(
+      inputs, compilerOptions, runtimeLibraryPath, generateSharedLib,
+      generateStaticLib, generateClientParameters, generateCompilationFeedback,
+      generateCppHeader);
+  if (cacheKey.has_value() &&
+      restoreCachedLibrary(*cacheKey, outputDirPath)) {
+    if (generateSharedLib)
+      outputLib->sharedLibraryPath = Library::getSharedLibraryPath(outputDirPath);
+    if (generateStaticLib)
+      outputLib->staticLibraryPath = Library::getStaticLibraryPath(outputDirPath);
+    return *outputLib.get();
+  }
   for (auto input : inputs) {
+    // Reuse the cached compilation of unchanged sources so that only
+    // modified sources go through the whole pipeline again.
+    auto sourceKey =
+        sourceCompilationCacheKey(input, compilerOptions, runtimeLibraryPath);
+    if (sourceKey.has_value()) {
+      std::vector<std::string> cachedObjects;
+      std::vector<ClientParameters> cachedParams;
+      std::vector<CompilationFeedback> cachedFeedbacks;
+      if (restoreCachedSourceCompilation(*sourceKey, outputDirPath,
+                                         cachedObjects, cachedParams,
+                                         cachedFeedbacks)) {
+        outputLib->addCachedCompilation(cachedObjects, cachedParams,
+                                        cachedFeedbacks);
+        continue;
+      }
+    }
+    size_t firstObject = outputLib->getObjectsPath().size();
+    size_t firstParam = outputLib->getClientParametersList().size();
+    size_t firstFeedback = outputLib->getCompilationFeedbackList().size();
     auto compilation = compile(input, target, outputLib);
     if (!compilation) {
       return StreamStringError("Can't compile: ")
              << llvm::toString(compilation.takeError());
     }
+    if (sourceKey.has_value()) {
+      cacheSourceCompilation(
+          *sourceKey,
+          llvm::ArrayRef<std::string>(outputLib->getObjectsPath())
+              .drop_front(firstObject),
+          llvm::ArrayRef<ClientParameters>(outputLib->getClientParametersList())
+              .drop_front(firstParam),
+          llvm::ArrayRef<CompilationFeedback>(
+              outputLib->getCompilationFeedbackList())
+              .drop_front(firstFeedback));
+    }
   }
   if (auto err = outputLib->emitArtifacts(
           generateSharedLib, generateStaticLib, generateClientParameters,
@@ -594,6 +768,9 @@ llvm::Expected<CompilerEngine::Library> CompilerEngine::compile(
     return StreamStringError("Can't emit artifacts: ")
            << llvm::toString(std::move(err));
   }
+  if (cacheKey.has_value()) {
+    cacheLibrary(*cacheKey, outputDirPath);
+  }
   return *outputLib.get();
 }
 
@@ -607,6 +784,23 @@ CompilerEngine::compile(llvm::SourceMgr &sm, std::string outputDirPath,
   auto outputLib = std::make_shared<Library>(outputDirPath, runtimeLibraryPath);
   auto target = CompilerEngine::Target::LIBRARY;
 
+  std::vector<std::string> sources;
+  for (unsigned i = 1; i <= sm.getNumBuffers(); i++) {
+    sources.push_back(sm.getMemoryBuffer(i)->getBuffer().str());
+  }
+  auto cacheKey = compilationCacheKey(
+      sources, compilerOptions, runtimeLibraryPath, generateSharedLib,
+      generateStaticLib, generateClientParameters, generateCompilationFeedback,
+      generateCppHeader);
+  if (cacheKey.has_value() &&
+      restoreCachedLibrary(*cacheKey, outputDirPath)) {
+    if (generateSharedLib)
+      outputLib->sharedLibraryPath = Library::getSharedLibraryPath(outputDirPath);
+    if (generateStaticLib)
+      outputLib->staticLibraryPath = Library::getStaticLibraryPath(outputDirPath);
+    return *outputLib.get();
+  }
+
   auto compilation = compile(sm, target, outputLib);
   if (!compilation) {
     return StreamStringError("Can't compile: ")
@@ -619,6 +813,9 @@ CompilerEngine::compile(llvm::SourceMgr &sm, std::string outputDirPath,
     return StreamStringError("Can't emit artifacts: ")
            << llvm::toString(std::move(err));
   }
+  if (cacheKey.has_value()) {
+    cacheLibrary(*cacheKey, outputDirPath);
+  }
   return *outputLib.get();
 }
 
@@ -676,6 +873,7 @@ const std::string CompilerEngine::Library::LINKER_SHARED_OPT = " --shared -o ";
 const std::string CompilerEngine::Library::DOT_SHARED_LIB_EXT = ".so";
 #endif
 const std::string CompilerEngine::Library::AR = "ar";
+const std::string CompilerEngine::Library::COMPRESSED_EXT = ".zc";
 const std::string CompilerEngine::Library::AR_STATIC_OPT = " rcs ";
 const std::string CompilerEngine::Library::DOT_STATIC_LIB_EXT = ".a";
 
@@ -697,6 +895,16 @@ CompilerEngine::Library::emitClientParametersJSON() {
   out << llvm::formatv("{0:2}", value);
   out.close();
 
+  // Also emit the binary sidecar, preferred at load; the JSON above
+  // stays the inspectable form.
+  auto binaryPath =
+      ClientParameters::getClientParametersBinaryPath(clientParamsPath);
+  auto saved =
+      ClientParameters::saveBinary(clientParametersList, binaryPath);
+  if (saved.has_error()) {
+    return StreamStringError(saved.error().mesg);
+  }
+
   return clientParamsPath;
 }
 
@@ -810,6 +1018,11 @@ llvm::Expected<std::string> CompilerEngine::Library::emitCppHeader() {
 
 llvm::Expected<std::string>
 CompilerEngine::Library::addCompilation(CompilationResult &compilation) {
+  // Held for the whole registration: the fallback object name derives from
+  // the number of registered objects, so naming and registration must not
+  // interleave between concurrent engines. Object emission is internally
+  // parallel, serializing it here costs little.
+  const std::lock_guard<std::mutex> guard(registrationMutex);
   llvm::Module *module = compilation.llvmModule.get();
   auto sourceName = module->getSourceFileName();
   if (sourceName == "" || sourceName == "LLVMDialectModule") {
@@ -817,11 +1030,15 @@ CompilerEngine::Library::addCompilation(CompilationResult &compilation) {
                  std::to_string(objectsPath.size()) + ".mlir";
   }
   auto objectPath = sourceName + OBJECT_EXT;
-  if (auto error = mlir::concretelang::emitObject(*module, objectPath)) {
-    return std::move(error);
+  auto emittedObjectsPath = mlir::concretelang::emitObjects(
+      *module, objectPath, std::thread::hardware_concurrency());
+  if (!emittedObjectsPath) {
+    return emittedObjectsPath.takeError();
   }
 
-  addExtraObjectFilePath(objectPath);
+  for (auto &emittedObjectPath : emittedObjectsPath.value()) {
+    addExtraObjectFilePath(emittedObjectPath);
+  }
   if (compilation.clientParameters.has_value()) {
     clientParametersList.push_back(compilation.clientParameters.value());
   }
@@ -831,6 +1048,20 @@ CompilerEngine::Library::addCompilation(CompilationResult &compilation) {
   return objectPath;
 }
 
+void CompilerEngine::Library::addCachedCompilation(
+    const std::vector<std::string> &objects,
+    const std::vector<mlir::concretelang::ClientParameters> &params,
+    const std::vector<mlir::concretelang::CompilationFeedback> &feedbacks) {
+  const std::lock_guard<std::mutex> guard(registrationMutex);
+  for (auto &objectPath : objects) {
+    addExtraObjectFilePath(objectPath);
+  }
+  clientParametersList.insert(clientParametersList.end(), params.begin(),
+                              params.end());
+  compilationFeedbackList.insert(compilationFeedbackList.end(),
+                                 feedbacks.begin(), feedbacks.end());
+}
+
 bool stringEndsWith(std::string path, std::string requiredExt) {
   return path.substr(path.size() - requiredExt.size()) == requiredExt;
 }
@@ -947,28 +1178,152 @@ llvm::Error CompilerEngine::Library::emitArtifacts(bool sharedLib,
                                                    bool cppHeader) {
   // Create output directory if doesn't exist
   llvm::sys::fs::create_directory(outputDirPath);
+
+  // The artifacts only share the object files, which are read-only by
+  // now, so they are written concurrently instead of one after the
+  // other: the shared-library link and the static archive dominate the
+  // wall time on networked storage, and the small JSON and header
+  // writes hide entirely behind them.
+  std::vector<std::function<llvm::Error()>> emitters;
   if (sharedLib) {
-    if (auto err = emitShared().takeError()) {
-      return err;
-    }
+    emitters.push_back([this] { return emitShared().takeError(); });
   }
   if (staticLib) {
-    if (auto err = emitStatic().takeError()) {
-      return err;
-    }
+    emitters.push_back([this] { return emitStatic().takeError(); });
   }
   if (clientParameters) {
-    if (auto err = emitClientParametersJSON().takeError()) {
-      return err;
-    }
+    emitters.push_back(
+        [this] { return emitClientParametersJSON().takeError(); });
   }
   if (compilationFeedback) {
-    if (auto err = emitCompilationFeedbackJSON().takeError()) {
-      return err;
-    }
+    emitters.push_back(
+        [this] { return emitCompilationFeedbackJSON().takeError(); });
   }
   if (cppHeader) {
-    if (auto err = emitCppHeader().takeError()) {
+    emitters.push_back([this] { return emitCppHeader().takeError(); });
+  }
+
+  // Failures are carried as strings so the llvm::Error checking
+  // discipline stays within each writer thread.
+  std::vector<std::optional<std::string>> failures(emitters.size());
+  std::vector<std::thread> writers;
+  writers.reserve(emitters.size());
+  for (size_t i = 0; i < emitters.size(); i++) {
+    writers.push_back(std::thread([&, i] {
+      if (auto err = emitters[i]())
+        failures[i] = llvm::toString(std::move(err));
+    }));
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  for (auto &failure : failures) {
+    if (failure.has_value()) {
+      return StreamStringError(*failure);
+    }
+  }
+  return llvm::Error::success();
+}
+
+namespace {
+// Header of a compressed artifact container: a magic tag, the container
+// format version and the uncompressed byte size, followed by one zlib
+// stream holding the whole artifact.
+const char COMPRESSED_MAGIC[4] = {'C', 'L', 'Z', 'C'};
+const uint32_t COMPRESSED_VERSION = 1;
+} // namespace
+
+llvm::Error CompilerEngine::Library::compressArtifact(std::string path) {
+  if (!llvm::zlib::isAvailable()) {
+    return StreamStringError(
+        "artifact compression requires an LLVM built with zlib");
+  }
+  std::ifstream input(path, std::ios::binary);
+  if (!input.good()) {
+    return StreamStringError("cannot read artifact: ") << path;
+  }
+  std::string raw((std::istreambuf_iterator<char>(input)),
+                  std::istreambuf_iterator<char>());
+  llvm::SmallVector<char, 0> compressed;
+  if (auto err = llvm::zlib::compress(llvm::StringRef(raw.data(), raw.size()),
+                                      compressed,
+                                      llvm::zlib::BestSizeCompression)) {
+    return err;
+  }
+  auto containerPath = path + COMPRESSED_EXT;
+  std::ofstream output(containerPath, std::ios::binary | std::ios::trunc);
+  uint32_t version = COMPRESSED_VERSION;
+  uint64_t rawSize = raw.size();
+  output.write(COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC));
+  output.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  output.write(reinterpret_cast<const char *>(&rawSize), sizeof(rawSize));
+  output.write(compressed.data(), compressed.size());
+  output.close();
+  if (!output.good()) {
+    return StreamStringError("cannot write artifact container: ")
+           << containerPath;
+  }
+  return llvm::Error::success();
+}
+
+llvm::Error CompilerEngine::Library::decompressArtifact(std::string path) {
+  auto containerPath = path + COMPRESSED_EXT;
+  std::ifstream input(containerPath, std::ios::binary);
+  if (!input.good()) {
+    return StreamStringError("cannot read artifact container: ")
+           << containerPath;
+  }
+  char magic[sizeof(COMPRESSED_MAGIC)];
+  uint32_t version = 0;
+  uint64_t rawSize = 0;
+  input.read(magic, sizeof(magic));
+  input.read(reinterpret_cast<char *>(&version), sizeof(version));
+  input.read(reinterpret_cast<char *>(&rawSize), sizeof(rawSize));
+  if (!input.good() ||
+      memcmp(magic, COMPRESSED_MAGIC, sizeof(magic)) != 0) {
+    return StreamStringError("not a compressed artifact container: ")
+           << containerPath;
+  }
+  if (version != COMPRESSED_VERSION) {
+    return StreamStringError("unsupported artifact container version: ")
+           << version;
+  }
+  std::string compressed((std::istreambuf_iterator<char>(input)),
+                         std::istreambuf_iterator<char>());
+  llvm::SmallVector<char, 0> raw;
+  if (auto err = llvm::zlib::uncompress(
+          llvm::StringRef(compressed.data(), compressed.size()), raw,
+          rawSize)) {
+    return err;
+  }
+  // Expand into a process-unique temporary and rename it into place, so
+  // concurrent loaders racing on the first access never observe a
+  // partially written artifact.
+  auto temporaryPath = path + ".expand." + std::to_string(getpid());
+  std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+  output.write(raw.data(), raw.size());
+  output.close();
+  if (!output.good()) {
+    return StreamStringError("cannot expand artifact container: ")
+           << containerPath;
+  }
+  if (rename(temporaryPath.c_str(), path.c_str()) != 0) {
+    remove(temporaryPath.c_str());
+    return StreamStringError("cannot expand artifact to: ") << path;
+  }
+  return llvm::Error::success();
+}
+
+llvm::Error CompilerEngine::Library::compressArtifacts() {
+  // The shared library (which embeds the constant pools) and the client
+  // parameters are the artifacts a deployment ships; the static library
+  // and the objects stay local to the build, so they are not packed.
+  for (auto path : {getSharedLibraryPath(outputDirPath),
+                    getClientParametersPath(outputDirPath)}) {
+    if (!llvm::sys::fs::exists(path)) {
+      continue;
+    }
+    if (auto err = compressArtifact(path)) {
       return err;
     }
   }
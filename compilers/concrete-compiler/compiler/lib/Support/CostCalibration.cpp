@@ -0,0 +1,194 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "concrete-cpu.h"
+#include "concretelang/Support/CostCalibration.h"
+#include "concretelang/Support/logging.h"
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+// Reference parameter set the microbenchmarks run on. The fitted weights
+// are per-abstract-operation costs, so any mid-range set works; this one
+// sits in the middle of the search space the optimizer explores.
+constexpr size_t GLWE_DIMENSION = 1;
+constexpr size_t POLYNOMIAL_SIZE = 2048;
+constexpr size_t LWE_SMALL_DIMENSION = 750;
+constexpr size_t BR_LEVEL = 2;
+constexpr size_t BR_BASE_LOG = 15;
+constexpr size_t KS_LEVEL = 5;
+constexpr size_t KS_BASE_LOG = 3;
+
+// Iteration counts sized so each benchmark runs for tens of milliseconds,
+// enough to average out scheduling noise without delaying compilation.
+constexpr size_t PBS_ITERATIONS = 16;
+constexpr size_t KS_ITERATIONS = 2048;
+
+// Abstract operation counts of the optimizer's complexity model (see
+// concrete-optimizer computing_cost) for the reference parameter set. The
+// formulas are mirrored here so the weights stay per-operation costs: if
+// the model changes these must follow.
+double fftModelCost(double size) { return size * std::log2(size) + size; }
+
+double pbsModelCost() {
+  double polynomialSize = POLYNOMIAL_SIZE;
+  double glweSize = GLWE_DIMENSION + 1;
+  double level = BR_LEVEL;
+  double fftCost = glweSize * level * fftModelCost(polynomialSize);
+  double ifftCost = glweSize * fftModelCost(polynomialSize);
+  double externalProductCost = glweSize * glweSize * level * polynomialSize;
+  double cmuxCost = fftCost + ifftCost + externalProductCost;
+  return (double)LWE_SMALL_DIMENSION * cmuxCost;
+}
+
+double ksModelCost() {
+  double inputDimension = GLWE_DIMENSION * POLYNOMIAL_SIZE;
+  double outputSize = LWE_SMALL_DIMENSION + 1;
+  double level = KS_LEVEL;
+  double countDecomposition = inputDimension * level;
+  double countMul = inputDimension * level * outputSize;
+  double countAdd = (inputDimension * level - 1) * outputSize + 1;
+  return countDecomposition + countMul + countAdd;
+}
+
+// Average duration of `iterations` runs of `op`, in nanoseconds. The
+// kernels only read the key material, so zeroed buffers time the same
+// instruction stream as real keys.
+template <typename Op> double measureNs(size_t iterations, Op op) {
+  // Warm the caches and the scratch before timing.
+  op();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+    op();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (double)iterations;
+}
+
+double measureBootstrapNs() {
+  size_t lweBigDimension = GLWE_DIMENSION * POLYNOMIAL_SIZE;
+
+  auto *fft =
+      (struct Fft *)aligned_alloc(CONCRETE_FFT_ALIGN, CONCRETE_FFT_SIZE);
+  concrete_cpu_construct_concrete_fft(fft, POLYNOMIAL_SIZE);
+
+  std::vector<double> fourierBsk(LWE_SMALL_DIMENSION * BR_LEVEL *
+                                 (GLWE_DIMENSION + 1) * (GLWE_DIMENSION + 1) *
+                                 POLYNOMIAL_SIZE);
+  std::vector<uint64_t> accumulator((GLWE_DIMENSION + 1) * POLYNOMIAL_SIZE);
+  std::vector<uint64_t> input(LWE_SMALL_DIMENSION + 1);
+  std::vector<uint64_t> output(lweBigDimension + 1);
+
+  size_t scratchSize;
+  size_t scratchAlign;
+  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratchSize, &scratchAlign, GLWE_DIMENSION, POLYNOMIAL_SIZE, fft);
+  auto *scratch = (uint8_t *)aligned_alloc(scratchAlign, scratchSize);
+
+  double ns = measureNs(PBS_ITERATIONS, [&]() {
+    concrete_cpu_bootstrap_lwe_ciphertext_u64(
+        output.data(), input.data(), accumulator.data(), fourierBsk.data(),
+        BR_LEVEL, BR_BASE_LOG, GLWE_DIMENSION, POLYNOMIAL_SIZE,
+        LWE_SMALL_DIMENSION, fft, scratch, scratchSize);
+  });
+
+  free(scratch);
+  concrete_cpu_destroy_concrete_fft(fft);
+  free(fft);
+  return ns;
+}
+
+double measureKeyswitchNs() {
+  size_t lweBigDimension = GLWE_DIMENSION * POLYNOMIAL_SIZE;
+
+  std::vector<uint64_t> ksk(lweBigDimension * KS_LEVEL *
+                            (LWE_SMALL_DIMENSION + 1));
+  std::vector<uint64_t> input(lweBigDimension + 1);
+  std::vector<uint64_t> output(LWE_SMALL_DIMENSION + 1);
+
+  return measureNs(KS_ITERATIONS, [&]() {
+    concrete_cpu_keyswitch_lwe_ciphertext_u64(
+        output.data(), input.data(), ksk.data(), KS_LEVEL, KS_BASE_LOG,
+        lweBigDimension, LWE_SMALL_DIMENSION);
+  });
+}
+
+const char *calibrationFilePath() {
+  return getenv("CONCRETE_OPTIMIZER_CALIBRATION_FILE");
+}
+
+bool loadWeights(CalibratedCostWeights &weights) {
+  const char *path = calibrationFilePath();
+  if (path == nullptr)
+    return false;
+  FILE *file = fopen(path, "r");
+  if (file == nullptr)
+    return false;
+  bool ok = fscanf(file, "%lf %lf", &weights.keyswitch, &weights.bootstrap) ==
+                2 &&
+            weights.keyswitch > 0.0 && weights.bootstrap > 0.0;
+  fclose(file);
+  return ok;
+}
+
+void storeWeights(CalibratedCostWeights weights) {
+  const char *path = calibrationFilePath();
+  if (path == nullptr)
+    return;
+  FILE *file = fopen(path, "w");
+  if (file == nullptr)
+    return;
+  fprintf(file, "%.17g %.17g\n", weights.keyswitch, weights.bootstrap);
+  fclose(file);
+}
+
+CalibratedCostWeights measureWeights() {
+  CalibratedCostWeights weights;
+  if (loadWeights(weights))
+    return weights;
+
+  double ksNs = measureKeyswitchNs();
+  double pbsNs = measureBootstrapNs();
+
+  // Normalize by the keyswitch weight so the keyswitch cost keeps the
+  // magnitude of its abstract operation count (and stays comparable to
+  // the unweighted levelled costs) while the bootstrap cost is scaled to
+  // the measured ratio.
+  double ksWeight = ksNs / ksModelCost();
+  double pbsWeight = pbsNs / pbsModelCost();
+  weights.keyswitch = 1.0;
+  weights.bootstrap = pbsWeight / ksWeight;
+
+  log_verbose() << "Optimizer cost calibration: keyswitch " << ksNs
+                << "ns, bootstrap " << pbsNs << "ns, bootstrap weight "
+                << weights.bootstrap << "\n";
+
+  storeWeights(weights);
+  return weights;
+}
+
+} // namespace
+
+bool useCostCalibration() {
+  char *env = getenv("CONCRETE_OPTIMIZER_CALIBRATE");
+  return env != nullptr && strtoul(env, NULL, 10) != 0;
+}
+
+CalibratedCostWeights getCalibratedCostWeights() {
+  static CalibratedCostWeights weights = measureWeights();
+  return weights;
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -7,10 +7,16 @@
 #include <llvm/ADT/ArrayRef.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/Support/TargetSelect.h>
 
 #include <mlir/Dialect/LLVMIR/LLVMDialect.h>
 #include <mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h>
+#include <mlir/Target/LLVMIR/Export.h>
 
 #include "concretelang/Common/BitsSize.h"
 #include "concretelang/Runtime/DFRuntime.hpp"
@@ -22,9 +28,84 @@
 namespace mlir {
 namespace concretelang {
 
+// Name of the wrapper function that provides the unified `void(void **)`
+// invocation interface of `funcName`.
+static std::string makeJITPackedFunctionName(llvm::StringRef funcName) {
+  return "_mlir_" + funcName.str();
+}
+
+// This function was copied from the MLIR Execution Engine, and provide an
+// elegant and generic invocation interface to the compiled circuit:
+// For each function in the LLVM module, define an interface function that
+// wraps all the arguments of the original function and all its results into
+// an i8** pointer to provide a unified invocation interface.
+static void packFunctionArguments(llvm::Module *module) {
+  auto &ctx = module->getContext();
+  llvm::IRBuilder<> builder(ctx);
+  llvm::DenseSet<llvm::Function *> interfaceFunctions;
+  for (auto &func : module->getFunctionList()) {
+    if (func.isDeclaration()) {
+      continue;
+    }
+    if (interfaceFunctions.count(&func)) {
+      continue;
+    }
+
+    // Given a function `foo(<...>)`, define the interface function
+    // `_mlir_foo(i8**)`.
+    auto *newType = llvm::FunctionType::get(
+        builder.getVoidTy(), builder.getInt8PtrTy()->getPointerTo(),
+        /*isVarArg=*/false);
+    auto newName = makeJITPackedFunctionName(func.getName());
+    auto funcCst = module->getOrInsertFunction(newName, newType);
+    llvm::Function *interfaceFunc =
+        llvm::cast<llvm::Function>(funcCst.getCallee());
+    interfaceFunctions.insert(interfaceFunc);
+
+    // Extract the arguments from the type-erased argument list and cast them
+    // to the proper types.
+    auto *bb = llvm::BasicBlock::Create(ctx);
+    bb->insertInto(interfaceFunc);
+    builder.SetInsertPoint(bb);
+    llvm::Value *argList = interfaceFunc->arg_begin();
+    llvm::SmallVector<llvm::Value *, 8> args;
+    args.reserve(llvm::size(func.args()));
+    for (auto &indexedArg : llvm::enumerate(func.args())) {
+      llvm::Value *argIndex = llvm::Constant::getIntegerValue(
+          builder.getInt64Ty(), llvm::APInt(64, indexedArg.index()));
+      llvm::Value *argPtrPtr =
+          builder.CreateGEP(builder.getInt8PtrTy(), argList, argIndex);
+      llvm::Value *argPtr =
+          builder.CreateLoad(builder.getInt8PtrTy(), argPtrPtr);
+      llvm::Type *argTy = indexedArg.value().getType();
+      argPtr = builder.CreateBitCast(argPtr, argTy->getPointerTo());
+      llvm::Value *arg = builder.CreateLoad(argTy, argPtr);
+      args.push_back(arg);
+    }
+
+    // Call the implementation function with the extracted arguments.
+    llvm::Value *result = builder.CreateCall(&func, args);
+
+    // Assuming the result is one value, potentially of type `void`.
+    if (!result->getType()->isVoidTy()) {
+      llvm::Value *retIndex = llvm::Constant::getIntegerValue(
+          builder.getInt64Ty(), llvm::APInt(64, llvm::size(func.args())));
+      llvm::Value *retPtrPtr =
+          builder.CreateGEP(builder.getInt8PtrTy(), argList, retIndex);
+      llvm::Value *retPtr =
+          builder.CreateLoad(builder.getInt8PtrTy(), retPtrPtr);
+      retPtr = builder.CreateBitCast(retPtr, result->getType()->getPointerTo());
+      builder.CreateStore(result, retPtr);
+    }
+
+    // The interface function returns void.
+    builder.CreateRetVoid();
+  }
+}
+
 llvm::Expected<std::unique_ptr<JITLambda>>
 JITLambda::create(llvm::StringRef name, mlir::ModuleOp &module,
-                  llvm::function_ref<llvm::Error(llvm::Module *)> optPipeline,
+                  std::function<llvm::Error(llvm::Module *)> optPipeline,
                   std::optional<std::string> runtimeLibPath) {
 
   // Looking for the function
@@ -42,38 +123,90 @@ JITLambda::create(llvm::StringRef name, mlir::ModuleOp &module,
 
   mlir::registerLLVMDialectTranslation(*module->getContext());
 
-  // Create an MLIR execution engine. The execution engine eagerly
-  // JIT-compiles the module. If runtimeLibPath is specified, it's passed as a
-  // shared library to the JIT compiler.
-  std::vector<llvm::StringRef> sharedLibPaths;
-  if (runtimeLibPath.has_value())
-    sharedLibPaths.push_back(runtimeLibPath.value());
-
-  mlir::ExecutionEngineOptions execOptions;
-  execOptions.transformer = optPipeline;
-  execOptions.sharedLibPaths = sharedLibPaths;
-  execOptions.jitCodeGenOptLevel = std::nullopt;
-  execOptions.llvmModuleBuilder = nullptr;
-
-  auto maybeEngine = mlir::ExecutionEngine::create(module, execOptions);
-  if (!maybeEngine) {
-    return StreamStringError("failed to construct the MLIR ExecutionEngine");
+  // Create an ORC lazy JIT. Unlike the eager MLIR execution engine, the
+  // functions of the module are only optimized and codegen'd when they are
+  // first called, so a multi-function module does not pay the compilation of
+  // the functions the entry point never reaches.
+  auto targetMachineBuilder = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!targetMachineBuilder) {
+    return targetMachineBuilder.takeError();
+  }
+
+  auto lazyJIT = llvm::orc::LLLazyJITBuilder()
+                     .setJITTargetMachineBuilder(*targetMachineBuilder)
+                     .create();
+  if (!lazyJIT) {
+    return lazyJIT.takeError();
+  }
+  auto &jit = *lazyJIT;
+
+  // Run the optimization pipeline on each module as it materializes, i.e.
+  // when one of its functions is first called.
+  jit->getIRTransformLayer().setTransform(
+      [optPipeline](llvm::orc::ThreadSafeModule threadSafeModule,
+                    const llvm::orc::MaterializationResponsibility &)
+          -> llvm::Expected<llvm::orc::ThreadSafeModule> {
+        llvm::Error error = threadSafeModule.withModuleDo(
+            [&](llvm::Module &module) { return optPipeline(&module); });
+        if (error) {
+          return std::move(error);
+        }
+        return std::move(threadSafeModule);
+      });
+
+  // Resolve the symbols of the process and, if specified, of the runtime
+  // shared library.
+  auto globalPrefix = jit->getDataLayout().getGlobalPrefix();
+  auto processSymbols =
+      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          globalPrefix);
+  if (!processSymbols) {
+    return processSymbols.takeError();
+  }
+  jit->getMainJITDylib().addGenerator(std::move(*processSymbols));
+  if (runtimeLibPath.has_value()) {
+    auto runtimeSymbols = llvm::orc::DynamicLibrarySearchGenerator::Load(
+        runtimeLibPath->c_str(), globalPrefix);
+    if (!runtimeSymbols) {
+      return runtimeSymbols.takeError();
+    }
+    jit->getMainJITDylib().addGenerator(std::move(*runtimeSymbols));
   }
-  auto &engine = maybeEngine.get();
+
+  // Translate the module to LLVM IR and add it for lazy compilation.
+  auto llvmContext = std::make_unique<llvm::LLVMContext>();
+  auto llvmModule = mlir::translateModuleToLLVMIR(module, *llvmContext);
+  if (!llvmModule) {
+    return StreamStringError("failed to translate the module to LLVM IR");
+  }
+  packFunctionArguments(llvmModule.get());
+  llvmModule->setDataLayout(jit->getDataLayout());
+  llvmModule->setTargetTriple(jit->getTargetTriple().str());
+  if (auto err = jit->addLazyIRModule(llvm::orc::ThreadSafeModule(
+          std::move(llvmModule), std::move(llvmContext)))) {
+    return std::move(err);
+  }
+
   auto lambda = std::make_unique<JITLambda>((*funcOp).getFunctionType(), name);
-  lambda->engine = std::move(engine);
+  lambda->jit = std::move(jit);
 
   return std::move(lambda);
 }
 
 llvm::Error JITLambda::invokeRaw(llvm::MutableArrayRef<void *> args) {
   auto found = std::find(args.begin(), args.end(), nullptr);
-  if (found == args.end()) {
-    return this->engine->invokePacked(this->name, args);
+  if (found != args.end()) {
+    int pos = found - args.begin();
+    return StreamStringError("invoke: argument at pos ")
+           << pos << " is null or missing";
+  }
+  auto address = this->jit->lookup(makeJITPackedFunctionName(this->name));
+  if (!address) {
+    return address.takeError();
   }
-  int pos = found - args.begin();
-  return StreamStringError("invoke: argument at pos ")
-         << pos << " is null or missing";
+  auto *fptr = address->toPtr<void (*)(void **)>();
+  (*fptr)(args.data());
+  return llvm::Error::success();
 }
 
 llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
@@ -4,8 +4,11 @@
 // for license information.
 
 #include <errno.h>
+#include <thread>
 
 #include "llvm/MC/SubtargetFeature.h"
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/MC/TargetRegistry.h>
@@ -13,6 +16,7 @@
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
 #include <mlir/Support/FileUtilities.h>
 
@@ -129,7 +133,11 @@ static void packFunctionArguments(llvm::Module *module) {
   }
 }
 
-llvm::Error emitObject(llvm::Module &module, string objectPath) {
+// Run final code generation on `module` and write the object file to
+// `objectPath`. The module is expected to be ready for codegen, i.e. the
+// invocation interface has already been generated.
+static llvm::Error emitObjectForModule(llvm::Module &module,
+                                       string objectPath) {
   auto targetMachine = getTargetMachineAndSetupModule(&module);
   if (!targetMachine) {
     return StreamStringError("No default target machine for object generation");
@@ -142,8 +150,6 @@ llvm::Error emitObject(llvm::Module &module, string objectPath) {
     return StreamStringError("Cannot create/open " + objectPath);
   }
 
-  packFunctionArguments(&module);
-
   // The legacy PassManager is mandatory for final code generation.
   // https://llvm.org/docs/NewPassManager.html#status-of-the-new-and-legacy-pass-managers
   llvm::legacy::PassManager pm;
@@ -161,6 +167,92 @@ llvm::Error emitObject(llvm::Module &module, string objectPath) {
   return llvm::Error::success();
 }
 
+llvm::Error emitObject(llvm::Module &module, string objectPath) {
+  packFunctionArguments(&module);
+  return emitObjectForModule(module, objectPath);
+}
+
+// Build the path of the i-th partition object file from the path of the
+// object file a single-threaded emission would have produced.
+static string partitionObjectPath(string objectPath, unsigned i) {
+  const string dotExt = ".o";
+  if (objectPath.size() > dotExt.size() &&
+      objectPath.compare(objectPath.size() - dotExt.size(), dotExt.size(),
+                         dotExt) == 0)
+    objectPath = objectPath.substr(0, objectPath.size() - dotExt.size());
+  return objectPath + "." + std::to_string(i) + dotExt;
+}
+
+llvm::Expected<vector<string>> emitObjects(llvm::Module &module,
+                                           string objectPath,
+                                           unsigned maxPartitions) {
+  packFunctionArguments(&module);
+
+  // Codegen time grows with the number of defined functions, splitting
+  // further than that only adds empty partitions.
+  unsigned numDefinedFuncs = 0;
+  for (auto &func : module.getFunctionList())
+    if (!func.isDeclaration())
+      numDefinedFuncs++;
+  unsigned numPartitions = std::min(maxPartitions, numDefinedFuncs);
+
+  if (numPartitions <= 1) {
+    if (auto error = emitObjectForModule(module, objectPath))
+      return std::move(error);
+    return vector<string>{objectPath};
+  }
+
+  // Setup the triple and data layout on the full module so that the
+  // partitions inherit them.
+  if (!getTargetMachineAndSetupModule(&module)) {
+    return StreamStringError("No default target machine for object generation");
+  }
+
+  // Partition the module. The clones share the LLVMContext of the original
+  // module, so they cannot be fed to codegen threads directly; round-trip
+  // each partition through bitcode and reparse it in a per-thread context
+  // instead.
+  vector<llvm::SmallString<0>> bitcodeBuffers(numPartitions);
+  unsigned partitionIndex = 0;
+  llvm::SplitModule(
+      module, numPartitions,
+      [&](std::unique_ptr<llvm::Module> partition) {
+        llvm::raw_svector_ostream os(bitcodeBuffers[partitionIndex++]);
+        llvm::WriteBitcodeToFile(*partition, os);
+      },
+      /*PreserveLocals=*/true);
+
+  vector<string> objectsPath(numPartitions);
+  vector<string> emitErrors(numPartitions);
+  vector<std::thread> threads;
+  for (unsigned i = 0; i < numPartitions; i++) {
+    objectsPath[i] = partitionObjectPath(objectPath, i);
+    threads.push_back(std::thread([&, i]() {
+      llvm::LLVMContext context;
+      llvm::MemoryBufferRef bitcode(
+          llvm::StringRef(bitcodeBuffers[i].data(), bitcodeBuffers[i].size()),
+          "partition");
+      auto partition = llvm::parseBitcodeFile(bitcode, context);
+      if (!partition) {
+        emitErrors[i] = llvm::toString(partition.takeError());
+        return;
+      }
+      if (auto error = emitObjectForModule(**partition, objectsPath[i]))
+        emitErrors[i] = llvm::toString(std::move(error));
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto &emitError : emitErrors) {
+    if (!emitError.empty()) {
+      return StreamStringError("Cannot emit object files in parallel: " +
+                               emitError);
+    }
+  }
+  return std::move(objectsPath);
+}
+
 string linkerCmd(vector<string> objectsPath, string libraryPath, string linker,
                  std::optional<vector<string>> extraArgs) {
   string cmd = linker + libraryPath;
@@ -0,0 +1,494 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <cstdlib>
+#include <string>
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "concretelang/Support/OptimizerSolutionCache.h"
+
+/// JSON (de)serialization of the concrete-optimizer solution types. The
+/// functions follow the toJSON / fromJSON conventions of llvm::json and
+/// are defined in the namespaces of the respective types, so that
+/// `llvm::json::parse<T>` finds them through argument-dependent lookup.
+
+static llvm::json::Value toJSON(const rust::String &s) {
+  return std::string(s.data(), s.size());
+}
+
+static bool fromJSON(const llvm::json::Value j, rust::String &s,
+                     llvm::json::Path p) {
+  std::string str;
+  if (!fromJSON(j, str, p))
+    return false;
+  s = rust::String(str);
+  return true;
+}
+
+static llvm::json::Value toJSON(uint64_t v) { return v; }
+
+/// Serializes a `rust::Vec` whose elements have a `toJSON` function or
+/// are directly convertible to a JSON value.
+template <typename T> static llvm::json::Value toJSON(const rust::Vec<T> &vec) {
+  llvm::json::Array array;
+  for (const T &element : vec) {
+    array.push_back(toJSON(element));
+  }
+  return std::move(array);
+}
+
+/// Deserializes a `rust::Vec` whose elements have a `fromJSON` function.
+template <typename T>
+static bool fromJSON(const llvm::json::Value j, rust::Vec<T> &vec,
+                     llvm::json::Path p) {
+  const llvm::json::Array *array = j.getAsArray();
+  if (array == nullptr) {
+    p.report("expected array");
+    return false;
+  }
+  vec = rust::Vec<T>();
+  size_t i = 0;
+  for (const llvm::json::Value &element : *array) {
+    T value{};
+    if (!fromJSON(element, value, p.index(i++)))
+      return false;
+    vec.push_back(std::move(value));
+  }
+  return true;
+}
+
+/// Deserializes the field `name` of the object `j` into `out`, handling
+/// types for which `llvm::json::ObjectMapper` cannot be used.
+template <typename T>
+static bool fieldFromJSON(const llvm::json::Value j, llvm::StringRef name,
+                          T &out, llvm::json::Path p) {
+  const llvm::json::Object *object = j.getAsObject();
+  if (object == nullptr) {
+    p.report("expected object");
+    return false;
+  }
+  const llvm::json::Value *value = object->get(name);
+  if (value == nullptr) {
+    p.field(name).report("missing field");
+    return false;
+  }
+  return fromJSON(*value, out, p.field(name));
+}
+
+namespace concrete_optimizer {
+namespace dag {
+
+static llvm::json::Value toJSON(const BrDecompositionParameters &params) {
+  return llvm::json::Object{
+      {"level", params.level},
+      {"log2_base", params.log2_base},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j,
+                     BrDecompositionParameters &params, llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("level", params.level) &&
+         O.map("log2_base", params.log2_base);
+}
+
+static llvm::json::Value toJSON(const KsDecompositionParameters &params) {
+  return llvm::json::Object{
+      {"level", params.level},
+      {"log2_base", params.log2_base},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j,
+                     KsDecompositionParameters &params, llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("level", params.level) &&
+         O.map("log2_base", params.log2_base);
+}
+
+static llvm::json::Value toJSON(const SecretLweKey &key) {
+  return llvm::json::Object{
+      {"identifier", key.identifier},
+      {"polynomial_size", key.polynomial_size},
+      {"glwe_dimension", key.glwe_dimension},
+      {"description", toJSON(key.description)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, SecretLweKey &key,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("identifier", key.identifier) &&
+         O.map("polynomial_size", key.polynomial_size) &&
+         O.map("glwe_dimension", key.glwe_dimension) &&
+         fieldFromJSON(j, "description", key.description, p);
+}
+
+static llvm::json::Value toJSON(const BootstrapKey &key) {
+  return llvm::json::Object{
+      {"identifier", key.identifier},
+      {"input_key", toJSON(key.input_key)},
+      {"output_key", toJSON(key.output_key)},
+      {"br_decomposition_parameter", toJSON(key.br_decomposition_parameter)},
+      {"description", toJSON(key.description)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, BootstrapKey &key,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("identifier", key.identifier) &&
+         fieldFromJSON(j, "input_key", key.input_key, p) &&
+         fieldFromJSON(j, "output_key", key.output_key, p) &&
+         fieldFromJSON(j, "br_decomposition_parameter",
+                       key.br_decomposition_parameter, p) &&
+         fieldFromJSON(j, "description", key.description, p);
+}
+
+static llvm::json::Value toJSON(const KeySwitchKey &key) {
+  return llvm::json::Object{
+      {"identifier", key.identifier},
+      {"input_key", toJSON(key.input_key)},
+      {"output_key", toJSON(key.output_key)},
+      {"ks_decomposition_parameter", toJSON(key.ks_decomposition_parameter)},
+      {"description", toJSON(key.description)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, KeySwitchKey &key,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("identifier", key.identifier) &&
+         fieldFromJSON(j, "input_key", key.input_key, p) &&
+         fieldFromJSON(j, "output_key", key.output_key, p) &&
+         fieldFromJSON(j, "ks_decomposition_parameter",
+                       key.ks_decomposition_parameter, p) &&
+         fieldFromJSON(j, "description", key.description, p);
+}
+
+static llvm::json::Value toJSON(const ConversionKeySwitchKey &key) {
+  return llvm::json::Object{
+      {"identifier", key.identifier},
+      {"input_key", toJSON(key.input_key)},
+      {"output_key", toJSON(key.output_key)},
+      {"ks_decomposition_parameter", toJSON(key.ks_decomposition_parameter)},
+      {"fast_keyswitch", key.fast_keyswitch},
+      {"description", toJSON(key.description)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, ConversionKeySwitchKey &key,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("identifier", key.identifier) &&
+         O.map("fast_keyswitch", key.fast_keyswitch) &&
+         fieldFromJSON(j, "input_key", key.input_key, p) &&
+         fieldFromJSON(j, "output_key", key.output_key, p) &&
+         fieldFromJSON(j, "ks_decomposition_parameter",
+                       key.ks_decomposition_parameter, p) &&
+         fieldFromJSON(j, "description", key.description, p);
+}
+
+static llvm::json::Value toJSON(const CircuitBoostrapKey &key) {
+  return llvm::json::Object{
+      {"identifier", key.identifier},
+      {"representation_key", toJSON(key.representation_key)},
+      {"br_decomposition_parameter", toJSON(key.br_decomposition_parameter)},
+      {"description", toJSON(key.description)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, CircuitBoostrapKey &key,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("identifier", key.identifier) &&
+         fieldFromJSON(j, "representation_key", key.representation_key, p) &&
+         fieldFromJSON(j, "br_decomposition_parameter",
+                       key.br_decomposition_parameter, p) &&
+         fieldFromJSON(j, "description", key.description, p);
+}
+
+} // namespace dag
+} // namespace concrete_optimizer
+
+static llvm::json::Value
+toJSON(const PrivateFunctionalPackingBoostrapKey &key) {
+  return llvm::json::Object{
+      {"identifier", key.identifier},
+      {"representation_key", toJSON(key.representation_key)},
+      {"br_decomposition_parameter", toJSON(key.br_decomposition_parameter)},
+      {"description", toJSON(key.description)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j,
+                     PrivateFunctionalPackingBoostrapKey &key,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("identifier", key.identifier) &&
+         fieldFromJSON(j, "representation_key", key.representation_key, p) &&
+         fieldFromJSON(j, "br_decomposition_parameter",
+                       key.br_decomposition_parameter, p) &&
+         fieldFromJSON(j, "description", key.description, p);
+}
+
+static llvm::json::Value toJSON(const CircuitKeys &keys) {
+  return llvm::json::Object{
+      {"secret_keys", toJSON(keys.secret_keys)},
+      {"keyswitch_keys", toJSON(keys.keyswitch_keys)},
+      {"bootstrap_keys", toJSON(keys.bootstrap_keys)},
+      {"conversion_keyswitch_keys", toJSON(keys.conversion_keyswitch_keys)},
+      {"circuit_bootstrap_keys", toJSON(keys.circuit_bootstrap_keys)},
+      {"private_functional_packing_keys",
+       toJSON(keys.private_functional_packing_keys)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, CircuitKeys &keys,
+                     llvm::json::Path p) {
+  return fieldFromJSON(j, "secret_keys", keys.secret_keys, p) &&
+         fieldFromJSON(j, "keyswitch_keys", keys.keyswitch_keys, p) &&
+         fieldFromJSON(j, "bootstrap_keys", keys.bootstrap_keys, p) &&
+         fieldFromJSON(j, "conversion_keyswitch_keys",
+                       keys.conversion_keyswitch_keys, p) &&
+         fieldFromJSON(j, "circuit_bootstrap_keys",
+                       keys.circuit_bootstrap_keys, p) &&
+         fieldFromJSON(j, "private_functional_packing_keys",
+                       keys.private_functional_packing_keys, p);
+}
+
+namespace concrete_optimizer {
+namespace dag {
+
+static llvm::json::Value toJSON(const InstructionKeys &keys) {
+  return llvm::json::Object{
+      {"input_key", keys.input_key},
+      {"tlu_keyswitch_key", keys.tlu_keyswitch_key},
+      {"tlu_bootstrap_key", keys.tlu_bootstrap_key},
+      {"tlu_circuit_bootstrap_key", keys.tlu_circuit_bootstrap_key},
+      {"tlu_private_functional_packing_key",
+       keys.tlu_private_functional_packing_key},
+      {"output_key", keys.output_key},
+      {"extra_conversion_keys", toJSON(keys.extra_conversion_keys)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, InstructionKeys &keys,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("input_key", keys.input_key) &&
+         O.map("tlu_keyswitch_key", keys.tlu_keyswitch_key) &&
+         O.map("tlu_bootstrap_key", keys.tlu_bootstrap_key) &&
+         O.map("tlu_circuit_bootstrap_key", keys.tlu_circuit_bootstrap_key) &&
+         O.map("tlu_private_functional_packing_key",
+               keys.tlu_private_functional_packing_key) &&
+         O.map("output_key", keys.output_key) &&
+         fieldFromJSON(j, "extra_conversion_keys", keys.extra_conversion_keys,
+                       p);
+}
+
+static llvm::json::Value toJSON(const DagSolution &sol) {
+  return llvm::json::Object{
+      {"input_lwe_dimension", sol.input_lwe_dimension},
+      {"internal_ks_output_lwe_dimension",
+       sol.internal_ks_output_lwe_dimension},
+      {"ks_decomposition_level_count", sol.ks_decomposition_level_count},
+      {"ks_decomposition_base_log", sol.ks_decomposition_base_log},
+      {"glwe_polynomial_size", sol.glwe_polynomial_size},
+      {"glwe_dimension", sol.glwe_dimension},
+      {"br_decomposition_level_count", sol.br_decomposition_level_count},
+      {"br_decomposition_base_log", sol.br_decomposition_base_log},
+      {"complexity", sol.complexity},
+      {"noise_max", sol.noise_max},
+      {"p_error", sol.p_error},
+      {"global_p_error", sol.global_p_error},
+      {"use_wop_pbs", sol.use_wop_pbs},
+      {"cb_decomposition_level_count", sol.cb_decomposition_level_count},
+      {"cb_decomposition_base_log", sol.cb_decomposition_base_log},
+      {"pp_decomposition_level_count", sol.pp_decomposition_level_count},
+      {"pp_decomposition_base_log", sol.pp_decomposition_base_log},
+      {"crt_decomposition", toJSON(sol.crt_decomposition)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, DagSolution &sol,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("input_lwe_dimension", sol.input_lwe_dimension) &&
+         O.map("internal_ks_output_lwe_dimension",
+               sol.internal_ks_output_lwe_dimension) &&
+         O.map("ks_decomposition_level_count",
+               sol.ks_decomposition_level_count) &&
+         O.map("ks_decomposition_base_log", sol.ks_decomposition_base_log) &&
+         O.map("glwe_polynomial_size", sol.glwe_polynomial_size) &&
+         O.map("glwe_dimension", sol.glwe_dimension) &&
+         O.map("br_decomposition_level_count",
+               sol.br_decomposition_level_count) &&
+         O.map("br_decomposition_base_log", sol.br_decomposition_base_log) &&
+         O.map("complexity", sol.complexity) &&
+         O.map("noise_max", sol.noise_max) && O.map("p_error", sol.p_error) &&
+         O.map("global_p_error", sol.global_p_error) &&
+         O.map("use_wop_pbs", sol.use_wop_pbs) &&
+         O.map("cb_decomposition_level_count",
+               sol.cb_decomposition_level_count) &&
+         O.map("cb_decomposition_base_log", sol.cb_decomposition_base_log) &&
+         O.map("pp_decomposition_level_count",
+               sol.pp_decomposition_level_count) &&
+         O.map("pp_decomposition_base_log", sol.pp_decomposition_base_log) &&
+         fieldFromJSON(j, "crt_decomposition", sol.crt_decomposition, p);
+}
+
+static llvm::json::Value toJSON(const CircuitSolution &sol) {
+  return llvm::json::Object{
+      {"circuit_keys", toJSON(sol.circuit_keys)},
+      {"instructions_keys", toJSON(sol.instructions_keys)},
+      {"crt_decomposition", toJSON(sol.crt_decomposition)},
+      {"complexity", sol.complexity},
+      {"p_error", sol.p_error},
+      {"global_p_error", sol.global_p_error},
+      {"is_feasible", sol.is_feasible},
+      {"error_msg", toJSON(sol.error_msg)},
+  };
+}
+
+static bool fromJSON(const llvm::json::Value j, CircuitSolution &sol,
+                     llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("complexity", sol.complexity) &&
+         O.map("p_error", sol.p_error) &&
+         O.map("global_p_error", sol.global_p_error) &&
+         O.map("is_feasible", sol.is_feasible) &&
+         fieldFromJSON(j, "circuit_keys", sol.circuit_keys, p) &&
+         fieldFromJSON(j, "instructions_keys", sol.instructions_keys, p) &&
+         fieldFromJSON(j, "crt_decomposition", sol.crt_decomposition, p) &&
+         fieldFromJSON(j, "error_msg", sol.error_msg, p);
+}
+
+} // namespace dag
+} // namespace concrete_optimizer
+
+namespace mlir {
+namespace concretelang {
+namespace optimizer {
+
+std::optional<std::string> solutionCacheDirectory() {
+  if (char *dir = std::getenv("CONCRETELANG_OPTIMIZER_CACHE_DIR")) {
+    if (*dir != '\0') {
+      return std::string(dir);
+    }
+  }
+  return std::nullopt;
+}
+
+std::string solutionCacheKey(llvm::StringRef dagDump,
+                             llvm::StringRef strategyTag,
+                             const Config &config) {
+  // Version tag of the on-disk format, to be bumped whenever the
+  // serialization or the meaning of the hashed inputs changes.
+  constexpr unsigned CACHE_FORMAT_VERSION = 1;
+
+  std::string searchInputs;
+  llvm::raw_string_ostream stream(searchInputs);
+  stream << CACHE_FORMAT_VERSION << '\0' << strategyTag << '\0'
+         << config.p_error << '\0' << config.global_p_error << '\0'
+         << config.security << '\0' << config.fallback_log_norm_woppbs << '\0'
+         << config.use_gpu_constraints << '\0' << (unsigned)config.encoding
+         << '\0' << config.ciphertext_modulus_log << '\0'
+         << config.fft_precision << '\0';
+  stream.flush();
+
+  llvm::MD5 hash;
+  hash.update(searchInputs);
+  hash.update(dagDump);
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return std::string(result.digest().str());
+}
+
+/// Returns the path of the cache entry for `key`, or std::nullopt if
+/// the cache is disabled.
+static std::optional<llvm::SmallString<128>>
+solutionCachePath(llvm::StringRef key) {
+  auto dir = solutionCacheDirectory();
+  if (!dir.has_value()) {
+    return std::nullopt;
+  }
+  llvm::SmallString<128> path(*dir);
+  llvm::sys::path::append(path, llvm::Twine(key) + ".json");
+  return path;
+}
+
+template <typename Solution>
+static std::optional<Solution> lookupCachedSolution(llvm::StringRef key) {
+  auto path = solutionCachePath(key);
+  if (!path.has_value()) {
+    return std::nullopt;
+  }
+  auto buffer = llvm::MemoryBuffer::getFile(*path);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  auto solution = llvm::json::parse<Solution>((*buffer)->getBuffer());
+  if (auto err = solution.takeError()) {
+    // A corrupted or outdated entry is treated as a miss; it is
+    // overwritten once the search has completed.
+    llvm::consumeError(std::move(err));
+    return std::nullopt;
+  }
+  return std::move(solution.get());
+}
+
+template <typename Solution>
+static void cacheSolutionImpl(llvm::StringRef key, const Solution &solution) {
+  auto path = solutionCachePath(key);
+  if (!path.has_value()) {
+    return;
+  }
+  if (llvm::sys::fs::create_directories(*solutionCacheDirectory())) {
+    return;
+  }
+  // Write to a unique temporary file and move it into place, so that
+  // concurrent compilations never observe a partially written entry.
+  llvm::SmallString<128> tmpPath;
+  int fd;
+  if (llvm::sys::fs::createUniqueFile(llvm::Twine(*path) + ".%%%%%%.tmp", fd,
+                                      tmpPath)) {
+    return;
+  }
+  {
+    llvm::raw_fd_ostream stream(fd, /*shouldClose=*/true);
+    stream << toJSON(solution);
+  }
+  if (llvm::sys::fs::rename(tmpPath, *path)) {
+    llvm::sys::fs::remove(tmpPath);
+  }
+}
+
+std::optional<DagSolution> lookupCachedDagSolution(llvm::StringRef key) {
+  return lookupCachedSolution<DagSolution>(key);
+}
+
+std::optional<CircuitSolution>
+lookupCachedCircuitSolution(llvm::StringRef key) {
+  return lookupCachedSolution<CircuitSolution>(key);
+}
+
+void cacheSolution(llvm::StringRef key, const DagSolution &solution) {
+  cacheSolutionImpl(key, solution);
+}
+
+void cacheSolution(llvm::StringRef key, const CircuitSolution &solution) {
+  cacheSolutionImpl(key, solution);
+}
+
+} // namespace optimizer
+} // namespace concretelang
+} // namespace mlir
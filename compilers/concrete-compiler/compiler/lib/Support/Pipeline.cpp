@@ -3,6 +3,13 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <chrono>
+#include <mutex>
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/Dominators.h>
 #include <llvm/Support/TargetSelect.h>
 
 #include <llvm/Support/Error.h>
@@ -14,12 +21,15 @@
 
 #include <mlir/Dialect/Affine/Passes.h>
 #include <mlir/Dialect/Arith/Transforms/Passes.h>
+#include <mlir/Dialect/Async/Passes.h>
 #include <mlir/Dialect/Bufferization/Transforms/OneShotAnalysis.h>
 #include <mlir/Dialect/Bufferization/Transforms/Passes.h>
 #include <mlir/Dialect/Linalg/Passes.h>
+#include <mlir/Dialect/MemRef/Transforms/Passes.h>
 #include <mlir/Dialect/SCF/Transforms/Passes.h>
 #include <mlir/Dialect/Tensor/Transforms/Passes.h>
 #include <mlir/ExecutionEngine/OptUtils.h>
+#include <mlir/Pass/PassInstrumentation.h>
 #include <mlir/Pass/PassManager.h>
 #include <mlir/Pass/PassOptions.h>
 #include <mlir/Support/LogicalResult.h>
@@ -38,7 +48,9 @@
 #include <concretelang/Dialect/FHE/Transforms/BigInt/BigInt.h>
 #include <concretelang/Dialect/FHE/Transforms/Boolean/Boolean.h>
 #include <concretelang/Dialect/FHE/Transforms/EncryptedMulToDoubleTLU.h>
+#include <concretelang/Dialect/FHE/Transforms/FHECSE/FHECSE.h>
 #include <concretelang/Dialect/FHE/Transforms/Max/Max.h>
+#include <concretelang/Dialect/FHE/Transforms/TLUFusion/TLUFusion.h>
 #include <concretelang/Dialect/FHELinalg/Transforms/Tiling.h>
 #include <concretelang/Dialect/RT/Analysis/Autopar.h>
 #include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
@@ -51,8 +63,60 @@ namespace mlir {
 namespace concretelang {
 namespace pipeline {
 
+/// Phase timings recorded on this thread since the last consumption.
+/// The phase functions run on the compiling thread (their passes may
+/// fan out to workers, but the pass manager is created and destroyed
+/// here), so a thread-local keeps concurrent compilations apart.
+static std::vector<PhaseTiming> &getPhaseTimings() {
+  thread_local std::vector<PhaseTiming> timings;
+  return timings;
+}
+
+std::vector<PhaseTiming> consumePhaseTimings() {
+  std::vector<PhaseTiming> timings;
+  std::swap(timings, getPhaseTimings());
+  return timings;
+}
+
+void recordPhaseTiming(PhaseTiming timing) {
+  getPhaseTimings().push_back(std::move(timing));
+}
+
+namespace {
+/// Measures the wall-clock time of the enclosing scope and records it
+/// under `name` when the scope exits.
+struct PhaseTimer {
+  PhaseTimer(llvm::StringRef name)
+      : name(name.str()), start(std::chrono::steady_clock::now()) {}
+
+  ~PhaseTimer() {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    getPhaseTimings().push_back({name, elapsed.count()});
+  }
+
+  std::string name;
+  std::chrono::steady_clock::time_point start;
+};
+
+/// Attaches a phase timer to a pass manager. The pass manager of a
+/// phase is created right before its passes run and destroyed right
+/// after, so the lifetime of an instrumentation attached to it
+/// brackets the whole phase.
+class PhaseTimingInstrumentation : public mlir::PassInstrumentation {
+public:
+  PhaseTimingInstrumentation(llvm::StringRef name) : timer(name) {}
+
+private:
+  PhaseTimer timer;
+};
+} // namespace
+
 static void pipelinePrinting(llvm::StringRef name, mlir::PassManager &pm,
                              mlir::MLIRContext &ctx) {
+  // The timing instrumentation is always on: it feeds the phase timings
+  // of the compilation feedback and costs two clock reads per phase.
+  pm.addInstrumentation(std::make_unique<PhaseTimingInstrumentation>(name));
   if (mlir::concretelang::isVerbose()) {
     mlir::concretelang::log_verbose()
         << "##################################################\n"
@@ -88,6 +152,9 @@ getFHEContextFromFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
                      std::function<bool(mlir::Pass *)> enablePass) {
   std::optional<size_t> oMax2norm;
   std::optional<size_t> oMaxWidth;
+  // The MaxMANP function pass runs in parallel over the functions of the
+  // module, updates of the module-wide maxima must be synchronized.
+  std::mutex oMaxMutex;
   optimizer::FunctionsDag dags;
 
   mlir::PassManager pm(&context);
@@ -100,6 +167,7 @@ getFHEContextFromFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
       pm,
       mlir::concretelang::createMaxMANPPass(
           [&](const uint64_t manp, unsigned width) {
+            std::lock_guard<std::mutex> lock(oMaxMutex);
             if (!oMax2norm.has_value() || oMax2norm.value() < manp)
               oMax2norm.emplace(manp);
 
@@ -214,16 +282,42 @@ mlir::LogicalResult
 transformFHEBoolean(mlir::MLIRContext &context, mlir::ModuleOp &module,
                     std::function<bool(mlir::Pass *)> enablePass) {
   mlir::PassManager pm(&context);
+  pipelinePrinting("FHEBooleanTransform", pm, context);
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createFHEBooleanTransformPass(), enablePass);
   return pm.run(module.getOperation());
 }
 
+mlir::LogicalResult
+fuseChainedTLU(mlir::MLIRContext &context, mlir::ModuleOp &module,
+               std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("FHETLUFusion", pm, context);
+  addPotentiallyNestedPass(pm, mlir::concretelang::createTLUFusionPass(),
+                           enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+deduplicateFHEOps(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                  std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("FHECSE", pm, context);
+  // FHE operations are pure, so generic CSE removes the duplicates an
+  // equivalent operation already dominates; the FHE-aware pass then
+  // merges the bootstrap-backed duplicates left in sibling branches.
+  addPotentiallyNestedPass(pm, mlir::createCSEPass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::concretelang::createFHECSEPass(),
+                           enablePass);
+  return pm.run(module.getOperation());
+}
+
 mlir::LogicalResult
 transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
                    unsigned int chunkSize, unsigned int chunkWidth) {
   mlir::PassManager pm(&context);
+  pipelinePrinting("FHEBigIntTransform", pm, context);
   addPotentiallyNestedPass(
       pm,
       mlir::concretelang::createFHEBigIntTransformPass(chunkSize, chunkWidth),
@@ -236,6 +330,22 @@ transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
   return pm.run(module.getOperation());
 }
 
+mlir::LogicalResult
+foldCleartextOperations(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                        std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("FoldCleartextOperations", pm, context);
+  // Pre-evaluate the cleartext computation (scaling factors, index
+  // math) before the FHE lowerings multiply it: constants propagated
+  // here neither inflate the IR the later pipeline stages walk nor
+  // survive into the compiled artifact's loops.
+  addPotentiallyNestedPass(pm, mlir::createCanonicalizerPass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::createSCCPPass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::createCSEPass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::createCanonicalizerPass(), enablePass);
+  return pm.run(module.getOperation());
+}
+
 mlir::LogicalResult
 lowerFHEToTFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
                std::optional<V0FHEContext> &fheContext,
@@ -306,6 +416,10 @@ mlir::LogicalResult batchTFHE(mlir::MLIRContext &context,
 
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createBatchingPass(maxBatchSize), enablePass);
+  // Cancel the relayouts the batching pass leaves between consecutive
+  // batched operations.
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createBatchingRelayoutCleanup(), enablePass);
 
   return pm.run(module.getOperation());
 }
@@ -330,6 +444,14 @@ lowerTFHEToConcrete(mlir::MLIRContext &context, mlir::ModuleOp &module,
 
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createConvertTFHEToConcretePass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::concretelang::createTLUDedupPass(),
+                           enablePass);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createStrengthReductionPass(), enablePass);
+  // Opt-in (CONCRETE_GLWE_PACKING): pack long-lived intermediate batches
+  // into GLWEs to shrink the resident ciphertext state.
+  addPotentiallyNestedPass(pm, mlir::concretelang::createGlwePackingPass(),
+                           enablePass);
 
   return pm.run(module.getOperation());
 }
@@ -393,10 +515,28 @@ lowerSDFGToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
   return pm.run(module.getOperation());
 }
 
+mlir::LogicalResult
+specializeStaticShapes(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                       std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("StaticShapeSpecialization", pm, context);
+  // Fold the shape queries and size arithmetic down to constants first,
+  // so the loop bounds below are static by the time the unroller reads
+  // them, then flatten the small fixed batch loops entirely.
+  addPotentiallyNestedPass(
+      pm, mlir::memref::createResolveShapedTypeResultDimsPass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::createCanonicalizerPass(), enablePass);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createUnrollSmallStaticLoops(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::createCanonicalizerPass(), enablePass);
+  addPotentiallyNestedPass(pm, mlir::createCSEPass(), enablePass);
+  return pm.run(module.getOperation());
+}
+
 mlir::LogicalResult
 lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
                       std::function<bool(mlir::Pass *)> enablePass,
-                      bool parallelizeLoops, bool gpu) {
+                      bool parallelizeLoops, bool asyncLoops, bool gpu) {
   mlir::PassManager pm(&context);
   pipelinePrinting("StdToLLVM", pm, context);
 
@@ -418,6 +558,12 @@ lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
 
   addPotentiallyNestedPass(pm, std::move(comprBuffPass), enablePass);
 
+  // The identity layouts forced on the Concrete operations above
+  // materialize copies around batch slices and concatenations; hand
+  // contiguous views to the batched operations directly.
+  addPotentiallyNestedPass(pm, mlir::concretelang::createBatchedCopyElision(),
+                           enablePass);
+
   // The bufferization may create `linalg.map` operations; Add another
   // conversion pass from linalg to loops
   addPotentiallyNestedPass(pm, mlir::createConvertLinalgToLoopsPass(),
@@ -433,9 +579,22 @@ lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
                              enablePass);
   }
 
-  if (parallelizeLoops)
-    addPotentiallyNestedPass(pm, mlir::createConvertSCFToOpenMPPass(),
-                             enablePass);
+  if (parallelizeLoops) {
+    if (asyncLoops) {
+      // Dispatch parallel loops over the MLIR async runtime's thread
+      // pool instead of OpenMP, so independent branches (e.g. PBS
+      // chains) overlap without carrying the HPX or OpenMP runtimes.
+      addPotentiallyNestedPass(pm, mlir::createAsyncParallelForPass(),
+                               enablePass);
+      addPotentiallyNestedPass(pm, mlir::createAsyncToAsyncRuntimePass(),
+                               enablePass);
+      addPotentiallyNestedPass(
+          pm, mlir::createAsyncRuntimePolicyBasedRefCountingPass(), enablePass);
+    } else {
+      addPotentiallyNestedPass(pm, mlir::createConvertSCFToOpenMPPass(),
+                               enablePass);
+    }
+  }
   // Lower affine
   addPotentiallyNestedPass(pm, mlir::createLowerAffinePass(), enablePass);
 
@@ -457,6 +616,12 @@ lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createConvertTracingToCAPIPass(), enablePass);
 
+  // Lower the async dialect to calls into the async runtime before the
+  // generic LLVM conversion, which does not handle async operations.
+  if (parallelizeLoops && asyncLoops)
+    addPotentiallyNestedPass(pm, mlir::createConvertAsyncToLLVMPass(),
+                             enablePass);
+
   // Convert to MLIR LLVM Dialect
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createConvertMLIRLowerableDialectsToLLVMPass(),
@@ -469,6 +634,8 @@ std::unique_ptr<llvm::Module>
 lowerLLVMDialectToLLVMIR(mlir::MLIRContext &context,
                          llvm::LLVMContext &llvmContext,
                          mlir::ModuleOp &module) {
+  // No pass manager here: time the translation directly.
+  PhaseTimer timer("LLVMDialectToLLVMIR");
   llvm::InitializeNativeTarget();
   llvm::InitializeNativeTargetAsmPrinter();
   mlir::registerLLVMDialectTranslation(*module->getContext());
@@ -477,8 +644,92 @@ lowerLLVMDialectToLLVMIR(mlir::MLIRContext &context,
   return mlir::translateModuleToLLVMIR(module, llvmContext);
 }
 
+namespace {
+// Attach unroll and vectorization hints as llvm.loop metadata on every
+// loop of the module. At this point the module only holds the lowered
+// circuit and its wrappers, so the loops are the levelled loops produced
+// by the linalg lowering; metadata is merged with any existing loop ID.
+void annotateLevelledLoops(llvm::Module &module, unsigned loopUnrollFactor,
+                           bool forceLoopVectorize) {
+  llvm::LLVMContext &ctx = module.getContext();
+  for (auto &f : module) {
+    if (f.isDeclaration())
+      continue;
+    llvm::DominatorTree dt(f);
+    llvm::LoopInfo li(dt);
+    for (auto *loop : li.getLoopsInPreorder()) {
+      llvm::SmallVector<llvm::Metadata *, 4> mds;
+      // Placeholder for the self-referencing loop ID operand
+      mds.push_back(nullptr);
+      if (llvm::MDNode *id = loop->getLoopID())
+        for (unsigned i = 1; i < id->getNumOperands(); ++i)
+          mds.push_back(id->getOperand(i));
+      if (forceLoopVectorize)
+        mds.push_back(llvm::MDNode::get(
+            ctx, {llvm::MDString::get(ctx, "llvm.loop.vectorize.enable"),
+                  llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(
+                      llvm::Type::getInt1Ty(ctx), 1))}));
+      if (loopUnrollFactor > 0)
+        mds.push_back(llvm::MDNode::get(
+            ctx, {llvm::MDString::get(ctx, "llvm.loop.unroll.count"),
+                  llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(
+                      llvm::Type::getInt32Ty(ctx), loopUnrollFactor))}));
+      llvm::MDNode *newId = llvm::MDNode::getDistinct(ctx, mds);
+      newId->replaceOperandWith(0, newId);
+      loop->setLoopID(newId);
+    }
+  }
+}
+
+// Diagnostic handler that enables the loop vectorizer's remarks and
+// prints them on stderr, reporting for each loop whether it vectorized
+// and, when it did not, why.
+struct VectorizerReportHandler : public llvm::DiagnosticHandler {
+  bool isAnyRemarkEnabled() const override { return true; }
+  bool isPassedOptRemarkEnabled(llvm::StringRef pass) const override {
+    return pass == "loop-vectorize";
+  }
+  bool isMissedOptRemarkEnabled(llvm::StringRef pass) const override {
+    return pass == "loop-vectorize";
+  }
+  bool isAnalysisRemarkEnabled(llvm::StringRef pass) const override {
+    return false;
+  }
+
+  bool handleDiagnostics(const llvm::DiagnosticInfo &di) override {
+    if (di.getKind() != llvm::DK_OptimizationRemark &&
+        di.getKind() != llvm::DK_OptimizationRemarkMissed)
+      return false;
+    auto &remark = llvm::cast<llvm::DiagnosticInfoOptimizationBase>(di);
+    if (llvm::StringRef(remark.getPassName()) != "loop-vectorize")
+      return true;
+    llvm::errs() << "loop-vectorize: "
+                 << (di.getKind() == llvm::DK_OptimizationRemark ? "passed"
+                                                                 : "missed")
+                 << " in " << remark.getFunction().getName();
+    if (remark.isLocationAvailable())
+      llvm::errs() << " at " << remark.getLocationStr();
+    llvm::errs() << ": " << remark.getMsg() << "\n";
+    return true;
+  }
+};
+} // namespace
+
 mlir::LogicalResult optimizeLLVMModule(llvm::LLVMContext &llvmContext,
-                                       llvm::Module &module) {
+                                       llvm::Module &module,
+                                       unsigned loopUnrollFactor,
+                                       bool forceLoopVectorize,
+                                       bool vectorizerReport) {
+  PhaseTimer timer("OptimizeLLVMIR");
+
+  if (loopUnrollFactor > 0 || forceLoopVectorize)
+    annotateLevelledLoops(module, loopUnrollFactor, forceLoopVectorize);
+  // The context belongs to this compilation, so the handler can stay in
+  // place after the pipeline ran.
+  if (vectorizerReport)
+    llvmContext.setDiagnosticHandler(
+        std::make_unique<VectorizerReportHandler>());
+
   std::function<llvm::Error(llvm::Module *)> optPipeline =
       mlir::makeOptimizingTransformer(3, 0, nullptr);
 
@@ -67,9 +67,14 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
   return OS;
 }
 
-TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
+static void
+gatherCircuitKeys(mlir::Operation *rootOp,
+                  SmallSet<TFHE::GLWESecretKey> &secretKeys,
+                  SmallSet<TFHE::GLWEBootstrapKeyAttr> &bootstrapKeys,
+                  SmallSet<TFHE::GLWEKeyswitchKeyAttr> &keyswitchKeys,
+                  SmallSet<TFHE::GLWEPackingKeyswitchKeyAttr>
+                      &packingKeyswitchKeys) {
   // Gathering circuit secret keys
-  SmallSet<TFHE::GLWESecretKey> secretKeys;
   auto tryInsert = [&](mlir::Type type) {
     if (auto glweType = type.dyn_cast<TFHE::GLWECipherTextType>()) {
       secretKeys.insert(glweType.getKey());
@@ -80,7 +85,7 @@ TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
       }
     }
   };
-  moduleOp->walk([&](mlir::Operation *op) {
+  rootOp->walk([&](mlir::Operation *op) {
     for (auto operand : op->getOperands()) {
       tryInsert(operand.getType());
     }
@@ -88,7 +93,7 @@ TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
       tryInsert(result.getType());
     }
   });
-  moduleOp->walk([&](mlir::func::FuncOp op) {
+  rootOp->walk([&](mlir::func::FuncOp op) {
     for (auto argType : op.getArgumentTypes()) {
       tryInsert(argType);
     }
@@ -98,24 +103,21 @@ TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
   });
 
   // Gathering circuit keyswitch keys
-  SmallSet<TFHE::GLWEKeyswitchKeyAttr> keyswitchKeys;
-  moduleOp->walk([&](TFHE::KeySwitchGLWEOp op) {
+  rootOp->walk([&](TFHE::KeySwitchGLWEOp op) {
     keyswitchKeys.insert(op.getKeyAttr());
     secretKeys.insert(op.getKeyAttr().getInputKey());
     secretKeys.insert(op.getKeyAttr().getOutputKey());
   });
 
   // Gathering circuit bootstrap keys
-  SmallSet<TFHE::GLWEBootstrapKeyAttr> bootstrapKeys;
-  moduleOp->walk([&](TFHE::BootstrapGLWEOp op) {
+  rootOp->walk([&](TFHE::BootstrapGLWEOp op) {
     bootstrapKeys.insert(op.getKeyAttr());
     secretKeys.insert(op.getKeyAttr().getInputKey());
     secretKeys.insert(op.getKeyAttr().getOutputKey());
   });
 
   // Gathering circuit packing keyswitch keys
-  SmallSet<TFHE::GLWEPackingKeyswitchKeyAttr> packingKeyswitchKeys;
-  moduleOp->walk([&](TFHE::WopPBSGLWEOp op) {
+  rootOp->walk([&](TFHE::WopPBSGLWEOp op) {
     keyswitchKeys.insert(op.getKskAttr());
     secretKeys.insert(op.getKskAttr().getInputKey());
     secretKeys.insert(op.getKskAttr().getOutputKey());
@@ -126,7 +128,29 @@ TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
     secretKeys.insert(op.getPkskAttr().getInputKey());
     secretKeys.insert(op.getPkskAttr().getOutputKey());
   });
+}
+
+TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
+  SmallSet<TFHE::GLWESecretKey> secretKeys;
+  SmallSet<TFHE::GLWEKeyswitchKeyAttr> keyswitchKeys;
+  SmallSet<TFHE::GLWEBootstrapKeyAttr> bootstrapKeys;
+  SmallSet<TFHE::GLWEPackingKeyswitchKeyAttr> packingKeyswitchKeys;
+  gatherCircuitKeys(moduleOp, secretKeys, bootstrapKeys, keyswitchKeys,
+                    packingKeyswitchKeys);
+  return TFHECircuitKeys{secretKeys.vector, bootstrapKeys.vector,
+                         keyswitchKeys.vector, packingKeyswitchKeys.vector};
+}
 
+TFHECircuitKeys
+extractCircuitKeys(llvm::ArrayRef<mlir::func::FuncOp> funcOps) {
+  SmallSet<TFHE::GLWESecretKey> secretKeys;
+  SmallSet<TFHE::GLWEKeyswitchKeyAttr> keyswitchKeys;
+  SmallSet<TFHE::GLWEBootstrapKeyAttr> bootstrapKeys;
+  SmallSet<TFHE::GLWEPackingKeyswitchKeyAttr> packingKeyswitchKeys;
+  for (auto funcOp : funcOps) {
+    gatherCircuitKeys(funcOp, secretKeys, bootstrapKeys, keyswitchKeys,
+                      packingKeyswitchKeys);
+  }
   return TFHECircuitKeys{secretKeys.vector, bootstrapKeys.vector,
                          keyswitchKeys.vector, packingKeyswitchKeys.vector};
 }
@@ -17,7 +17,9 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include "concrete-optimizer.hpp"
+#include "concretelang/Support/CostCalibration.h"
 #include "concretelang/Support/Error.h"
+#include "concretelang/Support/OptimizerSolutionCache.h"
 #include "concretelang/Support/V0Parameters.h"
 #include "concretelang/Support/logging.h"
 
@@ -25,6 +27,13 @@ namespace mlir {
 namespace concretelang {
 
 concrete_optimizer::Options options_from_config(optimizer::Config config) {
+  double ksCostWeight = config.ks_cost_weight;
+  double pbsCostWeight = config.pbs_cost_weight;
+  if (useCostCalibration()) {
+    auto weights = getCalibratedCostWeights();
+    ksCostWeight = weights.keyswitch;
+    pbsCostWeight = weights.bootstrap;
+  }
   concrete_optimizer::Options options = {
       /* .security_level = */ config.security,
       /* .maximum_acceptable_error_probability = */ config.p_error,
@@ -34,6 +43,9 @@ concrete_optimizer::Options options_from_config(optimizer::Config config) {
       /* .cache_on_disk = */ config.cache_on_disk,
       /* .ciphertext_modulus_log = */ config.ciphertext_modulus_log,
       /* .fft_precision = */ config.fft_precision,
+      /* .threads = */ config.threads,
+      /* .ks_cost_weight = */ ksCostWeight,
+      /* .pbs_cost_weight = */ pbsCostWeight,
   };
   return options;
 }
@@ -106,31 +118,63 @@ Solution getSolutionWithGlobalPError(optimizer::Config config,
   return sol;
 }
 
+/// Computes the persistent cache key of a search over `dag`, or an
+/// empty string if the persistent solution cache is disabled.
+static std::string solutionCacheKey(optimizer::Dag &dag,
+                                    llvm::StringRef strategyTag,
+                                    optimizer::Config config) {
+  if (!optimizer::solutionCacheDirectory().has_value()) {
+    return "";
+  }
+  // The dag dump is a canonical textual representation, so identical
+  // circuits hash to the same key across processes.
+  auto dagDump = dag->dump();
+  return optimizer::solutionCacheKey(
+      llvm::StringRef(dagDump.data(), dagDump.size()), strategyTag, config);
+}
+
 optimizer::DagSolution getDagMonoSolution(optimizer::Dag &dag,
                                           optimizer::Config config) {
+  auto cacheKey = solutionCacheKey(dag, "dag-mono", config);
+  if (!cacheKey.empty()) {
+    if (auto cached = optimizer::lookupCachedDagSolution(cacheKey)) {
+      return *cached;
+    }
+  }
   auto optimize =
       [&](concrete_optimizer::Options options) -> optimizer::DagSolution {
     return dag->optimize(options);
   };
-  if (!std::isnan(config.global_p_error)) {
-    return getSolutionWithGlobalPError<optimizer::DagSolution>(config,
-                                                               optimize);
+  auto sol = !std::isnan(config.global_p_error)
+                 ? getSolutionWithGlobalPError<optimizer::DagSolution>(
+                       config, optimize)
+                 : optimize(options_from_config(config));
+  if (!cacheKey.empty()) {
+    optimizer::cacheSolution(cacheKey, sol);
   }
-  return optimize(options_from_config(config));
+  return sol;
 }
 
 optimizer::CircuitSolution getDagMultiSolution(optimizer::Dag &dag,
                                                optimizer::Config config) {
-
+  auto cacheKey = solutionCacheKey(dag, "dag-multi", config);
+  if (!cacheKey.empty()) {
+    if (auto cached = optimizer::lookupCachedCircuitSolution(cacheKey)) {
+      return *cached;
+    }
+  }
   auto optimize =
       [&](concrete_optimizer::Options options) -> optimizer::CircuitSolution {
     return dag->optimize_multi(options);
   };
-  if (!std::isnan(config.global_p_error)) {
-    return getSolutionWithGlobalPError<optimizer::CircuitSolution>(config,
-                                                                   optimize);
+  auto sol = !std::isnan(config.global_p_error)
+                 ? getSolutionWithGlobalPError<optimizer::CircuitSolution>(
+                       config, optimize)
+                 : optimize(options_from_config(config));
+  if (!cacheKey.empty()) {
+    optimizer::cacheSolution(cacheKey, sol);
   }
-  return optimize(options_from_config(config));
+  return sol;
 }
 
 constexpr double WARN_ABOVE_GLOBAL_ERROR_RATE = 1.0 / 1000.0;
@@ -394,5 +438,62 @@ llvm::Expected<optimizer::Solution> getSolution(optimizer::Description &descr,
   //  }
 }
 
+llvm::Expected<optimizer::Solution>
+getAutotunedSolution(optimizer::Description &descr,
+                     CompilationFeedback &feedback,
+                     optimizer::Config config) {
+  // Programs without fhe computations have nothing to tune.
+  if (!descr.dag) {
+    return getSolution(descr, feedback, config);
+  }
+
+  const optimizer::Strategy candidates[] = {
+      optimizer::Strategy::V0,
+      optimizer::Strategy::DAG_MONO,
+      optimizer::Strategy::DAG_MULTI,
+  };
+
+  std::optional<optimizer::Solution> best;
+  CompilationFeedback bestFeedback;
+  optimizer::Strategy bestStrategy = optimizer::DEFAULT_STRATEGY;
+
+  for (auto candidate : candidates) {
+    auto candidateConfig = config;
+    candidateConfig.strategy = candidate;
+    CompilationFeedback candidateFeedback;
+    auto solution = getSolution(descr, candidateFeedback, candidateConfig);
+    if (auto err = solution.takeError()) {
+      // An infeasible candidate only matters if every candidate is: the
+      // tuner keeps going as long as one strategy yields a solution.
+      llvm::consumeError(std::move(err));
+      continue;
+    }
+    if (config.display) {
+      llvm::errs() << "--- Autotune candidate " << toString(candidate)
+                   << ": complexity " << candidateFeedback.complexity
+                   << ", global p-error " << candidateFeedback.globalPError
+                   << "\n";
+    }
+    if (!best.has_value() ||
+        candidateFeedback.complexity < bestFeedback.complexity) {
+      best = std::move(*solution);
+      bestFeedback = candidateFeedback;
+      bestStrategy = candidate;
+    }
+  }
+
+  if (!best.has_value()) {
+    // Rerun the configured strategy so its error (fallbacks included) is
+    // the one reported.
+    return getSolution(descr, feedback, config);
+  }
+
+  if (config.display) {
+    llvm::errs() << "--- Autotune winner: " << toString(bestStrategy) << "\n";
+  }
+  feedback = bestFeedback;
+  return std::move(*best);
+}
+
 } // namespace concretelang
 } // namespace mlir
@@ -0,0 +1,270 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/Transforms/Passes.h"
+
+#include "concretelang/Dialect/Concrete/IR/ConcreteDialect.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include <mlir/Transforms/GreedyPatternRewriteDriver.h>
+
+namespace Concrete = mlir::concretelang::Concrete;
+
+namespace {
+
+// Bufferization gives every buffer that flows into a Concrete operation
+// a static identity layout, so a circuit that slices a batch for
+// different lookup tables — or concatenates batched results back into a
+// larger tensor — materializes each slice as a subview plus a copy into
+// (or out of) a fresh identity buffer. The batched entry points read
+// their operands through full memref descriptors and therefore already
+// honor an offset into a larger allocation; the patterns below hand such
+// views to the batched ops directly and reserve real copies for
+// layout-incompatible views. Only contiguous views qualify: the CUDA
+// batched entry points upload the batch as one dense block and ignore
+// the stride part of the descriptor.
+
+/// Returns true when `subview` selects a contiguous block of a
+/// statically shaped, identity-layout buffer: unit strides, zero offsets
+/// and full extents in every dimension but the outermost. Such a view
+/// differs from its source only by the descriptor offset, which every
+/// batched entry point honors.
+bool isContiguousSubView(mlir::memref::SubViewOp subview) {
+  auto sourceType = subview.getSource().getType().cast<mlir::MemRefType>();
+  if (!sourceType.hasStaticShape() || !sourceType.getLayout().isIdentity())
+    return false;
+  // Rank-reducing views fold a dimension into the offset; keep the
+  // match simple and require matching ranks.
+  if (subview.getType().getRank() != sourceType.getRank())
+    return false;
+  for (int64_t dim = 0; dim < sourceType.getRank(); dim++) {
+    if (subview.isDynamicOffset(dim) || subview.isDynamicSize(dim) ||
+        subview.isDynamicStride(dim))
+      return false;
+    if (subview.getStaticStrides()[dim] != 1)
+      return false;
+    if (dim == 0)
+      continue;
+    if (subview.getStaticOffsets()[dim] != 0 ||
+        subview.getStaticSizes()[dim] != sourceType.getDimSize(dim))
+      return false;
+  }
+  return true;
+}
+
+/// Walks view chains back to the underlying buffer.
+mlir::Value viewRoot(mlir::Value value) {
+  while (auto view = mlir::dyn_cast_or_null<mlir::ViewLikeOpInterface>(
+             value.getDefiningOp()))
+    value = view.getViewSource();
+  return value;
+}
+
+/// Collects the non-view operations touching `root` through any chain of
+/// view operations.
+void collectAliasingUsers(mlir::Value root,
+                          llvm::SmallPtrSetImpl<mlir::Operation *> &users) {
+  for (mlir::Operation *user : root.getUsers()) {
+    if (auto view = mlir::dyn_cast<mlir::ViewLikeOpInterface>(user)) {
+      collectAliasingUsers(view->getResult(0), users);
+      continue;
+    }
+    users.insert(user);
+  }
+}
+
+/// Returns true when an operation aliasing the viewed buffer executes
+/// between `begin` and `end` (both exclusive), in which case eliding the
+/// copy would change what either side observes. Aliasing users outside
+/// the block of `begin` cannot be ordered and are treated as
+/// interfering.
+bool hasInterferingAliasingUser(
+    mlir::Value root, mlir::Operation *begin, mlir::Operation *end,
+    const llvm::SmallPtrSetImpl<mlir::Operation *> &exempt) {
+  llvm::SmallPtrSet<mlir::Operation *, 8> users;
+  collectAliasingUsers(root, users);
+  for (mlir::Operation *user : users) {
+    if (exempt.contains(user))
+      continue;
+    if (user->getBlock() != begin->getBlock())
+      return true;
+    if (begin->isBeforeInBlock(user) && user->isBeforeInBlock(end))
+      return true;
+  }
+  return false;
+}
+
+/// Erases `buffer`'s defining allocation once its only remaining users
+/// are deallocations.
+void eraseBufferIfOnlyDeallocated(mlir::Value buffer,
+                                  mlir::PatternRewriter &rewriter) {
+  auto alloc = buffer.getDefiningOp<mlir::memref::AllocOp>();
+  if (!alloc)
+    return;
+  if (!llvm::all_of(buffer.getUsers(), [](mlir::Operation *user) {
+        return mlir::isa<mlir::memref::DeallocOp>(user);
+      }))
+    return;
+  for (mlir::Operation *user :
+       llvm::make_early_inc_range(buffer.getUsers()))
+    rewriter.eraseOp(user);
+  rewriter.eraseOp(alloc);
+}
+
+/// Elides the copy materializing an extract slice: when a contiguous
+/// subview is copied into an identity buffer whose only other users are
+/// Concrete operations reading it (and a deallocation), the readers can
+/// take the subview itself.
+struct ForwardSubViewToBatchedReaders
+    : public mlir::OpRewritePattern<mlir::memref::CopyOp> {
+  using OpRewritePattern::OpRewritePattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::memref::CopyOp copy,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto subview = copy.getSource().getDefiningOp<mlir::memref::SubViewOp>();
+    if (!subview || !isContiguousSubView(subview))
+      return mlir::failure();
+    mlir::Value target = copy.getTarget();
+    if (!target.getDefiningOp<mlir::memref::AllocOp>())
+      return mlir::failure();
+
+    // Concrete operations write their first operand and read the others
+    // through full descriptors; anything else keeping the buffer alive
+    // (or writing it) disqualifies the forwarding.
+    llvm::SmallVector<mlir::OpOperand *> reads;
+    mlir::Operation *lastReader = copy;
+    for (mlir::OpOperand &use : target.getUses()) {
+      mlir::Operation *user = use.getOwner();
+      if (user == copy.getOperation() ||
+          mlir::isa<mlir::memref::DeallocOp>(user))
+        continue;
+      if (!mlir::isa<Concrete::ConcreteDialect>(user->getDialect()) ||
+          use.getOperandNumber() == 0)
+        return mlir::failure();
+      if (user->getBlock() != copy->getBlock() ||
+          !copy->isBeforeInBlock(user))
+        return mlir::failure();
+      reads.push_back(&use);
+      if (lastReader->isBeforeInBlock(user))
+        lastReader = user;
+    }
+    if (reads.empty())
+      return mlir::failure();
+
+    // The copy snapshots the slice; forwarding the view is only valid if
+    // nothing redefines the underlying buffer before the last read.
+    llvm::SmallPtrSet<mlir::Operation *, 8> exempt;
+    exempt.insert(copy);
+    for (mlir::OpOperand *use : reads)
+      exempt.insert(use->getOwner());
+    if (hasInterferingAliasingUser(viewRoot(subview.getSource()), copy,
+                                   lastReader, exempt))
+      return mlir::failure();
+
+    for (mlir::OpOperand *use : reads) {
+      mlir::Operation *user = use->getOwner();
+      rewriter.updateRootInPlace(user,
+                                 [&] { use->set(subview.getResult()); });
+    }
+    rewriter.eraseOp(copy);
+    eraseBufferIfOnlyDeallocated(target, rewriter);
+    return mlir::success();
+  }
+};
+
+/// Elides the copy materializing an insert slice (the concat direction):
+/// when a Concrete operation writes a scratch buffer whose only purpose
+/// is to be copied into a contiguous subview of a larger buffer, the
+/// operation can write the subview directly.
+struct WriteBatchedResultThroughSubView
+    : public mlir::OpRewritePattern<mlir::memref::CopyOp> {
+  using OpRewritePattern::OpRewritePattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::memref::CopyOp copy,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto subview = copy.getTarget().getDefiningOp<mlir::memref::SubViewOp>();
+    if (!subview || !isContiguousSubView(subview))
+      return mlir::failure();
+    mlir::Value source = copy.getSource();
+    if (!source.getDefiningOp<mlir::memref::AllocOp>())
+      return mlir::failure();
+
+    // The scratch buffer must be written by exactly one Concrete
+    // operation and read by nothing but the copy.
+    mlir::Operation *writer = nullptr;
+    for (mlir::OpOperand &use : source.getUses()) {
+      mlir::Operation *user = use.getOwner();
+      if (user == copy.getOperation() ||
+          mlir::isa<mlir::memref::DeallocOp>(user))
+        continue;
+      if (writer != nullptr ||
+          !mlir::isa<Concrete::ConcreteDialect>(user->getDialect()) ||
+          use.getOperandNumber() != 0)
+        return mlir::failure();
+      writer = user;
+    }
+    if (writer == nullptr || writer->getBlock() != copy->getBlock() ||
+        !writer->isBeforeInBlock(copy))
+      return mlir::failure();
+
+    // Writing the destination at the producer instead of at the copy
+    // must not be observable: nothing may touch the destination buffer
+    // in between, and the producer must not read it through another
+    // operand.
+    mlir::Value root = viewRoot(subview.getSource());
+    llvm::SmallPtrSet<mlir::Operation *, 8> exempt;
+    exempt.insert(copy);
+    if (hasInterferingAliasingUser(root, writer, copy, exempt))
+      return mlir::failure();
+    for (mlir::Value operand : writer->getOperands().drop_front())
+      if (operand.getType().isa<mlir::MemRefType>() &&
+          viewRoot(operand) == root)
+        return mlir::failure();
+
+    // The subview sits next to the copy; recreate it ahead of the
+    // producer. Its operands are all static, so only the source has to
+    // dominate the new position.
+    mlir::Operation *sourceDef = subview.getSource().getDefiningOp();
+    if (sourceDef != nullptr && (sourceDef->getBlock() != writer->getBlock() ||
+                                 !sourceDef->isBeforeInBlock(writer)))
+      return mlir::failure();
+    rewriter.setInsertionPoint(writer);
+    mlir::Value view = rewriter.clone(*subview)->getResult(0);
+    rewriter.updateRootInPlace(writer,
+                               [&] { writer->getOpOperand(0).set(view); });
+    rewriter.eraseOp(copy);
+    eraseBufferIfOnlyDeallocated(source, rewriter);
+    return mlir::success();
+  }
+};
+
+struct BatchedCopyElisionPass
+    : public BatchedCopyElisionBase<BatchedCopyElisionPass> {
+
+  void runOnOperation() override {
+    mlir::RewritePatternSet patterns(&getContext());
+    patterns.add<ForwardSubViewToBatchedReaders,
+                 WriteBatchedResultThroughSubView>(&getContext());
+
+    if (mlir::applyPatternsAndFoldGreedily(getOperation(),
+                                           std::move(patterns))
+            .failed()) {
+      this->signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createBatchedCopyElision() {
+  return std::make_unique<BatchedCopyElisionPass>();
+}
+} // namespace concretelang
+} // namespace mlir
@@ -3,8 +3,12 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <limits>
+#include <unistd.h>
+
 #include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/TypeSwitch.h>
 #include <mlir/Dialect/Affine/IR/AffineOps.h>
@@ -20,6 +24,10 @@
 #include <concretelang/Interfaces/BatchableInterface.h>
 #include <concretelang/Transforms/Passes.h>
 
+#ifdef CONCRETELANG_CUDA_SUPPORT
+#include <cuda_runtime.h>
+#endif
+
 namespace mlir {
 namespace concretelang {
 
@@ -1359,6 +1367,62 @@ operandsToValueSet(llvm::ArrayRef<mlir::OpOperand *> operands) {
   return set;
 }
 
+// Returns the memory budget in bytes available for the intermediate
+// operand and result buffers of a single batched operation. The
+// budget can be set explicitly through the environment variable
+// `CONCRETELANG_BATCHING_MEMORY_BUDGET`; otherwise it defaults to a
+// quarter of the memory of the first GPU for builds with CUDA support
+// and to the size of the last-level cache for CPU builds, so that the
+// buffers of a batch neither exhaust device memory nor evict the
+// entire cache.
+static int64_t getBatchMemoryBudget() {
+  static int64_t budget = []() -> int64_t {
+    if (char *env = getenv("CONCRETELANG_BATCHING_MEMORY_BUDGET")) {
+      int64_t envBudget = atoll(env);
+
+      if (envBudget > 0)
+        return envBudget;
+    }
+
+#ifdef CONCRETELANG_CUDA_SUPPORT
+    size_t freeMem;
+    size_t totalMem;
+
+    if (cudaMemGetInfo(&freeMem, &totalMem) == cudaSuccess)
+      return (int64_t)totalMem / 4;
+
+    return (int64_t)1 << 32;
+#else
+    long llcSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+    if (llcSize > 0)
+      return llcSize;
+
+    return (int64_t)32 << 20;
+#endif
+  }();
+
+  return budget;
+}
+
+// Returns the maximum number of elements of a batch for the batchable
+// operation `op` under the batching variant `variant`, i.e., the
+// smaller of `maxBatchSize` and the number of batched elements whose
+// operand and result buffers fit into the target memory budget.
+static int64_t getEffectiveMaxBatchSize(BatchableOpInterface op,
+                                        unsigned variant,
+                                        int64_t maxBatchSize) {
+  int64_t elementSize = op.getBatchedElementByteSize(variant);
+
+  if (elementSize <= 0)
+    return maxBatchSize;
+
+  int64_t memMaxBatchSize =
+      std::max(getBatchMemoryBudget() / elementSize, (int64_t)1);
+
+  return std::min(maxBatchSize, memMaxBatchSize);
+}
+
 /// Pattern that replaces a batchable operation embedded into a static
 /// loop nest with the batched version of the operation, e.g.,
 ///
@@ -1462,6 +1526,9 @@ public:
         splitOperands(scalarOp, candidateVariant, candidateBatchableOperands,
                       candidateNonBatchableOperands);
 
+        int64_t effectiveMaxBatchSize =
+            getEffectiveMaxBatchSize(scalarOp, candidateVariant, maxBatchSize);
+
         // Construct initial frontiers from the values used directly
         // by the batchable operation
         llvm::DenseSet<mlir::Value> frontierBatched =
@@ -1515,7 +1582,7 @@ public:
 
           int64_t thisTripCount = getStaticTripCount(forOp);
 
-          if (maxBatchSize / candidateBatchSize < thisTripCount)
+          if (effectiveMaxBatchSize / candidateBatchSize < thisTripCount)
             break;
           else
             candidateBatchSize *= thisTripCount;
@@ -1791,6 +1858,449 @@ private:
   int64_t maxBatchSize;
 };
 
+/// Pattern that merges compatible batchable operations from
+/// straight-line code into a single batched operation. E.g.,
+///
+///   %res0 = batchable_op %s0, %k
+///   %res1 = batchable_op %s1, %k
+///   %res2 = batchable_op %s2, %k
+///
+/// is replaced with:
+///
+///   %batch = ... tensor with %s0, %s1 and %s2 as its elements ...
+///   %resT = batchedOp %batch, %k
+///   %res0 = tensor.extract %resT[%c0]
+///   %res1 = tensor.extract %resT[%c1]
+///   %res2 = tensor.extract %resT[%c2]
+///
+/// Two operations are considered compatible if they are instances of
+/// the same operation with the same attributes, if all of their
+/// non-batchable operands reference the same values and if their
+/// batchable operands have identical types. Only operations from the
+/// same block are merged, so that no operation is executed
+/// speculatively, and operations embedded into a static loop are left
+/// to `BatchingPattern`, which batches entire iteration spaces at
+/// once.
+class SiblingBatchingPattern
+    : public mlir::OpRewritePattern<mlir::func::FuncOp> {
+public:
+  SiblingBatchingPattern(
+      mlir::MLIRContext *context,
+      int64_t maxBatchSize = std::numeric_limits<int64_t>::max())
+      : mlir::OpRewritePattern<mlir::func::FuncOp>(context),
+        maxBatchSize(maxBatchSize) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::func::FuncOp func,
+                  mlir::PatternRewriter &rewriter) const override {
+    // Compatible batchable operations to be replaced by a single
+    // batched operation, in block order
+    llvm::SmallVector<BatchableOpInterface> group;
+
+    // Selected batching variant of the batchable operations
+    unsigned variant = 0;
+
+    // Sequences of batchable and non-batchable operands of the first
+    // operation of the group
+    llvm::SmallVector<mlir::OpOperand *> batchableOperands;
+    llvm::SmallVector<mlir::OpOperand *> nonBatchableOperands;
+
+    func.walk([&](BatchableOpInterface firstOp) {
+      // Operations within a static loop are batched across the
+      // entire iteration space by `BatchingPattern`
+      mlir::scf::ForOp parentFor =
+          llvm::dyn_cast_or_null<mlir::scf::ForOp>(firstOp->getParentOp());
+
+      if (parentFor && isStaticLoop(parentFor))
+        return mlir::WalkResult::skip();
+
+      if (firstOp->getNumResults() != 1)
+        return mlir::WalkResult::skip();
+
+      // Predicate checking that `v` is available at the position of
+      // the first operation of the group, before which the batched
+      // operation is created
+      auto dominatesFirstOp = [&](mlir::Value v) {
+        mlir::Operation *definingOp = v.getDefiningOp();
+
+        return !definingOp || definingOp->getBlock() != firstOp->getBlock() ||
+               definingOp->isBeforeInBlock(firstOp);
+      };
+
+      // Try all batching variants of the batchable operation in
+      // sequence until a variant yields a group with at least two
+      // operations
+      for (unsigned candidateVariant = 0;
+           candidateVariant < firstOp.getNumBatchingVariants();
+           candidateVariant++) {
+        llvm::SmallVector<mlir::OpOperand *> firstBatchableOperands;
+        llvm::SmallVector<mlir::OpOperand *> firstNonBatchableOperands;
+
+        splitOperands(firstOp, candidateVariant, firstBatchableOperands,
+                      firstNonBatchableOperands);
+
+        int64_t effectiveMaxBatchSize =
+            getEffectiveMaxBatchSize(firstOp, candidateVariant, maxBatchSize);
+
+        llvm::SmallVector<BatchableOpInterface> candidateGroup{firstOp};
+
+        // Scan the remainder of the block for operations that can be
+        // merged with the first operation
+        for (mlir::Operation &laterOp :
+             llvm::make_range(std::next(firstOp->getIterator()),
+                              firstOp->getBlock()->end())) {
+          if ((int64_t)candidateGroup.size() >= effectiveMaxBatchSize)
+            break;
+
+          BatchableOpInterface laterBatchableOp =
+              llvm::dyn_cast<BatchableOpInterface>(&laterOp);
+
+          if (!laterBatchableOp || laterOp.getName() != firstOp->getName() ||
+              laterOp.getAttrDictionary() != firstOp->getAttrDictionary() ||
+              laterOp.getNumResults() != 1 ||
+              laterOp.getResult(0).getType() !=
+                  firstOp->getResult(0).getType())
+            continue;
+
+          llvm::SmallVector<mlir::OpOperand *> laterBatchableOperands;
+          llvm::SmallVector<mlir::OpOperand *> laterNonBatchableOperands;
+
+          splitOperands(laterBatchableOp, candidateVariant,
+                        laterBatchableOperands, laterNonBatchableOperands);
+
+          // Non-batchable operands must reference the very same
+          // values, so that the batched operation can simply reuse
+          // them
+          bool sameNonBatchableOperands =
+              laterNonBatchableOperands.size() ==
+                  firstNonBatchableOperands.size() &&
+              llvm::all_of(
+                  llvm::zip(firstNonBatchableOperands,
+                            laterNonBatchableOperands),
+                  [](auto it) {
+                    return std::get<0>(it)->get() == std::get<1>(it)->get();
+                  });
+
+          // Batchable operands must have identical types, so that
+          // they can be collected into a single tensor
+          bool sameBatchableOperandTypes =
+              laterBatchableOperands.size() == firstBatchableOperands.size() &&
+              llvm::all_of(
+                  llvm::zip(firstBatchableOperands, laterBatchableOperands),
+                  [](auto it) {
+                    return std::get<0>(it)->get().getType() ==
+                           std::get<1>(it)->get().getType();
+                  });
+
+          if (!sameNonBatchableOperands || !sameBatchableOperandTypes)
+            continue;
+
+          // All operands of the later operation must be available at
+          // the position of the first operation; this also guarantees
+          // that the operations of the group are independent of each
+          // other
+          if (!llvm::all_of(laterOp.getOperands(), dominatesFirstOp))
+            continue;
+
+          candidateGroup.push_back(laterBatchableOp);
+        }
+
+        // Merging a group with a single operation would just add
+        // overhead for the collection of the operands
+        if (candidateGroup.size() < 2)
+          continue;
+
+        group = std::move(candidateGroup);
+        variant = candidateVariant;
+        batchableOperands = std::move(firstBatchableOperands);
+        nonBatchableOperands = std::move(firstNonBatchableOperands);
+
+        return mlir::WalkResult::interrupt();
+      }
+
+      return mlir::WalkResult::skip();
+    });
+
+    // if no group of compatible batchable operations was found, bail
+    // out
+    if (group.size() < 2)
+      return mlir::failure();
+
+    BatchableOpInterface firstOp = group[0];
+    int64_t batchSize = group.size();
+
+    rewriter.setInsertionPoint(firstOp);
+    mlir::ImplicitLocOpBuilder ilob(firstOp.getLoc(), rewriter);
+
+    // Collect the batchable operands of all operations of the group
+    // into one tensor per batchable operand position
+    llvm::SmallVector<mlir::Value> batchedOperands;
+
+    for (mlir::OpOperand *batchableOperand : batchableOperands) {
+      unsigned operandNumber = batchableOperand->getOperandNumber();
+      mlir::Type nonBatchedType = batchableOperand->get().getType();
+
+      llvm::SmallVector<int64_t> batchedShape{batchSize};
+      mlir::Type batchedElementType;
+
+      if (mlir::RankedTensorType nonBatchedTensorType =
+              nonBatchedType.dyn_cast<mlir::RankedTensorType>()) {
+        batchedShape.append(nonBatchedTensorType.getShape().begin(),
+                            nonBatchedTensorType.getShape().end());
+        batchedElementType = nonBatchedTensorType.getElementType();
+      } else {
+        batchedElementType = nonBatchedType;
+      }
+
+      mlir::Value batchedOperand =
+          ilob.create<mlir::bufferization::AllocTensorOp>(
+              mlir::RankedTensorType::get(batchedShape, batchedElementType),
+              mlir::ValueRange{});
+
+      for (auto memberIt : llvm::enumerate(group)) {
+        mlir::Value element = memberIt.value()->getOperand(operandNumber);
+
+        if (mlir::RankedTensorType elementType =
+                nonBatchedType.dyn_cast<mlir::RankedTensorType>()) {
+          llvm::SmallVector<mlir::OpFoldResult> offsets{
+              ilob.getI64IntegerAttr(memberIt.index())};
+          llvm::SmallVector<mlir::OpFoldResult> sizes{
+              ilob.getI64IntegerAttr(1)};
+          llvm::SmallVector<mlir::OpFoldResult> strides{
+              ilob.getI64IntegerAttr(1)};
+
+          for (int64_t dim : elementType.getShape()) {
+            offsets.push_back(ilob.getI64IntegerAttr(0));
+            sizes.push_back(ilob.getI64IntegerAttr(dim));
+            strides.push_back(ilob.getI64IntegerAttr(1));
+          }
+
+          batchedOperand = ilob.create<mlir::tensor::InsertSliceOp>(
+              element, batchedOperand, offsets, sizes, strides);
+        } else {
+          mlir::Value idx =
+              ilob.create<mlir::arith::ConstantIndexOp>(memberIt.index());
+          batchedOperand = ilob.create<mlir::tensor::InsertOp>(
+              element, batchedOperand, idx);
+        }
+      }
+
+      batchedOperands.push_back(batchedOperand);
+    }
+
+    // Non-batchable operands are shared by all operations of the
+    // group and already dominate the insertion point
+    llvm::SmallVector<mlir::Value> nonBatchableValues =
+        map(nonBatchableOperands,
+            [](mlir::OpOperand *operand) { return operand->get(); });
+
+    // Created the actual batched operation through the op interface
+    mlir::Value batchedResult = firstOp.createBatchedOperation(
+        variant, ilob, batchedOperands, nonBatchableValues);
+
+    mlir::RankedTensorType batchedResultType =
+        llvm::dyn_cast<mlir::RankedTensorType>(batchedResult.getType());
+
+    assert(batchedResultType);
+
+    // Replace each operation of the group with an operation that
+    // extracts the respective result from the batch of results
+    // produced by the batched operation
+    for (auto memberIt : llvm::enumerate(group)) {
+      BatchableOpInterface member = memberIt.value();
+
+      rewriter.setInsertionPoint(member);
+      mlir::ImplicitLocOpBuilder memberIlob(member.getLoc(), rewriter);
+
+      if (batchedResultType.getShape().size() == 1) {
+        mlir::Value idx =
+            memberIlob.create<mlir::arith::ConstantIndexOp>(memberIt.index());
+        rewriter.replaceOpWithNewOp<mlir::tensor::ExtractOp>(
+            member, batchedResult, idx);
+      } else {
+        llvm::SmallVector<mlir::OpFoldResult> offsets{
+            memberIlob.getI64IntegerAttr(memberIt.index())};
+        llvm::SmallVector<mlir::OpFoldResult> sizes{
+            memberIlob.getI64IntegerAttr(1)};
+        llvm::SmallVector<mlir::OpFoldResult> strides{
+            memberIlob.getI64IntegerAttr(1)};
+
+        for (int64_t dim : batchedResultType.getShape().drop_front()) {
+          offsets.push_back(memberIlob.getI64IntegerAttr(0));
+          sizes.push_back(memberIlob.getI64IntegerAttr(dim));
+          strides.push_back(memberIlob.getI64IntegerAttr(1));
+        }
+
+        rewriter.replaceOpWithNewOp<mlir::tensor::ExtractSliceOp>(
+            member,
+            member->getResult(0).getType().cast<mlir::RankedTensorType>(),
+            batchedResult, offsets, sizes, strides);
+      }
+    }
+
+    return mlir::success();
+  }
+
+private:
+  int64_t maxBatchSize;
+};
+
+// Returns the largest divisor of `n` that is less than or equal to
+// `bound`, or 1 if there is no such divisor greater than 1.
+static int64_t largestDivisorUpTo(int64_t n, int64_t bound) {
+  for (int64_t d = std::min(bound, n - 1); d >= 2; d--) {
+    if (n % d == 0)
+      return d;
+  }
+
+  return 1;
+}
+
+/// Pattern that splits a static loop whose trip count exceeds the
+/// effective batch size limit of a batchable operation in its body
+/// into a pair of perfectly nested loops, so that `BatchingPattern`
+/// can subsequently batch the body of the inner loop in chunks that
+/// respect the limit. E.g., with a limit of 4:
+///
+///   scf.for %i = c0 to %c16 step %c1 {
+///     ... batchable_op ... %i ...
+///   }
+///
+/// is replaced with:
+///
+///   scf.for %t = c0 to %c4 step %c1 {
+///     scf.for %j = c0 to %c4 step %c1 {
+///       %i = ... %t * 4 + %j ...
+///       ... batchable_op ... %i ...
+///     }
+///   }
+///
+/// The trip count of the inner loop is the largest divisor of the
+/// original trip count that does not exceed the limit; loops with a
+/// prime trip count are left untouched.
+class BatchingLoopTilingPattern
+    : public mlir::OpRewritePattern<mlir::func::FuncOp> {
+public:
+  BatchingLoopTilingPattern(
+      mlir::MLIRContext *context,
+      int64_t maxBatchSize = std::numeric_limits<int64_t>::max())
+      : mlir::OpRewritePattern<mlir::func::FuncOp>(context),
+        maxBatchSize(maxBatchSize) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::func::FuncOp func,
+                  mlir::PatternRewriter &rewriter) const override {
+    // Loop to be split into a pair of nested loops
+    mlir::scf::ForOp target;
+
+    // Trip count of the inner loop after splitting
+    int64_t tileSize = 0;
+
+    func.walk([&](BatchableOpInterface scalarOp) {
+      mlir::scf::ForOp forOp =
+          llvm::dyn_cast_or_null<mlir::scf::ForOp>(scalarOp->getParentOp());
+
+      if (!forOp || !isStaticLoop(forOp))
+        return mlir::WalkResult::skip();
+
+      int64_t tripCount = getStaticTripCount(forOp);
+
+      // Use the most permissive limit over all batching variants, so
+      // that splitting never precludes a variant with a larger limit
+      int64_t limit = 0;
+      for (unsigned variant = 0; variant < scalarOp.getNumBatchingVariants();
+           variant++) {
+        limit = std::max(
+            limit, getEffectiveMaxBatchSize(scalarOp, variant, maxBatchSize));
+      }
+
+      if (limit <= 1 || tripCount <= limit)
+        return mlir::WalkResult::skip();
+
+      int64_t candidateTileSize = largestDivisorUpTo(tripCount, limit);
+
+      if (candidateTileSize < 2)
+        return mlir::WalkResult::skip();
+
+      target = forOp;
+      tileSize = candidateTileSize;
+
+      return mlir::WalkResult::interrupt();
+    });
+
+    if (!target)
+      return mlir::failure();
+
+    int64_t outerTripCount = getStaticTripCount(target) / tileSize;
+
+    rewriter.setInsertionPoint(target);
+    mlir::ImplicitLocOpBuilder ilob(target.getLoc(), rewriter);
+
+    mlir::Value c0 = ilob.create<mlir::arith::ConstantIndexOp>(0);
+    mlir::Value c1 = ilob.create<mlir::arith::ConstantIndexOp>(1);
+    mlir::Value cOuterTripCount =
+        ilob.create<mlir::arith::ConstantIndexOp>(outerTripCount);
+    mlir::Value cTileSize = ilob.create<mlir::arith::ConstantIndexOp>(tileSize);
+
+    mlir::scf::ForOp outerFor = ilob.create<mlir::scf::ForOp>(
+        c0, cOuterTripCount, c1, target.getInitArgs());
+
+    ilob.setInsertionPointToStart(outerFor.getBody());
+
+    mlir::scf::ForOp innerFor = ilob.create<mlir::scf::ForOp>(
+        c0, cTileSize, c1,
+        llvm::to_vector_of<mlir::Value>(outerFor.getRegionIterArgs()));
+
+    ilob.setInsertionPointToStart(innerFor.getBody());
+
+    // Reconstruct the original induction variable from the tile index
+    // and the position within the tile; the multiplications and
+    // additions fold away for normalized loops
+    mlir::Value tileBase = ilob.create<mlir::arith::MulIOp>(
+        outerFor.getInductionVar(), cTileSize);
+    mlir::Value normalizedIV =
+        ilob.create<mlir::arith::AddIOp>(tileBase, innerFor.getInductionVar());
+    mlir::Value scaledIV =
+        ilob.create<mlir::arith::MulIOp>(normalizedIV, target.getStep());
+    mlir::Value origIV =
+        ilob.create<mlir::arith::AddIOp>(target.getLowerBound(), scaledIV);
+
+    // Clone the loop body with the reconstructed induction variable
+    mlir::IRMapping mapping;
+    mapping.map(target.getInductionVar(), origIV);
+
+    for (auto it :
+         llvm::zip(target.getRegionIterArgs(), innerFor.getRegionIterArgs()))
+      mapping.map(std::get<0>(it), std::get<1>(it));
+
+    for (mlir::Operation &op : target.getBody()->without_terminator())
+      ilob.clone(op, mapping);
+
+    if (target.getNumRegionIterArgs() > 0) {
+      mlir::scf::YieldOp origYield =
+          llvm::cast<mlir::scf::YieldOp>(target.getBody()->getTerminator());
+
+      llvm::SmallVector<mlir::Value> innerYields =
+          map(origYield.getOperands(), [&](mlir::Value v) {
+            return mapping.lookupOrDefault(v);
+          });
+
+      ilob.create<mlir::scf::YieldOp>(innerYields);
+
+      ilob.setInsertionPointToEnd(outerFor.getBody());
+      ilob.create<mlir::scf::YieldOp>(
+          llvm::to_vector_of<mlir::Value>(innerFor.getResults()));
+    }
+
+    rewriter.replaceOp(target, outerFor.getResults());
+
+    return mlir::success();
+  }
+
+private:
+  int64_t maxBatchSize;
+};
+
 // Returns the set of loops whose IVs are referenced in the indexing
 // dimensions of `op` and which only appear in pure quasi-affine
 // expressions with a constant step wrt. to the iteration space and
@@ -2401,7 +2911,8 @@ public:
     mlir::Operation *op = getOperation();
 
     mlir::RewritePatternSet patterns(op->getContext());
-    patterns.add<BatchingPattern>(op->getContext(), maxBatchSize);
+    patterns.add<BatchingPattern, SiblingBatchingPattern,
+                 BatchingLoopTilingPattern>(op->getContext(), maxBatchSize);
     patterns
         .add<CleanupPattern<mlir::tensor::ExtractOp, mlir::tensor::InsertOp>,
              CleanupPattern<mlir::tensor::ExtractSliceOp,
@@ -0,0 +1,81 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/Transforms/Passes.h"
+
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include <mlir/Transforms/GreedyPatternRewriteDriver.h>
+
+namespace {
+
+// The batching pass wraps every batched call in a relayout sandwich: the
+// ciphertexts are sliced out of their structured tensor, collapsed into
+// the flat [batch][lwe_size] layout the batched wrappers consume, and
+// the result is expanded and inserted back. When two batched operations
+// are adjacent, the re-expansion of the first and the re-collapse of the
+// second are each other's inverses and only exist to move the data
+// through the structured layout; the patterns below cancel them so
+// consecutive batched ops hand their tensors over directly.
+
+/// Forwards `tensor.extract_slice` reading back exactly the slice a
+/// `tensor.insert_slice` just wrote, which the upstream canonicalizations
+/// do not cover.
+struct ForwardExtractOfInsertSlice
+    : public mlir::OpRewritePattern<mlir::tensor::ExtractSliceOp> {
+  using OpRewritePattern::OpRewritePattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::tensor::ExtractSliceOp extract,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto insert =
+        extract.getSource().getDefiningOp<mlir::tensor::InsertSliceOp>();
+    if (!insert)
+      return mlir::failure();
+    if (insert.getSource().getType() != extract.getType())
+      return mlir::failure();
+    if (extract.getMixedOffsets() != insert.getMixedOffsets() ||
+        extract.getMixedSizes() != insert.getMixedSizes() ||
+        extract.getMixedStrides() != insert.getMixedStrides())
+      return mlir::failure();
+    rewriter.replaceOp(extract, insert.getSource());
+    return mlir::success();
+  }
+};
+
+struct BatchingRelayoutCleanupPass
+    : public BatchingRelayoutCleanupBase<BatchingRelayoutCleanupPass> {
+
+  void runOnOperation() override {
+    mlir::RewritePatternSet patterns(&getContext());
+    // The upstream canonicalizations compose and cancel inverse
+    // expand/collapse pairs and fold slice operations into reshapes.
+    mlir::tensor::CollapseShapeOp::getCanonicalizationPatterns(patterns,
+                                                               &getContext());
+    mlir::tensor::ExpandShapeOp::getCanonicalizationPatterns(patterns,
+                                                             &getContext());
+    mlir::tensor::ExtractSliceOp::getCanonicalizationPatterns(patterns,
+                                                              &getContext());
+    mlir::tensor::InsertSliceOp::getCanonicalizationPatterns(patterns,
+                                                             &getContext());
+    patterns.add<ForwardExtractOfInsertSlice>(&getContext());
+
+    if (mlir::applyPatternsAndFoldGreedily(getOperation(),
+                                           std::move(patterns))
+            .failed()) {
+      this->signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createBatchingRelayoutCleanup() {
+  return std::make_unique<BatchingRelayoutCleanupPass>();
+}
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,68 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/Transforms/Passes.h"
+
+#include "mlir/Dialect/Affine/Analysis/LoopAnalysis.h"
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Affine/LoopUtils.h"
+#include "mlir/Dialect/SCF/Utils/Utils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+
+namespace {
+// Constant trip count of `forOp`, when its bounds and step are static.
+std::optional<uint64_t> constantTripCount(mlir::scf::ForOp forOp) {
+  auto lb = mlir::getConstantIntValue(forOp.getLowerBound());
+  auto ub = mlir::getConstantIntValue(forOp.getUpperBound());
+  auto step = mlir::getConstantIntValue(forOp.getStep());
+  if (!lb || !ub || !step || *step <= 0 || *ub < *lb)
+    return std::nullopt;
+  return (uint64_t)((*ub - *lb + *step - 1) / *step);
+}
+
+class UnrollSmallStaticLoopsPass
+    : public UnrollSmallStaticLoopsBase<UnrollSmallStaticLoopsPass> {
+public:
+  UnrollSmallStaticLoopsPass(int64_t maxTripCount)
+      : maxTripCount(maxTripCount) {}
+
+  void runOnOperation() override {
+    // Collect the loops in post order (innermost first), so a nest of
+    // small static loops flattens from the inside out and every handle
+    // is processed before an enclosing unroll could invalidate it.
+    llvm::SmallVector<mlir::Operation *> loops;
+    getOperation()->walk([&](mlir::Operation *op) {
+      if (llvm::isa<mlir::AffineForOp, mlir::scf::ForOp>(op))
+        loops.push_back(op);
+    });
+
+    for (mlir::Operation *op : loops) {
+      if (auto affineFor = llvm::dyn_cast<mlir::AffineForOp>(op)) {
+        auto tripCount = mlir::getConstantTripCount(affineFor);
+        if (tripCount && *tripCount > 0 &&
+            *tripCount <= (uint64_t)maxTripCount)
+          (void)mlir::loopUnrollFull(affineFor);
+        continue;
+      }
+
+      auto scfFor = llvm::cast<mlir::scf::ForOp>(op);
+      auto tripCount = constantTripCount(scfFor);
+      if (tripCount && *tripCount > 0 && *tripCount <= (uint64_t)maxTripCount)
+        // Unrolling by the full trip count leaves a single-iteration
+        // loop around the replicated body; the scf.for canonicalization
+        // promotes it afterwards.
+        (void)mlir::loopUnrollByFactor(scfFor, *tripCount);
+    }
+  }
+
+private:
+  int64_t maxTripCount;
+};
+} // namespace
+
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+mlir::concretelang::createUnrollSmallStaticLoops(int64_t maxTripCount) {
+  return std::make_unique<UnrollSmallStaticLoopsPass>(maxTripCount);
+}
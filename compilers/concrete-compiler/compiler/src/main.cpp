@@ -3,8 +3,10 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <atomic>
 #include <cstdint>
 #include <iostream>
+#include <thread>
 
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/JSON.h>
@@ -182,6 +184,14 @@ llvm::cl::opt<bool> splitInputFile(
                    "chunk independently"),
     llvm::cl::init(false));
 
+llvm::cl::opt<unsigned> jobs(
+    "jobs",
+    llvm::cl::desc("Number of input files processed concurrently within "
+                   "this process, sharing one LLVM/MLIR initialization; "
+                   "each job compiles with its own compilation context "
+                   "(1 by default)"),
+    llvm::cl::init(1));
+
 llvm::cl::opt<bool> autoParallelize(
     "parallelize",
     llvm::cl::desc("Generate (and execute if JIT) parallel code"),
@@ -193,6 +203,38 @@ llvm::cl::opt<bool> loopParallelize(
         "Generate (and execute if JIT) parallel loops from Linalg operations"),
     llvm::cl::init(false));
 
+llvm::cl::opt<bool> asyncLoopParallelize(
+    "parallelize-loops-async",
+    llvm::cl::desc("Lower parallel loops to the MLIR async runtime thread "
+                   "pool instead of OpenMP (requires --parallelize-loops)"),
+    llvm::cl::init(false));
+
+llvm::cl::opt<bool> specializeStaticShapes(
+    "specialize-static-shapes",
+    llvm::cl::desc("Specialize the lowered circuit for its static input "
+                   "shapes: fold shape and size arithmetic to constants "
+                   "and fully unroll small static batch loops"),
+    llvm::cl::init(false));
+
+llvm::cl::opt<unsigned int> loopUnrollFactor(
+    "loop-unroll-factor",
+    llvm::cl::desc("Unroll the lowered levelled loops by the given factor "
+                   "in the LLVM optimization pipeline (0 leaves the "
+                   "unroller to its own heuristics)"),
+    llvm::cl::init(0));
+
+llvm::cl::opt<bool> forceLoopVectorize(
+    "force-loop-vectorize",
+    llvm::cl::desc("Force the LLVM loop vectorizer on the lowered levelled "
+                   "loops, overriding its profitability model"),
+    llvm::cl::init(false));
+
+llvm::cl::opt<bool> vectorizerReport(
+    "vectorizer-report",
+    llvm::cl::desc("Report on stderr, per loop, whether the LLVM loop "
+                   "vectorizer vectorized it"),
+    llvm::cl::init(false));
+
 llvm::cl::opt<bool> batchTFHEOps(
     "batch-tfhe-ops",
     llvm::cl::desc("Hoist scalar TFHE operations with corresponding batched "
@@ -202,7 +244,10 @@ llvm::cl::opt<bool> batchTFHEOps(
 llvm::cl::opt<int64_t>
     maxBatchSize("max-batch-size",
                  llvm::cl::desc("Maximum number of operands materialized in a "
-                                "batch for --batch-tfhe-ops"),
+                                "batch for --batch-tfhe-ops; the effective "
+                                "limit may be lower if the buffers of a batch "
+                                "would exceed the memory budget of the target "
+                                "(cf. CONCRETELANG_BATCHING_MEMORY_BUDGET)"),
                  llvm::cl::init(std::numeric_limits<int64_t>::max()));
 
 llvm::cl::opt<bool> emitSDFGOps(
@@ -297,6 +342,21 @@ llvm::cl::opt<optimizer::Strategy> optimizerStrategy(
         "problem using the fhe computation dag with SEVERAL set of evaluation "
         "keys")));
 
+llvm::cl::opt<bool> autotuneOptimizer(
+    "autotune-optimizer",
+    llvm::cl::desc("Try every optimizer strategy and compile with the "
+                   "cheapest feasible one, overriding --optimizer-strategy "
+                   "(Disabled by default)"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> compressArtifacts(
+    "compress-artifacts",
+    llvm::cl::desc("Also emit compressed containers next to the shared "
+                   "library and client parameters; a distribution can ship "
+                   "the containers only, they are expanded in place on the "
+                   "first load (Disabled by default)"),
+    llvm::cl::init<bool>(false));
+
 llvm::cl::opt<double> fallbackLogNormWoppbs(
     "optimizer-fallback-log-norm-woppbs",
     llvm::cl::desc("Select a fallback value for multisum log norm in woppbs "
@@ -322,7 +382,9 @@ llvm::cl::opt<bool> optimizerNoCacheOnDisk(
 llvm::cl::list<int64_t> fhelinalgTileSizes(
     "fhelinalg-tile-sizes",
     llvm::cl::desc(
-        "Force tiling of FHELinalg operation with the given tile sizes"),
+        "Force tiling of FHELinalg operation with the given tile sizes; "
+        "without this option, large matrix multiplications are tiled with "
+        "automatically selected tile sizes"),
     llvm::cl::ZeroOrMore, llvm::cl::MiscFlags::CommaSeparated);
 
 llvm::cl::list<size_t> v0Constraint(
@@ -395,6 +457,7 @@ cmdlineCompilationOptions() {
   options.verifyDiagnostics = cmdline::verifyDiagnostics;
   options.autoParallelize = cmdline::autoParallelize;
   options.loopParallelize = cmdline::loopParallelize;
+  options.asyncLoopParallelize = cmdline::asyncLoopParallelize;
   options.dataflowParallelize = cmdline::dataflowParallelize;
   options.batchTFHEOps = cmdline::batchTFHEOps;
   options.maxBatchSize = cmdline::maxBatchSize;
@@ -407,6 +470,10 @@ cmdlineCompilationOptions() {
   options.chunkIntegers = cmdline::chunkIntegers;
   options.chunkSize = cmdline::chunkSize;
   options.chunkWidth = cmdline::chunkWidth;
+  options.specializeStaticShapes = cmdline::specializeStaticShapes;
+  options.loopUnrollFactor = cmdline::loopUnrollFactor;
+  options.forceLoopVectorize = cmdline::forceLoopVectorize;
+  options.vectorizerReport = cmdline::vectorizerReport;
 
   if (!cmdline::v0Constraint.empty()) {
     if (cmdline::v0Constraint.size() != 2) {
@@ -481,6 +548,7 @@ cmdlineCompilationOptions() {
   options.optimizerConfig.p_error = cmdline::pbsErrorProbability;
   options.optimizerConfig.display = cmdline::displayOptimizerChoice;
   options.optimizerConfig.strategy = cmdline::optimizerStrategy;
+  options.autotuneOptimizer = cmdline::autotuneOptimizer;
   options.optimizerConfig.encoding = cmdline::optimizerEncoding;
   options.optimizerConfig.cache_on_disk = !cmdline::optimizerNoCacheOnDisk;
 
@@ -682,6 +750,17 @@ mlir::LogicalResult compilerMain(int argc, char **argv) {
     }
   }
 
+  if (cmdline::jobs > 1) {
+    if (cmdline::splitInputFile) {
+      llvm::errs() << "'--jobs' and '--split-input-file' are incompatible\n";
+      return mlir::failure();
+    }
+    if (cmdline::action == Action::JIT_INVOKE) {
+      llvm::errs() << "'--jobs' does not support '--action=jit-invoke'\n";
+      return mlir::failure();
+    }
+  }
+
   auto compilerOptions = cmdlineCompilationOptions();
   if (auto err = compilerOptions.takeError()) {
     llvm::errs() << err << "\n";
@@ -708,36 +787,87 @@ mlir::LogicalResult compilerMain(int argc, char **argv) {
     return mlir::failure();
   }
 
-  // Iterate over all input files specified on the command line
-  for (const auto &fileName : cmdline::inputs) {
-    auto file = mlir::openInputFile(fileName, &errorMessage);
-
-    if (!file) {
-      llvm::errs() << errorMessage << "\n";
-      return mlir::failure();
+  size_t numJobs = std::min<size_t>(std::max<unsigned>(cmdline::jobs, 1),
+                                    cmdline::inputs.size());
+  if (numJobs > 1) {
+    // Concurrent driver: open every input up front, hand them out to a
+    // pool of worker threads that compile with separate compilation
+    // contexts against the shared output library, and write the buffered
+    // textual outputs back in input order once all workers are done.
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> files;
+    for (const auto &fileName : cmdline::inputs) {
+      auto file = mlir::openInputFile(fileName, &errorMessage);
+      if (!file) {
+        llvm::errs() << errorMessage << "\n";
+        return mlir::failure();
+      }
+      files.push_back(std::move(file));
     }
-
-    // If `--split-input-file` is set, the file is split into
-    // individual chunks separated by `// -----` markers. Each chunk
-    // is then processed individually as if it were part of a separate
-    // source file.
-    auto process = [&](std::unique_ptr<llvm::MemoryBuffer> inputBuffer,
-                       llvm::raw_ostream &os) {
-      return processInputBuffer(
-          std::move(inputBuffer), fileName, *compilerOptions, cmdline::action,
-          cmdline::jitArgs, jitKeySetCache, os, outputLib);
-    };
-    auto &os = output->os();
-    auto res = mlir::failure();
-    if (cmdline::splitInputFile) {
-      res = mlir::splitAndProcessBuffer(std::move(file), process, os);
-    } else {
-      res = process(std::move(file), os);
+    std::vector<std::string> buffered(files.size());
+    std::atomic<size_t> nextInput{0};
+    std::atomic<bool> anyFailed{false};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numJobs; t++) {
+      workers.push_back(std::thread([&]() {
+        while (true) {
+          size_t i = nextInput.fetch_add(1);
+          if (i >= files.size()) {
+            return;
+          }
+          llvm::raw_string_ostream os(buffered[i]);
+          auto res = processInputBuffer(
+              std::move(files[i]), cmdline::inputs[i], *compilerOptions,
+              cmdline::action, cmdline::jitArgs, jitKeySetCache, os,
+              outputLib);
+          os.flush();
+          if (res.failed()) {
+            anyFailed = true;
+          }
+        }
+      }));
     }
-    if (res.failed()) {
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    if (anyFailed) {
       return mlir::failure();
-    } else {
-      output->keep();
+    }
+    for (auto &chunk : buffered) {
+      output->os() << chunk;
+    }
+    output->keep();
+  } else {
+    // Iterate over all input files specified on the command line
+    for (const auto &fileName : cmdline::inputs) {
+      auto file = mlir::openInputFile(fileName, &errorMessage);
+
+      if (!file) {
+        llvm::errs() << errorMessage << "\n";
+        return mlir::failure();
+      }
+
+      // If `--split-input-file` is set, the file is split into
+      // individual chunks separated by `// -----` markers. Each chunk
+      // is then processed individually as if it were part of a separate
+      // source file.
+      auto process = [&](std::unique_ptr<llvm::MemoryBuffer> inputBuffer,
+                         llvm::raw_ostream &os) {
+        return processInputBuffer(
+            std::move(inputBuffer), fileName, *compilerOptions, cmdline::action,
+            cmdline::jitArgs, jitKeySetCache, os, outputLib);
+      };
+      auto &os = output->os();
+      auto res = mlir::failure();
+      if (cmdline::splitInputFile) {
+        res = mlir::splitAndProcessBuffer(std::move(file), process, os);
+      } else {
+        res = process(std::move(file), os);
+      }
+      if (res.failed()) {
+        return mlir::failure();
+      } else {
+        output->keep();
+      }
     }
   }
 
@@ -749,6 +879,12 @@ mlir::LogicalResult compilerMain(int argc, char **argv) {
     if (err) {
       return mlir::failure();
     }
+    if (cmdline::compressArtifacts) {
+      if (auto err = outputLib->compressArtifacts()) {
+        llvm::errs() << llvm::toString(std::move(err)) << "\n";
+        return mlir::failure();
+      }
+    }
   }
 
   return mlir::success();
@@ -0,0 +1,43 @@
+// RUN: concretecompiler --split-input-file --passes extract-sdfg-ops --emit-sdfg-ops --action=dump-sdfg %s 2>&1 | FileCheck %s
+
+// A chain of levelled operations is extracted as a whole: the
+// intermediate value between the two processes lives on an on_device
+// stream and never goes back to the host.
+
+// CHECK:      func.func @levelled_chain(%[[a0:.*]]: tensor<1025xi64>, %[[a1:.*]]: tensor<1025xi64>) -> tensor<1025xi64> {
+// CHECK-NEXT:   %[[DFG:.*]] = "SDFG.init"() : () -> !SDFG.dfg
+// CHECK-NEXT:   %[[S0:.*]] = "SDFG.make_stream"(%[[DFG]]) {name = "stream0", type = #SDFG.stream_kind<on_device>}
+// CHECK-NEXT:   %[[S1:.*]] = "SDFG.make_stream"(%[[DFG]]) {name = "stream1", type = #SDFG.stream_kind<host_to_device>}
+// CHECK-NEXT:   %[[S2:.*]] = "SDFG.make_stream"(%[[DFG]]) {name = "stream2", type = #SDFG.stream_kind<host_to_device>}
+// CHECK-NEXT:   "SDFG.make_process"(%[[DFG]], %[[S1]], %[[S2]], %[[S0]]) {type = #SDFG.process_kind<add_eint>}
+// CHECK-NEXT:   %[[S3:.*]] = "SDFG.make_stream"(%[[DFG]]) {name = "stream3", type = #SDFG.stream_kind<device_to_host>}
+// CHECK-NEXT:   "SDFG.make_process"(%[[DFG]], %[[S0]], %[[S3]]) {type = #SDFG.process_kind<neg_eint>}
+// CHECK-NEXT:   "SDFG.start"(%[[DFG]])
+// CHECK-NOT:    "Concrete.
+// CHECK:        "SDFG.put"(%[[S2]], %[[a1]])
+// CHECK-NEXT:   "SDFG.put"(%[[S1]], %[[a0]])
+// CHECK-NEXT:   %[[RES:.*]] = "SDFG.get"(%[[S3]])
+// CHECK-NEXT:   "SDFG.shutdown"(%[[DFG]])
+// CHECK-NEXT:   return %[[RES]] : tensor<1025xi64>
+func.func @levelled_chain(%arg0: tensor<1025xi64>, %arg1: tensor<1025xi64>) -> tensor<1025xi64> {
+  %0 = "Concrete.add_lwe_tensor"(%arg0, %arg1) : (tensor<1025xi64>, tensor<1025xi64>) -> tensor<1025xi64>
+  %1 = "Concrete.negate_lwe_tensor"(%0) : (tensor<1025xi64>) -> tensor<1025xi64>
+  return %1 : tensor<1025xi64>
+}
+
+// -----
+
+// An intermediate value consumed both on-device and by the host is
+// spliced: the on-device consumer keeps reading from the device while a
+// device_to_host stream feeds the host copy.
+
+// CHECK:      func.func @levelled_splice(%[[a0:.*]]: tensor<1025xi64>, %[[a1:.*]]: tensor<1025xi64>) -> (tensor<1025xi64>, tensor<1025xi64>) {
+// CHECK:        "SDFG.make_stream"(%{{.*}}) {name = "stream0", type = #SDFG.stream_kind<device_to_host>}
+// CHECK:        "SDFG.make_stream"(%{{.*}}) {name = "stream1", type = #SDFG.stream_kind<host_to_device>}
+// CHECK:        #SDFG.process_kind<add_eint>
+// CHECK:        #SDFG.process_kind<neg_eint>
+func.func @levelled_splice(%arg0: tensor<1025xi64>, %arg1: tensor<1025xi64>) -> (tensor<1025xi64>, tensor<1025xi64>) {
+  %0 = "Concrete.add_lwe_tensor"(%arg0, %arg1) : (tensor<1025xi64>, tensor<1025xi64>) -> tensor<1025xi64>
+  %1 = "Concrete.negate_lwe_tensor"(%0) : (tensor<1025xi64>) -> tensor<1025xi64>
+  return %0, %1 : tensor<1025xi64>, tensor<1025xi64>
+}
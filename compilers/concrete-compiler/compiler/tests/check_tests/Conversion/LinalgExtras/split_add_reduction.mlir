@@ -0,0 +1,31 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --parallelize-loops %s 2>&1 | FileCheck %s
+
+// A large encrypted sum is split into 16 partial accumulators computed
+// by a parallel chunk loop, followed by a small serial combine loop.
+
+// CHECK-LABEL: func.func @split_sum
+// CHECK: tensor.expand_shape %{{.*}} {{\[\[}}0, 1{{\]\]}} : tensor<4096x!FHE.eint<7>> into tensor<16x256x!FHE.eint<7>>
+// CHECK: "FHE.zero_tensor"() : () -> tensor<16x1x!FHE.eint<7>>
+// CHECK: scf.for
+// CHECK: scf.for
+// CHECK: "FHE.add_eint"
+// CHECK: {parallel = false}
+// CHECK: {parallel = true}
+// CHECK: scf.for
+// CHECK: "FHE.add_eint"
+// CHECK: {parallel = false}
+func.func @split_sum(%arg0: tensor<4096x!FHE.eint<7>>) -> tensor<1x!FHE.eint<7>> {
+  %0 = "FHELinalg.sum"(%arg0) { keep_dims = true } : (tensor<4096x!FHE.eint<7>>) -> tensor<1x!FHE.eint<7>>
+  return %0 : tensor<1x!FHE.eint<7>>
+}
+
+// -----
+
+// Small reductions are not worth splitting and stay serial.
+
+// CHECK-LABEL: func.func @small_sum
+// CHECK-NOT: tensor.expand_shape
+func.func @small_sum(%arg0: tensor<8x!FHE.eint<7>>) -> tensor<1x!FHE.eint<7>> {
+  %0 = "FHELinalg.sum"(%arg0) { keep_dims = true } : (tensor<8x!FHE.eint<7>>) -> tensor<1x!FHE.eint<7>>
+  return %0 : tensor<1x!FHE.eint<7>>
+}
@@ -0,0 +1,32 @@
+// RUN: concretecompiler --passes tfhe-to-concrete --passes concrete-tlu-dedup --action=dump-concrete %s 2>&1| FileCheck %s
+
+// CHECK:      func.func @dedup_lut(%[[A0:.*]]: tensor<601xi64>) -> (tensor<1025xi64>, tensor<1025xi64>) {
+// CHECK-NEXT:   %[[CST:.*]] = arith.constant dense<0> : tensor<128xi64>
+// CHECK-NEXT:   %[[V1:.*]] = "Concrete.bootstrap_lwe_tensor"(%[[A0]], %[[CST]])
+// CHECK-NEXT:   %[[V2:.*]] = "Concrete.bootstrap_lwe_tensor"(%[[A0]], %[[CST]])
+// CHECK-NEXT:   return %[[V1]], %[[V2]] : tensor<1025xi64>, tensor<1025xi64>
+// CHECK-NEXT: }
+func.func @dedup_lut(%ciphertext: !TFHE.glwe<sk[1]<1,600>>) -> (!TFHE.glwe<sk[5]<1,1024>>, !TFHE.glwe<sk[5]<1,1024>>) {
+  %cst0 = arith.constant dense<0> : tensor<128xi64>
+  %cst1 = arith.constant dense<0> : tensor<128xi64>
+  %b0 = "TFHE.bootstrap_glwe"(%ciphertext, %cst0) {key = #TFHE.bsk<sk[1]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>}: (!TFHE.glwe<sk[1]<1,600>>, tensor<128xi64>) -> !TFHE.glwe<sk[5]<1,1024>>
+  %b1 = "TFHE.bootstrap_glwe"(%ciphertext, %cst1) {key = #TFHE.bsk<sk[1]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>}: (!TFHE.glwe<sk[1]<1,600>>, tensor<128xi64>) -> !TFHE.glwe<sk[5]<1,1024>>
+  return %b0, %b1 : !TFHE.glwe<sk[5]<1,1024>>, !TFHE.glwe<sk[5]<1,1024>>
+}
+
+// -----
+
+// CHECK:      func.func @distinct_luts_kept(%[[A0:.*]]: tensor<601xi64>) -> (tensor<1025xi64>, tensor<1025xi64>) {
+// CHECK-NEXT:   %[[CST0:.*]] = arith.constant dense<0> : tensor<128xi64>
+// CHECK-NEXT:   %[[CST1:.*]] = arith.constant dense<1> : tensor<128xi64>
+// CHECK-NEXT:   %[[V1:.*]] = "Concrete.bootstrap_lwe_tensor"(%[[A0]], %[[CST0]])
+// CHECK-NEXT:   %[[V2:.*]] = "Concrete.bootstrap_lwe_tensor"(%[[A0]], %[[CST1]])
+// CHECK-NEXT:   return %[[V1]], %[[V2]] : tensor<1025xi64>, tensor<1025xi64>
+// CHECK-NEXT: }
+func.func @distinct_luts_kept(%ciphertext: !TFHE.glwe<sk[1]<1,600>>) -> (!TFHE.glwe<sk[5]<1,1024>>, !TFHE.glwe<sk[5]<1,1024>>) {
+  %cst0 = arith.constant dense<0> : tensor<128xi64>
+  %cst1 = arith.constant dense<1> : tensor<128xi64>
+  %b0 = "TFHE.bootstrap_glwe"(%ciphertext, %cst0) {key = #TFHE.bsk<sk[1]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>}: (!TFHE.glwe<sk[1]<1,600>>, tensor<128xi64>) -> !TFHE.glwe<sk[5]<1,1024>>
+  %b1 = "TFHE.bootstrap_glwe"(%ciphertext, %cst1) {key = #TFHE.bsk<sk[1]<1,600>, sk[1]<1,1024>, 1024, 1, 3, 1>}: (!TFHE.glwe<sk[1]<1,600>>, tensor<128xi64>) -> !TFHE.glwe<sk[5]<1,1024>>
+  return %b0, %b1 : !TFHE.glwe<sk[5]<1,1024>>, !TFHE.glwe<sk[5]<1,1024>>
+}
@@ -0,0 +1,43 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe %s 2>&1| FileCheck %s
+
+// The round of a lookup table result is fused into the table: the entries
+// are rounded at compile time and the lookup directly produces the smaller
+// precision.
+
+// CHECK:      func.func @round_of_tlu(%[[a0:.*]]: !FHE.eint<5>) -> !FHE.eint<3> {
+// CHECK-NEXT:   %[[cst:.*]] = arith.constant dense<[0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 0, 0]> : tensor<32xi64>
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[cst]]) : (!FHE.eint<5>, tensor<32xi64>) -> !FHE.eint<3>
+// CHECK-NEXT:   return %[[v0]] : !FHE.eint<3>
+func.func @round_of_tlu(%arg0: !FHE.eint<5>) -> !FHE.eint<3> {
+  %lut = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31]> : tensor<32xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<5>, tensor<32xi64>) -> !FHE.eint<5>
+  %1 = "FHE.round"(%0) : (!FHE.eint<5>) -> !FHE.eint<3>
+  return %1 : !FHE.eint<3>
+}
+
+// -----
+
+// The lookup table result is used elsewhere at full precision, the round
+// is kept.
+
+// CHECK:      func.func @round_of_tlu_multiple_uses
+// CHECK:        "FHE.round"
+func.func @round_of_tlu_multiple_uses(%arg0: !FHE.eint<5>) -> (!FHE.eint<5>, !FHE.eint<3>) {
+  %lut = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31]> : tensor<32xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<5>, tensor<32xi64>) -> !FHE.eint<5>
+  %1 = "FHE.round"(%0) : (!FHE.eint<5>) -> !FHE.eint<3>
+  return %0, %1 : !FHE.eint<5>, !FHE.eint<3>
+}
+
+// -----
+
+// Signed messages wrap around differently on rounding, the round is kept.
+
+// CHECK:      func.func @round_of_signed_tlu
+// CHECK:        "FHE.round"
+func.func @round_of_signed_tlu(%arg0: !FHE.eint<3>) -> !FHE.esint<2> {
+  %lut = arith.constant dense<[0, 1, 2, 3, 4, 5, 6, 7]> : tensor<8xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut) : (!FHE.eint<3>, tensor<8xi64>) -> !FHE.esint<3>
+  %1 = "FHE.round"(%0) : (!FHE.esint<3>) -> !FHE.esint<2>
+  return %1 : !FHE.esint<2>
+}
@@ -58,3 +58,62 @@ func.func @tiled_one_big_tile(%a: tensor<8x4x!FHE.eint<6>>, %b: tensor<4x2xi7>)
   return %0 : tensor<8x2x!FHE.eint<6>>
 }
 
+
+// -----
+
+// CHECK:      func.func @auto_tiled(%[[Varg0:.*]]: tensor<128x2x!FHE.eint<6>>, %[[Varg1:.*]]: tensor<2x128xi7>) -> tensor<128x128x!FHE.eint<6>>
+// CHECK:        scf.for
+// CHECK:          scf.for
+// CHECK:            scf.for
+// CHECK:              %[[VA:.*]] = tensor.extract_slice %[[Varg0]][{{.*}}] [64, 2] [1, 1] : tensor<128x2x!FHE.eint<6>> to tensor<64x2x!FHE.eint<6>>
+// CHECK:              %[[VB:.*]] = tensor.extract_slice %[[Varg1]][{{.*}}] [2, 64] [1, 1] : tensor<2x128xi7> to tensor<2x64xi7>
+// CHECK:              "FHELinalg.matmul_eint_int"(%[[VA]], %[[VB]]) : (tensor<64x2x!FHE.eint<6>>, tensor<2x64xi7>) -> tensor<64x64x!FHE.eint<6>>
+func.func @auto_tiled(%a: tensor<128x2x!FHE.eint<6>>, %b: tensor<2x128xi7>) -> tensor<128x128x!FHE.eint<6>> {
+  %0 = "FHELinalg.matmul_eint_int"(%a, %b) : (tensor<128x2x!FHE.eint<6>>, tensor<2x128xi7>) -> tensor<128x128x!FHE.eint<6>>
+  return %0 : tensor<128x128x!FHE.eint<6>>
+}
+
+// -----
+
+// CHECK:      func.func @small_not_tiled(%[[Varg0:.*]]: tensor<8x4x!FHE.eint<6>>, %[[Varg1:.*]]: tensor<4x2xi7>) -> tensor<8x2x!FHE.eint<6>>
+// CHECK-NOT:    scf.for
+// CHECK:        "FHELinalg.matmul_eint_int"(%[[Varg0]], %[[Varg1]]) : (tensor<8x4x!FHE.eint<6>>, tensor<4x2xi7>) -> tensor<8x2x!FHE.eint<6>>
+func.func @small_not_tiled(%a: tensor<8x4x!FHE.eint<6>>, %b: tensor<4x2xi7>) -> tensor<8x2x!FHE.eint<6>> {
+  %0 = "FHELinalg.matmul_eint_int"(%a, %b) : (tensor<8x4x!FHE.eint<6>>, tensor<4x2xi7>) -> tensor<8x2x!FHE.eint<6>>
+  return %0 : tensor<8x2x!FHE.eint<6>>
+}
+
+// -----
+
+// CHECK:      func.func @conv_blocked_2x2(%[[Varg0:.*]]: tensor<4x2x4x4x!FHE.eint<6>>, %[[Varg1:.*]]: tensor<4x2x2x2xi7>, %[[Varg2:.*]]: tensor<4xi7>) -> tensor<4x4x3x3x!FHE.eint<6>> {
+// CHECK-NEXT:    %[[Vc2:.*]] = arith.constant 2 : index
+// CHECK-NEXT:    %[[Vc0:.*]] = arith.constant 0 : index
+// CHECK-NEXT:    %[[Vc4:.*]] = arith.constant 4 : index
+// CHECK-NEXT:    %[[V0:.*]] = "FHE.zero_tensor"() : () -> tensor<4x4x3x3x!FHE.eint<6>>
+// CHECK-NEXT:    %[[V1:.*]] = scf.for %[[Varg3:.*]] = %[[Vc0]] to %[[Vc4]] step %[[Vc2]] iter_args(%[[Varg4:.*]] = %[[V0]]) -> (tensor<4x4x3x3x!FHE.eint<6>>) {
+// CHECK-NEXT:      %[[V2:.*]] = scf.for %[[Varg5:.*]] = %[[Vc0]] to %[[Vc4]] step %[[Vc2]] iter_args(%[[Varg6:.*]] = %[[Varg4]]) -> (tensor<4x4x3x3x!FHE.eint<6>>) {
+// CHECK-NEXT:        %[[V3:.*]] = tensor.extract_slice %[[Varg0]][%[[Varg3]], 0, 0, 0] [2, 2, 4, 4] [1, 1, 1, 1] : tensor<4x2x4x4x!FHE.eint<6>> to tensor<2x2x4x4x!FHE.eint<6>>
+// CHECK-NEXT:        %[[V4:.*]] = tensor.extract_slice %[[Varg1]][%[[Varg5]], 0, 0, 0] [2, 2, 2, 2] [1, 1, 1, 1] : tensor<4x2x2x2xi7> to tensor<2x2x2x2xi7>
+// CHECK-NEXT:        %[[V5:.*]] = tensor.extract_slice %[[Varg2]][%[[Varg5]]] [2] [1] : tensor<4xi7> to tensor<2xi7>
+// CHECK-NEXT:        %[[V6:.*]] = "FHELinalg.conv2d"(%[[V3]], %[[V4]], %[[V5]]) : (tensor<2x2x4x4x!FHE.eint<6>>, tensor<2x2x2x2xi7>, tensor<2xi7>) -> tensor<2x2x3x3x!FHE.eint<6>>
+// CHECK-NEXT:        %[[V7:.*]] = tensor.insert_slice %[[V6]] into %[[Varg6]][%[[Varg3]], %[[Varg5]], 0, 0] [2, 2, 3, 3] [1, 1, 1, 1] : tensor<2x2x3x3x!FHE.eint<6>> into tensor<4x4x3x3x!FHE.eint<6>>
+// CHECK-NEXT:        scf.yield %[[V7]] : tensor<4x4x3x3x!FHE.eint<6>>
+// CHECK-NEXT:      }
+// CHECK-NEXT:      scf.yield %[[V2]] : tensor<4x4x3x3x!FHE.eint<6>>
+// CHECK-NEXT:    }
+// CHECK-NEXT:    return %[[V1]] : tensor<4x4x3x3x!FHE.eint<6>>
+// CHECK-NEXT: }
+func.func @conv_blocked_2x2(%input: tensor<4x2x4x4x!FHE.eint<6>>, %weight: tensor<4x2x2x2xi7>, %bias: tensor<4xi7>) -> tensor<4x4x3x3x!FHE.eint<6>> {
+  %0 = "FHELinalg.conv2d"(%input, %weight, %bias) { "tile-sizes" = [2,2] } : (tensor<4x2x4x4x!FHE.eint<6>>, tensor<4x2x2x2xi7>, tensor<4xi7>) -> tensor<4x4x3x3x!FHE.eint<6>>
+  return %0 : tensor<4x4x3x3x!FHE.eint<6>>
+}
+
+// -----
+
+// CHECK:      func.func @small_conv_not_blocked(%[[Varg0:.*]]: tensor<1x1x4x4x!FHE.eint<6>>, %[[Varg1:.*]]: tensor<1x1x2x2xi7>) -> tensor<1x1x3x3x!FHE.eint<6>>
+// CHECK-NOT:    scf.for
+// CHECK:        "FHELinalg.conv2d"(%[[Varg0]], %[[Varg1]]) : (tensor<1x1x4x4x!FHE.eint<6>>, tensor<1x1x2x2xi7>) -> tensor<1x1x3x3x!FHE.eint<6>>
+func.func @small_conv_not_blocked(%input: tensor<1x1x4x4x!FHE.eint<6>>, %weight: tensor<1x1x2x2xi7>) -> tensor<1x1x3x3x!FHE.eint<6>> {
+  %0 = "FHELinalg.conv2d"(%input, %weight) : (tensor<1x1x4x4x!FHE.eint<6>>, tensor<1x1x2x2xi7>) -> tensor<1x1x3x3x!FHE.eint<6>>
+  return %0 : tensor<1x1x3x3x!FHE.eint<6>>
+}
@@ -278,3 +278,40 @@ func.func @apply_lookup_table_contiguous_hoistable_nonbatchable(%arg0: tensor<2x
   }
   return %1 : tensor<2x3x4x!TFHE.glwe<sk<0,1,2048>>>
 }
+
+// -----
+
+// CHECK-LABEL: func.func @batch_straight_line_keyswitch
+// CHECK: (%arg0: !TFHE.glwe<sk{{\[}}[[SK_IN:.*]]{{\]}}<1,2048>>, %arg1: !TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>, %arg2: !TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>) -> (!TFHE.glwe<sk{{\[}}[[SK_OUT:.*]]{{\]}}<1,750>>, !TFHE.glwe<sk{{\[}}[[SK_OUT]]{{\]}}<1,750>>, !TFHE.glwe<sk{{\[}}[[SK_OUT]]{{\]}}<1,750>>) {
+// CHECK: %[[T0:.*]] = bufferization.alloc_tensor() : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>>
+// CHECK: %[[T1:.*]] = tensor.insert %arg0 into %[[T0]][%{{.*}}] : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>>
+// CHECK: %[[T2:.*]] = tensor.insert %arg1 into %[[T1]][%{{.*}}] : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>>
+// CHECK: %[[T3:.*]] = tensor.insert %arg2 into %[[T2]][%{{.*}}] : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>>
+// CHECK: %[[V0:.*]] = "TFHE.batched_keyswitch_glwe"(%[[T3]]) {key = #TFHE<ksk{{\[}}[[KSK:.*]]{{\]}}<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>, sk{{\[}}[[SK_OUT]]{{\]}}<1,750>, 3, 4>>} : (tensor<3x!TFHE.glwe<sk{{\[}}[[SK_IN]]{{\]}}<1,2048>>>) -> tensor<3x!TFHE.glwe<sk{{\[}}[[SK_OUT]]{{\]}}<1,750>>>
+// CHECK: %[[R0:.*]] = tensor.extract %[[V0]][%{{.*}}] : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_OUT]]{{\]}}<1,750>>>
+// CHECK: %[[R1:.*]] = tensor.extract %[[V0]][%{{.*}}] : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_OUT]]{{\]}}<1,750>>>
+// CHECK: %[[R2:.*]] = tensor.extract %[[V0]][%{{.*}}] : tensor<3x!TFHE.glwe<sk{{\[}}[[SK_OUT]]{{\]}}<1,750>>>
+// CHECK: return %[[R0]], %[[R1]], %[[R2]]
+func.func @batch_straight_line_keyswitch(%arg0: !TFHE.glwe<sk<0,1,2048>>, %arg1: !TFHE.glwe<sk<0,1,2048>>, %arg2: !TFHE.glwe<sk<0,1,2048>>) -> (!TFHE.glwe<sk<1,1,750>>, !TFHE.glwe<sk<1,1,750>>, !TFHE.glwe<sk<1,1,750>>) {
+  %0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %1 = "TFHE.keyswitch_glwe"(%arg1) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  %2 = "TFHE.keyswitch_glwe"(%arg2) {key = #TFHE.ksk<sk<0,1,2048>, sk<1,1,750>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<1,1,750>>
+  return %0, %1, %2 : !TFHE.glwe<sk<1,1,750>>, !TFHE.glwe<sk<1,1,750>>, !TFHE.glwe<sk<1,1,750>>
+}
+
+// -----
+
+// The third keyswitch depends on the results of the first two, so
+// only the two independent operations are merged into a batch.
+// CHECK-LABEL: func.func @no_batch_dependent_keyswitch
+// CHECK: "TFHE.batched_keyswitch_glwe"
+// CHECK-NOT: "TFHE.batched_keyswitch_glwe"
+// CHECK: "TFHE.keyswitch_glwe"
+func.func @no_batch_dependent_keyswitch(%arg0: !TFHE.glwe<sk<0,1,2048>>, %arg1: !TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<0,1,2048>> {
+  %0 = "TFHE.keyswitch_glwe"(%arg0) {key = #TFHE.ksk<sk<0,1,2048>, sk<0,1,2048>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<0,1,2048>>
+  %1 = "TFHE.keyswitch_glwe"(%arg1) {key = #TFHE.ksk<sk<0,1,2048>, sk<0,1,2048>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<0,1,2048>>
+  %2 = "TFHE.add_glwe"(%0, %1) : (!TFHE.glwe<sk<0,1,2048>>, !TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<0,1,2048>>
+  %3 = "TFHE.keyswitch_glwe"(%2) {key = #TFHE.ksk<sk<0,1,2048>, sk<0,1,2048>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<0,1,2048>>
+  %4 = "TFHE.keyswitch_glwe"(%3) {key = #TFHE.ksk<sk<0,1,2048>, sk<0,1,2048>, 3, 4>} : (!TFHE.glwe<sk<0,1,2048>>) -> !TFHE.glwe<sk<0,1,2048>>
+  return %4 : !TFHE.glwe<sk<0,1,2048>>
+}
@@ -0,0 +1,222 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+/// Compile-time scalability benchmarks for the analysis phases whose cost
+/// grows with circuit size: the MANP noise analysis, the construction of
+/// the concrete-optimizer dag and the optimizer parameter search. The
+/// circuits are generated programmatically against the FHE dialect, so op
+/// counts far beyond the end-to-end fixtures (10k/100k/500k) are reached
+/// without shipping megabytes of textual MLIR.
+
+#include <benchmark/benchmark.h>
+
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/IR/Builders.h>
+#include <mlir/IR/BuiltinOps.h>
+#include <mlir/IR/MLIRContext.h>
+#include <mlir/Pass/PassManager.h>
+
+#include <concretelang/Dialect/FHE/Analysis/ConcreteOptimizer.h>
+#include <concretelang/Dialect/FHE/Analysis/MANP.h>
+#include <concretelang/Dialect/FHE/IR/FHEDialect.h>
+#include <concretelang/Dialect/FHE/IR/FHEOps.h>
+#include <concretelang/Dialect/FHE/IR/FHETypes.h>
+#include <concretelang/Support/CompilationFeedback.h>
+#include <concretelang/Support/V0Parameters.h>
+#include <concretelang/Support/math.h>
+
+namespace FHE = mlir::concretelang::FHE;
+
+namespace {
+
+constexpr unsigned PRECISION = 6;
+constexpr size_t WIDTH = 64;
+/// One op in TLU_PERIOD is a table lookup, the rest are levelled
+/// additions; 4 approximates the TLU density of the models the
+/// end-to-end benchmarks compile.
+constexpr size_t TLU_PERIOD = 4;
+
+void loadDialects(mlir::MLIRContext &context) {
+  context
+      .loadDialect<FHE::FHEDialect, mlir::func::FuncDialect,
+                   mlir::arith::ArithDialect>();
+}
+
+/// Builds a `main` function of `numOps` FHE operations arranged as WIDTH
+/// parallel lanes of encrypted integers: each step combines a lane with
+/// its neighbour so the dataflow is a wide grid rather than a single
+/// chain, and every TLU_PERIOD-th op is a table lookup resetting the
+/// accumulated noise of its lane.
+mlir::OwningOpRef<mlir::ModuleOp>
+buildSyntheticCircuit(mlir::MLIRContext &context, size_t numOps) {
+  mlir::OpBuilder builder(&context);
+  mlir::Location loc = builder.getUnknownLoc();
+  mlir::OwningOpRef<mlir::ModuleOp> module = mlir::ModuleOp::create(loc);
+  builder.setInsertionPointToEnd(module->getBody());
+
+  auto eintType = FHE::EncryptedIntegerType::get(&context, PRECISION);
+  llvm::SmallVector<mlir::Type> argTypes(WIDTH, eintType);
+  auto func = builder.create<mlir::func::FuncOp>(
+      loc, "main", builder.getFunctionType(argTypes, {eintType}));
+  mlir::Block *entry = func.addEntryBlock();
+  builder.setInsertionPointToStart(entry);
+
+  auto lutType = mlir::RankedTensorType::get({1 << PRECISION},
+                                             builder.getI64Type());
+  llvm::SmallVector<int64_t> lutValues(1 << PRECISION);
+  for (size_t i = 0; i < lutValues.size(); i++)
+    lutValues[i] = i;
+  mlir::Value lut = builder.create<mlir::arith::ConstantOp>(
+      loc, mlir::DenseIntElementsAttr::get(lutType, lutValues));
+
+  llvm::SmallVector<mlir::Value> lanes(entry->getArguments());
+  size_t emitted = 0;
+  while (emitted < numOps) {
+    for (size_t lane = 0; lane < WIDTH && emitted < numOps; lane++) {
+      if (emitted % TLU_PERIOD == TLU_PERIOD - 1)
+        lanes[lane] = builder.create<FHE::ApplyLookupTableEintOp>(
+            loc, eintType, lanes[lane], lut);
+      else
+        lanes[lane] = builder.create<FHE::AddEintOp>(
+            loc, eintType, lanes[lane], lanes[(lane + 1) % WIDTH]);
+      emitted++;
+    }
+  }
+  builder.create<mlir::func::ReturnOp>(loc, lanes[0]);
+  return module;
+}
+
+/// Nests `pass` on its anchor operation, as the compilation pipeline
+/// does, so function passes still run when the pass manager anchors on
+/// the module.
+void addNestedPass(mlir::PassManager &pm, std::unique_ptr<mlir::Pass> pass) {
+  if (!pass->getOpName() || *pass->getOpName() == "builtin.module")
+    pm.addPass(std::move(pass));
+  else
+    pm.nest(*pass->getOpName()).addPass(std::move(pass));
+}
+
+void runPasses(mlir::PassManager &pm, mlir::ModuleOp module,
+               const char *what) {
+  if (pm.run(module.getOperation()).failed()) {
+    llvm::errs() << what << " failed\n";
+    abort();
+  }
+}
+
+void runMANP(mlir::MLIRContext &context, mlir::ModuleOp module) {
+  mlir::PassManager pm(&context);
+  addNestedPass(pm, mlir::concretelang::createMANPPass());
+  runPasses(pm, module, "MANP");
+}
+
+mlir::concretelang::optimizer::Config searchConfig() {
+  auto config = mlir::concretelang::optimizer::DEFAULT_CONFIG;
+  // A benchmark must search, not hit the persistent solution cache, and
+  // needs fully specified error targets.
+  config.cache_on_disk = false;
+  config.p_error = mlir::concretelang::optimizer::DEFAULT_GLOBAL_P_ERROR;
+  return config;
+}
+
+/// MANP noise analysis alone. The pass recomputes and overwrites its
+/// attributes, so iterations run on the same module.
+void BM_MANP(benchmark::State &state) {
+  mlir::MLIRContext context;
+  loadDialects(context);
+  auto module = buildSyntheticCircuit(context, state.range(0));
+  for (auto _ : state)
+    runMANP(context, *module);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Construction of the concrete-optimizer dag. The dag pass consumes the
+/// SMANP attributes, so MANP is re-run untimed before each iteration.
+void BM_OptimizerDagBuild(benchmark::State &state) {
+  mlir::MLIRContext context;
+  loadDialects(context);
+  auto module = buildSyntheticCircuit(context, state.range(0));
+  auto config = searchConfig();
+  for (auto _ : state) {
+    state.PauseTiming();
+    runMANP(context, *module);
+    mlir::concretelang::optimizer::FunctionsDag dags;
+    mlir::PassManager pm(&context);
+    addNestedPass(pm, mlir::concretelang::optimizer::createDagPass(config,
+                                                                   dags));
+    state.ResumeTiming();
+    runPasses(pm, *module, "dag construction");
+    benchmark::DoNotOptimize(dags);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/// Optimizer parameter search over the dag (mono or multi parameter
+/// strategy), excluding dag construction.
+void BM_OptimizerSearch(benchmark::State &state,
+                        mlir::concretelang::optimizer::Strategy strategy) {
+  mlir::MLIRContext context;
+  loadDialects(context);
+  auto module = buildSyntheticCircuit(context, state.range(0));
+  runMANP(context, *module);
+
+  std::optional<uint64_t> maxManp;
+  std::optional<unsigned> maxWidth;
+  mlir::concretelang::optimizer::FunctionsDag dags;
+  auto config = searchConfig();
+  config.strategy = strategy;
+  mlir::PassManager pm(&context);
+  addNestedPass(pm, mlir::concretelang::createMaxMANPPass(
+                        [&](const uint64_t manp, unsigned width) {
+                          if (!maxManp.has_value() || *maxManp < manp)
+                            maxManp = manp;
+                          if (!maxWidth.has_value() || *maxWidth < width)
+                            maxWidth = width;
+                        }));
+  addNestedPass(pm, mlir::concretelang::optimizer::createDagPass(config,
+                                                                 dags));
+  runPasses(pm, *module, "constraint and dag construction");
+  if (!maxManp.has_value() || !dags["main"].has_value()) {
+    llvm::errs() << "no FHE constraint or dag for the synthetic circuit\n";
+    abort();
+  }
+
+  mlir::concretelang::optimizer::Description description = {
+      {/*.norm2 = */ ceilLog2(*maxManp), /*.p = */ *maxWidth},
+      std::move(dags["main"])};
+  for (auto _ : state) {
+    mlir::concretelang::CompilationFeedback feedback;
+    auto solution =
+        mlir::concretelang::getSolution(description, feedback, config);
+    if (auto err = solution.takeError()) {
+      llvm::errs() << "optimizer search failed: "
+                   << llvm::toString(std::move(err)) << "\n";
+      abort();
+    }
+    benchmark::DoNotOptimize(*solution);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void registerSizes(benchmark::internal::Benchmark *bench) {
+  bench->Unit(benchmark::kMillisecond)
+      ->Arg(10000)
+      ->Arg(100000)
+      ->Arg(500000);
+}
+
+BENCHMARK(BM_MANP)->Apply(registerSizes);
+BENCHMARK(BM_OptimizerDagBuild)->Apply(registerSizes);
+BENCHMARK_CAPTURE(BM_OptimizerSearch, dag_mono,
+                  mlir::concretelang::optimizer::Strategy::DAG_MONO)
+    ->Apply(registerSizes);
+BENCHMARK_CAPTURE(BM_OptimizerSearch, dag_multi,
+                  mlir::concretelang::optimizer::Strategy::DAG_MULTI)
+    ->Apply(registerSizes);
+
+} // namespace
+
+BENCHMARK_MAIN();
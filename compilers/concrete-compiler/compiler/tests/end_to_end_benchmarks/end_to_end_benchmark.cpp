@@ -1,6 +1,9 @@
 #include "../end_to_end_tests/end_to_end_test.h"
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <chrono>
+#include <fstream>
 
 #define BENCHMARK_HAS_CXX11
 #include "llvm/Support/Path.h"
@@ -14,31 +17,78 @@
     assert(false && "See error above");                                        \
   }
 
+/// Records per-iteration wall-clock latencies and reports the p50/p95/p99
+/// percentiles as counters (in nanoseconds) next to the google-benchmark
+/// mean, so SLOs can be tracked per phase instead of averages only.
+class LatencyPercentiles {
+public:
+  void record(std::chrono::steady_clock::time_point begin) {
+    samples.push_back(std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - begin)
+                          .count());
+  }
+
+  void report(benchmark::State &state) {
+    if (samples.empty())
+      return;
+    std::sort(samples.begin(), samples.end());
+    state.counters["p50"] = percentile(0.50);
+    state.counters["p95"] = percentile(0.95);
+    state.counters["p99"] = percentile(0.99);
+  }
+
+private:
+  double percentile(double p) {
+    size_t idx = (size_t)(p * (samples.size() - 1) + 0.5);
+    return samples[idx];
+  }
+
+  std::vector<double> samples;
+};
+
 /// Benchmark time of the compilation
 template <typename LambdaSupport>
 static void BM_Compile(benchmark::State &state, EndToEndDesc description,
                        LambdaSupport support,
                        mlir::concretelang::CompilationOptions options) {
+  LatencyPercentiles latencies;
   for (auto _ : state) {
+    auto begin = std::chrono::steady_clock::now();
     if (support.compile(description.program, options)) {
     };
+    latencies.record(begin);
   }
+  latencies.report(state);
 }
 
-/// Benchmark time of the key generation
+/// Benchmark time of the key generation. `cache` distinguishes the cold
+/// path (no cache, keys generated from scratch) from the warm path (keys
+/// loaded back from the test key set cache).
 template <typename LambdaSupport>
 static void BM_KeyGen(benchmark::State &state, EndToEndDesc description,
                       LambdaSupport support,
-                      mlir::concretelang::CompilationOptions options) {
+                      mlir::concretelang::CompilationOptions options,
+                      std::optional<concretelang::clientlib::KeySetCache>
+                          cache = std::nullopt) {
   auto compilationResult = support.compile(description.program, options);
   check(compilationResult);
 
   auto clientParameters = support.loadClientParameters(**compilationResult);
   check(clientParameters);
 
+  // Warm the cache up so the first measured iteration loads instead of
+  // generating.
+  if (cache.has_value()) {
+    check(support.keySet(*clientParameters, cache));
+  }
+
+  LatencyPercentiles latencies;
   for (auto _ : state) {
-    check(support.keySet(*clientParameters, std::nullopt));
+    auto begin = std::chrono::steady_clock::now();
+    check(support.keySet(*clientParameters, cache));
+    latencies.record(begin);
   }
+  latencies.report(state);
 }
 
 /// Benchmark time of the encryption
@@ -63,9 +113,13 @@ static void BM_ExportArguments(benchmark::State &state,
     inputArguments.push_back(&input.getValue());
   }
 
+  LatencyPercentiles latencies;
   for (auto _ : state) {
+    auto begin = std::chrono::steady_clock::now();
     check(support.exportArguments(*clientParameters, **keySet, inputArguments));
+    latencies.record(begin);
   }
+  latencies.report(state);
 }
 
 /// Benchmark time of the program evaluation
@@ -81,13 +135,10 @@ static void BM_Evaluate(benchmark::State &state, EndToEndDesc description,
   check(keySet);
   assert(description.tests.size() > 0);
   auto test = description.tests[0];
-  std::vector<const mlir::concretelang::LambdaArgument *> inputArguments;
-  inputArguments.reserve(test.inputs.size());
-  for (auto input : test.inputs) {
-    inputArguments.push_back(&input.getValue());
-  }
-  auto publicArguments =
-      support.exportArguments(*clientParameters, **keySet, inputArguments);
+  // Replay recorded arguments when available, so successive runs only
+  // spend setup time on compilation and the cached key set.
+  auto publicArguments = loadOrRecordArguments(
+      description, test, *clientParameters, **keySet, getArgumentsCacheDir());
   check(publicArguments);
 
   auto serverLambda = support.loadServerLambda(**compilationResult);
@@ -97,9 +148,13 @@ static void BM_Evaluate(benchmark::State &state, EndToEndDesc description,
   // Warmup
   assert(support.serverCall(*serverLambda, **publicArguments, evaluationKeys));
 
+  LatencyPercentiles latencies;
   for (auto _ : state) {
+    auto begin = std::chrono::steady_clock::now();
     check(support.serverCall(*serverLambda, **publicArguments, evaluationKeys));
+    latencies.record(begin);
   }
+  latencies.report(state);
 }
 
 enum Action {
@@ -123,6 +178,9 @@ void registerEndToEndBenchmark(std::string suiteName,
     }
     options.optimizerConfig.encoding = description.encoding;
     mlir::concretelang::JITSupport support;
+    // Stable naming scheme: suite/phase/options/case, where `case` is the
+    // EndToEndDesc description. Dashboards key on these names across
+    // commits, do not reorder the components.
     auto benchName = [&](std::string name) {
       std::ostringstream s;
       s << suiteName << "/" << name << "/" << optionsName << "/"
@@ -139,8 +197,13 @@ void registerEndToEndBenchmark(std::string suiteName,
         break;
       case Action::KEYGEN:
         benchmark::RegisterBenchmark(
-            benchName("keygen").c_str(), [=](::benchmark::State &st) {
-              BM_KeyGen(st, description, support, options);
+            benchName("keygen_cold").c_str(), [=](::benchmark::State &st) {
+              BM_KeyGen(st, description, support, options, std::nullopt);
+            });
+        benchmark::RegisterBenchmark(
+            benchName("keygen_warm").c_str(), [=](::benchmark::State &st) {
+              BM_KeyGen(st, description, support, options,
+                        getTestKeySetCache());
             });
         break;
       case Action::ENCRYPT:
@@ -161,6 +224,42 @@ void registerEndToEndBenchmark(std::string suiteName,
   setCurrentStackLimit(stackSizeRequirement);
 }
 
+/// Console reporter that additionally collects every run and writes them
+/// out as a JSON array on shutdown, one object per benchmark with the
+/// stable name, iteration count, mean times and the percentile counters.
+/// This is the machine-readable output tracked by the dashboards.
+class JSONExportReporter : public benchmark::ConsoleReporter {
+public:
+  JSONExportReporter(std::string path) : path(path) {}
+
+  void ReportRuns(const std::vector<Run> &report) override {
+    benchmark::ConsoleReporter::ReportRuns(report);
+    runs.insert(runs.end(), report.begin(), report.end());
+  }
+
+  void Finalize() override {
+    benchmark::ConsoleReporter::Finalize();
+    std::ofstream out(path);
+    out << "[\n";
+    for (size_t i = 0; i < runs.size(); i++) {
+      auto &run = runs[i];
+      out << "  {\"name\": \"" << run.benchmark_name() << "\""
+          << ", \"iterations\": " << run.iterations
+          << ", \"real_time_ns\": " << run.GetAdjustedRealTime()
+          << ", \"cpu_time_ns\": " << run.GetAdjustedCPUTime();
+      for (auto &counter : run.counters) {
+        out << ", \"" << counter.first << "_ns\": " << counter.second.value;
+      }
+      out << "}" << ((i + 1 < runs.size()) ? "," : "") << "\n";
+    }
+    out << "]\n";
+  }
+
+private:
+  std::string path;
+  std::vector<Run> runs;
+};
+
 int main(int argc, char **argv) {
   // Parse google benchmark options
   ::benchmark::Initialize(&argc, argv);
@@ -177,6 +276,11 @@ int main(int argc, char **argv) {
       llvm::cl::values(
           clEnumValN(Action::EVALUATE, "evaluate", "Run evaluate benchmark")));
 
+  llvm::cl::opt<std::string> clJsonOut(
+      "json-out",
+      llvm::cl::desc("Write benchmark results as JSON to the given file"),
+      llvm::cl::init(""));
+
   // parse end to end test compiler options
   auto options = parseEndToEndCommandLine(argc, argv);
 
@@ -197,7 +301,12 @@ int main(int argc, char **argv) {
                               compilationOptions, actions,
                               stackSizeRequirement);
   }
-  ::benchmark::RunSpecifiedBenchmarks();
+  if (clJsonOut.empty()) {
+    ::benchmark::RunSpecifiedBenchmarks();
+  } else {
+    JSONExportReporter reporter(clJsonOut);
+    ::benchmark::RunSpecifiedBenchmarks(&reporter);
+  }
   ::benchmark::Shutdown();
   return 0;
 }
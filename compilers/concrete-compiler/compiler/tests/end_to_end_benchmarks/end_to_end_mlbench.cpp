@@ -78,14 +78,10 @@ static void BM_Evaluate(benchmark::State &state, EndToEndDesc description,
 
   assert(description.tests.size() > 0);
   auto test = description.tests[0];
-  std::vector<const mlir::concretelang::LambdaArgument *> inputArguments;
-  inputArguments.reserve(test.inputs.size());
-  for (auto input : test.inputs) {
-    inputArguments.push_back(&input.getValue());
-  }
-
-  auto publicArguments =
-      support.exportArguments(*clientParameters, **keySet, inputArguments);
+  // Replay recorded arguments when available, so successive runs only
+  // spend setup time on compilation and the cached key set.
+  auto publicArguments = loadOrRecordArguments(
+      description, test, *clientParameters, **keySet, getArgumentsCacheDir());
   assert(publicArguments);
 
   auto serverLambda = support.loadServerLambda(**compilationResult);
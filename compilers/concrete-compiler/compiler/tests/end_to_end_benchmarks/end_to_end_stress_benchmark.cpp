@@ -0,0 +1,214 @@
+#include "../end_to_end_tests/end_to_end_test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define BENCHMARK_HAS_CXX11
+#include "llvm/Support/Path.h"
+
+#include "tests_tools/StackSize.h"
+#include "tests_tools/keySetCache.h"
+
+#define check(expr)                                                           \
+  if (auto E = expr.takeError()) {                                            \
+    std::cerr << "Error: " << llvm::toString(std::move(E)) << "\n";           \
+    assert(false && "See error above");                                       \
+  }
+
+/// Multi-client concurrency stress benchmark for ServerLambda.
+///
+/// The end_to_end_benchmark harness measures each phase from a single
+/// thread; this binary measures the regime a gateway actually runs in:
+/// N client threads issuing requests against one shared ServerLambda,
+/// one shared set of evaluation keys and therefore one shared
+/// RuntimeContext. For every thread count (doubling up to --max-threads)
+/// it reports the aggregate throughput and the latency percentiles over
+/// all requests, so contention on the runtime allocator or GPU streams
+/// shows up as throughput that stops scaling and tail latencies that
+/// grow.
+
+namespace {
+
+struct StressResult {
+  std::string name;
+  size_t threads;
+  size_t requests;
+  double throughput;
+  double p50;
+  double p95;
+  double p99;
+};
+
+double percentile(const std::vector<double> &sorted, double p) {
+  size_t idx = (size_t)(p * (sorted.size() - 1) + 0.5);
+  return sorted[idx];
+}
+
+template <typename LambdaSupport>
+StressResult stressCase(std::string name, EndToEndDesc description,
+                        LambdaSupport support,
+                        mlir::concretelang::CompilationOptions options,
+                        size_t numThreads, size_t requestsPerThread) {
+  auto compilationResult = support.compile(description.program, options);
+  check(compilationResult);
+  auto clientParameters = support.loadClientParameters(**compilationResult);
+  check(clientParameters);
+  auto keySet = support.keySet(*clientParameters, getTestKeySetCache());
+  check(keySet);
+  auto serverLambda = support.loadServerLambda(**compilationResult);
+  check(serverLambda);
+  auto evaluationKeys = (*keySet)->evaluationKeys();
+
+  assert(description.tests.size() > 0);
+  auto test = description.tests[0];
+  std::vector<const mlir::concretelang::LambdaArgument *> inputArguments;
+  inputArguments.reserve(test.inputs.size());
+  for (auto &input : test.inputs) {
+    inputArguments.push_back(&input.getValue());
+  }
+
+  // Each client gets its own exported arguments, as real clients would,
+  // while the lambda, keys and runtime context stay shared.
+  std::vector<std::unique_ptr<concretelang::clientlib::PublicArguments>>
+      arguments;
+  for (size_t t = 0; t < numThreads; t++) {
+    auto publicArguments =
+        support.exportArguments(*clientParameters, **keySet, inputArguments);
+    check(publicArguments);
+    arguments.push_back(std::move(*publicArguments));
+  }
+
+  // Warmup from a single thread so one-time lazy initialization does not
+  // end up in the measurements.
+  check(support.serverCall(*serverLambda, *arguments[0], evaluationKeys));
+
+  std::vector<std::vector<double>> latencies(numThreads);
+  std::atomic<bool> start = {false};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; t++) {
+    latencies[t].reserve(requestsPerThread);
+    threads.push_back(std::thread([&, t]() {
+      while (!start.load())
+        std::this_thread::yield();
+      for (size_t r = 0; r < requestsPerThread; r++) {
+        auto begin = std::chrono::steady_clock::now();
+        check(support.serverCall(*serverLambda, *arguments[t],
+                                 evaluationKeys));
+        latencies[t].push_back(std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - begin)
+                                   .count());
+      }
+    }));
+  }
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+          .count();
+
+  std::vector<double> all;
+  for (auto &perThread : latencies) {
+    all.insert(all.end(), perThread.begin(), perThread.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  StressResult result;
+  result.name = name;
+  result.threads = numThreads;
+  result.requests = all.size();
+  result.throughput = all.size() / elapsed;
+  result.p50 = percentile(all, 0.50);
+  result.p95 = percentile(all, 0.95);
+  result.p99 = percentile(all, 0.99);
+  return result;
+}
+
+void printResult(const StressResult &result) {
+  std::cout << result.name << " threads=" << result.threads
+            << " requests=" << result.requests << " throughput="
+            << result.throughput << "req/s p50=" << result.p50 * 1e3
+            << "ms p95=" << result.p95 * 1e3
+            << "ms p99=" << result.p99 * 1e3 << "ms\n"
+            << std::flush;
+}
+
+void writeJson(const std::vector<StressResult> &results, std::string path) {
+  std::ofstream out(path);
+  out << "[\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    auto &result = results[i];
+    out << "  {\"name\": \"" << result.name << "\""
+        << ", \"threads\": " << result.threads
+        << ", \"requests\": " << result.requests
+        << ", \"throughput_req_per_s\": " << result.throughput
+        << ", \"p50_s\": " << result.p50 << ", \"p95_s\": " << result.p95
+        << ", \"p99_s\": " << result.p99 << "}"
+        << ((i + 1 < results.size()) ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::cl::opt<size_t> clMaxThreads(
+      "max-threads",
+      llvm::cl::desc("Highest client thread count to stress (doubling from 1)"),
+      llvm::cl::init(128));
+  llvm::cl::opt<size_t> clRequestsPerThread(
+      "requests-per-thread",
+      llvm::cl::desc("Number of requests each client thread issues"),
+      llvm::cl::init(16));
+  llvm::cl::opt<std::string> clJsonOut(
+      "json-out",
+      llvm::cl::desc("Write stress results as JSON to the given file"),
+      llvm::cl::init(""));
+
+  auto options = parseEndToEndCommandLine(argc, argv);
+
+  auto compilationOptions = std::get<0>(options);
+  auto descriptionFiles = std::get<2>(options);
+
+  std::vector<StressResult> results;
+  for (auto descFile : descriptionFiles) {
+    auto suiteName = llvm::sys::path::stem(descFile.path).str();
+    auto optionsName = getOptionsName(compilationOptions);
+    for (auto description : descFile.descriptions) {
+      auto caseOptions = compilationOptions;
+      caseOptions.clientParametersFuncName = "main";
+      if (description.p_error) {
+        assert(std::isnan(caseOptions.optimizerConfig.global_p_error));
+        caseOptions.optimizerConfig.p_error = description.p_error.value();
+      }
+      caseOptions.optimizerConfig.encoding = description.encoding;
+      mlir::concretelang::JITSupport support;
+
+      // Same stable naming scheme as end_to_end_benchmark:
+      // suite/phase/options/case.
+      std::ostringstream name;
+      name << suiteName << "/stress/" << optionsName << "/"
+           << description.description;
+
+      for (size_t numThreads = 1; numThreads <= clMaxThreads;
+           numThreads *= 2) {
+        auto result = stressCase(name.str(), description, support, caseOptions,
+                                 numThreads, clRequestsPerThread);
+        printResult(result);
+        results.push_back(result);
+      }
+    }
+  }
+  if (!clJsonOut.empty()) {
+    writeJson(results, clJsonOut);
+  }
+  return 0;
+}
@@ -0,0 +1,235 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "concrete/curves.h"
+#include "concretelang/ClientLib/KeySet.h"
+#include "concretelang/Runtime/wrappers.h"
+
+namespace clientlib = concretelang::clientlib;
+
+/// One-time calibration for the per-op GPU/CPU placement of the
+/// Conversion/ConcreteToCAPI lowering: measures keyswitch and bootstrap on
+/// both backends across the production parameter grid and writes the
+/// placement table the compiler consumes through the
+/// CONCRETE_PLACEMENT_TABLE environment variable. The single-ciphertext
+/// entry points are measured, which is the worst case for the GPU since
+/// nothing amortizes the host-device round trip. In a build without CUDA
+/// support every entry is placed on the CPU, recording the measurement
+/// honestly for the machine the table was calibrated on.
+
+namespace {
+
+struct CalibrationParameters {
+  const char *name;
+  uint64_t inputLweDimension;
+  uint64_t glweDimension;
+  uint64_t polynomialSize;
+  uint64_t ksLevel;
+  uint64_t ksBaseLog;
+  uint64_t bsLevel;
+  uint64_t bsBaseLog;
+};
+
+/// The (small lwe dimension, glwe dimension, polynomial size, decomposition)
+/// combinations the optimizer picks for our production precisions.
+const CalibrationParameters parameterGrid[] = {
+    {"n=586_k=1_N=512_ks(2,5)_bs(2,8)", 586, 1, 512, 2, 5, 2, 8},
+    {"n=744_k=1_N=2048_ks(3,4)_bs(1,23)", 744, 1, 2048, 3, 4, 1, 23},
+    {"n=902_k=1_N=8192_ks(4,3)_bs(1,22)", 902, 1, 8192, 4, 3, 1, 22},
+};
+
+/// Returns the RuntimeContext for the given parameters, generating the keys
+/// once per parameter set and caching them for the lifetime of the process.
+mlir::concretelang::RuntimeContext *
+getContext(const CalibrationParameters &params) {
+  static std::map<std::string,
+                  std::unique_ptr<mlir::concretelang::RuntimeContext>>
+      contexts;
+  auto it = contexts.find(params.name);
+  if (it != contexts.end()) {
+    return it->second.get();
+  }
+  const auto v0Curve = concrete::getSecurityCurve(128, concrete::BINARY);
+  uint64_t bigLweDimension = params.glweDimension * params.polynomialSize;
+
+  clientlib::ClientParameters clientParameters;
+  // BIG_KEY then SMALL_KEY, the IDs are positional
+  clientParameters.secretKeys.push_back({/*.dimension =*/bigLweDimension});
+  clientParameters.secretKeys.push_back(
+      {/*.dimension =*/params.inputLweDimension});
+
+  clientlib::BootstrapKeyParam bsk;
+  bsk.inputSecretKeyID = clientlib::SMALL_KEY;
+  bsk.outputSecretKeyID = clientlib::BIG_KEY;
+  bsk.level = params.bsLevel;
+  bsk.baseLog = params.bsBaseLog;
+  bsk.glweDimension = params.glweDimension;
+  bsk.variance =
+      v0Curve->getVariance(params.glweDimension, params.polynomialSize, 64);
+  bsk.polynomialSize = params.polynomialSize;
+  bsk.inputLweDimension = params.inputLweDimension;
+  clientParameters.bootstrapKeys.push_back(bsk);
+
+  clientlib::KeyswitchKeyParam ksk;
+  ksk.inputSecretKeyID = clientlib::BIG_KEY;
+  ksk.outputSecretKeyID = clientlib::SMALL_KEY;
+  ksk.level = params.ksLevel;
+  ksk.baseLog = params.ksBaseLog;
+  ksk.variance = v0Curve->getVariance(1, params.inputLweDimension, 64);
+  clientParameters.keyswitchKeys.push_back(ksk);
+
+  auto keySet = clientlib::KeySet::generate(clientParameters,
+                                            clientlib::ConcreteCSPRNG(0));
+  assert(keySet.has_value() && "key generation failed");
+  auto context = std::make_unique<mlir::concretelang::RuntimeContext>(
+      (*keySet)->evaluationKeys());
+  auto inserted = contexts.emplace(params.name, std::move(context));
+  return inserted.first->second.get();
+}
+
+/// Best-of-five average latency of `fn` in seconds: one warm-up call, then
+/// five timed runs of `iterations` calls each, keeping the fastest run to
+/// filter out scheduling noise.
+template <typename Fn> double measure(Fn fn, size_t iterations) {
+  fn();
+  double best = 0;
+  for (int run = 0; run < 5; run++) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      fn();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count() /
+                     (double)iterations;
+    if (run == 0 || seconds < best) {
+      best = seconds;
+    }
+  }
+  return best;
+}
+
+double measureKeyswitchCpu(const CalibrationParameters &params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.glweDimension * params.polynomialSize + 1;
+  uint64_t outSize = params.inputLweDimension + 1;
+  std::vector<uint64_t> in(inSize);
+  std::vector<uint64_t> out(outSize);
+  return measure(
+      [&]() {
+        memref_keyswitch_lwe_u64(out.data(), out.data(), 0, outSize, 1,
+                                 in.data(), in.data(), 0, inSize, 1,
+                                 params.ksLevel, params.ksBaseLog, inSize - 1,
+                                 outSize - 1, 0, context);
+      },
+      100);
+}
+
+double measureBootstrapCpu(const CalibrationParameters &params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.inputLweDimension + 1;
+  uint64_t outSize = params.glweDimension * params.polynomialSize + 1;
+  std::vector<uint64_t> in(inSize);
+  std::vector<uint64_t> out(outSize);
+  std::vector<uint64_t> tlu(params.polynomialSize);
+  return measure(
+      [&]() {
+        memref_bootstrap_lwe_u64(out.data(), out.data(), 0, outSize, 1,
+                                 in.data(), in.data(), 0, inSize, 1, tlu.data(),
+                                 tlu.data(), 0, tlu.size(), 1,
+                                 params.inputLweDimension,
+                                 params.polynomialSize, params.bsLevel,
+                                 params.bsBaseLog, params.glweDimension, 0,
+                                 context);
+      },
+      20);
+}
+
+#ifdef CONCRETELANG_CUDA_SUPPORT
+double measureKeyswitchGpu(const CalibrationParameters &params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.glweDimension * params.polynomialSize + 1;
+  uint64_t outSize = params.inputLweDimension + 1;
+  std::vector<uint64_t> in(inSize);
+  std::vector<uint64_t> out(outSize);
+  return measure(
+      [&]() {
+        memref_keyswitch_lwe_cuda_u64(out.data(), out.data(), 0, outSize, 1,
+                                      in.data(), in.data(), 0, inSize, 1,
+                                      params.ksLevel, params.ksBaseLog,
+                                      inSize - 1, outSize - 1, 0, context);
+      },
+      100);
+}
+
+double measureBootstrapGpu(const CalibrationParameters &params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.inputLweDimension + 1;
+  uint64_t outSize = params.glweDimension * params.polynomialSize + 1;
+  std::vector<uint64_t> in(inSize);
+  std::vector<uint64_t> out(outSize);
+  std::vector<uint64_t> tlu(params.polynomialSize);
+  return measure(
+      [&]() {
+        memref_bootstrap_lwe_cuda_u64(out.data(), out.data(), 0, outSize, 1,
+                                      in.data(), in.data(), 0, inSize, 1,
+                                      tlu.data(), tlu.data(), 0, tlu.size(), 1,
+                                      params.inputLweDimension,
+                                      params.polynomialSize, params.bsLevel,
+                                      params.bsBaseLog, params.glweDimension,
+                                      0, context);
+      },
+      20);
+}
+#endif
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *outputPath =
+      argc > 1 ? argv[1] : "concrete-placement-table.txt";
+  FILE *output = fopen(outputPath, "w");
+  if (output == nullptr) {
+    fprintf(stderr, "cannot open %s for writing\n", outputPath);
+    return 1;
+  }
+  fprintf(output, "concrete-placement-table v1\n");
+
+  for (auto params : parameterGrid) {
+    fprintf(stderr, "calibrating %s\n", params.name);
+    double ksCpu = measureKeyswitchCpu(params);
+    double bsCpu = measureBootstrapCpu(params);
+#ifdef CONCRETELANG_CUDA_SUPPORT
+    double ksGpu = measureKeyswitchGpu(params);
+    double bsGpu = measureBootstrapGpu(params);
+#else
+    double ksGpu = -1;
+    double bsGpu = -1;
+#endif
+    bool ksOnGpu = ksGpu >= 0 && ksGpu < ksCpu;
+    bool bsOnGpu = bsGpu >= 0 && bsGpu < bsCpu;
+    fprintf(stderr, "  keyswitch cpu=%gs gpu=%gs -> %s\n", ksCpu, ksGpu,
+            ksOnGpu ? "gpu" : "cpu");
+    fprintf(stderr, "  bootstrap cpu=%gs gpu=%gs -> %s\n", bsCpu, bsGpu,
+            bsOnGpu ? "gpu" : "cpu");
+
+    uint64_t bigLweDimension = params.glweDimension * params.polynomialSize;
+    fprintf(output,
+            "keyswitch level=%lu base_log=%lu lwe_dim_in=%lu lwe_dim_out=%lu "
+            "backend=%s\n",
+            params.ksLevel, params.ksBaseLog, bigLweDimension,
+            params.inputLweDimension, ksOnGpu ? "gpu" : "cpu");
+    fprintf(output,
+            "bootstrap poly_size=%lu glwe_dim=%lu level=%lu backend=%s\n",
+            params.polynomialSize, params.glweDimension, params.bsLevel,
+            bsOnGpu ? "gpu" : "cpu");
+  }
+
+  fclose(output);
+  fprintf(stderr, "placement table written to %s\n", outputPath);
+  return 0;
+}
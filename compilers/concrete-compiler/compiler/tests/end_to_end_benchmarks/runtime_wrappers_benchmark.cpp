@@ -0,0 +1,208 @@
+#include <benchmark/benchmark.h>
+
+#include <cassert>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "concrete/curves.h"
+#include "concretelang/ClientLib/KeySet.h"
+#include "concretelang/Runtime/wrappers.h"
+
+namespace clientlib = concretelang::clientlib;
+
+/// Microbenchmarks for the runtime wrapper primitives, isolated from
+/// compilation and key material setup. Each benchmark calls one wrapper of
+/// lib/Runtime/wrappers.cpp directly over the production parameter grid
+/// below, so a regression in these hot functions can be bisected at the
+/// runtime level instead of showing up as end-to-end noise.
+
+namespace {
+
+struct WrapperParameters {
+  const char *name;
+  uint64_t inputLweDimension;
+  uint64_t glweDimension;
+  uint64_t polynomialSize;
+  uint64_t ksLevel;
+  uint64_t ksBaseLog;
+  uint64_t bsLevel;
+  uint64_t bsBaseLog;
+};
+
+/// The (small lwe dimension, glwe dimension, polynomial size, decomposition)
+/// combinations the optimizer picks for our production precisions.
+const WrapperParameters parameterGrid[] = {
+    {"n=586_k=1_N=512_ks(2,5)_bs(2,8)", 586, 1, 512, 2, 5, 2, 8},
+    {"n=744_k=1_N=2048_ks(3,4)_bs(1,23)", 744, 1, 2048, 3, 4, 1, 23},
+    {"n=902_k=1_N=8192_ks(4,3)_bs(1,22)", 902, 1, 8192, 4, 3, 1, 22},
+};
+
+/// Batch size used by the batched wrapper benchmarks.
+constexpr uint64_t batchSize = 64;
+
+/// Returns the RuntimeContext for the given parameters, generating the keys
+/// once per parameter set and caching them for the lifetime of the process.
+mlir::concretelang::RuntimeContext *
+getContext(const WrapperParameters &params) {
+  static std::map<std::string,
+                  std::unique_ptr<mlir::concretelang::RuntimeContext>>
+      contexts;
+  auto it = contexts.find(params.name);
+  if (it != contexts.end()) {
+    return it->second.get();
+  }
+  const auto v0Curve = concrete::getSecurityCurve(128, concrete::BINARY);
+  uint64_t bigLweDimension = params.glweDimension * params.polynomialSize;
+
+  clientlib::ClientParameters clientParameters;
+  // BIG_KEY then SMALL_KEY, the IDs are positional
+  clientParameters.secretKeys.push_back({/*.dimension =*/bigLweDimension});
+  clientParameters.secretKeys.push_back(
+      {/*.dimension =*/params.inputLweDimension});
+
+  clientlib::BootstrapKeyParam bsk;
+  bsk.inputSecretKeyID = clientlib::SMALL_KEY;
+  bsk.outputSecretKeyID = clientlib::BIG_KEY;
+  bsk.level = params.bsLevel;
+  bsk.baseLog = params.bsBaseLog;
+  bsk.glweDimension = params.glweDimension;
+  bsk.variance =
+      v0Curve->getVariance(params.glweDimension, params.polynomialSize, 64);
+  bsk.polynomialSize = params.polynomialSize;
+  bsk.inputLweDimension = params.inputLweDimension;
+  clientParameters.bootstrapKeys.push_back(bsk);
+
+  clientlib::KeyswitchKeyParam ksk;
+  ksk.inputSecretKeyID = clientlib::BIG_KEY;
+  ksk.outputSecretKeyID = clientlib::SMALL_KEY;
+  ksk.level = params.ksLevel;
+  ksk.baseLog = params.ksBaseLog;
+  ksk.variance = v0Curve->getVariance(1, params.inputLweDimension, 64);
+  clientParameters.keyswitchKeys.push_back(ksk);
+
+  auto keySet = clientlib::KeySet::generate(clientParameters,
+                                            clientlib::ConcreteCSPRNG(0));
+  assert(keySet.has_value() && "key generation failed");
+  auto context = std::make_unique<mlir::concretelang::RuntimeContext>(
+      (*keySet)->evaluationKeys());
+  auto inserted = contexts.emplace(params.name, std::move(context));
+  return inserted.first->second.get();
+}
+
+void BM_EncodeExpandLutForBootstrap(benchmark::State &state,
+                                    uint64_t polySize) {
+  constexpr uint32_t messageBits = 4;
+  std::vector<uint64_t> out(polySize);
+  std::vector<uint64_t> lut(1 << messageBits);
+  for (auto _ : state) {
+    memref_encode_expand_lut_for_bootstrap(
+        out.data(), out.data(), 0, out.size(), 1, lut.data(), lut.data(), 0,
+        lut.size(), 1, polySize, messageBits, false);
+  }
+}
+
+void BM_KeyswitchLwe(benchmark::State &state, WrapperParameters params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.glweDimension * params.polynomialSize + 1;
+  uint64_t outSize = params.inputLweDimension + 1;
+  std::vector<uint64_t> in(inSize);
+  std::vector<uint64_t> out(outSize);
+  for (auto _ : state) {
+    memref_keyswitch_lwe_u64(out.data(), out.data(), 0, outSize, 1, in.data(),
+                             in.data(), 0, inSize, 1, params.ksLevel,
+                             params.ksBaseLog, inSize - 1, outSize - 1, 0,
+                             context);
+  }
+}
+
+void BM_BatchedKeyswitchLwe(benchmark::State &state,
+                            WrapperParameters params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.glweDimension * params.polynomialSize + 1;
+  uint64_t outSize = params.inputLweDimension + 1;
+  std::vector<uint64_t> in(batchSize * inSize);
+  std::vector<uint64_t> out(batchSize * outSize);
+  for (auto _ : state) {
+    memref_batched_keyswitch_lwe_u64(
+        out.data(), out.data(), 0, batchSize, outSize, outSize, 1, in.data(),
+        in.data(), 0, batchSize, inSize, inSize, 1, params.ksLevel,
+        params.ksBaseLog, inSize - 1, outSize - 1, 0, context);
+  }
+}
+
+void BM_BootstrapLwe(benchmark::State &state, WrapperParameters params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.inputLweDimension + 1;
+  uint64_t outSize = params.glweDimension * params.polynomialSize + 1;
+  std::vector<uint64_t> in(inSize);
+  std::vector<uint64_t> out(outSize);
+  std::vector<uint64_t> tlu(params.polynomialSize);
+  for (auto _ : state) {
+    memref_bootstrap_lwe_u64(out.data(), out.data(), 0, outSize, 1, in.data(),
+                             in.data(), 0, inSize, 1, tlu.data(), tlu.data(),
+                             0, tlu.size(), 1, params.inputLweDimension,
+                             params.polynomialSize, params.bsLevel,
+                             params.bsBaseLog, params.glweDimension, 0,
+                             context);
+  }
+}
+
+void BM_BatchedBootstrapLwe(benchmark::State &state,
+                            WrapperParameters params) {
+  auto context = getContext(params);
+  uint64_t inSize = params.inputLweDimension + 1;
+  uint64_t outSize = params.glweDimension * params.polynomialSize + 1;
+  std::vector<uint64_t> in(batchSize * inSize);
+  std::vector<uint64_t> out(batchSize * outSize);
+  std::vector<uint64_t> tlu(params.polynomialSize);
+  for (auto _ : state) {
+    memref_batched_bootstrap_lwe_u64(
+        out.data(), out.data(), 0, batchSize, outSize, outSize, 1, in.data(),
+        in.data(), 0, batchSize, inSize, inSize, 1, tlu.data(), tlu.data(), 0,
+        tlu.size(), 1, params.inputLweDimension, params.polynomialSize,
+        params.bsLevel, params.bsBaseLog, params.glweDimension, 0, context);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+
+  for (auto polySize : {512, 1024, 2048, 4096, 8192}) {
+    benchmark::RegisterBenchmark(
+        ("wrappers/encode_expand_lut/N=" + std::to_string(polySize)).c_str(),
+        [=](benchmark::State &st) {
+          BM_EncodeExpandLutForBootstrap(st, polySize);
+        });
+  }
+  for (auto params : parameterGrid) {
+    std::string suffix = params.name;
+    benchmark::RegisterBenchmark(
+        ("wrappers/keyswitch/" + suffix).c_str(),
+        [=](benchmark::State &st) { BM_KeyswitchLwe(st, params); })
+        ->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(
+        ("wrappers/batched_keyswitch/" + suffix + "/batch=" +
+         std::to_string(batchSize))
+            .c_str(),
+        [=](benchmark::State &st) { BM_BatchedKeyswitchLwe(st, params); })
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(
+        ("wrappers/bootstrap/" + suffix).c_str(),
+        [=](benchmark::State &st) { BM_BootstrapLwe(st, params); })
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(
+        ("wrappers/batched_bootstrap/" + suffix + "/batch=" +
+         std::to_string(batchSize))
+            .c_str(),
+        [=](benchmark::State &st) { BM_BatchedBootstrapLwe(st, params); })
+        ->Unit(benchmark::kMillisecond);
+  }
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
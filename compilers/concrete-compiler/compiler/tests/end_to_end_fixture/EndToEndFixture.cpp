@@ -1,8 +1,13 @@
+#include <algorithm>
+#include <cctype>
 #include <cmath>
 
 #include "EndToEndFixture.h"
 #include "concretelang/Support/CompilerEngine.h"
 #include "concretelang/Support/Jit.h"
+#include "concretelang/Support/LambdaSupport.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/YAMLTraits.h"
 
@@ -380,3 +385,65 @@ std::vector<EndToEndDesc> loadEndToEndDesc(std::string path) {
   }
   return desc;
 }
+
+std::string getArgumentsCacheDir() {
+  llvm::SmallString<0> cachePath;
+  llvm::sys::path::system_temp_directory(true, cachePath);
+  llvm::sys::path::append(cachePath, "ArgumentsCache");
+  return std::string(cachePath);
+}
+
+llvm::Expected<std::unique_ptr<concretelang::clientlib::PublicArguments>>
+loadOrRecordArguments(
+    const EndToEndDesc &desc, const TestDescription &test,
+    concretelang::clientlib::ClientParameters clientParameters,
+    concretelang::clientlib::KeySet &keySet, std::string cacheDir) {
+  // Cache entries are keyed by the description name and the client
+  // parameters hash, so a recompiled circuit never replays ciphertexts
+  // recorded for other parameters.
+  std::string name = desc.description;
+  std::replace_if(
+      name.begin(), name.end(),
+      [](unsigned char c) { return !std::isalnum(c); }, '_');
+  llvm::SmallString<0> path(cacheDir);
+  llvm::sys::path::append(path, name + "_" +
+                                    std::to_string(clientParameters.hash()) +
+                                    ".args");
+  auto pathStr = std::string(path);
+
+  if (llvm::sys::fs::exists(path)) {
+    std::ifstream istream(pathStr, std::ios::binary);
+    auto args = concretelang::clientlib::PublicArguments::unserialize(
+        clientParameters, istream);
+    if (!args.has_error()) {
+      return std::move(args.value());
+    }
+    // Unreadable or truncated recording: fall through and re-encrypt.
+  }
+
+  std::vector<const mlir::concretelang::LambdaArgument *> inputArguments;
+  inputArguments.reserve(test.inputs.size());
+  for (auto &input : test.inputs) {
+    inputArguments.push_back(&input.getValue());
+  }
+
+  auto publicArguments =
+      mlir::concretelang::LambdaArgumentAdaptor::exportArguments(
+          inputArguments, clientParameters, keySet);
+  if (auto err = publicArguments.takeError()) {
+    return std::move(err);
+  }
+
+  // Recording is best effort: a failed write only costs the replay.
+  if (!llvm::sys::fs::create_directories(cacheDir)) {
+    std::ofstream ostream(pathStr, std::ios::binary);
+    if (ostream.good()) {
+      auto res = (*publicArguments)->serialize(ostream);
+      if (res.has_error()) {
+        ostream.close();
+        llvm::sys::fs::remove(path);
+      }
+    }
+  }
+  return publicArguments;
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include "concretelang/ClientLib/KeySet.h"
+#include "concretelang/ClientLib/PublicArguments.h"
 #include "concretelang/ClientLib/Types.h"
 #include "concretelang/Support/JITSupport.h"
 
@@ -69,4 +71,19 @@ llvm::Error checkResult(ValueDescription &desc,
 /// Unserialize from the given path a list of a end to end description file.
 std::vector<EndToEndDesc> loadEndToEndDesc(std::string path);
 
+/// Directory under the system temporary directory where encrypted
+/// arguments are recorded for replay, next to the key set cache.
+std::string getArgumentsCacheDir();
+
+/// Returns the public arguments for `test`, replayed from the arguments
+/// cache when a previous run recorded them for the same description and
+/// client parameters, freshly encrypted and recorded otherwise. Together
+/// with the key set cache this removes keygen and encryption from the
+/// setup of successive benchmark runs, so only evaluation is measured.
+llvm::Expected<std::unique_ptr<concretelang::clientlib::PublicArguments>>
+loadOrRecordArguments(
+    const EndToEndDesc &desc, const TestDescription &test,
+    concretelang::clientlib::ClientParameters clientParameters,
+    concretelang::clientlib::KeySet &keySet, std::string cacheDir);
+
 #endif
@@ -74,3 +74,64 @@ TEST(Support, client_parameters_json_serde) {
   auto parseResult = llvm::json::parse<clientlib::ClientParameters>(jsonStr);
   ASSERT_EXPECTED_VALUE(parseResult, params0);
 }
+
+TEST(Support, client_parameters_binary_serde) {
+  clientlib::ClientParameters params0;
+  params0.secretKeys.push_back({14});
+  params0.secretKeys.push_back({12});
+  params0.bootstrapKeys.push_back({
+      /*.inputSecretKeyID = */ clientlib::SMALL_KEY,
+      /*.outputSecretKeyID = */ clientlib::BIG_KEY,
+      /*.level = */ 1,
+      /*.baseLog = */ 2,
+      /*.glweDimension = */ 3,
+      /*.variance = */ 0.001,
+      /*.polynomialSize = */ 1024,
+      /*.inputLweDimension = */ 600,
+  });
+  params0.keyswitchKeys.push_back({
+      /*.inputSecretKeyID = */ clientlib::BIG_KEY,
+      /*.outputSecretKeyID = */ clientlib::SMALL_KEY,
+      /*.level = */ 1,
+      /*.baseLog = */ 2,
+      /*.variance = */ 3,
+  });
+  params0.inputs = {
+      {
+          /*.encryption = */ {
+              {clientlib::SMALL_KEY, 0.00, {4, {1, 2, 3, 4}, false}}},
+          /*.shape = */ {32, {1, 2, 3, 4}, 1 * 2 * 3 * 4, false},
+          /*.chunkInfo = */ clientlib::ChunkInfo{4, 3},
+      },
+  };
+  params0.outputs = {
+      {
+          /*.encryption = */ {
+              {clientlib::SMALL_KEY, 0.00, {5, {1, 2, 3, 4}, false}}},
+          /*.shape = */ {8, {4, 4, 4, 4}, 4 * 4 * 4 * 4, false},
+          /*.chunkInfo = */ std::nullopt,
+      },
+  };
+  params0.functionName = "main";
+  params0.hasKeyLiveness = true;
+  params0.usedSecretKeys = {0, 1};
+  params0.usedBootstrapKeys = {0};
+  params0.usedKeyswitchKeys = {0};
+
+  std::string path =
+      "client_parameters_binary_serde" + clientlib::CLIENT_PARAMETERS_BIN_EXT;
+  auto saved = clientlib::ClientParameters::saveBinary({params0}, path);
+  ASSERT_TRUE(saved.has_value());
+  auto loaded = clientlib::ClientParameters::loadBinary(path);
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_EQ(loaded.value().size(), (size_t)1);
+  auto &params1 = loaded.value()[0];
+  ASSERT_TRUE(params1 == params0);
+  ASSERT_EQ(params1.functionName, params0.functionName);
+  ASSERT_EQ(params1.packingKeyswitchKeys.size(),
+            params0.packingKeyswitchKeys.size());
+  ASSERT_TRUE(params1.hasKeyLiveness);
+  ASSERT_EQ(params1.usedSecretKeys, params0.usedSecretKeys);
+  ASSERT_TRUE(params1.inputs[0].chunkInfo.has_value());
+  ASSERT_EQ(params1.inputs[0].chunkInfo->width, (unsigned int)3);
+}
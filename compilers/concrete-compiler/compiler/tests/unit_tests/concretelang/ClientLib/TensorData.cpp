@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "concretelang/ClientLib/Types.h"
+
+namespace {
+using concretelang::clientlib::TensorData;
+
+TEST(TensorDataTest, slice_is_view) {
+  TensorData tensor(llvm::ArrayRef<size_t>{4, 3}, 64, false);
+  for (size_t i = 0; i < tensor.getNumElements(); i++)
+    tensor.getElementReference<uint64_t>(i) = i;
+
+  auto slice = tensor.slice(1, 3);
+
+  ASSERT_TRUE(slice.isBorrowed());
+  ASSERT_EQ(slice.getDimensions(), (std::vector<size_t>{2, 3}));
+  // A slice is a view over the original storage, not a copy
+  ASSERT_EQ(slice.getElementPointer<uint64_t>(0),
+            tensor.getElementPointer<uint64_t>(3));
+  for (size_t i = 0; i < slice.getNumElements(); i++)
+    ASSERT_EQ(slice.getElementValue<uint64_t>(i), i + 3);
+}
+
+TEST(TensorDataTest, split_covers_all_rows) {
+  TensorData tensor(llvm::ArrayRef<size_t>{7, 2}, 64, false);
+  for (size_t i = 0; i < tensor.getNumElements(); i++)
+    tensor.getElementReference<uint64_t>(i) = i;
+
+  auto chunks = tensor.split(3);
+
+  ASSERT_EQ(chunks.size(), (size_t)3);
+  // 7 rows over 3 chunks: the first chunk gets the extra row
+  ASSERT_EQ(chunks[0].getDimensions()[0], (size_t)3);
+  ASSERT_EQ(chunks[1].getDimensions()[0], (size_t)2);
+  ASSERT_EQ(chunks[2].getDimensions()[0], (size_t)2);
+  uint64_t expected = 0;
+  for (auto &chunk : chunks)
+    for (size_t i = 0; i < chunk.getNumElements(); i++)
+      ASSERT_EQ(chunk.getElementValue<uint64_t>(i), expected++);
+}
+
+} // namespace
@@ -382,6 +382,43 @@ func.func @extract(%arg0: tensor<3x!FHE.eint<7>>, %arg1: tensor<3x!FHE.eint<7>>)
                         "/call_2t_1s_with_header/fhecircuit-client.h"));
 }
 
+TEST(CompiledModule, call_1s_1s_memoized) {
+  std::string source = R"(
+func.func @main(%arg0: !FHE.eint<7>) -> !FHE.eint<7> {
+  return %arg0: !FHE.eint<7>
+}
+)";
+  namespace clientlib = concretelang::clientlib;
+  using MyLambda = clientlib::TypedClientLambda<scalar_out, scalar_in>;
+  std::string outputLib = outputLibFromThis(this->test_info_);
+  auto compiled = compile(outputLib, source);
+  std::string jsonPath = compiled.getClientParametersPath(outputLib);
+  auto cLambda_ = MyLambda::load("main", jsonPath);
+  ASSERT_TRUE(cLambda_.has_value());
+  auto cLambda = cLambda_.value();
+  auto sLambda_ = ServerLambda::load("main", outputLib);
+  ASSERT_TRUE(sLambda_);
+  auto sLambda = sLambda_.value();
+  auto keySet_ = cLambda.keySet(getTestKeySetCachePtr(), 0, 0);
+  ASSERT_TRUE(keySet_.has_value());
+  std::shared_ptr<KeySet> keySet = std::move(keySet_.value());
+  auto publicArguments_ = cLambda.publicArguments(5, *keySet);
+  ASSERT_TRUE(publicArguments_.has_value());
+  auto publicArguments = std::move(publicArguments_.value());
+  auto evaluationKeys = keySet->evaluationKeys();
+
+  auto first = sLambda.callMemoized(*publicArguments, evaluationKeys);
+  ASSERT_TRUE((bool)first);
+  auto second = sLambda.callMemoized(*publicArguments, evaluationKeys);
+  ASSERT_TRUE((bool)second);
+  // Same argument handles: the second call reuses the cached buffers
+  // instead of re-evaluating.
+  ASSERT_EQ((*first)->buffers[0].inner.get(), (*second)->buffers[0].inner.get());
+  auto decrypted = (*second)->asClearTextScalar<uint64_t>(*keySet, 0);
+  ASSERT_TRUE(decrypted.has_value());
+  ASSERT_EQ(decrypted.value(), (uint64_t)5);
+}
+
 TEST(DISABLED_CompiledModule, call_2s_1s_lookup_table) {
   std::string source = R"(
 func.func @main(%arg0: !FHE.eint<6>, %arg1: !FHE.eint<3>) -> !FHE.eint<6> {
@@ -0,0 +1,186 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+/// Turnkey evaluation profiler: drives a function of a compiled
+/// library through ServerLambda with the runtime trace enabled and
+/// emits one Chrome trace file (chrome://tracing, Perfetto) plus a
+/// per-operation summary for every invocation, answering "where did
+/// this invocation go?" without instrumenting the application. Inputs
+/// are generated (zeros encrypted under a fixed-seed keyset), so only
+/// the compiled artifacts directory is needed.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "llvm/Support/CommandLine.h"
+
+#include "concretelang/ClientLib/ClientParameters.h"
+#include "concretelang/ClientLib/EncryptedArguments.h"
+#include "concretelang/ClientLib/KeySet.h"
+#include "concretelang/ClientLib/KeySetCache.h"
+#include "concretelang/Runtime/runtime_stats.h"
+#include "concretelang/Runtime/runtime_trace.h"
+#include "concretelang/ServerLib/ServerLambda.h"
+#include "concretelang/Support/CompilerEngine.h"
+
+namespace clientlib = concretelang::clientlib;
+namespace serverlib = concretelang::serverlib;
+
+namespace cmdline {
+llvm::cl::opt<std::string>
+    artifactsDir(llvm::cl::Positional, llvm::cl::Required,
+                 llvm::cl::desc("<compiled artifacts directory>"));
+
+llvm::cl::opt<std::string> funcName("funcname",
+                                    llvm::cl::desc("Function to profile"),
+                                    llvm::cl::init("main"));
+
+llvm::cl::opt<size_t>
+    invocations("invocations",
+                llvm::cl::desc("Number of invocations to profile"),
+                llvm::cl::init(1));
+
+llvm::cl::opt<std::string> outputPrefix(
+    "output-prefix",
+    llvm::cl::desc("Prefix of the emitted trace files "
+                   "(<prefix>.invocation-<i>.trace.json)"),
+    llvm::cl::init("concrete-profile"));
+
+llvm::cl::opt<std::string>
+    keyCacheDir("key-cache",
+                llvm::cl::desc("Keyset cache directory (keys are "
+                               "regenerated when empty)"),
+                llvm::cl::init(""));
+} // namespace cmdline
+
+namespace {
+
+int fatal(const std::string &message) {
+  std::cerr << "concrete-profiler: " << message << "\n";
+  return 1;
+}
+
+const char *statsOpName(runtime_stats_op op) {
+  switch (op) {
+  case RUNTIME_STATS_OP_KEYSWITCH:
+    return "keyswitch";
+  case RUNTIME_STATS_OP_BOOTSTRAP:
+    return "bootstrap";
+  case RUNTIME_STATS_OP_WOP_PBS:
+    return "wop_pbs";
+  default:
+    return "unknown";
+  }
+}
+
+/// Encrypts a zero-filled argument for each input gate of the
+/// function; the values do not matter for profiling, the shapes and
+/// key choices do.
+outcome::checked<std::unique_ptr<clientlib::PublicArguments>,
+                 clientlib::StringError>
+buildArguments(clientlib::ClientParameters &params,
+               clientlib::KeySet &keySet) {
+  auto args = clientlib::EncryptedArguments::empty();
+  for (auto gate : params.inputs) {
+    if (gate.shape.dimensions.empty()) {
+      OUTCOME_TRYV(args->pushArg((uint64_t)0, keySet));
+      continue;
+    }
+    std::vector<uint64_t> zeros(gate.shape.size, 0);
+    OUTCOME_TRYV(args->pushArg(
+        zeros.data(), llvm::ArrayRef<int64_t>(gate.shape.dimensions), keySet));
+  }
+  OUTCOME_TRYV(args->checkAllArgs(keySet));
+  return args->exportPublicArguments(params);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::cl::ParseCommandLineOptions(
+      argc, argv, "Profile the evaluation of a compiled circuit\n");
+
+  // Arm the runtime trace before anything touches the runtime; the
+  // process-exit dump goes next to the per-invocation ones.
+  std::string exitDumpPath = cmdline::outputPrefix + ".exit.trace.json";
+  setenv("CONCRETE_RUNTIME_TRACE", exitDumpPath.c_str(), /*overwrite=*/0);
+
+  auto paramsPath =
+      mlir::concretelang::CompilerEngine::Library::getClientParametersPath(
+          cmdline::artifactsDir);
+  auto paramsList = clientlib::ClientParameters::load(paramsPath);
+  if (paramsList.has_error())
+    return fatal(paramsList.error().mesg);
+  clientlib::ClientParameters params;
+  bool found = false;
+  for (auto &candidate : paramsList.value()) {
+    if (candidate.functionName == cmdline::funcName) {
+      params = candidate;
+      found = true;
+    }
+  }
+  if (!found)
+    return fatal("no client parameters for function '" + cmdline::funcName +
+                 "' in " + paramsPath);
+
+  auto lambda =
+      serverlib::ServerLambda::load(cmdline::funcName, cmdline::artifactsDir);
+  if (lambda.has_error())
+    return fatal(lambda.error().mesg);
+
+  std::cerr << "concrete-profiler: generating keyset...\n";
+  std::shared_ptr<clientlib::KeySetCache> cache;
+  if (!cmdline::keyCacheDir.empty())
+    cache = std::make_shared<clientlib::KeySetCache>(cmdline::keyCacheDir);
+  auto keySet = clientlib::KeySetCache::generate(cache, params, 0, 0);
+  if (keySet.has_error())
+    return fatal(keySet.error().mesg);
+  auto evaluationKeys = keySet.value()->evaluationKeys();
+
+  auto publicArgs = buildArguments(params, *keySet.value());
+  if (publicArgs.has_error())
+    return fatal(publicArgs.error().mesg);
+
+  for (size_t i = 0; i < cmdline::invocations; i++) {
+    runtime_trace_reset();
+    runtime_stats_reset();
+
+    auto begin = std::chrono::steady_clock::now();
+    auto result =
+        lambda.value().call(*publicArgs.value(), evaluationKeys, false);
+    auto end = std::chrono::steady_clock::now();
+    if (!result) {
+      llvm::errs() << result.takeError();
+      return fatal("invocation failed");
+    }
+
+    double milliseconds =
+        std::chrono::duration<double, std::milli>(end - begin).count();
+    std::cout << "invocation " << i << ": " << milliseconds << " ms\n";
+    for (int op = 0; op < RUNTIME_STATS_OP_NUM; op++) {
+      auto statsOp = (runtime_stats_op)op;
+      uint64_t count = runtime_stats_get_count(statsOp);
+      if (count == 0)
+        continue;
+      std::cout << "  " << statsOpName(statsOp) << ": " << count << " calls, "
+                << runtime_stats_get_time_ns(statsOp) / 1e6 << " ms total\n";
+    }
+
+    std::ostringstream path;
+    path << cmdline::outputPrefix << ".invocation-" << i << ".trace.json";
+    if (runtime_trace_dump(path.str().c_str()) != 0)
+      return fatal("cannot write trace to " + path.str());
+    std::cout << "  trace: " << path.str() << "\n";
+    if (runtime_trace_dropped() > 0)
+      std::cerr << "concrete-profiler: " << runtime_trace_dropped()
+                << " events dropped, raise CONCRETE_RUNTIME_TRACE_CAPACITY "
+                   "for a complete timeline\n";
+  }
+
+  return 0;
+}
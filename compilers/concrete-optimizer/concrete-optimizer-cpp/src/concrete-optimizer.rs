@@ -35,25 +35,52 @@ fn caches_from(options: ffi::Options) -> decomposition::PersistDecompCaches {
         println!("optimizer: To clear the cache, remove directory {cache_dir}");
     }
     let processing_unit = processing_unit(options);
+    // Calibrated cost weights change the cached decomposition rankings, so
+    // they opt out of the on-disk cache shared with uncalibrated runs.
+    let calibrated = options.ks_cost_weight != 1.0 || options.pbs_cost_weight != 1.0;
     decomposition::cache(
         options.security_level,
         processing_unit,
-        Some(ProcessingUnit::Cpu.complexity_model()),
-        options.cache_on_disk,
+        Some(std::sync::Arc::new(cpu_complexity_from(options))),
+        options.cache_on_disk && !calibrated,
         options.ciphertext_modulus_log,
         options.fft_precision,
     )
 }
 
+/// Complexity model carrying the (possibly calibrated) cost weights of the
+/// options; both weights at 1.0 reproduce the abstract operation counts.
+fn cpu_complexity_from(options: ffi::Options) -> CpuComplexity {
+    CpuComplexity {
+        ks_weight: options.ks_cost_weight,
+        pbs_weight: options.pbs_cost_weight,
+        ..CpuComplexity::default()
+    }
+}
+
+/// Runs `f` in a thread pool of `options.threads` threads, 0 keeping the
+/// default pool with one thread per core.
+fn with_threads<R: Send>(options: ffi::Options, f: impl FnOnce() -> R + Send) -> R {
+    if options.threads == 0 {
+        return f();
+    }
+    rayon::ThreadPoolBuilder::new()
+        .num_threads(options.threads as usize)
+        .build()
+        .unwrap()
+        .install(f)
+}
+
 fn optimize_bootstrap(precision: u64, noise_factor: f64, options: ffi::Options) -> ffi::Solution {
     let processing_unit = processing_unit(options);
 
+    let complexity_model = cpu_complexity_from(options);
     let config = Config {
         security_level: options.security_level,
         maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
         ciphertext_modulus_log: options.ciphertext_modulus_log,
         fft_precision: options.fft_precision,
-        complexity_model: &CpuComplexity::default(),
+        complexity_model: &complexity_model,
     };
 
     let sum_size = 1;
@@ -421,6 +448,33 @@ fn empty() -> Box<OperationDag> {
 }
 
 impl OperationDag {
+    fn reserve(&mut self, additional: usize) {
+        self.0.reserve(additional);
+    }
+
+    fn add_inputs(
+        &mut self,
+        out_precisions: &[u8],
+        flat_shapes: &[u64],
+        shape_sizes: &[u64],
+    ) -> ffi::OperatorIndex {
+        assert_eq!(out_precisions.len(), shape_sizes.len());
+        self.0.reserve(out_precisions.len());
+        let mut first = ffi::OperatorIndex { index: 0 };
+        let mut offset = 0_usize;
+        for (i, (&out_precision, &shape_size)) in
+            out_precisions.iter().zip(shape_sizes.iter()).enumerate()
+        {
+            let out_shape = &flat_shapes[offset..offset + shape_size as usize];
+            offset += shape_size as usize;
+            let index = self.add_input(out_precision, out_shape);
+            if i == 0 {
+                first = index;
+            }
+        }
+        first
+    }
+
     fn add_input(&mut self, out_precision: Precision, out_shape: &[u64]) -> ffi::OperatorIndex {
         let out_shape = Shape {
             dimensions_size: out_shape.to_owned(),
@@ -487,51 +541,58 @@ impl OperationDag {
     }
 
     fn optimize_v0(&self, options: ffi::Options) -> ffi::Solution {
-        let processing_unit = processing_unit(options);
-
-        let config = Config {
-            security_level: options.security_level,
-            maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
-            ciphertext_modulus_log: options.ciphertext_modulus_log,
-            fft_precision: options.fft_precision,
-            complexity_model: &CpuComplexity::default(),
-        };
+        with_threads(options, || {
+            let processing_unit = processing_unit(options);
 
-        let search_space = SearchSpace::default(processing_unit);
+            let complexity_model = cpu_complexity_from(options);
+            let config = Config {
+                security_level: options.security_level,
+                maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
+                ciphertext_modulus_log: options.ciphertext_modulus_log,
+                fft_precision: options.fft_precision,
+                complexity_model: &complexity_model,
+            };
 
-        let result = concrete_optimizer::optimization::dag::solo_key::optimize::optimize(
-            &self.0,
-            config,
-            &search_space,
-            &caches_from(options),
-        );
-        result
-            .best_solution
-            .map_or_else(no_solution, |solution| solution.into())
+            let search_space = SearchSpace::default(processing_unit);
+
+            let result = concrete_optimizer::optimization::dag::solo_key::optimize::optimize(
+                &self.0,
+                config,
+                &search_space,
+                &caches_from(options),
+            );
+            result
+                .best_solution
+                .map_or_else(no_solution, |solution| solution.into())
+        })
     }
 
     fn optimize(&self, options: ffi::Options) -> ffi::DagSolution {
-        let processing_unit = processing_unit(options);
-        let config = Config {
-            security_level: options.security_level,
-            maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
-            ciphertext_modulus_log: options.ciphertext_modulus_log,
-            fft_precision: options.fft_precision,
-            complexity_model: &CpuComplexity::default(),
-        };
-
-        let search_space = SearchSpace::default(processing_unit);
-
-        let encoding = options.encoding.into();
-        let result = concrete_optimizer::optimization::dag::solo_key::optimize_generic::optimize(
-            &self.0,
-            config,
-            &search_space,
-            encoding,
-            options.default_log_norm2_woppbs,
-            &caches_from(options),
-        );
-        result.map_or_else(no_dag_solution, |solution| solution.into())
+        with_threads(options, || {
+            let processing_unit = processing_unit(options);
+            let complexity_model = cpu_complexity_from(options);
+            let config = Config {
+                security_level: options.security_level,
+                maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
+                ciphertext_modulus_log: options.ciphertext_modulus_log,
+                fft_precision: options.fft_precision,
+                complexity_model: &complexity_model,
+            };
+
+            let search_space = SearchSpace::default(processing_unit);
+
+            let encoding = options.encoding.into();
+            let result =
+                concrete_optimizer::optimization::dag::solo_key::optimize_generic::optimize(
+                    &self.0,
+                    config,
+                    &search_space,
+                    encoding,
+                    options.default_log_norm2_woppbs,
+                    &caches_from(options),
+                );
+            result.map_or_else(no_dag_solution, |solution| solution.into())
+        })
     }
 
     fn dump(&self) -> String {
@@ -539,28 +600,31 @@ impl OperationDag {
     }
 
     fn optimize_multi(&self, options: ffi::Options) -> ffi::CircuitSolution {
-        let processing_unit = processing_unit(options);
-        let config = Config {
-            security_level: options.security_level,
-            maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
-            ciphertext_modulus_log: options.ciphertext_modulus_log,
-            fft_precision: options.fft_precision,
-            complexity_model: &CpuComplexity::default(),
-        };
-        let search_space = SearchSpace::default(processing_unit);
-
-        let encoding = options.encoding.into();
-        let circuit_sol =
-            concrete_optimizer::optimization::dag::multi_parameters::optimize_generic::optimize(
-                &self.0,
-                config,
-                &search_space,
-                encoding,
-                options.default_log_norm2_woppbs,
-                &caches_from(options),
-                &None,
-            );
-        circuit_sol.into()
+        with_threads(options, || {
+            let processing_unit = processing_unit(options);
+            let complexity_model = cpu_complexity_from(options);
+            let config = Config {
+                security_level: options.security_level,
+                maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
+                ciphertext_modulus_log: options.ciphertext_modulus_log,
+                fft_precision: options.fft_precision,
+                complexity_model: &complexity_model,
+            };
+            let search_space = SearchSpace::default(processing_unit);
+
+            let encoding = options.encoding.into();
+            let circuit_sol =
+                concrete_optimizer::optimization::dag::multi_parameters::optimize_generic::optimize(
+                    &self.0,
+                    config,
+                    &search_space,
+                    encoding,
+                    options.default_log_norm2_woppbs,
+                    &caches_from(options),
+                    &None,
+                );
+            circuit_sol.into()
+        })
     }
 }
 
@@ -618,6 +682,15 @@ mod ffi {
         #[namespace = "concrete_optimizer::dag"]
         fn empty() -> Box<OperationDag>;
 
+        fn reserve(self: &mut OperationDag, additional: usize);
+
+        fn add_inputs(
+            self: &mut OperationDag,
+            out_precisions: &[u8],
+            flat_shapes: &[u64],
+            shape_sizes: &[u64],
+        ) -> OperatorIndex;
+
         fn add_input(
             self: &mut OperationDag,
             out_precision: u8,
@@ -736,6 +809,9 @@ mod ffi {
         pub cache_on_disk: bool,
         pub ciphertext_modulus_log: u32,
         pub fft_precision: u32,
+        pub threads: u64,
+        pub ks_cost_weight: f64,
+        pub pbs_cost_weight: f64,
     }
 
     #[namespace = "concrete_optimizer::dag"]
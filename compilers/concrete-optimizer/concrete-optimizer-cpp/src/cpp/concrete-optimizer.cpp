@@ -967,6 +967,8 @@ namespace concrete_optimizer {
 #ifndef CXXBRIDGE1_STRUCT_concrete_optimizer$OperationDag
 #define CXXBRIDGE1_STRUCT_concrete_optimizer$OperationDag
 struct OperationDag final : public ::rust::Opaque {
+  void reserve(::std::size_t additional) noexcept;
+  ::concrete_optimizer::dag::OperatorIndex add_inputs(::rust::Slice<::std::uint8_t const> out_precisions, ::rust::Slice<::std::uint64_t const> flat_shapes, ::rust::Slice<::std::uint64_t const> shape_sizes) noexcept;
   ::concrete_optimizer::dag::OperatorIndex add_input(::std::uint8_t out_precision, ::rust::Slice<::std::uint64_t const> out_shape) noexcept;
   ::concrete_optimizer::dag::OperatorIndex add_lut(::concrete_optimizer::dag::OperatorIndex input, ::rust::Slice<::std::uint64_t const> table, ::std::uint8_t out_precision) noexcept;
   ::concrete_optimizer::dag::OperatorIndex add_dot(::rust::Slice<::concrete_optimizer::dag::OperatorIndex const> inputs, ::rust::Box<::concrete_optimizer::Weights> weights) noexcept;
@@ -1081,6 +1083,9 @@ struct Options final {
   bool cache_on_disk;
   ::std::uint32_t ciphertext_modulus_log;
   ::std::uint32_t fft_precision;
+  ::std::uint64_t threads;
+  double ks_cost_weight;
+  double pbs_cost_weight;
 
   using IsRelocatable = ::std::true_type;
 };
@@ -1260,6 +1265,10 @@ extern "C" {
 } // namespace dag
 
 extern "C" {
+void concrete_optimizer$cxxbridge1$OperationDag$reserve(::concrete_optimizer::OperationDag &self, ::std::size_t additional) noexcept;
+
+::concrete_optimizer::dag::OperatorIndex concrete_optimizer$cxxbridge1$OperationDag$add_inputs(::concrete_optimizer::OperationDag &self, ::rust::Slice<::std::uint8_t const> out_precisions, ::rust::Slice<::std::uint64_t const> flat_shapes, ::rust::Slice<::std::uint64_t const> shape_sizes) noexcept;
+
 ::concrete_optimizer::dag::OperatorIndex concrete_optimizer$cxxbridge1$OperationDag$add_input(::concrete_optimizer::OperationDag &self, ::std::uint8_t out_precision, ::rust::Slice<::std::uint64_t const> out_shape) noexcept;
 
 ::concrete_optimizer::dag::OperatorIndex concrete_optimizer$cxxbridge1$OperationDag$add_lut(::concrete_optimizer::OperationDag &self, ::concrete_optimizer::dag::OperatorIndex input, ::rust::Slice<::std::uint64_t const> table, ::std::uint8_t out_precision) noexcept;
@@ -1334,6 +1343,14 @@ namespace dag {
 }
 } // namespace dag
 
+void OperationDag::reserve(::std::size_t additional) noexcept {
+  concrete_optimizer$cxxbridge1$OperationDag$reserve(*this, additional);
+}
+
+::concrete_optimizer::dag::OperatorIndex OperationDag::add_inputs(::rust::Slice<::std::uint8_t const> out_precisions, ::rust::Slice<::std::uint64_t const> flat_shapes, ::rust::Slice<::std::uint64_t const> shape_sizes) noexcept {
+  return concrete_optimizer$cxxbridge1$OperationDag$add_inputs(*this, out_precisions, flat_shapes, shape_sizes);
+}
+
 ::concrete_optimizer::dag::OperatorIndex OperationDag::add_input(::std::uint8_t out_precision, ::rust::Slice<::std::uint64_t const> out_shape) noexcept {
   return concrete_optimizer$cxxbridge1$OperationDag$add_input(*this, out_precision, out_shape);
 }
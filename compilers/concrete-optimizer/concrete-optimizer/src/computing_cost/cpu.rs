@@ -10,11 +10,18 @@ pub struct CpuComplexity {
     pub ks_lwe: keyswitch_lwe::KsComplexity,
     pub pbs: pbs::PbsComplexity,
     pub multi_bit_pbs: MultiBitPbsComplexity,
+    /// Multiplier applied on keyswitch costs, 1.0 keeps the abstract
+    /// operation counts. Calibration against measured timings sets this so
+    /// the model reflects the actual keyswitch/bootstrap cost ratio of the
+    /// deployment machine.
+    pub ks_weight: f64,
+    /// Multiplier applied on (multi bit) bootstrap costs, see `ks_weight`.
+    pub pbs_weight: f64,
 }
 
 impl ComplexityModel for CpuComplexity {
     fn pbs_complexity(&self, params: PbsParameters, ciphertext_modulus_log: u32) -> Complexity {
-        self.pbs.complexity(params, ciphertext_modulus_log)
+        self.pbs_weight * self.pbs.complexity(params, ciphertext_modulus_log)
     }
     fn multi_bit_pbs_complexity(
         &self,
@@ -23,8 +30,10 @@ impl ComplexityModel for CpuComplexity {
         grouping_factor: u32,
         jit_fft: bool,
     ) -> Complexity {
-        self.multi_bit_pbs
-            .complexity(params, ciphertext_modulus_log, grouping_factor, jit_fft)
+        self.pbs_weight
+            * self
+                .multi_bit_pbs
+                .complexity(params, ciphertext_modulus_log, grouping_factor, jit_fft)
     }
 
     fn cmux_complexity(&self, params: CmuxParameters, ciphertext_modulus_log: u32) -> Complexity {
@@ -36,7 +45,7 @@ impl ComplexityModel for CpuComplexity {
         params: KeyswitchParameters,
         ciphertext_modulus_log: u32,
     ) -> Complexity {
-        self.ks_lwe.complexity(params, ciphertext_modulus_log)
+        self.ks_weight * self.ks_lwe.complexity(params, ciphertext_modulus_log)
     }
 
     fn fft_complexity(&self, glwe_polynomial_size: f64, ciphertext_modulus_log: u32) -> Complexity {
@@ -61,6 +70,8 @@ impl Default for CpuComplexity {
             ks_lwe: KsComplexity,
             pbs: pbs::PbsComplexity::default(),
             multi_bit_pbs: multi_bit_pbs::MultiBitPbsComplexity::default(),
+            ks_weight: 1.0,
+            pbs_weight: 1.0,
         }
     }
 }
@@ -36,6 +36,12 @@ impl OperationDag {
         }
     }
 
+    pub fn reserve(&mut self, additional: usize) {
+        self.operators.reserve(additional);
+        self.out_shapes.reserve(additional);
+        self.out_precisions.reserve(additional);
+    }
+
     fn add_operator(&mut self, operator: UnparameterizedOperator) -> OperatorIndex {
         let i = self.operators.len();
         self.out_precisions
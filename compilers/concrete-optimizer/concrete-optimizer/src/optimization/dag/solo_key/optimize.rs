@@ -17,6 +17,7 @@ use crate::optimization::decomposition::keyswitch::{
 };
 use crate::optimization::decomposition::PersistDecompCaches;
 use crate::parameters::GlweParameters;
+use rayon::prelude::*;
 
 #[allow(clippy::too_many_lines)]
 fn update_best_solution_with_best_decompositions(
@@ -263,7 +264,96 @@ fn too_complex_macro_parameters(
     dag.complexity(input_lwe_dimension, lower_one_lut_complexity) > best_complexity
 }
 
-#[allow(clippy::too_many_lines)]
+/// Explores the internal lwe dimensions and micro parameters for one pair of
+/// glwe macro parameters, with its own decomposition caches and local
+/// best-solution pruning.
+fn optimize_glwe_params(
+    consts: &OptimizationDecompositionsConsts,
+    dag: &analyze::OperationDag,
+    search_space: &SearchSpace,
+    persistent_caches: &PersistDecompCaches,
+    glwe_params: GlweParameters,
+) -> OptimizationState {
+    let ciphertext_modulus_log = consts.config.ciphertext_modulus_log;
+    let mut state = OptimizationState {
+        best_solution: None,
+    };
+    let mut caches = persistent_caches.caches();
+
+    let input_noise_out = minimal_variance(&consts.config, glwe_params);
+
+    let cmux_pareto = caches.cmux.pareto_quantities(glwe_params);
+
+    for &internal_dim in &search_space.internal_lwe_dimensions {
+        let ks_pareto = caches.keyswitch.pareto_quantities(internal_dim);
+
+        let noise_modulus_switching = estimate_modulus_switching_noise_with_binary_key(
+            internal_dim,
+            glwe_params.log2_polynomial_size,
+            ciphertext_modulus_log,
+        );
+        if !dag.feasible(input_noise_out, 0.0, 0.0, noise_modulus_switching) {
+            // noise_modulus_switching is increasing with internal_dim
+            break;
+        }
+        if too_complex_macro_parameters(
+            &state,
+            dag,
+            internal_dim,
+            glwe_params,
+            cmux_pareto,
+            ks_pareto,
+        ) {
+            break;
+        }
+        if not_feasible_macro_parameters(
+            dag,
+            internal_dim,
+            input_noise_out,
+            noise_modulus_switching,
+            cmux_pareto,
+            ks_pareto,
+        ) {
+            continue;
+        }
+        update_best_solution_with_best_decompositions(
+            &mut state,
+            consts,
+            dag,
+            internal_dim,
+            glwe_params,
+            input_noise_out,
+            noise_modulus_switching,
+            cmux_pareto,
+            ks_pareto,
+        );
+    }
+
+    persistent_caches.backport(caches);
+    state
+}
+
+/// Merges a partial optimization state into `state`, using the same criterion
+/// as `update_best_solution_with_best_decompositions`: a lower complexity, or
+/// the same complexity with fewer errors.
+#[allow(clippy::float_cmp)]
+fn merge_best_solution(state: &mut OptimizationState, partial: OptimizationState) {
+    let partial_sol = match partial.best_solution {
+        Some(sol) => sol,
+        None => return,
+    };
+    let better = match state.best_solution {
+        None => true,
+        Some(sol) => {
+            partial_sol.complexity < sol.complexity
+                || (partial_sol.complexity == sol.complexity && partial_sol.p_error < sol.p_error)
+        }
+    };
+    if better {
+        state.best_solution = Some(partial_sol);
+    }
+}
+
 pub fn optimize(
     dag: &unparametrized::OperationDag,
     config: Config,
@@ -304,78 +394,33 @@ pub fn optimize(
     if dag.nb_luts == 0 {
         return optimize_no_luts(state, &consts, &dag, search_space);
     }
-    let mut caches = persistent_caches.caches();
-
-    let noise_modulus_switching = |glwe_log2_poly_size, internal_lwe_dimensions| {
-        estimate_modulus_switching_noise_with_binary_key(
-            internal_lwe_dimensions,
-            glwe_log2_poly_size,
-            ciphertext_modulus_log,
-        )
-    };
-
-    let not_feasible = |input_noise_out, noise_modulus_switching| {
-        !dag.feasible(input_noise_out, 0.0, 0.0, noise_modulus_switching)
-    };
 
+    let mut macro_params = Vec::with_capacity(
+        search_space.glwe_dimensions.len() * search_space.glwe_log_polynomial_sizes.len(),
+    );
     for &glwe_dim in &search_space.glwe_dimensions {
         for &glwe_log_poly_size in &search_space.glwe_log_polynomial_sizes {
-            let glwe_params = GlweParameters {
+            macro_params.push(GlweParameters {
                 log2_polynomial_size: glwe_log_poly_size,
                 glwe_dimension: glwe_dim,
-            };
-            let input_noise_out = minimal_variance(&config, glwe_params);
-
-            let cmux_pareto = caches.cmux.pareto_quantities(glwe_params);
-
-            for &internal_dim in &search_space.internal_lwe_dimensions {
-                let ks_pareto = caches.keyswitch.pareto_quantities(internal_dim);
-
-                let noise_modulus_switching =
-                    noise_modulus_switching(glwe_log_poly_size, internal_dim);
-                if not_feasible(input_noise_out, noise_modulus_switching) {
-                    // noise_modulus_switching is increasing with internal_dim
-                    break;
-                }
-                if too_complex_macro_parameters(
-                    &state,
-                    &dag,
-                    internal_dim,
-                    glwe_params,
-                    cmux_pareto,
-                    ks_pareto,
-                ) {
-                    break;
-                }
-                if not_feasible_macro_parameters(
-                    &dag,
-                    internal_dim,
-                    input_noise_out,
-                    noise_modulus_switching,
-                    cmux_pareto,
-                    ks_pareto,
-                ) {
-                    continue;
-                }
-                update_best_solution_with_best_decompositions(
-                    &mut state,
-                    &consts,
-                    &dag,
-                    internal_dim,
-                    glwe_params,
-                    input_noise_out,
-                    noise_modulus_switching,
-                    cmux_pareto,
-                    ks_pareto,
-                );
-                if dag.nb_luts == 0 && state.best_solution.is_some() {
-                    return state;
-                }
-            }
+            });
         }
     }
 
-    persistent_caches.backport(caches);
+    // The glwe macro parameters are evaluated in parallel: the evaluations are
+    // independent, only the best-solution pruning is shared and keeping it
+    // local to each pair cannot change the result since pruned candidates are
+    // strictly worse than the running best. Partial states are merged in
+    // search order to keep the result deterministic.
+    let partial_states: Vec<OptimizationState> = macro_params
+        .par_iter()
+        .map(|&glwe_params| {
+            optimize_glwe_params(&consts, &dag, search_space, persistent_caches, glwe_params)
+        })
+        .collect();
+    for partial in partial_states {
+        merge_best_solution(&mut state, partial);
+    }
 
     if let Some(sol) = state.best_solution {
         assert!(0.0 <= sol.p_error && sol.p_error <= 1.0);